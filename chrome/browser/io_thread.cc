@@ -14,6 +14,7 @@
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
+#include "base/path_service.h"
 #include "base/prefs/pref_registry_simple.h"
 #include "base/prefs/pref_service.h"
 #include "base/stl_util.h"
@@ -41,6 +42,8 @@
 #include "chrome/browser/net/sdch_dictionary_fetcher.h"
 #include "chrome/browser/net/spdyproxy/http_auth_handler_spdyproxy.h"
 #include "chrome/browser/policy/policy_service.h"
+#include "chrome/common/chrome_constants.h"
+#include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/common/url_constants.h"
@@ -52,6 +55,7 @@
 #include "net/cert/cert_verifier.h"
 #include "net/cookies/cookie_monster.h"
 #include "net/dns/host_cache.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
 #include "net/ftp/ftp_network_layer.h"
@@ -134,6 +138,20 @@ class SystemURLRequestContext : public net::URLRequestContext {
   }
 };
 
+// Lets the resolver serve expired host cache entries while it refreshes them,
+// which is what makes the entries restored by the HostCachePersister at
+// startup usable.
+void ConfigureStaleHostCacheFieldTrial(net::HostResolver::Options* options) {
+  // Configure the StaleHostCache field trial as follows:
+  // group Enabled: serve entries up to a day after they expire, and refresh
+  // entries in use in the last 10 seconds before they expire,
+  // otherwise (trial absent or other group): only serve valid entries.
+  if (base::FieldTrialList::FindFullName("StaleHostCache") != "Enabled")
+    return;
+  options->max_cache_staleness = base::TimeDelta::FromDays(1);
+  options->cache_prefetch_window = base::TimeDelta::FromSeconds(10);
+}
+
 scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
   TRACE_EVENT0("startup", "IOThread::CreateGlobalHostResolver");
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
@@ -167,6 +185,8 @@ scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
     }
   }
 
+  ConfigureStaleHostCacheFieldTrial(&options);
+
   scoped_ptr<net::HostResolver> global_host_resolver(
       net::HostResolver::CreateSystemResolver(options, net_log));
 
@@ -192,6 +212,26 @@ scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
   return remapped_resolver.PassAs<net::HostResolver>();
 }
 
+// Returns a persister that keeps the entries of |host_cache| in the user data
+// directory across restarts, or NULL if there is nothing to persist. The file
+// is written when the persister is destroyed, from IOThread::CleanUp(), which
+// runs before the blocking pool is shut down.
+scoped_ptr<net::HostCachePersister> CreateHostCachePersister(
+    net::HostCache* host_cache) {
+  base::FilePath user_data_dir;
+  if (!host_cache || !PathService::Get(chrome::DIR_USER_DATA, &user_data_dir))
+    return scoped_ptr<net::HostCachePersister>();
+
+  base::SequencedWorkerPool* pool = BrowserThread::GetBlockingPool();
+  scoped_refptr<base::SequencedTaskRunner> task_runner =
+      pool->GetSequencedTaskRunnerWithShutdownBehavior(
+          pool->GetNamedSequenceToken("HostCachePersister"),
+          base::SequencedWorkerPool::BLOCK_SHUTDOWN);
+  return scoped_ptr<net::HostCachePersister>(new net::HostCachePersister(
+      host_cache, user_data_dir.Append(chrome::kHostCacheFilename),
+      task_runner.get()));
+}
+
 // TODO(willchan): Remove proxy script fetcher context since it's not necessary
 // now that I got rid of refcounting URLRequestContexts.
 // See IOThread::Globals for details.
@@ -524,6 +564,10 @@ void IOThread::InitAsync() {
     network_delegate->NeverThrottleRequests();
   globals_->system_network_delegate.reset(network_delegate);
   globals_->host_resolver = CreateGlobalHostResolver(net_log_);
+  globals_->host_cache_persister = CreateHostCachePersister(
+      globals_->host_resolver->GetHostCache());
+  if (globals_->host_cache_persister)
+    globals_->host_cache_persister->Load(base::Bind(&base::DoNothing));
   UpdateDnsClientEnabled();
   globals_->cert_verifier.reset(net::CertVerifier::CreateDefault());
   globals_->transport_security_state.reset(new net::TransportSecurityState());
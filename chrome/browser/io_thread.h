@@ -42,6 +42,7 @@ namespace net {
 class CertVerifier;
 class CookieStore;
 class FtpTransactionFactory;
+class HostCachePersister;
 class HostMappingRules;
 class HostResolver;
 class HttpAuthHandlerFactory;
@@ -111,6 +112,9 @@ class IOThread : public content::BrowserThreadDelegate {
     // The "system" NetworkDelegate, used for Profile-agnostic network events.
     scoped_ptr<net::NetworkDelegate> system_network_delegate;
     scoped_ptr<net::HostResolver> host_resolver;
+    // Saves the cache of |host_resolver| when destroyed, so it must be
+    // destroyed first.
+    scoped_ptr<net::HostCachePersister> host_cache_persister;
     scoped_ptr<net::CertVerifier> cert_verifier;
     // The ServerBoundCertService must outlive the HttpTransactionFactory.
     scoped_ptr<net::ServerBoundCertService> system_server_bound_cert_service;
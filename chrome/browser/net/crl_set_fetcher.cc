@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/path_service.h"
 #include "base/rand_util.h"
 #include "base/safe_numerics.h"
@@ -21,6 +22,40 @@
 
 using content::BrowserThread;
 
+// GetMappedCRLSetFilePath returns the path of the copy of the CRL set file at
+// |crl_set_file_path| which net::CRLSet::LoadMappedFile can use in place.
+static base::FilePath GetMappedCRLSetFilePath(
+    const base::FilePath& crl_set_file_path) {
+  return crl_set_file_path.AddExtension(FILE_PATH_LITERAL("mapped"));
+}
+
+// ReadCRLSetSequence sets |*sequence| to the sequence number of the CRL set
+// file at |path|, reading no more than its header.
+static bool ReadCRLSetSequence(const base::FilePath& path, uint32* sequence) {
+  // The header is prefixed with its uint16 length.
+  std::string header_bytes(2 + kuint16max, 0);
+  int size = file_util::ReadFile(path, &header_bytes[0],
+                                 static_cast<int>(header_bytes.size()));
+  if (size <= 0)
+    return false;
+  return net::CRLSet::GetSequence(base::StringPiece(header_bytes.data(), size),
+                                  sequence);
+}
+
+// SaveMappedCRLSet saves |crl_set| for GetMappedCRLSetFilePath. The file is
+// replaced atomically because the previous one may still be mapped. If it
+// can't be saved, the previous one is deleted rather than left out of date;
+// where that fails too, LoadFromDisk ignores it by its sequence number.
+static void SaveMappedCRLSet(const base::FilePath& crl_set_file_path,
+                             const net::CRLSet* crl_set) {
+  const base::FilePath path = GetMappedCRLSetFilePath(crl_set_file_path);
+  if (!base::ImportantFileWriter::WriteFileAtomically(
+          path, crl_set->SerializeMappable())) {
+    LOG(WARNING) << "Failed to save mapped CRL set to disk";
+    base::DeleteFile(path, false);
+  }
+}
+
 CRLSetFetcher::CRLSetFetcher() : cus_(NULL) {}
 
 bool CRLSetFetcher::GetCRLSetFilePath(base::FilePath* path) const {
@@ -74,16 +109,36 @@ void CRLSetFetcher::LoadFromDisk(base::FilePath path,
                                  scoped_refptr<net::CRLSet>* out_crl_set) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
 
-  std::string crl_set_bytes;
-  if (!base::ReadFileToString(path, &crl_set_bytes))
-    return;
+  // The mapped copy is used in place, and its pages are shared with the other
+  // processes which map it, so it's preferred to parsing the CRL set. It may
+  // be out of date: on Windows, SaveMappedCRLSet can neither replace nor
+  // delete it while a running process still maps it. So it's only used if it
+  // has the sequence number of the CRL set file.
+  scoped_refptr<net::CRLSet> mapped_crl_set;
+  uint32 sequence;
+  if (ReadCRLSetSequence(path, &sequence) &&
+      net::CRLSet::LoadMappedFile(GetMappedCRLSetFilePath(path),
+                                  &mapped_crl_set) &&
+      mapped_crl_set->sequence() == sequence) {
+    VLOG(1) << "Mapped CRL set from disk";
+    *out_crl_set = mapped_crl_set;
+  } else {
+    // Unmap any out of date copy, so that SaveMappedCRLSet can replace it.
+    mapped_crl_set = NULL;
 
-  if (!net::CRLSet::Parse(crl_set_bytes, out_crl_set)) {
-    LOG(WARNING) << "Failed to parse CRL set from " << path.MaybeAsASCII();
-    return;
-  }
+    std::string crl_set_bytes;
+    if (!base::ReadFileToString(path, &crl_set_bytes))
+      return;
+
+    if (!net::CRLSet::Parse(crl_set_bytes, out_crl_set)) {
+      LOG(WARNING) << "Failed to parse CRL set from " << path.MaybeAsASCII();
+      return;
+    }
 
-  VLOG(1) << "Loaded " << crl_set_bytes.size() << " bytes of CRL set from disk";
+    VLOG(1) << "Loaded " << crl_set_bytes.size()
+            << " bytes of CRL set from disk";
+    SaveMappedCRLSet(path, out_crl_set->get());
+  }
 
   if (!BrowserThread::PostTask(
           BrowserThread::IO, FROM_HERE,
@@ -175,6 +230,7 @@ bool CRLSetFetcher::Install(const base::DictionaryValue& manifest,
       // we restart we might revert to an older version, then we'll
       // advertise the older version to Omaha and everything will still work.
     }
+    SaveMappedCRLSet(save_to, crl_set_.get());
   } else {
     scoped_refptr<net::CRLSet> new_crl_set;
     if (!crl_set_->ApplyDelta(crl_set_bytes, &new_crl_set)) {
@@ -191,6 +247,7 @@ bool CRLSetFetcher::Install(const base::DictionaryValue& manifest,
       // we restart we might revert to an older version, then we'll
       // advertise the older version to Omaha and everything will still work.
     }
+    SaveMappedCRLSet(save_to, new_crl_set.get());
     crl_set_ = new_crl_set;
   }
 
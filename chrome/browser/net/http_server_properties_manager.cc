@@ -249,6 +249,26 @@ HttpServerPropertiesManager::GetPipelineCapabilityMap() const {
   return http_server_properties_impl_->GetPipelineCapabilityMap();
 }
 
+net::AddressConnectStats HttpServerPropertiesManager::GetAddressConnectStats(
+    const net::IPEndPoint& address) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  return http_server_properties_impl_->GetAddressConnectStats(address);
+}
+
+// The connect stats describe the current network, so they aren't saved to
+// the preferences.
+void HttpServerPropertiesManager::SetAddressConnectStats(
+    const net::IPEndPoint& address,
+    const net::AddressConnectStats& stats) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  http_server_properties_impl_->SetAddressConnectStats(address, stats);
+}
+
+void HttpServerPropertiesManager::ClearAddressConnectStats() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  http_server_properties_impl_->ClearAddressConnectStats();
+}
+
 //
 // Update the HttpServerPropertiesImpl's cache with data from preferences.
 //
@@ -152,6 +152,15 @@ class HttpServerPropertiesManager
 
   virtual net::PipelineCapabilityMap GetPipelineCapabilityMap() const OVERRIDE;
 
+  virtual net::AddressConnectStats GetAddressConnectStats(
+      const net::IPEndPoint& address) OVERRIDE;
+
+  virtual void SetAddressConnectStats(
+      const net::IPEndPoint& address,
+      const net::AddressConnectStats& stats) OVERRIDE;
+
+  virtual void ClearAddressConnectStats() OVERRIDE;
+
  protected:
   // --------------------
   // SPDY related methods
@@ -48,11 +48,12 @@ namespace content {
 //
 // SQLitePersistentCookieStore::Load is called to load all cookies.  It
 // delegates to Backend::Load, which posts a Backend::LoadAndNotifyOnDBThread
-// task to the background runner.  This task calls Backend::ChainLoadCookies(),
-// which repeatedly posts itself to the BG runner to load each eTLD+1's cookies
-// in separate tasks.  When this is complete, Backend::CompleteLoadOnIOThread is
-// posted to the client runner, which notifies the caller of
-// SQLitePersistentCookieStore::Load that the load is complete.
+// task to the background runner.  This task opens the database and posts
+// Backend::ChainLoadCookies(), which repeatedly posts itself to the BG runner
+// to load the eTLD+1s' cookies in separate tasks, a few keys at a time.  When
+// this is complete, Backend::CompleteLoadOnIOThread is posted to the client
+// runner, which notifies the caller of SQLitePersistentCookieStore::Load that
+// the load is complete.
 //
 // If a priority load request is invoked via SQLitePersistentCookieStore::
 // LoadCookiesForKey, it is delegated to Backend::LoadCookiesForKey, which posts
@@ -61,10 +62,15 @@ namespace content {
 // CompleteLoadForKeyOnIOThread to the client runner to notify the caller of
 // SQLitePersistentCookieStore::LoadCookiesForKey that that load is complete.
 //
+// Since each chain-load task reads a bounded number of cookies, a priority
+// request doesn't wait for long behind the full load.
+//
 // Subsequent to loading, mutations may be queued by any thread using
-// AddCookie, UpdateCookieAccessTime, and DeleteCookie. These are flushed to
-// disk on the BG runner every 30 seconds, 512 operations, or call to Flush(),
-// whichever occurs first.
+// AddCookie, UpdateCookieAccessTime, and DeleteCookie. Operations on a cookie
+// that already has a pending operation are merged with it when possible (e.g.
+// repeated access time updates, or the deletion of a cookie that was never
+// written). These are flushed to disk on the BG runner every 30 seconds, 512
+// operations, or call to Flush(), whichever occurs first.
 class SQLitePersistentCookieStore::Backend
     : public base::RefCountedThreadSafe<SQLitePersistentCookieStore::Backend> {
  public:
@@ -138,6 +144,10 @@ class SQLitePersistentCookieStore::Backend
     OperationType op() const { return op_; }
     const net::CanonicalCookie& cc() const { return cc_; }
 
+    void set_last_access_date(const base::Time& date) {
+      cc_.SetLastAccessDate(date);
+    }
+
    private:
     OperationType op_;
     net::CanonicalCookie cc_;
@@ -191,6 +201,11 @@ class SQLitePersistentCookieStore::Backend
   // Batch a cookie operation (add or delete)
   void BatchOperation(PendingOperation::OperationType op,
                       const net::CanonicalCookie& cc);
+  // Folds |op| on |cc| into the last pending operation for the same cookie, if
+  // there is one and the result is equivalent. Returns true if |op| does not
+  // need to be queued anymore. Must be called with |lock_| held.
+  bool MergePendingOperation(PendingOperation::OperationType op,
+                             const net::CanonicalCookie& cc);
   // Commit our pending operations to the database.
   void Commit();
   // Close() executed on the background runner.
@@ -214,10 +229,18 @@ class SQLitePersistentCookieStore::Backend
 
   typedef std::list<PendingOperation*> PendingOperationsList;
   PendingOperationsList pending_;
+  // The number of operations batched since the last commit, including those
+  // that were merged into |pending_|.
   PendingOperationsList::size_type num_pending_;
+  // Maps the creation time of a cookie (which is its primary key) to the last
+  // operation in |pending_| for that cookie.
+  typedef std::map<int64, PendingOperationsList::iterator>
+      PendingOperationsIndex;
+  PendingOperationsIndex pending_index_;
   // True if the persistent store should skip delete on exit rules.
   bool force_keep_session_state_;
-  // Guard |cookies_|, |pending_|, |num_pending_|, |force_keep_session_state_|
+  // Guard |cookies_|, |pending_|, |num_pending_|, |pending_index_|,
+  // |force_keep_session_state_|
   base::Lock lock_;
 
   // Temporary buffer for cookies loaded from DB. Accumulates cookies to reduce
@@ -295,6 +318,10 @@ namespace {
 const int kCurrentVersionNumber = 6;
 const int kCompatibleVersionNumber = 5;
 
+// ChainLoadCookies() keeps loading domain keys in the same task until this
+// many cookies have been read.
+const int kChainLoadBatchCookies = 250;
+
 // Possible values for the 'priority' column.
 enum DBCookiePriority {
   kCookiePriorityLow = 0,
@@ -428,7 +455,10 @@ void SQLitePersistentCookieStore::Backend::LoadAndNotifyInBackground(
     PostClientTask(FROM_HERE, base::Bind(
         &Backend::CompleteLoadInForeground, this, loaded_callback, false));
   } else {
-    ChainLoadCookies(loaded_callback);
+    // Let the priority loads that were requested while the database was being
+    // opened go first.
+    PostBackgroundTask(FROM_HERE, base::Bind(
+        &Backend::ChainLoadCookies, this, loaded_callback));
   }
 }
 
@@ -647,12 +677,18 @@ void SQLitePersistentCookieStore::Backend::ChainLoadCookies(
   if (!db_) {
     // Close() has been called on this store.
     load_success = false;
-  } else if (keys_to_load_.size() > 0) {
-    // Load cookies for the first domain key.
-    std::map<std::string, std::set<std::string> >::iterator
-      it = keys_to_load_.begin();
-    load_success = LoadCookiesForDomains(it->second);
-    keys_to_load_.erase(it);
+  } else {
+    // Load cookies for the first domain keys. Every task reads a bounded number
+    // of cookies, so that priority loads don't wait for long.
+    const int num_cookies_read_at_start = num_cookies_read_;
+    while (load_success && keys_to_load_.size() > 0 &&
+           num_cookies_read_ - num_cookies_read_at_start <
+               kChainLoadBatchCookies) {
+      std::map<std::string, std::set<std::string> >::iterator
+        it = keys_to_load_.begin();
+      load_success = LoadCookiesForDomains(it->second);
+      keys_to_load_.erase(it);
+    }
   }
 
   // If load is successful and there are more domain keys to be loaded,
@@ -888,7 +924,10 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   PendingOperationsList::size_type num_pending;
   {
     base::AutoLock locked(lock_);
-    pending_.push_back(po.release());
+    if (!MergePendingOperation(op, cc)) {
+      pending_.push_back(po.release());
+      pending_index_[cc.CreationDate().ToInternalValue()] = --pending_.end();
+    }
     num_pending = ++num_pending_;
   }
 
@@ -905,6 +944,47 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   }
 }
 
+bool SQLitePersistentCookieStore::Backend::MergePendingOperation(
+    PendingOperation::OperationType op,
+    const net::CanonicalCookie& cc) {
+  lock_.AssertAcquired();
+
+  PendingOperationsIndex::iterator index_it =
+      pending_index_.find(cc.CreationDate().ToInternalValue());
+  if (index_it == pending_index_.end())
+    return false;
+
+  PendingOperationsList::iterator pending_it = index_it->second;
+  PendingOperation* pending = *pending_it;
+  switch (op) {
+    case PendingOperation::COOKIE_UPDATEACCESS:
+      // Only the last access time is written, and there is nothing to update
+      // once the cookie is deleted.
+      if (pending->op() != PendingOperation::COOKIE_DELETE)
+        pending->set_last_access_date(cc.LastAccessDate());
+      return true;
+
+    case PendingOperation::COOKIE_DELETE: {
+      if (pending->op() == PendingOperation::COOKIE_DELETE)
+        return true;
+      // The pending add or update is moot. If it was an add, the cookie never
+      // reached the database and there is nothing to delete.
+      bool was_add = pending->op() == PendingOperation::COOKIE_ADD;
+      delete pending;
+      pending_.erase(pending_it);
+      pending_index_.erase(index_it);
+      return was_add;
+    }
+
+    case PendingOperation::COOKIE_ADD:
+      // Keep the operations in order.
+      return false;
+  }
+
+  NOTREACHED();
+  return false;
+}
+
 void SQLitePersistentCookieStore::Backend::Commit() {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
 
@@ -912,6 +992,7 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   {
     base::AutoLock locked(lock_);
     pending_.swap(ops);
+    pending_index_.clear();
     num_pending_ = 0;
   }
 
@@ -62,6 +62,11 @@ class SQLitePersistentCookieStorePerfTest : public testing::Test {
 
   virtual void SetUp() OVERRIDE {
     ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  // Writes |num_domains| * |cookies_per_domain| cookies to the database, and
+  // creates a new |store_| for it that hasn't loaded anything yet.
+  void CreateStoreWithCookies(int num_domains, int cookies_per_domain) {
     store_ = new SQLitePersistentCookieStore(
         temp_dir_.path().Append(cookie_filename),
         client_task_runner(),
@@ -70,12 +75,11 @@ class SQLitePersistentCookieStorePerfTest : public testing::Test {
     std::vector<net::CanonicalCookie*> cookies;
     Load();
     ASSERT_EQ(0u, cookies_.size());
-    // Creates 15000 cookies from 300 eTLD+1s.
     base::Time t = base::Time::Now();
-    for (int domain_num = 0; domain_num < 300; domain_num++) {
+    for (int domain_num = 0; domain_num < num_domains; domain_num++) {
       std::string domain_name(base::StringPrintf(".domain_%d.com", domain_num));
       GURL gurl("www" + domain_name);
-      for (int cookie_num = 0; cookie_num < 50; ++cookie_num) {
+      for (int cookie_num = 0; cookie_num < cookies_per_domain; ++cookie_num) {
         t += base::TimeDelta::FromInternalValue(10);
         store_->AddCookie(
             net::CanonicalCookie(gurl,
@@ -116,6 +120,8 @@ class SQLitePersistentCookieStorePerfTest : public testing::Test {
 
 // Test the performance of priority load of cookies for a specfic domain key
 TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadForKeyPerformance) {
+  // Creates 15000 cookies from 300 eTLD+1s.
+  CreateStoreWithCookies(300, 50);
   for (int domain_num = 0; domain_num < 3; ++domain_num) {
     std::string domain_name(base::StringPrintf("domain_%d.com", domain_num));
     base::PerfTimeLogger timer(
@@ -132,6 +138,7 @@ TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadForKeyPerformance) {
 
 // Test the performance of load
 TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadPerformance) {
+  CreateStoreWithCookies(300, 50);
   base::PerfTimeLogger timer("Load all cookies");
   Load();
   timer.Done();
@@ -139,4 +146,26 @@ TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadPerformance) {
   ASSERT_EQ(15000U, cookies_.size());
 }
 
+// Test the startup latency with a large cookie jar: the time until the cookies
+// for the first page are available, while the full load is in progress, and
+// the time until everything is loaded.
+TEST_F(SQLitePersistentCookieStorePerfTest, TestStartupPerformance) {
+  // Creates 50000 cookies from 2500 eTLD+1s.
+  CreateStoreWithCookies(2500, 20);
+
+  base::PerfTimeLogger load_timer("Startup load all of 50000 cookies");
+  base::PerfTimeLogger key_timer("Startup load first eTLD+1 of 50000 cookies");
+  store_->Load(base::Bind(&SQLitePersistentCookieStorePerfTest::OnLoaded,
+                          base::Unretained(this)));
+  store_->LoadCookiesForKey("domain_2000.com",
+      base::Bind(&SQLitePersistentCookieStorePerfTest::OnKeyLoaded,
+                 base::Unretained(this)));
+  key_loaded_event_.Wait();
+  key_timer.Done();
+  ASSERT_EQ(20U, cookies_.size());
+
+  loaded_event_.Wait();
+  load_timer.Done();
+}
+
 }  // namespace content
@@ -250,7 +250,7 @@ TEST_F(SQLitePersistentCookieStoreTest, TestLoadCookiesForKey) {
   // (active:)
   // 1. Wait (on db_event)
   // (pending:)
-  // 2. "Init And Chain-Load First Domain"
+  // 2. "Init" (posts "Chain-Load" behind 4.)
   // 3. Priority Load (aaa.com)
   // 4. Wait (on db_event)
   db_thread_event_.Signal();
@@ -308,6 +308,51 @@ TEST_F(SQLitePersistentCookieStoreTest, TestFlush) {
   ASSERT_GT(info.size, base_size);
 }
 
+// Test that operations on a cookie that is waiting to be written are merged,
+// and that the result on disk is the same as applying them one by one.
+TEST_F(SQLitePersistentCookieStoreTest, TestMergePendingOperations) {
+  InitializeStore(false);
+  base::Time t = base::Time::Now();
+  base::Time expiry = t + base::TimeDelta::FromDays(1);
+  net::CanonicalCookie kept(GURL(), "A", "B", "foo.bar", "/", t, expiry, t,
+                            false, false, net::COOKIE_PRIORITY_DEFAULT);
+  net::CanonicalCookie deleted(GURL(), "C", "D", "foo.bar", "/",
+                               t + base::TimeDelta::FromInternalValue(10),
+                               expiry, t, false, false,
+                               net::COOKIE_PRIORITY_DEFAULT);
+
+  store_->AddCookie(kept);
+  store_->AddCookie(deleted);
+  for (int i = 1; i <= 10; ++i) {
+    kept.SetLastAccessDate(t + base::TimeDelta::FromSeconds(i));
+    store_->UpdateCookieAccessTime(kept);
+  }
+  store_->DeleteCookie(deleted);
+  Flush();
+
+  // The cookie is in the database now.
+  kept.SetLastAccessDate(t + base::TimeDelta::FromSeconds(20));
+  store_->UpdateCookieAccessTime(kept);
+  store_->UpdateCookieAccessTime(kept);
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("A", cookies[0]->Name());
+  EXPECT_EQ(kept.LastAccessDate(), cookies[0]->LastAccessDate());
+  STLDeleteElements(&cookies);
+
+  // Deleting a cookie that is stored cancels a pending update.
+  kept.SetLastAccessDate(t + base::TimeDelta::FromSeconds(30));
+  store_->UpdateCookieAccessTime(kept);
+  store_->DeleteCookie(kept);
+  DestroyStore();
+
+  CreateAndLoad(false, &cookies);
+  EXPECT_EQ(0U, cookies.size());
+}
+
 // Test loading old session cookies from the disk.
 TEST_F(SQLitePersistentCookieStoreTest, TestLoadOldSessionCookies) {
   InitializeStore(true);
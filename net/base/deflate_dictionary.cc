@@ -0,0 +1,122 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/deflate_dictionary.h"
+
+namespace net {
+
+const char kDeflateDictionaryEncoding[] = "x-deflate-dict";
+
+// DEFLATE codes nearer matches in fewer bits, so the most common strings come
+// last.  Do not edit: encoders and decoders must agree on every byte.
+const char kDeflateDictionary[] =
+    // Less common markup and metadata.
+    "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\" "
+    "\"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">\n"
+    "<html xmlns=\"http://www.w3.org/1999/xhtml\" "
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 "
+    "<meta http-equiv=\"X-UA-Compatible\" content=\"IE=edge\">\n"
+    "<meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\">\n"
+    "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n"
+    "<meta name=\"description\" content=\"<meta name=\"keywords\" content=\""
+    "<meta property=\"og:title\" content=\"<meta property=\"og:image\" "
+    "<link rel=\"shortcut icon\" href=\"/favicon.ico\" "
+    "<link rel=\"canonical\" href=\"<link rel=\"alternate\" "
+    "type=\"application/rss+xml\" <link rel=\"stylesheet\" type=\"text/css\" "
+    "<iframe src=\"frameborder=\"0\" allowfullscreen></iframe>"
+    "<noscript></noscript><textarea name=\"</textarea><select name=\""
+    "<option value=\"</option></select><fieldset><legend></legend>"
+    "<table cellpadding=\"0\" cellspacing=\"0\" border=\"0\" width=\"100%\">"
+    "<thead></thead><tbody></tbody><tr><th></th><td colspan=\"2\" "
+    "</td></tr></table><blockquote></blockquote><pre><code></code></pre>"
+    "<strong></strong><em></em><small></small><sup></sup><br /><hr />"
+    "<h1></h1><h2></h2><h3></h3><h4></h4><h5></h5><h6></h6>"
+    "<header></header><footer></footer><nav></nav><section></section>"
+    "<article></article><aside></aside><main></main><label for=\""
+    "<button type=\"submit\" </button><form action=\"\" method=\"post\" "
+    "method=\"get\" enctype=\"multipart/form-data\" autocomplete=\"off\" "
+    "<input type=\"hidden\" name=\"<input type=\"text\" "
+    "<input type=\"checkbox\" placeholder=\"tabindex=\"-1\" "
+    "aria-hidden=\"true\" aria-label=\"role=\"button\" target=\"_blank\" "
+    "rel=\"nofollow\" title=\"alt=\"\" width=\"height=\"data-id=\""
+    "onclick=\"return false;\" onload=\"style=\"display:none\" "
+    "async defer crossorigin=\"anonymous\" integrity=\"sha256-"
+    "&nbsp;&amp;&quot;&lt;&gt;&copy;&raquo;&laquo;&middot;&#8217;&mdash;"
+    "Copyright (c) All rights reserved. Privacy Policy Terms of Service "
+    "Contact Us About Us Home Search Login Sign in Sign up Register "
+    "Read more Next Previous Page Share on Facebook Twitter "
+    // CSS.
+    "@charset \"UTF-8\";@import url(@font-face{font-family:@media screen and "
+    "(max-width:(min-width:px){@media print{@-webkit-keyframes @keyframes "
+    "!important;-webkit-transition:all .3s ease;transition:-moz-transform:"
+    "-ms-filter:progid:DXImageTransform.Microsoft.gradient(filter:alpha("
+    "opacity=-webkit-box-shadow:0 1px 2px rgba(0,0,0,.box-shadow:0 0 "
+    "-webkit-border-radius:-moz-border-radius:border-radius:3px;"
+    "-webkit-linear-gradient(top,linear-gradient(to bottom,"
+    "background-image:url(data:image/png;base64,background-repeat:no-repeat;"
+    "background-position:center center;background-size:cover;"
+    "background-color:transparent;background:#fff;background:none;"
+    "text-decoration:none;text-decoration:underline;text-transform:uppercase;"
+    "text-align:center;text-align:left;text-align:right;vertical-align:middle;"
+    "white-space:nowrap;text-overflow:ellipsis;word-wrap:break-word;"
+    "list-style:none;list-style-type:none;outline:0;overflow:hidden;"
+    "overflow:auto;visibility:hidden;cursor:pointer;z-index:1000;"
+    "box-sizing:border-box;-webkit-box-sizing:border-box;"
+    "position:absolute;position:relative;position:fixed;top:0;left:0;right:0;"
+    "bottom:0;float:left;float:right;clear:both;display:inline-block;"
+    "display:block;display:none;display:inline;display:flex;"
+    "font-family:Arial,Helvetica,sans-serif;font-family:\"Helvetica Neue\","
+    "font-weight:bold;font-weight:normal;font-style:italic;font-size:12px;"
+    "font-size:14px;font-size:16px;line-height:1.5;line-height:20px;"
+    "letter-spacing:color:#000;color:#333;color:#666;color:#999;color:#fff;"
+    "border:1px solid #ccc;border:1px solid #ddd;border:0;border-bottom:1px "
+    "solid #border-top:border-left:border-right:border-collapse:collapse;"
+    "height:100%;width:100%;max-width:min-height:max-height:height:auto;"
+    "margin:0 auto;margin:0;padding:0;margin-top:margin-bottom:margin-left:"
+    "margin-right:padding-top:padding-bottom:padding-left:padding-right:"
+    "opacity:0;opacity:1;content:\"\";transform:translate(:hover{:focus{"
+    ":before{:after{:first-child{:last-child{:nth-child(:active{:visited{"
+    // JavaScript.
+    "/*! jQuery v | (c) jQuery Foundation | jquery.org/license */"
+    "\"use strict\";Object.prototype.hasOwnProperty.call(Array.prototype."
+    "slice.call(arguments,Object.defineProperty(exports,\"__esModule\","
+    "module.exports=require(\"Object.keys(JSON.stringify(JSON.parse("
+    "encodeURIComponent(decodeURIComponent(Math.floor(Math.random()*Math.max("
+    "Math.min(parseInt(parseFloat(isNaN(setTimeout(function(){clearTimeout("
+    "setInterval(new Date().getTime()new RegExp(new Error(throw new Error(\""
+    "document.getElementById(\"document.getElementsByTagName(\""
+    "document.querySelector(\"document.querySelectorAll(\""
+    "document.createElement(\"document.cookie document.documentElement."
+    "document.body.appendChild(.parentNode.removeChild(.setAttribute(\""
+    ".getAttribute(\".addEventListener(\"click\",function(e){"
+    ".addEventListener(\"load\",.removeEventListener(\"DOMContentLoaded\""
+    "window.location.href=window.addEventListener(\"window.navigator.userAgent"
+    "XMLHttpRequest.open(\"GET\",.send(null);.readyState==4&&.status==200"
+    "e.preventDefault();e.stopPropagation();.innerHTML=.textContent="
+    ".className+=\" .style.display=\"none\";.classList.add(\".classList.remove(\""
+    "console.log(.prototype.constructor=.apply(this,arguments).call(this,"
+    ".push(.join(\"\").split(\".replace(/.indexOf(\".substring(.toLowerCase()"
+    ".length;i++){for(var i=0;i<if(typeof ===\"undefined\"===\"function\""
+    "===\"object\"===\"string\"!==null&&return!1}return!0}instanceof "
+    "try{}catch(e){}finally{}switch(case default:break;continue;do{}while("
+    "void 0:null,this.var self=this;var that=this;prototype:"
+    "(function($){$(document).ready(function(){})(jQuery);$(this)."
+    ".on(\"click\",function(){.each(function(){$.ajax({url:type:\"POST\","
+    "dataType:\"json\",success:function(data){error:function(){"
+    "function(e,t,n){var r=function(){return e&&e.length}"
+    "})();}();},{}};\n"
+    // The most common markup.
+    "<script type=\"text/javascript\" src=\"</script>\n<script>"
+    "<link rel=\"stylesheet\" href=\"<style type=\"text/css\"></style>\n"
+    "<!DOCTYPE html>\n<html lang=\"en\"><head><meta charset=\"utf-8\">"
+    "<title></title></head>\n<body></body></html>\n"
+    "<img src=\"<span class=\"</span><ul class=\"<li class=\"</li></ul>"
+    "<p class=\"</p>\n<a href=\"https://www.</a><a href=\"http://www."
+    "<a href=\"/<a class=\"<div id=\"<div class=\"</div>\n</div></div>"
+    ".html\" .php?.js\"></script>.css\" type=\"text/css\" />"
+    ".png\" .jpg\" .gif\" .svg\" .com/\">\n";
+
+const size_t kDeflateDictionarySize = sizeof(kDeflateDictionary) - 1;
+
+}  // namespace net
@@ -0,0 +1,34 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The "x-deflate-dict" content encoding is a raw DEFLATE stream (RFC 1951),
+// like the body of "deflate" without its zlib wrapper, compressed with a
+// static dictionary preset into its window.  The dictionary holds strings
+// common in HTML, JavaScript and CSS, so that even small responses compress
+// well, and decoding costs no more than inflate.
+//
+// Unlike SDCH, there is no dictionary to fetch, advertise or keep: it is
+// built in, and must never change.  A different dictionary needs a new
+// content encoding name.
+
+#ifndef NET_BASE_DEFLATE_DICTIONARY_H_
+#define NET_BASE_DEFLATE_DICTIONARY_H_
+
+#include <stddef.h>
+
+#include "net/base/net_export.h"
+
+namespace net {
+
+// The name of the content encoding, as used in Accept-Encoding and
+// Content-Encoding headers.
+NET_EXPORT_PRIVATE extern const char kDeflateDictionaryEncoding[];
+
+// The dictionary, and its size in bytes.  It is not NUL terminated.
+NET_EXPORT_PRIVATE extern const char kDeflateDictionary[];
+NET_EXPORT_PRIVATE extern const size_t kDeflateDictionarySize;
+
+}  // namespace net
+
+#endif  // NET_BASE_DEFLATE_DICTIONARY_H_
@@ -254,6 +254,33 @@ TEST(ExpiringCacheTest, GetTruncatesExpiredEntries) {
   EXPECT_EQ(6U, cache.size());
 }
 
+TEST(ExpiringCacheTest, GetIncludingExpired) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  Cache cache(kMaxCacheEntries);
+
+  // Start at t=0.
+  base::TimeTicks now;
+  base::TimeTicks expiration;
+  EXPECT_FALSE(cache.GetIncludingExpired("test", &expiration));
+
+  cache.Put("test", "foo", now, now + kTTL);
+  EXPECT_THAT(cache.GetIncludingExpired("test", &expiration),
+              Pointee(StrEq("foo")));
+  EXPECT_EQ(now + kTTL, expiration);
+
+  // The entry is still returned, and kept, once it has expired.
+  now += 2 * kTTL;
+  EXPECT_THAT(cache.GetIncludingExpired("test", &expiration),
+              Pointee(StrEq("foo")));
+  EXPECT_EQ(1U, cache.size());
+
+  // Get() removes it.
+  EXPECT_FALSE(cache.Get("test", now));
+  EXPECT_FALSE(cache.GetIncludingExpired("test", &expiration));
+  EXPECT_EQ(0U, cache.size());
+}
+
 TEST(ExpiringCacheTest, CustomFunctor) {
   ExpiringCache<std::string, std::string, std::string, TestFunctor> cache(5);
 
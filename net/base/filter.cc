@@ -6,6 +6,7 @@
 
 #include "base/files/file_path.h"
 #include "base/strings/string_util.h"
+#include "net/base/deflate_dictionary.h"
 #include "net/base/gzip_filter.h"
 #include "net/base/io_buffer.h"
 #include "net/base/mime_util.h"
@@ -137,6 +138,8 @@ Filter::FilterType Filter::ConvertEncodingToType(
   FilterType type_id;
   if (LowerCaseEqualsASCII(filter_type, kDeflate)) {
     type_id = FILTER_TYPE_DEFLATE;
+  } else if (LowerCaseEqualsASCII(filter_type, kDeflateDictionaryEncoding)) {
+    type_id = FILTER_TYPE_DEFLATE_DICTIONARY;
   } else if (LowerCaseEqualsASCII(filter_type, kGZip) ||
              LowerCaseEqualsASCII(filter_type, kXGZip)) {
     type_id = FILTER_TYPE_GZIP;
@@ -364,6 +367,7 @@ Filter* Filter::PrependNewFilter(FilterType type_id,
   switch (type_id) {
     case FILTER_TYPE_GZIP_HELPING_SDCH:
     case FILTER_TYPE_DEFLATE:
+    case FILTER_TYPE_DEFLATE_DICTIONARY:
     case FILTER_TYPE_GZIP:
       first_filter.reset(InitGZipFilter(type_id, buffer_size));
       break;
@@ -121,6 +121,7 @@ class NET_EXPORT_PRIVATE Filter {
   // Specifies type of filters that can be created.
   enum FilterType {
     FILTER_TYPE_DEFLATE,
+    FILTER_TYPE_DEFLATE_DICTIONARY,
     FILTER_TYPE_GZIP,
     FILTER_TYPE_GZIP_HELPING_SDCH,  // Gzip possible, but pass through allowed.
     FILTER_TYPE_SDCH,
@@ -17,6 +17,10 @@ TEST(FilterTest, ContentTypeId) {
             Filter::ConvertEncodingToType("deflate"));
   EXPECT_EQ(Filter::FILTER_TYPE_DEFLATE,
             Filter::ConvertEncodingToType("deflAte"));
+  EXPECT_EQ(Filter::FILTER_TYPE_DEFLATE_DICTIONARY,
+            Filter::ConvertEncodingToType("x-deflate-dict"));
+  EXPECT_EQ(Filter::FILTER_TYPE_DEFLATE_DICTIONARY,
+            Filter::ConvertEncodingToType("X-Deflate-Dict"));
   EXPECT_EQ(Filter::FILTER_TYPE_GZIP,
             Filter::ConvertEncodingToType("gzip"));
   EXPECT_EQ(Filter::FILTER_TYPE_GZIP,
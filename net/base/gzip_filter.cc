@@ -4,18 +4,30 @@
 
 #include "net/base/gzip_filter.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
+#include "net/base/deflate_dictionary.h"
 #include "net/base/gzip_header.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
 
+// static
+bool GZipFilter::g_fast_inflate_enabled_ = true;
+
+// static
+bool GZipFilter::g_deflate_dictionary_enabled_ = false;
+
 GZipFilter::GZipFilter()
     : decoding_status_(DECODING_UNINITIALIZED),
       decoding_mode_(DECODE_MODE_UNKNOWN),
       gzip_header_status_(GZIP_CHECK_HEADER_IN_PROGRESS),
       zlib_header_added_(false),
       gzip_footer_bytes_(0),
+      use_inflate_buffer_(g_fast_inflate_enabled_),
+      inflate_buffer_offset_(0),
+      inflate_buffer_len_(0),
       possible_sdch_pass_through_(false) {
 }
 
@@ -43,6 +55,20 @@ bool GZipFilter::InitDecoding(Filter::FilterType filter_type) {
       decoding_mode_ = DECODE_MODE_DEFLATE;
       break;
     }
+    case Filter::FILTER_TYPE_DEFLATE_DICTIONARY: {
+      // A raw DEFLATE stream may have its dictionary set right away.
+      if (inflateInit2(zlib_stream_.get(), -MAX_WBITS) != Z_OK)
+        return false;
+      if (inflateSetDictionary(
+              zlib_stream_.get(),
+              bit_cast<const Bytef*>(&kDeflateDictionary[0]),
+              kDeflateDictionarySize) != Z_OK) {
+        inflateEnd(zlib_stream_.get());
+        return false;
+      }
+      decoding_mode_ = DECODE_MODE_DEFLATE_DICTIONARY;
+      break;
+    }
     case Filter::FILTER_TYPE_GZIP_HELPING_SDCH:
       possible_sdch_pass_through_ =  true;  // Needed to optionally help sdch.
       // Fall through to GZIP case.
@@ -69,6 +95,11 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
   if (!dest_buffer || !dest_len || *dest_len <= 0)
     return Filter::FILTER_ERROR;
 
+  // Hand out what is left of the last inflate into the output window before
+  // decoding any more.
+  if (inflate_buffer_len_ > 0)
+    return ReadInflateBuffer(dest_buffer, dest_len);
+
   if (decoding_status_ == DECODING_DONE) {
     if (GZIP_GET_INVALID_HEADER != gzip_header_status_)
       SkipGZipFooter();
@@ -123,8 +154,19 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
     }
   }
 
-  int dest_orig_size = *dest_len;
-  status = DoInflate(dest_buffer, dest_len);
+  // Small reads inflate into the output window instead, and are then served
+  // from it.
+  char* inflate_dest = dest_buffer;
+  int inflate_size = *dest_len;
+  if (use_inflate_buffer_ && inflate_size < kInflateBufferSize) {
+    if (!inflate_buffer_)
+      inflate_buffer_.reset(new char[kInflateBufferSize]);
+    inflate_dest = inflate_buffer_.get();
+    inflate_size = kInflateBufferSize;
+  }
+
+  int inflate_len = inflate_size;
+  status = DoInflate(inflate_dest, &inflate_len);
 
   if (decoding_mode_ == DECODE_MODE_DEFLATE && status == Filter::FILTER_ERROR) {
     // As noted in Mozilla implementation, some servers such as Apache with
@@ -132,8 +174,8 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
     // See 677409 for instances where this work around is needed.
     // Insert a dummy zlib header and try again.
     if (InsertZlibHeader()) {
-      *dest_len = dest_orig_size;
-      status = DoInflate(dest_buffer, dest_len);
+      inflate_len = inflate_size;
+      status = DoInflate(inflate_dest, &inflate_len);
     }
   }
 
@@ -143,7 +185,14 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
     decoding_status_ = DECODING_ERROR;
   }
 
-  return status;
+  if (inflate_dest == dest_buffer || status == Filter::FILTER_ERROR) {
+    *dest_len = inflate_len;
+    return status;
+  }
+
+  inflate_buffer_offset_ = 0;
+  inflate_buffer_len_ = inflate_len;
+  return ReadInflateBuffer(dest_buffer, dest_len);
 }
 
 Filter::FilterStatus GZipFilter::CheckGZipHeader() {
@@ -281,7 +330,6 @@ bool GZipFilter::InsertZlibHeader() {
   return (code == Z_OK);
 }
 
-
 void GZipFilter::SkipGZipFooter() {
   int footer_bytes_expected = kGZipFooterSize - gzip_footer_bytes_;
   if (footer_bytes_expected > 0) {
@@ -295,4 +343,33 @@ void GZipFilter::SkipGZipFooter() {
   }
 }
 
+Filter::FilterStatus GZipFilter::ReadInflateBuffer(char* dest_buffer,
+                                                   int* dest_len) {
+  int copy_len = std::min(*dest_len, inflate_buffer_len_);
+  memcpy(dest_buffer, inflate_buffer_.get() + inflate_buffer_offset_,
+         copy_len);
+  inflate_buffer_offset_ += copy_len;
+  inflate_buffer_len_ -= copy_len;
+  *dest_len = copy_len;
+
+  // Report the same status DoInflate would have, had dest_buffer been large
+  // enough to hold what is left.
+  if (inflate_buffer_len_ > 0)
+    return Filter::FILTER_OK;
+  if (decoding_status_ == DECODING_DONE)
+    return Filter::FILTER_DONE;
+  return stream_data_len_ > 0 ? Filter::FILTER_OK :
+                                Filter::FILTER_NEED_MORE_DATA;
+}
+
+// static
+void GZipFilter::EnableFastInflate(bool enabled) {
+  g_fast_inflate_enabled_ = enabled;
+}
+
+// static
+void GZipFilter::EnableDeflateDictionarySupport(bool enabled) {
+  g_deflate_dictionary_enabled_ = enabled;
+}
+
 }  // namespace net
@@ -7,7 +7,12 @@
 // wrapped with a gzip header, and with deflate encoding the content is in
 // a raw, headerless DEFLATE stream.
 //
-// Internally GZipFilter uses zlib inflate to do decoding.
+// GZipFilter also decodes the x-deflate-dict content encoding, a raw DEFLATE
+// stream with a built-in dictionary, see deflate_dictionary.h.
+//
+// Internally GZipFilter uses zlib inflate to do decoding.  When fast inflate
+// is enabled, reads into small destination buffers are served from a larger
+// output window, so that zlib decodes in fewer, larger calls.
 //
 // GZipFilter is a subclass of Filter. See the latter's header file filter.h
 // for sample usage.
@@ -31,8 +36,8 @@ class GZipFilter : public Filter {
 
   // Initializes filter decoding mode and internal control blocks.
   // Parameter filter_type specifies the type of filter, which corresponds to
-  // either gzip or deflate decoding. The function returns true if success and
-  // false otherwise.
+  // either gzip, deflate or x-deflate-dict decoding. The function returns true
+  // if success and false otherwise.
   // The filter can only be initialized once.
   bool InitDecoding(Filter::FilterType filter_type);
 
@@ -51,6 +56,19 @@ class GZipFilter : public Filter {
   virtual FilterStatus ReadFilteredData(char* dest_buffer,
                                         int* dest_len) OVERRIDE;
 
+  // Enables or disables inflating into an internal output window for all
+  // GZipFilters created afterwards.  Enabled by default.
+  static void EnableFastInflate(bool enabled);
+  static bool fast_inflate_enabled() { return g_fast_inflate_enabled_; }
+
+  // Enables or disables advertising the x-deflate-dict content encoding in
+  // the Accept-Encoding header of requests.  Disabled by default.  Responses
+  // with that encoding are decoded either way.
+  static void EnableDeflateDictionarySupport(bool enabled);
+  static bool deflate_dictionary_enabled() {
+    return g_deflate_dictionary_enabled_;
+  }
+
  private:
   enum DecodingStatus {
     DECODING_UNINITIALIZED,
@@ -62,6 +80,7 @@ class GZipFilter : public Filter {
   enum DecodingMode {
     DECODE_MODE_GZIP,
     DECODE_MODE_DEFLATE,
+    DECODE_MODE_DEFLATE_DICTIONARY,
     DECODE_MODE_UNKNOWN
   };
 
@@ -73,6 +92,10 @@ class GZipFilter : public Filter {
 
   static const int kGZipFooterSize = 8;
 
+  // Size of the output window used by fast inflate.  Reads into destination
+  // buffers at least this large are inflated directly.
+  static const int kInflateBufferSize = 64 * 1024;
+
   // Only to be instantiated by Filter::Factory.
   GZipFilter();
   friend class Filter;
@@ -105,6 +128,13 @@ class GZipFilter : public Filter {
   // Skip the 8 byte GZip footer after z_stream_end
   void SkipGZipFooter();
 
+  // Copies as much of the inflated data held in inflate_buffer_ as fits into
+  // dest_buffer, and returns the status ReadFilteredData should report.
+  FilterStatus ReadInflateBuffer(char* dest_buffer, int* dest_len);
+
+  static bool g_fast_inflate_enabled_;
+  static bool g_deflate_dictionary_enabled_;
+
   // Tracks the status of decoding.
   // This variable is initialized by InitDecoding and updated only by
   // ReadFilteredData.
@@ -134,6 +164,18 @@ class GZipFilter : public Filter {
   // DoInflate, with InsertZlibHeader being the exception as a workaround.
   scoped_ptr<z_stream> zlib_stream_;
 
+  // Whether reads into small buffers go through inflate_buffer_.  zlib only
+  // takes its fast decoding loop when it has at least 258 bytes of output
+  // space, so tiny reads otherwise decode a byte at a time.
+  bool use_inflate_buffer_;
+
+  // The output window of fast inflate, allocated on first use.  Holds
+  // inflate_buffer_len_ bytes of inflated data not yet read, starting at
+  // inflate_buffer_offset_.
+  scoped_ptr<char[]> inflate_buffer_;
+  int inflate_buffer_offset_;
+  int inflate_buffer_len_;
+
   // For robustness, when we see the solo sdch filter, we chain in a gzip filter
   // in front of it, with this flag to indicate that the gzip decoding might not
   // be needed.  This handles a strange case where "Content-Encoding: sdch,gzip"
@@ -0,0 +1,218 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "net/base/deflate_dictionary.h"
+#include "net/base/filter.h"
+#include "net/base/gzip_filter.h"
+#include "net/base/io_buffer.h"
+#include "net/base/mock_filter_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+const int kNumIterations = 100;
+
+// Builds a corpus of bodies that resemble typical HTML, JS and CSS responses.
+std::vector<std::string> MakeCorpus() {
+  std::vector<std::string> corpus;
+
+  std::string html("<!DOCTYPE html><html><head><title>Test</title>"
+                   "<link rel=\"stylesheet\" href=\"/s.css\"></head><body>\n");
+  for (int i = 0; html.size() < 150 * 1024; ++i) {
+    base::StringAppendF(
+        &html,
+        "<div class=\"result\" id=\"r%d\"><h3><a href=\"http://www.example.com/"
+        "search?q=item%d&amp;start=%d\">Result number %d</a></h3><span "
+        "class=\"snippet\">Some text about item %d, and more %d</span></div>\n",
+        i, i * 7, i % 10, i, i % 31, i * 13);
+  }
+  html.append("</body></html>\n");
+  corpus.push_back(html);
+
+  std::string js("(function(){var g=this;\n");
+  for (int i = 0; js.size() < 250 * 1024; ++i) {
+    base::StringAppendF(
+        &js,
+        "function f%d(a,b){if(!a||typeof a.length!=\"number\")return null;"
+        "for(var c=0,d=[];c<a.length;c++)d.push(b(a[c],%d));return d}\n"
+        "g.module%d={init:f%d,name:\"module_%d\",flags:%d};\n",
+        i, i % 7, i % 97, i, i, i * 2654435 % 1024);
+  }
+  js.append("})();\n");
+  corpus.push_back(js);
+
+  std::string css;
+  for (int i = 0; css.size() < 60 * 1024; ++i) {
+    base::StringAppendF(
+        &css,
+        ".rule-%d { margin: %dpx 0 %dpx; color: #%06x; font: 13px arial; }\n"
+        ".rule-%d:hover { background-color: #%06x; }\n",
+        i, i % 17, i % 5, i * 2654435 & 0xffffff, i, i * 40503 & 0xffffff);
+  }
+  corpus.push_back(css);
+
+  return corpus;
+}
+
+// Returns |body| compressed with |type|, which is either FILTER_TYPE_GZIP or
+// FILTER_TYPE_DEFLATE_DICTIONARY, as a server would send it.
+std::string Compress(Filter::FilterType type, const std::string& body) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (type == Filter::FILTER_TYPE_GZIP) {
+    EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                 MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY));
+  } else {
+    EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                 -MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+    EXPECT_EQ(Z_OK, deflateSetDictionary(
+        &stream, bit_cast<const Bytef*>(&kDeflateDictionary[0]),
+        kDeflateDictionarySize));
+  }
+  std::string compressed(deflateBound(&stream, body.size()) + 32, '\0');
+  stream.next_in = bit_cast<Bytef*>(body.data());
+  stream.avail_in = body.size();
+  stream.next_out = bit_cast<Bytef*>(&compressed[0]);
+  stream.avail_out = compressed.size();
+  EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  compressed.resize(compressed.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return compressed;
+}
+
+// Runs |compressed| through a filter chain of |type| the way URLRequestJob
+// does, feeding it network-sized chunks and reading it out |read_size| bytes
+// at a time.  Returns the number of bytes decoded.
+size_t Decode(Filter::FilterType type,
+              const std::string& compressed,
+              int read_size) {
+  MockFilterContext filter_context;
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(type);
+  scoped_ptr<Filter> filter(Filter::Factory(filter_types, filter_context));
+  scoped_ptr<char[]> output(new char[read_size]);
+
+  size_t decoded = 0;
+  size_t offset = 0;
+  Filter::FilterStatus status = Filter::FILTER_NEED_MORE_DATA;
+  while (status != Filter::FILTER_DONE) {
+    if (status == Filter::FILTER_NEED_MORE_DATA) {
+      if (offset == compressed.size())
+        break;
+      int len = std::min(filter->stream_buffer_size(),
+                         static_cast<int>(compressed.size() - offset));
+      memcpy(filter->stream_buffer()->data(), compressed.data() + offset, len);
+      filter->FlushStreamBuffer(len);
+      offset += len;
+    }
+    int output_len = read_size;
+    status = filter->ReadData(output.get(), &output_len);
+    if (status == Filter::FILTER_ERROR)
+      break;
+    decoded += output_len;
+  }
+  return decoded;
+}
+
+void RunTest(int read_size) {
+  std::vector<std::string> corpus = MakeCorpus();
+  std::vector<std::string> compressed;
+  size_t total_size = 0;
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    compressed.push_back(Compress(Filter::FILTER_TYPE_GZIP, corpus[i]));
+    total_size += corpus[i].size();
+  }
+
+  for (int fast_inflate = 0; fast_inflate < 2; ++fast_inflate) {
+    GZipFilter::EnableFastInflate(fast_inflate != 0);
+    std::string name = base::StringPrintf(
+        "GZipFilter_read_%d_%s", read_size, fast_inflate ? "fast" : "direct");
+    size_t decoded = 0;
+    base::PerfTimeLogger timer(name.c_str());
+    for (int i = 0; i < kNumIterations; ++i) {
+      for (size_t j = 0; j < compressed.size(); ++j)
+        decoded += Decode(Filter::FILTER_TYPE_GZIP, compressed[j], read_size);
+    }
+    timer.Done();
+    EXPECT_EQ(total_size * kNumIterations, decoded);
+  }
+  GZipFilter::EnableFastInflate(true);
+}
+
+// Compares the bytes on the wire and the decoding time of gzip and
+// x-deflate-dict, on the whole corpus and on its first |prefix_size| bytes, as
+// for small responses.
+void RunDeflateDictionaryTest(const char* name, size_t prefix_size) {
+  std::vector<std::string> corpus = MakeCorpus();
+  const Filter::FilterType kTypes[] = {
+    Filter::FILTER_TYPE_GZIP, Filter::FILTER_TYPE_DEFLATE_DICTIONARY
+  };
+  const char* const kTypeNames[] = { "gzip", "deflate_dict" };
+  for (size_t i = 0; i < arraysize(kTypes); ++i) {
+    std::vector<std::string> compressed;
+    size_t raw_size = 0;
+    size_t wire_size = 0;
+    for (size_t j = 0; j < corpus.size(); ++j) {
+      std::string body = corpus[j].substr(0, prefix_size);
+      compressed.push_back(Compress(kTypes[i], body));
+      raw_size += body.size();
+      wire_size += compressed.back().size();
+    }
+    base::LogPerfResult(
+        base::StringPrintf("GZipFilter_%s_%s_wire_size", name,
+                           kTypeNames[i]).c_str(),
+        wire_size, "bytes");
+
+    // Decode the same number of bytes whatever the size of the bodies.
+    const size_t kBytesToDecode = 64 * 1024 * 1024;
+    size_t iterations = kBytesToDecode / raw_size;
+    std::string timer_name = base::StringPrintf(
+        "GZipFilter_%s_%s_decode", name, kTypeNames[i]);
+    size_t decoded = 0;
+    base::PerfTimeLogger timer(timer_name.c_str());
+    for (size_t k = 0; k < iterations; ++k) {
+      for (size_t j = 0; j < compressed.size(); ++j)
+        decoded += Decode(kTypes[i], compressed[j], 32 * 1024);
+    }
+    timer.Done();
+    EXPECT_EQ(raw_size * iterations, decoded);
+  }
+}
+
+}  // namespace
+
+TEST(GZipFilterPerfTest, TinyReads) {
+  RunTest(128);
+}
+
+// Reads the size of those made by URLFetcher.
+TEST(GZipFilterPerfTest, SmallReads) {
+  RunTest(4096);
+}
+
+// Reads as large as the input buffer of the filter.
+TEST(GZipFilterPerfTest, LargeReads) {
+  RunTest(32 * 1024);
+}
+
+TEST(GZipFilterPerfTest, DeflateDictionary) {
+  RunDeflateDictionaryTest("whole", std::string::npos);
+}
+
+TEST(GZipFilterPerfTest, DeflateDictionarySmallResponses) {
+  RunDeflateDictionaryTest("2k", 2 * 1024);
+}
+
+}  // namespace net
@@ -8,6 +8,7 @@
 #include "base/file_util.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/path_service.h"
+#include "net/base/deflate_dictionary.h"
 #include "net/base/gzip_filter.h"
 #include "net/base/mock_filter_context.h"
 #include "net/base/io_buffer.h"
@@ -37,8 +38,9 @@ const char kGZipHeader[] = { '\037', '\213', '\010', '\000', '\000',
                              '\000', '\000', '\000', '\002', '\377' };
 
 enum EncodeMode {
-  ENCODE_GZIP,      // Wrap the deflate with a GZip header.
-  ENCODE_DEFLATE    // Raw deflate.
+  ENCODE_GZIP,              // Wrap the deflate with a GZip header.
+  ENCODE_DEFLATE,           // Raw deflate.
+  ENCODE_DEFLATE_DICTIONARY // Raw deflate with the built-in dictionary.
 };
 
 }  // namespace
@@ -52,6 +54,8 @@ class GZipUnitTest : public PlatformTest {
   virtual void SetUp() {
     PlatformTest::SetUp();
 
+    fast_inflate_was_enabled_ = GZipFilter::fast_inflate_enabled();
+
     deflate_encode_buffer_ = NULL;
     gzip_encode_buffer_ = NULL;
 
@@ -96,6 +100,8 @@ class GZipUnitTest : public PlatformTest {
     delete[] gzip_encode_buffer_;
     gzip_encode_buffer_ = NULL;
 
+    GZipFilter::EnableFastInflate(fast_inflate_was_enabled_);
+
     PlatformTest::TearDown();
   }
 
@@ -111,11 +117,16 @@ class GZipUnitTest : public PlatformTest {
     int code;
 
     // Initialize zlib
-    if (mode == ENCODE_GZIP) {
+    if (mode == ENCODE_GZIP || mode == ENCODE_DEFLATE_DICTIONARY) {
       code = deflateInit2(&zlib_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
                           -MAX_WBITS,
                           8,  // DEF_MEM_LEVEL
                           Z_DEFAULT_STRATEGY);
+      if (code == Z_OK && mode == ENCODE_DEFLATE_DICTIONARY) {
+        code = deflateSetDictionary(
+            &zlib_stream, bit_cast<const Bytef*>(&kDeflateDictionary[0]),
+            kDeflateDictionarySize);
+      }
     } else {
       code = deflateInit(&zlib_stream, Z_DEFAULT_COMPRESSION);
     }
@@ -244,6 +255,7 @@ class GZipUnitTest : public PlatformTest {
 
  private:
   MockFilterContext filter_context_;
+  bool fast_inflate_was_enabled_;
 };
 
 // Basic scenario: decoding deflate data with big enough buffer.
@@ -320,6 +332,107 @@ TEST_F(GZipUnitTest, DecodeWithOneByteInputAndOutputBuffer) {
                              gzip_encode_buffer_, gzip_encode_len_, 1);
 }
 
+// Tests we can decode with small input and output buffers without fast
+// inflate, which inflates straight into the caller's buffer.
+TEST_F(GZipUnitTest, DecodeWithoutFastInflate) {
+  GZipFilter::EnableFastInflate(false);
+  InitFilterWithBufferSize(Filter::FILTER_TYPE_GZIP, kSmallBufferSize);
+  DecodeAndCompareWithFilter(filter_.get(), source_buffer(), source_len(),
+                             gzip_encode_buffer_, gzip_encode_len_,
+                             kSmallBufferSize);
+
+  InitFilterWithBufferSize(Filter::FILTER_TYPE_DEFLATE, 1);
+  DecodeAndCompareWithFilter(filter_.get(), source_buffer(), source_len(),
+                             deflate_encode_buffer_, deflate_encode_len_, 1);
+}
+
+// Tests decoding data which inflates to more than the fast inflate output
+// window holds, with output buffers of several sizes.
+TEST_F(GZipUnitTest, DecodeLargeData) {
+  std::string source;
+  while (source.size() < 512 * 1024)
+    source.append(source_buffer_);
+
+  int encode_len = static_cast<int>(source.size());
+  scoped_ptr<char[]> encode_buffer(new char[encode_len]);
+  ASSERT_EQ(Z_STREAM_END,
+            CompressAll(ENCODE_GZIP, source.data(),
+                        static_cast<int>(source.size()), encode_buffer.get(),
+                        &encode_len));
+
+  const int kOutputBufferSizes[] = { 1, 1000, 32 * 1024, 256 * 1024 };
+  for (size_t i = 0; i < arraysize(kOutputBufferSizes); ++i) {
+    for (int fast_inflate = 0; fast_inflate < 2; ++fast_inflate) {
+      GZipFilter::EnableFastInflate(fast_inflate != 0);
+      InitFilter(Filter::FILTER_TYPE_GZIP);
+
+      std::string decoded;
+      scoped_ptr<char[]> output(new char[kOutputBufferSizes[i]]);
+      const char* encode_next = encode_buffer.get();
+      int encode_avail_size = encode_len;
+      int code = Filter::FILTER_NEED_MORE_DATA;
+      while (code != Filter::FILTER_DONE) {
+        if (code == Filter::FILTER_NEED_MORE_DATA) {
+          ASSERT_GT(encode_avail_size, 0);
+          int encode_data_len = std::min(encode_avail_size,
+                                         filter_->stream_buffer_size());
+          memcpy(filter_->stream_buffer()->data(), encode_next,
+                 encode_data_len);
+          filter_->FlushStreamBuffer(encode_data_len);
+          encode_next += encode_data_len;
+          encode_avail_size -= encode_data_len;
+        }
+        int output_len = kOutputBufferSizes[i];
+        code = filter_->ReadData(output.get(), &output_len);
+        ASSERT_NE(Filter::FILTER_ERROR, code);
+        decoded.append(output.get(), output_len);
+      }
+      EXPECT_TRUE(decoded == source) << "output buffer size "
+                                     << kOutputBufferSizes[i];
+    }
+  }
+}
+
+// Tests decoding the x-deflate-dict encoding, which should also take less
+// space than deflate.
+TEST_F(GZipUnitTest, DecodeDeflateDictionary) {
+  char encode_buffer[kDefaultBufferSize];
+  int encode_len = kDefaultBufferSize;
+  ASSERT_EQ(Z_STREAM_END,
+            CompressAll(ENCODE_DEFLATE_DICTIONARY, source_buffer(),
+                        source_len(), encode_buffer, &encode_len));
+  EXPECT_LT(encode_len, deflate_encode_len_);
+
+  InitFilter(Filter::FILTER_TYPE_DEFLATE_DICTIONARY);
+  char decode_buffer[kDefaultBufferSize];
+  int decode_size = kDefaultBufferSize;
+  EXPECT_EQ(Filter::FILTER_DONE,
+            DecodeAllWithFilter(filter_.get(), encode_buffer, encode_len,
+                                decode_buffer, &decode_size));
+  EXPECT_EQ(source_len(), decode_size);
+  EXPECT_EQ(0, memcmp(source_buffer(), decode_buffer, source_len()));
+
+  InitFilterWithBufferSize(Filter::FILTER_TYPE_DEFLATE_DICTIONARY, 1);
+  DecodeAndCompareWithFilter(filter_.get(), source_buffer(), source_len(),
+                             encode_buffer, encode_len, 1);
+}
+
+// x-deflate-dict can't be decoded without the dictionary.
+TEST_F(GZipUnitTest, DecodeDeflateDictionaryWithoutDictionary) {
+  char encode_buffer[kDefaultBufferSize];
+  int encode_len = kDefaultBufferSize;
+  ASSERT_EQ(Z_STREAM_END,
+            CompressAll(ENCODE_DEFLATE_DICTIONARY, source_buffer(),
+                        source_len(), encode_buffer, &encode_len));
+
+  InitFilter(Filter::FILTER_TYPE_DEFLATE);
+  char decode_buffer[kDefaultBufferSize];
+  int decode_size = kDefaultBufferSize;
+  int code = DecodeAllWithFilter(filter_.get(), encode_buffer, encode_len,
+                                 decode_buffer, &decode_size);
+  EXPECT_EQ(Filter::FILTER_ERROR, code);
+}
+
 // Decoding deflate stream with corrupted data.
 TEST_F(GZipUnitTest, DecodeCorruptedData) {
   char corrupt_data[kDefaultBufferSize];
@@ -785,6 +785,10 @@ EVENT_TYPE(HTTP_CACHE_WRITE_INFO)
 EVENT_TYPE(HTTP_CACHE_READ_DATA)
 EVENT_TYPE(HTTP_CACHE_WRITE_DATA)
 
+// Logged when a stale entry is served under "stale-while-revalidate" and a
+// background revalidation of the entry is started.
+EVENT_TYPE(HTTP_CACHE_ASYNC_VALIDATION)
+
 // ------------------------------------------------------------------------
 // Disk Cache / Memory Cache
 // ------------------------------------------------------------------------
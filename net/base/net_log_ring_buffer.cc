@@ -0,0 +1,543 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace net {
+
+namespace {
+
+// The dump starts with this magic number, followed by the format version and
+// the offset of TimeTicks from the unix epoch at the time of the dump, both
+// as 4 and 8 byte little endian integers.  Then come the entries, each
+// prefixed by its length as a varint.
+const char kDumpMagic[] = "NLRB";
+const uint32 kDumpVersion = 1;
+
+// Each entry holds its time, as the 8 byte little endian internal value of
+// its TimeTicks, followed by varints of its type, source type, source id and
+// phase, then its parameters.
+const size_t kTimeSize = 8;
+
+// Tags of the encoded parameter values.  Each is followed by nothing for
+// TAG_NO_PARAMETERS, TAG_NULL, TAG_FALSE and TAG_TRUE, a zigzag varint for
+// TAG_INTEGER, 8 bytes for TAG_DOUBLE, a varint length and the bytes for
+// TAG_STRING, and a varint count and the values, with dictionary values
+// preceded by their keys as strings, for TAG_LIST and TAG_DICTIONARY.
+enum ValueTag {
+  TAG_NO_PARAMETERS,
+  TAG_NULL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_DOUBLE,
+  TAG_STRING,
+  TAG_LIST,
+  TAG_DICTIONARY,
+};
+
+// Guards against running out of stack on malformed dumps.
+const int kMaxValueDepth = 100;
+
+void WriteFixed(uint64 value, size_t size, std::string* out) {
+  for (size_t i = 0; i < size; ++i)
+    out->push_back(static_cast<char>(value >> (8 * i)));
+}
+
+void WriteVarint(uint64 value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void WriteString(const std::string& value, std::string* out) {
+  WriteVarint(value.size(), out);
+  out->append(value);
+}
+
+void WriteValue(const base::Value& value, std::string* out) {
+  switch (value.GetType()) {
+    case base::Value::TYPE_BOOLEAN: {
+      bool boolean = false;
+      value.GetAsBoolean(&boolean);
+      out->push_back(boolean ? TAG_TRUE : TAG_FALSE);
+      break;
+    }
+    case base::Value::TYPE_INTEGER: {
+      int integer = 0;
+      value.GetAsInteger(&integer);
+      out->push_back(TAG_INTEGER);
+      int64 wide = integer;
+      WriteVarint((static_cast<uint64>(wide) << 1) ^ (wide >> 63), out);
+      break;
+    }
+    case base::Value::TYPE_DOUBLE: {
+      double number = 0;
+      value.GetAsDouble(&number);
+      uint64 bits;
+      memcpy(&bits, &number, sizeof(bits));
+      out->push_back(TAG_DOUBLE);
+      WriteFixed(bits, 8, out);
+      break;
+    }
+    case base::Value::TYPE_STRING: {
+      std::string string;
+      value.GetAsString(&string);
+      out->push_back(TAG_STRING);
+      WriteString(string, out);
+      break;
+    }
+    case base::Value::TYPE_LIST: {
+      const base::ListValue* list = NULL;
+      value.GetAsList(&list);
+      out->push_back(TAG_LIST);
+      WriteVarint(list->GetSize(), out);
+      for (base::ListValue::const_iterator it = list->begin();
+           it != list->end(); ++it) {
+        WriteValue(**it, out);
+      }
+      break;
+    }
+    case base::Value::TYPE_DICTIONARY: {
+      const base::DictionaryValue* dict = NULL;
+      value.GetAsDictionary(&dict);
+      out->push_back(TAG_DICTIONARY);
+      WriteVarint(dict->size(), out);
+      for (base::DictionaryValue::Iterator it(*dict); !it.IsAtEnd();
+           it.Advance()) {
+        WriteString(it.key(), out);
+        WriteValue(it.value(), out);
+      }
+      break;
+    }
+    default:
+      // Binary values can't be written as JSON either.
+      out->push_back(TAG_NULL);
+      break;
+  }
+}
+
+// Encodes |entry| to |out|, replacing its contents.
+void EncodeEntry(const NetLog::Entry& entry, std::string* out) {
+  out->clear();
+  WriteFixed(static_cast<uint64>(entry.time().ToInternalValue()), kTimeSize,
+             out);
+  WriteVarint(entry.type(), out);
+  WriteVarint(entry.source().type, out);
+  WriteVarint(entry.source().id, out);
+  WriteVarint(entry.phase(), out);
+
+  // The parameters are only available as a Value.
+  scoped_ptr<base::Value> params(entry.ParametersToValue());
+  if (params)
+    WriteValue(*params, out);
+  else
+    out->push_back(TAG_NO_PARAMETERS);
+}
+
+// Reads the encoding written by the functions above.
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), end_(data + size) {}
+
+  bool IsAtEnd() const { return data_ == end_; }
+
+  bool ReadBytes(size_t size, const char** bytes) {
+    if (static_cast<size_t>(end_ - data_) < size)
+      return false;
+    *bytes = data_;
+    data_ += size;
+    return true;
+  }
+
+  bool ReadFixed(size_t size, uint64* value) {
+    const char* bytes;
+    if (!ReadBytes(size, &bytes))
+      return false;
+    *value = 0;
+    for (size_t i = 0; i < size; ++i)
+      *value |= static_cast<uint64>(static_cast<uint8>(bytes[i])) << (8 * i);
+    return true;
+  }
+
+  bool ReadVarint(uint64* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && data_ != end_; shift += 7) {
+      uint8 byte = static_cast<uint8>(*data_++);
+      *value |= static_cast<uint64>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadString(std::string* value) {
+    uint64 size;
+    const char* bytes;
+    if (!ReadVarint(&size) || size > static_cast<uint64>(end_ - data_) ||
+        !ReadBytes(size, &bytes)) {
+      return false;
+    }
+    value->assign(bytes, size);
+    return true;
+  }
+
+  // Reads the value of |tag|.  Returns NULL on failure.
+  base::Value* ReadValue(uint8 tag, int depth) {
+    if (depth > kMaxValueDepth)
+      return NULL;
+    switch (tag) {
+      case TAG_NULL:
+        return base::Value::CreateNullValue();
+      case TAG_FALSE:
+      case TAG_TRUE:
+        return new base::FundamentalValue(tag == TAG_TRUE);
+      case TAG_INTEGER: {
+        uint64 zigzag;
+        if (!ReadVarint(&zigzag))
+          return NULL;
+        int64 wide = static_cast<int64>(zigzag >> 1) ^ -static_cast<int64>(
+            zigzag & 1);
+        return new base::FundamentalValue(static_cast<int>(wide));
+      }
+      case TAG_DOUBLE: {
+        uint64 bits;
+        if (!ReadFixed(8, &bits))
+          return NULL;
+        double number;
+        memcpy(&number, &bits, sizeof(number));
+        return new base::FundamentalValue(number);
+      }
+      case TAG_STRING: {
+        std::string string;
+        if (!ReadString(&string))
+          return NULL;
+        return new base::StringValue(string);
+      }
+      case TAG_LIST: {
+        uint64 count;
+        if (!ReadVarint(&count))
+          return NULL;
+        scoped_ptr<base::ListValue> list(new base::ListValue());
+        for (uint64 i = 0; i < count; ++i) {
+          uint8 item_tag;
+          if (!ReadTag(&item_tag))
+            return NULL;
+          base::Value* item = ReadValue(item_tag, depth + 1);
+          if (!item)
+            return NULL;
+          list->Append(item);
+        }
+        return list.release();
+      }
+      case TAG_DICTIONARY: {
+        uint64 count;
+        if (!ReadVarint(&count))
+          return NULL;
+        scoped_ptr<base::DictionaryValue> dict(new base::DictionaryValue());
+        for (uint64 i = 0; i < count; ++i) {
+          std::string key;
+          uint8 item_tag;
+          if (!ReadString(&key) || !ReadTag(&item_tag))
+            return NULL;
+          base::Value* item = ReadValue(item_tag, depth + 1);
+          if (!item)
+            return NULL;
+          dict->SetWithoutPathExpansion(key, item);
+        }
+        return dict.release();
+      }
+      default:
+        return NULL;
+    }
+  }
+
+  bool ReadTag(uint8* tag) {
+    const char* bytes;
+    if (!ReadBytes(1, &bytes))
+      return false;
+    *tag = static_cast<uint8>(bytes[0]);
+    return true;
+  }
+
+ private:
+  const char* data_;
+  const char* end_;
+};
+
+// Returns the time of the encoded |entry|.
+int64 GetEntryTime(const std::string& entry) {
+  uint64 time;
+  Reader reader(entry.data(), entry.size());
+  bool result = reader.ReadFixed(kTimeSize, &time);
+  DCHECK(result);
+  return static_cast<int64>(time);
+}
+
+bool EntryTimeLess(const std::string* a, const std::string* b) {
+  return GetEntryTime(*a) < GetEntryTime(*b);
+}
+
+// Decodes |entry| to the Value NetLog::Entry::ToValue() would have returned.
+base::Value* EntryToValue(const std::string& entry) {
+  Reader reader(entry.data(), entry.size());
+  uint64 time, type, source_type, source_id, phase;
+  uint8 tag;
+  if (!reader.ReadFixed(kTimeSize, &time) || !reader.ReadVarint(&type) ||
+      !reader.ReadVarint(&source_type) || !reader.ReadVarint(&source_id) ||
+      !reader.ReadVarint(&phase) || !reader.ReadTag(&tag)) {
+    return NULL;
+  }
+
+  scoped_ptr<base::DictionaryValue> entry_dict(new base::DictionaryValue());
+  entry_dict->SetString("time", NetLog::TickCountToString(
+      base::TimeTicks::FromInternalValue(static_cast<int64>(time))));
+
+  base::DictionaryValue* source_dict = new base::DictionaryValue();
+  source_dict->SetInteger("id", static_cast<uint32>(source_id));
+  source_dict->SetInteger("type", static_cast<int>(source_type));
+  entry_dict->Set("source", source_dict);
+
+  entry_dict->SetInteger("type", static_cast<int>(type));
+  entry_dict->SetInteger("phase", static_cast<int>(phase));
+
+  if (tag != TAG_NO_PARAMETERS) {
+    base::Value* params = reader.ReadValue(tag, 0);
+    if (!params)
+      return NULL;
+    entry_dict->Set("params", params);
+  }
+  if (!reader.IsAtEnd())
+    return NULL;
+  return entry_dict.release();
+}
+
+// Returns what to add to a TimeTicks value in milliseconds to get the number
+// of milliseconds since the unix epoch, as in NetLogLogger::GetConstants().
+int64 GetTickToUnixTimeMs() {
+  int64 cur_time_ms = (base::Time::Now() - base::Time()).InMilliseconds();
+  int64 cur_time_ticks_ms =
+      (base::TimeTicks::Now() - base::TimeTicks()).InMilliseconds();
+  const int64 kUnixEpochMs = 11644473600000LL;
+  return cur_time_ms - cur_time_ticks_ms - kUnixEpochMs;
+}
+
+}  // namespace
+
+// A ring of encoded entries, added on one thread, or on a few once the
+// number of buffers is capped.  Each entry is prefixed by its length, as a 4
+// byte integer.
+class NetLogRingBuffer::ThreadBuffer {
+ public:
+  explicit ThreadBuffer(size_t size)
+      : buffer_(size), begin_(0), used_(0), last_add_time_(0) {}
+
+  // Encodes and adds |entry|, dropping the oldest entries to make room for it.
+  // Entries which don't fit in the whole buffer are dropped.
+  void Add(const NetLog::Entry& entry) {
+    base::AutoLock lock(lock_);
+    last_add_time_ = entry.time().ToInternalValue();
+
+    EncodeEntry(entry, &scratch_);
+    size_t size = sizeof(uint32) + scratch_.size();
+    if (size > buffer_.size())
+      return;
+
+    while (buffer_.size() - used_ < size) {
+      uint32 length;
+      Read(begin_, reinterpret_cast<char*>(&length), sizeof(length));
+      begin_ = (begin_ + sizeof(length) + length) % buffer_.size();
+      used_ -= sizeof(length) + length;
+    }
+    size_t end = (begin_ + used_) % buffer_.size();
+    uint32 length = scratch_.size();
+    Write(end, reinterpret_cast<const char*>(&length), sizeof(length));
+    Write((end + sizeof(length)) % buffer_.size(), scratch_.data(),
+          scratch_.size());
+    used_ += size;
+  }
+
+  // Returns the internal value of the time of the last entry added, or 0.
+  int64 last_add_time() const {
+    base::AutoLock lock(lock_);
+    return last_add_time_;
+  }
+
+  // Appends the entries held, oldest first, to |entries|.
+  void GetEntries(ScopedVector<std::string>* entries) const {
+    base::AutoLock lock(lock_);
+    size_t offset = begin_;
+    size_t remaining = used_;
+    while (remaining > 0) {
+      uint32 length;
+      Read(offset, reinterpret_cast<char*>(&length), sizeof(length));
+      offset = (offset + sizeof(length)) % buffer_.size();
+      std::string* entry = new std::string(length, '\0');
+      if (length > 0)
+        Read(offset, &(*entry)[0], length);
+      entries->push_back(entry);
+      offset = (offset + length) % buffer_.size();
+      remaining -= sizeof(length) + length;
+    }
+  }
+
+ private:
+  void Write(size_t offset, const char* data, size_t size) {
+    size_t first = std::min(size, buffer_.size() - offset);
+    memcpy(&buffer_[offset], data, first);
+    memcpy(&buffer_[0], data + first, size - first);
+  }
+
+  void Read(size_t offset, char* data, size_t size) const {
+    size_t first = std::min(size, buffer_.size() - offset);
+    memcpy(data, &buffer_[offset], first);
+    memcpy(data + first, &buffer_[0], size - first);
+  }
+
+  // Only contended while dumping, or when the buffer is shared.
+  mutable base::Lock lock_;
+  std::vector<char> buffer_;
+  // Offset of the oldest entry.
+  size_t begin_;
+  // Number of bytes of entries held.
+  size_t used_;
+  int64 last_add_time_;
+
+  // Scratch space to encode entries in.
+  std::string scratch_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+NetLogRingBuffer::NetLogRingBuffer(size_t buffer_size, size_t max_buffers)
+    : buffer_size_(buffer_size),
+      max_buffers_(max_buffers) {
+  DCHECK_GT(buffer_size, 0u);
+  DCHECK_GT(max_buffers, 0u);
+}
+
+NetLogRingBuffer::~NetLogRingBuffer() {
+}
+
+void NetLogRingBuffer::StartObserving(NetLog* net_log,
+                                      NetLog::LogLevel log_level) {
+  net_log->AddThreadSafeObserver(this, log_level);
+}
+
+void NetLogRingBuffer::StopObserving() {
+  net_log()->RemoveThreadSafeObserver(this);
+}
+
+void NetLogRingBuffer::Dump(std::string* data) const {
+  ScopedVector<std::string> entries;
+  {
+    base::AutoLock lock(lock_);
+    for (size_t i = 0; i < thread_buffers_.size(); ++i)
+      thread_buffers_[i]->GetEntries(&entries);
+  }
+  // Interleave the entries of the threads.  Those of each thread are already
+  // in order, so keep them that way.
+  std::stable_sort(entries.begin(), entries.end(), EntryTimeLess);
+
+  data->assign(kDumpMagic, 4);
+  WriteFixed(kDumpVersion, 4, data);
+  WriteFixed(static_cast<uint64>(GetTickToUnixTimeMs()), 8, data);
+  for (size_t i = 0; i < entries.size(); ++i)
+    WriteString(*entries[i], data);
+}
+
+// static
+bool NetLogRingBuffer::ConvertToJSON(const std::string& data,
+                                     const base::DictionaryValue& constants,
+                                     std::string* json) {
+  Reader reader(data.data(), data.size());
+  const char* magic;
+  uint64 version;
+  uint64 tick_to_unix_time_ms;
+  if (!reader.ReadBytes(4, &magic) || memcmp(magic, kDumpMagic, 4) != 0 ||
+      !reader.ReadFixed(4, &version) || version != kDumpVersion ||
+      !reader.ReadFixed(8, &tick_to_unix_time_ms)) {
+    return false;
+  }
+
+  // The times are relative to the TimeTicks of the process which dumped the
+  // log, not this one.
+  scoped_ptr<base::DictionaryValue> dump_constants(constants.DeepCopy());
+  dump_constants->SetString(
+      "timeTickOffset",
+      base::Int64ToString(static_cast<int64>(tick_to_unix_time_ms)));
+
+  // The same layout as NetLogLogger, one entry per line.
+  std::string constants_json;
+  base::JSONWriter::Write(dump_constants.get(), &constants_json);
+  json->assign("{\"constants\": ");
+  json->append(constants_json);
+  json->append(",\n\"events\": [\n");
+
+  bool added_events = false;
+  std::string entry;
+  std::string entry_json;
+  while (!reader.IsAtEnd()) {
+    if (!reader.ReadString(&entry))
+      return false;
+    scoped_ptr<base::Value> value(EntryToValue(entry));
+    if (!value)
+      return false;
+    base::JSONWriter::Write(value.get(), &entry_json);
+    if (added_events)
+      json->append(",\n");
+    json->append(entry_json);
+    added_events = true;
+  }
+  json->append("]}");
+  return true;
+}
+
+void NetLogRingBuffer::OnAddEntry(const NetLog::Entry& entry) {
+  GetThreadBuffer()->Add(entry);
+}
+
+NetLogRingBuffer::ThreadBuffer* NetLogRingBuffer::GetThreadBuffer() {
+  ThreadBuffer* buffer = thread_buffer_.Get();
+  if (buffer)
+    return buffer;
+
+  {
+    base::AutoLock lock(lock_);
+    if (thread_buffers_.size() < max_buffers_) {
+      buffer = new ThreadBuffer(buffer_size_);
+      thread_buffers_.push_back(buffer);
+    } else {
+      // Share the buffer written to least recently, so that the entries
+      // pushed out are the oldest ones.
+      buffer = thread_buffers_[0];
+      int64 oldest_time = buffer->last_add_time();
+      for (size_t i = 1; i < thread_buffers_.size(); ++i) {
+        int64 time = thread_buffers_[i]->last_add_time();
+        if (time < oldest_time) {
+          buffer = thread_buffers_[i];
+          oldest_time = time;
+        }
+      }
+    }
+  }
+  thread_buffer_.Set(buffer);
+  return buffer;
+}
+
+}  // namespace net
@@ -0,0 +1,90 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_NET_LOG_RING_BUFFER_H_
+#define NET_BASE_NET_LOG_RING_BUFFER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local.h"
+#include "net/base/net_export.h"
+#include "net/base/net_log.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace net {
+
+// NetLogRingBuffer watches the NetLog event stream, and keeps the most recent
+// entries in memory in a compact binary form, so that logging can be left on
+// at little cost and the log written out only when it is wanted.
+//
+// Each thread that adds entries gets a fixed-size buffer of its own, so that
+// the threads don't contend for a lock, and a busy thread doesn't push the
+// entries of the others out. When a buffer is full, its oldest entries are
+// dropped to make room. The number of buffers is capped: once it is reached,
+// a new thread shares the buffer that was written to least recently, most
+// likely the one of a thread which has exited.
+//
+// Dump() writes out the entries of all the buffers. ConvertToJSON() turns the
+// dump into the JSON format written by NetLogLogger, possibly in another
+// process, see net/tools/net_log_to_json.
+class NET_EXPORT NetLogRingBuffer : public NetLog::ThreadSafeObserver {
+ public:
+  // The buffer of each thread holds up to |buffer_size| bytes of entries, and
+  // there are at most |max_buffers| of them.
+  NetLogRingBuffer(size_t buffer_size, size_t max_buffers);
+  virtual ~NetLogRingBuffer();
+
+  // Starts observing |net_log| at |log_level|.  Must not already be watching a
+  // NetLog.
+  void StartObserving(NetLog* net_log, NetLog::LogLevel log_level);
+
+  // Stops observing net_log().  Must already be watching.
+  void StopObserving();
+
+  // Writes the entries held by all the buffers to |data|, oldest first.  May
+  // be called on any thread, while observing or after.
+  void Dump(std::string* data) const;
+
+  // Converts |data|, as written by Dump(), to the JSON format written by
+  // NetLogLogger, with |constants| as its legend (see
+  // NetLogLogger::GetConstants()).  Returns false if |data| is malformed.
+  static bool ConvertToJSON(const std::string& data,
+                            const base::DictionaryValue& constants,
+                            std::string* json);
+
+  // net::NetLog::ThreadSafeObserver implementation:
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE;
+
+ private:
+  class ThreadBuffer;
+
+  // Returns the buffer of the current thread, creating or picking one if
+  // needed.
+  ThreadBuffer* GetThreadBuffer();
+
+  const size_t buffer_size_;
+  const size_t max_buffers_;
+
+  base::ThreadLocalPointer<ThreadBuffer> thread_buffer_;
+
+  // Protects |thread_buffers_|.
+  mutable base::Lock lock_;
+
+  // The buffers of the threads which have added entries.  They outlive their
+  // threads, so that their entries can still be dumped, until they are shared
+  // with new threads.
+  ScopedVector<ThreadBuffer> thread_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogRingBuffer);
+};
+
+}  // namespace net
+
+#endif  // NET_BASE_NET_LOG_RING_BUFFER_H_
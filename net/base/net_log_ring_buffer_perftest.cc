@@ -0,0 +1,115 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdio.h>
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/base/net_log.h"
+#include "net/base/net_log_logger.h"
+#include "net/base/net_log_ring_buffer.h"
+#include "net/url_request/data_protocol_handler.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_job_factory_impl.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kNumRequests = 20000;
+const size_t kRingBufferSize = 4 * 1024 * 1024;
+const size_t kMaxRingBuffers = 16;
+
+class NetLogRingBufferPerfTest : public testing::Test {
+ public:
+  NetLogRingBufferPerfTest() : context_(true) {
+    context_.set_net_log(&net_log_);
+    job_factory_.SetProtocolHandler("data", new DataProtocolHandler);
+    context_.set_job_factory(&job_factory_);
+    context_.Init();
+  }
+
+ protected:
+  // Runs kNumRequests URLRequests, one at a time, timed as |name|.  Returns
+  // the time taken.
+  base::TimeDelta RunRequests(const char* name) {
+    const GURL url("data:text/plain,Hello%20world");
+    int bytes_received = 0;
+    base::PerfTimeLogger timer(name);
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kNumRequests; ++i) {
+      TestDelegate delegate;
+      URLRequest request(url, DEFAULT_PRIORITY, &delegate, &context_);
+      request.Start();
+      base::RunLoop().Run();
+      bytes_received += delegate.bytes_received();
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    timer.Done();
+    EXPECT_EQ(kNumRequests * 11, bytes_received);
+    return elapsed;
+  }
+
+  base::MessageLoopForIO message_loop_;
+  NetLog net_log_;
+  URLRequestJobFactoryImpl job_factory_;
+  TestURLRequestContext context_;
+};
+
+}  // namespace
+
+TEST_F(NetLogRingBufferPerfTest, NoLogging) {
+  RunRequests("URLRequest_NetLog_None");
+}
+
+TEST_F(NetLogRingBufferPerfTest, NetLogLogger) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  FILE* file = file_util::OpenFile(temp_dir.path().AppendASCII("net_log"),
+                                   "w");
+  ASSERT_TRUE(file);
+  scoped_ptr<base::Value> constants(NetLogLogger::GetConstants());
+  NetLogLogger logger(file, *constants);
+
+  logger.StartObserving(&net_log_);
+  RunRequests("URLRequest_NetLog_NetLogLogger");
+  logger.StopObserving();
+}
+
+TEST_F(NetLogRingBufferPerfTest, NetLogRingBuffer) {
+  NetLogRingBuffer ring_buffer(kRingBufferSize, kMaxRingBuffers);
+
+  // Compare against the same requests without an observer, run in the same
+  // process and state.
+  base::TimeDelta none = RunRequests("URLRequest_NetLog_None");
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+  base::TimeDelta logged = RunRequests("URLRequest_NetLog_NetLogRingBuffer");
+  ring_buffer.StopObserving();
+  base::LogPerfResult("URLRequest_NetLog_NetLogRingBuffer_overhead",
+                      (logged - none).InMillisecondsF() * 1000 / kNumRequests,
+                      "us/request");
+
+  std::string data;
+  {
+    base::PerfTimeLogger timer("NetLogRingBuffer_Dump");
+    ring_buffer.Dump(&data);
+    timer.Done();
+  }
+  base::LogPerfResult("NetLogRingBuffer_dump_size", data.size(), "bytes");
+}
+
+}  // namespace net
@@ -0,0 +1,251 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/threading/thread.h"
+#include "base/values.h"
+#include "net/base/net_log_logger.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxBuffers = 8;
+
+base::Value* NetLogTestParametersCallback(int index,
+                                          NetLog::LogLevel /* log_level */) {
+  base::DictionaryValue* dict = new base::DictionaryValue();
+  dict->SetInteger("index", index);
+  dict->SetInteger("negative", -index);
+  dict->SetString("string", "some \"quoted\" text");
+  dict->SetBoolean("odd", index % 2 == 1);
+  dict->SetDouble("double", index / 4.0);
+  dict->Set("null", base::Value::CreateNullValue());
+  base::ListValue* list = new base::ListValue();
+  list->AppendInteger(kint32max);
+  list->AppendInteger(kint32min);
+  list->Append(new base::DictionaryValue());
+  dict->Set("list", list);
+  return dict;
+}
+
+void AddEntries(NetLog* net_log, int first, int count) {
+  for (int i = first; i < first + count; ++i) {
+    if (i % 3 == 0) {
+      net_log->AddGlobalEntry(NetLog::TYPE_CANCELLED);
+    } else {
+      net_log->AddGlobalEntry(
+          NetLog::TYPE_CANCELLED,
+          base::Bind(&NetLogTestParametersCallback, i));
+    }
+  }
+}
+
+// Returns the "events" list of the log in |json|.
+scoped_ptr<base::Value> GetEvents(const std::string& json) {
+  base::JSONReader reader;
+  scoped_ptr<base::Value> root(reader.ReadToValue(json));
+  EXPECT_TRUE(root) << reader.GetErrorMessage();
+  base::DictionaryValue* dict;
+  scoped_ptr<base::Value> events;
+  if (root && root->GetAsDictionary(&dict))
+    dict->Remove("events", &events);
+  return events.Pass();
+}
+
+// Returns the "index" parameter of each entry of |events|, or -1 for entries
+// without parameters.
+std::vector<int> GetIndices(const base::Value& events) {
+  std::vector<int> indices;
+  const base::ListValue* list;
+  if (!events.GetAsList(&list))
+    return indices;
+  for (size_t i = 0; i < list->GetSize(); ++i) {
+    const base::DictionaryValue* event;
+    int index = -1;
+    if (list->GetDictionary(i, &event))
+      event->GetInteger("params.index", &index);
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+class NetLogRingBufferTest : public testing::Test {
+ public:
+  NetLogRingBufferTest() : constants_(NetLogLogger::GetConstants()) {}
+
+ protected:
+  // Returns the JSON of the log dumped by |ring_buffer|.
+  std::string DumpToJSON(const NetLogRingBuffer& ring_buffer) {
+    std::string data;
+    ring_buffer.Dump(&data);
+    std::string json;
+    EXPECT_TRUE(NetLogRingBuffer::ConvertToJSON(data, *constants_, &json));
+    return json;
+  }
+
+  NetLog net_log_;
+  scoped_ptr<base::DictionaryValue> constants_;
+};
+
+TEST_F(NetLogRingBufferTest, NoEvents) {
+  NetLogRingBuffer ring_buffer(1024, kMaxBuffers);
+  scoped_ptr<base::Value> events = GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(events);
+  EXPECT_TRUE(base::ListValue().Equals(events.get()));
+}
+
+// The converted log should have the same events as the one written by
+// NetLogLogger.
+TEST_F(NetLogRingBufferTest, SameEventsAsNetLogLogger) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath log_path = temp_dir.path().AppendASCII("NetLogFile");
+
+  NetLogRingBuffer ring_buffer(1024 * 1024, kMaxBuffers);
+  {
+    FILE* file = file_util::OpenFile(log_path, "w");
+    ASSERT_TRUE(file);
+    NetLogLogger logger(file, *constants_);
+    logger.StartObserving(&net_log_);
+    ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+    AddEntries(&net_log_, 0, 10);
+    ring_buffer.StopObserving();
+    logger.StopObserving();
+  }
+
+  std::string logger_json;
+  ASSERT_TRUE(base::ReadFileToString(log_path, &logger_json));
+  scoped_ptr<base::Value> logger_events = GetEvents(logger_json);
+  scoped_ptr<base::Value> ring_buffer_events =
+      GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(logger_events);
+  ASSERT_TRUE(ring_buffer_events);
+  EXPECT_TRUE(logger_events->Equals(ring_buffer_events.get()));
+  EXPECT_EQ(10u, GetIndices(*ring_buffer_events).size());
+}
+
+TEST_F(NetLogRingBufferTest, DropsOldestEvents) {
+  NetLogRingBuffer ring_buffer(2048, kMaxBuffers);
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+  AddEntries(&net_log_, 0, 1000);
+  ring_buffer.StopObserving();
+
+  scoped_ptr<base::Value> events = GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(events);
+  std::vector<int> indices = GetIndices(*events);
+  ASSERT_LT(10u, indices.size());
+  ASSERT_GT(1000u, indices.size());
+  // The most recent events are kept, in order.
+  int first = 1000 - indices.size();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    int index = first + i;
+    EXPECT_EQ(index % 3 == 0 ? -1 : index, indices[i]);
+  }
+}
+
+TEST_F(NetLogRingBufferTest, EntriesLargerThanBuffer) {
+  NetLogRingBuffer ring_buffer(16, kMaxBuffers);
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+  AddEntries(&net_log_, 1, 1);
+  ring_buffer.StopObserving();
+
+  scoped_ptr<base::Value> events = GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(events);
+  EXPECT_TRUE(GetIndices(*events).empty());
+}
+
+// Each thread has a buffer of its own, and the dump interleaves them by time.
+TEST_F(NetLogRingBufferTest, MultipleThreads) {
+  NetLogRingBuffer ring_buffer(2048, kMaxBuffers);
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+
+  AddEntries(&net_log_, 0, 1000);
+  base::Thread thread("NetLogRingBufferTest");
+  ASSERT_TRUE(thread.Start());
+  thread.message_loop()->PostTask(
+      FROM_HERE, base::Bind(&AddEntries, &net_log_, 1000, 1000));
+  thread.Stop();
+  AddEntries(&net_log_, 2000, 1);
+  ring_buffer.StopObserving();
+
+  scoped_ptr<base::Value> events = GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(events);
+  std::vector<int> indices = GetIndices(*events);
+  // The other thread didn't push out the last events of the main thread.
+  ASSERT_LT(20u, indices.size());
+  EXPECT_GT(1000, indices[0]);
+  EXPECT_EQ(1999, indices[indices.size() - 2]);
+  EXPECT_EQ(2000, indices[indices.size() - 1]);
+}
+
+// Once there are |max_buffers| buffers, new threads share the one written to
+// least recently.
+TEST_F(NetLogRingBufferTest, MaxBuffers) {
+  NetLogRingBuffer ring_buffer(2048, 1);
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+
+  AddEntries(&net_log_, 0, 1000);
+  base::Thread thread("NetLogRingBufferTest");
+  ASSERT_TRUE(thread.Start());
+  thread.message_loop()->PostTask(
+      FROM_HERE, base::Bind(&AddEntries, &net_log_, 1000, 1000));
+  thread.Stop();
+  AddEntries(&net_log_, 2000, 1);
+  ring_buffer.StopObserving();
+
+  scoped_ptr<base::Value> events = GetEvents(DumpToJSON(ring_buffer));
+  ASSERT_TRUE(events);
+  std::vector<int> indices = GetIndices(*events);
+  // The other thread pushed out the events of the main thread.
+  ASSERT_LT(20u, indices.size());
+  ASSERT_GT(1000u, indices.size());
+  int first = 2001 - indices.size();
+  EXPECT_LT(1000, first);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    int index = first + i;
+    EXPECT_EQ(index % 3 == 0 ? -1 : index, indices[i]);
+  }
+}
+
+TEST_F(NetLogRingBufferTest, MalformedDump) {
+  NetLogRingBuffer ring_buffer(1024, kMaxBuffers);
+  ring_buffer.StartObserving(&net_log_, NetLog::LOG_ALL_BUT_BYTES);
+  AddEntries(&net_log_, 1, 2);
+  ring_buffer.StopObserving();
+
+  std::string data;
+  ring_buffer.Dump(&data);
+  std::string json;
+  ASSERT_TRUE(NetLogRingBuffer::ConvertToJSON(data, *constants_, &json));
+
+  // Truncated header.
+  EXPECT_FALSE(NetLogRingBuffer::ConvertToJSON(data.substr(0, 8), *constants_,
+                                               &json));
+  // Truncated entry.
+  EXPECT_FALSE(NetLogRingBuffer::ConvertToJSON(
+      data.substr(0, data.size() - 1), *constants_, &json));
+  // Unknown version.
+  std::string unknown_version = data;
+  unknown_version[4]++;
+  EXPECT_FALSE(NetLogRingBuffer::ConvertToJSON(unknown_version, *constants_,
+                                               &json));
+  EXPECT_FALSE(NetLogRingBuffer::ConvertToJSON("not a dump", *constants_,
+                                               &json));
+}
+
+}  // namespace
+
+}  // namespace net
@@ -0,0 +1,40 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_CERT_CERT_VERIFY_RESULT_STORE_H_
+#define NET_CERT_CERT_VERIFY_RESULT_STORE_H_
+
+#include <string>
+
+#include "net/base/net_export.h"
+
+namespace net {
+
+// An interface for keeping certificate verification results beyond the
+// lifetime of a MultiThreadedCertVerifier, so that they can be shared by the
+// verifiers of several profiles and reused after a restart. See
+// MultiThreadedCertVerifier::SetResultStore().
+//
+// Keys and results are opaque serialized blobs. The verifier decides when a
+// result is no longer valid.
+class NET_EXPORT CertVerifyResultStore {
+ public:
+  virtual ~CertVerifyResultStore() {}
+
+  // Sets |*result| to the result stored for |key| and returns true, or returns
+  // false if there is none.
+  virtual bool GetResult(const std::string& key, std::string* result) = 0;
+
+  // Stores |result| for |key|, replacing any previous result for |key|.
+  virtual void SetResult(const std::string& key,
+                         const std::string& result) = 0;
+
+  virtual void DeleteResult(const std::string& key) = 0;
+
+  virtual void DeleteAll() = 0;
+};
+
+}  // namespace net
+
+#endif  // NET_CERT_CERT_VERIFY_RESULT_STORE_H_
@@ -2,17 +2,23 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "net/cert/crl_set.h"
+
+#include <algorithm>
+
 #include "base/base64.h"
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/format_macros.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/safe_numerics.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "crypto/sha2.h"
-#include "net/cert/crl_set.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
@@ -46,7 +52,13 @@ static bool DecompressZlib(uint8* out, int out_len, base::StringPiece in) {
 
 CRLSet::CRLSet()
     : sequence_(0),
-      not_after_(0) {
+      not_after_(0),
+      mappable_(NULL),
+      mappable_length_(0),
+      crls_(NULL),
+      num_crls_(0),
+      serials_(NULL),
+      num_serials_(0) {
 }
 
 CRLSet::~CRLSet() {
@@ -117,6 +129,56 @@ CRLSet::~CRLSet() {
 // except there is no delta update of a serial number: they are either
 // inserted, deleted or left the same.
 
+// Mappable CRLSet format:
+//
+// Every CRLSet keeps its CRLs in this format, which SerializeMappable returns
+// and LoadMappedFile uses in place. Integers are little-endian, as above, and
+// every table starts at a multiple of four bytes from the start.
+//
+// MappableHeader header
+// byte[32][header.num_blocked_spkis] blocked_spki_sha256s
+// MappableCRL[header.num_crls] crls, sorted by issuer_spki_hash
+// MappableSerials[header.num_serial_arrays] serial_arrays
+// the arrays which serial_arrays point at
+//
+// The serials of each CRL are split by length into arrays of fixed-width
+// serials, which are sorted so that CheckSerial can binary search them. The
+// index of each serial in its CRL is kept next to each array, so that crls(),
+// and so Serialize and ApplyDelta, can put the serials back in order.
+
+struct CRLSet::MappableHeader {
+  // kMappableMagic, which also identifies the version of the format.
+  char magic[8];
+  uint32 sequence;
+  uint32 num_blocked_spkis;
+  uint64 not_after;
+  uint32 num_crls;
+  uint32 num_serial_arrays;
+};
+
+struct CRLSet::MappableCRL {
+  uint8 issuer_spki_hash[crypto::kSHA256Length];
+  // The index of the CRL in the CRLSet.
+  uint32 index;
+  uint32 num_serials;
+  // The serials of the CRL are in the |num_serial_arrays| entries of
+  // serial_arrays from |first_serial_array|, sorted by serial length.
+  uint32 first_serial_array;
+  uint32 num_serial_arrays;
+};
+
+struct CRLSet::MappableSerials {
+  uint32 serial_length;
+  uint32 num_serials;
+  // The offset of byte[serial_length][num_serials], the sorted serials.
+  uint32 serials_offset;
+  // The offset of uint32le[num_serials], the index of each of the serials in
+  // the CRL.
+  uint32 indices_offset;
+};
+
+static const char kMappableMagic[] = "CRLSetM1";
+
 // ReadHeader reads the header (including length prefix) from |data| and
 // updates |data| to remove the header on return. Caller takes ownership of the
 // returned pointer.
@@ -147,11 +209,18 @@ static base::DictionaryValue* ReadHeader(base::StringPiece* data) {
 // currently implement.
 static const int kCurrentFileVersion = 0;
 
-static bool ReadCRL(base::StringPiece* data, std::string* out_parent_spki_hash,
-                    std::vector<std::string>* out_serials) {
+// CRLPieces contains a list of (issuer SPKI hash, revoked serial numbers)
+// pairs, like CRLSet::CRLList, which point into the bytes they were read from.
+typedef std::vector<std::pair<base::StringPiece,
+                              std::vector<base::StringPiece> > > CRLPieces;
+
+static bool ReadCRL(base::StringPiece* data,
+                    base::StringPiece* out_parent_spki_hash,
+                    std::vector<base::StringPiece>* out_serials) {
   if (data->size() < crypto::kSHA256Length)
     return false;
-  *out_parent_spki_hash = std::string(data->data(), crypto::kSHA256Length);
+  *out_parent_spki_hash = base::StringPiece(data->data(),
+                                            crypto::kSHA256Length);
   data->remove_prefix(crypto::kSHA256Length);
 
   if (data->size() < sizeof(uint32))
@@ -169,9 +238,8 @@ static bool ReadCRL(base::StringPiece* data, std::string* out_parent_spki_hash,
 
     if (data->size() < serial_length)
       return false;
-    std::string serial(data->data(), serial_length);
+    out_serials->push_back(base::StringPiece(data->data(), serial_length));
     data->remove_prefix(serial_length);
-    out_serials->push_back(serial);
   }
 
   return true;
@@ -190,8 +258,10 @@ bool CRLSet::CopyBlockedSPKIsFromHeader(base::DictionaryValue* header_dict) {
     std::string spki_sha256_base64, spki_sha256;
     if (!blocked_spkis_list->GetString(i, &spki_sha256_base64))
       return false;
-    if (!base::Base64Decode(spki_sha256_base64, &spki_sha256))
+    if (!base::Base64Decode(spki_sha256_base64, &spki_sha256) ||
+        spki_sha256.size() != crypto::kSHA256Length) {
       return false;
+    }
     blocked_spkis_.push_back(spki_sha256);
   }
 
@@ -242,19 +312,18 @@ bool CRLSet::Parse(base::StringPiece data, scoped_refptr<CRLSet>* out_crl_set) {
   crl_set->sequence_ = static_cast<uint32>(sequence);
   crl_set->not_after_ = static_cast<uint64>(not_after);
 
-  for (size_t crl_index = 0; !data.empty(); crl_index++) {
-    std::string parent_spki_sha256;
-    std::vector<std::string> serials;
-    if (!ReadCRL(&data, &parent_spki_sha256, &serials))
+  // The serials are only copied once, into the mappable format.
+  CRLPieces crls;
+  while (!data.empty()) {
+    crls.push_back(CRLPieces::value_type());
+    if (!ReadCRL(&data, &crls.back().first, &crls.back().second))
       return false;
-
-    crl_set->crls_.push_back(std::make_pair(parent_spki_sha256, serials));
-    crl_set->crls_index_by_issuer_[parent_spki_sha256] = crl_index;
   }
 
   if (!crl_set->CopyBlockedSPKIsFromHeader(header_dict.get()))
     return false;
 
+  crl_set->SetCRLs(crls);
   *out_crl_set = crl_set;
   return true;
 }
@@ -300,7 +369,7 @@ enum {
 
 bool ReadDeltaCRL(base::StringPiece* data,
                   const std::vector<std::string>& old_serials,
-                  std::vector<std::string>* out_serials) {
+                  std::vector<base::StringPiece>* out_serials) {
   std::vector<uint8> changes;
   if (!ReadChanges(data, &changes))
     return false;
@@ -322,10 +391,8 @@ bool ReadDeltaCRL(base::StringPiece* data,
 
       if (data->size() < serial_length)
         return false;
-      const std::string serial(data->data(), serial_length);
+      out_serials->push_back(base::StringPiece(data->data(), serial_length));
       data->remove_prefix(serial_length);
-
-      out_serials->push_back(serial);
     } else if (*k == SYMBOL_DELETE) {
       if (i >= old_serials.size())
         return false;
@@ -388,38 +455,36 @@ bool CRLSet::ApplyDelta(const base::StringPiece& in_data,
   if (!ReadChanges(&data, &crl_changes))
     return false;
 
-  size_t i = 0, j = 0;
+  // The CRLs of the delta point into |old_crls| and |data|.
+  const CRLList old_crls = crls();
+  CRLPieces new_crls;
+  size_t i = 0;
   for (std::vector<uint8>::const_iterator k = crl_changes.begin();
        k != crl_changes.end(); ++k) {
     if (*k == SYMBOL_SAME) {
-      if (i >= crls_.size())
+      if (i >= old_crls.size())
         return false;
-      crl_set->crls_.push_back(crls_[i]);
-      crl_set->crls_index_by_issuer_[crls_[i].first] = j;
+      new_crls.push_back(std::make_pair(
+          base::StringPiece(old_crls[i].first),
+          std::vector<base::StringPiece>(old_crls[i].second.begin(),
+                                         old_crls[i].second.end())));
       i++;
-      j++;
     } else if (*k == SYMBOL_INSERT) {
-      std::string parent_spki_hash;
-      std::vector<std::string> serials;
-      if (!ReadCRL(&data, &parent_spki_hash, &serials))
+      new_crls.push_back(CRLPieces::value_type());
+      if (!ReadCRL(&data, &new_crls.back().first, &new_crls.back().second))
         return false;
-      crl_set->crls_.push_back(std::make_pair(parent_spki_hash, serials));
-      crl_set->crls_index_by_issuer_[parent_spki_hash] = j;
-      j++;
     } else if (*k == SYMBOL_DELETE) {
-      if (i >= crls_.size())
+      if (i >= old_crls.size())
         return false;
       i++;
     } else if (*k == SYMBOL_CHANGED) {
-      if (i >= crls_.size())
+      if (i >= old_crls.size())
         return false;
-      std::vector<std::string> serials;
-      if (!ReadDeltaCRL(&data, crls_[i].second, &serials))
+      new_crls.push_back(CRLPieces::value_type());
+      new_crls.back().first = old_crls[i].first;
+      if (!ReadDeltaCRL(&data, old_crls[i].second, &new_crls.back().second))
         return false;
-      crl_set->crls_.push_back(std::make_pair(crls_[i].first, serials));
-      crl_set->crls_index_by_issuer_[crls_[i].first] = j;
       i++;
-      j++;
     } else {
       NOTREACHED();
       return false;
@@ -428,9 +493,10 @@ bool CRLSet::ApplyDelta(const base::StringPiece& in_data,
 
   if (!data.empty())
     return false;
-  if (i != crls_.size())
+  if (i != old_crls.size())
     return false;
 
+  crl_set->SetCRLs(new_crls);
   *out_crl_set = crl_set;
   return true;
 }
@@ -458,6 +524,21 @@ bool CRLSet::GetIsDeltaUpdate(const base::StringPiece& in_data,
   return true;
 }
 
+// static
+bool CRLSet::GetSequence(const base::StringPiece& in_data, uint32* sequence) {
+  base::StringPiece data(in_data);
+  scoped_ptr<base::DictionaryValue> header_dict(ReadHeader(&data));
+  if (!header_dict.get())
+    return false;
+
+  int header_sequence;
+  if (!header_dict->GetInteger("Sequence", &header_sequence))
+    return false;
+
+  *sequence = header_sequence;
+  return true;
+}
+
 std::string CRLSet::Serialize() const {
   std::string header = base::StringPrintf(
       "{"
@@ -468,7 +549,7 @@ std::string CRLSet::Serialize() const {
       "\"NumParents\":%u,"
       "\"BlockedSPKIs\":[",
       static_cast<unsigned>(sequence_),
-      static_cast<unsigned>(crls_.size()));
+      static_cast<unsigned>(num_crls_));
 
   for (std::vector<std::string>::const_iterator i = blocked_spkis_.begin();
        i != blocked_spkis_.end(); ++i) {
@@ -484,9 +565,10 @@ std::string CRLSet::Serialize() const {
     header += base::StringPrintf(",\"NotAfter\":%" PRIu64, not_after_);
   header += "}";
 
+  const CRLList crls = this->crls();
   size_t len = 2 /* header len */ + header.size();
 
-  for (CRLList::const_iterator i = crls_.begin(); i != crls_.end(); ++i) {
+  for (CRLList::const_iterator i = crls.begin(); i != crls.end(); ++i) {
     len += i->first.size() + 4 /* num serials */;
     for (std::vector<std::string>::const_iterator j = i->second.begin();
          j != i->second.end(); ++j) {
@@ -502,7 +584,7 @@ std::string CRLSet::Serialize() const {
   memcpy(out + off, header.data(), header.size());
   off += header.size();
 
-  for (CRLList::const_iterator i = crls_.begin(); i != crls_.end(); ++i) {
+  for (CRLList::const_iterator i = crls.begin(); i != crls.end(); ++i) {
     memcpy(out + off, i->first.data(), i->first.size());
     off += i->first.size();
     const uint32 num_serials = i->second.size();
@@ -521,6 +603,266 @@ std::string CRLSet::Serialize() const {
   return ret;
 }
 
+std::string CRLSet::SerializeMappable() const {
+  return std::string(reinterpret_cast<const char*>(mappable_),
+                     mappable_length_);
+}
+
+// static
+bool CRLSet::LoadMappedFile(const base::FilePath& path,
+                            scoped_refptr<CRLSet>* out_crl_set) {
+  scoped_ptr<base::MemoryMappedFile> mapped_file(new base::MemoryMappedFile);
+  if (!mapped_file->Initialize(path))
+    return false;
+
+  scoped_refptr<CRLSet> crl_set(new CRLSet);
+  if (!crl_set->InitFromMappable(mapped_file->data(), mapped_file->length()))
+    return false;
+  crl_set->mapped_file_ = mapped_file.Pass();
+
+  *out_crl_set = crl_set;
+  return true;
+}
+
+namespace {
+
+// CRLIssuerLess orders the indices of CRLs by issuer SPKI hash, keeping the
+// CRLs of the same issuer in order.
+class CRLIssuerLess {
+ public:
+  explicit CRLIssuerLess(const CRLPieces& crls) : crls_(crls) {}
+
+  bool operator()(uint32 a, uint32 b) const {
+    const int cmp = crls_[a].first.compare(crls_[b].first);
+    return cmp < 0 || (cmp == 0 && a < b);
+  }
+
+ private:
+  const CRLPieces& crls_;
+};
+
+// SerialLess orders the indices of serials by length, and then by value.
+class SerialLess {
+ public:
+  explicit SerialLess(const std::vector<base::StringPiece>& serials)
+      : serials_(serials) {}
+
+  bool operator()(uint32 a, uint32 b) const {
+    if (serials_[a].size() != serials_[b].size())
+      return serials_[a].size() < serials_[b].size();
+    const int cmp = serials_[a].compare(serials_[b]);
+    return cmp < 0 || (cmp == 0 && a < b);
+  }
+
+ private:
+  const std::vector<base::StringPiece>& serials_;
+};
+
+void AppendUint32(uint32 value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+void CRLSet::SetCRLs(const CRLPieces& crls) {
+  std::vector<uint32> crl_order(crls.size());
+  for (size_t i = 0; i < crls.size(); ++i)
+    crl_order[i] = i;
+  std::sort(crl_order.begin(), crl_order.end(), CRLIssuerLess(crls));
+
+  std::vector<std::vector<uint32> > serial_orders(crls.size());
+  size_t num_serial_arrays = 0;
+  for (size_t i = 0; i < crls.size(); ++i) {
+    const std::vector<base::StringPiece>& serials = crls[crl_order[i]].second;
+    std::vector<uint32>* order = &serial_orders[i];
+    order->resize(serials.size());
+    for (size_t j = 0; j < serials.size(); ++j)
+      (*order)[j] = j;
+    std::sort(order->begin(), order->end(), SerialLess(serials));
+    for (size_t j = 0; j < order->size(); ++j) {
+      if (j == 0 ||
+          serials[(*order)[j]].size() != serials[(*order)[j - 1]].size()) {
+        num_serial_arrays++;
+      }
+    }
+  }
+
+  const size_t tables_length =
+      sizeof(MappableHeader) +
+      blocked_spkis_.size() * crypto::kSHA256Length +
+      crls.size() * sizeof(MappableCRL) +
+      num_serial_arrays * sizeof(MappableSerials);
+
+  std::vector<MappableCRL> crl_table(crls.size());
+  std::vector<MappableSerials> serials_table;
+  serials_table.reserve(num_serial_arrays);
+  std::string arrays;
+  for (size_t i = 0; i < crls.size(); ++i) {
+    const CRLPieces::value_type& crl = crls[crl_order[i]];
+    const std::vector<uint32>& order = serial_orders[i];
+    DCHECK_EQ(crypto::kSHA256Length, crl.first.size());
+    memcpy(crl_table[i].issuer_spki_hash, crl.first.data(),
+           sizeof(crl_table[i].issuer_spki_hash));
+    crl_table[i].index = crl_order[i];
+    crl_table[i].num_serials = base::checked_numeric_cast<uint32>(order.size());
+    crl_table[i].first_serial_array = serials_table.size();
+    crl_table[i].num_serial_arrays = 0;
+
+    for (size_t j = 0; j < order.size(); ) {
+      const size_t serial_length = crl.second[order[j]].size();
+      size_t end = j;
+      while (end < order.size() &&
+             crl.second[order[end]].size() == serial_length) {
+        end++;
+      }
+
+      MappableSerials entry;
+      entry.serial_length = serial_length;
+      entry.num_serials = end - j;
+      entry.serials_offset =
+          base::checked_numeric_cast<uint32>(tables_length + arrays.size());
+      for (size_t k = j; k < end; ++k)
+        crl.second[order[k]].AppendToString(&arrays);
+      arrays.resize((arrays.size() + 3) & ~3);
+      entry.indices_offset =
+          base::checked_numeric_cast<uint32>(tables_length + arrays.size());
+      for (size_t k = j; k < end; ++k)
+        AppendUint32(order[k], &arrays);
+
+      serials_table.push_back(entry);
+      crl_table[i].num_serial_arrays++;
+      j = end;
+    }
+  }
+  DCHECK_EQ(num_serial_arrays, serials_table.size());
+
+  MappableHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kMappableMagic, sizeof(header.magic));
+  header.sequence = sequence_;
+  header.num_blocked_spkis = blocked_spkis_.size();
+  header.not_after = not_after_;
+  header.num_crls = crl_table.size();
+  header.num_serial_arrays = serials_table.size();
+
+  std::string data;
+  data.reserve(tables_length + arrays.size());
+  data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (std::vector<std::string>::const_iterator i = blocked_spkis_.begin();
+       i != blocked_spkis_.end(); ++i) {
+    DCHECK_EQ(crypto::kSHA256Length, i->size());
+    data.append(*i);
+  }
+  if (!crl_table.empty()) {
+    data.append(reinterpret_cast<const char*>(&crl_table[0]),
+                crl_table.size() * sizeof(MappableCRL));
+  }
+  if (!serials_table.empty()) {
+    data.append(reinterpret_cast<const char*>(&serials_table[0]),
+                serials_table.size() * sizeof(MappableSerials));
+  }
+  DCHECK_EQ(tables_length, data.size());
+  data.append(arrays);
+
+  data_.swap(data);
+  CHECK(InitFromMappable(reinterpret_cast<const uint8*>(data_.data()),
+                         data_.size()));
+}
+
+bool CRLSet::InitFromMappable(const uint8* data, size_t length) {
+  COMPILE_ASSERT(sizeof(MappableHeader) == 32, mappable_header_size);
+  COMPILE_ASSERT(sizeof(MappableCRL) == 48, mappable_crl_size);
+  COMPILE_ASSERT(sizeof(MappableSerials) == 16, mappable_serials_size);
+
+  // The tables are used in place.
+  if (reinterpret_cast<uintptr_t>(data) % sizeof(uint64) != 0)
+    return false;
+  if (length < sizeof(MappableHeader))
+    return false;
+  const MappableHeader* header = reinterpret_cast<const MappableHeader*>(data);
+  if (memcmp(header->magic, kMappableMagic, sizeof(header->magic)) != 0)
+    return false;
+
+  // These are computed in 64 bits, so they can't overflow.
+  const uint64 blocked_spkis_offset = sizeof(MappableHeader);
+  const uint64 crls_offset =
+      blocked_spkis_offset +
+      static_cast<uint64>(header->num_blocked_spkis) * crypto::kSHA256Length;
+  const uint64 serials_offset =
+      crls_offset + static_cast<uint64>(header->num_crls) * sizeof(MappableCRL);
+  const uint64 tables_end =
+      serials_offset +
+      static_cast<uint64>(header->num_serial_arrays) * sizeof(MappableSerials);
+  if (tables_end > length)
+    return false;
+
+  const MappableCRL* crls =
+      reinterpret_cast<const MappableCRL*>(data + crls_offset);
+  for (uint32 i = 0; i < header->num_crls; ++i) {
+    if (static_cast<uint64>(crls[i].first_serial_array) +
+        crls[i].num_serial_arrays > header->num_serial_arrays) {
+      return false;
+    }
+  }
+
+  const MappableSerials* serials =
+      reinterpret_cast<const MappableSerials*>(data + serials_offset);
+  for (uint32 i = 0; i < header->num_serial_arrays; ++i) {
+    const MappableSerials& array = serials[i];
+    if (array.indices_offset % sizeof(uint32) != 0 ||
+        array.serials_offset +
+            static_cast<uint64>(array.serial_length) * array.num_serials >
+            length ||
+        array.indices_offset +
+            static_cast<uint64>(sizeof(uint32)) * array.num_serials > length) {
+      return false;
+    }
+  }
+
+  sequence_ = header->sequence;
+  not_after_ = header->not_after;
+  blocked_spkis_.clear();
+  for (uint32 i = 0; i < header->num_blocked_spkis; ++i) {
+    blocked_spkis_.push_back(std::string(
+        reinterpret_cast<const char*>(data + blocked_spkis_offset) +
+            i * crypto::kSHA256Length,
+        crypto::kSHA256Length));
+  }
+
+  mappable_ = data;
+  mappable_length_ = length;
+  crls_ = crls;
+  num_crls_ = header->num_crls;
+  serials_ = serials;
+  num_serials_ = header->num_serial_arrays;
+  return true;
+}
+
+const CRLSet::MappableCRL* CRLSet::FindCRL(
+    const base::StringPiece& issuer_spki_hash) const {
+  if (issuer_spki_hash.size() != crypto::kSHA256Length)
+    return NULL;
+
+  // If an issuer has several CRLs, the last one is used.
+  size_t low = 0;
+  size_t high = num_crls_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (memcmp(crls_[middle].issuer_spki_hash, issuer_spki_hash.data(),
+               crypto::kSHA256Length) <= 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0 ||
+      memcmp(crls_[low - 1].issuer_spki_hash, issuer_spki_hash.data(),
+             crypto::kSHA256Length) != 0) {
+    return NULL;
+  }
+  return &crls_[low - 1];
+}
+
 CRLSet::Result CRLSet::CheckSPKI(const base::StringPiece& spki_hash) const {
   for (std::vector<std::string>::const_iterator i = blocked_spkis_.begin();
        i != blocked_spkis_.end(); ++i) {
@@ -548,16 +890,31 @@ CRLSet::Result CRLSet::CheckSerial(
   while (serial.size() > 1 && serial[0] == 0x00)
     serial.remove_prefix(1);
 
-  std::map<std::string, size_t>::const_iterator i =
-      crls_index_by_issuer_.find(issuer_spki_hash.as_string());
-  if (i == crls_index_by_issuer_.end())
+  const MappableCRL* crl = FindCRL(issuer_spki_hash);
+  if (!crl)
     return UNKNOWN;
-  const std::vector<std::string>& serials = crls_[i->second].second;
 
-  for (std::vector<std::string>::const_iterator i = serials.begin();
-       i != serials.end(); ++i) {
-    if (base::StringPiece(*i) == serial)
-      return REVOKED;
+  for (uint32 i = 0; i < crl->num_serial_arrays; ++i) {
+    const MappableSerials& serials = serials_[crl->first_serial_array + i];
+    if (serials.serial_length != serial.size())
+      continue;
+
+    // The serials of the array are sorted, and all |serial_length| long.
+    const uint8* array = mappable_ + serials.serials_offset;
+    size_t low = 0;
+    size_t high = serials.num_serials;
+    while (low < high) {
+      const size_t middle = low + (high - low) / 2;
+      const int cmp = memcmp(array + middle * serials.serial_length,
+                             serial.data(), serials.serial_length);
+      if (cmp == 0)
+        return REVOKED;
+      if (cmp < 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    break;
   }
 
   return GOOD;
@@ -575,8 +932,32 @@ uint32 CRLSet::sequence() const {
   return sequence_;
 }
 
-const CRLSet::CRLList& CRLSet::crls() const {
-  return crls_;
+CRLSet::CRLList CRLSet::crls() const {
+  CRLList crls(num_crls_);
+  for (size_t i = 0; i < num_crls_; ++i) {
+    const MappableCRL& crl = crls_[i];
+    if (crl.index >= num_crls_)
+      continue;
+    CRLList::value_type* out = &crls[crl.index];
+    out->first.assign(reinterpret_cast<const char*>(crl.issuer_spki_hash),
+                      sizeof(crl.issuer_spki_hash));
+    out->second.resize(crl.num_serials);
+
+    for (uint32 j = 0; j < crl.num_serial_arrays; ++j) {
+      const MappableSerials& serials = serials_[crl.first_serial_array + j];
+      const char* array =
+          reinterpret_cast<const char*>(mappable_ + serials.serials_offset);
+      const uint32* indices =
+          reinterpret_cast<const uint32*>(mappable_ + serials.indices_offset);
+      for (uint32 k = 0; k < serials.num_serials; ++k) {
+        if (indices[k] >= out->second.size())
+          continue;
+        out->second[indices[k]].assign(array + k * serials.serial_length,
+                                       serials.serial_length);
+      }
+    }
+  }
+  return crls;
 }
 
 // static
@@ -595,16 +976,19 @@ CRLSet* CRLSet::ForTesting(bool is_expired,
   CRLSet* crl_set = new CRLSet;
   if (is_expired)
     crl_set->not_after_ = 1;
+
+  CRLPieces crls;
   if (issuer_spki != NULL) {
-    const std::string spki(reinterpret_cast<const char*>(issuer_spki->data),
-                           sizeof(issuer_spki->data));
-    crl_set->crls_.push_back(make_pair(spki, std::vector<std::string>()));
-    crl_set->crls_index_by_issuer_[spki] = 0;
+    const base::StringPiece spki(
+        reinterpret_cast<const char*>(issuer_spki->data),
+        sizeof(issuer_spki->data));
+    crls.push_back(std::make_pair(spki, std::vector<base::StringPiece>()));
   }
 
   if (!serial_number.empty())
-    crl_set->crls_[0].second.push_back(serial_number);
+    crls[0].second.push_back(serial_number);
 
+  crl_set->SetCRLs(crls);
   return crl_set;
 }
 
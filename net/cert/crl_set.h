@@ -5,18 +5,20 @@
 #ifndef NET_CERT_CRL_SET_H_
 #define NET_CERT_CRL_SET_H_
 
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/strings/string_piece.h"
 #include "net/base/net_export.h"
 #include "net/cert/x509_cert_types.h"
 
 namespace base {
 class DictionaryValue;
+class FilePath;
+class MemoryMappedFile;
 }
 
 namespace net {
@@ -24,6 +26,11 @@ namespace net {
 // A CRLSet is a structure that lists the serial numbers of revoked
 // certificates from a number of issuers where issuers are identified by the
 // SHA256 of their SubjectPublicKeyInfo.
+//
+// The CRLs are kept in a single buffer, with the serials of each issuer in
+// sorted arrays, so that checking a serial is a binary search. The buffer can
+// be saved with SerializeMappable() and used in place, without parsing, from a
+// memory mapped file with LoadMappedFile().
 class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
  public:
   enum Result {
@@ -64,11 +71,35 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
   // of a parse error, it returns false.
   static bool GetIsDeltaUpdate(const base::StringPiece& bytes, bool *is_delta);
 
+  // GetSequence extracts the header from |bytes|, which only needs to start
+  // with the header of a CRL set or delta, sets *sequence to the sequence
+  // number of the CRL set that |bytes| holds or results in and returns true.
+  // In the event of a parse error, it returns false.
+  static bool GetSequence(const base::StringPiece& bytes, uint32* sequence);
+
   // Serialize returns a string of bytes suitable for passing to Parse. Parsing
   // and serializing a CRLSet is a lossless operation - the resulting bytes
   // will be equal.
   std::string Serialize() const;
 
+  // SerializeMappable returns the bytes of this CRLSet in the format which
+  // LoadMappedFile uses in place. The format is specific to this version of
+  // the code, so these bytes should only be kept locally, next to the ones
+  // from Serialize.
+  std::string SerializeMappable() const;
+
+  // LoadMappedFile maps the file at |path|, which must hold the bytes from
+  // SerializeMappable, and, on success, puts a CRLSet which uses them in place
+  // in |out_crl_set| and returns true. Only the bounds of the file's tables
+  // are checked, so loading takes the same time whatever the number of
+  // serials. The mapping is read-only and shared, so every process which
+  // loads the same file shares its pages.
+  //
+  // The file must not be modified while it is mapped: replace it with
+  // base::ImportantFileWriter::WriteFileAtomically instead.
+  static bool LoadMappedFile(const base::FilePath& path,
+                             scoped_refptr<CRLSet>* out_crl_set);
+
   // sequence returns the sequence number of this CRL set. CRL sets generated
   // by the same source are given strictly monotonically increasing sequence
   // numbers.
@@ -79,9 +110,9 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
   typedef std::vector< std::pair<std::string, std::vector<std::string> > >
       CRLList;
 
-  // crls returns the internal state of this CRLSet. It should only be used in
-  // testing.
-  const CRLList& crls() const;
+  // crls returns the CRLs of this CRLSet, in their original order. It copies
+  // every serial, so it should only be used in testing and tools.
+  CRLList crls() const;
 
   // EmptyCRLSetForTesting returns a valid, but empty, CRLSet for unit tests.
   static CRLSet* EmptyCRLSetForTesting();
@@ -104,23 +135,49 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
 
   friend class base::RefCountedThreadSafe<CRLSet>;
 
+  // The entries of the tables in the mappable format. See crl_set.cc.
+  struct MappableHeader;
+  struct MappableCRL;
+  struct MappableSerials;
+
   // CopyBlockedSPKIsFromHeader sets |blocked_spkis_| to the list of values
   // from "BlockedSPKIs" in |header_dict|.
   bool CopyBlockedSPKIsFromHeader(base::DictionaryValue* header_dict);
 
+  // SetCRLs builds the mappable format for |crls|, given as (issuer SPKI hash,
+  // serials) pairs, and uses it. |sequence_|, |not_after_| and
+  // |blocked_spkis_| must already be set.
+  void SetCRLs(const std::vector<std::pair<
+      base::StringPiece, std::vector<base::StringPiece> > >& crls);
+
+  // InitFromMappable points the tables at the |length| bytes at |data|, in the
+  // mappable format, and reads the fields of its header. It returns false if
+  // the tables don't fit in |length| bytes.
+  bool InitFromMappable(const uint8* data, size_t length);
+
+  // FindCRL returns the CRL for |issuer_spki_hash|, or NULL.
+  const MappableCRL* FindCRL(const base::StringPiece& issuer_spki_hash) const;
+
   uint32 sequence_;
-  CRLList crls_;
   // not_after_ contains the time, in UNIX epoch seconds, after which the
   // CRLSet should be considered stale, or 0 if no such time was given.
   uint64 not_after_;
-  // crls_index_by_issuer_ maps from issuer SPKI hashes to the index in |crls_|
-  // where the information for that issuer can be found. We have both |crls_|
-  // and |crls_index_by_issuer_| because, when applying a delta update, we need
-  // to identify a CRL by index.
-  std::map<std::string, size_t> crls_index_by_issuer_;
   // blocked_spkis_ contains the SHA256 hashes of SPKIs which are to be blocked
   // no matter where in a certificate chain they might appear.
   std::vector<std::string> blocked_spkis_;
+
+  // The CRLs are in the mappable format, either in |data_| or in
+  // |mapped_file_|. |mappable_| and |mappable_length_| point at them, and the
+  // tables below point into them.
+  std::string data_;
+  scoped_ptr<base::MemoryMappedFile> mapped_file_;
+  const uint8* mappable_;
+  size_t mappable_length_;
+  // crls_ is sorted by issuer SPKI hash.
+  const MappableCRL* crls_;
+  size_t num_crls_;
+  const MappableSerials* serials_;
+  size_t num_serials_;
 };
 
 }  // namespace net
@@ -0,0 +1,129 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "net/cert/crl_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kNumIssuers = 100;
+const size_t kNumSerialsPerIssuer = 1000;
+const int kNumParses = 20;
+const int kNumLookups = 1000000;
+
+// Returns a serial like the ones CAs issue: 8 to 20 random bytes, positive
+// and without leading zeros.
+std::string RandomSerial() {
+  std::string serial = base::RandBytesAsString(base::RandInt(8, 20));
+  serial[0] = (serial[0] & 0x7f) | 0x01;
+  return serial;
+}
+
+// Builds a CRLSet, in the format of CRLSet::Parse, with kNumIssuers issuers
+// of kNumSerialsPerIssuer serials each.
+std::string MakeCRLSet(std::vector<std::string>* issuers,
+                       std::vector<std::string>* serials) {
+  const std::string header =
+      "{\"Version\":0,\"ContentType\":\"CRLSet\",\"Sequence\":1,"
+      "\"DeltaFrom\":0,\"NumParents\":100,\"BlockedSPKIs\":[]}";
+  std::string data;
+  data.push_back(header.size() & 0xff);
+  data.push_back(header.size() >> 8);
+  data.append(header);
+
+  for (size_t i = 0; i < kNumIssuers; ++i) {
+    issuers->push_back(base::RandBytesAsString(32));
+    data.append(issuers->back());
+    const uint32 num_serials = kNumSerialsPerIssuer;
+    data.append(reinterpret_cast<const char*>(&num_serials),
+                sizeof(num_serials));
+    for (size_t j = 0; j < kNumSerialsPerIssuer; ++j) {
+      serials->push_back(RandomSerial());
+      data.push_back(serials->back().size());
+      data.append(serials->back());
+    }
+  }
+  return data;
+}
+
+void CheckSerials(const char* name,
+                  const CRLSet* crl_set,
+                  const std::vector<std::string>& issuers,
+                  const std::vector<std::string>& serials) {
+  // Mostly serials which aren't revoked, as in real use.
+  std::vector<std::string> good_serials;
+  for (size_t i = 0; i < 1000; ++i)
+    good_serials.push_back(RandomSerial());
+
+  int num_revoked = 0;
+  base::PerfTimeLogger timer(
+      base::StringPrintf("CRLSet_CheckSerial_%s", name).c_str());
+  for (int i = 0; i < kNumLookups; ++i) {
+    const std::string& issuer = issuers[i % issuers.size()];
+    if (i % 10 == 0) {
+      const std::string& serial =
+          serials[(i % issuers.size()) * kNumSerialsPerIssuer +
+                  (i / issuers.size()) % kNumSerialsPerIssuer];
+      if (crl_set->CheckSerial(serial, issuer) == CRLSet::REVOKED)
+        num_revoked++;
+    } else {
+      crl_set->CheckSerial(good_serials[i % good_serials.size()], issuer);
+    }
+  }
+  timer.Done();
+  EXPECT_EQ(kNumLookups / 10, num_revoked);
+}
+
+}  // namespace
+
+TEST(CRLSetPerfTest, Parse) {
+  std::vector<std::string> issuers;
+  std::vector<std::string> serials;
+  const std::string data = MakeCRLSet(&issuers, &serials);
+  base::LogPerfResult("CRLSet_size", data.size(), "bytes");
+
+  scoped_refptr<CRLSet> crl_set;
+  base::PerfTimeLogger timer("CRLSet_Parse");
+  for (int i = 0; i < kNumParses; ++i)
+    ASSERT_TRUE(CRLSet::Parse(data, &crl_set));
+  timer.Done();
+
+  CheckSerials("parsed", crl_set.get(), issuers, serials);
+}
+
+TEST(CRLSetPerfTest, LoadMappedFile) {
+  std::vector<std::string> issuers;
+  std::vector<std::string> serials;
+  scoped_refptr<CRLSet> crl_set;
+  ASSERT_TRUE(CRLSet::Parse(MakeCRLSet(&issuers, &serials), &crl_set));
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.path().AppendASCII("crl-set");
+  const std::string mappable = crl_set->SerializeMappable();
+  ASSERT_EQ(static_cast<int>(mappable.size()),
+            file_util::WriteFile(path, mappable.data(), mappable.size()));
+  base::LogPerfResult("CRLSet_mappable_size", mappable.size(), "bytes");
+
+  scoped_refptr<CRLSet> mapped_crl_set;
+  base::PerfTimeLogger timer("CRLSet_LoadMappedFile");
+  for (int i = 0; i < kNumParses; ++i)
+    ASSERT_TRUE(CRLSet::LoadMappedFile(path, &mapped_crl_set));
+  timer.Done();
+
+  CheckSerials("mapped", mapped_crl_set.get(), issuers, serials);
+}
+
+}  // namespace net
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "net/cert/crl_set.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -324,3 +326,133 @@ TEST(CRLSetTest, Expired) {
 
   EXPECT_TRUE(set->IsExpired());
 }
+
+TEST(CRLSetTest, CheckSerialFindsEverySerial) {
+  base::StringPiece s(reinterpret_cast<const char*>(kGIACRLSet),
+                      sizeof(kGIACRLSet));
+  scoped_refptr<net::CRLSet> set;
+  EXPECT_TRUE(net::CRLSet::Parse(s, &set));
+  ASSERT_TRUE(set.get() != NULL);
+
+  // The added CRL has serials of a different length than those of the first.
+  scoped_refptr<net::CRLSet> delta_set;
+  base::StringPiece delta(reinterpret_cast<const char*>(kAddCRLDelta),
+                          sizeof(kAddCRLDelta));
+  EXPECT_TRUE(set->ApplyDelta(delta, &delta_set));
+  ASSERT_TRUE(delta_set.get() != NULL);
+
+  const net::CRLSet::CRLList& crls = delta_set->crls();
+  ASSERT_EQ(2u, crls.size());
+  for (size_t i = 0; i < crls.size(); ++i) {
+    const std::vector<std::string>& serials = crls[i].second;
+    for (size_t j = 0; j < serials.size(); ++j) {
+      EXPECT_EQ(net::CRLSet::REVOKED,
+                delta_set->CheckSerial(serials[j], crls[i].first));
+      // A leading zero doesn't change the serial.
+      EXPECT_EQ(net::CRLSet::REVOKED,
+                delta_set->CheckSerial(std::string(1, '\0') + serials[j],
+                                       crls[i].first));
+      EXPECT_EQ(net::CRLSet::GOOD,
+                delta_set->CheckSerial(serials[j] + '\x01', crls[i].first));
+    }
+  }
+  EXPECT_EQ(net::CRLSet::GOOD,
+            delta_set->CheckSerial(std::string("\x7f", 1), crls[1].first));
+  EXPECT_EQ(net::CRLSet::UNKNOWN,
+            delta_set->CheckSerial(crls[1].second[0], std::string(32, 'a')));
+}
+
+TEST(CRLSetTest, GetSequence) {
+  base::StringPiece s(reinterpret_cast<const char*>(kGIACRLSet),
+                      sizeof(kGIACRLSet));
+  scoped_refptr<net::CRLSet> set;
+  EXPECT_TRUE(net::CRLSet::Parse(s, &set));
+  ASSERT_TRUE(set.get() != NULL);
+
+  uint32 sequence = 0;
+  EXPECT_TRUE(net::CRLSet::GetSequence(s, &sequence));
+  EXPECT_EQ(set->sequence(), sequence);
+
+  base::StringPiece delta(reinterpret_cast<const char*>(kNoopDeltaCRL),
+                          sizeof(kNoopDeltaCRL));
+  scoped_refptr<net::CRLSet> delta_set;
+  EXPECT_TRUE(set->ApplyDelta(delta, &delta_set));
+  ASSERT_TRUE(delta_set.get() != NULL);
+  EXPECT_TRUE(net::CRLSet::GetSequence(delta, &sequence));
+  EXPECT_EQ(delta_set->sequence(), sequence);
+
+  // Only the header is needed.
+  uint16 header_len;
+  memcpy(&header_len, s.data(), 2);
+  EXPECT_TRUE(net::CRLSet::GetSequence(s.substr(0, 2 + header_len),
+                                       &sequence));
+  EXPECT_EQ(set->sequence(), sequence);
+  EXPECT_FALSE(net::CRLSet::GetSequence(s.substr(0, 1 + header_len),
+                                        &sequence));
+}
+
+TEST(CRLSetTest, MappedFile) {
+  base::StringPiece s(reinterpret_cast<const char*>(kGIACRLSet),
+                      sizeof(kGIACRLSet));
+  scoped_refptr<net::CRLSet> set;
+  EXPECT_TRUE(net::CRLSet::Parse(s, &set));
+  ASSERT_TRUE(set.get() != NULL);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.path().AppendASCII("crl-set");
+  const std::string mappable = set->SerializeMappable();
+  ASSERT_EQ(static_cast<int>(mappable.size()),
+            file_util::WriteFile(path, mappable.data(), mappable.size()));
+
+  scoped_refptr<net::CRLSet> mapped_set;
+  EXPECT_TRUE(net::CRLSet::LoadMappedFile(path, &mapped_set));
+  ASSERT_TRUE(mapped_set.get() != NULL);
+  EXPECT_EQ(set->sequence(), mapped_set->sequence());
+  EXPECT_EQ(s.as_string(), mapped_set->Serialize());
+  EXPECT_EQ(mappable, mapped_set->SerializeMappable());
+
+  const std::string gia_spki_hash(
+      reinterpret_cast<const char*>(kGIASPKISHA256),
+      sizeof(kGIASPKISHA256));
+  EXPECT_EQ(net::CRLSet::REVOKED, mapped_set->CheckSerial(
+      std::string("\x16\x7D\x75\x9D\x00\x03\x00\x00\x14\x55", 10),
+      gia_spki_hash));
+  EXPECT_EQ(net::CRLSet::GOOD, mapped_set->CheckSerial(
+      std::string("\x47\x54\x3E\x79\x00\x03\x00\x00\x14\xF5", 10),
+      gia_spki_hash));
+
+  // Deltas apply to mapped CRLSets too.
+  scoped_refptr<net::CRLSet> delta_set;
+  base::StringPiece delta(reinterpret_cast<const char*>(kNoopDeltaCRL),
+                          sizeof(kNoopDeltaCRL));
+  EXPECT_TRUE(mapped_set->ApplyDelta(delta, &delta_set));
+  ASSERT_TRUE(delta_set.get() != NULL);
+  EXPECT_EQ(s.as_string(), delta_set->Serialize());
+}
+
+TEST(CRLSetTest, MappedFileRejectsBadFiles) {
+  base::StringPiece s(reinterpret_cast<const char*>(kGIACRLSet),
+                      sizeof(kGIACRLSet));
+  scoped_refptr<net::CRLSet> set;
+  EXPECT_TRUE(net::CRLSet::Parse(s, &set));
+  ASSERT_TRUE(set.get() != NULL);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.path().AppendASCII("crl-set");
+  scoped_refptr<net::CRLSet> mapped_set;
+  EXPECT_FALSE(net::CRLSet::LoadMappedFile(path, &mapped_set));
+
+  // A CRLSet in the format of Serialize.
+  ASSERT_EQ(static_cast<int>(s.size()),
+            file_util::WriteFile(path, s.data(), s.size()));
+  EXPECT_FALSE(net::CRLSet::LoadMappedFile(path, &mapped_set));
+
+  // A truncated file.
+  const std::string mappable = set->SerializeMappable();
+  ASSERT_EQ(static_cast<int>(mappable.size() - 1),
+            file_util::WriteFile(path, mappable.data(), mappable.size() - 1));
+  EXPECT_FALSE(net::CRLSet::LoadMappedFile(path, &mapped_set));
+  EXPECT_TRUE(mapped_set.get() == NULL);
+}
@@ -0,0 +1,134 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/file_cert_verify_result_store.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/location.h"
+#include "base/pickle.h"
+#include "base/sequenced_task_runner.h"
+
+namespace net {
+
+namespace {
+
+// Version number of the file format.
+const int kVersion = 1;
+
+void ReadFile(const base::FilePath& path, std::string* data) {
+  if (!base::ReadFileToString(path, data))
+    data->clear();
+}
+
+}  // namespace
+
+const size_t FileCertVerifyResultStore::kMaxResults = 1024;
+
+FileCertVerifyResultStore::FileCertVerifyResultStore(
+    const base::FilePath& path,
+    base::SequencedTaskRunner* task_runner)
+    : results_(kMaxResults),
+      task_runner_(task_runner),
+      writer_(path, task_runner),
+      weak_factory_(this) {
+}
+
+FileCertVerifyResultStore::~FileCertVerifyResultStore() {
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+}
+
+void FileCertVerifyResultStore::Load(const base::Closure& callback) {
+  DCHECK(CalledOnValidThread());
+  std::string* data = new std::string;
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadFile, writer_.path(), data),
+      base::Bind(&FileCertVerifyResultStore::OnFileRead,
+                 weak_factory_.GetWeakPtr(), callback, base::Owned(data)));
+}
+
+bool FileCertVerifyResultStore::GetResult(const std::string& key,
+                                          std::string* result) {
+  DCHECK(CalledOnValidThread());
+  // Only the order of the results changes, so the file isn't rewritten.
+  ResultMap::iterator it = results_.Get(key);
+  if (it == results_.end())
+    return false;
+  *result = it->second;
+  return true;
+}
+
+void FileCertVerifyResultStore::SetResult(const std::string& key,
+                                          const std::string& result) {
+  DCHECK(CalledOnValidThread());
+  results_.Put(key, result);
+  writer_.ScheduleWrite(this);
+}
+
+void FileCertVerifyResultStore::DeleteResult(const std::string& key) {
+  DCHECK(CalledOnValidThread());
+  ResultMap::iterator it = results_.Peek(key);
+  if (it == results_.end())
+    return;
+  results_.Erase(it);
+  writer_.ScheduleWrite(this);
+}
+
+void FileCertVerifyResultStore::DeleteAll() {
+  DCHECK(CalledOnValidThread());
+  results_.Clear();
+  writer_.ScheduleWrite(this);
+}
+
+bool FileCertVerifyResultStore::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+  Pickle pickle;
+  pickle.WriteInt(kVersion);
+  pickle.WriteUInt32(static_cast<uint32>(results_.size()));
+  // Oldest first, so that reading the file back preserves the order.
+  for (ResultMap::const_reverse_iterator it = results_.rbegin();
+       it != results_.rend(); ++it) {
+    pickle.WriteString(it->first);
+    pickle.WriteString(it->second);
+  }
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  return true;
+}
+
+void FileCertVerifyResultStore::OnFileRead(const base::Closure& callback,
+                                           const std::string* data) {
+  DCHECK(CalledOnValidThread());
+  Pickle pickle(data->data(), data->size());
+  PickleIterator iter(pickle);
+  int version;
+  uint32 num_results;
+  if (iter.ReadInt(&version) && version == kVersion &&
+      iter.ReadUInt32(&num_results)) {
+    // Results which are already in the store are newer than the saved ones,
+    // so they are put back in front of them.
+    std::vector<std::pair<std::string, std::string> > newer_results;
+    for (ResultMap::const_reverse_iterator it = results_.rbegin();
+         it != results_.rend(); ++it) {
+      newer_results.push_back(*it);
+    }
+    for (uint32 i = 0; i < num_results; ++i) {
+      std::string key;
+      std::string result;
+      if (!iter.ReadString(&key) || !iter.ReadString(&result))
+        break;
+      results_.Put(key, result);
+    }
+    for (size_t i = 0; i < newer_results.size(); ++i)
+      results_.Put(newer_results[i].first, newer_results[i].second);
+  }
+  callback.Run();
+}
+
+}  // namespace net
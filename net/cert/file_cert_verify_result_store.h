@@ -0,0 +1,78 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_CERT_FILE_CERT_VERIFY_RESULT_STORE_H_
+#define NET_CERT_FILE_CERT_VERIFY_RESULT_STORE_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/callback_forward.h"
+#include "base/compiler_specific.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+#include "net/cert/cert_verify_result_store.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// A CertVerifyResultStore which keeps the kMaxResults most recently used
+// results, and saves them to a file a few seconds after they change.
+class NET_EXPORT FileCertVerifyResultStore
+    : public CertVerifyResultStore,
+      public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  static const size_t kMaxResults;
+
+  // The file is read and written on |task_runner|.
+  FileCertVerifyResultStore(const base::FilePath& path,
+                            base::SequencedTaskRunner* task_runner);
+
+  // Starts writing out any pending changes.
+  virtual ~FileCertVerifyResultStore();
+
+  // Reads the results saved in the file, and runs |callback| once they have
+  // been added to the store. Results stored before then take precedence over
+  // the ones in the file.
+  void Load(const base::Closure& callback);
+
+  size_t size() const { return results_.size(); }
+
+  // CertVerifyResultStore implementation.
+  virtual bool GetResult(const std::string& key,
+                         std::string* result) OVERRIDE;
+  virtual void SetResult(const std::string& key,
+                         const std::string& result) OVERRIDE;
+  virtual void DeleteResult(const std::string& key) OVERRIDE;
+  virtual void DeleteAll() OVERRIDE;
+
+  // base::ImportantFileWriter::DataSerializer implementation.
+  virtual bool SerializeData(std::string* data) OVERRIDE;
+
+ private:
+  typedef base::MRUCache<std::string, std::string> ResultMap;
+
+  void OnFileRead(const base::Closure& callback, const std::string* data);
+
+  ResultMap results_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<FileCertVerifyResultStore> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileCertVerifyResultStore);
+};
+
+}  // namespace net
+
+#endif  // NET_CERT_FILE_CERT_VERIFY_RESULT_STORE_H_
@@ -0,0 +1,135 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/file_cert_verify_result_store.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+class FileCertVerifyResultStoreTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("Certificate Verifications");
+  }
+
+  scoped_ptr<FileCertVerifyResultStore> CreateStore() {
+    return scoped_ptr<FileCertVerifyResultStore>(new FileCertVerifyResultStore(
+        path_, base::MessageLoopProxy::current()));
+  }
+
+  void Load(FileCertVerifyResultStore* store) {
+    base::RunLoop run_loop;
+    store->Load(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  // Destroys |store|, and waits for it to finish writing the file.
+  void Shutdown(scoped_ptr<FileCertVerifyResultStore> store) {
+    store.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(FileCertVerifyResultStoreTest, LoadWithoutFile) {
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  Load(store.get());
+  EXPECT_EQ(0u, store->size());
+}
+
+TEST_F(FileCertVerifyResultStoreTest, SaveAndLoad) {
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  Load(store.get());
+  store->SetResult("a", "result a");
+  store->SetResult("b", "result b");
+  store->SetResult("c", "result c");
+  store->DeleteResult("c");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  EXPECT_EQ(2u, store->size());
+  std::string result;
+  ASSERT_TRUE(store->GetResult("a", &result));
+  EXPECT_EQ("result a", result);
+  ASSERT_TRUE(store->GetResult("b", &result));
+  EXPECT_EQ("result b", result);
+  EXPECT_FALSE(store->GetResult("c", &result));
+}
+
+TEST_F(FileCertVerifyResultStoreTest, DeleteAll) {
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  store->SetResult("a", "result a");
+  store->DeleteAll();
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  EXPECT_EQ(0u, store->size());
+}
+
+// Results stored while the file is being loaded are newer than the ones in
+// it.
+TEST_F(FileCertVerifyResultStoreTest, LoadKeepsNewerResults) {
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  store->SetResult("a", "old result a");
+  store->SetResult("b", "result b");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  store->SetResult("a", "new result a");
+  Load(store.get());
+  EXPECT_EQ(2u, store->size());
+  std::string result;
+  ASSERT_TRUE(store->GetResult("a", &result));
+  EXPECT_EQ("new result a", result);
+  ASSERT_TRUE(store->GetResult("b", &result));
+  EXPECT_EQ("result b", result);
+}
+
+// Looking a result up makes it the most recently used.
+TEST_F(FileCertVerifyResultStoreTest, KeepsMostRecentlyUsedResults) {
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  for (size_t i = 0; i < FileCertVerifyResultStore::kMaxResults; ++i)
+    store->SetResult(base::Uint64ToString(i), "result");
+  std::string result;
+  ASSERT_TRUE(store->GetResult("0", &result));
+  store->SetResult("new", "result");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  EXPECT_EQ(FileCertVerifyResultStore::kMaxResults, store->size());
+  EXPECT_TRUE(store->GetResult("0", &result));
+  EXPECT_FALSE(store->GetResult("1", &result));
+  EXPECT_TRUE(store->GetResult("new", &result));
+}
+
+TEST_F(FileCertVerifyResultStoreTest, IgnoresCorruptFile) {
+  ASSERT_EQ(4, file_util::WriteFile(path_, "junk", 4));
+
+  scoped_ptr<FileCertVerifyResultStore> store(CreateStore());
+  Load(store.get());
+  EXPECT_EQ(0u, store->size());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -11,14 +11,17 @@
 #include "base/compiler_specific.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/worker_pool.h"
 #include "base/time/time.h"
+#include "crypto/sha2.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
+#include "net/cert/cert_verify_result_store.h"
 #include "net/cert/crl_set.h"
 #include "net/cert/x509_certificate.h"
 #include "net/cert/x509_certificate_net_log_param.h"
@@ -78,6 +81,95 @@ const unsigned kMaxCacheEntries = 256;
 // The number of seconds for which we'll cache a cache entry.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
+// The number of seconds for which a result is kept in a CertVerifyResultStore.
+// This is longer than kTTLSecs because results in the store are meant to
+// outlive the process, but short enough that changes to the trust settings
+// which aren't reported by CertDatabase, and revocations which aren't in the
+// CRLSet, are picked up within hours.
+const unsigned kStoreTTLSecs = 6 * 3600;  // 6 hours.
+
+// The version of the results saved in a CertVerifyResultStore.
+const int kStoredResultVersion = 1;
+
+// Serializes a result for a CertVerifyResultStore.
+std::string SerializeStoredResult(int error,
+                                  const CertVerifyResult& verify_result,
+                                  const base::Time& verification_time,
+                                  const base::Time& expiration_time) {
+  Pickle pickle;
+  pickle.WriteInt(kStoredResultVersion);
+  pickle.WriteInt64(verification_time.ToInternalValue());
+  pickle.WriteInt64(expiration_time.ToInternalValue());
+  pickle.WriteInt(error);
+  pickle.WriteUInt32(verify_result.cert_status);
+  pickle.WriteBool(verify_result.has_md5);
+  pickle.WriteBool(verify_result.has_md2);
+  pickle.WriteBool(verify_result.has_md4);
+  pickle.WriteBool(verify_result.is_issued_by_known_root);
+  pickle.WriteBool(verify_result.is_issued_by_additional_trust_anchor);
+  pickle.WriteBool(verify_result.common_name_fallback_used);
+  pickle.WriteUInt32(
+      static_cast<uint32>(verify_result.public_key_hashes.size()));
+  for (size_t i = 0; i < verify_result.public_key_hashes.size(); ++i)
+    pickle.WriteString(verify_result.public_key_hashes[i].ToString());
+  pickle.WriteBool(verify_result.verified_cert.get() != NULL);
+  if (verify_result.verified_cert.get())
+    verify_result.verified_cert->Persist(&pickle);
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+// Parses a result serialized by SerializeStoredResult. Returns false if
+// |data| is invalid.
+bool ParseStoredResult(const std::string& data,
+                       int* error,
+                       CertVerifyResult* verify_result,
+                       base::Time* verification_time,
+                       base::Time* expiration_time) {
+  Pickle pickle(data.data(), data.size());
+  PickleIterator iter(pickle);
+  int version;
+  int64 verification_time_value;
+  int64 expiration_time_value;
+  uint32 num_public_key_hashes;
+  if (!iter.ReadInt(&version) || version != kStoredResultVersion ||
+      !iter.ReadInt64(&verification_time_value) ||
+      !iter.ReadInt64(&expiration_time_value) ||
+      !iter.ReadInt(error) ||
+      !iter.ReadUInt32(&verify_result->cert_status) ||
+      !iter.ReadBool(&verify_result->has_md5) ||
+      !iter.ReadBool(&verify_result->has_md2) ||
+      !iter.ReadBool(&verify_result->has_md4) ||
+      !iter.ReadBool(&verify_result->is_issued_by_known_root) ||
+      !iter.ReadBool(&verify_result->is_issued_by_additional_trust_anchor) ||
+      !iter.ReadBool(&verify_result->common_name_fallback_used) ||
+      !iter.ReadUInt32(&num_public_key_hashes)) {
+    return false;
+  }
+  *verification_time = base::Time::FromInternalValue(verification_time_value);
+  *expiration_time = base::Time::FromInternalValue(expiration_time_value);
+
+  verify_result->public_key_hashes.clear();
+  for (uint32 i = 0; i < num_public_key_hashes; ++i) {
+    std::string hash_string;
+    HashValue hash;
+    if (!iter.ReadString(&hash_string) || !hash.FromString(hash_string))
+      return false;
+    verify_result->public_key_hashes.push_back(hash);
+  }
+
+  bool has_verified_cert;
+  if (!iter.ReadBool(&has_verified_cert))
+    return false;
+  verify_result->verified_cert = NULL;
+  if (has_verified_cert) {
+    verify_result->verified_cert = X509Certificate::CreateFromPickle(
+        pickle, &iter, X509Certificate::PICKLETYPE_CERTIFICATE_CHAIN_V3);
+    if (!verify_result->verified_cert.get())
+      return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 MultiThreadedCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
@@ -257,6 +349,7 @@ class CertVerifierWorker {
         cert_verifier_->HandleResult(cert_.get(),
                                      hostname_,
                                      flags_,
+                                     crl_set_.get(),
                                      additional_trust_anchors_,
                                      error_,
                                      verify_result_);
@@ -394,8 +487,10 @@ MultiThreadedCertVerifier::MultiThreadedCertVerifier(
       requests_(0),
       cache_hits_(0),
       inflight_joins_(0),
+      store_hits_(0),
       verify_proc_(verify_proc),
-      trust_anchor_provider_(NULL) {
+      trust_anchor_provider_(NULL),
+      result_store_(NULL) {
   CertDatabase::GetInstance()->AddObserver(this);
 }
 
@@ -410,6 +505,12 @@ void MultiThreadedCertVerifier::SetCertTrustAnchorProvider(
   trust_anchor_provider_ = trust_anchor_provider;
 }
 
+void MultiThreadedCertVerifier::SetResultStore(
+    CertVerifyResultStore* result_store) {
+  DCHECK(CalledOnValidThread());
+  result_store_ = result_store;
+}
+
 int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
                                       const std::string& hostname,
                                       int flags,
@@ -433,9 +534,13 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
           trust_anchor_provider_->GetAdditionalTrustAnchors() : empty_cert_list;
 
   const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags, additional_trust_anchors);
+                          hostname, flags, crl_set ? crl_set->sequence() : 0,
+                          additional_trust_anchors);
+  const base::Time now = base::Time::Now();
   const CertVerifierCache::value_type* cached_entry =
-      cache_.Get(key, CacheValidityPeriod(base::Time::Now()));
+      cache_.Get(key, CacheValidityPeriod(now));
+  if (!cached_entry && result_store_)
+    cached_entry = GetStoredResult(key, now);
   if (cached_entry) {
     ++cache_hits_;
     *out_req = NULL;
@@ -494,9 +599,11 @@ MultiThreadedCertVerifier::RequestParams::RequestParams(
     const SHA1HashValue& ca_fingerprint_arg,
     const std::string& hostname_arg,
     int flags_arg,
+    uint32 crl_set_sequence_arg,
     const CertificateList& additional_trust_anchors)
     : hostname(hostname_arg),
-      flags(flags_arg) {
+      flags(flags_arg),
+      crl_set_sequence(crl_set_sequence_arg) {
   hash_values.reserve(2 + additional_trust_anchors.size());
   hash_values.push_back(cert_fingerprint_arg);
   hash_values.push_back(ca_fingerprint_arg);
@@ -513,6 +620,8 @@ bool MultiThreadedCertVerifier::RequestParams::operator<(
   // memory and string comparisons.
   if (flags != other.flags)
     return flags < other.flags;
+  if (crl_set_sequence != other.crl_set_sequence)
+    return crl_set_sequence < other.crl_set_sequence;
   if (hostname != other.hostname)
     return hostname < other.hostname;
   return std::lexicographical_compare(
@@ -521,19 +630,34 @@ bool MultiThreadedCertVerifier::RequestParams::operator<(
       net::SHA1HashValueLessThan());
 }
 
+std::string MultiThreadedCertVerifier::RequestParams::GetStoreKey() const {
+  Pickle pickle;
+  pickle.WriteInt(flags);
+  pickle.WriteUInt32(crl_set_sequence);
+  pickle.WriteString(hostname);
+  for (size_t i = 0; i < hash_values.size(); ++i)
+    pickle.WriteBytes(hash_values[i].data, sizeof(hash_values[i].data));
+  // Hashed so that stores don't keep the hostnames in the clear, and so that
+  // all the keys have the same size.
+  return crypto::SHA256HashString(base::StringPiece(
+      static_cast<const char*>(pickle.data()), pickle.size()));
+}
+
 // HandleResult is called by CertVerifierWorker on the origin message loop.
 // It deletes CertVerifierJob.
 void MultiThreadedCertVerifier::HandleResult(
     X509Certificate* cert,
     const std::string& hostname,
     int flags,
+    CRLSet* crl_set,
     const CertificateList& additional_trust_anchors,
     int error,
     const CertVerifyResult& verify_result) {
   DCHECK(CalledOnValidThread());
 
   const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags, additional_trust_anchors);
+                          hostname, flags, crl_set ? crl_set->sequence() : 0,
+                          additional_trust_anchors);
 
   CachedResult cached_result;
   cached_result.error = error;
@@ -543,6 +667,20 @@ void MultiThreadedCertVerifier::HandleResult(
       key, cached_result, CacheValidityPeriod(now),
       CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
 
+  // Only successful verifications are stored, so that errors which the user
+  // fixes outside of the browser, such as a wrong clock or a missing root,
+  // don't outlive the process.
+  if (result_store_ && error == OK) {
+    base::Time expiration = now + base::TimeDelta::FromSeconds(kStoreTTLSecs);
+    if (verify_result.verified_cert.get() &&
+        verify_result.verified_cert->valid_expiry() < expiration) {
+      expiration = verify_result.verified_cert->valid_expiry();
+    }
+    result_store_->SetResult(
+        key.GetStoreKey(),
+        SerializeStoredResult(error, verify_result, now, expiration));
+  }
+
   std::map<RequestParams, CertVerifierJob*>::iterator j;
   j = inflight_.find(key);
   if (j == inflight_.end()) {
@@ -556,11 +694,43 @@ void MultiThreadedCertVerifier::HandleResult(
   delete job;
 }
 
+const MultiThreadedCertVerifier::CachedResult*
+MultiThreadedCertVerifier::GetStoredResult(const RequestParams& key,
+                                           const base::Time& now) {
+  const std::string store_key = key.GetStoreKey();
+  std::string data;
+  if (!result_store_->GetResult(store_key, &data))
+    return NULL;
+
+  CachedResult cached_result;
+  base::Time verification_time;
+  base::Time expiration_time;
+  if (!ParseStoredResult(data, &cached_result.error, &cached_result.result,
+                         &verification_time, &expiration_time) ||
+      !CacheExpirationFunctor()(
+          CacheValidityPeriod(now),
+          CacheValidityPeriod(verification_time, expiration_time))) {
+    result_store_->DeleteResult(store_key);
+    return NULL;
+  }
+
+  ++store_hits_;
+  // The result stays in |cache_| for no longer than a new one would.
+  base::Time cache_expiration = now + base::TimeDelta::FromSeconds(kTTLSecs);
+  if (expiration_time < cache_expiration)
+    cache_expiration = expiration_time;
+  cache_.Put(key, cached_result, CacheValidityPeriod(now),
+             CacheValidityPeriod(verification_time, cache_expiration));
+  return cache_.Get(key, CacheValidityPeriod(now));
+}
+
 void MultiThreadedCertVerifier::OnCACertChanged(
     const X509Certificate* cert) {
   DCHECK(CalledOnValidThread());
 
   ClearCache();
+  if (result_store_)
+    result_store_->DeleteAll();
 }
 
 }  // namespace net
@@ -29,6 +29,7 @@ class CertVerifierJob;
 class CertVerifierRequest;
 class CertVerifierWorker;
 class CertVerifyProc;
+class CertVerifyResultStore;
 
 // MultiThreadedCertVerifier is a CertVerifier implementation that runs
 // synchronous CertVerifier implementations on worker threads.
@@ -53,6 +54,16 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   void SetCertTrustAnchorProvider(
       CertTrustAnchorProvider* trust_anchor_provider);
 
+  // Configures a store that successful verifications are saved to, and that
+  // is looked up when a request isn't in the cache. The store can be shared
+  // with other verifiers, and may keep results across restarts. Results are
+  // keyed by certificate chain, hostname, flags, CRLSet sequence number and
+  // additional trust anchors, so a new CRLSet invalidates them. The store is
+  // emptied when the certificate database changes.
+  // The CertVerifyResultStore will only be accessed on the same thread that
+  // Verify() is called on, and must outlive the MultiThreadedCertVerifier.
+  void SetResultStore(CertVerifyResultStore* result_store);
+
   // CertVerifier implementation
   virtual int Verify(X509Certificate* cert,
                      const std::string& hostname,
@@ -78,6 +89,13 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                            RequestParamsComparators);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            CertTrustAnchorProvider);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, ResultStoreHit);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           ResultStoreCRLSetChanged);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           ResultStoreCACertChanged);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           ResultStoreInvalidResult);
 
   // Input parameters of a certificate verification request.
   struct NET_EXPORT_PRIVATE RequestParams {
@@ -85,13 +103,18 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                   const SHA1HashValue& ca_fingerprint_arg,
                   const std::string& hostname_arg,
                   int flags_arg,
+                  uint32 crl_set_sequence_arg,
                   const CertificateList& additional_trust_anchors);
     ~RequestParams();
 
     bool operator<(const RequestParams& other) const;
 
+    // Returns the key of the request in a CertVerifyResultStore.
+    std::string GetStoreKey() const;
+
     std::string hostname;
     int flags;
+    uint32 crl_set_sequence;
     std::vector<SHA1HashValue> hash_values;
   };
 
@@ -132,10 +155,16 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   void HandleResult(X509Certificate* cert,
                     const std::string& hostname,
                     int flags,
+                    CRLSet* crl_set,
                     const CertificateList& additional_trust_anchors,
                     int error,
                     const CertVerifyResult& verify_result);
 
+  // Looks |key| up in |result_store_|. If there is a valid result, adds it to
+  // |cache_| and returns it, otherwise returns NULL.
+  const CachedResult* GetStoredResult(const RequestParams& key,
+                                      const base::Time& now);
+
   // CertDatabase::Observer methods:
   virtual void OnCACertChanged(const X509Certificate* cert) OVERRIDE;
 
@@ -145,6 +174,7 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   uint64 cache_hits() const { return cache_hits_; }
   uint64 requests() const { return requests_; }
   uint64 inflight_joins() const { return inflight_joins_; }
+  uint64 store_hits() const { return store_hits_; }
 
   // cache_ maps from a request to a cached result.
   CertVerifierCache cache_;
@@ -156,11 +186,15 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   uint64 requests_;
   uint64 cache_hits_;
   uint64 inflight_joins_;
+  // The cache hits which were found in |result_store_|.
+  uint64 store_hits_;
 
   scoped_refptr<CertVerifyProc> verify_proc_;
 
   CertTrustAnchorProvider* trust_anchor_provider_;
 
+  CertVerifyResultStore* result_store_;
+
   DISALLOW_COPY_AND_ASSIGN(MultiThreadedCertVerifier);
 };
 
@@ -0,0 +1,143 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/multi_threaded_cert_verifier.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/format_macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/base/test_data_directory.h"
+#include "net/cert/cert_verify_proc.h"
+#include "net/cert/cert_verify_result.h"
+#include "net/cert/file_cert_verify_result_store.h"
+#include "net/cert/x509_certificate.h"
+#include "net/test/cert_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// The number of verifications that are made at startup, such as for the
+// tabs that are restored. The store can keep all of them.
+const size_t kNumHosts = 1024;
+
+// A CertVerifyProc which accepts every certificate.
+class SuccessfulCertVerifyProc : public CertVerifyProc {
+ public:
+  SuccessfulCertVerifyProc() {}
+
+ private:
+  virtual ~SuccessfulCertVerifyProc() {}
+
+  // CertVerifyProc implementation
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    return OK;
+  }
+};
+
+class MultiThreadedCertVerifierPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    cert_ = ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem");
+    ASSERT_TRUE(cert_.get());
+    for (size_t i = 0; i < kNumHosts; ++i)
+      hosts_.push_back(base::StringPrintf("host%" PRIuS ".example.com", i));
+  }
+
+  scoped_ptr<FileCertVerifyResultStore> LoadStore() {
+    scoped_ptr<FileCertVerifyResultStore> store(new FileCertVerifyResultStore(
+        temp_dir_.path().AppendASCII("Certificate Verifications"),
+        base::MessageLoopProxy::current()));
+    base::RunLoop run_loop;
+    store->Load(run_loop.QuitClosure());
+    run_loop.Run();
+    return store.Pass();
+  }
+
+  // Verifies |cert_| for each of |hosts_|, and returns the number of
+  // verifications which completed synchronously.
+  size_t VerifyAll(MultiThreadedCertVerifier* verifier) {
+    size_t num_synchronous = 0;
+    for (size_t i = 0; i < hosts_.size(); ++i) {
+      CertVerifyResult verify_result;
+      TestCompletionCallback callback;
+      CertVerifier::RequestHandle request_handle;
+      int error = verifier->Verify(cert_.get(), hosts_[i], 0, NULL,
+                                   &verify_result, callback.callback(),
+                                   &request_handle, BoundNetLog());
+      if (error == ERR_IO_PENDING)
+        callback.WaitForResult();
+      else
+        num_synchronous++;
+    }
+    return num_synchronous;
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<X509Certificate> cert_;
+  std::vector<std::string> hosts_;
+};
+
+}  // namespace
+
+// Measures the verifications made at startup without a store, with the
+// platform's CertVerifyProc.
+TEST_F(MultiThreadedCertVerifierPerfTest, StartupWithoutStore) {
+  MultiThreadedCertVerifier verifier(CertVerifyProc::CreateDefault());
+  base::PerfTimeLogger timer("MultiThreadedCertVerifier_StartupWithoutStore");
+  EXPECT_EQ(0u, VerifyAll(&verifier));
+  timer.Done();
+}
+
+// Measures loading a full store, and the verifications made at startup
+// with it.
+TEST_F(MultiThreadedCertVerifierPerfTest, StartupWithStore) {
+  {
+    scoped_ptr<FileCertVerifyResultStore> store(LoadStore());
+    MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+    verifier.SetResultStore(store.get());
+    EXPECT_EQ(0u, VerifyAll(&verifier));
+    EXPECT_EQ(kNumHosts, store->size());
+    store.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  base::PerfTimeLogger load_timer("MultiThreadedCertVerifier_LoadStore");
+  scoped_ptr<FileCertVerifyResultStore> store(LoadStore());
+  load_timer.Done();
+  ASSERT_EQ(kNumHosts, store->size());
+
+  MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+  verifier.SetResultStore(store.get());
+  base::PerfTimeLogger timer("MultiThreadedCertVerifier_StartupWithStore");
+  EXPECT_EQ(kNumHosts, VerifyAll(&verifier));
+  timer.Done();
+}
+
+}  // namespace net
@@ -4,6 +4,8 @@
 
 #include "net/cert/multi_threaded_cert_verifier.h"
 
+#include <map>
+
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/format_macros.h"
@@ -15,6 +17,8 @@
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/cert_verify_result_store.h"
+#include "net/cert/crl_set.h"
 #include "net/cert/x509_certificate.h"
 #include "net/test/cert_test_util.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -56,6 +60,85 @@ class MockCertVerifyProc : public CertVerifyProc {
   }
 };
 
+// A CertVerifyProc which accepts every certificate.
+class SuccessfulCertVerifyProc : public CertVerifyProc {
+ public:
+  SuccessfulCertVerifyProc() {}
+
+ private:
+  virtual ~SuccessfulCertVerifyProc() {}
+
+  // CertVerifyProc implementation
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    verify_result->is_issued_by_known_root = true;
+    HashValue hash(HASH_VALUE_SHA1);
+    memset(hash.data(), 'a', hash.size());
+    verify_result->public_key_hashes.push_back(hash);
+    return OK;
+  }
+};
+
+// A CertVerifyResultStore which keeps its results in memory.
+class MockCertVerifyResultStore : public CertVerifyResultStore {
+ public:
+  MockCertVerifyResultStore() {}
+  virtual ~MockCertVerifyResultStore() {}
+
+  size_t size() const { return results_.size(); }
+
+  // CertVerifyResultStore implementation.
+  virtual bool GetResult(const std::string& key,
+                         std::string* result) OVERRIDE {
+    std::map<std::string, std::string>::const_iterator it = results_.find(key);
+    if (it == results_.end())
+      return false;
+    *result = it->second;
+    return true;
+  }
+
+  virtual void SetResult(const std::string& key,
+                         const std::string& result) OVERRIDE {
+    results_[key] = result;
+  }
+
+  virtual void DeleteResult(const std::string& key) OVERRIDE {
+    results_.erase(key);
+  }
+
+  virtual void DeleteAll() OVERRIDE {
+    results_.clear();
+  }
+
+ private:
+  std::map<std::string, std::string> results_;
+};
+
+// Returns an empty CRLSet with the given sequence number.
+scoped_refptr<CRLSet> CRLSetWithSequence(int sequence) {
+  const std::string header = base::StringPrintf(
+      "{\"Version\":0,\"ContentType\":\"CRLSet\",\"Sequence\":%d,"
+      "\"DeltaFrom\":0,\"NumParents\":0,\"BlockedSPKIs\":[]}",
+      sequence);
+  std::string data;
+  data.push_back(header.size() & 0xff);
+  data.push_back(header.size() >> 8);
+  data.append(header);
+  scoped_refptr<CRLSet> crl_set;
+  CHECK(CRLSet::Parse(data, &crl_set));
+  return crl_set;
+}
+
 class MockCertTrustAnchorProvider : public CertTrustAnchorProvider {
  public:
   MockCertTrustAnchorProvider() {}
@@ -335,51 +418,59 @@ TEST_F(MultiThreadedCertVerifierTest, RequestParamsComparators) {
   } tests[] = {
     {  // Test for basic equivalence.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       0,
     },
     {  // Test that different certificates but with the same CA and for
        // the same host are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(z_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       -1,
     },
     {  // Test that the same EE certificate for the same host, but with
        // different chains are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, z_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       1,
     },
     {  // The same certificate, with the same chain, but for different
        // hosts are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www1.example.test", 0,
+                                               "www1.example.test", 0, 0,
                                                test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www2.example.test", 0,
+                                               "www2.example.test", 0, 0,
                                                test_list),
       -1,
     },
     {  // The same certificate, chain, and host, but with different flags
        // are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               CertVerifier::VERIFY_EV_CERT,
+                                               CertVerifier::VERIFY_EV_CERT, 0,
                                                test_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       1,
     },
+    {  // The same certificate, chain, and host, but checked with different
+       // CRLSets are different validation keys.
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 1, test_list),
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 2, test_list),
+      -1,
+    },
     {  // Different additional_trust_anchors.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, empty_list),
+                                               0, 0, empty_list),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0, test_list),
+                                               0, 0, test_list),
       -1,
     },
   };
@@ -482,4 +573,165 @@ TEST_F(MultiThreadedCertVerifierTest, CertTrustAnchorProvider) {
   ASSERT_EQ(1u, verifier_.cache_hits());
 }
 
+// Tests that a verifier finds the results of another one in a shared
+// CertVerifyResultStore.
+TEST_F(MultiThreadedCertVerifierTest, ResultStoreHit) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  MockCertVerifyResultStore store;
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  {
+    MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+    verifier.SetResultStore(&store);
+    error = verifier.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                            &verify_result, callback.callback(),
+                            &request_handle, BoundNetLog());
+    ASSERT_EQ(ERR_IO_PENDING, error);
+    EXPECT_EQ(OK, callback.WaitForResult());
+    EXPECT_EQ(1u, store.size());
+  }
+
+  MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+  verifier.SetResultStore(&store);
+  verify_result.Reset();
+  error = verifier.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                          &verify_result, callback.callback(),
+                          &request_handle, BoundNetLog());
+  // Synchronous completion.
+  EXPECT_EQ(OK, error);
+  EXPECT_FALSE(request_handle);
+  EXPECT_EQ(1u, verifier.cache_hits());
+  EXPECT_EQ(1u, verifier.store_hits());
+  ASSERT_TRUE(verify_result.verified_cert.get());
+  EXPECT_TRUE(verify_result.verified_cert->Equals(test_cert.get()));
+  EXPECT_TRUE(verify_result.is_issued_by_known_root);
+  ASSERT_EQ(1u, verify_result.public_key_hashes.size());
+  EXPECT_EQ(HASH_VALUE_SHA1, verify_result.public_key_hashes[0].tag);
+
+  // The stored result was added to the cache.
+  EXPECT_EQ(1u, verifier.GetCacheSize());
+  error = verifier.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                          &verify_result, callback.callback(),
+                          &request_handle, BoundNetLog());
+  EXPECT_EQ(OK, error);
+  EXPECT_EQ(2u, verifier.cache_hits());
+  EXPECT_EQ(1u, verifier.store_hits());
+}
+
+// Tests that failed verifications aren't stored.
+TEST_F(MultiThreadedCertVerifierTest, ResultStoreSkipsErrors) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  MockCertVerifyResultStore store;
+  verifier_.SetResultStore(&store);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  int error = verifier_.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                               &verify_result, callback.callback(),
+                               &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback.WaitForResult());
+  EXPECT_EQ(0u, store.size());
+}
+
+// Tests that results checked against an older CRLSet aren't used.
+TEST_F(MultiThreadedCertVerifierTest, ResultStoreCRLSetChanged) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  MockCertVerifyResultStore store;
+  MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+  verifier.SetResultStore(&store);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  int error = verifier.Verify(test_cert.get(), "www.example.com", 0,
+                              CRLSetWithSequence(1).get(), &verify_result,
+                              callback.callback(), &request_handle,
+                              BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+
+  verifier.ClearCache();
+  error = verifier.Verify(test_cert.get(), "www.example.com", 0,
+                          CRLSetWithSequence(2).get(), &verify_result,
+                          callback.callback(), &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(0u, verifier.store_hits());
+  EXPECT_EQ(2u, store.size());
+
+  verifier.ClearCache();
+  error = verifier.Verify(test_cert.get(), "www.example.com", 0,
+                          CRLSetWithSequence(2).get(), &verify_result,
+                          callback.callback(), &request_handle,
+                          BoundNetLog());
+  EXPECT_EQ(OK, error);
+  EXPECT_EQ(1u, verifier.store_hits());
+}
+
+// Tests that the store is emptied when the certificate database changes.
+TEST_F(MultiThreadedCertVerifierTest, ResultStoreCACertChanged) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  MockCertVerifyResultStore store;
+  MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+  verifier.SetResultStore(&store);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  int error = verifier.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                              &verify_result, callback.callback(),
+                              &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(1u, store.size());
+
+  verifier.OnCACertChanged(NULL);
+  EXPECT_EQ(0u, verifier.GetCacheSize());
+  EXPECT_EQ(0u, store.size());
+}
+
+// Tests that results which can't be read are removed from the store.
+TEST_F(MultiThreadedCertVerifierTest, ResultStoreInvalidResult) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  MockCertVerifyResultStore store;
+  const MultiThreadedCertVerifier::RequestParams key(
+      test_cert->fingerprint(), test_cert->ca_fingerprint(), "www.example.com",
+      0, 0, CertificateList());
+  store.SetResult(key.GetStoreKey(), "junk");
+
+  MultiThreadedCertVerifier verifier(new SuccessfulCertVerifyProc());
+  verifier.SetResultStore(&store);
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  int error = verifier.Verify(test_cert.get(), "www.example.com", 0, NULL,
+                              &verify_result, callback.callback(),
+                              &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(0u, store.size());
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(0u, verifier.store_hits());
+
+  std::string result;
+  ASSERT_TRUE(store.GetResult(key.GetStoreKey(), &result));
+  EXPECT_NE("junk", result);
+}
+
 }  // namespace net
@@ -126,6 +126,10 @@ typedef std::vector<CanonicalCookie*> CanonicalCookieVector;
 // will update it again.
 const int kDefaultAccessUpdateThresholdSeconds = 60;
 
+// Maximum number of cookie lines kept by a CookieMonster. Lines are keyed by
+// URL path, so this bounds memory use for hosts with many distinct URLs.
+const size_t kMaxCachedCookieLines = 2000;
+
 // Comparator to sort cookies from highest creation date to lowest
 // creation date.
 struct OrderByCreationTimeDesc {
@@ -312,7 +316,8 @@ std::string BuildCookieLine(const CanonicalCookieVector& cookies) {
 bool CookieMonster::default_enable_file_scheme_ = false;
 
 CookieMonster::CookieMonster(PersistentCookieStore* store, Delegate* delegate)
-    : initialized_(false),
+    : cookie_line_cache_size_(0),
+      initialized_(false),
       loaded_(false),
       store_(store),
       last_access_threshold_(
@@ -328,7 +333,8 @@ CookieMonster::CookieMonster(PersistentCookieStore* store, Delegate* delegate)
 CookieMonster::CookieMonster(PersistentCookieStore* store,
                              Delegate* delegate,
                              int last_access_threshold_milliseconds)
-    : initialized_(false),
+    : cookie_line_cache_size_(0),
+      initialized_(false),
       loaded_(false),
       store_(store),
       last_access_threshold_(base::TimeDelta::FromMilliseconds(
@@ -341,6 +347,9 @@ CookieMonster::CookieMonster(PersistentCookieStore* store,
   SetDefaultCookieableSchemes();
 }
 
+CookieMonster::CachedCookieLine::CachedCookieLine() {}
+
+CookieMonster::CachedCookieLine::~CachedCookieLine() {}
 
 // Task classes for queueing the coming request.
 
@@ -1323,11 +1332,7 @@ std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
 
   TimeTicks start_time(TimeTicks::Now());
 
-  std::vector<CanonicalCookie*> cookies;
-  FindCookiesForHostAndDomain(url, options, true, &cookies);
-  std::sort(cookies.begin(), cookies.end(), CookieSorter);
-
-  std::string cookie_line = BuildCookieLine(cookies);
+  std::string cookie_line = GetCachedCookieLine(url, options);
 
   histogram_time_get_->AddTime(TimeTicks::Now() - start_time);
 
@@ -1733,6 +1738,74 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
   }
 }
 
+std::string CookieMonster::GetCachedCookieLine(const GURL& url,
+                                               const CookieOptions& options) {
+  lock_.AssertAcquired();
+
+  const Time current(CurrentTime());
+  RecordPeriodicStats(current);
+
+  // The line depends on these, besides the cookies stored for |key|; see
+  // CanonicalCookie::IncludeForRequestURL().
+  const std::string key(GetKey(url.host()));
+  std::string line_key(url.SchemeIsSecure() ? "s" : "-");
+  line_key += options.exclude_httponly() ? "-" : "h";
+  line_key += url.host();
+  line_key += url.path();
+
+  CookieLineCache::iterator key_it = cookie_line_cache_.find(key);
+  if (key_it != cookie_line_cache_.end()) {
+    CookieLineMap::iterator it = key_it->second.find(line_key);
+    if (it != key_it->second.end() && current < it->second.expiry) {
+      const std::vector<CanonicalCookie*>& cookies = it->second.cookies;
+      for (size_t i = 0; i < cookies.size(); ++i)
+        InternalUpdateCookieAccessTime(cookies[i], current);
+      return it->second.cookie_line;
+    }
+  }
+
+  std::vector<CanonicalCookie*> cookies;
+  FindCookiesForKey(key, url, options, current, true, &cookies);
+  std::sort(cookies.begin(), cookies.end(), CookieSorter);
+  std::string cookie_line = BuildCookieLine(cookies);
+
+  // FindCookiesForKey() deletes the cookies that expired, so the line stays
+  // valid until the next cookie for |key| expires.
+  Time expiry = Time::Max();
+  for (CookieMapItPair its = cookies_.equal_range(key);
+       its.first != its.second; ++its.first) {
+    const CanonicalCookie* cc = its.first->second;
+    if (cc->IsPersistent() && cc->ExpiryDate() < expiry)
+      expiry = cc->ExpiryDate();
+  }
+
+  if (cookie_line_cache_size_ >= kMaxCachedCookieLines) {
+    cookie_line_cache_.clear();
+    cookie_line_cache_size_ = 0;
+  }
+  std::pair<CookieLineMap::iterator, bool> inserted =
+      cookie_line_cache_[key].insert(
+          CookieLineMap::value_type(line_key, CachedCookieLine()));
+  if (inserted.second)
+    ++cookie_line_cache_size_;
+  CachedCookieLine& cached_line = inserted.first->second;
+  cached_line.cookies.swap(cookies);
+  cached_line.cookie_line = cookie_line;
+  cached_line.expiry = expiry;
+
+  return cookie_line;
+}
+
+void CookieMonster::InvalidateCookieLines(const std::string& key) {
+  lock_.AssertAcquired();
+
+  CookieLineCache::iterator it = cookie_line_cache_.find(key);
+  if (it == cookie_line_cache_.end())
+    return;
+  cookie_line_cache_size_ -= it->second.size();
+  cookie_line_cache_.erase(it);
+}
+
 bool CookieMonster::DeleteAnyEquivalentCookie(const std::string& key,
                                               const CanonicalCookie& ecc,
                                               bool skip_httponly,
@@ -1775,6 +1848,7 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     store_->AddCookie(*cc);
   CookieMap::iterator inserted =
       cookies_.insert(CookieMap::value_type(key, cc));
+  InvalidateCookieLines(key);
   if (delegate_.get()) {
     delegate_->OnCookieChanged(
         *cc, false, Delegate::CHANGE_COOKIE_EXPLICIT);
@@ -1895,6 +1969,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
     if (mapping.notify)
       delegate_->OnCookieChanged(*cc, true, mapping.cause);
   }
+  InvalidateCookieLines(it->first);
   cookies_.erase(it);
   delete cc;
 }
@@ -17,6 +17,7 @@
 
 #include "base/basictypes.h"
 #include "base/callback_forward.h"
+#include "base/containers/hash_tables.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
@@ -507,6 +508,15 @@ class NET_EXPORT CookieMonster : public CookieStore {
                          bool update_access_time,
                          std::vector<CanonicalCookie*>* cookies);
 
+  // Returns the cookie line for a request to |url|, from
+  // |cookie_line_cache_| if possible. Computes and caches the line otherwise.
+  std::string GetCachedCookieLine(const GURL& url,
+                                  const CookieOptions& options);
+
+  // Drops the cookie lines cached for CookieMap key |key|. Must be called
+  // whenever a cookie is added to or removed from |key|.
+  void InvalidateCookieLines(const std::string& key);
+
   // Delete any cookies that are equivalent to |ecc| (same path, domain, etc).
   // If |skip_httponly| is true, httponly cookies will not be deleted.  The
   // return value with be true if |skip_httponly| skipped an httponly cookie.
@@ -618,6 +628,31 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // A cookie line built by GetCookiesWithOptions(), along with the cookies
+  // it was built from, in the order they appear in the line.
+  struct CachedCookieLine {
+    CachedCookieLine();
+    ~CachedCookieLine();
+
+    std::vector<CanonicalCookie*> cookies;
+    std::string cookie_line;
+    // When the first cookie stored for the CookieMap key expires. The line has
+    // to be rebuilt from that point on.
+    base::Time expiry;
+  };
+  // Cached lines for a CookieMap key, indexed by request properties; see
+  // GetCachedCookieLine().
+  typedef base::hash_map<std::string, CachedCookieLine> CookieLineMap;
+  typedef base::hash_map<std::string, CookieLineMap> CookieLineCache;
+
+  // Cookie lines per CookieMap key. Since all the cookies for a request come
+  // from a single key, adding or removing a cookie only drops the lines of
+  // its own key.
+  CookieLineCache cookie_line_cache_;
+
+  // Total number of lines in |cookie_line_cache_|.
+  size_t cookie_line_cache_size_;
+
   // Indicates whether the cookie store has been initialized. This happens
   // lazily in InitStoreIfNecessary().
   bool initialized_;
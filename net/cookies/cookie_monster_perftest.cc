@@ -182,6 +182,51 @@ TEST_F(CookieMonsterTest, TestAddCookieOnManyHosts) {
   timer3.Done();
 }
 
+// Repeated queries for the same pages, as done while browsing a handful of
+// sites, with and without cookies being set in between.
+TEST_F(CookieMonsterTest, TestRepeatedQueriesOnManyHosts) {
+  const int kNumHosts = 150;  // Stays below CookieMonster::kMaxCookies.
+  const int kCookiesPerHost = 20;
+  const int kQueriesPerHost = 40;
+
+  scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
+  SetCookieCallback setCookieCallback;
+  GetCookiesCallback getCookiesCallback;
+
+  std::vector<GURL> gurls;
+  for (int i = 0; i < kNumHosts; ++i) {
+    GURL host_url(base::StringPrintf("http://www.a%04d.izzle", i));
+    for (int j = 0; j < kCookiesPerHost; ++j) {
+      setCookieCallback.SetCookie(
+          cm.get(), host_url, base::StringPrintf("c%02d=some_value_%d", j, j));
+    }
+    gurls.push_back(GURL(base::StringPrintf("http://www.a%04d.izzle/page", i)));
+  }
+
+  base::PerfTimeLogger timer("Cookie_monster_repeated_query_many_hosts");
+  for (int i = 0; i < kQueriesPerHost; ++i) {
+    for (std::vector<GURL>::const_iterator it = gurls.begin();
+         it != gurls.end(); ++it) {
+      getCookiesCallback.GetCookies(cm.get(), *it);
+    }
+  }
+  timer.Done();
+
+  // Every tenth request updates a cookie for the host.
+  base::PerfTimeLogger timer2(
+      "Cookie_monster_repeated_query_many_hosts_with_updates");
+  for (int i = 0; i < kQueriesPerHost; ++i) {
+    for (size_t j = 0; j < gurls.size(); ++j) {
+      if ((i * gurls.size() + j) % 10 == 0) {
+        setCookieCallback.SetCookie(cm.get(), gurls[j],
+                                    base::StringPrintf("c00=value_%d", i));
+      }
+      getCookiesCallback.GetCookies(cm.get(), gurls[j]);
+    }
+  }
+  timer2.Done();
+}
+
 TEST_F(CookieMonsterTest, TestDomainTree) {
   scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
   GetCookiesCallback getCookiesCallback;
@@ -2723,4 +2723,43 @@ TEST_F(CookieMonsterTest, ControlCharacterPurge) {
   EXPECT_EQ("foo=bar; hello=world", GetCookies(cm.get(), url));
 }
 
+// Tests that cached cookie lines follow changes to the store.
+TEST_F(CookieMonsterTest, CookieLineCache) {
+  scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
+  CookieOptions options;
+  options.set_include_httponly();
+
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "A=B"));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), url_google_));
+
+  // Adding, overwriting and deleting cookies is reflected in the line.
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "C=D"));
+  EXPECT_EQ("A=B; C=D", GetCookies(cm.get(), url_google_));
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "A=E"));
+  EXPECT_EQ("C=D; A=E", GetCookies(cm.get(), url_google_));
+  DeleteCookie(cm.get(), url_google_, "C");
+  EXPECT_EQ("A=E", GetCookies(cm.get(), url_google_));
+
+  // Lines are specific to the path, scheme and options of the request.
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_foo_, "F=G; path=/foo"));
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_secure_, "S=T; secure"));
+  EXPECT_TRUE(SetCookieWithOptions(cm.get(), url_google_, "H=I; httponly",
+                                   options));
+  EXPECT_EQ("A=E", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("F=G; A=E", GetCookies(cm.get(), url_google_foo_));
+  EXPECT_EQ("A=E; S=T", GetCookies(cm.get(), url_google_secure_));
+  EXPECT_EQ("A=E; H=I", GetCookiesWithOptions(cm.get(), url_google_, options));
+
+  // A cookie that expires is dropped from the line.
+  EXPECT_TRUE(SetCookie(cm.get(), url_google_, "X=Y; max-age=1"));
+  EXPECT_EQ("A=E; X=Y", GetCookies(cm.get(), url_google_));
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(1100));
+  EXPECT_EQ("A=E", GetCookies(cm.get(), url_google_));
+
+  EXPECT_EQ(4, DeleteAll(cm.get()));
+  EXPECT_EQ("", GetCookies(cm.get(), url_google_));
+  EXPECT_EQ("", GetCookies(cm.get(), url_google_foo_));
+}
+
 }  // namespace net
@@ -21,6 +21,7 @@ DnsConfig::DnsConfig()
       timeout(base::TimeDelta::FromSeconds(kDnsTimeoutSeconds)),
       attempts(2),
       rotate(false),
+      num_parallel_servers(1),
       edns0(false),
       use_local_ipv6(false) {}
 
@@ -39,6 +40,7 @@ bool DnsConfig::EqualsIgnoreHosts(const DnsConfig& d) const {
          (timeout == d.timeout) &&
          (attempts == d.attempts) &&
          (rotate == d.rotate) &&
+         (num_parallel_servers == d.num_parallel_servers) &&
          (edns0 == d.edns0) &&
          (use_local_ipv6 == d.use_local_ipv6);
 }
@@ -52,6 +54,7 @@ void DnsConfig::CopyIgnoreHosts(const DnsConfig& d) {
   timeout = d.timeout;
   attempts = d.attempts;
   rotate = d.rotate;
+  num_parallel_servers = d.num_parallel_servers;
   edns0 = d.edns0;
   use_local_ipv6 = d.use_local_ipv6;
 }
@@ -75,6 +78,7 @@ base::Value* DnsConfig::ToValue() const {
   dict->SetDouble("timeout", timeout.InSecondsF());
   dict->SetInteger("attempts", attempts);
   dict->SetBoolean("rotate", rotate);
+  dict->SetInteger("num_parallel_servers", num_parallel_servers);
   dict->SetBoolean("edns0", edns0);
   dict->SetBoolean("use_local_ipv6", use_local_ipv6);
   dict->SetInteger("num_hosts", hosts.size());
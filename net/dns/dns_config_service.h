@@ -81,6 +81,12 @@ struct NET_EXPORT_PRIVATE DnsConfig {
   int attempts;
   // Round robin entries in |nameservers| for subsequent requests.
   bool rotate;
+  // Number of servers each query is first sent to in parallel, fastest first
+  // by observed round-trip times. The first good response wins. When 1, the
+  // servers are tried one at a time, as given by |rotate|. Not part of the
+  // system configuration: HostResolverImpl sets it from the
+  // AsyncDnsParallelServers field trial.
+  int num_parallel_servers;
   // Enable EDNS0 extensions.
   bool edns0;
 
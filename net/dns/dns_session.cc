@@ -4,6 +4,8 @@
 
 #include "net/dns/dns_session.h"
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/lazy_instance.h"
@@ -31,6 +33,24 @@ const unsigned kMinTimeoutMs = 10;
 const size_t kRTTBucketCount = 100;
 // Target percentile in the RTT histogram used for retransmission timeout.
 const unsigned kRTOPercentile = 99;
+// Percentile in the RTT histogram used to rank servers.
+const unsigned kRankPercentile = 50;
+
+// A server as ranked by DnsSession::RankServers.
+struct RankedServer {
+  unsigned index;
+  bool failed;
+  base::Time last_failure;
+  base::TimeDelta rtt;
+};
+
+bool RankedServerLess(const RankedServer& a, const RankedServer& b) {
+  if (a.failed != b.failed)
+    return !a.failed;
+  if (a.failed)
+    return a.last_failure < b.last_failure;
+  return a.rtt < b.rtt;
+}
 }  // namespace
 
 // Runtime statistics of DNS server.
@@ -137,6 +157,23 @@ unsigned DnsSession::NextGoodServerIndex(unsigned server_index) {
   return oldest_server_failure_index;
 }
 
+void DnsSession::RankServers(std::vector<unsigned>* server_indices) {
+  std::vector<RankedServer> servers(server_stats_.size());
+  for (size_t i = 0; i < servers.size(); ++i) {
+    servers[i].index = i;
+    servers[i].failed =
+        server_stats_[i]->last_failure_count >= config_.attempts;
+    servers[i].last_failure = server_stats_[i]->last_failure;
+    servers[i].rtt = GetRTTPercentile(i, kRankPercentile);
+  }
+  // Keep the configured order between equally good servers.
+  std::stable_sort(servers.begin(), servers.end(), RankedServerLess);
+
+  server_indices->clear();
+  for (size_t i = 0; i < servers.size(); ++i)
+    server_indices->push_back(servers[i].index);
+}
+
 void DnsSession::RecordServerFailure(unsigned server_index) {
   UMA_HISTOGRAM_CUSTOM_COUNTS(
       "AsyncDNS.ServerFailureIndex", server_index, 0, 10, 10);
@@ -268,31 +305,37 @@ base::TimeDelta DnsSession::NextTimeoutFromHistogram(unsigned server_index,
                                                      int attempt) {
   DCHECK_LT(server_index, server_stats_.size());
 
+  // Use fixed percentile of observed samples.
+  base::TimeDelta timeout = GetRTTPercentile(server_index, kRTOPercentile);
+
+  timeout = std::max(timeout, base::TimeDelta::FromMilliseconds(kMinTimeoutMs));
+
+  // The timeout still doubles every full round.
+  unsigned num_backoffs = attempt / config_.nameservers.size();
+
+  return std::min(timeout * (1 << num_backoffs),
+                  base::TimeDelta::FromMilliseconds(kMaxTimeoutMs));
+}
+
+base::TimeDelta DnsSession::GetRTTPercentile(unsigned server_index,
+                                             unsigned percentile) const {
+  DCHECK_LT(server_index, server_stats_.size());
+
   COMPILE_ASSERT(std::numeric_limits<base::HistogramBase::Count>::is_signed,
                  histogram_base_count_assumed_to_be_signed);
 
-  // Use fixed percentile of observed samples.
   const base::SampleVector& samples =
       *server_stats_[server_index]->rtt_histogram;
 
   base::HistogramBase::Count total = samples.TotalCount();
-  base::HistogramBase::Count remaining_count = kRTOPercentile * total / 100;
+  base::HistogramBase::Count remaining_count = percentile * total / 100;
   size_t index = 0;
   while (remaining_count > 0 && index < rtt_buckets_.Get().size()) {
     remaining_count -= samples.GetCountAtIndex(index);
     ++index;
   }
 
-  base::TimeDelta timeout =
-      base::TimeDelta::FromMilliseconds(rtt_buckets_.Get().range(index));
-
-  timeout = std::max(timeout, base::TimeDelta::FromMilliseconds(kMinTimeoutMs));
-
-  // The timeout still doubles every full round.
-  unsigned num_backoffs = attempt / config_.nameservers.size();
-
-  return std::min(timeout * (1 << num_backoffs),
-                  base::TimeDelta::FromMilliseconds(kMaxTimeoutMs));
+  return base::TimeDelta::FromMilliseconds(rtt_buckets_.Get().range(index));
 }
 
 }  // namespace net
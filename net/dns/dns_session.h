@@ -77,6 +77,12 @@ class NET_EXPORT_PRIVATE DnsSession
   // or have failed longer time ago.
   unsigned NextGoodServerIndex(unsigned server_index);
 
+  // Fills |server_indices| with the indices of all configured servers, best
+  // first: the servers that have not failed |DnsConfig::attempts| times in a
+  // row come first, by their median observed RTT, followed by the failed ones,
+  // those that failed longest ago first.
+  void RankServers(std::vector<unsigned>* server_indices);
+
   // Record that server failed to respond (due to SRV_FAIL or timeout).
   void RecordServerFailure(unsigned server_index);
 
@@ -120,6 +126,10 @@ class NET_EXPORT_PRIVATE DnsSession
   // Compute the timeout using the histogram method.
   base::TimeDelta NextTimeoutFromHistogram(unsigned server_index, int attempt);
 
+  // Return the given |percentile| of the RTTs observed for the server.
+  base::TimeDelta GetRTTPercentile(unsigned server_index,
+                                   unsigned percentile) const;
+
   const DnsConfig config_;
   scoped_ptr<DnsSocketPool> socket_pool_;
   RandCallback rand_callback_;
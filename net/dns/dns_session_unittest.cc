@@ -5,6 +5,7 @@
 #include "net/dns/dns_session.h"
 
 #include <list>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/memory/scoped_ptr.h"
@@ -247,6 +248,35 @@ TEST_F(DnsSessionTest, HistogramTimeoutLong) {
   EXPECT_EQ(config_.timeout.InMilliseconds(), timeout.InMilliseconds());
 }
 
+// Expect servers ranked by observed RTT, with failed servers last.
+TEST_F(DnsSessionTest, RankServers) {
+  Initialize(4);
+  std::vector<unsigned> order;
+  session_->RankServers(&order);
+  const unsigned kConfigOrder[] = { 0, 1, 2, 3 };
+  EXPECT_EQ(std::vector<unsigned>(kConfigOrder,
+                                  kConfigOrder + arraysize(kConfigOrder)),
+            order);
+
+  session_->RecordRTT(3, base::TimeDelta::FromMilliseconds(50));
+  session_->RecordRTT(2, base::TimeDelta::FromMilliseconds(20));
+  for (int i = 0; i < config_.attempts; ++i)
+    session_->RecordServerFailure(1);
+  session_->RankServers(&order);
+  const unsigned kRankedOrder[] = { 2, 3, 0, 1 };
+  EXPECT_EQ(std::vector<unsigned>(kRankedOrder,
+                                  kRankedOrder + arraysize(kRankedOrder)),
+            order);
+
+  session_->RecordServerSuccess(1);
+  session_->RecordRTT(1, base::TimeDelta::FromMilliseconds(5));
+  session_->RankServers(&order);
+  const unsigned kRecoveredOrder[] = { 1, 2, 3, 0 };
+  EXPECT_EQ(std::vector<unsigned>(kRecoveredOrder,
+                                  kRecoveredOrder + arraysize(kRecoveredOrder)),
+            order);
+}
+
 }  // namespace
 
 } // namespace net
@@ -4,6 +4,7 @@
 
 #include "net/dns/dns_transaction.h"
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <vector>
@@ -513,6 +514,9 @@ class DnsTCPAttempt : public DnsAttempt {
 // The first server to attempt on each query is given by
 // DnsSession::NextFirstServerIndex, and the order is round-robin afterwards.
 // Each server is attempted DnsConfig::attempts times.
+// If DnsConfig::num_parallel_servers is more than 1, the servers are instead
+// tried in the order given by DnsSession::RankServers, and each query is first
+// sent to that many of them at once. The first successful response wins.
 class DnsTransactionImpl : public DnsTransaction,
                            public base::NonThreadSafe,
                            public base::SupportsWeakPtr<DnsTransactionImpl> {
@@ -675,10 +679,16 @@ class DnsTransactionImpl : public DnsTransaction,
 
     const DnsConfig& config = session_->config();
 
-    unsigned server_index =
-        (first_server_index_ + attempt_number) % config.nameservers.size();
-    // Skip over known failed servers.
-    server_index = session_->NextGoodServerIndex(server_index);
+    unsigned server_index;
+    if (!server_order_.empty()) {
+      // Failed servers are already ranked last.
+      server_index = server_order_[attempt_number % server_order_.size()];
+    } else {
+      server_index =
+          (first_server_index_ + attempt_number) % config.nameservers.size();
+      // Skip over known failed servers.
+      server_index = session_->NextGoodServerIndex(server_index);
+    }
 
     scoped_ptr<DnsSession::SocketLease> lease =
         session_->AllocateSocket(server_index, net_log_.source());
@@ -752,17 +762,28 @@ class DnsTransactionImpl : public DnsTransaction,
     return AttemptResult(rv, attempt);
   }
 
-  // Begins query for the current name. Makes the first attempt.
+  // Begins query for the current name. Makes the first attempt, or the first
+  // DnsConfig::num_parallel_servers attempts at once.
   AttemptResult StartQuery() {
     std::string dotted_qname = DNSDomainToString(qnames_.front());
     net_log_.BeginEvent(NetLog::TYPE_DNS_TRANSACTION_QUERY,
                         NetLog::StringCallback("qname", &dotted_qname));
 
-    first_server_index_ = session_->NextFirstServerIndex();
+    const DnsConfig& config = session_->config();
+    size_t num_parallel = std::min<size_t>(
+        std::max(config.num_parallel_servers, 1), config.nameservers.size());
+    if (num_parallel > 1)
+      session_->RankServers(&server_order_);
+    else
+      first_server_index_ = session_->NextFirstServerIndex();
     RecordLostPacketsIfAny();
     attempts_.clear();
     had_tcp_attempt_ = false;
-    return MakeAttempt();
+
+    AttemptResult result = MakeAttempt();
+    while (result.rv == ERR_IO_PENDING && attempts_.size() < num_parallel)
+      result = MakeAttempt();
+    return result;
   }
 
   void OnUdpAttemptComplete(unsigned attempt_number,
@@ -789,6 +810,11 @@ class DnsTransactionImpl : public DnsTransaction,
 
   // Record packet loss for any incomplete attempts.
   void RecordLostPacketsIfAny() {
+    // Attempts made in parallel to other servers are expected to still be
+    // pending when the fastest one completes, so they aren't lost packets.
+    if (!server_order_.empty())
+      return;
+
     // Loop through attempts until we find first that is completed
     size_t first_completed = 0;
     for (first_completed = 0; first_completed < attempts_.size();
@@ -922,6 +948,9 @@ class DnsTransactionImpl : public DnsTransaction,
 
   // Index of the first server to try on each search query.
   int first_server_index_;
+  // Order of the servers to try on each search query, when querying several
+  // of them in parallel. Empty otherwise.
+  std::vector<unsigned> server_order_;
 
   base::OneShotTimer<DnsTransactionImpl> timer_;
 
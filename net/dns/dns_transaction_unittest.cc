@@ -658,6 +658,79 @@ TEST_F(DnsTransactionTest, ServerFallbackAndRotate) {
   CheckServerOrder(kOrder, arraysize(kOrder));
 }
 
+TEST_F(DnsTransactionTest, ParallelServersFirstResponseWins) {
+  config_.num_parallel_servers = 2;
+  ConfigureNumServers(3);
+  ConfigureFactory();
+
+  // The first server is slow to respond, so the second one wins.
+  AddQueryAndTimeout(kT0HostName, kT0Qtype);
+  AddAsyncQueryAndResponse(0 /* id */, kT0HostName, kT0Qtype,
+                           kT0ResponseDatagram, arraysize(kT0ResponseDatagram));
+
+  TransactionHelper helper0(kT0HostName, kT0Qtype, kT0RecordCount);
+  EXPECT_TRUE(helper0.Run(transaction_factory_.get()));
+
+  unsigned kOrder[] = { 0, 1 };
+  CheckServerOrder(kOrder, arraysize(kOrder));
+}
+
+TEST_F(DnsTransactionTest, ParallelServersIgnoreFailure) {
+  config_.num_parallel_servers = 2;
+  ConfigureNumServers(2);
+  ConfigureFactory();
+
+  // A failure from one server doesn't end the query while the other one can
+  // still respond.
+  AddAsyncQueryAndRcode(kT0HostName, kT0Qtype, dns_protocol::kRcodeSERVFAIL);
+  AddAsyncQueryAndResponse(0 /* id */, kT0HostName, kT0Qtype,
+                           kT0ResponseDatagram, arraysize(kT0ResponseDatagram));
+
+  TransactionHelper helper0(kT0HostName, kT0Qtype, kT0RecordCount);
+  EXPECT_TRUE(helper0.Run(transaction_factory_.get()));
+
+  unsigned kOrder[] = { 0, 1 };
+  CheckServerOrder(kOrder, arraysize(kOrder));
+}
+
+TEST_F(DnsTransactionTest, ParallelServersFallback) {
+  config_.num_parallel_servers = 2;
+  ConfigureNumServers(3);
+  ConfigureFactory();
+
+  // When the last of the parallel attempts fails, the next server is tried.
+  AddQueryAndTimeout(kT0HostName, kT0Qtype);
+  AddAsyncQueryAndRcode(kT0HostName, kT0Qtype, dns_protocol::kRcodeSERVFAIL);
+  AddAsyncQueryAndResponse(0 /* id */, kT0HostName, kT0Qtype,
+                           kT0ResponseDatagram, arraysize(kT0ResponseDatagram));
+
+  TransactionHelper helper0(kT0HostName, kT0Qtype, kT0RecordCount);
+  EXPECT_TRUE(helper0.Run(transaction_factory_.get()));
+
+  unsigned kOrder[] = { 0, 1, 2 };
+  CheckServerOrder(kOrder, arraysize(kOrder));
+}
+
+TEST_F(DnsTransactionTest, ParallelServersRankedByRTT) {
+  config_.num_parallel_servers = 2;
+  ConfigureNumServers(3);
+  ConfigureFactory();
+
+  // The fastest server is queried first, and the failed one last.
+  session_->RecordRTT(2, base::TimeDelta::FromMilliseconds(10));
+  session_->RecordServerFailure(0);
+
+  AddAsyncQueryAndResponse(0 /* id */, kT0HostName, kT0Qtype,
+                           kT0ResponseDatagram, arraysize(kT0ResponseDatagram));
+  AddQueryAndTimeout(kT0HostName, kT0Qtype);
+
+  TransactionHelper helper0(kT0HostName, kT0Qtype, kT0RecordCount);
+  EXPECT_TRUE(helper0.Run(transaction_factory_.get()));
+
+  unsigned kOrder[] = { 2, 1 };
+  CheckServerOrder(kOrder, arraysize(kOrder));
+}
+
 TEST_F(DnsTransactionTest, SuffixSearchAboveNdots) {
   config_.ndots = 2;
   config_.search.push_back("a");
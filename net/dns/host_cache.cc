@@ -8,10 +8,23 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 
 namespace net {
 
+namespace {
+
+// Keys of the dictionaries built by HostCache::GetAsListValue().
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kAddressesKey[] = "addresses";
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -49,6 +62,21 @@ const HostCache::Entry* HostCache::Lookup(const Key& key,
   return entries_.Get(key, now);
 }
 
+const HostCache::Entry* HostCache::LookupStale(
+    const Key& key,
+    base::TimeTicks now,
+    base::TimeDelta* expires_in) const {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return NULL;
+
+  base::TimeTicks expiration;
+  const Entry* entry = entries_.GetIncludingExpired(key, &expiration);
+  if (entry)
+    *expires_in = expiration - now;
+  return entry;
+}
+
 void HostCache::Set(const Key& key,
                     const Entry& entry,
                     base::TimeTicks now,
@@ -60,6 +88,89 @@ void HostCache::Set(const Key& key,
   entries_.Put(key, entry, now, now + ttl);
 }
 
+void HostCache::GetAsListValue(base::ListValue* entry_list,
+                               base::TimeTicks now,
+                               base::Time wall_now) const {
+  DCHECK(CalledOnValidThread());
+  DCHECK(entry_list);
+
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    const Entry& entry = it.value();
+    // Failures are only cached for a short time, and are not worth keeping.
+    if (entry.error != OK)
+      continue;
+
+    base::ListValue* addresses = new base::ListValue();
+    for (size_t i = 0; i < entry.addrlist.size(); ++i)
+      addresses->AppendString(entry.addrlist[i].ToStringWithoutPort());
+
+    base::Time expiration = wall_now + (it.expiration() - now);
+
+    base::DictionaryValue* entry_dict = new base::DictionaryValue();
+    entry_dict->SetString(kHostnameKey, it.key().hostname);
+    entry_dict->SetInteger(kAddressFamilyKey, it.key().address_family);
+    entry_dict->SetInteger(kFlagsKey, it.key().host_resolver_flags);
+    // Stored as a string since base::Value has no 64-bit integer type.
+    entry_dict->SetString(kExpirationKey,
+                          base::Int64ToString(expiration.ToInternalValue()));
+    entry_dict->Set(kAddressesKey, addresses);
+    entry_list->Append(entry_dict);
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& entry_list,
+                                     base::TimeTicks now,
+                                     base::Time wall_now) {
+  DCHECK(CalledOnValidThread());
+
+  for (size_t i = 0; i < entry_list.GetSize(); ++i) {
+    // Do not let restored entries, which are likely expired, push each other
+    // out when the cache compacts.
+    if (entries_.size() >= entries_.max_entries())
+      return true;
+
+    const base::DictionaryValue* entry_dict;
+    std::string hostname;
+    int address_family;
+    int flags;
+    std::string expiration_string;
+    int64 expiration_value;
+    const base::ListValue* addresses;
+    if (!entry_list.GetDictionary(i, &entry_dict) ||
+        !entry_dict->GetString(kHostnameKey, &hostname) ||
+        !entry_dict->GetInteger(kAddressFamilyKey, &address_family) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_IPV6 ||
+        !entry_dict->GetInteger(kFlagsKey, &flags) ||
+        !entry_dict->GetString(kExpirationKey, &expiration_string) ||
+        !base::StringToInt64(expiration_string, &expiration_value) ||
+        !entry_dict->GetList(kAddressesKey, &addresses)) {
+      return false;
+    }
+
+    AddressList address_list;
+    for (size_t j = 0; j < addresses->GetSize(); ++j) {
+      std::string address_string;
+      IPAddressNumber address;
+      if (!addresses->GetString(j, &address_string) ||
+          !ParseIPLiteralToNumber(address_string, &address)) {
+        return false;
+      }
+      address_list.push_back(IPEndPoint(address, 0));
+    }
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    base::TimeTicks unused_expiration;
+    if (entries_.GetIncludingExpired(key, &unused_expiration))
+      continue;
+
+    base::Time expiration = base::Time::FromInternalValue(expiration_value);
+    entries_.Put(key, Entry(OK, address_list), now,
+                 now + (expiration - wall_now));
+  }
+  return true;
+}
+
 void HostCache::clear() {
   DCHECK(CalledOnValidThread());
   entries_.Clear();
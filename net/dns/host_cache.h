@@ -17,6 +17,10 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -82,6 +86,14 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // |now|. If there is no such entry, returns NULL.
   const Entry* Lookup(const Key& key, base::TimeTicks now);
 
+  // Returns a pointer to the entry for |key| even if it is no longer valid at
+  // time |now|, and sets |expires_in| to the time left until it expires, which
+  // is negative for an expired entry. Expired entries are not removed. If
+  // there is no such entry, returns NULL.
+  const Entry* LookupStale(const Key& key,
+                           base::TimeTicks now,
+                           base::TimeDelta* expires_in) const;
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -90,6 +102,25 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
            base::TimeTicks now,
            base::TimeDelta ttl);
 
+  // Appends a dictionary describing each successful entry to |entry_list|, so
+  // that the cache can be saved to disk and restored by the next session.
+  // Expiration times are stored as wall clock times, computed from the pair
+  // of equivalent times |now| and |wall_now|, as base::TimeTicks values do not
+  // survive a restart.
+  void GetAsListValue(base::ListValue* entry_list,
+                      base::TimeTicks now,
+                      base::Time wall_now) const;
+
+  // Adds the entries from a list built by GetAsListValue(), converting their
+  // expiration times back using |now| and |wall_now|. Entries that are already
+  // in the cache are kept, as they are at least as recent as the saved ones.
+  // Restored entries are often expired, and are only useful to a resolver
+  // that serves stale entries. Returns false if |entry_list| is malformed, in
+  // which case the entries that precede the error are still added.
+  bool RestoreFromListValue(const base::ListValue& entry_list,
+                            base::TimeTicks now,
+                            base::Time wall_now);
+
   // Empties the cache
   void clear();
 
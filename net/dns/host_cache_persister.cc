@@ -0,0 +1,78 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/location.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/dns/host_cache.h"
+
+namespace net {
+
+namespace {
+
+void ReadFile(const base::FilePath& path, std::string* data) {
+  if (!base::ReadFileToString(path, data))
+    data->clear();
+}
+
+}  // namespace
+
+HostCachePersister::HostCachePersister(
+    HostCache* cache,
+    const base::FilePath& path,
+    base::SequencedTaskRunner* task_runner)
+    : cache_(cache),
+      task_runner_(task_runner),
+      writer_(path, task_runner),
+      weak_factory_(this) {
+  DCHECK(cache_);
+}
+
+HostCachePersister::~HostCachePersister() {
+  Save();
+}
+
+void HostCachePersister::Load(const base::Closure& callback) {
+  DCHECK(CalledOnValidThread());
+  std::string* data = new std::string;
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadFile, writer_.path(), data),
+      base::Bind(&HostCachePersister::OnFileRead, weak_factory_.GetWeakPtr(),
+                 callback, base::Owned(data)));
+}
+
+void HostCachePersister::Save() {
+  DCHECK(CalledOnValidThread());
+  base::ListValue entries;
+  cache_->GetAsListValue(&entries, base::TimeTicks::Now(), base::Time::Now());
+  std::string data;
+  base::JSONWriter::Write(&entries, &data);
+  writer_.WriteNow(data);
+}
+
+void HostCachePersister::OnFileRead(const base::Closure& callback,
+                                    const std::string* data) {
+  DCHECK(CalledOnValidThread());
+  scoped_ptr<base::Value> value(base::JSONReader::Read(*data));
+  base::ListValue* entries;
+  if (value && value->GetAsList(&entries)) {
+    if (!cache_->RestoreFromListValue(*entries, base::TimeTicks::Now(),
+                                      base::Time::Now())) {
+      LOG(WARNING) << "Malformed host cache in " << writer_.path().value();
+    }
+  }
+  callback.Run();
+}
+
+}  // namespace net
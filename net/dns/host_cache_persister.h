@@ -0,0 +1,65 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+class HostCache;
+
+// Keeps the successful entries of a HostCache in a file across restarts, see
+// HostCache::GetAsListValue(). The owner of the resolver calls Load() before
+// the resolver is used, and the entries are written out when the persister is
+// destroyed, at shutdown.
+class NET_EXPORT HostCachePersister
+    : NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // |cache| must outlive this object. The file is read and written on
+  // |task_runner|.
+  HostCachePersister(HostCache* cache,
+                     const base::FilePath& path,
+                     base::SequencedTaskRunner* task_runner);
+
+  // Starts writing out the entries of the cache.
+  ~HostCachePersister();
+
+  // Reads the file, and runs |callback| once its entries have been added to
+  // the cache. Entries added to the cache before then take precedence over
+  // the ones in the file.
+  void Load(const base::Closure& callback);
+
+  // Starts writing out the entries of the cache.
+  void Save();
+
+ private:
+  void OnFileRead(const base::Closure& callback, const std::string* data);
+
+  HostCache* const cache_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<HostCachePersister> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
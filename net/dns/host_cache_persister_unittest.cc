@@ -0,0 +1,179 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "net/base/address_list.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/base/prioritized_dispatcher.h"
+#include "net/base/request_priority.h"
+#include "net/base/test_completion_callback.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_resolver_impl.h"
+#include "net/dns/mock_host_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxCacheEntries = 10;
+
+HostCache::Key Key(const std::string& hostname) {
+  return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
+}
+
+AddressList MakeAddressList(const char* ip_literal) {
+  IPAddressNumber address;
+  EXPECT_TRUE(ParseIPLiteralToNumber(ip_literal, &address));
+  return AddressList(IPEndPoint(address, 0));
+}
+
+class HostCachePersisterTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("Host Cache");
+  }
+
+  scoped_ptr<HostCachePersister> CreatePersister(HostCache* cache) {
+    return scoped_ptr<HostCachePersister>(new HostCachePersister(
+        cache, path_, base::MessageLoopProxy::current()));
+  }
+
+  void Load(HostCachePersister* persister) {
+    base::RunLoop run_loop;
+    persister->Load(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  // Destroys |persister|, and waits for it to finish writing the file.
+  void Shutdown(scoped_ptr<HostCachePersister> persister) {
+    persister.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(HostCachePersisterTest, LoadWithoutFile) {
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister(CreatePersister(&cache));
+  Load(persister.get());
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(HostCachePersisterTest, SaveAndLoad) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromHours(1);
+  {
+    HostCache cache(kMaxCacheEntries);
+    scoped_ptr<HostCachePersister> persister(CreatePersister(&cache));
+    Load(persister.get());
+    cache.Set(Key("ok.com"), HostCache::Entry(OK, MakeAddressList("1.2.3.4")),
+              base::TimeTicks::Now(), kTTL);
+    cache.Set(Key("nx.com"),
+              HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()),
+              base::TimeTicks::Now(), kTTL);
+    Shutdown(persister.Pass());
+  }
+  EXPECT_TRUE(base::PathExists(path_));
+
+  // The next session gets the successful entry back.
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister(CreatePersister(&cache));
+  Load(persister.get());
+  EXPECT_EQ(1u, cache.size());
+  const HostCache::Entry* entry =
+      cache.Lookup(Key("ok.com"), base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(1u, entry->addrlist.size());
+  EXPECT_EQ("1.2.3.4", entry->addrlist[0].ToStringWithoutPort());
+}
+
+// Entries resolved before the file is read are newer than the saved ones.
+TEST_F(HostCachePersisterTest, LoadKeepsNewerEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromHours(1);
+  {
+    HostCache cache(kMaxCacheEntries);
+    cache.Set(Key("a.com"), HostCache::Entry(OK, MakeAddressList("1.2.3.4")),
+              base::TimeTicks::Now(), kTTL);
+    Shutdown(CreatePersister(&cache));
+  }
+
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister(CreatePersister(&cache));
+  cache.Set(Key("a.com"), HostCache::Entry(OK, MakeAddressList("5.6.7.8")),
+            base::TimeTicks::Now(), kTTL);
+  Load(persister.get());
+  const HostCache::Entry* entry =
+      cache.Lookup(Key("a.com"), base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("5.6.7.8", entry->addrlist[0].ToStringWithoutPort());
+}
+
+TEST_F(HostCachePersisterTest, MalformedFile) {
+  const char kData[] = "{\"not\": \"a list\"}";
+  ASSERT_EQ(static_cast<int>(sizeof(kData) - 1),
+            file_util::WriteFile(path_, kData, sizeof(kData) - 1));
+
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister(CreatePersister(&cache));
+  Load(persister.get());
+  EXPECT_EQ(0u, cache.size());
+}
+
+// An entry that expired while the browser was not running is served after a
+// restart by a resolver that allows stale entries.
+TEST_F(HostCachePersisterTest, RestoredEntryServedAfterRestart) {
+  const HostCache::Key kKey("a.com", ADDRESS_FAMILY_IPV4, 0);
+  {
+    HostCache cache(kMaxCacheEntries);
+    cache.Set(kKey, HostCache::Entry(OK, MakeAddressList("1.2.3.4")),
+              base::TimeTicks::Now(), base::TimeDelta());
+    Shutdown(CreatePersister(&cache));
+  }
+
+  scoped_refptr<RuleBasedHostResolverProc> proc(
+      new RuleBasedHostResolverProc(NULL));
+  proc->AddRule("a.com", "5.6.7.8");
+  HostResolverImpl resolver(
+      HostCache::CreateDefaultCache(),
+      PrioritizedDispatcher::Limits(NUM_PRIORITIES, 1),
+      HostResolverImpl::ProcTaskParams(proc.get(), 1),
+      NULL);
+  resolver.SetMaxCacheStaleness(base::TimeDelta::FromDays(1));
+  scoped_ptr<HostCachePersister> persister(
+      CreatePersister(resolver.GetHostCache()));
+  Load(persister.get());
+
+  HostResolver::RequestInfo info(HostPortPair("a.com", 80));
+  info.set_address_family(ADDRESS_FAMILY_IPV4);
+  AddressList addresses;
+  TestCompletionCallback callback;
+  HostResolver::RequestHandle request;
+  EXPECT_EQ(OK, resolver.Resolve(info, DEFAULT_PRIORITY, &addresses,
+                                 callback.callback(), &request,
+                                 BoundNetLog()));
+  ASSERT_EQ(1u, addresses.size());
+  EXPECT_EQ("1.2.3.4", addresses[0].ToStringWithoutPort());
+}
+
+}  // namespace
+
+}  // namespace net
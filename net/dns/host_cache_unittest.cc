@@ -8,7 +8,9 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -22,6 +24,12 @@ HostCache::Key Key(const std::string& hostname) {
   return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
 }
 
+AddressList MakeAddressList(const char* ip_literal) {
+  IPAddressNumber address;
+  EXPECT_TRUE(ParseIPLiteralToNumber(ip_literal, &address));
+  return AddressList(IPEndPoint(address, 0));
+}
+
 }  // namespace
 
 TEST(HostCacheTest, Basic) {
@@ -385,4 +393,149 @@ TEST(HostCacheTest, KeyComparators) {
   }
 }
 
+TEST(HostCacheTest, LookupStale) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Start at t=0.
+  base::TimeTicks now;
+
+  HostCache::Key key = Key("foobar.com");
+  base::TimeDelta expires_in;
+  EXPECT_FALSE(cache.LookupStale(key, now, &expires_in));
+
+  cache.Set(key, HostCache::Entry(OK, AddressList()), now, kTTL);
+  EXPECT_TRUE(cache.LookupStale(key, now, &expires_in));
+  EXPECT_EQ(kTTL, expires_in);
+
+  // Advance to t=15; the entry has been expired for 5 seconds.
+  now += base::TimeDelta::FromSeconds(15);
+  EXPECT_TRUE(cache.LookupStale(key, now, &expires_in));
+  EXPECT_EQ(base::TimeDelta::FromSeconds(-5), expires_in);
+  EXPECT_EQ(1U, cache.size());
+
+  // Lookup() does not return it, and removes it.
+  EXPECT_FALSE(cache.Lookup(key, now));
+  EXPECT_FALSE(cache.LookupStale(key, now, &expires_in));
+}
+
+TEST(HostCacheTest, SerializeAndRestore) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+  base::TimeTicks now;
+  base::Time wall_now = base::Time::FromDoubleT(1000000);
+
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Key key2("foobar2.com", ADDRESS_FAMILY_IPV6, 0);
+  HostCache::Key key3 = Key("negative.com");
+  AddressList addresses1 = MakeAddressList("1.2.3.4");
+  addresses1.push_back(MakeAddressList("5.6.7.8")[0]);
+  AddressList addresses2 = MakeAddressList("::1");
+  cache.Set(key1, HostCache::Entry(OK, addresses1), now, kTTL);
+  cache.Set(key2, HostCache::Entry(OK, addresses2), now, 2 * kTTL);
+  cache.Set(key3, HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now,
+            kTTL);
+
+  base::ListValue entry_list;
+  cache.GetAsListValue(&entry_list, now, wall_now);
+  // The negative entry is not saved.
+  EXPECT_EQ(2U, entry_list.GetSize());
+
+  // Restore in a new session, 15 seconds later, with an unrelated clock.
+  HostCache restored_cache(kMaxCacheEntries);
+  base::TimeTicks restore_now = now + base::TimeDelta::FromHours(3);
+  base::Time restore_wall_now = wall_now + base::TimeDelta::FromSeconds(15);
+  HostCache::Key key4 = Key("fresh.com");
+  restored_cache.Set(key4, HostCache::Entry(OK, AddressList()), restore_now,
+                     kTTL);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(entry_list, restore_now,
+                                                  restore_wall_now));
+  EXPECT_EQ(3U, restored_cache.size());
+
+  base::TimeDelta expires_in;
+  const HostCache::Entry* entry =
+      restored_cache.LookupStale(key1, restore_now, &expires_in);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  EXPECT_FALSE(entry->has_ttl());
+  EXPECT_EQ(base::TimeDelta::FromSeconds(-5), expires_in);
+  ASSERT_EQ(2U, entry->addrlist.size());
+  EXPECT_EQ("1.2.3.4", entry->addrlist[0].ToStringWithoutPort());
+  EXPECT_EQ("5.6.7.8", entry->addrlist[1].ToStringWithoutPort());
+
+  entry = restored_cache.LookupStale(key2, restore_now, &expires_in);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(base::TimeDelta::FromSeconds(5), expires_in);
+  EXPECT_EQ(entry, restored_cache.Lookup(key2, restore_now));
+  ASSERT_EQ(1U, entry->addrlist.size());
+  EXPECT_EQ("::1", entry->addrlist[0].ToStringWithoutPort());
+
+  EXPECT_FALSE(restored_cache.LookupStale(key3, restore_now, &expires_in));
+  EXPECT_TRUE(restored_cache.Lookup(key4, restore_now));
+}
+
+TEST(HostCacheTest, RestoreKeepsExistingEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  base::TimeTicks now;
+  base::Time wall_now = base::Time::FromDoubleT(1000000);
+
+  HostCache old_cache(kMaxCacheEntries);
+  HostCache::Key key = Key("foobar.com");
+  old_cache.Set(key, HostCache::Entry(OK, MakeAddressList("1.2.3.4")), now,
+                kTTL);
+  base::ListValue entry_list;
+  old_cache.GetAsListValue(&entry_list, now, wall_now);
+
+  HostCache cache(kMaxCacheEntries);
+  cache.Set(key, HostCache::Entry(OK, MakeAddressList("5.6.7.8")), now, kTTL);
+  EXPECT_TRUE(cache.RestoreFromListValue(entry_list, now, wall_now));
+  const HostCache::Entry* entry = cache.Lookup(key, now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("5.6.7.8", entry->addrlist[0].ToStringWithoutPort());
+}
+
+TEST(HostCacheTest, RestoreStopsWhenFull) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  base::TimeTicks now;
+  base::Time wall_now = base::Time::FromDoubleT(1000000);
+
+  HostCache big_cache(2 * kMaxCacheEntries);
+  for (int i = 0; i < 2 * kMaxCacheEntries; ++i) {
+    big_cache.Set(Key(base::StringPrintf("host%d.com", i)),
+                  HostCache::Entry(OK, MakeAddressList("1.2.3.4")), now, kTTL);
+  }
+  base::ListValue entry_list;
+  big_cache.GetAsListValue(&entry_list, now, wall_now);
+
+  HostCache cache(kMaxCacheEntries);
+  EXPECT_TRUE(cache.RestoreFromListValue(entry_list, now, wall_now));
+  EXPECT_EQ(static_cast<size_t>(kMaxCacheEntries), cache.size());
+}
+
+TEST(HostCacheTest, RestoreMalformed) {
+  base::TimeTicks now;
+  base::Time wall_now = base::Time::FromDoubleT(1000000);
+  HostCache cache(kMaxCacheEntries);
+
+  base::ListValue not_a_dictionary;
+  not_a_dictionary.AppendString("foobar.com");
+  EXPECT_FALSE(cache.RestoreFromListValue(not_a_dictionary, now, wall_now));
+
+  base::ListValue bad_address;
+  base::DictionaryValue* entry_dict = new base::DictionaryValue();
+  entry_dict->SetString("hostname", "foobar.com");
+  entry_dict->SetInteger("address_family", ADDRESS_FAMILY_UNSPECIFIED);
+  entry_dict->SetInteger("flags", 0);
+  entry_dict->SetString("expiration", "0");
+  base::ListValue* addresses = new base::ListValue();
+  addresses->AppendString("not an address");
+  entry_dict->Set("addresses", addresses);
+  bad_address.Append(entry_dict);
+  EXPECT_FALSE(cache.RestoreFromListValue(bad_address, now, wall_now));
+
+  EXPECT_EQ(0U, cache.size());
+}
+
 }  // namespace net
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "net/base/address_family.h"
 #include "net/base/completion_callback.h"
 #include "net/base/host_port_pair.h"
@@ -45,12 +46,16 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |max_cache_staleness| and |cache_prefetch_window| are passed to
+  // HostResolverImpl::SetMaxCacheStaleness() and SetCachePrefetchWindow().
   struct NET_EXPORT Options {
     Options();
 
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    base::TimeDelta max_cache_staleness;
+    base::TimeDelta cache_prefetch_window;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are
@@ -25,6 +25,7 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/worker_pool.h"
@@ -254,6 +255,27 @@ bool ConfigureAsyncDnsNoFallbackFieldTrial() {
   return kDefault;
 }
 
+// Returns the DnsConfig::num_parallel_servers to use.
+int ConfigureAsyncDnsParallelServersFieldTrial() {
+  const int kDefault = 1;
+  const int kMaxParallelServers = 4;
+
+  // Configure the AsyncDnsParallelServers field trial as follows:
+  // groups Parallel1 to Parallel4: return the number in the group name,
+  // otherwise (trial absent or other group): return default.
+  std::string group_name =
+      base::FieldTrialList::FindFullName("AsyncDnsParallelServers");
+  const char kGroupPrefix[] = "Parallel";
+  int num_servers;
+  if (StartsWithASCII(group_name, kGroupPrefix, true) &&
+      base::StringToInt(group_name.substr(arraysize(kGroupPrefix) - 1),
+                        &num_servers) &&
+      num_servers >= 1 && num_servers <= kMaxParallelServers) {
+    return num_servers;
+  }
+  return kDefault;
+}
+
 //-----------------------------------------------------------------------------
 
 AddressList EnsurePortOnAddressList(const AddressList& list, uint16 port) {
@@ -1205,6 +1227,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         priority_tracker_(priority),
         had_non_speculative_request_(false),
         had_dns_config_(false),
+        is_refresh_(false),
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
         creation_time_(base::TimeTicks::Now()),
@@ -1299,6 +1322,13 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     UpdatePriority();
   }
 
+  // Marks this Job as refreshing a cache entry in the background. It keeps
+  // running when it has no active Request, and then only caches successful
+  // results, so that a failed refresh does not replace a usable stale entry.
+  void MarkAsRefresh() {
+    is_refresh_ = true;
+  }
+
   // Marks |req| as cancelled. If it was the last active Request, also finishes
   // this Job, marking it as cancelled, and deletes it.
   void CancelRequest(Request* req) {
@@ -1316,7 +1346,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                                  req->request_net_log().source(),
                                  priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || is_refresh_) {
       UpdatePriority();
     } else {
       // If we were called from a Request's callback within CompleteRequests,
@@ -1358,7 +1388,10 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Attempts to serve the job from HOSTS. Returns true if succeeded and
   // this Job was destroyed.
   bool ServeFromHosts() {
-    DCHECK_GT(num_active_requests(), 0u);
+    DCHECK(is_refresh_ || num_active_requests() > 0);
+    // A refresh Job that no Request ever joined has no RequestInfo to use.
+    if (requests_.empty())
+      return false;
     AddressList addr_list;
     if (resolver_->ServeFromHosts(key(),
                                   requests_.front()->info(),
@@ -1666,6 +1699,13 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     }
 
     if (num_active_requests() == 0) {
+      if (is_refresh_) {
+        if (entry.error == OK)
+          resolver_->CacheResult(key_, entry, ttl);
+        net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
+                                          entry.error);
+        return;
+      }
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1750,6 +1790,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Distinguishes measurements taken while DnsClient was fully configured.
   bool had_dns_config_;
 
+  // True if this Job was started to refresh the cache. See MarkAsRefresh().
+  bool is_refresh_;
+
   // Number of slots occupied by this Job in resolver's PrioritizedDispatcher.
   unsigned num_occupied_job_slots_;
 
@@ -1806,7 +1849,8 @@ HostResolverImpl::HostResolverImpl(
       use_local_ipv6_(false),
       resolved_known_ipv6_hostname_(false),
       additional_resolver_flags_(0),
-      fallback_to_proctask_(true) {
+      fallback_to_proctask_(true),
+      num_parallel_dns_servers_(1) {
 
   DCHECK_GE(dispatcher_.num_priorities(), static_cast<size_t>(NUM_PRIORITIES));
 
@@ -1838,6 +1882,7 @@ HostResolverImpl::HostResolverImpl(
   }
 
   fallback_to_proctask_ = !ConfigureAsyncDnsNoFallbackFieldTrial();
+  num_parallel_dns_servers_ = ConfigureAsyncDnsParallelServersFieldTrial();
 }
 
 HostResolverImpl::~HostResolverImpl() {
@@ -1857,6 +1902,16 @@ void HostResolverImpl::SetMaxQueuedJobs(size_t value) {
   max_queued_jobs_ = value;
 }
 
+void HostResolverImpl::SetMaxCacheStaleness(base::TimeDelta max_staleness) {
+  DCHECK(max_staleness >= base::TimeDelta());
+  max_cache_staleness_ = max_staleness;
+}
+
+void HostResolverImpl::SetCachePrefetchWindow(base::TimeDelta window) {
+  DCHECK(window >= base::TimeDelta());
+  cache_prefetch_window_ = window;
+}
+
 int HostResolverImpl::Resolve(const RequestInfo& info,
                               RequestPriority priority,
                               AddressList* addresses,
@@ -1939,8 +1994,11 @@ int HostResolverImpl::ResolveHelper(const Key& key,
   int net_error = ERR_UNEXPECTED;
   if (ResolveAsIP(key, info, &net_error, addresses))
     return net_error;
-  if (ServeFromCache(key, info, &net_error, addresses)) {
+  bool needs_refresh = false;
+  if (ServeFromCache(key, info, &net_error, addresses, &needs_refresh)) {
     request_net_log.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_CACHE_HIT);
+    if (needs_refresh)
+      StartRefreshJob(key, request_net_log);
     return net_error;
   }
   // TODO(szym): Do not do this if nsswitch.conf instructs not to.
@@ -2050,14 +2108,32 @@ bool HostResolverImpl::ResolveAsIP(const Key& key,
 bool HostResolverImpl::ServeFromCache(const Key& key,
                                       const RequestInfo& info,
                                       int* net_error,
-                                      AddressList* addresses) {
+                                      AddressList* addresses,
+                                      bool* needs_refresh) {
   DCHECK(addresses);
   DCHECK(net_error);
+  DCHECK(needs_refresh);
   if (!info.allow_cached_response() || !cache_.get())
     return false;
 
-  const HostCache::Entry* cache_entry = cache_->Lookup(
-      key, base::TimeTicks::Now());
+  const HostCache::Entry* cache_entry = NULL;
+  if (max_cache_staleness_ == base::TimeDelta() &&
+      cache_prefetch_window_ == base::TimeDelta()) {
+    cache_entry = cache_->Lookup(key, base::TimeTicks::Now());
+  } else {
+    // Expired entries are left in the cache, to be dropped when it compacts.
+    base::TimeDelta expires_in;
+    cache_entry = cache_->LookupStale(key, base::TimeTicks::Now(),
+                                      &expires_in);
+    if (cache_entry && expires_in <= base::TimeDelta()) {
+      if (cache_entry->error != OK || -expires_in >= max_cache_staleness_)
+        return false;
+      *needs_refresh = true;
+    } else if (cache_entry && cache_entry->error == OK &&
+               expires_in <= cache_prefetch_window_) {
+      *needs_refresh = true;
+    }
+  }
   if (!cache_entry)
     return false;
 
@@ -2125,6 +2201,28 @@ void HostResolverImpl::CacheResult(const Key& key,
     cache_->Set(key, entry, base::TimeTicks::Now(), ttl);
 }
 
+void HostResolverImpl::StartRefreshJob(const Key& key,
+                                       const BoundNetLog& request_net_log) {
+  JobMap::iterator jobit = jobs_.find(key);
+  if (jobit != jobs_.end())
+    return;
+
+  Job* job = new Job(weak_ptr_factory_.GetWeakPtr(), key, MINIMUM_PRIORITY,
+                     request_net_log);
+  job->MarkAsRefresh();
+  job->Schedule(false);
+
+  // Check for queue overflow.
+  if (dispatcher_.num_queued_jobs() > max_queued_jobs_) {
+    Job* evicted = static_cast<Job*>(dispatcher_.EvictOldestLowest());
+    DCHECK(evicted);
+    evicted->OnEvicted();  // Deletes |evicted|.
+    if (evicted == job)
+      return;
+  }
+  jobs_.insert(jobit, std::make_pair(key, job));
+}
+
 void HostResolverImpl::RemoveJob(Job* job) {
   DCHECK(job);
   JobMap::iterator it = jobs_.find(job->key());
@@ -2279,6 +2377,7 @@ void HostResolverImpl::OnDNSChanged() {
   // We want a new DnsSession in place, before we Abort running Jobs, so that
   // the newly started jobs use the new config.
   if (dns_client_.get()) {
+    dns_config.num_parallel_servers = num_parallel_dns_servers_;
     dns_client_->SetConfig(dns_config);
     if (dns_client_->GetConfig())
       UMA_HISTOGRAM_BOOLEAN("AsyncDNS.DnsClientEnabled", true);
@@ -2344,6 +2443,7 @@ void HostResolverImpl::SetDnsClient(scoped_ptr<DnsClient> dns_client) {
       num_dns_failures_ < kMaximumDnsFailures) {
     DnsConfig dns_config;
     NetworkChangeNotifier::GetDnsConfig(&dns_config);
+    dns_config.num_parallel_servers = num_parallel_dns_servers_;
     dns_client_->SetConfig(dns_config);
     num_dns_failures_ = 0;
     if (dns_client_->GetConfig())
@@ -123,6 +123,18 @@ class NET_EXPORT HostResolverImpl
   // Only allowed when the queue is empty.
   void SetMaxQueuedJobs(size_t value);
 
+  // Allows successful cache entries that expired less than |max_staleness| ago
+  // to be served, so that a request for a known host completes immediately
+  // instead of waiting for the network. Every time a stale entry is served, a
+  // Job is started in the background to refresh it. Zero, the default,
+  // disables this.
+  void SetMaxCacheStaleness(base::TimeDelta max_staleness);
+
+  // When a request is served from a cache entry that expires within |window|,
+  // a Job is started in the background to refresh the entry, so that hosts in
+  // use keep a valid entry. Zero, the default, disables this.
+  void SetCachePrefetchWindow(base::TimeDelta window);
+
   // Set the DnsClient to be used for resolution. In case of failure, the
   // HostResolverProc from ProcTaskParams will be queried. If the DnsClient is
   // not pre-configured with a valid DnsConfig, a new config is fetched from
@@ -179,11 +191,13 @@ class NET_EXPORT HostResolverImpl
 
   // If |key| is not found in cache returns false, otherwise returns
   // true, sets |net_error| to the cached error code and fills |addresses|
-  // if it is a positive entry.
+  // if it is a positive entry. Sets |needs_refresh| if the entry was stale, or
+  // is about to expire, and should be refreshed in the background.
   bool ServeFromCache(const Key& key,
                       const RequestInfo& info,
                       int* net_error,
-                      AddressList* addresses);
+                      AddressList* addresses,
+                      bool* needs_refresh);
 
   // If we have a DnsClient with a valid DnsConfig, and |key| is found in the
   // HOSTS file, returns true and fills |addresses|. Otherwise returns false.
@@ -205,6 +219,10 @@ class NET_EXPORT HostResolverImpl
                    const HostCache::Entry& entry,
                    base::TimeDelta ttl);
 
+  // Starts a Job without any Request to refresh the cache entry for |key|,
+  // unless one is already running for it.
+  void StartRefreshJob(const Key& key, const BoundNetLog& request_net_log);
+
   // Removes |job| from |jobs_|, only if it exists.
   void RemoveJob(Job* job);
 
@@ -293,6 +311,18 @@ class NET_EXPORT HostResolverImpl
   // Allow fallback to ProcTask if DnsTask fails.
   bool fallback_to_proctask_;
 
+  // The number of nameservers DnsClient queries at once, see
+  // DnsConfig::num_parallel_servers.
+  int num_parallel_dns_servers_;
+
+  // How long after expiration a cache entry can still be served. See
+  // SetMaxCacheStaleness().
+  base::TimeDelta max_cache_staleness_;
+
+  // How long before expiration a cache hit triggers a refresh. See
+  // SetCachePrefetchWindow().
+  base::TimeDelta cache_prefetch_window_;
+
   DISALLOW_COPY_AND_ASSIGN(HostResolverImpl);
 };
 
@@ -11,6 +11,7 @@
 #include "base/bind_helpers.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_vector.h"
+#include "base/metrics/field_trial.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/strings/string_util.h"
@@ -529,6 +530,32 @@ class HostResolverImplTest : public testing::Test {
     return HostResolverImpl::kMaximumDnsFailures;
   }
 
+  // Makes the cache entry for |hostname| expire |expires_in| from now, which
+  // can be negative to make it stale.
+  void SetCacheEntryExpiration(const std::string& hostname,
+                               base::TimeDelta expires_in) {
+    HostCache* cache = resolver_->GetHostCache();
+    for (HostCache::EntryMap::Iterator it(cache->entries()); it.HasNext();
+         it.Advance()) {
+      if (it.key().hostname == hostname) {
+        HostCache::Key key = it.key();
+        HostCache::Entry entry = it.value();
+        cache->Set(key, entry, base::TimeTicks::Now(), expires_in);
+        return;
+      }
+    }
+    ADD_FAILURE() << "No cache entry for " << hostname;
+  }
+
+  // Waits for a refresh Job to complete. Requires a serial resolver, which
+  // runs the Job for an IDLE request only after the ones queued before it.
+  void WaitForRefresh() {
+    Request* req = CreateRequest("refresh.barrier", 80, IDLE);
+    EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+    proc_->SignalMultiple(2u);  // One for the refresh, one for the barrier.
+    req->WaitForResult();
+  }
+
   scoped_refptr<MockHostResolverProc> proc_;
   scoped_ptr<HostResolverImpl> resolver_;
   ScopedVector<Request> requests_;
@@ -1217,6 +1244,117 @@ TEST_F(HostResolverImplTest, ResolveFromCache) {
   EXPECT_TRUE(requests_[2]->HasOneAddress("192.168.1.42", 80));
 }
 
+// Test that an expired entry is served while it is refreshed in the background.
+TEST_F(HostResolverImplTest, ServeStaleCacheEntry) {
+  CreateSerialResolver();
+  resolver_->SetMaxCacheStaleness(base::TimeDelta::FromHours(1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  SetCacheEntryExpiration("just.testing", -base::TimeDelta::FromMinutes(10));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 80));
+
+  // A request that bypasses the cache joins the refresh. Cancelling it does
+  // not stop the refresh.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 80));
+  info.set_allow_cached_response(false);
+  req = CreateRequest(info, DEFAULT_PRIORITY);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  req->Cancel();
+
+  WaitForRefresh();
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 80));
+}
+
+TEST_F(HostResolverImplTest, StaleCacheEntryTooOld) {
+  resolver_->SetMaxCacheStaleness(base::TimeDelta::FromMinutes(1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(2u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  SetCacheEntryExpiration("just.testing", -base::TimeDelta::FromMinutes(10));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 80));
+}
+
+// Test that a failed refresh does not replace the stale entry.
+TEST_F(HostResolverImplTest, FailedRefreshKeepsStaleEntry) {
+  CreateSerialResolver();
+  resolver_->SetMaxCacheStaleness(base::TimeDelta::FromHours(1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  SetCacheEntryExpiration("just.testing", -base::TimeDelta::FromMinutes(10));
+  proc_->AddRuleForAllFamilies("just.testing", std::string());
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  WaitForRefresh();
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 80));
+  WaitForRefresh();
+}
+
+// Test that entries in use are refreshed shortly before they expire.
+TEST_F(HostResolverImplTest, PrefetchCacheEntry) {
+  CreateSerialResolver();
+  resolver_->SetCachePrefetchWindow(base::TimeDelta::FromSeconds(10));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  // Far from expiring; no refresh.
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  SetCacheEntryExpiration("just.testing", base::TimeDelta::FromSeconds(5));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 80));
+  WaitForRefresh();
+
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 80));
+
+  // Without stale serving, expired entries are not used.
+  SetCacheEntryExpiration("just.testing", -base::TimeDelta::FromSeconds(1));
+  proc_->SignalMultiple(1u);
+  req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+}
+
 // Test the retry attempts simulating host resolver proc that takes too long.
 TEST_F(HostResolverImplTest, MultipleAttempts) {
   // Total number of attempts would be 3 and we want the 3rd attempt to resolve
@@ -1386,6 +1524,26 @@ TEST_F(HostResolverImplDnsTest, DnsTask) {
   EXPECT_TRUE(requests_[3]->HasOneAddress("192.168.1.102", 80));
 }
 
+// The AsyncDnsParallelServers field trial sets the number of servers DnsClient
+// queries at once.
+TEST_F(HostResolverImplDnsTest, ParallelServersFieldTrial) {
+  ChangeDnsConfig(CreateValidDnsConfig());
+  ASSERT_TRUE(dns_client_->GetConfig());
+  EXPECT_EQ(1, dns_client_->GetConfig()->num_parallel_servers);
+
+  base::FieldTrialList field_trial_list(NULL);
+  base::FieldTrialList::CreateFieldTrial("AsyncDnsParallelServers",
+                                         "Parallel2");
+  CreateResolver();
+  ASSERT_TRUE(dns_client_->GetConfig());
+  EXPECT_EQ(2, dns_client_->GetConfig()->num_parallel_servers);
+
+  // It is kept when the DNS configuration changes.
+  ChangeDnsConfig(CreateValidDnsConfig());
+  ASSERT_TRUE(dns_client_->GetConfig());
+  EXPECT_EQ(2, dns_client_->GetConfig()->num_parallel_servers);
+}
+
 // Test successful and failing resolutions in HostResolverImpl::DnsTask when
 // fallback to ProcTask is disabled.
 TEST_F(HostResolverImplDnsTest, NoFallbackToProcTask) {
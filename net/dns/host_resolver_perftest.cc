@@ -0,0 +1,98 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_vector.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/base/address_list.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_resolver_impl.h"
+#include "net/dns/mock_host_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Number of hosts looked up right after startup, e.g. for the tabs that are
+// restored and their subresources.
+const int kNumHosts = 100;
+
+// Latency of every lookup that goes to the network.
+const int kLookupLatencyMs = 20;
+
+const size_t kMaxJobs = 8u;
+
+scoped_ptr<HostResolverImpl> CreateResolver(scoped_ptr<HostCache> cache,
+                                            HostResolverProc* proc) {
+  HostResolverImpl::ProcTaskParams params(proc, 0u);
+  return make_scoped_ptr(new HostResolverImpl(
+      cache.Pass(), PrioritizedDispatcher::Limits(NUM_PRIORITIES, kMaxJobs),
+      params, NULL));
+}
+
+// Resolves all the hosts at once, and waits for all of them.
+void ResolveAllHosts(HostResolver* resolver) {
+  ScopedVector<TestCompletionCallback> callbacks;
+  ScopedVector<AddressList> addresses;
+  std::vector<int> results;
+  for (int i = 0; i < kNumHosts; ++i) {
+    HostResolver::RequestInfo info(
+        HostPortPair(base::StringPrintf("host%d.example.com", i), 80));
+    callbacks.push_back(new TestCompletionCallback());
+    addresses.push_back(new AddressList());
+    results.push_back(resolver->Resolve(info, DEFAULT_PRIORITY, addresses[i],
+                                        callbacks[i]->callback(), NULL,
+                                        BoundNetLog()));
+  }
+  for (int i = 0; i < kNumHosts; ++i)
+    EXPECT_EQ(OK, callbacks[i]->GetResult(results[i]));
+}
+
+}  // namespace
+
+// Compares the time taken by the first lookups of a session, with an empty
+// cache and with the cache saved by the previous session.
+TEST(HostResolverPerfTest, ColdStart) {
+  scoped_refptr<RuleBasedHostResolverProc> proc(
+      new RuleBasedHostResolverProc(NULL));
+  proc->AddRuleWithLatency("*", "127.0.0.1", kLookupLatencyMs);
+
+  // The previous session.
+  scoped_ptr<HostResolverImpl> resolver =
+      CreateResolver(HostCache::CreateDefaultCache(), proc.get());
+  {
+    base::PerfTimeLogger timer("HostResolver_ColdStart_empty_cache");
+    ResolveAllHosts(resolver.get());
+    timer.Done();
+  }
+  base::ListValue saved_entries;
+  resolver->GetHostCache()->GetAsListValue(&saved_entries,
+                                           base::TimeTicks::Now(),
+                                           base::Time::Now());
+  resolver.reset();
+
+  // The next session starts an hour later, when all the entries are expired.
+  scoped_ptr<HostCache> cache = HostCache::CreateDefaultCache();
+  ASSERT_TRUE(cache->RestoreFromListValue(
+      saved_entries, base::TimeTicks::Now(),
+      base::Time::Now() + base::TimeDelta::FromHours(1)));
+  resolver = CreateResolver(cache.Pass(), proc.get());
+  resolver->SetMaxCacheStaleness(base::TimeDelta::FromDays(1));
+  {
+    base::PerfTimeLogger timer("HostResolver_ColdStart_restored_cache");
+    ResolveAllHosts(resolver.get());
+    timer.Done();
+  }
+}
+
+}  // namespace net
@@ -30,6 +30,7 @@
 #include "net/base/cache_type.h"
 #include "net/base/io_buffer.h"
 #include "net/base/load_flags.h"
+#include "net/base/net_log.h"
 #include "net/base/net_errors.h"
 #include "net/base/upload_data_stream.h"
 #include "net/disk_cache/disk_cache.h"
@@ -43,6 +44,10 @@
 
 namespace {
 
+// Size of the buffer used to drain the response body of background
+// revalidations.
+const int kAsyncValidationBufSize = 32 * 1024;
+
 // Adaptor to delete a file on a worker thread.
 void DeletePath(base::FilePath path) {
   base::DeleteFile(path, false);
@@ -267,12 +272,108 @@ void HttpCache::MetadataWriter::OnIOComplete(int result) {
 
 //-----------------------------------------------------------------------------
 
+// This class encapsulates a transaction whose only purpose is to revalidate a
+// stale entry that was served to the caller under "stale-while-revalidate".
+// The response body is read and discarded so that the entry gets updated (on a
+// 304) or replaced (on a 200) by the regular HttpCache::Transaction logic.
+class HttpCache::AsyncValidation {
+ public:
+  AsyncValidation(const HttpRequestInfo& original_request, HttpCache* cache)
+      : request_(original_request),
+        cache_(cache) {
+  }
+  ~AsyncValidation() {}
+
+  // Starts the revalidation.  |this| may be deleted before this method
+  // returns.
+  void Start();
+
+  const std::string& key() const { return key_; }
+  void set_key(const std::string& key) { key_ = key; }
+
+ private:
+  void OnStarted(int result);
+  void DoRead();
+  void OnRead(int result);
+
+  // Terminates the validation and deletes |this|.
+  void Terminate(int result);
+
+  HttpRequestInfo request_;
+  std::string key_;
+  scoped_refptr<IOBuffer> buf_;
+  CompletionCallback read_callback_;
+  scoped_ptr<Transaction> transaction_;
+
+  // The cache owns |this|.
+  HttpCache* cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncValidation);
+};
+
+void HttpCache::AsyncValidation::Start() {
+  transaction_.reset(new Transaction(IDLE, cache_, NULL));
+
+  // The request is forced to go to the network, so that this transaction will
+  // not itself be answered from the stale entry.
+  request_.load_flags |= LOAD_VALIDATE_CACHE;
+  request_.load_flags &= ~(LOAD_PREFERRING_CACHE | LOAD_ONLY_FROM_CACHE |
+                           LOAD_FROM_CACHE_IF_OFFLINE);
+
+  read_callback_ = base::Bind(&AsyncValidation::OnRead, base::Unretained(this));
+  int rv = transaction_->Start(
+      &request_,
+      base::Bind(&AsyncValidation::OnStarted, base::Unretained(this)),
+      BoundNetLog());
+  if (rv == ERR_IO_PENDING)
+    return;
+
+  OnStarted(rv);
+}
+
+void HttpCache::AsyncValidation::OnStarted(int result) {
+  if (result != OK)
+    return Terminate(result);
+
+  buf_ = new IOBuffer(kAsyncValidationBufSize);
+  DoRead();
+}
+
+void HttpCache::AsyncValidation::DoRead() {
+  int rv = OK;
+  do {
+    rv = transaction_->Read(buf_.get(), kAsyncValidationBufSize,
+                            read_callback_);
+    if (rv == ERR_IO_PENDING)
+      return;
+  } while (rv > 0);
+
+  Terminate(rv);
+}
+
+void HttpCache::AsyncValidation::OnRead(int result) {
+  if (result > 0)
+    return DoRead();
+  Terminate(result);
+}
+
+void HttpCache::AsyncValidation::Terminate(int result) {
+  DVLOG_IF(1, result < 0) << "Asynchronous validation of " << request_.url
+                          << " failed: " << result;
+  cache_->OnAsyncValidationComplete(this);
+  // |this| is deleted.
+}
+
+//-----------------------------------------------------------------------------
+
 HttpCache::HttpCache(const net::HttpNetworkSession::Params& params,
                      BackendFactory* backend_factory)
     : net_log_(params.net_log),
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      use_stale_while_revalidate_(true),
+      compress_stored_bodies_(false),
       network_layer_(new HttpNetworkLayer(new HttpNetworkSession(params))) {
 }
 
@@ -283,6 +384,8 @@ HttpCache::HttpCache(HttpNetworkSession* session,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      use_stale_while_revalidate_(true),
+      compress_stored_bodies_(false),
       network_layer_(new HttpNetworkLayer(session)) {
 }
 
@@ -293,10 +396,16 @@ HttpCache::HttpCache(HttpTransactionFactory* network_layer,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      use_stale_while_revalidate_(true),
+      compress_stored_bodies_(false),
       network_layer_(network_layer) {
 }
 
 HttpCache::~HttpCache() {
+  // Background revalidations own transactions that may be attached to active
+  // entries, so they have to go away first.
+  STLDeleteValues(&async_validations_);
+
   // If we have any active entries remaining, then we need to deactivate them.
   // We may have some pending calls to OnProcessPendingQueue, but since those
   // won't run (due to our destruction), we can simply ignore the corresponding
@@ -981,6 +1090,30 @@ void HttpCache::ProcessPendingQueue(ActiveEntry* entry) {
       base::Bind(&HttpCache::OnProcessPendingQueue, AsWeakPtr(), entry));
 }
 
+void HttpCache::PerformAsyncValidation(const HttpRequestInfo& original_request,
+                                       const BoundNetLog& net_log) {
+  DCHECK_EQ(0, original_request.load_flags & LOAD_VALIDATE_CACHE);
+  std::string key = GenerateCacheKey(&original_request);
+  if (ContainsKey(async_validations_, key))
+    return;  // Already revalidating this entry.
+
+  net_log.AddEvent(NetLog::TYPE_HTTP_CACHE_ASYNC_VALIDATION);
+
+  AsyncValidation* validation = new AsyncValidation(original_request, this);
+  validation->set_key(key);
+  async_validations_[key] = validation;
+  validation->Start();
+  // |validation| may have been deleted.
+}
+
+void HttpCache::OnAsyncValidationComplete(AsyncValidation* validation) {
+  AsyncValidationMap::iterator it = async_validations_.find(validation->key());
+  DCHECK(it != async_validations_.end());
+  DCHECK_EQ(validation, it->second);
+  async_validations_.erase(it);
+  delete validation;
+}
+
 void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
   entry->will_process_pending_queue = false;
   DCHECK(!entry->writer);
@@ -43,6 +43,7 @@ class Entry;
 
 namespace net {
 
+class BoundNetLog;
 class CertVerifier;
 class HostResolver;
 class HttpAuthHandlerFactory;
@@ -174,6 +175,24 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   void set_mode(Mode value) { mode_ = value; }
   Mode mode() { return mode_; }
 
+  // Enables or disables serving stale entries while they are revalidated in
+  // the background, as allowed by the "stale-while-revalidate" Cache-Control
+  // extension.  Enabled by default.
+  void set_use_stale_while_revalidate(bool value) {
+    use_stale_while_revalidate_ = value;
+  }
+  bool use_stale_while_revalidate() const {
+    return use_stale_while_revalidate_;
+  }
+
+  // Enables or disables storing textual response bodies compressed on disk.
+  // Disabled by default. Entries stored compressed remain readable when this
+  // is turned off.
+  void set_compress_stored_bodies(bool value) {
+    compress_stored_bodies_ = value;
+  }
+  bool compress_stored_bodies() const { return compress_stored_bodies_; }
+
   // Close currently active sockets so that fresh page loads will not use any
   // recycled connections.  For sockets currently in use, they may not close
   // immediately, but they will not be reusable. This is for debugging.
@@ -211,6 +230,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
  private:
   // Types --------------------------------------------------------------------
 
+  class AsyncValidation;
   class MetadataWriter;
   class Transaction;
   class WorkItem;
@@ -236,6 +256,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   typedef base::hash_map<std::string, PendingOp*> PendingOpsMap;
   typedef std::set<ActiveEntry*> ActiveEntriesSet;
   typedef base::hash_map<std::string, int> PlaybackCacheMap;
+  typedef base::hash_map<std::string, AsyncValidation*> AsyncValidationMap;
 
   // Methods ------------------------------------------------------------------
 
@@ -350,6 +371,16 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // Resumes processing the pending list of |entry|.
   void ProcessPendingQueue(ActiveEntry* entry);
 
+  // Starts a background revalidation of the entry that would be used for
+  // |original_request|, unless one is already in progress for the same key.
+  // |net_log| is the log of the transaction that is serving the stale entry.
+  void PerformAsyncValidation(const HttpRequestInfo& original_request,
+                              const BoundNetLog& net_log);
+
+  // Called by |validation| when it has finished, to remove it from
+  // |async_validations_| and delete it.
+  void OnAsyncValidationComplete(AsyncValidation* validation);
+
   // Events (called via PostTask) ---------------------------------------------
 
   void OnProcessPendingQueue(ActiveEntry* entry);
@@ -381,6 +412,8 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   bool building_backend_;
 
   Mode mode_;
+  bool use_stale_while_revalidate_;
+  bool compress_stored_bodies_;
 
   const scoped_ptr<HttpTransactionFactory> network_layer_;
   scoped_ptr<disk_cache::Backend> disk_cache_;
@@ -396,6 +429,9 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
 
   scoped_ptr<PlaybackCacheMap> playback_cache_map_;
 
+  // The background revalidations in progress, indexed by cache key.
+  AsyncValidationMap async_validations_;
+
   DISALLOW_COPY_AND_ASSIGN(HttpCache);
 };
 
@@ -0,0 +1,221 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_cache_compression.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "net/http/http_response_headers.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+// MIME types, besides text/*, that are worth compressing.
+const char* const kCompressibleMimeTypes[] = {
+  "application/javascript",
+  "application/json",
+  "application/x-javascript",
+  "application/xhtml+xml",
+  "application/xml",
+  "image/svg+xml",
+};
+
+void WriteUInt32(uint32 value, std::string* output) {
+  for (int i = 0; i < 4; ++i) {
+    output->push_back(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+uint32 ReadUInt32(const char* data) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  return static_cast<uint32>(bytes[0]) |
+         static_cast<uint32>(bytes[1]) << 8 |
+         static_cast<uint32>(bytes[2]) << 16 |
+         static_cast<uint32>(bytes[3]) << 24;
+}
+
+}  // namespace
+
+// static
+const int HttpCacheCompressor::kChunkSize = 32 * 1024;
+
+// static
+const int HttpCacheCompressor::kFrameHeaderSize = 8;
+
+HttpCacheCompressor::HttpCacheCompressor() : bytes_in_(0), bytes_out_(0) {
+  pending_.reserve(kChunkSize);
+}
+
+HttpCacheCompressor::~HttpCacheCompressor() {}
+
+// static
+bool HttpCacheCompressor::ShouldCompress(const HttpResponseHeaders& headers) {
+  std::string encoding;
+  if (headers.GetNormalizedHeader("content-encoding", &encoding) &&
+      !LowerCaseEqualsASCII(encoding, "identity")) {
+    return false;
+  }
+
+  std::string mime_type;
+  if (!headers.GetMimeType(&mime_type))
+    return false;
+
+  if (StartsWithASCII(mime_type, "text/", false))
+    return true;
+
+  for (size_t i = 0; i < arraysize(kCompressibleMimeTypes); ++i) {
+    if (LowerCaseEqualsASCII(mime_type, kCompressibleMimeTypes[i]))
+      return true;
+  }
+  return false;
+}
+
+bool HttpCacheCompressor::Append(const char* data, int data_len,
+                                 std::string* output) {
+  DCHECK_GE(data_len, 0);
+  bytes_in_ += data_len;
+  while (data_len > 0) {
+    int bytes = std::min(data_len,
+                         kChunkSize - static_cast<int>(pending_.size()));
+    pending_.append(data, bytes);
+    data += bytes;
+    data_len -= bytes;
+    if (static_cast<int>(pending_.size()) == kChunkSize &&
+        !FlushChunk(output)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HttpCacheCompressor::Finish(std::string* output) {
+  if (pending_.empty())
+    return true;
+  return FlushChunk(output);
+}
+
+bool HttpCacheCompressor::FlushChunk(std::string* output) {
+  DCHECK(!pending_.empty());
+  uLong raw_size = pending_.size();
+  uLongf stored_size = compressBound(raw_size);
+
+  size_t header_offset = output->size();
+  output->resize(header_offset + kFrameHeaderSize + stored_size);
+  Bytef* dest =
+      reinterpret_cast<Bytef*>(&(*output)[header_offset + kFrameHeaderSize]);
+
+  // Favor speed: this runs on the IO thread for every byte that is cached.
+  int rv = compress2(dest, &stored_size,
+                     reinterpret_cast<const Bytef*>(pending_.data()), raw_size,
+                     Z_BEST_SPEED);
+  if (rv != Z_OK) {
+    output->resize(header_offset);
+    return false;
+  }
+
+  if (stored_size >= raw_size) {
+    // Not worth it; keep the raw bytes.
+    stored_size = raw_size;
+    memcpy(dest, pending_.data(), raw_size);
+  }
+  output->resize(header_offset + kFrameHeaderSize + stored_size);
+
+  std::string header;
+  WriteUInt32(static_cast<uint32>(stored_size), &header);
+  WriteUInt32(static_cast<uint32>(raw_size), &header);
+  output->replace(header_offset, kFrameHeaderSize, header);
+
+  bytes_out_ += kFrameHeaderSize + stored_size;
+  pending_.clear();
+  return true;
+}
+
+HttpCacheDecompressor::HttpCacheDecompressor()
+    : output_offset_(0),
+      bytes_in_(0),
+      failed_(false) {
+}
+
+HttpCacheDecompressor::~HttpCacheDecompressor() {}
+
+bool HttpCacheDecompressor::Append(const char* data, int data_len) {
+  DCHECK_GE(data_len, 0);
+  if (failed_)
+    return false;
+
+  bytes_in_ += data_len;
+  input_.append(data, data_len);
+  return DecodeNextFrame();
+}
+
+int HttpCacheDecompressor::Read(char* buf, int buf_len) {
+  int bytes = std::min(buf_len,
+                       static_cast<int>(output_.size() - output_offset_));
+  if (bytes <= 0)
+    return 0;
+
+  memcpy(buf, output_.data() + output_offset_, bytes);
+  output_offset_ += bytes;
+
+  // Errors are reported by the next call to Append(), or by the caller noticing
+  // that the stream did not end at a frame boundary.
+  if (!HasOutput() && !DecodeNextFrame())
+    failed_ = true;
+  return bytes;
+}
+
+bool HttpCacheDecompressor::IsAtFrameBoundary() const {
+  return !failed_ && input_.empty();
+}
+
+bool HttpCacheDecompressor::DecodeNextFrame() {
+  const size_t kHeaderSize = HttpCacheCompressor::kFrameHeaderSize;
+  const uint32 kMaxRawSize = HttpCacheCompressor::kChunkSize;
+
+  if (HasOutput())
+    return true;
+  output_.clear();
+  output_offset_ = 0;
+
+  if (input_.size() < kHeaderSize)
+    return true;
+
+  uint32 stored_size = ReadUInt32(input_.data());
+  uint32 raw_size = ReadUInt32(input_.data() + 4);
+  if (!raw_size || raw_size > kMaxRawSize ||
+      stored_size > compressBound(raw_size)) {
+    failed_ = true;
+    return false;
+  }
+
+  size_t frame_size = kHeaderSize + stored_size;
+  if (input_.size() < frame_size)
+    return true;
+
+  const char* stored_data = input_.data() + kHeaderSize;
+  if (stored_size == raw_size) {
+    output_.assign(stored_data, raw_size);
+  } else {
+    output_.resize(raw_size);
+    uLongf decoded_size = raw_size;
+    int rv = uncompress(reinterpret_cast<Bytef*>(&output_[0]), &decoded_size,
+                        reinterpret_cast<const Bytef*>(stored_data),
+                        stored_size);
+    if (rv != Z_OK || decoded_size != raw_size) {
+      output_.clear();
+      failed_ = true;
+      return false;
+    }
+  }
+
+  input_.erase(0, frame_size);
+  return true;
+}
+
+}  // namespace net
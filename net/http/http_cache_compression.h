@@ -0,0 +1,115 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_HTTP_HTTP_CACHE_COMPRESSION_H_
+#define NET_HTTP_HTTP_CACHE_COMPRESSION_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+class HttpResponseHeaders;
+
+// These classes implement the format used by HttpCache::Transaction to store
+// response bodies compressed on disk.
+//
+// The body is split into chunks of at most kChunkSize bytes, and each chunk is
+// stored as a separate frame:
+//
+//   uint32 stored_size   (little endian)
+//   uint32 raw_size      (little endian)
+//   stored_size bytes    (zlib data, or the raw bytes if stored_size equals
+//                         raw_size)
+//
+// Chunks that do not shrink are stored as is. There is no index of the frames,
+// so the body can only be decoded from the start: HttpCache::Transaction sends
+// range requests for a compressed entry to the server instead of serving them
+// from the stored body.
+class NET_EXPORT_PRIVATE HttpCacheCompressor {
+ public:
+  // The maximum number of uncompressed bytes stored in a single frame.
+  static const int kChunkSize;
+
+  // The size of the header that precedes the data of each frame.
+  static const int kFrameHeaderSize;
+
+  HttpCacheCompressor();
+  ~HttpCacheCompressor();
+
+  // Returns true if a response with the given |headers| is worth storing
+  // compressed: it has to carry a textual MIME type, and the body must not
+  // already be encoded by the server.
+  static bool ShouldCompress(const HttpResponseHeaders& headers);
+
+  // Consumes |data_len| bytes of body from |data|. Any frame completed by this
+  // data is appended to |output|. Returns false on failure.
+  bool Append(const char* data, int data_len, std::string* output);
+
+  // Appends the last (possibly partial) chunk to |output|. Returns false on
+  // failure.
+  bool Finish(std::string* output);
+
+  // Total number of body bytes consumed so far.
+  int64 bytes_in() const { return bytes_in_; }
+
+  // Total number of bytes emitted so far, including frame headers.
+  int64 bytes_out() const { return bytes_out_; }
+
+ private:
+  // Encodes |pending_| as a frame at the end of |output|.
+  bool FlushChunk(std::string* output);
+
+  std::string pending_;
+  int64 bytes_in_;
+  int64 bytes_out_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpCacheCompressor);
+};
+
+// Decodes a stream of frames produced by HttpCacheCompressor. Frames are
+// decoded one at a time, as the caller consumes the output, so that memory
+// usage is bounded by the size of a chunk plus the input that is buffered.
+class NET_EXPORT_PRIVATE HttpCacheDecompressor {
+ public:
+  HttpCacheDecompressor();
+  ~HttpCacheDecompressor();
+
+  // Feeds |data_len| bytes of stored data. Returns false if the data is
+  // corrupt, in which case the object should not be used anymore.
+  bool Append(const char* data, int data_len);
+
+  // Copies up to |buf_len| decoded bytes to |buf|. Returns the number of bytes
+  // copied, or zero if no decoded data is available yet.
+  int Read(char* buf, int buf_len);
+
+  // Returns true if decoded data is available for Read().
+  bool HasOutput() const { return output_offset_ < output_.size(); }
+
+  // Returns true if there is no partial frame waiting for more input. A
+  // stream that ends while this is false is truncated.
+  bool IsAtFrameBoundary() const;
+
+  // Total number of stored bytes fed to this object.
+  int64 bytes_in() const { return bytes_in_; }
+
+ private:
+  // Decodes the next frame if all of it is available and the previous output
+  // was consumed. Returns false if the frame is corrupt.
+  bool DecodeNextFrame();
+
+  std::string input_;
+  std::string output_;
+  size_t output_offset_;
+  int64 bytes_in_;
+  bool failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpCacheDecompressor);
+};
+
+}  // namespace net
+
+#endif  // NET_HTTP_HTTP_CACHE_COMPRESSION_H_
@@ -0,0 +1,290 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "net/base/cache_type.h"
+#include "net/base/io_buffer.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache.h"
+#include "net/http/http_cache_compression.h"
+#include "net/http/http_transaction.h"
+#include "net/http/http_transaction_unittest.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumIterations = 200;
+const int kNumCacheEntries = 100;
+
+// Builds a body that resembles a typical HTML, CSS or JSON resource.
+std::string MakeHtmlBody() {
+  std::string body("<!DOCTYPE html><html><head><title>Test</title></head>"
+                   "<body>\n");
+  for (int i = 0; body.size() < 120 * 1024; ++i) {
+    base::StringAppendF(
+        &body,
+        "<div class=\"result\" id=\"r%d\"><a href=\"http://www.example.com/"
+        "search?q=item%d\">Result number %d</a><span>Some text %d</span>"
+        "</div>\n", i, i * 7, i, i % 13);
+  }
+  body.append("</body></html>\n");
+  return body;
+}
+
+std::string MakeCssBody() {
+  std::string body;
+  for (int i = 0; body.size() < 60 * 1024; ++i) {
+    base::StringAppendF(
+        &body,
+        ".rule-%d { margin: %dpx 0 %dpx; color: #%06x; font: 13px arial; }\n",
+        i, i % 17, i % 5, i * 2654435);
+  }
+  return body;
+}
+
+std::string MakeJsonBody() {
+  std::string body("{\"items\":[");
+  for (int i = 0; body.size() < 200 * 1024; ++i) {
+    base::StringAppendF(
+        &body,
+        "{\"id\":%d,\"name\":\"item %d\",\"price\":%d.%02d,\"tags\":"
+        "[\"a\",\"b\"]},", i, i, i % 100, i % 97);
+  }
+  body.append("{}]}");
+  return body;
+}
+
+std::string Compress(const std::string& body) {
+  HttpCacheCompressor compressor;
+  std::string stored;
+  const int kReadSize = 16 * 1024;  // Like the network reads.
+  for (size_t i = 0; i < body.size(); i += kReadSize) {
+    int len = std::min(kReadSize, static_cast<int>(body.size() - i));
+    EXPECT_TRUE(compressor.Append(body.data() + i, len, &stored));
+  }
+  EXPECT_TRUE(compressor.Finish(&stored));
+  return stored;
+}
+
+void RunTest(const char* name, const std::string& body) {
+  std::string stored = Compress(body);
+  base::LogPerfResult(
+      base::StringPrintf("HttpCacheCompression_%s_raw_size", name).c_str(),
+      body.size(), "bytes");
+  base::LogPerfResult(
+      base::StringPrintf("HttpCacheCompression_%s_stored_size", name).c_str(),
+      stored.size(), "bytes");
+
+  base::PerfTimeLogger encode_timer(
+      base::StringPrintf("HttpCacheCompression_%s_encode", name).c_str());
+  for (int i = 0; i < kNumIterations; ++i)
+    Compress(body);
+  encode_timer.Done();
+
+  base::PerfTimeLogger decode_timer(
+      base::StringPrintf("HttpCacheCompression_%s_decode", name).c_str());
+  const int kBufSize = 32 * 1024;  // Like URLRequest reads.
+  char buf[kBufSize];
+  for (int i = 0; i < kNumIterations; ++i) {
+    HttpCacheDecompressor decompressor;
+    size_t total = 0;
+    for (size_t offset = 0; offset < stored.size(); offset += kBufSize) {
+      int len = std::min(kBufSize, static_cast<int>(stored.size() - offset));
+      ASSERT_TRUE(decompressor.Append(stored.data() + offset, len));
+      while (decompressor.HasOutput())
+        total += decompressor.Read(buf, kBufSize);
+    }
+    ASSERT_EQ(body.size(), total);
+  }
+  decode_timer.Done();
+}
+
+// Stores kNumCacheEntries responses in a disk cache through HttpCache, then
+// reads them back from a freshly opened cache, to see what compression costs
+// on the real read and write paths.
+class HttpCacheCompressionDiskPerfTest : public testing::Test {
+ protected:
+  HttpCacheCompressionDiskPerfTest() : cache_thread_("CacheThread") {}
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(cache_thread_.StartWithOptions(
+        base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
+  }
+
+  void RunTest(const char* name, const char* mime_type,
+               const std::string& body, bool compress) {
+    std::string label = base::StringPrintf(
+        "HttpCacheCompression_%s_disk_%s", name,
+        compress ? "compressed" : "uncompressed");
+    base::FilePath path = temp_dir_.path().AppendASCII(label);
+
+    std::string response_headers = base::StringPrintf(
+        "Content-Type: %s\nCache-Control: max-age=86400\n", mime_type);
+    std::vector<std::string> urls;
+    for (int i = 0; i < kNumCacheEntries; ++i) {
+      urls.push_back(base::StringPrintf("http://www.example.com/%s/%d",
+                                        name, i));
+    }
+    std::vector<MockTransaction> transactions(kNumCacheEntries,
+                                              kSimpleGET_Transaction);
+    for (int i = 0; i < kNumCacheEntries; ++i) {
+      transactions[i].url = urls[i].c_str();
+      transactions[i].response_headers = response_headers.c_str();
+      transactions[i].data = body.c_str();
+      AddMockTransaction(&transactions[i]);
+    }
+
+    {
+      scoped_ptr<HttpCache> cache(CreateCache(path, compress));
+      base::PerfTimeLogger timer((label + "_write").c_str());
+      for (int i = 0; i < kNumCacheEntries; ++i) {
+        std::string result;
+        Fetch(cache.get(), MockHttpRequest(transactions[i]), &result);
+        ASSERT_EQ(body.size(), result.size());
+      }
+      timer.Done();
+
+      base::LogPerfResult((label + "_bytes_written").c_str(),
+                          GetStoredBodySize(cache.get(), urls), "bytes");
+    }
+
+    // Destroying the cache flushes the backend to disk, so the next one has
+    // to load the entries from the files. Its backend is opened before the
+    // clock starts.
+    scoped_ptr<HttpCache> cache(CreateCache(path, compress));
+    disk_cache::Backend* backend;
+    TestCompletionCallback callback;
+    ASSERT_EQ(OK, callback.GetResult(
+        cache->GetBackend(&backend, callback.callback())));
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kNumCacheEntries; ++i) {
+      MockHttpRequest request(transactions[i]);
+      request.load_flags |= LOAD_ONLY_FROM_CACHE;
+      std::string result;
+      Fetch(cache.get(), request, &result);
+      ASSERT_EQ(body.size(), result.size());
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    base::LogPerfResult((label + "_read_latency").c_str(),
+                        elapsed.InMillisecondsF() / kNumCacheEntries, "ms");
+
+    for (int i = 0; i < kNumCacheEntries; ++i)
+      RemoveMockTransaction(&transactions[i]);
+  }
+
+ private:
+  scoped_ptr<HttpCache> CreateCache(const base::FilePath& path,
+                                    bool compress) {
+    scoped_ptr<HttpCache> cache(new HttpCache(
+        new MockNetworkLayer(), NULL,
+        new HttpCache::DefaultBackend(
+            DISK_CACHE, CACHE_BACKEND_DEFAULT, path, 0,
+            cache_thread_.message_loop_proxy().get())));
+    cache->set_compress_stored_bodies(compress);
+    return cache.Pass();
+  }
+
+  // Runs a transaction for |request|, and reads its body into |body| in
+  // chunks of the size URLRequest uses.
+  void Fetch(HttpCache* cache,
+             const HttpRequestInfo& request,
+             std::string* body) {
+    scoped_ptr<HttpTransaction> trans;
+    ASSERT_EQ(OK, cache->CreateTransaction(DEFAULT_PRIORITY, &trans, NULL));
+    TestCompletionCallback callback;
+    ASSERT_EQ(OK, callback.GetResult(
+        trans->Start(&request, callback.callback(), BoundNetLog())));
+
+    const int kBufSize = 32 * 1024;
+    scoped_refptr<IOBuffer> buf(new IOBuffer(kBufSize));
+    body->clear();
+    for (;;) {
+      int rv = callback.GetResult(
+          trans->Read(buf.get(), kBufSize, callback.callback()));
+      ASSERT_GE(rv, 0);
+      if (rv == 0)
+        break;
+      body->append(buf->data(), rv);
+    }
+  }
+
+  // Returns the number of bytes stored for the bodies of |urls|.
+  int64 GetStoredBodySize(HttpCache* cache,
+                          const std::vector<std::string>& urls) {
+    disk_cache::Backend* backend;
+    TestCompletionCallback callback;
+    EXPECT_EQ(OK, callback.GetResult(
+        cache->GetBackend(&backend, callback.callback())));
+    int64 size = 0;
+    for (size_t i = 0; i < urls.size(); ++i) {
+      disk_cache::Entry* entry;
+      int rv = backend->OpenEntry(urls[i], &entry, callback.callback());
+      if (callback.GetResult(rv) != OK) {
+        ADD_FAILURE() << "Missing entry for " << urls[i];
+        continue;
+      }
+      size += entry->GetDataSize(1);
+      entry->Close();
+    }
+    return size;
+  }
+
+  base::MessageLoopForIO message_loop_;
+  base::Thread cache_thread_;
+  base::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST(HttpCacheCompressionPerfTest, Html) {
+  RunTest("html", MakeHtmlBody());
+}
+
+TEST(HttpCacheCompressionPerfTest, Css) {
+  RunTest("css", MakeCssBody());
+}
+
+TEST(HttpCacheCompressionPerfTest, Json) {
+  RunTest("json", MakeJsonBody());
+}
+
+TEST_F(HttpCacheCompressionDiskPerfTest, Html) {
+  std::string body = MakeHtmlBody();
+  RunTest("html", "text/html", body, false);
+  RunTest("html", "text/html", body, true);
+}
+
+TEST_F(HttpCacheCompressionDiskPerfTest, Css) {
+  std::string body = MakeCssBody();
+  RunTest("css", "text/css", body, false);
+  RunTest("css", "text/css", body, true);
+}
+
+TEST_F(HttpCacheCompressionDiskPerfTest, Json) {
+  std::string body = MakeJsonBody();
+  RunTest("json", "application/json", body, false);
+  RunTest("json", "application/json", body, true);
+}
+
+}  // namespace net
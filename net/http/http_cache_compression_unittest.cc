@@ -0,0 +1,174 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_cache_compression.h"
+
+#include <algorithm>
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_util.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+std::string MakeTextBody(size_t size) {
+  const char kLine[] = "<div class=\"item\">The quick brown fox.</div>\n";
+  std::string body;
+  while (body.size() < size)
+    body.append(kLine);
+  body.resize(size);
+  return body;
+}
+
+std::string MakeRandomBody(size_t size) {
+  std::string body;
+  uint32 value = 0x12345678;
+  for (size_t i = 0; i < size; ++i) {
+    value = value * 1103515245 + 12345;
+    body.push_back(static_cast<char>(value >> 16));
+  }
+  return body;
+}
+
+std::string Compress(const std::string& body, int piece_size) {
+  HttpCacheCompressor compressor;
+  std::string stored;
+  for (size_t i = 0; i < body.size(); i += piece_size) {
+    int len = std::min(piece_size, static_cast<int>(body.size() - i));
+    EXPECT_TRUE(compressor.Append(body.data() + i, len, &stored));
+  }
+  EXPECT_TRUE(compressor.Finish(&stored));
+  EXPECT_EQ(static_cast<int64>(body.size()), compressor.bytes_in());
+  EXPECT_EQ(static_cast<int64>(stored.size()), compressor.bytes_out());
+  return stored;
+}
+
+// Feeds |stored| to a decompressor, |piece_size| bytes at a time, draining the
+// output after every piece. Returns false on error.
+bool Decompress(const std::string& stored, int piece_size,
+                std::string* body) {
+  HttpCacheDecompressor decompressor;
+  char buf[1000];
+  for (size_t i = 0; i < stored.size(); i += piece_size) {
+    int len = std::min(piece_size, static_cast<int>(stored.size() - i));
+    if (!decompressor.Append(stored.data() + i, len))
+      return false;
+    while (decompressor.HasOutput()) {
+      int rv = decompressor.Read(buf, sizeof(buf));
+      EXPECT_GT(rv, 0);
+      body->append(buf, rv);
+    }
+  }
+  return decompressor.IsAtFrameBoundary();
+}
+
+scoped_refptr<HttpResponseHeaders> MakeHeaders(const char* raw_headers) {
+  std::string headers(raw_headers);
+  return new HttpResponseHeaders(
+      HttpUtil::AssembleRawHeaders(headers.c_str(), headers.size()));
+}
+
+}  // namespace
+
+TEST(HttpCacheCompressionTest, RoundTrip) {
+  const size_t kSizes[] = {
+    1, 1000, HttpCacheCompressor::kChunkSize,
+    HttpCacheCompressor::kChunkSize + 1, 5 * HttpCacheCompressor::kChunkSize + 7
+  };
+  for (size_t i = 0; i < arraysize(kSizes); ++i) {
+    std::string body = MakeTextBody(kSizes[i]);
+    std::string stored = Compress(body, 4000);
+    if (kSizes[i] > 1000)
+      EXPECT_LT(stored.size(), body.size() / 4);
+
+    std::string result;
+    EXPECT_TRUE(Decompress(stored, 3000, &result));
+    EXPECT_EQ(body, result);
+
+    result.clear();
+    EXPECT_TRUE(Decompress(stored, 1, &result));
+    EXPECT_EQ(body, result);
+  }
+}
+
+TEST(HttpCacheCompressionTest, Empty) {
+  std::string stored = Compress(std::string(), 1);
+  EXPECT_TRUE(stored.empty());
+
+  HttpCacheDecompressor decompressor;
+  EXPECT_FALSE(decompressor.HasOutput());
+  EXPECT_TRUE(decompressor.IsAtFrameBoundary());
+}
+
+// Data that does not shrink is stored as is.
+TEST(HttpCacheCompressionTest, Incompressible) {
+  std::string body = MakeRandomBody(2 * HttpCacheCompressor::kChunkSize + 10);
+  std::string stored = Compress(body, 10000);
+  EXPECT_EQ(body.size() + 3 * HttpCacheCompressor::kFrameHeaderSize,
+            stored.size());
+
+  std::string result;
+  EXPECT_TRUE(Decompress(stored, 10000, &result));
+  EXPECT_EQ(body, result);
+}
+
+TEST(HttpCacheCompressionTest, Truncated) {
+  std::string body = MakeTextBody(3 * HttpCacheCompressor::kChunkSize);
+  std::string stored = Compress(body, 10000);
+  stored.resize(stored.size() - 1);
+
+  std::string result;
+  EXPECT_FALSE(Decompress(stored, 10000, &result));
+  EXPECT_EQ(2u * HttpCacheCompressor::kChunkSize, result.size());
+}
+
+TEST(HttpCacheCompressionTest, Corrupt) {
+  std::string body = MakeTextBody(1000);
+  std::string stored = Compress(body, 1000);
+
+  // Bad frame header.
+  std::string bad_header(stored);
+  bad_header[4] = '\xff';
+  bad_header[5] = '\xff';
+  bad_header[6] = '\xff';
+  std::string result;
+  EXPECT_FALSE(Decompress(bad_header, 1000, &result));
+
+  // Bad zlib data.
+  std::string bad_data(stored);
+  bad_data[HttpCacheCompressor::kFrameHeaderSize] ^= 0x55;
+  result.clear();
+  EXPECT_FALSE(Decompress(bad_data, 1000, &result));
+  EXPECT_TRUE(result.empty());
+}
+
+TEST(HttpCacheCompressionTest, ShouldCompress) {
+  EXPECT_TRUE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: text/html; charset=utf-8\n").get()));
+  EXPECT_TRUE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: application/javascript\n").get()));
+  EXPECT_TRUE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: text/css\n"
+      "Content-Encoding: identity\n").get()));
+
+  EXPECT_FALSE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: text/html\n"
+      "Content-Encoding: gzip\n").get()));
+  EXPECT_FALSE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: image/png\n").get()));
+  EXPECT_FALSE(HttpCacheCompressor::ShouldCompress(*MakeHeaders(
+      "HTTP/1.1 200 OK\n").get()));
+}
+
+}  // namespace net
@@ -32,6 +32,7 @@
 #include "net/base/upload_data_stream.h"
 #include "net/cert/cert_status_flags.h"
 #include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache_compression.h"
 #include "net/http/http_network_session.h"
 #include "net/http/http_request_info.h"
 #include "net/http/http_response_headers.h"
@@ -118,6 +119,21 @@ void RecordVaryHeaderHistogram(const net::HttpResponseInfo* response) {
   UMA_HISTOGRAM_ENUMERATION("HttpCache.Vary", vary, VARY_MAX);
 }
 
+// Maps the result of writing |frames_len| bytes of compressed body to the
+// result expected for the |data_len| bytes of data received from the network.
+int TranslateCompressedWriteResult(int result, int frames_len, int data_len) {
+  if (result == frames_len)
+    return data_len;
+  return result < 0 ? result : net::ERR_CACHE_WRITE_FAILURE;
+}
+
+void OnCompressedWriteComplete(int frames_len,
+                               int data_len,
+                               const net::CompletionCallback& callback,
+                               int result) {
+  callback.Run(TranslateCompressedWriteResult(result, frames_len, data_len));
+}
+
 }  // namespace
 
 namespace net {
@@ -760,6 +776,13 @@ int HttpCache::Transaction::DoLoop(int result) {
       case STATE_CACHE_READ_DATA_COMPLETE:
         rv = DoCacheReadDataComplete(rv);
         break;
+      case STATE_CACHE_READ_COMPRESSED_DATA:
+        DCHECK_EQ(OK, rv);
+        rv = DoCacheReadCompressedData();
+        break;
+      case STATE_CACHE_READ_COMPRESSED_DATA_COMPLETE:
+        rv = DoCacheReadCompressedDataComplete(rv);
+        break;
       case STATE_CACHE_WRITE_DATA:
         rv = DoCacheWriteData(rv);
         break;
@@ -1305,6 +1328,7 @@ int HttpCache::Transaction::DoOverwriteCachedResponse() {
     partial_->FixContentLength(new_response_->headers.get());
 
   response_ = *new_response_;
+  SetupBodyCompression();
 
   if (handling_206_ && !CanResume(false)) {
     // There is no point in storing this resource because it will never be used.
@@ -1414,10 +1438,17 @@ int HttpCache::Transaction::DoCacheReadResponseComplete(int result) {
     return OnCacheReadError(result, true);
   }
 
-  // Some resources may have slipped in as truncated when they're not.
-  int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
-  if (response_.headers->GetContentLength() == current_size)
-    truncated_ = false;
+  if (response_.body_stored_compressed) {
+    // We never store a compressed body for an incomplete response.
+    if (truncated_)
+      return OnCacheReadError(ERR_CACHE_READ_FAILURE, true);
+    body_decompressor_.reset(new HttpCacheDecompressor());
+  } else {
+    // Some resources may have slipped in as truncated when they're not.
+    int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
+    if (response_.headers->GetContentLength() == current_size)
+      truncated_ = false;
+  }
 
   // We now have access to the cache entry.
   //
@@ -1543,11 +1574,52 @@ int HttpCache::Transaction::DoCacheReadData() {
                                io_callback_);
   }
 
+  if (body_decompressor_.get()) {
+    next_state_ = STATE_CACHE_READ_COMPRESSED_DATA;
+    return OK;
+  }
+
   return entry_->disk_entry->ReadData(kResponseContentIndex, read_offset_,
                                       read_buf_.get(), io_buf_len_,
                                       io_callback_);
 }
 
+int HttpCache::Transaction::DoCacheReadCompressedData() {
+  if (body_decompressor_->HasOutput()) {
+    next_state_ = STATE_CACHE_READ_DATA_COMPLETE;
+    return body_decompressor_->Read(read_buf_->data(), io_buf_len_);
+  }
+
+  // Read the next piece of the stored body, at the end of what was already
+  // fed to the decompressor.
+  next_state_ = STATE_CACHE_READ_COMPRESSED_DATA_COMPLETE;
+  if (!compressed_read_buf_.get())
+    compressed_read_buf_ = new IOBuffer(HttpCacheCompressor::kChunkSize);
+  int64 offset = body_decompressor_->bytes_in();
+  return entry_->disk_entry->ReadData(
+      kResponseContentIndex, static_cast<int>(offset),
+      compressed_read_buf_.get(), HttpCacheCompressor::kChunkSize,
+      io_callback_);
+}
+
+int HttpCache::Transaction::DoCacheReadCompressedDataComplete(int result) {
+  next_state_ = STATE_CACHE_READ_DATA_COMPLETE;
+  if (result < 0)
+    return result;
+
+  if (result == 0) {
+    // The stored body must end with a complete frame.
+    return body_decompressor_->IsAtFrameBoundary() ? 0 :
+                                                     ERR_CACHE_READ_FAILURE;
+  }
+
+  if (!body_decompressor_->Append(compressed_read_buf_->data(), result))
+    return ERR_CACHE_READ_FAILURE;
+
+  next_state_ = STATE_CACHE_READ_COMPRESSED_DATA;
+  return OK;
+}
+
 int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
   ReportCacheActionFinish();
   if (net_log_.IsLoggingAllEvents()) {
@@ -1609,7 +1681,7 @@ int HttpCache::Transaction::DoCacheWriteDataComplete(int result) {
     // the network.
     result = write_len_;
   } else if (!done_reading_ && entry_) {
-    int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
+    int64 current_size = GetStoredBodySize();
     int64 body_size = response_.headers->GetContentLength();
     if (body_size >= 0 && body_size <= current_size)
       done_reading_ = true;
@@ -1792,7 +1864,25 @@ int HttpCache::Transaction::BeginCacheRead() {
 int HttpCache::Transaction::BeginCacheValidation() {
   DCHECK(mode_ == READ_WRITE);
 
-  bool skip_validation = !RequiresValidation();
+  ValidationType required_validation = RequiresValidation();
+
+  if (required_validation == VALIDATION_ASYNCHRONOUS &&
+      (truncated_ || partial_.get() ||
+       response_.headers->response_code() != 200)) {
+    // Sparse and truncated entries need the network anyway, so there is
+    // nothing to gain from serving them stale.
+    required_validation = VALIDATION_SYNCHRONOUS;
+  }
+
+  bool skip_validation = (required_validation == VALIDATION_NONE);
+
+  if (required_validation == VALIDATION_ASYNCHRONOUS) {
+    // Serve the stale entry now, and let the cache refresh it behind our back.
+    // The revalidation will not start until this transaction is done with the
+    // entry.
+    cache_->PerformAsyncValidation(*request_, net_log_);
+    skip_validation = true;
+  }
 
   if (truncated_) {
     // Truncated entries can cause partial gets, so we shouldn't record this
@@ -1836,6 +1926,16 @@ int HttpCache::Transaction::BeginCacheValidation() {
 int HttpCache::Transaction::BeginPartialCacheValidation() {
   DCHECK(mode_ == READ_WRITE);
 
+  if (response_.body_stored_compressed && partial_.get()) {
+    // A compressed body can only be decoded from the start, so let the server
+    // handle the byte range, and keep the entry for regular requests.
+    partial_->RestoreHeaders(&custom_request_->extra_headers);
+    body_decompressor_.reset();
+    IgnoreRangeRequest();
+    next_state_ = STATE_SEND_REQUEST;
+    return OK;
+  }
+
   if (response_.headers->response_code() != 206 && !partial_.get() &&
       !truncated_) {
     return BeginCacheValidation();
@@ -1947,37 +2047,48 @@ int HttpCache::Transaction::RestartNetworkRequestWithAuth(
   return rv;
 }
 
-bool HttpCache::Transaction::RequiresValidation() {
+HttpCache::Transaction::ValidationType
+HttpCache::Transaction::RequiresValidation() {
   // TODO(darin): need to do more work here:
   //  - make sure we have a matching request method
   //  - watch out for cached responses that depend on authentication
 
   // In playback mode, nothing requires validation.
   if (cache_->mode() == net::HttpCache::PLAYBACK)
-    return false;
+    return VALIDATION_NONE;
 
   if (response_.vary_data.is_valid() &&
       !response_.vary_data.MatchesRequest(*request_,
                                           *response_.headers.get())) {
     vary_mismatch_ = true;
-    return true;
+    return VALIDATION_SYNCHRONOUS;
   }
 
   if (effective_load_flags_ & LOAD_PREFERRING_CACHE)
-    return false;
+    return VALIDATION_NONE;
 
   if (effective_load_flags_ & LOAD_VALIDATE_CACHE)
-    return true;
+    return VALIDATION_SYNCHRONOUS;
 
   if (request_->method == "PUT" || request_->method == "DELETE")
-    return true;
+    return VALIDATION_SYNCHRONOUS;
 
-  if (response_.headers->RequiresValidation(
-          response_.request_time, response_.response_time, Time::Now())) {
-    return true;
+  Time now = Time::Now();
+  if (!response_.headers->RequiresValidation(
+          response_.request_time, response_.response_time, now)) {
+    return VALIDATION_NONE;
   }
 
-  return false;
+  // Only plain GETs are revalidated in the background; anything else goes
+  // through the regular synchronous validation.
+  if (cache_->use_stale_while_revalidate() && request_->method == "GET" &&
+      !request_->upload_data_stream &&
+      response_.headers->IsStaleWhileRevalidateAllowed(
+          response_.request_time, response_.response_time, now)) {
+    return VALIDATION_ASYNCHRONOUS;
+  }
+
+  return VALIDATION_SYNCHRONOUS;
 }
 
 bool HttpCache::Transaction::ConditionalizeRequest() {
@@ -2277,6 +2388,9 @@ int HttpCache::Transaction::WriteResponseInfoToEntry(bool truncated) {
 
 int HttpCache::Transaction::AppendResponseDataToEntry(
     IOBuffer* data, int data_len, const CompletionCallback& callback) {
+  if (entry_ && body_compressor_.get())
+    return AppendCompressedResponseDataToEntry(data, data_len, callback);
+
   if (!entry_ || !data_len)
     return data_len;
 
@@ -2285,6 +2399,58 @@ int HttpCache::Transaction::AppendResponseDataToEntry(
                       callback);
 }
 
+int HttpCache::Transaction::AppendCompressedResponseDataToEntry(
+    IOBuffer* data, int data_len, const CompletionCallback& callback) {
+  // A |data_len| of zero signals the end of the body.
+  std::string frames;
+  bool success = data_len ?
+      body_compressor_->Append(data->data(), data_len, &frames) :
+      body_compressor_->Finish(&frames);
+  // Flush the last chunk as soon as the whole body is here; the consumer may
+  // not read until the end of the stream.
+  int64 body_size = response_.headers->GetContentLength();
+  if (success && body_size >= 0 && body_compressor_->bytes_in() >= body_size)
+    success = body_compressor_->Finish(&frames);
+  if (!success)
+    return ERR_CACHE_WRITE_FAILURE;
+  if (frames.empty())
+    return data_len;
+
+  scoped_refptr<StringIOBuffer> buf(new StringIOBuffer(frames));
+  int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
+  int rv = WriteToEntry(kResponseContentIndex, current_size, buf.get(),
+                        buf->size(),
+                        base::Bind(&OnCompressedWriteComplete, buf->size(),
+                                   data_len, callback));
+  if (rv == ERR_IO_PENDING)
+    return rv;
+  return TranslateCompressedWriteResult(rv, buf->size(), data_len);
+}
+
+void HttpCache::Transaction::SetupBodyCompression() {
+  body_compressor_.reset();
+  body_decompressor_.reset();
+  response_.body_stored_compressed = false;
+
+  // Only complete, regular responses are compressed; everything else has to
+  // support reading arbitrary ranges of the stored body.
+  if (!entry_ || !cache_->compress_stored_bodies() || partial_.get() ||
+      handling_206_ || truncated_ || !response_.headers.get() ||
+      response_.headers->response_code() != 200 ||
+      !HttpCacheCompressor::ShouldCompress(*response_.headers.get())) {
+    return;
+  }
+
+  body_compressor_.reset(new HttpCacheCompressor());
+  response_.body_stored_compressed = true;
+}
+
+int64 HttpCache::Transaction::GetStoredBodySize() {
+  if (body_compressor_.get())
+    return body_compressor_->bytes_in();
+  return entry_->disk_entry->GetDataSize(kResponseContentIndex);
+}
+
 void HttpCache::Transaction::DoneWritingToEntry(bool success) {
   if (!entry_)
     return;
@@ -2392,6 +2558,10 @@ void HttpCache::Transaction::ResetNetworkTransaction() {
 //   Strong Validator + CL........ 49%
 //
 bool HttpCache::Transaction::CanResume(bool has_data) {
+  // A compressed body cannot be extended with a byte range from the server.
+  if (response_.body_stored_compressed)
+    return false;
+
   // Double check that there is something worth keeping.
   if (has_data && !entry_->disk_entry->GetDataSize(kResponseContentIndex))
     return false;
@@ -21,6 +21,8 @@
 
 namespace net {
 
+class HttpCacheCompressor;
+class HttpCacheDecompressor;
 class PartialData;
 struct HttpRequestInfo;
 class HttpTransactionDelegate;
@@ -142,6 +144,14 @@ class HttpCache::Transaction : public HttpTransaction {
     bool initialized;
   };
 
+  // Describes whether and how a cached entry must be validated before it can
+  // be returned to the caller.
+  enum ValidationType {
+    VALIDATION_NONE,          // The entry can be used as is.
+    VALIDATION_ASYNCHRONOUS,  // The entry can be used while it is revalidated.
+    VALIDATION_SYNCHRONOUS    // The entry must be revalidated before use.
+  };
+
   enum State {
     STATE_NONE,
     STATE_GET_BACKEND,
@@ -181,6 +191,8 @@ class HttpCache::Transaction : public HttpTransaction {
     STATE_CACHE_QUERY_DATA_COMPLETE,
     STATE_CACHE_READ_DATA,
     STATE_CACHE_READ_DATA_COMPLETE,
+    STATE_CACHE_READ_COMPRESSED_DATA,
+    STATE_CACHE_READ_COMPRESSED_DATA_COMPLETE,
     STATE_CACHE_WRITE_DATA,
     STATE_CACHE_WRITE_DATA_COMPLETE
   };
@@ -252,6 +264,8 @@ class HttpCache::Transaction : public HttpTransaction {
   int DoCacheQueryDataComplete(int result);
   int DoCacheReadData();
   int DoCacheReadDataComplete(int result);
+  int DoCacheReadCompressedData();
+  int DoCacheReadCompressedDataComplete(int result);
   int DoCacheWriteData(int num_bytes);
   int DoCacheWriteDataComplete(int result);
 
@@ -294,8 +308,9 @@ class HttpCache::Transaction : public HttpTransaction {
   // Returns network error code.
   int RestartNetworkRequestWithAuth(const AuthCredentials& credentials);
 
-  // Called to determine if we need to validate the cache entry before using it.
-  bool RequiresValidation();
+  // Called to determine if we need to validate the cache entry before using it,
+  // and whether that validation may happen in the background.
+  ValidationType RequiresValidation();
 
   // Called to make the request conditional (to ask the server if the cached
   // copy is valid).  Returns true if able to make the request conditional.
@@ -337,6 +352,19 @@ class HttpCache::Transaction : public HttpTransaction {
   int AppendResponseDataToEntry(IOBuffer* data, int data_len,
                                 const CompletionCallback& callback);
 
+  // Like AppendResponseDataToEntry(), for bodies stored compressed. A
+  // |data_len| of zero flushes the last chunk of the body.
+  int AppendCompressedResponseDataToEntry(IOBuffer* data, int data_len,
+                                          const CompletionCallback& callback);
+
+  // Decides whether the body of response_, about to be written to the entry,
+  // should be stored compressed, and sets up |body_compressor_| accordingly.
+  void SetupBodyCompression();
+
+  // Returns the number of body bytes stored in the entry, as seen by the
+  // consumer (that is, before compression).
+  int64 GetStoredBodySize();
+
   // Called when we are done writing to the cache entry.
   void DoneWritingToEntry(bool success);
 
@@ -417,6 +445,11 @@ class HttpCache::Transaction : public HttpTransaction {
   int effective_load_flags_;
   int write_len_;
   scoped_ptr<PartialData> partial_;  // We are dealing with range requests.
+  // Used when the body is written compressed to the entry.
+  scoped_ptr<HttpCacheCompressor> body_compressor_;
+  // Used when the body is read from a compressed entry.
+  scoped_ptr<HttpCacheDecompressor> body_decompressor_;
+  scoped_refptr<IOBuffer> compressed_read_buf_;
   UploadProgress final_upload_progress_;
   base::WeakPtrFactory<Transaction> weak_factory_;
   CompletionCallback io_callback_;
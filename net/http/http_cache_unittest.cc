@@ -2037,6 +2037,345 @@ TEST(HttpCache, ETagGET_ConditionalRequest_304) {
   TestLoadTimingNetworkRequest(load_timing_info);
 }
 
+const char kStaleWhileRevalidateHeaders[] =
+    "Cache-Control: max-age=0, stale-while-revalidate=3600\n"
+    "Etag: \"foopy\"\n";
+
+static void StaleWhileRevalidate_Handler(
+    const net::HttpRequestInfo* request,
+    std::string* response_status,
+    std::string* response_headers,
+    std::string* response_data) {
+  EXPECT_TRUE(
+      request->extra_headers.HasHeader(net::HttpRequestHeaders::kIfNoneMatch));
+  response_status->assign("HTTP/1.1 304 Not Modified");
+  response_headers->assign(kStaleWhileRevalidateHeaders);
+  response_data->clear();
+}
+
+static void StaleWhileRevalidate_NewContent_Handler(
+    const net::HttpRequestInfo* request,
+    std::string* response_status,
+    std::string* response_headers,
+    std::string* response_data) {
+  response_status->assign("HTTP/1.1 200 OK");
+  response_headers->assign(kStaleWhileRevalidateHeaders);
+  response_data->assign("new content");
+}
+
+// Tests that a stale entry within its stale-while-revalidate window is served
+// without waiting for the network, and is revalidated in the background.
+TEST(HttpCache, StaleWhileRevalidate_ServesStale) {
+  MockHttpCache cache;
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers = kStaleWhileRevalidateHeaders;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  // Read from the cache. The revalidation should not block the response.
+  transaction.handler = StaleWhileRevalidate_Handler;
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+
+  EXPECT_TRUE(response.was_cached);
+  EXPECT_FALSE(response.network_accessed);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+
+  // Now the background revalidation goes to the network.
+  base::MessageLoop::current()->RunUntilIdle();
+
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that the background revalidation updates the cached entry.
+TEST(HttpCache, StaleWhileRevalidate_UpdatesEntry) {
+  MockHttpCache cache;
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers = kStaleWhileRevalidateHeaders;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  // The stale content is served, while the server has new content.
+  transaction.handler = StaleWhileRevalidate_NewContent_Handler;
+  RunTransactionTest(cache.http_cache(), transaction);
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+
+  // The new content is now in the cache.
+  transaction.handler = NULL;
+  transaction.load_flags = net::LOAD_ONLY_FROM_CACHE;
+  transaction.data = "new content";
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+}
+
+// Tests that concurrent requests for a stale entry share a single background
+// revalidation.
+TEST(HttpCache, StaleWhileRevalidate_Deduplicated) {
+  MockHttpCache cache;
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers = kStaleWhileRevalidateHeaders;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  transaction.handler = StaleWhileRevalidate_Handler;
+  MockHttpRequest request(transaction);
+
+  std::vector<Context*> context_list;
+  const int kNumTransactions = 3;
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    context_list.push_back(new Context());
+    Context* c = context_list[i];
+
+    c->result = cache.http_cache()->CreateTransaction(
+        net::DEFAULT_PRIORITY, &c->trans, NULL);
+    EXPECT_EQ(net::OK, c->result);
+
+    c->result = c->trans->Start(
+        &request, c->callback.callback(), net::BoundNetLog());
+  }
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    if (c->result == net::ERR_IO_PENDING)
+      c->result = c->callback.WaitForResult();
+    EXPECT_EQ(net::OK, c->result);
+    ReadAndVerifyTransaction(c->trans.get(), transaction);
+
+    // All requests are served from the cache.
+    EXPECT_EQ(1, cache.network_layer()->transaction_count());
+    delete c;
+  }
+
+  base::MessageLoop::current()->RunUntilIdle();
+
+  // There was only one revalidation.
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+}
+
+// Tests that an entry past its stale-while-revalidate window is revalidated
+// synchronously.
+TEST(HttpCache, StaleWhileRevalidate_OutsideWindow) {
+  MockHttpCache cache;
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers =
+      "Cache-Control: max-age=0, stale-while-revalidate=60\n"
+      "Etag: \"foopy\"\n";
+  transaction.response_time = base::Time::Now() - base::TimeDelta::FromHours(1);
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  transaction.handler = ETagGet_ConditionalRequest_Handler;
+  transaction.response_time = base::Time();
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+
+  EXPECT_TRUE(response.network_accessed);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+}
+
+// Tests that stale-while-revalidate can be turned off.
+TEST(HttpCache, StaleWhileRevalidate_Disabled) {
+  MockHttpCache cache;
+  cache.http_cache()->set_use_stale_while_revalidate(false);
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers = kStaleWhileRevalidateHeaders;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  transaction.handler = StaleWhileRevalidate_Handler;
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+
+  EXPECT_TRUE(response.network_accessed);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+}
+
+// Tests that deleting the cache while a background revalidation is in progress
+// doesn't crash.
+TEST(HttpCache, StaleWhileRevalidate_DeleteCache) {
+  scoped_ptr<MockHttpCache> cache(new MockHttpCache());
+
+  ScopedMockTransaction transaction(kETagGET_Transaction);
+  transaction.response_headers = kStaleWhileRevalidateHeaders;
+
+  // Write to the cache.
+  RunTransactionTest(cache->http_cache(), transaction);
+
+  transaction.handler = StaleWhileRevalidate_Handler;
+  RunTransactionTest(cache->http_cache(), transaction);
+
+  cache.reset();
+  base::MessageLoop::current()->RunUntilIdle();
+}
+
+static const char kCompressibleHeaders[] =
+    "Cache-Control: max-age=10000\n"
+    "Content-Type: text/html\n"
+    "ETag: \"foo\"\n"
+    "Accept-Ranges: bytes\n";
+
+// Returns a body that spans a few compression chunks and compresses well.
+std::string MakeCompressibleBody() {
+  std::string body;
+  for (int i = 0; body.size() < 100 * 1024; ++i) {
+    base::StringAppendF(&body, "<div id=\"item%d\">Some text</div>\n", i);
+  }
+  return body;
+}
+
+void CompressedRange_Handler(const net::HttpRequestInfo* request,
+                             std::string* response_status,
+                             std::string* response_headers,
+                             std::string* response_data) {
+  // The range must be handled by the server.
+  std::string range;
+  EXPECT_TRUE(request->extra_headers.GetHeader(
+      net::HttpRequestHeaders::kRange, &range));
+  response_status->assign("HTTP/1.1 206 Partial Content");
+  response_headers->assign("Content-Range: bytes 40-49/80\n"
+                           "Content-Length: 10\n");
+  response_data->assign("rg: 40-49 ");
+}
+
+// Tests that text bodies are stored compressed, and read back as they came
+// from the network.
+TEST(HttpCache, CompressStoredBodies) {
+  MockHttpCache cache;
+  cache.http_cache()->set_compress_stored_bodies(true);
+
+  std::string body = MakeCompressibleBody();
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers = kCompressibleHeaders;
+  transaction.data = body.c_str();
+
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+  EXPECT_FALSE(response.was_cached);
+  EXPECT_TRUE(response.body_stored_compressed);
+
+  disk_cache::Entry* entry;
+  ASSERT_TRUE(cache.OpenBackendEntry(transaction.url, &entry));
+  EXPECT_LT(entry->GetDataSize(1), static_cast<int>(body.size()) / 4);
+  entry->Close();
+
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+  EXPECT_TRUE(response.was_cached);
+  EXPECT_TRUE(response.body_stored_compressed);
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that the last chunk is stored as soon as the whole body is received,
+// when the size of the body is known.
+TEST(HttpCache, CompressStoredBodies_ContentLength) {
+  MockHttpCache cache;
+  cache.http_cache()->set_compress_stored_bodies(true);
+
+  std::string body = MakeCompressibleBody();
+  std::string headers = base::StringPrintf("%sContent-Length: %d\n",
+                                           kCompressibleHeaders,
+                                           static_cast<int>(body.size()));
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers = headers.c_str();
+  transaction.data = body.c_str();
+
+  RunTransactionTest(cache.http_cache(), transaction);
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that bodies are stored as is unless compression is enabled, and only
+// text is compressed.
+TEST(HttpCache, CompressStoredBodies_NotCompressed) {
+  MockHttpCache cache;
+  std::string body = MakeCompressibleBody();
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers = kCompressibleHeaders;
+  transaction.data = body.c_str();
+
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+  EXPECT_FALSE(response.body_stored_compressed);
+
+  disk_cache::Entry* entry;
+  ASSERT_TRUE(cache.OpenBackendEntry(transaction.url, &entry));
+  EXPECT_EQ(static_cast<int>(body.size()), entry->GetDataSize(1));
+  entry->Close();
+
+  cache.http_cache()->set_compress_stored_bodies(true);
+  ScopedMockTransaction image_transaction(kTypicalGET_Transaction);
+  image_transaction.response_headers = "Cache-Control: max-age=10000\n"
+                                       "Content-Type: image/png\n";
+  image_transaction.data = body.c_str();
+  RunTransactionTestWithResponseInfo(cache.http_cache(), image_transaction,
+                                     &response);
+  EXPECT_FALSE(response.body_stored_compressed);
+
+  ASSERT_TRUE(cache.OpenBackendEntry(image_transaction.url, &entry));
+  EXPECT_EQ(static_cast<int>(body.size()), entry->GetDataSize(1));
+  entry->Close();
+}
+
+// Tests that a range request for a compressed entry goes to the server, and
+// that the entry is preserved.
+TEST(HttpCache, CompressStoredBodies_RangeRequest) {
+  MockHttpCache cache;
+  cache.http_cache()->set_compress_stored_bodies(true);
+
+  std::string body = MakeCompressibleBody();
+  ScopedMockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers = kCompressibleHeaders;
+  transaction.data = body.c_str();
+  RunTransactionTest(cache.http_cache(), transaction);
+
+  transaction.request_headers = "Range: bytes = 40-49\r\n";
+  transaction.handler = CompressedRange_Handler;
+  transaction.data = "rg: 40-49 ";
+  net::HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+  EXPECT_EQ(206, response.headers->response_code());
+  EXPECT_FALSE(response.was_cached);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+
+  // The stored body is still there.
+  transaction.request_headers = kSimpleGET_Transaction.request_headers;
+  transaction.handler = NULL;
+  transaction.data = body.c_str();
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response);
+  EXPECT_TRUE(response.was_cached);
+
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
 class RevalidationServer {
  public:
   RevalidationServer() {
@@ -23,7 +23,9 @@
 #include "net/quic/quic_stream_factory.h"
 #include "net/socket/client_socket_factory.h"
 #include "net/socket/client_socket_pool_manager_impl.h"
+#include "net/socket/connection_prewarm_model.h"
 #include "net/socket/next_proto.h"
+#include "net/socket/transport_client_socket_pool.h"
 #include "net/spdy/spdy_session_pool.h"
 
 namespace {
@@ -33,7 +35,7 @@ net::ClientSocketPoolManager* CreateSocketPoolManager(
     const net::HttpNetworkSession::Params& params) {
   // TODO(yutak): Differentiate WebSocket pool manager and allow more
   // simultaneous connections for WebSockets.
-  return new net::ClientSocketPoolManagerImpl(
+  net::ClientSocketPoolManager* manager = new net::ClientSocketPoolManagerImpl(
       params.net_log,
       params.client_socket_factory ?
       params.client_socket_factory :
@@ -46,6 +48,10 @@ net::ClientSocketPoolManager* CreateSocketPoolManager(
       params.proxy_service,
       params.ssl_config_service,
       pool_type);
+  // Let the direct connects remember how fast each address connects.
+  manager->GetTransportSocketPool()->SetHttpServerProperties(
+      params.http_server_properties);
+  return manager;
 }
 
 }  // unnamed namespace
@@ -66,6 +72,7 @@ HttpNetworkSession::Params::Params()
       host_mapping_rules(NULL),
       force_http_pipelining(false),
       ignore_certificate_errors(false),
+      enable_connection_prewarming(false),
       http_pipelining_enabled(false),
       testing_fixed_http_port(0),
       testing_fixed_https_port(0),
@@ -132,6 +139,11 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
   DCHECK(proxy_service_);
   DCHECK(ssl_config_service_.get());
   CHECK(http_server_properties_);
+
+  if (params.enable_connection_prewarming) {
+    connection_prewarm_model_.reset(
+        new ConnectionPrewarmModel(params.http_server_properties));
+  }
 }
 
 HttpNetworkSession::~HttpNetworkSession() {
@@ -30,6 +30,7 @@ namespace net {
 class CertVerifier;
 class ClientSocketFactory;
 class ClientSocketPoolManager;
+class ConnectionPrewarmModel;
 class HostResolver;
 class HttpAuthHandlerFactory;
 class HttpNetworkSessionPeer;
@@ -72,6 +73,9 @@ class NET_EXPORT HttpNetworkSession
     HostMappingRules* host_mapping_rules;
     bool force_http_pipelining;
     bool ignore_certificate_errors;
+    // Keeps idle sockets open for hosts which are likely to be used again
+    // soon. See ConnectionPrewarmModel.
+    bool enable_connection_prewarming;
     bool http_pipelining_enabled;
     uint16 testing_fixed_http_port;
     uint16 testing_fixed_https_port;
@@ -137,6 +141,10 @@ class NET_EXPORT HttpNetworkSession
   base::WeakPtr<HttpServerProperties> http_server_properties() {
     return http_server_properties_;
   }
+  // NULL unless connection prewarming is enabled.
+  ConnectionPrewarmModel* connection_prewarm_model() {
+    return connection_prewarm_model_.get();
+  }
   HttpStreamFactory* http_stream_factory() {
     return http_stream_factory_.get();
   }
@@ -198,6 +206,7 @@ class NET_EXPORT HttpNetworkSession
   SpdySessionPool spdy_session_pool_;
   scoped_ptr<HttpStreamFactory> http_stream_factory_;
   scoped_ptr<HttpStreamFactory> websocket_handshake_stream_factory_;
+  scoped_ptr<ConnectionPrewarmModel> connection_prewarm_model_;
   std::set<HttpResponseBodyDrainer*> response_drainers_;
 
   Params params_;
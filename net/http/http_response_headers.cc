@@ -909,6 +909,30 @@ bool HttpResponseHeaders::RequiresValidation(const Time& request_time,
   return lifetime <= GetCurrentAge(request_time, response_time, current_time);
 }
 
+bool HttpResponseHeaders::IsStaleWhileRevalidateAllowed(
+    const Time& request_time,
+    const Time& response_time,
+    const Time& current_time) const {
+  // Responses that must never be served without validation can't be served
+  // stale either.  See RFC 5861 section 3 and RFC 2616 section 14.9.4.
+  if (HasHeaderValue("cache-control", "no-cache") ||
+      HasHeaderValue("cache-control", "no-store") ||
+      HasHeaderValue("cache-control", "must-revalidate") ||
+      HasHeaderValue("cache-control", "proxy-revalidate") ||
+      HasHeaderValue("pragma", "no-cache") ||
+      HasHeaderValue("vary", "*"))
+    return false;
+
+  TimeDelta stale_while_revalidate;
+  if (!GetStaleWhileRevalidateValue(&stale_while_revalidate) ||
+      stale_while_revalidate <= TimeDelta())
+    return false;
+
+  TimeDelta lifetime = GetFreshnessLifetime(response_time);
+  return lifetime + stale_while_revalidate >
+         GetCurrentAge(request_time, response_time, current_time);
+}
+
 // From RFC 2616 section 13.2.4:
 //
 // The max-age directive takes priority over Expires, so if max-age is present
@@ -1054,32 +1078,40 @@ TimeDelta HttpResponseHeaders::GetCurrentAge(const Time& request_time,
   return current_age;
 }
 
-bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
+bool HttpResponseHeaders::GetCacheControlDirective(const char* directive,
+                                                   TimeDelta* result) const {
   std::string name = "cache-control";
   std::string value;
 
-  const char kMaxAgePrefix[] = "max-age=";
-  const size_t kMaxAgePrefixLen = arraysize(kMaxAgePrefix) - 1;
+  const size_t directive_size = strlen(directive);
 
   void* iter = NULL;
   while (EnumerateHeader(&iter, name, &value)) {
-    if (value.size() > kMaxAgePrefixLen) {
-      if (LowerCaseEqualsASCII(value.begin(),
-                               value.begin() + kMaxAgePrefixLen,
-                               kMaxAgePrefix)) {
-        int64 seconds;
-        base::StringToInt64(StringPiece(value.begin() + kMaxAgePrefixLen,
-                                        value.end()),
-                            &seconds);
-        *result = TimeDelta::FromSeconds(seconds);
-        return true;
-      }
+    if (value.size() > directive_size &&
+        LowerCaseEqualsASCII(value.begin(),
+                             value.begin() + directive_size,
+                             directive)) {
+      int64 seconds;
+      base::StringToInt64(StringPiece(value.begin() + directive_size,
+                                      value.end()),
+                          &seconds);
+      *result = TimeDelta::FromSeconds(seconds);
+      return true;
     }
   }
 
   return false;
 }
 
+bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
+  return GetCacheControlDirective("max-age=", result);
+}
+
+bool HttpResponseHeaders::GetStaleWhileRevalidateValue(
+    TimeDelta* result) const {
+  return GetCacheControlDirective("stale-while-revalidate=", result);
+}
+
 bool HttpResponseHeaders::GetAgeValue(TimeDelta* result) const {
   std::string value;
   if (!EnumerateHeader(NULL, "Age", &value))
@@ -197,6 +197,16 @@ class NET_EXPORT HttpResponseHeaders
                           const base::Time& response_time,
                           const base::Time& current_time) const;
 
+  // Returns true if the age of the response is within its freshness lifetime
+  // plus the window of its "stale-while-revalidate" Cache-Control extension
+  // (RFC 5861), and nothing else in the headers forbids serving it stale.  It
+  // doesn't check whether the response needs validation at all; callers
+  // should check RequiresValidation first.  See RequiresValidation for a
+  // description of this method's parameters.
+  bool IsStaleWhileRevalidateAllowed(const base::Time& request_time,
+                                     const base::Time& response_time,
+                                     const base::Time& current_time) const;
+
   // Returns the amount of time the server claims the response is fresh from
   // the time the response was generated.  See section 13.2.4 of RFC 2616.  See
   // RequiresValidation for a description of the response_time parameter.
@@ -212,6 +222,7 @@ class NET_EXPORT HttpResponseHeaders
   // value is not present, then false is returned.  Otherwise, true is returned
   // and the out param is assigned to the corresponding value.
   bool GetMaxAgeValue(base::TimeDelta* value) const;
+  bool GetStaleWhileRevalidateValue(base::TimeDelta* value) const;
   bool GetAgeValue(base::TimeDelta* value) const;
   bool GetDateValue(base::Time* value) const;
   bool GetLastModifiedValue(base::Time* value) const;
@@ -294,6 +305,12 @@ class NET_EXPORT HttpResponseHeaders
   // Initializes from the given raw headers.
   void Parse(const std::string& raw_input);
 
+  // Looks for a Cache-Control directive of the form "|directive|=<seconds>"
+  // and, if found, assigns its value to |result|.  |directive| must be lower
+  // case and include the trailing '='.
+  bool GetCacheControlDirective(const char* directive,
+                                base::TimeDelta* result) const;
+
   // Helper function for ParseStatusLine.
   // Tries to extract the "HTTP/X.Y" from a status line formatted like:
   //    HTTP/1.1 200 OK
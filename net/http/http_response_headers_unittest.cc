@@ -872,6 +872,74 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
   }
 }
 
+TEST(HttpResponseHeadersTest, IsStaleWhileRevalidateAllowed) {
+  const struct {
+    const char* headers;
+    bool stale_while_revalidate_allowed;
+  } tests[] = {
+    // no stale-while-revalidate directive
+    { "HTTP/1.1 200 OK\n"
+      "cache-control: max-age=0\n"
+      "\n",
+      false
+    },
+    // stale, but within the stale-while-revalidate window
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=60, stale-while-revalidate=3600\n"
+      "\n",
+      true
+    },
+    // stale, and past the stale-while-revalidate window
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=60, stale-while-revalidate=60\n"
+      "\n",
+      false
+    },
+    // expires header plus stale-while-revalidate
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "expires: Wed, 28 Nov 2007 00:00:00 GMT\n"
+      "cache-control: stale-while-revalidate=86400\n"
+      "\n",
+      true
+    },
+    // must-revalidate overrides stale-while-revalidate
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=0, must-revalidate\n"
+      "cache-control: stale-while-revalidate=3600\n"
+      "\n",
+      false
+    },
+    // no-cache overrides stale-while-revalidate
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: no-cache, stale-while-revalidate=3600\n"
+      "\n",
+      false
+    },
+  };
+  base::Time request_time, response_time, current_time;
+  base::Time::FromString("Wed, 28 Nov 2007 00:40:09 GMT", &request_time);
+  base::Time::FromString("Wed, 28 Nov 2007 00:40:12 GMT", &response_time);
+  base::Time::FromString("Wed, 28 Nov 2007 00:45:20 GMT", &current_time);
+
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(tests); ++i) {
+    std::string headers(tests[i].headers);
+    HeadersToRaw(&headers);
+    scoped_refptr<net::HttpResponseHeaders> parsed(
+        new net::HttpResponseHeaders(headers));
+
+    bool stale_while_revalidate_allowed =
+        parsed->IsStaleWhileRevalidateAllowed(request_time, response_time,
+                                              current_time);
+    EXPECT_EQ(tests[i].stale_while_revalidate_allowed,
+              stale_while_revalidate_allowed) << i;
+  }
+}
+
 TEST(HttpResponseHeadersTest, Update) {
   const struct {
     const char* orig_headers;
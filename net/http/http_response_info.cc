@@ -38,7 +38,13 @@ X509Certificate::PickleType GetPickleTypeForVersion(int version) {
 // serialized HttpResponseInfo.
 enum {
   // The version of the response info used when persisting response info.
-  RESPONSE_INFO_VERSION = 3,
+  RESPONSE_INFO_VERSION = 4,
+
+  // The version used for entries that don't need version 4 features. Version
+  // 4 is only written when the body is stored compressed, so that readers that
+  // don't understand compressed bodies skip those entries instead of returning
+  // the compressed bytes.
+  RESPONSE_INFO_UNCOMPRESSED_VERSION = 3,
 
   // The minimum version supported for deserializing response info.
   RESPONSE_INFO_MINIMUM_VERSION = 1,
@@ -87,6 +93,10 @@ enum {
   // This bit is set if the request has http authentication.
   RESPONSE_INFO_USE_HTTP_AUTHENTICATION = 1 << 19,
 
+  // This bit is set if the response body is stored compressed by the
+  // HttpCache. Requires version 4.
+  RESPONSE_INFO_BODY_STORED_COMPRESSED = 1 << 20,
+
   // TODO(darin): Add other bits to indicate alternate request methods.
   // For now, we don't support storing those.
 };
@@ -99,6 +109,7 @@ HttpResponseInfo::HttpResponseInfo()
       was_npn_negotiated(false),
       was_fetched_via_proxy(false),
       did_use_http_auth(false),
+      body_stored_compressed(false),
       connection_info(CONNECTION_INFO_UNKNOWN) {
 }
 
@@ -110,6 +121,7 @@ HttpResponseInfo::HttpResponseInfo(const HttpResponseInfo& rhs)
       was_npn_negotiated(rhs.was_npn_negotiated),
       was_fetched_via_proxy(rhs.was_fetched_via_proxy),
       did_use_http_auth(rhs.did_use_http_auth),
+      body_stored_compressed(rhs.body_stored_compressed),
       socket_address(rhs.socket_address),
       npn_negotiated_protocol(rhs.npn_negotiated_protocol),
       connection_info(rhs.connection_info),
@@ -134,6 +146,7 @@ HttpResponseInfo& HttpResponseInfo::operator=(const HttpResponseInfo& rhs) {
   was_npn_negotiated = rhs.was_npn_negotiated;
   was_fetched_via_proxy = rhs.was_fetched_via_proxy;
   did_use_http_auth = rhs.did_use_http_auth;
+  body_stored_compressed = rhs.body_stored_compressed;
   socket_address = rhs.socket_address;
   npn_negotiated_protocol = rhs.npn_negotiated_protocol;
   connection_info = rhs.connection_info;
@@ -255,13 +268,17 @@ bool HttpResponseInfo::InitFromPickle(const Pickle& pickle,
 
   did_use_http_auth = (flags & RESPONSE_INFO_USE_HTTP_AUTHENTICATION) != 0;
 
+  body_stored_compressed =
+      (flags & RESPONSE_INFO_BODY_STORED_COMPRESSED) != 0;
+
   return true;
 }
 
 void HttpResponseInfo::Persist(Pickle* pickle,
                                bool skip_transient_headers,
                                bool response_truncated) const {
-  int flags = RESPONSE_INFO_VERSION;
+  int flags = body_stored_compressed ? RESPONSE_INFO_VERSION :
+                                      RESPONSE_INFO_UNCOMPRESSED_VERSION;
   if (ssl_info.is_valid()) {
     flags |= RESPONSE_INFO_HAS_CERT;
     flags |= RESPONSE_INFO_HAS_CERT_STATUS;
@@ -286,6 +303,8 @@ void HttpResponseInfo::Persist(Pickle* pickle,
     flags |= RESPONSE_INFO_HAS_CONNECTION_INFO;
   if (did_use_http_auth)
     flags |= RESPONSE_INFO_USE_HTTP_AUTHENTICATION;
+  if (body_stored_compressed)
+    flags |= RESPONSE_INFO_BODY_STORED_COMPRESSED;
 
   pickle->WriteInt(flags);
   pickle->WriteInt64(request_time.ToInternalValue());
@@ -90,6 +90,11 @@ class NET_EXPORT HttpResponseInfo {
   // Whether the request use http proxy or server authentication.
   bool did_use_http_auth;
 
+  // True if the HttpCache stores the body of this response compressed. This is
+  // a detail of the cache storage, and it doesn't affect the data returned to
+  // the consumer.
+  bool body_stored_compressed;
+
   // Remote address of the socket which fetched this resource.
   //
   // NOTE: If the response was served from the cache (was_cached is true),
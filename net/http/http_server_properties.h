@@ -9,7 +9,9 @@
 #include <string>
 #include "base/basictypes.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_export.h"
 #include "net/http/http_pipelined_host_capability.h"
 #include "net/socket/next_proto.h"
@@ -68,11 +70,25 @@ typedef std::map<HostPortPair,
 
 extern const char kAlternateProtocolHeader[];
 
+// What is known about connecting to an IP address. Connect jobs use it to
+// decide which of the addresses of a host to try first, and how long to wait
+// for a connect before racing the next address against it.
+struct NET_EXPORT AddressConnectStats {
+  AddressConnectStats() {}
+
+  // The smoothed time taken by successful connects, or zero if none
+  // succeeded.
+  base::TimeDelta rtt;
+  // When the last connect failed, or null if it succeeded.
+  base::TimeTicks last_failure;
+};
+
 // The interface for setting/retrieving the HTTP server properties.
 // Currently, this class manages servers':
 // * SPDY support (based on NPN results)
 // * Alternate-Protocol support
 // * Spdy Settings (like CWND ID field)
+// * Connect times and failures of IP addresses
 class NET_EXPORT HttpServerProperties {
  public:
   HttpServerProperties() {}
@@ -143,6 +159,19 @@ class NET_EXPORT HttpServerProperties {
 
   virtual PipelineCapabilityMap GetPipelineCapabilityMap() const = 0;
 
+  // Returns what is known about connecting to |address|, or an empty
+  // AddressConnectStats if nothing is.
+  virtual AddressConnectStats GetAddressConnectStats(
+      const IPEndPoint& address) = 0;
+
+  // Saves what is known about connecting to |address|. These depend on the
+  // network, so they aren't persisted.
+  virtual void SetAddressConnectStats(const IPEndPoint& address,
+                                      const AddressConnectStats& stats) = 0;
+
+  // Clears the AddressConnectStats of all addresses.
+  virtual void ClearAddressConnectStats() = 0;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(HttpServerProperties);
 };
@@ -17,9 +17,13 @@ namespace net {
 // then, this is just a bad guess.
 static const int kDefaultNumHostsToRemember = 200;
 
+// The number of IP addresses to remember connect times and failures for.
+static const int kNumAddressesToRemember = 200;
+
 HttpServerPropertiesImpl::HttpServerPropertiesImpl()
     : pipeline_capability_map_(
         new CachedPipelineCapabilityMap(kDefaultNumHostsToRemember)),
+      address_connect_stats_map_(kNumAddressesToRemember),
       weak_ptr_factory_(this) {
 }
 
@@ -123,6 +127,7 @@ void HttpServerPropertiesImpl::Clear() {
   alternate_protocol_map_.clear();
   spdy_settings_map_.clear();
   pipeline_capability_map_->Clear();
+  address_connect_stats_map_.Clear();
 }
 
 bool HttpServerPropertiesImpl::SupportsSpdy(
@@ -300,4 +305,26 @@ HttpServerPropertiesImpl::GetPipelineCapabilityMap() const {
   return result;
 }
 
+AddressConnectStats HttpServerPropertiesImpl::GetAddressConnectStats(
+    const IPEndPoint& address) {
+  DCHECK(CalledOnValidThread());
+  AddressConnectStatsMap::const_iterator it =
+      address_connect_stats_map_.Get(address);
+  if (it == address_connect_stats_map_.end())
+    return AddressConnectStats();
+  return it->second;
+}
+
+void HttpServerPropertiesImpl::SetAddressConnectStats(
+    const IPEndPoint& address,
+    const AddressConnectStats& stats) {
+  DCHECK(CalledOnValidThread());
+  address_connect_stats_map_.Put(address, stats);
+}
+
+void HttpServerPropertiesImpl::ClearAddressConnectStats() {
+  DCHECK(CalledOnValidThread());
+  address_connect_stats_map_.Clear();
+}
+
 }  // namespace net
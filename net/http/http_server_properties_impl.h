@@ -16,6 +16,7 @@
 #include "base/threading/non_thread_safe.h"
 #include "base/values.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_export.h"
 #include "net/http/http_pipelined_host_capability.h"
 #include "net/http/http_server_properties.h"
@@ -138,9 +139,20 @@ class NET_EXPORT HttpServerPropertiesImpl
 
   virtual PipelineCapabilityMap GetPipelineCapabilityMap() const OVERRIDE;
 
+  virtual AddressConnectStats GetAddressConnectStats(
+      const IPEndPoint& address) OVERRIDE;
+
+  virtual void SetAddressConnectStats(
+      const IPEndPoint& address,
+      const AddressConnectStats& stats) OVERRIDE;
+
+  virtual void ClearAddressConnectStats() OVERRIDE;
+
  private:
   typedef base::MRUCache<
       HostPortPair, HttpPipelinedHostCapability> CachedPipelineCapabilityMap;
+  typedef base::MRUCache<
+      IPEndPoint, AddressConnectStats> AddressConnectStatsMap;
   // |spdy_servers_table_| has flattened representation of servers (host/port
   // pair) that either support or not support SPDY protocol.
   typedef base::hash_map<std::string, bool> SpdyServerHostPortTable;
@@ -150,6 +162,7 @@ class NET_EXPORT HttpServerPropertiesImpl
   AlternateProtocolMap alternate_protocol_map_;
   SpdySettingsMap spdy_settings_map_;
   scoped_ptr<CachedPipelineCapabilityMap> pipeline_capability_map_;
+  AddressConnectStatsMap address_connect_stats_map_;
 
   base::WeakPtrFactory<HttpServerPropertiesImpl> weak_ptr_factory_;
 
@@ -13,6 +13,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -411,6 +412,50 @@ TEST_F(SpdySettingsServerPropertiesTest, Clear) {
   EXPECT_EQ(0U, impl_.GetSpdySettings(spdy_server_docs).size());
 }
 
+typedef HttpServerPropertiesImplTest AddressConnectStatsServerPropertiesTest;
+
+TEST_F(AddressConnectStatsServerPropertiesTest, SetAndClear) {
+  IPAddressNumber ip_v4;
+  ASSERT_TRUE(ParseIPLiteralToNumber("1.2.3.4", &ip_v4));
+  IPAddressNumber ip_v6;
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:db8::1", &ip_v6));
+  const IPEndPoint address_v4(ip_v4, 443);
+  const IPEndPoint address_v6(ip_v6, 443);
+
+  // Nothing is known about new addresses.
+  AddressConnectStats stats = impl_.GetAddressConnectStats(address_v4);
+  EXPECT_TRUE(stats.rtt == base::TimeDelta());
+  EXPECT_TRUE(stats.last_failure.is_null());
+
+  AddressConnectStats stats_v4;
+  stats_v4.rtt = base::TimeDelta::FromMilliseconds(30);
+  impl_.SetAddressConnectStats(address_v4, stats_v4);
+  AddressConnectStats stats_v6;
+  stats_v6.last_failure = base::TimeTicks::Now();
+  impl_.SetAddressConnectStats(address_v6, stats_v6);
+
+  stats = impl_.GetAddressConnectStats(address_v4);
+  EXPECT_TRUE(stats_v4.rtt == stats.rtt);
+  EXPECT_TRUE(stats.last_failure.is_null());
+  stats = impl_.GetAddressConnectStats(address_v6);
+  EXPECT_TRUE(stats.rtt == base::TimeDelta());
+  EXPECT_TRUE(stats_v6.last_failure == stats.last_failure);
+
+  // A different port is a different address.
+  stats = impl_.GetAddressConnectStats(IPEndPoint(ip_v4, 80));
+  EXPECT_TRUE(stats.rtt == base::TimeDelta());
+
+  impl_.ClearAddressConnectStats();
+  EXPECT_TRUE(impl_.GetAddressConnectStats(address_v4).rtt ==
+              base::TimeDelta());
+  EXPECT_TRUE(impl_.GetAddressConnectStats(address_v6).last_failure.is_null());
+
+  impl_.SetAddressConnectStats(address_v4, stats_v4);
+  impl_.Clear();
+  EXPECT_TRUE(impl_.GetAddressConnectStats(address_v4).rtt ==
+              base::TimeDelta());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -526,77 +526,133 @@ struct PublicKeyPins {
   const char* const* excluded_hashes;
 };
 
+// HSTSPreload is an entry of kHSTSPreloads. Its name is only in the comment
+// next to it in the table; lookups go through kHSTSPreloadTrie instead.
 struct HSTSPreload {
-  uint8 length;
   bool include_subdomains;
-  char dns_name[38];
   bool https_required;
-  PublicKeyPins pins;
-  SecondLevelDomainName second_level_domain_name;
+  // Whether the entry only applies to connections which send SNI.
+  bool sni_only;
+  // Index in kPinsets.
+  uint8 pins;
+  // A SecondLevelDomainName.
+  uint8 second_level_domain_name;
 };
 
-static bool HasPreload(const struct HSTSPreload* entries, size_t num_entries,
-                       const std::string& canonicalized_host, size_t i,
-                       TransportSecurityState::DomainState* out, bool* ret) {
-  for (size_t j = 0; j < num_entries; j++) {
-    if (entries[j].length == canonicalized_host.size() - i &&
-        memcmp(entries[j].dns_name, &canonicalized_host[i],
-               entries[j].length) == 0) {
-      if (!entries[j].include_subdomains && i != 0) {
-        *ret = false;
-      } else {
-        out->sts_include_subdomains = entries[j].include_subdomains;
-        out->pkp_include_subdomains = entries[j].include_subdomains;
-        *ret = true;
-        if (!entries[j].https_required)
-          out->upgrade_mode = TransportSecurityState::DomainState::MODE_DEFAULT;
-        if (entries[j].pins.required_hashes) {
-          const char* const* sha1_hash = entries[j].pins.required_hashes;
-          while (*sha1_hash) {
-            AddHash(*sha1_hash, &out->static_spki_hashes);
-            sha1_hash++;
-          }
-        }
-        if (entries[j].pins.excluded_hashes) {
-          const char* const* sha1_hash = entries[j].pins.excluded_hashes;
-          while (*sha1_hash) {
-            AddHash(*sha1_hash, &out->bad_static_spki_hashes);
-            sha1_hash++;
-          }
-        }
-      }
-      return true;
-    }
+// HSTSPreloadTrieNode is a node of kHSTSPreloadTrie. Its label is the
+// |label_length| bytes at kHSTSPreloadLabels[label], and its children are the
+// |num_children| nodes starting at kHSTSPreloadTrie[first_child]. |entry| is
+// the index in kHSTSPreloads of the name which ends at this node, or
+// kNoHSTSPreload.
+struct HSTSPreloadTrieNode {
+  uint16 label;
+  uint8 label_length;
+  uint8 num_children;
+  uint16 first_child;
+  uint16 entry;
+};
+
+static const uint16 kNoHSTSPreload = 0xffff;
+
+#include "net/http/transport_security_state_static.h"
+
+COMPILE_ASSERT(arraysize(kHSTSPreloads) < kNoHSTSPreload,
+               too_many_hsts_preloads);
+COMPILE_ASSERT(arraysize(kPinsets) <= 256, too_many_pinsets);
+COMPILE_ASSERT(DOMAIN_NUM_EVENTS <= 256, too_many_second_level_domain_names);
+
+// Returns the child of |node| whose label is the |length| bytes at |label|,
+// or NULL if there is none.
+static const struct HSTSPreloadTrieNode* FindHSTSPreloadTrieChild(
+    const struct HSTSPreloadTrieNode* node,
+    const char* label,
+    size_t length) {
+  size_t low = node->first_child;
+  size_t high = low + node->num_children;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const struct HSTSPreloadTrieNode* child = &kHSTSPreloadTrie[middle];
+    int cmp = memcmp(kHSTSPreloadLabels + child->label, label,
+                     std::min<size_t>(child->label_length, length));
+    if (cmp == 0 && child->label_length != length)
+      cmp = child->label_length < length ? -1 : 1;
+    if (cmp == 0)
+      return child;
+    if (cmp < 0)
+      low = middle + 1;
+    else
+      high = middle;
   }
-  return false;
+  return NULL;
 }
 
-#include "net/http/transport_security_state_static.h"
+// HSTSPreloadMatch is an entry of kHSTSPreloads whose name is the suffix of a
+// canonicalized host starting at |offset|.
+struct HSTSPreloadMatch {
+  const struct HSTSPreload* entry;
+  size_t offset;
+};
 
-// Returns the HSTSPreload entry for the |canonicalized_host| in |entries|,
-// or NULL if there is none. Prefers exact hostname matches to those that
-// match only because HSTSPreload.include_subdomains is true.
+// Finds the entries of kHSTSPreloads for |canonicalized_host| and its parent
+// domains by walking kHSTSPreloadTrie from the last label of the host. Stores
+// them in |matches|, most specific first, and returns how many there are.
 //
 // |canonicalized_host| should be the hostname as canonicalized by
 // CanonicalizeHost.
-static const struct HSTSPreload* GetHSTSPreload(
+static size_t FindHSTSPreloads(
     const std::string& canonicalized_host,
-    const struct HSTSPreload* entries,
-    size_t num_entries) {
+    HSTSPreloadMatch matches[kHSTSPreloadTrieMaxDepth]) {
+  // Only the last kHSTSPreloadTrieMaxDepth labels can be in the trie, so the
+  // offsets of the labels are kept in a ring buffer of that size.
+  size_t label_offsets[kHSTSPreloadTrieMaxDepth];
+  size_t num_labels = 0;
   for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    for (size_t j = 0; j < num_entries; j++) {
-      const struct HSTSPreload* entry = entries + j;
-
-      if (i != 0 && !entry->include_subdomains)
-        continue;
+    label_offsets[num_labels % kHSTSPreloadTrieMaxDepth] = i;
+    num_labels++;
+  }
 
-      if (entry->length == canonicalized_host.size() - i &&
-          memcmp(entry->dns_name, &canonicalized_host[i], entry->length) == 0) {
-        return entry;
-      }
+  size_t num_matches = 0;
+  const struct HSTSPreloadTrieNode* node = kHSTSPreloadTrie;
+  const size_t depth = std::min(num_labels, kHSTSPreloadTrieMaxDepth);
+  for (size_t i = 1; i <= depth; i++) {
+    const size_t offset =
+        label_offsets[(num_labels - i) % kHSTSPreloadTrieMaxDepth];
+    node = FindHSTSPreloadTrieChild(
+        node, &canonicalized_host[offset + 1],
+        static_cast<uint8>(canonicalized_host[offset]));
+    if (!node)
+      break;
+    if (node->entry != kNoHSTSPreload) {
+      matches[num_matches].entry = &kHSTSPreloads[node->entry];
+      matches[num_matches].offset = offset;
+      num_matches++;
     }
   }
 
+  std::reverse(matches, matches + num_matches);
+  return num_matches;
+}
+
+// Returns the HSTSPreload entry for the |canonicalized_host| whose |sni_only|
+// is |sni_only|, or NULL if there is none. Prefers exact hostname matches to
+// those that match only because HSTSPreload.include_subdomains is true.
+//
+// |canonicalized_host| should be the hostname as canonicalized by
+// CanonicalizeHost.
+static const struct HSTSPreload* GetHSTSPreload(
+    const std::string& canonicalized_host,
+    bool sni_only) {
+  HSTSPreloadMatch matches[kHSTSPreloadTrieMaxDepth];
+  const size_t num_matches = FindHSTSPreloads(canonicalized_host, matches);
+  for (size_t i = 0; i < num_matches; i++) {
+    const struct HSTSPreload* entry = matches[i].entry;
+    if (entry->sni_only != sni_only)
+      continue;
+    if (matches[i].offset != 0 && !entry->include_subdomains)
+      continue;
+    return entry;
+  }
+
   return NULL;
 }
 
@@ -692,17 +748,17 @@ bool TransportSecurityState::AddHPKP(const std::string& host,
 bool TransportSecurityState::IsGooglePinnedProperty(const std::string& host,
                                                     bool sni_enabled) {
   std::string canonicalized_host = CanonicalizeHost(host);
-  const struct HSTSPreload* entry =
-      GetHSTSPreload(canonicalized_host, kPreloadedSTS, kNumPreloadedSTS);
+  const struct HSTSPreload* entry = GetHSTSPreload(canonicalized_host, false);
 
-  if (entry && entry->pins.required_hashes == kGoogleAcceptableCerts)
+  if (entry && kPinsets[entry->pins].required_hashes == kGoogleAcceptableCerts)
     return true;
 
   if (sni_enabled) {
-    entry = GetHSTSPreload(canonicalized_host, kPreloadedSNISTS,
-                           kNumPreloadedSNISTS);
-    if (entry && entry->pins.required_hashes == kGoogleAcceptableCerts)
+    entry = GetHSTSPreload(canonicalized_host, true);
+    if (entry &&
+        kPinsets[entry->pins].required_hashes == kGoogleAcceptableCerts) {
       return true;
+    }
   }
 
   return false;
@@ -712,13 +768,10 @@ bool TransportSecurityState::IsGooglePinnedProperty(const std::string& host,
 void TransportSecurityState::ReportUMAOnPinFailure(const std::string& host) {
   std::string canonicalized_host = CanonicalizeHost(host);
 
-  const struct HSTSPreload* entry =
-      GetHSTSPreload(canonicalized_host, kPreloadedSTS, kNumPreloadedSTS);
+  const struct HSTSPreload* entry = GetHSTSPreload(canonicalized_host, false);
 
-  if (!entry) {
-    entry = GetHSTSPreload(canonicalized_host, kPreloadedSNISTS,
-                           kNumPreloadedSNISTS);
-  }
+  if (!entry)
+    entry = GetHSTSPreload(canonicalized_host, true);
 
   if (!entry) {
     // We don't care to report pin failures for dynamic pins.
@@ -726,7 +779,7 @@ void TransportSecurityState::ReportUMAOnPinFailure(const std::string& host) {
   }
 
   DCHECK(entry);
-  DCHECK(entry->pins.required_hashes);
+  DCHECK(kPinsets[entry->pins].required_hashes);
   DCHECK(entry->second_level_domain_name != DOMAIN_NOT_PINNED);
 
   UMA_HISTOGRAM_ENUMERATION("Net.PublicKeyPinFailureDomain",
@@ -750,24 +803,41 @@ bool TransportSecurityState::GetStaticDomainState(
   out->sts_include_subdomains = false;
   out->pkp_include_subdomains = false;
 
-  const bool is_build_timely = IsBuildTimely();
+  if (!IsBuildTimely())
+    return false;
 
-  for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    std::string host_sub_chunk(&canonicalized_host[i],
-                               canonicalized_host.size() - i);
-    out->domain = DNSDomainToString(host_sub_chunk);
-    bool ret;
-    if (is_build_timely &&
-        HasPreload(kPreloadedSTS, kNumPreloadedSTS, canonicalized_host, i, out,
-                   &ret)) {
-      return ret;
+  HSTSPreloadMatch matches[kHSTSPreloadTrieMaxDepth];
+  const size_t num_matches = FindHSTSPreloads(canonicalized_host, matches);
+  for (size_t i = 0; i < num_matches; i++) {
+    const struct HSTSPreload* entry = matches[i].entry;
+    if (entry->sni_only && !sni_enabled)
+      continue;
+
+    out->domain = DNSDomainToString(
+        canonicalized_host.substr(matches[i].offset));
+    if (!entry->include_subdomains && matches[i].offset != 0)
+      return false;
+
+    out->sts_include_subdomains = entry->include_subdomains;
+    out->pkp_include_subdomains = entry->include_subdomains;
+    if (!entry->https_required)
+      out->upgrade_mode = DomainState::MODE_DEFAULT;
+    const PublicKeyPins& pins = kPinsets[entry->pins];
+    if (pins.required_hashes) {
+      const char* const* sha1_hash = pins.required_hashes;
+      while (*sha1_hash) {
+        AddHash(*sha1_hash, &out->static_spki_hashes);
+        sha1_hash++;
+      }
     }
-    if (sni_enabled &&
-        is_build_timely &&
-        HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host, i,
-                   out, &ret)) {
-      return ret;
+    if (pins.excluded_hashes) {
+      const char* const* sha1_hash = pins.excluded_hashes;
+      while (*sha1_hash) {
+        AddHash(*sha1_hash, &out->bad_static_spki_hashes);
+        sha1_hash++;
+      }
     }
+    return true;
   }
 
   return false;
@@ -0,0 +1,76 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/basictypes.h"
+#include "base/test/perf_time_logger.h"
+#include "net/http/transport_security_state.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumIterations = 20000;
+
+// A mix of hosts like the ones every request is checked for: mostly hosts
+// which aren't preloaded, some which are, and some subdomains of preloaded
+// hosts.
+const char* const kHosts[] = {
+  "www.example.com",
+  "en.wikipedia.org",
+  "upload.wikimedia.org",
+  "www.facebook.com",
+  "static.ak.fbcdn.net",
+  "news.ycombinator.com",
+  "a248.e.akamai.net",
+  "s.yimg.com",
+  "www.bbc.co.uk",
+  "cdn.sstatic.net",
+  "www.google.com",
+  "mail.google.com",
+  "ssl.gstatic.com",
+  "lh3.googleusercontent.com",
+  "www.paypal.com",
+  "twitter.com",
+  "pbs.twimg.com",
+  "www.torproject.org",
+  "a.b.c.d.e.f.docs.google.com",
+  "www.googlegroups.com",
+  "localhost",
+  "192.168.0.1",
+};
+
+}  // namespace
+
+TEST(TransportSecurityStatePerfTest, GetDomainState) {
+  TransportSecurityState state;
+  TransportSecurityState::DomainState domain_state;
+  int num_found = 0;
+
+  base::PerfTimeLogger timer("TransportSecurityState_GetDomainState");
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (size_t j = 0; j < arraysize(kHosts); ++j) {
+      if (state.GetDomainState(kHosts[j], true, &domain_state))
+        num_found++;
+    }
+  }
+  timer.Done();
+  EXPECT_LT(0, num_found);
+}
+
+TEST(TransportSecurityStatePerfTest, IsGooglePinnedProperty) {
+  int num_found = 0;
+
+  base::PerfTimeLogger timer("TransportSecurityState_IsGooglePinnedProperty");
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (size_t j = 0; j < arraysize(kHosts); ++j) {
+      if (TransportSecurityState::IsGooglePinnedProperty(kHosts[j], true))
+        num_found++;
+    }
+  }
+  timer.Done();
+  EXPECT_LT(0, num_found);
+}
+
+}  // namespace net
@@ -2,7 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-// This file is automatically generated by transport_security_state_static_generate.go
+// This file is automatically generated by
+// transport_security_state_static_generate.py
 
 #ifndef NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
 #define NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
@@ -210,6 +211,7 @@ static const char kSPKIHash_Libertylavabitcom[] =
     "\x41\xbb\x3b\x8b\xc7\xcf\x3d\x13\x3f\x17"
     "\xb3\x25\x7e\xe4\x03\xca\x8a\x5c\x6d\x36";
 
+
 // The following is static data describing the hosts that are hardcoded with
 // certificate pins or HSTS information.
 
@@ -360,497 +362,1364 @@ static const char* const kLavabitAcceptableCerts[] = {
   NULL, NULL, \
 }
 
-static const struct HSTSPreload kPreloadedSTS[] = {
-  {25, true, "\013pinningtest\007appspot\003com", false, kTestPins, DOMAIN_APPSPOT_COM },
-  {12, true, "\006google\003com", false, kGooglePins, DOMAIN_GOOGLE_COM },
-  {19, true, "\006wallet\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {21, true, "\010checkout\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {19, true, "\006chrome\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {17, true, "\004docs\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {18, true, "\005sites\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {25, true, "\014spreadsheets\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {22, false, "\011appengine\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {22, true, "\011encrypted\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {21, true, "\010accounts\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {21, true, "\010profiles\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {17, true, "\004mail\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {23, true, "\012talkgadget\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {17, true, "\004talk\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {29, true, "\020hostedtalkgadget\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {17, true, "\004plus\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {25, true, "\004plus\007sandbox\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {19, true, "\006script\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {20, true, "\007history\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {21, true, "\010security\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {20, true, "\006market\007android\003com", true, kGooglePins, DOMAIN_ANDROID_COM },
-  {26, true, "\003ssl\020google-analytics\003com", true, kGooglePins, DOMAIN_GOOGLE_ANALYTICS_COM },
-  {18, true, "\005drive\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {16, true, "\012googleplex\003com", true, kGooglePins, DOMAIN_GOOGLEPLEX_COM },
-  {19, true, "\006groups\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {17, true, "\004apis\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {32, true, "\022chromiumcodereview\007appspot\003com", true, kGooglePins, DOMAIN_APPSPOT_COM },
-  {38, true, "\030chrome-devtools-frontend\007appspot\003com", true, kGooglePins, DOMAIN_APPSPOT_COM },
-  {24, true, "\012codereview\007appspot\003com", true, kGooglePins, DOMAIN_APPSPOT_COM },
-  {25, true, "\012codereview\010chromium\003org", true, kGooglePins, DOMAIN_CHROMIUM_ORG },
-  {17, true, "\004code\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {16, true, "\012googlecode\003com", false, kGooglePins, DOMAIN_GOOGLECODE_COM },
-  {15, true, "\002dl\006google\003com", true, kGooglePins, DOMAIN_GOOGLE_COM },
-  {26, true, "\011translate\012googleapis\003com", true, kGooglePins, DOMAIN_GOOGLEAPIS_COM },
-  {23, true, "\005chart\004apis\006google\003com", false, kGooglePins, DOMAIN_GOOGLE_COM },
-  {28, true, "\012oraprodsso\004corp\006google\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {27, true, "\011oraprodmv\004corp\006google\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\005ytimg\003com", false, kGooglePins, DOMAIN_YTIMG_COM },
-  {23, true, "\021googleusercontent\003com", false, kGooglePins, DOMAIN_GOOGLEUSERCONTENT_COM },
-  {13, true, "\007youtube\003com", false, kGooglePins, DOMAIN_YOUTUBE_COM },
-  {16, true, "\012googleapis\003com", false, kGooglePins, DOMAIN_GOOGLEAPIS_COM },
-  {22, true, "\020googleadservices\003com", false, kGooglePins, DOMAIN_GOOGLEADSERVICES_COM },
-  {13, true, "\007appspot\003com", false, kGooglePins, DOMAIN_APPSPOT_COM },
-  {23, true, "\021googlesyndication\003com", false, kGooglePins, DOMAIN_GOOGLESYNDICATION_COM },
-  {17, true, "\013doubleclick\003net", false, kGooglePins, DOMAIN_DOUBLECLICK_NET },
-  {17, true, "\003ssl\007gstatic\003com", false, kGooglePins, DOMAIN_GSTATIC_COM },
-  {10, true, "\005youtu\002be", false, kGooglePins, DOMAIN_YOUTU_BE },
-  {13, true, "\007android\003com", false, kGooglePins, DOMAIN_ANDROID_COM },
-  {20, true, "\016googlecommerce\003com", false, kGooglePins, DOMAIN_GOOGLECOMMERCE_COM },
-  {12, true, "\006urchin\003com", false, kGooglePins, DOMAIN_URCHIN_COM },
-  {8, true, "\003goo\002gl", false, kGooglePins, DOMAIN_GOO_GL },
-  {6, true, "\001g\002co", false, kGooglePins, DOMAIN_G_CO },
-  {11, true, "\006google\002ac", false, kGooglePins, DOMAIN_GOOGLE_AC },
-  {11, true, "\006google\002ad", false, kGooglePins, DOMAIN_GOOGLE_AD },
-  {11, true, "\006google\002ae", false, kGooglePins, DOMAIN_GOOGLE_AE },
-  {11, true, "\006google\002af", false, kGooglePins, DOMAIN_GOOGLE_AF },
-  {11, true, "\006google\002ag", false, kGooglePins, DOMAIN_GOOGLE_AG },
-  {11, true, "\006google\002am", false, kGooglePins, DOMAIN_GOOGLE_AM },
-  {11, true, "\006google\002as", false, kGooglePins, DOMAIN_GOOGLE_AS },
-  {11, true, "\006google\002at", false, kGooglePins, DOMAIN_GOOGLE_AT },
-  {11, true, "\006google\002az", false, kGooglePins, DOMAIN_GOOGLE_AZ },
-  {11, true, "\006google\002ba", false, kGooglePins, DOMAIN_GOOGLE_BA },
-  {11, true, "\006google\002be", false, kGooglePins, DOMAIN_GOOGLE_BE },
-  {11, true, "\006google\002bf", false, kGooglePins, DOMAIN_GOOGLE_BF },
-  {11, true, "\006google\002bg", false, kGooglePins, DOMAIN_GOOGLE_BG },
-  {11, true, "\006google\002bi", false, kGooglePins, DOMAIN_GOOGLE_BI },
-  {11, true, "\006google\002bj", false, kGooglePins, DOMAIN_GOOGLE_BJ },
-  {11, true, "\006google\002bs", false, kGooglePins, DOMAIN_GOOGLE_BS },
-  {11, true, "\006google\002by", false, kGooglePins, DOMAIN_GOOGLE_BY },
-  {11, true, "\006google\002ca", false, kGooglePins, DOMAIN_GOOGLE_CA },
-  {12, true, "\006google\003cat", false, kGooglePins, DOMAIN_GOOGLE_CAT },
-  {11, true, "\006google\002cc", false, kGooglePins, DOMAIN_GOOGLE_CC },
-  {11, true, "\006google\002cd", false, kGooglePins, DOMAIN_GOOGLE_CD },
-  {11, true, "\006google\002cf", false, kGooglePins, DOMAIN_GOOGLE_CF },
-  {11, true, "\006google\002cg", false, kGooglePins, DOMAIN_GOOGLE_CG },
-  {11, true, "\006google\002ch", false, kGooglePins, DOMAIN_GOOGLE_CH },
-  {11, true, "\006google\002ci", false, kGooglePins, DOMAIN_GOOGLE_CI },
-  {11, true, "\006google\002cl", false, kGooglePins, DOMAIN_GOOGLE_CL },
-  {11, true, "\006google\002cm", false, kGooglePins, DOMAIN_GOOGLE_CM },
-  {11, true, "\006google\002cn", false, kGooglePins, DOMAIN_GOOGLE_CN },
-  {14, true, "\006google\002co\002ao", false, kGooglePins, DOMAIN_CO_AO },
-  {14, true, "\006google\002co\002bw", false, kGooglePins, DOMAIN_CO_BW },
-  {14, true, "\006google\002co\002ck", false, kGooglePins, DOMAIN_CO_CK },
-  {14, true, "\006google\002co\002cr", false, kGooglePins, DOMAIN_CO_CR },
-  {14, true, "\006google\002co\002hu", false, kGooglePins, DOMAIN_CO_HU },
-  {14, true, "\006google\002co\002id", false, kGooglePins, DOMAIN_CO_ID },
-  {14, true, "\006google\002co\002il", false, kGooglePins, DOMAIN_CO_IL },
-  {14, true, "\006google\002co\002im", false, kGooglePins, DOMAIN_CO_IM },
-  {14, true, "\006google\002co\002in", false, kGooglePins, DOMAIN_CO_IN },
-  {14, true, "\006google\002co\002je", false, kGooglePins, DOMAIN_CO_JE },
-  {14, true, "\006google\002co\002jp", false, kGooglePins, DOMAIN_CO_JP },
-  {14, true, "\006google\002co\002ke", false, kGooglePins, DOMAIN_CO_KE },
-  {14, true, "\006google\002co\002kr", false, kGooglePins, DOMAIN_CO_KR },
-  {14, true, "\006google\002co\002ls", false, kGooglePins, DOMAIN_CO_LS },
-  {14, true, "\006google\002co\002ma", false, kGooglePins, DOMAIN_CO_MA },
-  {14, true, "\006google\002co\002mz", false, kGooglePins, DOMAIN_CO_MZ },
-  {14, true, "\006google\002co\002nz", false, kGooglePins, DOMAIN_CO_NZ },
-  {14, true, "\006google\002co\002th", false, kGooglePins, DOMAIN_CO_TH },
-  {14, true, "\006google\002co\002tz", false, kGooglePins, DOMAIN_CO_TZ },
-  {14, true, "\006google\002co\002ug", false, kGooglePins, DOMAIN_CO_UG },
-  {14, true, "\006google\002co\002uk", false, kGooglePins, DOMAIN_CO_UK },
-  {14, true, "\006google\002co\002uz", false, kGooglePins, DOMAIN_CO_UZ },
-  {14, true, "\006google\002co\002ve", false, kGooglePins, DOMAIN_CO_VE },
-  {14, true, "\006google\002co\002vi", false, kGooglePins, DOMAIN_CO_VI },
-  {14, true, "\006google\002co\002za", false, kGooglePins, DOMAIN_CO_ZA },
-  {14, true, "\006google\002co\002zm", false, kGooglePins, DOMAIN_CO_ZM },
-  {14, true, "\006google\002co\002zw", false, kGooglePins, DOMAIN_CO_ZW },
-  {15, true, "\006google\003com\002af", false, kGooglePins, DOMAIN_COM_AF },
-  {15, true, "\006google\003com\002ag", false, kGooglePins, DOMAIN_COM_AG },
-  {15, true, "\006google\003com\002ai", false, kGooglePins, DOMAIN_COM_AI },
-  {15, true, "\006google\003com\002ar", false, kGooglePins, DOMAIN_COM_AR },
-  {15, true, "\006google\003com\002au", false, kGooglePins, DOMAIN_COM_AU },
-  {15, true, "\006google\003com\002bd", false, kGooglePins, DOMAIN_COM_BD },
-  {15, true, "\006google\003com\002bh", false, kGooglePins, DOMAIN_COM_BH },
-  {15, true, "\006google\003com\002bn", false, kGooglePins, DOMAIN_COM_BN },
-  {15, true, "\006google\003com\002bo", false, kGooglePins, DOMAIN_COM_BO },
-  {15, true, "\006google\003com\002br", false, kGooglePins, DOMAIN_COM_BR },
-  {15, true, "\006google\003com\002by", false, kGooglePins, DOMAIN_COM_BY },
-  {15, true, "\006google\003com\002bz", false, kGooglePins, DOMAIN_COM_BZ },
-  {15, true, "\006google\003com\002cn", false, kGooglePins, DOMAIN_COM_CN },
-  {15, true, "\006google\003com\002co", false, kGooglePins, DOMAIN_COM_CO },
-  {15, true, "\006google\003com\002cu", false, kGooglePins, DOMAIN_COM_CU },
-  {15, true, "\006google\003com\002cy", false, kGooglePins, DOMAIN_COM_CY },
-  {15, true, "\006google\003com\002do", false, kGooglePins, DOMAIN_COM_DO },
-  {15, true, "\006google\003com\002ec", false, kGooglePins, DOMAIN_COM_EC },
-  {15, true, "\006google\003com\002eg", false, kGooglePins, DOMAIN_COM_EG },
-  {15, true, "\006google\003com\002et", false, kGooglePins, DOMAIN_COM_ET },
-  {15, true, "\006google\003com\002fj", false, kGooglePins, DOMAIN_COM_FJ },
-  {15, true, "\006google\003com\002ge", false, kGooglePins, DOMAIN_COM_GE },
-  {15, true, "\006google\003com\002gh", false, kGooglePins, DOMAIN_COM_GH },
-  {15, true, "\006google\003com\002gi", false, kGooglePins, DOMAIN_COM_GI },
-  {15, true, "\006google\003com\002gr", false, kGooglePins, DOMAIN_COM_GR },
-  {15, true, "\006google\003com\002gt", false, kGooglePins, DOMAIN_COM_GT },
-  {15, true, "\006google\003com\002hk", false, kGooglePins, DOMAIN_COM_HK },
-  {15, true, "\006google\003com\002iq", false, kGooglePins, DOMAIN_COM_IQ },
-  {15, true, "\006google\003com\002jm", false, kGooglePins, DOMAIN_COM_JM },
-  {15, true, "\006google\003com\002jo", false, kGooglePins, DOMAIN_COM_JO },
-  {15, true, "\006google\003com\002kh", false, kGooglePins, DOMAIN_COM_KH },
-  {15, true, "\006google\003com\002kw", false, kGooglePins, DOMAIN_COM_KW },
-  {15, true, "\006google\003com\002lb", false, kGooglePins, DOMAIN_COM_LB },
-  {15, true, "\006google\003com\002ly", false, kGooglePins, DOMAIN_COM_LY },
-  {15, true, "\006google\003com\002mt", false, kGooglePins, DOMAIN_COM_MT },
-  {15, true, "\006google\003com\002mx", false, kGooglePins, DOMAIN_COM_MX },
-  {15, true, "\006google\003com\002my", false, kGooglePins, DOMAIN_COM_MY },
-  {15, true, "\006google\003com\002na", false, kGooglePins, DOMAIN_COM_NA },
-  {15, true, "\006google\003com\002nf", false, kGooglePins, DOMAIN_COM_NF },
-  {15, true, "\006google\003com\002ng", false, kGooglePins, DOMAIN_COM_NG },
-  {15, true, "\006google\003com\002ni", false, kGooglePins, DOMAIN_COM_NI },
-  {15, true, "\006google\003com\002np", false, kGooglePins, DOMAIN_COM_NP },
-  {15, true, "\006google\003com\002nr", false, kGooglePins, DOMAIN_COM_NR },
-  {15, true, "\006google\003com\002om", false, kGooglePins, DOMAIN_COM_OM },
-  {15, true, "\006google\003com\002pa", false, kGooglePins, DOMAIN_COM_PA },
-  {15, true, "\006google\003com\002pe", false, kGooglePins, DOMAIN_COM_PE },
-  {15, true, "\006google\003com\002ph", false, kGooglePins, DOMAIN_COM_PH },
-  {15, true, "\006google\003com\002pk", false, kGooglePins, DOMAIN_COM_PK },
-  {15, true, "\006google\003com\002pl", false, kGooglePins, DOMAIN_COM_PL },
-  {15, true, "\006google\003com\002pr", false, kGooglePins, DOMAIN_COM_PR },
-  {15, true, "\006google\003com\002py", false, kGooglePins, DOMAIN_COM_PY },
-  {15, true, "\006google\003com\002qa", false, kGooglePins, DOMAIN_COM_QA },
-  {15, true, "\006google\003com\002ru", false, kGooglePins, DOMAIN_COM_RU },
-  {15, true, "\006google\003com\002sa", false, kGooglePins, DOMAIN_COM_SA },
-  {15, true, "\006google\003com\002sb", false, kGooglePins, DOMAIN_COM_SB },
-  {15, true, "\006google\003com\002sg", false, kGooglePins, DOMAIN_COM_SG },
-  {15, true, "\006google\003com\002sl", false, kGooglePins, DOMAIN_COM_SL },
-  {15, true, "\006google\003com\002sv", false, kGooglePins, DOMAIN_COM_SV },
-  {15, true, "\006google\003com\002tj", false, kGooglePins, DOMAIN_COM_TJ },
-  {15, true, "\006google\003com\002tn", false, kGooglePins, DOMAIN_COM_TN },
-  {15, true, "\006google\003com\002tr", false, kGooglePins, DOMAIN_COM_TR },
-  {15, true, "\006google\003com\002tw", false, kGooglePins, DOMAIN_COM_TW },
-  {15, true, "\006google\003com\002ua", false, kGooglePins, DOMAIN_COM_UA },
-  {15, true, "\006google\003com\002uy", false, kGooglePins, DOMAIN_COM_UY },
-  {15, true, "\006google\003com\002vc", false, kGooglePins, DOMAIN_COM_VC },
-  {15, true, "\006google\003com\002ve", false, kGooglePins, DOMAIN_COM_VE },
-  {15, true, "\006google\003com\002vn", false, kGooglePins, DOMAIN_COM_VN },
-  {11, true, "\006google\002cv", false, kGooglePins, DOMAIN_GOOGLE_CV },
-  {11, true, "\006google\002cz", false, kGooglePins, DOMAIN_GOOGLE_CZ },
-  {11, true, "\006google\002de", false, kGooglePins, DOMAIN_GOOGLE_DE },
-  {11, true, "\006google\002dj", false, kGooglePins, DOMAIN_GOOGLE_DJ },
-  {11, true, "\006google\002dk", false, kGooglePins, DOMAIN_GOOGLE_DK },
-  {11, true, "\006google\002dm", false, kGooglePins, DOMAIN_GOOGLE_DM },
-  {11, true, "\006google\002dz", false, kGooglePins, DOMAIN_GOOGLE_DZ },
-  {11, true, "\006google\002ee", false, kGooglePins, DOMAIN_GOOGLE_EE },
-  {11, true, "\006google\002es", false, kGooglePins, DOMAIN_GOOGLE_ES },
-  {11, true, "\006google\002fi", false, kGooglePins, DOMAIN_GOOGLE_FI },
-  {11, true, "\006google\002fm", false, kGooglePins, DOMAIN_GOOGLE_FM },
-  {11, true, "\006google\002fr", false, kGooglePins, DOMAIN_GOOGLE_FR },
-  {11, true, "\006google\002ga", false, kGooglePins, DOMAIN_GOOGLE_GA },
-  {11, true, "\006google\002ge", false, kGooglePins, DOMAIN_GOOGLE_GE },
-  {11, true, "\006google\002gg", false, kGooglePins, DOMAIN_GOOGLE_GG },
-  {11, true, "\006google\002gl", false, kGooglePins, DOMAIN_GOOGLE_GL },
-  {11, true, "\006google\002gm", false, kGooglePins, DOMAIN_GOOGLE_GM },
-  {11, true, "\006google\002gp", false, kGooglePins, DOMAIN_GOOGLE_GP },
-  {11, true, "\006google\002gr", false, kGooglePins, DOMAIN_GOOGLE_GR },
-  {11, true, "\006google\002gy", false, kGooglePins, DOMAIN_GOOGLE_GY },
-  {11, true, "\006google\002hk", false, kGooglePins, DOMAIN_GOOGLE_HK },
-  {11, true, "\006google\002hn", false, kGooglePins, DOMAIN_GOOGLE_HN },
-  {11, true, "\006google\002hr", false, kGooglePins, DOMAIN_GOOGLE_HR },
-  {11, true, "\006google\002ht", false, kGooglePins, DOMAIN_GOOGLE_HT },
-  {11, true, "\006google\002hu", false, kGooglePins, DOMAIN_GOOGLE_HU },
-  {11, true, "\006google\002ie", false, kGooglePins, DOMAIN_GOOGLE_IE },
-  {11, true, "\006google\002im", false, kGooglePins, DOMAIN_GOOGLE_IM },
-  {13, true, "\006google\004info", false, kGooglePins, DOMAIN_GOOGLE_INFO },
-  {11, true, "\006google\002iq", false, kGooglePins, DOMAIN_GOOGLE_IQ },
-  {11, true, "\006google\002is", false, kGooglePins, DOMAIN_GOOGLE_IS },
-  {11, true, "\006google\002it", false, kGooglePins, DOMAIN_GOOGLE_IT },
-  {14, true, "\006google\002it\002ao", false, kGooglePins, DOMAIN_IT_AO },
-  {11, true, "\006google\002je", false, kGooglePins, DOMAIN_GOOGLE_JE },
-  {11, true, "\006google\002jo", false, kGooglePins, DOMAIN_GOOGLE_JO },
-  {13, true, "\006google\004jobs", false, kGooglePins, DOMAIN_GOOGLE_JOBS },
-  {11, true, "\006google\002jp", false, kGooglePins, DOMAIN_GOOGLE_JP },
-  {11, true, "\006google\002kg", false, kGooglePins, DOMAIN_GOOGLE_KG },
-  {11, true, "\006google\002ki", false, kGooglePins, DOMAIN_GOOGLE_KI },
-  {11, true, "\006google\002kz", false, kGooglePins, DOMAIN_GOOGLE_KZ },
-  {11, true, "\006google\002la", false, kGooglePins, DOMAIN_GOOGLE_LA },
-  {11, true, "\006google\002li", false, kGooglePins, DOMAIN_GOOGLE_LI },
-  {11, true, "\006google\002lk", false, kGooglePins, DOMAIN_GOOGLE_LK },
-  {11, true, "\006google\002lt", false, kGooglePins, DOMAIN_GOOGLE_LT },
-  {11, true, "\006google\002lu", false, kGooglePins, DOMAIN_GOOGLE_LU },
-  {11, true, "\006google\002lv", false, kGooglePins, DOMAIN_GOOGLE_LV },
-  {11, true, "\006google\002md", false, kGooglePins, DOMAIN_GOOGLE_MD },
-  {11, true, "\006google\002me", false, kGooglePins, DOMAIN_GOOGLE_ME },
-  {11, true, "\006google\002mg", false, kGooglePins, DOMAIN_GOOGLE_MG },
-  {11, true, "\006google\002mk", false, kGooglePins, DOMAIN_GOOGLE_MK },
-  {11, true, "\006google\002ml", false, kGooglePins, DOMAIN_GOOGLE_ML },
-  {11, true, "\006google\002mn", false, kGooglePins, DOMAIN_GOOGLE_MN },
-  {11, true, "\006google\002ms", false, kGooglePins, DOMAIN_GOOGLE_MS },
-  {11, true, "\006google\002mu", false, kGooglePins, DOMAIN_GOOGLE_MU },
-  {11, true, "\006google\002mv", false, kGooglePins, DOMAIN_GOOGLE_MV },
-  {11, true, "\006google\002mw", false, kGooglePins, DOMAIN_GOOGLE_MW },
-  {11, true, "\006google\002ne", false, kGooglePins, DOMAIN_GOOGLE_NE },
-  {14, true, "\006google\002ne\002jp", false, kGooglePins, DOMAIN_NE_JP },
-  {12, true, "\006google\003net", false, kGooglePins, DOMAIN_GOOGLE_NET },
-  {11, true, "\006google\002nl", false, kGooglePins, DOMAIN_GOOGLE_NL },
-  {11, true, "\006google\002no", false, kGooglePins, DOMAIN_GOOGLE_NO },
-  {11, true, "\006google\002nr", false, kGooglePins, DOMAIN_GOOGLE_NR },
-  {11, true, "\006google\002nu", false, kGooglePins, DOMAIN_GOOGLE_NU },
-  {15, true, "\006google\003off\002ai", false, kGooglePins, DOMAIN_OFF_AI },
-  {11, true, "\006google\002pk", false, kGooglePins, DOMAIN_GOOGLE_PK },
-  {11, true, "\006google\002pl", false, kGooglePins, DOMAIN_GOOGLE_PL },
-  {11, true, "\006google\002pn", false, kGooglePins, DOMAIN_GOOGLE_PN },
-  {11, true, "\006google\002ps", false, kGooglePins, DOMAIN_GOOGLE_PS },
-  {11, true, "\006google\002pt", false, kGooglePins, DOMAIN_GOOGLE_PT },
-  {11, true, "\006google\002ro", false, kGooglePins, DOMAIN_GOOGLE_RO },
-  {11, true, "\006google\002rs", false, kGooglePins, DOMAIN_GOOGLE_RS },
-  {11, true, "\006google\002ru", false, kGooglePins, DOMAIN_GOOGLE_RU },
-  {11, true, "\006google\002rw", false, kGooglePins, DOMAIN_GOOGLE_RW },
-  {11, true, "\006google\002sc", false, kGooglePins, DOMAIN_GOOGLE_SC },
-  {11, true, "\006google\002se", false, kGooglePins, DOMAIN_GOOGLE_SE },
-  {11, true, "\006google\002sh", false, kGooglePins, DOMAIN_GOOGLE_SH },
-  {11, true, "\006google\002si", false, kGooglePins, DOMAIN_GOOGLE_SI },
-  {11, true, "\006google\002sk", false, kGooglePins, DOMAIN_GOOGLE_SK },
-  {11, true, "\006google\002sm", false, kGooglePins, DOMAIN_GOOGLE_SM },
-  {11, true, "\006google\002sn", false, kGooglePins, DOMAIN_GOOGLE_SN },
-  {11, true, "\006google\002so", false, kGooglePins, DOMAIN_GOOGLE_SO },
-  {11, true, "\006google\002st", false, kGooglePins, DOMAIN_GOOGLE_ST },
-  {11, true, "\006google\002td", false, kGooglePins, DOMAIN_GOOGLE_TD },
-  {11, true, "\006google\002tg", false, kGooglePins, DOMAIN_GOOGLE_TG },
-  {11, true, "\006google\002tk", false, kGooglePins, DOMAIN_GOOGLE_TK },
-  {11, true, "\006google\002tl", false, kGooglePins, DOMAIN_GOOGLE_TL },
-  {11, true, "\006google\002tm", false, kGooglePins, DOMAIN_GOOGLE_TM },
-  {11, true, "\006google\002tn", false, kGooglePins, DOMAIN_GOOGLE_TN },
-  {11, true, "\006google\002to", false, kGooglePins, DOMAIN_GOOGLE_TO },
-  {11, true, "\006google\002tp", false, kGooglePins, DOMAIN_GOOGLE_TP },
-  {11, true, "\006google\002tt", false, kGooglePins, DOMAIN_GOOGLE_TT },
-  {11, true, "\006google\002us", false, kGooglePins, DOMAIN_GOOGLE_US },
-  {11, true, "\006google\002uz", false, kGooglePins, DOMAIN_GOOGLE_UZ },
-  {11, true, "\006google\002vg", false, kGooglePins, DOMAIN_GOOGLE_VG },
-  {11, true, "\006google\002vu", false, kGooglePins, DOMAIN_GOOGLE_VU },
-  {11, true, "\006google\002ws", false, kGooglePins, DOMAIN_GOOGLE_WS },
-  {23, true, "\005learn\013doubleclick\003net", false, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\003www\006paypal\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\006paypal\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\003www\006elanex\003biz", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006jottit\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\015sunshinepress\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, false, "\003www\013noisebridge\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, false, "\004neg9\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006riseup\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, false, "\006factor\002cc", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\007members\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\007support\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\002id\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, true, "\005lists\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\007webmail\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {24, true, "\011roundcube\010mayfirst\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {28, false, "\016aladdinschools\007appspot\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\011ottospora\002nl", true, kNoPins, DOMAIN_NOT_PINNED },
-  {25, false, "\003www\017paycheckrecords\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\010lastpass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\003www\010lastpass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\010keyerror\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\010entropia\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003www\010entropia\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\005romab\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\012logentries\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\003www\012logentries\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006stripe\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {27, true, "\025cloudsecurityalliance\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\005login\004sapo\002pt", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\015mattmccutchen\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\006betnet\002fr", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\010uprotect\002it", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\010squareup\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006square\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, true, "\004cert\002se", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\006crypto\002is", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, true, "\005simon\007butcher\004name", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\004linx\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007dropcam\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003www\007dropcam\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {30, true, "\010ebanking\014indovinabank\003com\002vn", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007epoxate\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\012torproject\003org", true, kTorPins, DOMAIN_TORPROJECT_ORG },
-  {21, true, "\004blog\012torproject\003org", true, kTorPins, DOMAIN_TORPROJECT_ORG },
-  {22, true, "\005check\012torproject\003org", true, kTorPins, DOMAIN_TORPROJECT_ORG },
-  {20, true, "\003www\012torproject\003org", true, kTorPins, DOMAIN_TORPROJECT_ORG },
-  {21, true, "\004dist\012torproject\003org", true, kTorPins, DOMAIN_TORPROJECT_ORG },
-  {22, true, "\003www\014moneybookers\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\013ledgerscope\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, false, "\003www\013ledgerscope\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\003app\007recurly\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\003api\007recurly\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007greplin\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003www\007greplin\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {27, true, "\006luneta\016nearbuysystems\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006ubertt\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, true, "\004pixi\002me", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\010grepular\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\003www\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {26, false, "\011developer\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {30, false, "\003www\011developer\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {24, false, "\007sandbox\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {28, false, "\003www\007sandbox\012mydigipass\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\006crypto\003cat", true, kCryptoCatPins, DOMAIN_CRYPTO_CAT },
-  {25, true, "\014bigshinylock\006minazo\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\005crate\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007twitter\003com", true, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {17, true, "\003www\007twitter\003com", true, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {17, true, "\003api\007twitter\003com", false, kTwitterCDNPins, DOMAIN_TWITTER_COM },
-  {19, true, "\005oauth\007twitter\003com", false, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {20, true, "\006mobile\007twitter\003com", false, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {17, true, "\003dev\007twitter\003com", false, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {22, true, "\010business\007twitter\003com", false, kTwitterComPins, DOMAIN_TWITTER_COM },
-  {22, true, "\010platform\007twitter\003com", false, kTwitterCDNPins, DOMAIN_TWITTER_COM },
-  {15, true, "\003si0\005twimg\003com", false, kTwitterCDNPins, DOMAIN_TWIMG_COM },
-  {23, true, "\010twimg0-a\010akamaihd\003net", false, kTwitterCDNPins, DOMAIN_AKAMAIHD_NET },
-  {22, true, "\020braintreegateway\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {23, false, "\021braintreepayments\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {27, false, "\003www\021braintreepayments\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {24, false, "\022emailprivacytester\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\007tor2web\003org", false, kTor2webPins, DOMAIN_TOR2WEB_ORG },
-  {25, true, "\010business\007medbank\003com\002mt", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\005arivo\003com\002br", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\003www\013apollo-auto\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\003www\005cueup\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, false, "\005jitsi\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\003www\005jitsi\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\010download\005jitsi\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {8, true, "\003sol\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\010irccloud\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\003www\010irccloud\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\005alpha\010irccloud\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\006passwd\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\011browserid\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\005login\007persona\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007neonisi\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\003www\007neonisi\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\005shops\007neonisi\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\014piratenlogin\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\011howrandom\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\010intercom\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003api\010intercom\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003www\010intercom\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\010fatzebra\003com\002au", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\007csawctf\004poly\003edu", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\014makeyourlaws\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, false, "\003www\014makeyourlaws\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\003iop\006intuit\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\010surfeasy\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\003www\010surfeasy\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\011packagist\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007lookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\003www\007lookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\011mylookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, false, "\003www\011mylookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\002dm\007lookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\002dm\011mylookout\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\011itriskltd\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\012stocktrade\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\011openshift\006redhat\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\014therapynotes\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, false, "\003www\014therapynotes\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, true, "\003wiz\003biz", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\002my\006onlime\002ch", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\007webmail\006onlime\002ch", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\003crm\006onlime\002ch", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\003www\003gov\002uk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\014silentcircle\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\014silentcircle\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\015serverdensity\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\002my\010alfresco\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\007webmail\010gigahost\002dk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\007paymill\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\007paymill\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\012gocardless\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\005espra\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\005zoo24\002de", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\004mega\002co\002nz", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\003api\004mega\002co\002nz", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\007lockify\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\010writeapp\002me", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\010bugzilla\007mozilla\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {30, true, "\007members\020nearlyfreespeech\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, false, "\003ssl\011panoramio\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\007kiwiirc\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\003pay\010gigahost\002dk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {27, true, "\015controlcenter\010gigahost\002dk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\006simple\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\003www\006simple\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\002fj\006simple\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\003api\006simple\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\004bank\006simple\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\005bassh\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\004sah3\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, false, "\003grc\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, false, "\003www\003grc\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, false, "\003www\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\007manager\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, false, "\004blog\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {20, false, "\007library\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\005forum\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\001p\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, false, "\005paste\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, false, "\010pastebin\006linode\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\017inertianetworks\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, false, "\010carezone\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\011conformal\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\012cyphertite\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\010logotype\002se", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\004bccx\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, true, "\011launchkey\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\010carlolly\002co\002uk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\003www\013cyveillance\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\004blog\013cyveillance\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006whonix\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\010blueseed\002co", true, kNoPins, DOMAIN_NOT_PINNED },
-  {26, true, "\005forum\016quantifiedself\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {11, true, "\006shodan\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\015rapidresearch\002me", true, kNoPins, DOMAIN_NOT_PINNED },
-  {14, true, "\010surkatty\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\017securityheaders\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {10, true, "\005haste\002ch", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\007mudcrab\002us", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\010mediacru\002sh", true, kNoPins, DOMAIN_NOT_PINNED },
-  {13, true, "\010lolicore\002ch", true, kNoPins, DOMAIN_NOT_PINNED },
-  {16, true, "\007cloudns\003com\002au", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\005oplop\007appspot\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, false, "\006bcrook\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\004wiki\006python\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, false, "\004lumi\002do", true, kNoPins, DOMAIN_NOT_PINNED },
-  {22, true, "\020appseccalifornia\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\013crowdcurity\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {19, true, "\013saturngames\002co\002uk", true, kNoPins, DOMAIN_NOT_PINNED },
-  {23, true, "\021strongest-privacy\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {25, true, "\011ecosystem\011atlassian\003net", true, kNoPins, DOMAIN_NOT_PINNED },
-  {18, true, "\002id\011atlassian\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\011bitbucket\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\007cupcake\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\007cupcake\002is", true, kNoPins, DOMAIN_NOT_PINNED },
-  {9, true, "\004tent\002io", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006cybozu\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {17, true, "\013davidlyness\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {12, true, "\006medium\003com", true, kNoPins, DOMAIN_NOT_PINNED },
-  {21, true, "\007liberty\007lavabit\003com", true, kLavabitPins, DOMAIN_LAVABIT_COM },
-  {16, true, "\012getlantern\003org", true, kNoPins, DOMAIN_NOT_PINNED },
-  {15, false, "\011kinsights\003com", true, kNoPins, DOMAIN_NOT_PINNED },
+// Indexed by HSTSPreload.pins.
+static const struct PublicKeyPins kPinsets[] = {
+  kNoPins,
+  kTestPins,
+  kGooglePins,
+  kTorPins,
+  kTwitterComPins,
+  kTwitterCDNPins,
+  kTor2webPins,
+  kCryptoCatPins,
+  kLavabitPins,
 };
-static const size_t kNumPreloadedSTS = ARRAYSIZE_UNSAFE(kPreloadedSTS);
-
-static const struct HSTSPreload kPreloadedSNISTS[] = {
-  {11, false, "\005gmail\003com", true, kGooglePins, DOMAIN_GMAIL_COM },
-  {16, false, "\012googlemail\003com", true, kGooglePins, DOMAIN_GOOGLEMAIL_COM },
-  {15, false, "\003www\005gmail\003com", true, kGooglePins, DOMAIN_GMAIL_COM },
-  {20, false, "\003www\012googlemail\003com", true, kGooglePins, DOMAIN_GOOGLEMAIL_COM },
-  {22, true, "\020google-analytics\003com", false, kGooglePins, DOMAIN_GOOGLE_ANALYTICS_COM },
-  {18, true, "\014googlegroups\003com", false, kGooglePins, DOMAIN_GOOGLEGROUPS_COM },
+
+static const struct HSTSPreload kHSTSPreloads[] = {
+  { true, false, false, 1, DOMAIN_APPSPOT_COM },  // pinningtest.appspot.com
+  { true, false, false, 2, DOMAIN_GOOGLE_COM },  // google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // wallet.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // checkout.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // chrome.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // docs.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // sites.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // spreadsheets.google.com
+  { false, true, false, 2, DOMAIN_GOOGLE_COM },  // appengine.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // encrypted.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // accounts.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // profiles.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // mail.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // talkgadget.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // talk.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // hostedtalkgadget.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // plus.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // plus.sandbox.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // script.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // history.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // security.google.com
+  { true, true, false, 2, DOMAIN_ANDROID_COM },  // market.android.com
+  { true, true, false, 2, DOMAIN_GOOGLE_ANALYTICS_COM },  // ssl.google-analytics.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // drive.google.com
+  { true, true, false, 2, DOMAIN_GOOGLEPLEX_COM },  // googleplex.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // groups.google.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // apis.google.com
+  { true, true, false, 2, DOMAIN_APPSPOT_COM },  // chromiumcodereview.appspot.com
+  { true, true, false, 2, DOMAIN_APPSPOT_COM },  // chrome-devtools-frontend.appspot.com
+  { true, true, false, 2, DOMAIN_APPSPOT_COM },  // codereview.appspot.com
+  { true, true, false, 2, DOMAIN_CHROMIUM_ORG },  // codereview.chromium.org
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // code.google.com
+  { true, false, false, 2, DOMAIN_GOOGLECODE_COM },  // googlecode.com
+  { true, true, false, 2, DOMAIN_GOOGLE_COM },  // dl.google.com
+  { true, true, false, 2, DOMAIN_GOOGLEAPIS_COM },  // translate.googleapis.com
+  { true, false, false, 2, DOMAIN_GOOGLE_COM },  // chart.apis.google.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // oraprodsso.corp.google.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // oraprodmv.corp.google.com
+  { true, false, false, 2, DOMAIN_YTIMG_COM },  // ytimg.com
+  { true, false, false, 2, DOMAIN_GOOGLEUSERCONTENT_COM },  // googleusercontent.com
+  { true, false, false, 2, DOMAIN_YOUTUBE_COM },  // youtube.com
+  { true, false, false, 2, DOMAIN_GOOGLEAPIS_COM },  // googleapis.com
+  { true, false, false, 2, DOMAIN_GOOGLEADSERVICES_COM },  // googleadservices.com
+  { true, false, false, 2, DOMAIN_APPSPOT_COM },  // appspot.com
+  { true, false, false, 2, DOMAIN_GOOGLESYNDICATION_COM },  // googlesyndication.com
+  { true, false, false, 2, DOMAIN_DOUBLECLICK_NET },  // doubleclick.net
+  { true, false, false, 2, DOMAIN_GSTATIC_COM },  // ssl.gstatic.com
+  { true, false, false, 2, DOMAIN_YOUTU_BE },  // youtu.be
+  { true, false, false, 2, DOMAIN_ANDROID_COM },  // android.com
+  { true, false, false, 2, DOMAIN_GOOGLECOMMERCE_COM },  // googlecommerce.com
+  { true, false, false, 2, DOMAIN_URCHIN_COM },  // urchin.com
+  { true, false, false, 2, DOMAIN_GOO_GL },  // goo.gl
+  { true, false, false, 2, DOMAIN_G_CO },  // g.co
+  { true, false, false, 2, DOMAIN_GOOGLE_AC },  // google.ac
+  { true, false, false, 2, DOMAIN_GOOGLE_AD },  // google.ad
+  { true, false, false, 2, DOMAIN_GOOGLE_AE },  // google.ae
+  { true, false, false, 2, DOMAIN_GOOGLE_AF },  // google.af
+  { true, false, false, 2, DOMAIN_GOOGLE_AG },  // google.ag
+  { true, false, false, 2, DOMAIN_GOOGLE_AM },  // google.am
+  { true, false, false, 2, DOMAIN_GOOGLE_AS },  // google.as
+  { true, false, false, 2, DOMAIN_GOOGLE_AT },  // google.at
+  { true, false, false, 2, DOMAIN_GOOGLE_AZ },  // google.az
+  { true, false, false, 2, DOMAIN_GOOGLE_BA },  // google.ba
+  { true, false, false, 2, DOMAIN_GOOGLE_BE },  // google.be
+  { true, false, false, 2, DOMAIN_GOOGLE_BF },  // google.bf
+  { true, false, false, 2, DOMAIN_GOOGLE_BG },  // google.bg
+  { true, false, false, 2, DOMAIN_GOOGLE_BI },  // google.bi
+  { true, false, false, 2, DOMAIN_GOOGLE_BJ },  // google.bj
+  { true, false, false, 2, DOMAIN_GOOGLE_BS },  // google.bs
+  { true, false, false, 2, DOMAIN_GOOGLE_BY },  // google.by
+  { true, false, false, 2, DOMAIN_GOOGLE_CA },  // google.ca
+  { true, false, false, 2, DOMAIN_GOOGLE_CAT },  // google.cat
+  { true, false, false, 2, DOMAIN_GOOGLE_CC },  // google.cc
+  { true, false, false, 2, DOMAIN_GOOGLE_CD },  // google.cd
+  { true, false, false, 2, DOMAIN_GOOGLE_CF },  // google.cf
+  { true, false, false, 2, DOMAIN_GOOGLE_CG },  // google.cg
+  { true, false, false, 2, DOMAIN_GOOGLE_CH },  // google.ch
+  { true, false, false, 2, DOMAIN_GOOGLE_CI },  // google.ci
+  { true, false, false, 2, DOMAIN_GOOGLE_CL },  // google.cl
+  { true, false, false, 2, DOMAIN_GOOGLE_CM },  // google.cm
+  { true, false, false, 2, DOMAIN_GOOGLE_CN },  // google.cn
+  { true, false, false, 2, DOMAIN_CO_AO },  // google.co.ao
+  { true, false, false, 2, DOMAIN_CO_BW },  // google.co.bw
+  { true, false, false, 2, DOMAIN_CO_CK },  // google.co.ck
+  { true, false, false, 2, DOMAIN_CO_CR },  // google.co.cr
+  { true, false, false, 2, DOMAIN_CO_HU },  // google.co.hu
+  { true, false, false, 2, DOMAIN_CO_ID },  // google.co.id
+  { true, false, false, 2, DOMAIN_CO_IL },  // google.co.il
+  { true, false, false, 2, DOMAIN_CO_IM },  // google.co.im
+  { true, false, false, 2, DOMAIN_CO_IN },  // google.co.in
+  { true, false, false, 2, DOMAIN_CO_JE },  // google.co.je
+  { true, false, false, 2, DOMAIN_CO_JP },  // google.co.jp
+  { true, false, false, 2, DOMAIN_CO_KE },  // google.co.ke
+  { true, false, false, 2, DOMAIN_CO_KR },  // google.co.kr
+  { true, false, false, 2, DOMAIN_CO_LS },  // google.co.ls
+  { true, false, false, 2, DOMAIN_CO_MA },  // google.co.ma
+  { true, false, false, 2, DOMAIN_CO_MZ },  // google.co.mz
+  { true, false, false, 2, DOMAIN_CO_NZ },  // google.co.nz
+  { true, false, false, 2, DOMAIN_CO_TH },  // google.co.th
+  { true, false, false, 2, DOMAIN_CO_TZ },  // google.co.tz
+  { true, false, false, 2, DOMAIN_CO_UG },  // google.co.ug
+  { true, false, false, 2, DOMAIN_CO_UK },  // google.co.uk
+  { true, false, false, 2, DOMAIN_CO_UZ },  // google.co.uz
+  { true, false, false, 2, DOMAIN_CO_VE },  // google.co.ve
+  { true, false, false, 2, DOMAIN_CO_VI },  // google.co.vi
+  { true, false, false, 2, DOMAIN_CO_ZA },  // google.co.za
+  { true, false, false, 2, DOMAIN_CO_ZM },  // google.co.zm
+  { true, false, false, 2, DOMAIN_CO_ZW },  // google.co.zw
+  { true, false, false, 2, DOMAIN_COM_AF },  // google.com.af
+  { true, false, false, 2, DOMAIN_COM_AG },  // google.com.ag
+  { true, false, false, 2, DOMAIN_COM_AI },  // google.com.ai
+  { true, false, false, 2, DOMAIN_COM_AR },  // google.com.ar
+  { true, false, false, 2, DOMAIN_COM_AU },  // google.com.au
+  { true, false, false, 2, DOMAIN_COM_BD },  // google.com.bd
+  { true, false, false, 2, DOMAIN_COM_BH },  // google.com.bh
+  { true, false, false, 2, DOMAIN_COM_BN },  // google.com.bn
+  { true, false, false, 2, DOMAIN_COM_BO },  // google.com.bo
+  { true, false, false, 2, DOMAIN_COM_BR },  // google.com.br
+  { true, false, false, 2, DOMAIN_COM_BY },  // google.com.by
+  { true, false, false, 2, DOMAIN_COM_BZ },  // google.com.bz
+  { true, false, false, 2, DOMAIN_COM_CN },  // google.com.cn
+  { true, false, false, 2, DOMAIN_COM_CO },  // google.com.co
+  { true, false, false, 2, DOMAIN_COM_CU },  // google.com.cu
+  { true, false, false, 2, DOMAIN_COM_CY },  // google.com.cy
+  { true, false, false, 2, DOMAIN_COM_DO },  // google.com.do
+  { true, false, false, 2, DOMAIN_COM_EC },  // google.com.ec
+  { true, false, false, 2, DOMAIN_COM_EG },  // google.com.eg
+  { true, false, false, 2, DOMAIN_COM_ET },  // google.com.et
+  { true, false, false, 2, DOMAIN_COM_FJ },  // google.com.fj
+  { true, false, false, 2, DOMAIN_COM_GE },  // google.com.ge
+  { true, false, false, 2, DOMAIN_COM_GH },  // google.com.gh
+  { true, false, false, 2, DOMAIN_COM_GI },  // google.com.gi
+  { true, false, false, 2, DOMAIN_COM_GR },  // google.com.gr
+  { true, false, false, 2, DOMAIN_COM_GT },  // google.com.gt
+  { true, false, false, 2, DOMAIN_COM_HK },  // google.com.hk
+  { true, false, false, 2, DOMAIN_COM_IQ },  // google.com.iq
+  { true, false, false, 2, DOMAIN_COM_JM },  // google.com.jm
+  { true, false, false, 2, DOMAIN_COM_JO },  // google.com.jo
+  { true, false, false, 2, DOMAIN_COM_KH },  // google.com.kh
+  { true, false, false, 2, DOMAIN_COM_KW },  // google.com.kw
+  { true, false, false, 2, DOMAIN_COM_LB },  // google.com.lb
+  { true, false, false, 2, DOMAIN_COM_LY },  // google.com.ly
+  { true, false, false, 2, DOMAIN_COM_MT },  // google.com.mt
+  { true, false, false, 2, DOMAIN_COM_MX },  // google.com.mx
+  { true, false, false, 2, DOMAIN_COM_MY },  // google.com.my
+  { true, false, false, 2, DOMAIN_COM_NA },  // google.com.na
+  { true, false, false, 2, DOMAIN_COM_NF },  // google.com.nf
+  { true, false, false, 2, DOMAIN_COM_NG },  // google.com.ng
+  { true, false, false, 2, DOMAIN_COM_NI },  // google.com.ni
+  { true, false, false, 2, DOMAIN_COM_NP },  // google.com.np
+  { true, false, false, 2, DOMAIN_COM_NR },  // google.com.nr
+  { true, false, false, 2, DOMAIN_COM_OM },  // google.com.om
+  { true, false, false, 2, DOMAIN_COM_PA },  // google.com.pa
+  { true, false, false, 2, DOMAIN_COM_PE },  // google.com.pe
+  { true, false, false, 2, DOMAIN_COM_PH },  // google.com.ph
+  { true, false, false, 2, DOMAIN_COM_PK },  // google.com.pk
+  { true, false, false, 2, DOMAIN_COM_PL },  // google.com.pl
+  { true, false, false, 2, DOMAIN_COM_PR },  // google.com.pr
+  { true, false, false, 2, DOMAIN_COM_PY },  // google.com.py
+  { true, false, false, 2, DOMAIN_COM_QA },  // google.com.qa
+  { true, false, false, 2, DOMAIN_COM_RU },  // google.com.ru
+  { true, false, false, 2, DOMAIN_COM_SA },  // google.com.sa
+  { true, false, false, 2, DOMAIN_COM_SB },  // google.com.sb
+  { true, false, false, 2, DOMAIN_COM_SG },  // google.com.sg
+  { true, false, false, 2, DOMAIN_COM_SL },  // google.com.sl
+  { true, false, false, 2, DOMAIN_COM_SV },  // google.com.sv
+  { true, false, false, 2, DOMAIN_COM_TJ },  // google.com.tj
+  { true, false, false, 2, DOMAIN_COM_TN },  // google.com.tn
+  { true, false, false, 2, DOMAIN_COM_TR },  // google.com.tr
+  { true, false, false, 2, DOMAIN_COM_TW },  // google.com.tw
+  { true, false, false, 2, DOMAIN_COM_UA },  // google.com.ua
+  { true, false, false, 2, DOMAIN_COM_UY },  // google.com.uy
+  { true, false, false, 2, DOMAIN_COM_VC },  // google.com.vc
+  { true, false, false, 2, DOMAIN_COM_VE },  // google.com.ve
+  { true, false, false, 2, DOMAIN_COM_VN },  // google.com.vn
+  { true, false, false, 2, DOMAIN_GOOGLE_CV },  // google.cv
+  { true, false, false, 2, DOMAIN_GOOGLE_CZ },  // google.cz
+  { true, false, false, 2, DOMAIN_GOOGLE_DE },  // google.de
+  { true, false, false, 2, DOMAIN_GOOGLE_DJ },  // google.dj
+  { true, false, false, 2, DOMAIN_GOOGLE_DK },  // google.dk
+  { true, false, false, 2, DOMAIN_GOOGLE_DM },  // google.dm
+  { true, false, false, 2, DOMAIN_GOOGLE_DZ },  // google.dz
+  { true, false, false, 2, DOMAIN_GOOGLE_EE },  // google.ee
+  { true, false, false, 2, DOMAIN_GOOGLE_ES },  // google.es
+  { true, false, false, 2, DOMAIN_GOOGLE_FI },  // google.fi
+  { true, false, false, 2, DOMAIN_GOOGLE_FM },  // google.fm
+  { true, false, false, 2, DOMAIN_GOOGLE_FR },  // google.fr
+  { true, false, false, 2, DOMAIN_GOOGLE_GA },  // google.ga
+  { true, false, false, 2, DOMAIN_GOOGLE_GE },  // google.ge
+  { true, false, false, 2, DOMAIN_GOOGLE_GG },  // google.gg
+  { true, false, false, 2, DOMAIN_GOOGLE_GL },  // google.gl
+  { true, false, false, 2, DOMAIN_GOOGLE_GM },  // google.gm
+  { true, false, false, 2, DOMAIN_GOOGLE_GP },  // google.gp
+  { true, false, false, 2, DOMAIN_GOOGLE_GR },  // google.gr
+  { true, false, false, 2, DOMAIN_GOOGLE_GY },  // google.gy
+  { true, false, false, 2, DOMAIN_GOOGLE_HK },  // google.hk
+  { true, false, false, 2, DOMAIN_GOOGLE_HN },  // google.hn
+  { true, false, false, 2, DOMAIN_GOOGLE_HR },  // google.hr
+  { true, false, false, 2, DOMAIN_GOOGLE_HT },  // google.ht
+  { true, false, false, 2, DOMAIN_GOOGLE_HU },  // google.hu
+  { true, false, false, 2, DOMAIN_GOOGLE_IE },  // google.ie
+  { true, false, false, 2, DOMAIN_GOOGLE_IM },  // google.im
+  { true, false, false, 2, DOMAIN_GOOGLE_INFO },  // google.info
+  { true, false, false, 2, DOMAIN_GOOGLE_IQ },  // google.iq
+  { true, false, false, 2, DOMAIN_GOOGLE_IS },  // google.is
+  { true, false, false, 2, DOMAIN_GOOGLE_IT },  // google.it
+  { true, false, false, 2, DOMAIN_IT_AO },  // google.it.ao
+  { true, false, false, 2, DOMAIN_GOOGLE_JE },  // google.je
+  { true, false, false, 2, DOMAIN_GOOGLE_JO },  // google.jo
+  { true, false, false, 2, DOMAIN_GOOGLE_JOBS },  // google.jobs
+  { true, false, false, 2, DOMAIN_GOOGLE_JP },  // google.jp
+  { true, false, false, 2, DOMAIN_GOOGLE_KG },  // google.kg
+  { true, false, false, 2, DOMAIN_GOOGLE_KI },  // google.ki
+  { true, false, false, 2, DOMAIN_GOOGLE_KZ },  // google.kz
+  { true, false, false, 2, DOMAIN_GOOGLE_LA },  // google.la
+  { true, false, false, 2, DOMAIN_GOOGLE_LI },  // google.li
+  { true, false, false, 2, DOMAIN_GOOGLE_LK },  // google.lk
+  { true, false, false, 2, DOMAIN_GOOGLE_LT },  // google.lt
+  { true, false, false, 2, DOMAIN_GOOGLE_LU },  // google.lu
+  { true, false, false, 2, DOMAIN_GOOGLE_LV },  // google.lv
+  { true, false, false, 2, DOMAIN_GOOGLE_MD },  // google.md
+  { true, false, false, 2, DOMAIN_GOOGLE_ME },  // google.me
+  { true, false, false, 2, DOMAIN_GOOGLE_MG },  // google.mg
+  { true, false, false, 2, DOMAIN_GOOGLE_MK },  // google.mk
+  { true, false, false, 2, DOMAIN_GOOGLE_ML },  // google.ml
+  { true, false, false, 2, DOMAIN_GOOGLE_MN },  // google.mn
+  { true, false, false, 2, DOMAIN_GOOGLE_MS },  // google.ms
+  { true, false, false, 2, DOMAIN_GOOGLE_MU },  // google.mu
+  { true, false, false, 2, DOMAIN_GOOGLE_MV },  // google.mv
+  { true, false, false, 2, DOMAIN_GOOGLE_MW },  // google.mw
+  { true, false, false, 2, DOMAIN_GOOGLE_NE },  // google.ne
+  { true, false, false, 2, DOMAIN_NE_JP },  // google.ne.jp
+  { true, false, false, 2, DOMAIN_GOOGLE_NET },  // google.net
+  { true, false, false, 2, DOMAIN_GOOGLE_NL },  // google.nl
+  { true, false, false, 2, DOMAIN_GOOGLE_NO },  // google.no
+  { true, false, false, 2, DOMAIN_GOOGLE_NR },  // google.nr
+  { true, false, false, 2, DOMAIN_GOOGLE_NU },  // google.nu
+  { true, false, false, 2, DOMAIN_OFF_AI },  // google.off.ai
+  { true, false, false, 2, DOMAIN_GOOGLE_PK },  // google.pk
+  { true, false, false, 2, DOMAIN_GOOGLE_PL },  // google.pl
+  { true, false, false, 2, DOMAIN_GOOGLE_PN },  // google.pn
+  { true, false, false, 2, DOMAIN_GOOGLE_PS },  // google.ps
+  { true, false, false, 2, DOMAIN_GOOGLE_PT },  // google.pt
+  { true, false, false, 2, DOMAIN_GOOGLE_RO },  // google.ro
+  { true, false, false, 2, DOMAIN_GOOGLE_RS },  // google.rs
+  { true, false, false, 2, DOMAIN_GOOGLE_RU },  // google.ru
+  { true, false, false, 2, DOMAIN_GOOGLE_RW },  // google.rw
+  { true, false, false, 2, DOMAIN_GOOGLE_SC },  // google.sc
+  { true, false, false, 2, DOMAIN_GOOGLE_SE },  // google.se
+  { true, false, false, 2, DOMAIN_GOOGLE_SH },  // google.sh
+  { true, false, false, 2, DOMAIN_GOOGLE_SI },  // google.si
+  { true, false, false, 2, DOMAIN_GOOGLE_SK },  // google.sk
+  { true, false, false, 2, DOMAIN_GOOGLE_SM },  // google.sm
+  { true, false, false, 2, DOMAIN_GOOGLE_SN },  // google.sn
+  { true, false, false, 2, DOMAIN_GOOGLE_SO },  // google.so
+  { true, false, false, 2, DOMAIN_GOOGLE_ST },  // google.st
+  { true, false, false, 2, DOMAIN_GOOGLE_TD },  // google.td
+  { true, false, false, 2, DOMAIN_GOOGLE_TG },  // google.tg
+  { true, false, false, 2, DOMAIN_GOOGLE_TK },  // google.tk
+  { true, false, false, 2, DOMAIN_GOOGLE_TL },  // google.tl
+  { true, false, false, 2, DOMAIN_GOOGLE_TM },  // google.tm
+  { true, false, false, 2, DOMAIN_GOOGLE_TN },  // google.tn
+  { true, false, false, 2, DOMAIN_GOOGLE_TO },  // google.to
+  { true, false, false, 2, DOMAIN_GOOGLE_TP },  // google.tp
+  { true, false, false, 2, DOMAIN_GOOGLE_TT },  // google.tt
+  { true, false, false, 2, DOMAIN_GOOGLE_US },  // google.us
+  { true, false, false, 2, DOMAIN_GOOGLE_UZ },  // google.uz
+  { true, false, false, 2, DOMAIN_GOOGLE_VG },  // google.vg
+  { true, false, false, 2, DOMAIN_GOOGLE_VU },  // google.vu
+  { true, false, false, 2, DOMAIN_GOOGLE_WS },  // google.ws
+  { true, false, false, 0, DOMAIN_NOT_PINNED },  // learn.doubleclick.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.paypal.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // paypal.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.elanex.biz
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // jottit.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // sunshinepress.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.noisebridge.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // neg9.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // riseup.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // factor.cc
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // members.mayfirst.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // support.mayfirst.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // id.mayfirst.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // lists.mayfirst.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // webmail.mayfirst.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // roundcube.mayfirst.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // aladdinschools.appspot.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // ottospora.nl
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.paycheckrecords.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // lastpass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.lastpass.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // keyerror.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // entropia.de
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.entropia.de
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // romab.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // logentries.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.logentries.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // stripe.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cloudsecurityalliance.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // login.sapo.pt
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // mattmccutchen.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // betnet.fr
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // uprotect.it
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // squareup.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // square.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cert.se
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // crypto.is
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // simon.butcher.name
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // linx.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // dropcam.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.dropcam.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // ebanking.indovinabank.com.vn
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // epoxate.com
+  { false, true, false, 3, DOMAIN_TORPROJECT_ORG },  // torproject.org
+  { true, true, false, 3, DOMAIN_TORPROJECT_ORG },  // blog.torproject.org
+  { true, true, false, 3, DOMAIN_TORPROJECT_ORG },  // check.torproject.org
+  { true, true, false, 3, DOMAIN_TORPROJECT_ORG },  // www.torproject.org
+  { true, true, false, 3, DOMAIN_TORPROJECT_ORG },  // dist.torproject.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.moneybookers.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // ledgerscope.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.ledgerscope.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // app.recurly.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // api.recurly.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // greplin.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.greplin.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // luneta.nearbuysystems.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // ubertt.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // pixi.me
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // grepular.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // mydigipass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.mydigipass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // developer.mydigipass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.developer.mydigipass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // sandbox.mydigipass.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.sandbox.mydigipass.com
+  { false, true, false, 7, DOMAIN_CRYPTO_CAT },  // crypto.cat
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // bigshinylock.minazo.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // crate.io
+  { false, true, false, 4, DOMAIN_TWITTER_COM },  // twitter.com
+  { true, true, false, 4, DOMAIN_TWITTER_COM },  // www.twitter.com
+  { true, false, false, 5, DOMAIN_TWITTER_COM },  // api.twitter.com
+  { true, false, false, 4, DOMAIN_TWITTER_COM },  // oauth.twitter.com
+  { true, false, false, 4, DOMAIN_TWITTER_COM },  // mobile.twitter.com
+  { true, false, false, 4, DOMAIN_TWITTER_COM },  // dev.twitter.com
+  { true, false, false, 4, DOMAIN_TWITTER_COM },  // business.twitter.com
+  { true, false, false, 5, DOMAIN_TWITTER_COM },  // platform.twitter.com
+  { true, false, false, 5, DOMAIN_TWIMG_COM },  // si0.twimg.com
+  { true, false, false, 5, DOMAIN_AKAMAIHD_NET },  // twimg0-a.akamaihd.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // braintreegateway.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // braintreepayments.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.braintreepayments.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // emailprivacytester.com
+  { true, false, false, 6, DOMAIN_TOR2WEB_ORG },  // tor2web.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // business.medbank.com.mt
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // arivo.com.br
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.apollo-auto.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.cueup.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // jitsi.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.jitsi.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // download.jitsi.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // sol.io
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // irccloud.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.irccloud.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // alpha.irccloud.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // passwd.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // browserid.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // login.persona.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // neonisi.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.neonisi.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // shops.neonisi.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // piratenlogin.de
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // howrandom.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // intercom.io
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // api.intercom.io
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.intercom.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // fatzebra.com.au
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // csawctf.poly.edu
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // makeyourlaws.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.makeyourlaws.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // iop.intuit.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // surfeasy.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.surfeasy.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // packagist.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // lookout.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.lookout.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // mylookout.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.mylookout.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // dm.lookout.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // dm.mylookout.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // itriskltd.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // stocktrade.de
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // openshift.redhat.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // therapynotes.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.therapynotes.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // wiz.biz
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // my.onlime.ch
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // webmail.onlime.ch
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // crm.onlime.ch
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.gov.uk
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // silentcircle.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // silentcircle.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // serverdensity.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // my.alfresco.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // webmail.gigahost.dk
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // paymill.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // paymill.de
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // gocardless.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // espra.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // zoo24.de
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // mega.co.nz
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // api.mega.co.nz
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // lockify.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // writeapp.me
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // bugzilla.mozilla.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // members.nearlyfreespeech.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // ssl.panoramio.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // kiwiirc.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // pay.gigahost.dk
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // controlcenter.gigahost.dk
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // simple.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.simple.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // fj.simple.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // api.simple.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // bank.simple.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // bassh.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // sah3.net
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // grc.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.grc.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // www.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // manager.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // blog.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // library.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // forum.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // p.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // paste.linode.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // pastebin.linode.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // inertianetworks.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // carezone.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // conformal.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cyphertite.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // logotype.se
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // bccx.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // launchkey.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // carlolly.co.uk
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // www.cyveillance.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // blog.cyveillance.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // whonix.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // blueseed.co
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // forum.quantifiedself.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // shodan.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // rapidresearch.me
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // surkatty.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // securityheaders.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // haste.ch
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // mudcrab.us
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // mediacru.sh
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // lolicore.ch
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cloudns.com.au
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // oplop.appspot.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // bcrook.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // wiki.python.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // lumi.do
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // appseccalifornia.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // crowdcurity.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // saturngames.co.uk
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // strongest-privacy.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // ecosystem.atlassian.net
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // id.atlassian.com
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // bitbucket.org
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cupcake.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cupcake.is
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // tent.io
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // cybozu.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // davidlyness.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // medium.com
+  { true, true, false, 8, DOMAIN_LAVABIT_COM },  // liberty.lavabit.com
+  { true, true, false, 0, DOMAIN_NOT_PINNED },  // getlantern.org
+  { false, true, false, 0, DOMAIN_NOT_PINNED },  // kinsights.com
+  { false, true, true, 2, DOMAIN_GMAIL_COM },  // gmail.com
+  { false, true, true, 2, DOMAIN_GOOGLEMAIL_COM },  // googlemail.com
+  { false, true, true, 2, DOMAIN_GMAIL_COM },  // www.gmail.com
+  { false, true, true, 2, DOMAIN_GOOGLEMAIL_COM },  // www.googlemail.com
+  { true, false, true, 2, DOMAIN_GOOGLE_ANALYTICS_COM },  // google-analytics.com
+  { true, false, true, 2, DOMAIN_GOOGLEGROUPS_COM },  // googlegroups.com
 };
-static const size_t kNumPreloadedSNISTS = ARRAYSIZE_UNSAFE(kPreloadedSNISTS);
+
+// kHSTSPreloadLabels holds the labels of the names in kHSTSPreloads.
+static const char kHSTSPreloadLabels[] =
+    "chrome-devtools-frontendcloudsecurityalliancechromiumcodereviewemailpriv"
+    "acytesterbraintreepaymentsgooglesyndicationgoogleusercontentstrongest-pr"
+    "ivacyappseccaliforniabraintreegatewaygoogle-analyticsgoogleadserviceshos"
+    "tedtalkgadgetnearlyfreespeechinertianetworkspaycheckrecordssecurityheade"
+    "rsaladdinschoolsgooglecommercenearbuysystemsquantifiedselfcontrolcenterm"
+    "attmccutchenrapidresearchserverdensitysunshinepressbigshinylockgooglegro"
+    "upsindovinabankmakeyourlawsmoneybookerspiratenloginsilentcirclespreadshe"
+    "etstherapynotesapollo-autocrowdcuritycyveillancedavidlynessdoubleclickle"
+    "dgerscopenoisebridgepinningtestsaturngamescyphertitegetlanterngocardless"
+    "googleapisgooglecodegooglemailgoogleplexlogentriesmydigipassoraprodssost"
+    "ocktradetorprojectappengineatlassianbitbucketbrowseridconformaldeveloper"
+    "ecosystemencryptedhowrandomitriskltdkinsightslaunchkeymylookoutopenshift"
+    "oraprodmvottosporapackagistpanoramioroundcubetranslateaccountsakamaihdal"
+    "frescoblueseedbugzillabusinesscarezonecarlollycheckoutdownloadebankingen"
+    "tropiafatzebragigahostgrepularintercomirccloudkeyerrorlastpasslogotypelo"
+    "licoremayfirstmediacrupastebinplatformprofilessquareupsurfeasysurkattytw"
+    "img0-auprotectwriteappandroidappspotbutchercloudnscsawctfcupcakedropcame"
+    "poxategreplingstatichistorykiwiirclavabitlibertylibrarylockifymanagermed"
+    "bankmembersmozillamudcrabneonisipaymillpersonarecurlysandboxsupporttor2w"
+    "ebtwitterwebmailyoutubebcrookbetnetcryptocybozuelanexfactorintuitjottitl"
+    "inodelunetamarketmediumminazomobileonlimepasswdpaypalpythonredhatriseups"
+    "criptshodansimplestripeubertturchinwalletwhonixalphaarivobasshchartcrate"
+    "cueupdriveespraforumgmailhastejitsilearnlistsoauthoplopromabshopssimonsi"
+    "tesytimgzoo24bccxblogcertcorpdistdocsinfojobslinxlumimeganameneg9pixiplu"
+    "spolysah3wikibizcrmedugovgrciopofforgsi0solwizwwwaeaobdbfbgbhbjbwbybzcdc"
+    "fcgcmcncvczdjdzfjfmgggpgyhnhuiqjmjpkhkwkzlblvmdmkmlmnmtmwmxmznunzpnqasns"
+    "vtkukuzvnvuzazm";
+
+// kHSTSPreloadTrie is a trie of the reversed labels of the names in
+// kHSTSPreloads. The root comes first, and the children of each node are
+// next to each other, sorted by label.
+static const struct HSTSPreloadTrieNode kHSTSPreloadTrie[] = {
+  { 0, 0, 200, 1, kNoHSTSPreload },  // (root)
+  { 72, 2, 1, 201, kNoHSTSPreload },  // ac
+  { 203, 2, 1, 202, kNoHSTSPreload },  // ad
+  { 1777, 2, 1, 203, kNoHSTSPreload },  // ae
+  { 1013, 2, 2, 204, kNoHSTSPreload },  // af
+  { 886, 2, 2, 206, kNoHSTSPreload },  // ag
+  { 65, 2, 2, 208, kNoHSTSPreload },  // ai
+  { 614, 2, 1, 210, kNoHSTSPreload },  // am
+  { 1779, 2, 2, 211, kNoHSTSPreload },  // ao
+  { 231, 2, 1, 213, kNoHSTSPreload },  // ar
+  { 705, 2, 1, 214, kNoHSTSPreload },  // as
+  { 110, 2, 1, 215, kNoHSTSPreload },  // at
+  { 526, 2, 1, 216, kNoHSTSPreload },  // au
+  { 1466, 2, 1, 217, kNoHSTSPreload },  // az
+  { 443, 2, 1, 218, kNoHSTSPreload },  // ba
+  { 1781, 2, 1, 219, kNoHSTSPreload },  // bd
+  { 907, 2, 2, 220, kNoHSTSPreload },  // be
+  { 1783, 2, 1, 222, kNoHSTSPreload },  // bf
+  { 1785, 2, 1, 223, kNoHSTSPreload },  // bg
+  { 1787, 2, 1, 224, kNoHSTSPreload },  // bh
+  { 411, 2, 1, 225, kNoHSTSPreload },  // bi
+  { 1741, 3, 2, 226, kNoHSTSPreload },  // biz
+  { 1789, 2, 1, 228, kNoHSTSPreload },  // bj
+  { 1320, 2, 1, 229, kNoHSTSPreload },  // bn
+  { 464, 2, 1, 230, kNoHSTSPreload },  // bo
+  { 81, 2, 1, 231, kNoHSTSPreload },  // br
+  { 1643, 2, 1, 232, kNoHSTSPreload },  // bs
+  { 1791, 2, 1, 233, kNoHSTSPreload },  // bw
+  { 1793, 2, 2, 234, kNoHSTSPreload },  // by
+  { 1795, 2, 1, 236, kNoHSTSPreload },  // bz
+  { 109, 2, 1, 237, kNoHSTSPreload },  // ca
+  { 109, 3, 2, 238, kNoHSTSPreload },  // cat
+  { 154, 2, 2, 240, kNoHSTSPreload },  // cc
+  { 1797, 2, 1, 242, kNoHSTSPreload },  // cd
+  { 1799, 2, 1, 243, kNoHSTSPreload },  // cf
+  { 1801, 2, 1, 244, kNoHSTSPreload },  // cg
+  { 0, 2, 4, 245, kNoHSTSPreload },  // ch
+  { 489, 2, 1, 249, kNoHSTSPreload },  // ci
+  { 266, 2, 1, 250, kNoHSTSPreload },  // ck
+  { 24, 2, 1, 251, kNoHSTSPreload },  // cl
+  { 1803, 2, 1, 252, kNoHSTSPreload },  // cm
+  { 1805, 2, 2, 253, kNoHSTSPreload },  // cn
+  { 53, 2, 3, 255, kNoHSTSPreload },  // co
+  { 310, 3, 81, 258, kNoHSTSPreload },  // com
+  { 530, 2, 1, 339, kNoHSTSPreload },  // cr
+  { 31, 2, 1, 340, kNoHSTSPreload },  // cu
+  { 1807, 2, 1, 341, kNoHSTSPreload },  // cv
+  { 73, 2, 1, 342, kNoHSTSPreload },  // cy
+  { 1809, 2, 1, 343, kNoHSTSPreload },  // cz
+  { 7, 2, 6, 344, kNoHSTSPreload },  // de
+  { 1811, 2, 1, 350, kNoHSTSPreload },  // dj
+  { 827, 2, 2, 351, kNoHSTSPreload },  // dk
+  { 870, 2, 1, 353, kNoHSTSPreload },  // dm
+  { 437, 2, 2, 354, kNoHSTSPreload },  // do
+  { 1813, 2, 1, 356, kNoHSTSPreload },  // dz
+  { 30, 2, 1, 357, kNoHSTSPreload },  // ec
+  { 1747, 3, 1, 358, kNoHSTSPreload },  // edu
+  { 88, 2, 1, 359, kNoHSTSPreload },  // ee
+  { 173, 2, 1, 360, kNoHSTSPreload },  // eg
+  { 76, 2, 1, 361, kNoHSTSPreload },  // es
+  { 227, 2, 1, 362, kNoHSTSPreload },  // et
+  { 338, 2, 1, 363, kNoHSTSPreload },  // fi
+  { 1815, 2, 1, 364, kNoHSTSPreload },  // fj
+  { 1817, 2, 1, 365, kNoHSTSPreload },  // fm
+  { 16, 2, 2, 366, kNoHSTSPreload },  // fr
+  { 174, 2, 1, 368, kNoHSTSPreload },  // ga
+  { 137, 2, 2, 369, kNoHSTSPreload },  // ge
+  { 1819, 2, 1, 371, kNoHSTSPreload },  // gg
+  { 833, 2, 1, 372, kNoHSTSPreload },  // gh
+  { 480, 2, 1, 373, kNoHSTSPreload },  // gi
+  { 101, 2, 2, 374, kNoHSTSPreload },  // gl
+  { 1604, 2, 1, 376, kNoHSTSPreload },  // gm
+  { 1821, 2, 1, 377, kNoHSTSPreload },  // gp
+  { 429, 2, 2, 378, kNoHSTSPreload },  // gr
+  { 602, 2, 1, 380, kNoHSTSPreload },  // gt
+  { 1823, 2, 1, 381, kNoHSTSPreload },  // gy
+  { 842, 2, 2, 382, kNoHSTSPreload },  // hk
+  { 1825, 2, 1, 384, kNoHSTSPreload },  // hn
+  { 1, 2, 1, 385, kNoHSTSPreload },  // hr
+  { 834, 2, 1, 386, kNoHSTSPreload },  // ht
+  { 1827, 2, 2, 387, kNoHSTSPreload },  // hu
+  { 375, 2, 1, 389, kNoHSTSPreload },  // id
+  { 60, 2, 1, 390, kNoHSTSPreload },  // ie
+  { 66, 2, 1, 391, kNoHSTSPreload },  // il
+  { 1152, 2, 2, 392, kNoHSTSPreload },  // im
+  { 84, 2, 1, 394, kNoHSTSPreload },  // in
+  { 1693, 4, 1, 395, kNoHSTSPreload },  // info
+  { 112, 2, 8, 396, kNoHSTSPreload },  // io
+  { 1829, 2, 2, 404, kNoHSTSPreload },  // iq
+  { 587, 2, 3, 406, kNoHSTSPreload },  // is
+  { 34, 2, 2, 409, kNoHSTSPreload },  // it
+  { 734, 2, 2, 411, kNoHSTSPreload },  // je
+  { 1831, 2, 1, 413, kNoHSTSPreload },  // jm
+  { 1433, 2, 2, 414, kNoHSTSPreload },  // jo
+  { 1697, 4, 1, 416, kNoHSTSPreload },  // jobs
+  { 1833, 2, 3, 417, kNoHSTSPreload },  // jp
+  { 449, 2, 1, 420, kNoHSTSPreload },  // ke
+  { 222, 2, 1, 421, kNoHSTSPreload },  // kg
+  { 1835, 2, 1, 422, kNoHSTSPreload },  // kh
+  { 828, 2, 1, 423, kNoHSTSPreload },  // ki
+  { 267, 2, 1, 424, kNoHSTSPreload },  // kr
+  { 1837, 2, 1, 425, kNoHSTSPreload },  // kw
+  { 1839, 2, 1, 426, kNoHSTSPreload },  // kz
+  { 291, 2, 1, 427, kNoHSTSPreload },  // la
+  { 1841, 2, 1, 428, kNoHSTSPreload },  // lb
+  { 39, 2, 1, 429, kNoHSTSPreload },  // li
+  { 221, 2, 1, 430, kNoHSTSPreload },  // lk
+  { 13, 2, 1, 431, kNoHSTSPreload },  // ls
+  { 825, 2, 1, 432, kNoHSTSPreload },  // lt
+  { 943, 2, 1, 433, kNoHSTSPreload },  // lu
+  { 1843, 2, 1, 434, kNoHSTSPreload },  // lv
+  { 191, 2, 1, 435, kNoHSTSPreload },  // ly
+  { 64, 2, 1, 436, kNoHSTSPreload },  // ma
+  { 1845, 2, 1, 437, kNoHSTSPreload },  // md
+  { 4, 2, 4, 438, kNoHSTSPreload },  // me
+  { 1153, 2, 1, 442, kNoHSTSPreload },  // mg
+  { 1847, 2, 1, 443, kNoHSTSPreload },  // mk
+  { 1849, 2, 1, 444, kNoHSTSPreload },  // ml
+  { 1851, 2, 1, 445, kNoHSTSPreload },  // mn
+  { 330, 2, 1, 446, kNoHSTSPreload },  // ms
+  { 1853, 2, 1, 447, kNoHSTSPreload },  // mt
+  { 1314, 2, 1, 448, kNoHSTSPreload },  // mu
+  { 871, 2, 1, 449, kNoHSTSPreload },  // mv
+  { 1855, 2, 1, 450, kNoHSTSPreload },  // mw
+  { 1857, 2, 1, 451, kNoHSTSPreload },  // mx
+  { 698, 2, 1, 452, kNoHSTSPreload },  // my
+  { 1859, 2, 1, 453, kNoHSTSPreload },  // mz
+  { 189, 2, 1, 454, kNoHSTSPreload },  // na
+  { 1713, 4, 1, 455, kNoHSTSPreload },  // name
+  { 229, 2, 1, 456, kNoHSTSPreload },  // ne
+  { 252, 3, 13, 457, kNoHSTSPreload },  // net
+  { 776, 2, 1, 470, kNoHSTSPreload },  // nf
+  { 114, 2, 1, 471, kNoHSTSPreload },  // ng
+  { 162, 2, 1, 472, kNoHSTSPreload },  // ni
+  { 477, 2, 2, 473, kNoHSTSPreload },  // nl
+  { 514, 2, 1, 475, kNoHSTSPreload },  // no
+  { 1109, 2, 1, 476, kNoHSTSPreload },  // np
+  { 371, 2, 2, 477, kNoHSTSPreload },  // nr
+  { 1861, 2, 1, 479, kNoHSTSPreload },  // nu
+  { 1863, 2, 1, 480, kNoHSTSPreload },  // nz
+  { 3, 2, 1, 481, kNoHSTSPreload },  // om
+  { 1762, 3, 22, 482, kNoHSTSPreload },  // org
+  { 90, 2, 1, 504, kNoHSTSPreload },  // pa
+  { 240, 2, 1, 505, kNoHSTSPreload },  // pe
+  { 620, 2, 1, 506, kNoHSTSPreload },  // ph
+  { 1834, 2, 2, 507, kNoHSTSPreload },  // pk
+  { 684, 2, 2, 509, kNoHSTSPreload },  // pl
+  { 1865, 2, 1, 511, kNoHSTSPreload },  // pn
+  { 68, 2, 1, 512, kNoHSTSPreload },  // pr
+  { 151, 2, 1, 513, kNoHSTSPreload },  // ps
+  { 806, 2, 2, 514, kNoHSTSPreload },  // pt
+  { 512, 2, 1, 516, kNoHSTSPreload },  // py
+  { 1867, 2, 1, 517, kNoHSTSPreload },  // qa
+  { 2, 2, 1, 518, kNoHSTSPreload },  // ro
+  { 288, 2, 1, 519, kNoHSTSPreload },  // rs
+  { 1100, 2, 2, 520, kNoHSTSPreload },  // ru
+  { 1376, 2, 1, 522, kNoHSTSPreload },  // rw
+  { 289, 2, 1, 523, kNoHSTSPreload },  // sa
+  { 410, 2, 1, 524, kNoHSTSPreload },  // sb
+  { 297, 2, 1, 525, kNoHSTSPreload },  // sc
+  { 29, 2, 3, 526, kNoHSTSPreload },  // se
+  { 97, 2, 1, 529, kNoHSTSPreload },  // sg
+  { 212, 2, 2, 530, kNoHSTSPreload },  // sh
+  { 394, 2, 1, 532, kNoHSTSPreload },  // si
+  { 823, 2, 1, 533, kNoHSTSPreload },  // sk
+  { 836, 2, 1, 534, kNoHSTSPreload },  // sl
+  { 458, 2, 1, 535, kNoHSTSPreload },  // sm
+  { 1869, 2, 1, 536, kNoHSTSPreload },  // sn
+  { 707, 2, 1, 537, kNoHSTSPreload },  // so
+  { 77, 2, 1, 538, kNoHSTSPreload },  // st
+  { 1871, 2, 1, 539, kNoHSTSPreload },  // sv
+  { 826, 2, 1, 540, kNoHSTSPreload },  // td
+  { 1029, 2, 1, 541, kNoHSTSPreload },  // tg
+  { 507, 2, 1, 542, kNoHSTSPreload },  // th
+  { 1432, 2, 1, 543, kNoHSTSPreload },  // tj
+  { 1873, 2, 1, 544, kNoHSTSPreload },  // tk
+  { 630, 2, 1, 545, kNoHSTSPreload },  // tl
+  { 362, 2, 1, 546, kNoHSTSPreload },  // tm
+  { 228, 2, 2, 547, kNoHSTSPreload },  // tn
+  { 10, 2, 1, 549, kNoHSTSPreload },  // to
+  { 890, 2, 1, 550, kNoHSTSPreload },  // tp
+  { 86, 2, 1, 551, kNoHSTSPreload },  // tr
+  { 361, 2, 1, 552, kNoHSTSPreload },  // tt
+  { 254, 2, 1, 553, kNoHSTSPreload },  // tw
+  { 1016, 2, 1, 554, kNoHSTSPreload },  // tz
+  { 333, 2, 1, 555, kNoHSTSPreload },  // ua
+  { 951, 2, 1, 556, kNoHSTSPreload },  // ug
+  { 1875, 2, 2, 557, kNoHSTSPreload },  // uk
+  { 121, 2, 2, 559, kNoHSTSPreload },  // us
+  { 323, 2, 1, 561, kNoHSTSPreload },  // uy
+  { 1877, 2, 2, 562, kNoHSTSPreload },  // uz
+  { 1808, 2, 1, 564, kNoHSTSPreload },  // vc
+  { 388, 2, 2, 565, kNoHSTSPreload },  // ve
+  { 1752, 2, 1, 567, kNoHSTSPreload },  // vg
+  { 59, 2, 1, 568, kNoHSTSPreload },  // vi
+  { 1879, 2, 1, 569, kNoHSTSPreload },  // vn
+  { 1881, 2, 1, 570, kNoHSTSPreload },  // vu
+  { 457, 2, 1, 571, kNoHSTSPreload },  // ws
+  { 1883, 2, 1, 572, kNoHSTSPreload },  // za
+  { 1885, 2, 1, 573, kNoHSTSPreload },  // zm
+  { 1773, 2, 1, 574, kNoHSTSPreload },  // zw
+  { 98, 6, 0, 0, 53 },  // google.ac
+  { 98, 6, 0, 0, 54 },  // google.ad
+  { 98, 6, 0, 0, 55 },  // google.ae
+  { 310, 3, 1, 575, kNoHSTSPreload },  // com.af
+  { 98, 6, 0, 0, 56 },  // google.af
+  { 310, 3, 1, 576, kNoHSTSPreload },  // com.ag
+  { 98, 6, 0, 0, 57 },  // google.ag
+  { 310, 3, 1, 577, kNoHSTSPreload },  // com.ai
+  { 1759, 3, 1, 578, kNoHSTSPreload },  // off.ai
+  { 98, 6, 0, 0, 58 },  // google.am
+  { 53, 2, 1, 579, kNoHSTSPreload },  // co.ao
+  { 34, 2, 1, 580, kNoHSTSPreload },  // it.ao
+  { 310, 3, 1, 581, kNoHSTSPreload },  // com.ar
+  { 98, 6, 0, 0, 59 },  // google.as
+  { 98, 6, 0, 0, 60 },  // google.at
+  { 310, 3, 3, 582, kNoHSTSPreload },  // com.au
+  { 98, 6, 0, 0, 61 },  // google.az
+  { 98, 6, 0, 0, 62 },  // google.ba
+  { 310, 3, 1, 585, kNoHSTSPreload },  // com.bd
+  { 98, 6, 0, 0, 63 },  // google.be
+  { 1384, 5, 0, 0, 47 },  // youtu.be
+  { 98, 6, 0, 0, 64 },  // google.bf
+  { 98, 6, 0, 0, 65 },  // google.bg
+  { 310, 3, 1, 586, kNoHSTSPreload },  // com.bh
+  { 98, 6, 0, 0, 66 },  // google.bi
+  { 1415, 6, 1, 587, kNoHSTSPreload },  // elanex.biz
+  { 1771, 3, 0, 0, 394 },  // wiz.biz
+  { 98, 6, 0, 0, 67 },  // google.bj
+  { 310, 3, 1, 588, kNoHSTSPreload },  // com.bn
+  { 310, 3, 1, 589, kNoHSTSPreload },  // com.bo
+  { 310, 3, 2, 590, kNoHSTSPreload },  // com.br
+  { 98, 6, 0, 0, 68 },  // google.bs
+  { 53, 2, 1, 592, kNoHSTSPreload },  // co.bw
+  { 310, 3, 1, 593, kNoHSTSPreload },  // com.by
+  { 98, 6, 0, 0, 69 },  // google.by
+  { 310, 3, 1, 594, kNoHSTSPreload },  // com.bz
+  { 98, 6, 0, 0, 70 },  // google.ca
+  { 1403, 6, 0, 0, 335 },  // crypto.cat
+  { 98, 6, 0, 0, 71 },  // google.cat
+  { 1421, 6, 0, 0, 279 },  // factor.cc
+  { 98, 6, 0, 0, 72 },  // google.cc
+  { 98, 6, 0, 0, 73 },  // google.cd
+  { 98, 6, 0, 0, 74 },  // google.cf
+  { 98, 6, 0, 0, 75 },  // google.cg
+  { 98, 6, 0, 0, 76 },  // google.ch
+  { 1609, 5, 0, 0, 454 },  // haste.ch
+  { 1078, 8, 0, 0, 457 },  // lolicore.ch
+  { 1475, 6, 3, 595, kNoHSTSPreload },  // onlime.ch
+  { 98, 6, 0, 0, 77 },  // google.ci
+  { 53, 2, 1, 598, kNoHSTSPreload },  // co.ck
+  { 98, 6, 0, 0, 78 },  // google.cl
+  { 98, 6, 0, 0, 79 },  // google.cm
+  { 310, 3, 1, 599, kNoHSTSPreload },  // com.cn
+  { 98, 6, 0, 0, 80 },  // google.cn
+  { 942, 8, 0, 0, 448 },  // blueseed.co
+  { 310, 3, 1, 600, kNoHSTSPreload },  // com.co
+  { 98, 1, 0, 0, 52 },  // g.co
+  { 934, 8, 1, 601, kNoHSTSPreload },  // alfresco.com
+  { 1174, 7, 1, 602, 48 },  // android.com
+  { 519, 11, 1, 603, kNoHSTSPreload },  // apollo-auto.com
+  { 1181, 7, 6, 604, 43 },  // appspot.com
+  { 747, 9, 1, 610, kNoHSTSPreload },  // atlassian.com
+  { 1669, 4, 0, 0, 442 },  // bccx.com
+  { 1391, 6, 0, 0, 460 },  // bcrook.com
+  { 165, 16, 0, 0, 348 },  // braintreegateway.com
+  { 81, 17, 1, 611, 349 },  // braintreepayments.com
+  { 966, 8, 0, 0, 438 },  // carezone.com
+  { 774, 9, 0, 0, 439 },  // conformal.com
+  { 530, 11, 0, 0, 464 },  // crowdcurity.com
+  { 1584, 5, 1, 612, kNoHSTSPreload },  // cueup.com
+  { 1409, 6, 0, 0, 473 },  // cybozu.com
+  { 618, 10, 0, 0, 440 },  // cyphertite.com
+  { 541, 11, 2, 613, kNoHSTSPreload },  // cyveillance.com
+  { 552, 11, 0, 0, 474 },  // davidlyness.com
+  { 1216, 7, 1, 615, 309 },  // dropcam.com
+  { 63, 18, 0, 0, 351 },  // emailprivacytester.com
+  { 1223, 7, 0, 0, 312 },  // epoxate.com
+  { 1594, 5, 0, 0, 407 },  // espra.com
+  { 1604, 5, 1, 616, 479 },  // gmail.com
+  { 638, 10, 0, 0, 406 },  // gocardless.com
+  { 98, 6, 25, 617, 1 },  // google.com
+  { 181, 16, 1, 642, 483 },  // google-analytics.com
+  { 197, 16, 0, 0, 42 },  // googleadservices.com
+  { 648, 10, 1, 643, 41 },  // googleapis.com
+  { 658, 10, 0, 0, 32 },  // googlecode.com
+  { 304, 14, 0, 0, 49 },  // googlecommerce.com
+  { 423, 12, 0, 0, 484 },  // googlegroups.com
+  { 668, 10, 1, 644, 480 },  // googlemail.com
+  { 678, 10, 0, 0, 24 },  // googleplex.com
+  { 98, 17, 0, 0, 44 },  // googlesyndication.com
+  { 115, 17, 0, 0, 39 },  // googleusercontent.com
+  { 1753, 3, 1, 645, 426 },  // grc.com
+  { 1230, 7, 1, 646, 323 },  // greplin.com
+  { 1030, 8, 0, 0, 328 },  // grepular.com
+  { 1237, 7, 1, 647, kNoHSTSPreload },  // gstatic.com
+  { 245, 15, 0, 0, 437 },  // inertianetworks.com
+  { 1427, 6, 1, 648, kNoHSTSPreload },  // intuit.com
+  { 1046, 8, 2, 649, 361 },  // irccloud.com
+  { 819, 9, 0, 0, 389 },  // itriskltd.com
+  { 1433, 6, 0, 0, 274 },  // jottit.com
+  { 1054, 8, 0, 0, 291 },  // keyerror.com
+  { 828, 9, 0, 0, 478 },  // kinsights.com
+  { 1251, 7, 0, 0, 416 },  // kiwiirc.com
+  { 1062, 8, 1, 651, 289 },  // lastpass.com
+  { 837, 9, 0, 0, 443 },  // launchkey.com
+  { 1258, 7, 1, 652, kNoHSTSPreload },  // lavabit.com
+  { 1439, 6, 8, 653, 428 },  // linode.com
+  { 1279, 7, 0, 0, 411 },  // lockify.com
+  { 688, 10, 1, 661, 295 },  // logentries.com
+  { 848, 7, 2, 662, 383 },  // lookout.com
+  { 1457, 6, 0, 0, 475 },  // medium.com
+  { 459, 12, 1, 664, kNoHSTSPreload },  // moneybookers.com
+  { 698, 10, 3, 665, 329 },  // mydigipass.com
+  { 846, 9, 2, 668, 385 },  // mylookout.com
+  { 318, 14, 1, 670, kNoHSTSPreload },  // nearbuysystems.com
+  { 1321, 7, 2, 671, 367 },  // neonisi.com
+  { 891, 9, 1, 673, kNoHSTSPreload },  // panoramio.com
+  { 260, 15, 1, 674, kNoHSTSPreload },  // paycheckrecords.com
+  { 1328, 7, 0, 0, 404 },  // paymill.com
+  { 1487, 6, 1, 675, 272 },  // paypal.com
+  { 332, 14, 1, 676, kNoHSTSPreload },  // quantifiedself.com
+  { 1342, 7, 2, 677, kNoHSTSPreload },  // recurly.com
+  { 1499, 6, 1, 679, kNoHSTSPreload },  // redhat.com
+  { 1639, 5, 0, 0, 294 },  // romab.com
+  { 275, 15, 0, 0, 453 },  // securityheaders.com
+  { 483, 12, 0, 0, 399 },  // silentcircle.com
+  { 1523, 6, 4, 680, 419 },  // simple.com
+  { 1126, 6, 0, 0, 304 },  // square.com
+  { 1126, 8, 0, 0, 303 },  // squareup.com
+  { 1529, 6, 0, 0, 297 },  // stripe.com
+  { 132, 17, 0, 0, 466 },  // strongest-privacy.com
+  { 1134, 8, 1, 684, 380 },  // surfeasy.com
+  { 507, 12, 1, 685, 392 },  // therapynotes.com
+  { 1150, 5, 1, 686, kNoHSTSPreload },  // twimg.com
+  { 1370, 7, 7, 687, 338 },  // twitter.com
+  { 1541, 6, 0, 0, 50 },  // urchin.com
+  { 1384, 7, 0, 0, 40 },  // youtube.com
+  { 1659, 5, 0, 0, 38 },  // ytimg.com
+  { 53, 2, 1, 694, kNoHSTSPreload },  // co.cr
+  { 310, 3, 1, 695, kNoHSTSPreload },  // com.cu
+  { 98, 6, 0, 0, 175 },  // google.cv
+  { 310, 3, 1, 696, kNoHSTSPreload },  // com.cy
+  { 98, 6, 0, 0, 176 },  // google.cz
+  { 1006, 8, 1, 697, 292 },  // entropia.de
+  { 98, 6, 0, 0, 177 },  // google.de
+  { 1328, 7, 0, 0, 405 },  // paymill.de
+  { 471, 12, 0, 0, 370 },  // piratenlogin.de
+  { 718, 10, 0, 0, 390 },  // stocktrade.de
+  { 1664, 5, 0, 0, 408 },  // zoo24.de
+  { 98, 6, 0, 0, 178 },  // google.dj
+  { 1022, 8, 3, 698, kNoHSTSPreload },  // gigahost.dk
+  { 98, 6, 0, 0, 179 },  // google.dk
+  { 98, 6, 0, 0, 180 },  // google.dm
+  { 310, 3, 1, 701, kNoHSTSPreload },  // com.do
+  { 1705, 4, 0, 0, 462 },  // lumi.do
+  { 98, 6, 0, 0, 181 },  // google.dz
+  { 310, 3, 1, 702, kNoHSTSPreload },  // com.ec
+  { 1729, 4, 1, 703, kNoHSTSPreload },  // poly.edu
+  { 98, 6, 0, 0, 182 },  // google.ee
+  { 310, 3, 1, 704, kNoHSTSPreload },  // com.eg
+  { 98, 6, 0, 0, 183 },  // google.es
+  { 310, 3, 1, 705, kNoHSTSPreload },  // com.et
+  { 98, 6, 0, 0, 184 },  // google.fi
+  { 310, 3, 1, 706, kNoHSTSPreload },  // com.fj
+  { 98, 6, 0, 0, 185 },  // google.fm
+  { 1397, 6, 0, 0, 301 },  // betnet.fr
+  { 98, 6, 0, 0, 186 },  // google.fr
+  { 98, 6, 0, 0, 187 },  // google.ga
+  { 310, 3, 1, 707, kNoHSTSPreload },  // com.ge
+  { 98, 6, 0, 0, 188 },  // google.ge
+  { 98, 6, 0, 0, 189 },  // google.gg
+  { 310, 3, 1, 708, kNoHSTSPreload },  // com.gh
+  { 310, 3, 1, 709, kNoHSTSPreload },  // com.gi
+  { 98, 3, 0, 0, 51 },  // goo.gl
+  { 98, 6, 0, 0, 190 },  // google.gl
+  { 98, 6, 0, 0, 191 },  // google.gm
+  { 98, 6, 0, 0, 192 },  // google.gp
+  { 310, 3, 1, 710, kNoHSTSPreload },  // com.gr
+  { 98, 6, 0, 0, 193 },  // google.gr
+  { 310, 3, 1, 711, kNoHSTSPreload },  // com.gt
+  { 98, 6, 0, 0, 194 },  // google.gy
+  { 310, 3, 1, 712, kNoHSTSPreload },  // com.hk
+  { 98, 6, 0, 0, 195 },  // google.hk
+  { 98, 6, 0, 0, 196 },  // google.hn
+  { 98, 6, 0, 0, 197 },  // google.hr
+  { 98, 6, 0, 0, 198 },  // google.ht
+  { 53, 2, 1, 713, kNoHSTSPreload },  // co.hu
+  { 98, 6, 0, 0, 199 },  // google.hu
+  { 53, 2, 1, 714, kNoHSTSPreload },  // co.id
+  { 98, 6, 0, 0, 200 },  // google.ie
+  { 53, 2, 1, 715, kNoHSTSPreload },  // co.il
+  { 53, 2, 1, 716, kNoHSTSPreload },  // co.im
+  { 98, 6, 0, 0, 201 },  // google.im
+  { 53, 2, 1, 717, kNoHSTSPreload },  // co.in
+  { 98, 6, 0, 0, 202 },  // google.info
+  { 1579, 5, 0, 0, 337 },  // crate.io
+  { 1209, 7, 0, 0, 470 },  // cupcake.io
+  { 1038, 8, 2, 718, 372 },  // intercom.io
+  { 1481, 6, 0, 0, 364 },  // passwd.io
+  { 385, 13, 0, 0, 401 },  // serverdensity.io
+  { 1517, 6, 0, 0, 450 },  // shodan.io
+  { 1768, 3, 0, 0, 360 },  // sol.io
+  { 128, 4, 0, 0, 472 },  // tent.io
+  { 310, 3, 1, 720, kNoHSTSPreload },  // com.iq
+  { 98, 6, 0, 0, 203 },  // google.iq
+  { 1403, 6, 0, 0, 306 },  // crypto.is
+  { 1209, 7, 0, 0, 471 },  // cupcake.is
+  { 98, 6, 0, 0, 204 },  // google.is
+  { 98, 6, 0, 0, 205 },  // google.it
+  { 1158, 8, 0, 0, 302 },  // uprotect.it
+  { 53, 2, 1, 721, kNoHSTSPreload },  // co.je
+  { 98, 6, 0, 0, 207 },  // google.je
+  { 310, 3, 1, 722, kNoHSTSPreload },  // com.jm
+  { 310, 3, 1, 723, kNoHSTSPreload },  // com.jo
+  { 98, 6, 0, 0, 208 },  // google.jo
+  { 98, 6, 0, 0, 209 },  // google.jobs
+  { 53, 2, 1, 724, kNoHSTSPreload },  // co.jp
+  { 98, 6, 0, 0, 210 },  // google.jp
+  { 229, 2, 1, 725, kNoHSTSPreload },  // ne.jp
+  { 53, 2, 1, 726, kNoHSTSPreload },  // co.ke
+  { 98, 6, 0, 0, 211 },  // google.kg
+  { 310, 3, 1, 727, kNoHSTSPreload },  // com.kh
+  { 98, 6, 0, 0, 212 },  // google.ki
+  { 53, 2, 1, 728, kNoHSTSPreload },  // co.kr
+  { 310, 3, 1, 729, kNoHSTSPreload },  // com.kw
+  { 98, 6, 0, 0, 213 },  // google.kz
+  { 98, 6, 0, 0, 214 },  // google.la
+  { 310, 3, 1, 730, kNoHSTSPreload },  // com.lb
+  { 98, 6, 0, 0, 215 },  // google.li
+  { 98, 6, 0, 0, 216 },  // google.lk
+  { 53, 2, 1, 731, kNoHSTSPreload },  // co.ls
+  { 98, 6, 0, 0, 217 },  // google.lt
+  { 98, 6, 0, 0, 218 },  // google.lu
+  { 98, 6, 0, 0, 219 },  // google.lv
+  { 310, 3, 1, 732, kNoHSTSPreload },  // com.ly
+  { 53, 2, 1, 733, kNoHSTSPreload },  // co.ma
+  { 98, 6, 0, 0, 220 },  // google.md
+  { 98, 6, 0, 0, 221 },  // google.me
+  { 1721, 4, 0, 0, 327 },  // pixi.me
+  { 372, 13, 0, 0, 451 },  // rapidresearch.me
+  { 1166, 8, 0, 0, 412 },  // writeapp.me
+  { 98, 6, 0, 0, 222 },  // google.mg
+  { 98, 6, 0, 0, 223 },  // google.mk
+  { 98, 6, 0, 0, 224 },  // google.ml
+  { 98, 6, 0, 0, 225 },  // google.mn
+  { 98, 6, 0, 0, 226 },  // google.ms
+  { 310, 3, 2, 734, kNoHSTSPreload },  // com.mt
+  { 98, 6, 0, 0, 227 },  // google.mu
+  { 98, 6, 0, 0, 228 },  // google.mv
+  { 98, 6, 0, 0, 229 },  // google.mw
+  { 310, 3, 1, 736, kNoHSTSPreload },  // com.mx
+  { 310, 3, 1, 737, kNoHSTSPreload },  // com.my
+  { 53, 2, 1, 738, kNoHSTSPreload },  // co.mz
+  { 310, 3, 1, 739, kNoHSTSPreload },  // com.na
+  { 1188, 7, 1, 740, kNoHSTSPreload },  // butcher.name
+  { 98, 6, 0, 0, 230 },  // google.ne
+  { 926, 8, 1, 741, kNoHSTSPreload },  // akamaihd.net
+  { 747, 9, 1, 742, kNoHSTSPreload },  // atlassian.net
+  { 1569, 5, 0, 0, 424 },  // bassh.net
+  { 563, 11, 1, 743, 45 },  // doubleclick.net
+  { 98, 6, 0, 0, 232 },  // google.net
+  { 574, 11, 1, 744, 319 },  // ledgerscope.net
+  { 1701, 4, 0, 0, 308 },  // linx.net
+  { 359, 13, 0, 0, 300 },  // mattmccutchen.net
+  { 1463, 6, 1, 745, kNoHSTSPreload },  // minazo.net
+  { 229, 16, 1, 746, kNoHSTSPreload },  // nearlyfreespeech.net
+  { 585, 11, 1, 747, kNoHSTSPreload },  // noisebridge.net
+  { 1505, 6, 0, 0, 278 },  // riseup.net
+  { 1733, 4, 0, 0, 425 },  // sah3.net
+  { 310, 3, 1, 748, kNoHSTSPreload },  // com.nf
+  { 310, 3, 1, 749, kNoHSTSPreload },  // com.ng
+  { 310, 3, 1, 750, kNoHSTSPreload },  // com.ni
+  { 98, 6, 0, 0, 233 },  // google.nl
+  { 873, 9, 0, 0, 287 },  // ottospora.nl
+  { 98, 6, 0, 0, 234 },  // google.no
+  { 310, 3, 1, 751, kNoHSTSPreload },  // com.np
+  { 310, 3, 1, 752, kNoHSTSPreload },  // com.nr
+  { 98, 6, 0, 0, 235 },  // google.nr
+  { 98, 6, 0, 0, 236 },  // google.nu
+  { 53, 2, 2, 753, kNoHSTSPreload },  // co.nz
+  { 310, 3, 1, 755, kNoHSTSPreload },  // com.om
+  { 149, 16, 0, 0, 463 },  // appseccalifornia.org
+  { 756, 9, 0, 0, 469 },  // bitbucket.org
+  { 765, 9, 0, 0, 365 },  // browserid.org
+  { 45, 8, 1, 756, kNoHSTSPreload },  // chromium.org
+  { 24, 21, 0, 0, 298 },  // cloudsecurityalliance.org
+  { 628, 10, 0, 0, 477 },  // getlantern.org
+  { 810, 9, 0, 0, 371 },  // howrandom.org
+  { 1614, 5, 2, 757, 357 },  // jitsi.org
+  { 447, 12, 1, 759, 377 },  // makeyourlaws.org
+  { 1086, 8, 6, 760, kNoHSTSPreload },  // mayfirst.org
+  { 1307, 7, 1, 766, kNoHSTSPreload },  // mozilla.org
+  { 1717, 4, 0, 0, 277 },  // neg9.org
+  { 882, 9, 0, 0, 382 },  // packagist.org
+  { 1335, 7, 1, 767, kNoHSTSPreload },  // persona.org
+  { 1493, 6, 1, 768, kNoHSTSPreload },  // python.org
+  { 483, 12, 0, 0, 400 },  // silentcircle.org
+  { 398, 13, 0, 0, 275 },  // sunshinepress.org
+  { 1142, 8, 0, 0, 452 },  // surkatty.org
+  { 1363, 7, 0, 0, 352 },  // tor2web.org
+  { 728, 10, 4, 769, 313 },  // torproject.org
+  { 1535, 6, 0, 0, 326 },  // ubertt.org
+  { 1553, 6, 0, 0, 447 },  // whonix.org
+  { 310, 3, 1, 773, kNoHSTSPreload },  // com.pa
+  { 310, 3, 1, 774, kNoHSTSPreload },  // com.pe
+  { 310, 3, 1, 775, kNoHSTSPreload },  // com.ph
+  { 310, 3, 1, 776, kNoHSTSPreload },  // com.pk
+  { 98, 6, 0, 0, 238 },  // google.pk
+  { 310, 3, 1, 777, kNoHSTSPreload },  // com.pl
+  { 98, 6, 0, 0, 239 },  // google.pl
+  { 98, 6, 0, 0, 240 },  // google.pn
+  { 310, 3, 1, 778, kNoHSTSPreload },  // com.pr
+  { 98, 6, 0, 0, 241 },  // google.ps
+  { 98, 6, 0, 0, 242 },  // google.pt
+  { 518, 4, 1, 779, kNoHSTSPreload },  // sapo.pt
+  { 310, 3, 1, 780, kNoHSTSPreload },  // com.py
+  { 310, 3, 1, 781, kNoHSTSPreload },  // com.qa
+  { 98, 6, 0, 0, 243 },  // google.ro
+  { 98, 6, 0, 0, 244 },  // google.rs
+  { 310, 3, 1, 782, kNoHSTSPreload },  // com.ru
+  { 98, 6, 0, 0, 245 },  // google.ru
+  { 98, 6, 0, 0, 246 },  // google.rw
+  { 310, 3, 1, 783, kNoHSTSPreload },  // com.sa
+  { 310, 3, 1, 784, kNoHSTSPreload },  // com.sb
+  { 98, 6, 0, 0, 247 },  // google.sc
+  { 1677, 4, 0, 0, 305 },  // cert.se
+  { 98, 6, 0, 0, 248 },  // google.se
+  { 1070, 8, 0, 0, 441 },  // logotype.se
+  { 310, 3, 1, 785, kNoHSTSPreload },  // com.sg
+  { 98, 6, 0, 0, 249 },  // google.sh
+  { 1094, 8, 0, 0, 456 },  // mediacru.sh
+  { 98, 6, 0, 0, 250 },  // google.si
+  { 98, 6, 0, 0, 251 },  // google.sk
+  { 310, 3, 1, 786, kNoHSTSPreload },  // com.sl
+  { 98, 6, 0, 0, 252 },  // google.sm
+  { 98, 6, 0, 0, 253 },  // google.sn
+  { 98, 6, 0, 0, 254 },  // google.so
+  { 98, 6, 0, 0, 255 },  // google.st
+  { 310, 3, 1, 787, kNoHSTSPreload },  // com.sv
+  { 98, 6, 0, 0, 256 },  // google.td
+  { 98, 6, 0, 0, 257 },  // google.tg
+  { 53, 2, 1, 788, kNoHSTSPreload },  // co.th
+  { 310, 3, 1, 789, kNoHSTSPreload },  // com.tj
+  { 98, 6, 0, 0, 258 },  // google.tk
+  { 98, 6, 0, 0, 259 },  // google.tl
+  { 98, 6, 0, 0, 260 },  // google.tm
+  { 310, 3, 1, 790, kNoHSTSPreload },  // com.tn
+  { 98, 6, 0, 0, 261 },  // google.tn
+  { 98, 6, 0, 0, 262 },  // google.to
+  { 98, 6, 0, 0, 263 },  // google.tp
+  { 310, 3, 1, 791, kNoHSTSPreload },  // com.tr
+  { 98, 6, 0, 0, 264 },  // google.tt
+  { 310, 3, 1, 792, kNoHSTSPreload },  // com.tw
+  { 53, 2, 1, 793, kNoHSTSPreload },  // co.tz
+  { 310, 3, 1, 794, kNoHSTSPreload },  // com.ua
+  { 53, 2, 1, 795, kNoHSTSPreload },  // co.ug
+  { 53, 2, 3, 796, kNoHSTSPreload },  // co.uk
+  { 1750, 3, 1, 799, kNoHSTSPreload },  // gov.uk
+  { 98, 6, 0, 0, 265 },  // google.us
+  { 1314, 7, 0, 0, 455 },  // mudcrab.us
+  { 310, 3, 1, 800, kNoHSTSPreload },  // com.uy
+  { 53, 2, 1, 801, kNoHSTSPreload },  // co.uz
+  { 98, 6, 0, 0, 266 },  // google.uz
+  { 310, 3, 1, 802, kNoHSTSPreload },  // com.vc
+  { 53, 2, 1, 803, kNoHSTSPreload },  // co.ve
+  { 310, 3, 1, 804, kNoHSTSPreload },  // com.ve
+  { 98, 6, 0, 0, 267 },  // google.vg
+  { 53, 2, 1, 805, kNoHSTSPreload },  // co.vi
+  { 310, 3, 2, 806, kNoHSTSPreload },  // com.vn
+  { 98, 6, 0, 0, 268 },  // google.vu
+  { 98, 6, 0, 0, 269 },  // google.ws
+  { 53, 2, 1, 808, kNoHSTSPreload },  // co.za
+  { 53, 2, 1, 809, kNoHSTSPreload },  // co.zm
+  { 53, 2, 1, 810, kNoHSTSPreload },  // co.zw
+  { 98, 6, 0, 0, 108 },  // google.com.af
+  { 98, 6, 0, 0, 109 },  // google.com.ag
+  { 98, 6, 0, 0, 110 },  // google.com.ai
+  { 98, 6, 0, 0, 237 },  // google.off.ai
+  { 98, 6, 0, 0, 81 },  // google.co.ao
+  { 98, 6, 0, 0, 206 },  // google.it.ao
+  { 98, 6, 0, 0, 111 },  // google.com.ar
+  { 1195, 7, 0, 0, 458 },  // cloudns.com.au
+  { 1014, 8, 0, 0, 375 },  // fatzebra.com.au
+  { 98, 6, 0, 0, 112 },  // google.com.au
+  { 98, 6, 0, 0, 113 },  // google.com.bd
+  { 98, 6, 0, 0, 114 },  // google.com.bh
+  { 1774, 3, 0, 0, 273 },  // www.elanex.biz
+  { 98, 6, 0, 0, 115 },  // google.com.bn
+  { 98, 6, 0, 0, 116 },  // google.com.bo
+  { 1564, 5, 0, 0, 354 },  // arivo.com.br
+  { 98, 6, 0, 0, 117 },  // google.com.br
+  { 98, 6, 0, 0, 82 },  // google.co.bw
+  { 98, 6, 0, 0, 118 },  // google.com.by
+  { 98, 6, 0, 0, 119 },  // google.com.bz
+  { 1744, 3, 0, 0, 397 },  // crm.onlime.ch
+  { 698, 2, 0, 0, 395 },  // my.onlime.ch
+  { 1377, 7, 0, 0, 396 },  // webmail.onlime.ch
+  { 98, 6, 0, 0, 83 },  // google.co.ck
+  { 98, 6, 0, 0, 120 },  // google.com.cn
+  { 98, 6, 0, 0, 121 },  // google.com.co
+  { 698, 2, 0, 0, 402 },  // my.alfresco.com
+  { 1451, 6, 0, 0, 21 },  // market.android.com
+  { 1774, 3, 0, 0, 355 },  // www.apollo-auto.com
+  { 290, 14, 0, 0, 286 },  // aladdinschools.appspot.com
+  { 0, 24, 0, 0, 28 },  // chrome-devtools-frontend.appspot.com
+  { 45, 18, 0, 0, 27 },  // chromiumcodereview.appspot.com
+  { 53, 10, 0, 0, 29 },  // codereview.appspot.com
+  { 1634, 5, 0, 0, 459 },  // oplop.appspot.com
+  { 596, 11, 0, 0, 0 },  // pinningtest.appspot.com
+  { 375, 2, 0, 0, 468 },  // id.atlassian.com
+  { 1774, 3, 0, 0, 350 },  // www.braintreepayments.com
+  { 1774, 3, 0, 0, 356 },  // www.cueup.com
+  { 1673, 4, 0, 0, 446 },  // blog.cyveillance.com
+  { 1774, 3, 0, 0, 445 },  // www.cyveillance.com
+  { 1774, 3, 0, 0, 310 },  // www.dropcam.com
+  { 1774, 3, 0, 0, 481 },  // www.gmail.com
+  { 918, 8, 0, 0, 10 },  // accounts.google.com
+  { 654, 4, 1, 811, 26 },  // apis.google.com
+  { 738, 9, 0, 0, 8 },  // appengine.google.com
+  { 982, 8, 0, 0, 3 },  // checkout.google.com
+  { 0, 6, 0, 0, 4 },  // chrome.google.com
+  { 53, 4, 0, 0, 31 },  // code.google.com
+  { 1681, 4, 2, 812, kNoHSTSPreload },  // corp.google.com
+  { 556, 2, 0, 0, 33 },  // dl.google.com
+  { 1689, 4, 0, 0, 5 },  // docs.google.com
+  { 1589, 5, 0, 0, 23 },  // drive.google.com
+  { 801, 9, 0, 0, 9 },  // encrypted.google.com
+  { 429, 6, 0, 0, 25 },  // groups.google.com
+  { 1244, 7, 0, 0, 19 },  // history.google.com
+  { 213, 16, 0, 0, 15 },  // hostedtalkgadget.google.com
+  { 64, 4, 0, 0, 12 },  // mail.google.com
+  { 1725, 4, 0, 0, 16 },  // plus.google.com
+  { 1118, 8, 0, 0, 11 },  // profiles.google.com
+  { 1349, 7, 1, 814, kNoHSTSPreload },  // sandbox.google.com
+  { 1511, 6, 0, 0, 18 },  // script.google.com
+  { 29, 8, 0, 0, 20 },  // security.google.com
+  { 1654, 5, 0, 0, 6 },  // sites.google.com
+  { 495, 12, 0, 0, 7 },  // spreadsheets.google.com
+  { 219, 4, 0, 0, 14 },  // talk.google.com
+  { 219, 10, 0, 0, 13 },  // talkgadget.google.com
+  { 1547, 6, 0, 0, 2 },  // wallet.google.com
+  { 1068, 3, 0, 0, 22 },  // ssl.google-analytics.com
+  { 909, 9, 0, 0, 34 },  // translate.googleapis.com
+  { 1774, 3, 0, 0, 482 },  // www.googlemail.com
+  { 1774, 3, 0, 0, 427 },  // www.grc.com
+  { 1774, 3, 0, 0, 324 },  // www.greplin.com
+  { 1068, 3, 0, 0, 46 },  // ssl.gstatic.com
+  { 1756, 3, 0, 0, 379 },  // iop.intuit.com
+  { 1559, 5, 0, 0, 363 },  // alpha.irccloud.com
+  { 1774, 3, 0, 0, 362 },  // www.irccloud.com
+  { 1774, 3, 0, 0, 290 },  // www.lastpass.com
+  { 1265, 7, 0, 0, 476 },  // liberty.lavabit.com
+  { 1673, 4, 0, 0, 431 },  // blog.linode.com
+  { 1599, 5, 0, 0, 433 },  // forum.linode.com
+  { 1272, 7, 0, 0, 432 },  // library.linode.com
+  { 1286, 7, 0, 0, 430 },  // manager.linode.com
+  { 68, 1, 0, 0, 434 },  // p.linode.com
+  { 1102, 5, 0, 0, 435 },  // paste.linode.com
+  { 1102, 8, 0, 0, 436 },  // pastebin.linode.com
+  { 1774, 3, 0, 0, 429 },  // www.linode.com
+  { 1774, 3, 0, 0, 296 },  // www.logentries.com
+  { 870, 2, 0, 0, 387 },  // dm.lookout.com
+  { 1774, 3, 0, 0, 384 },  // www.lookout.com
+  { 1774, 3, 0, 0, 318 },  // www.moneybookers.com
+  { 783, 9, 1, 815, 331 },  // developer.mydigipass.com
+  { 1349, 7, 1, 816, 333 },  // sandbox.mydigipass.com
+  { 1774, 3, 0, 0, 330 },  // www.mydigipass.com
+  { 870, 2, 0, 0, 388 },  // dm.mylookout.com
+  { 1774, 3, 0, 0, 386 },  // www.mylookout.com
+  { 1445, 6, 0, 0, 325 },  // luneta.nearbuysystems.com
+  { 1644, 5, 0, 0, 369 },  // shops.neonisi.com
+  { 1774, 3, 0, 0, 368 },  // www.neonisi.com
+  { 1068, 3, 0, 0, 415 },  // ssl.panoramio.com
+  { 1774, 3, 0, 0, 288 },  // www.paycheckrecords.com
+  { 1774, 3, 0, 0, 271 },  // www.paypal.com
+  { 1599, 5, 0, 0, 449 },  // forum.quantifiedself.com
+  { 373, 3, 0, 0, 322 },  // api.recurly.com
+  { 149, 3, 0, 0, 321 },  // app.recurly.com
+  { 855, 9, 0, 0, 391 },  // openshift.redhat.com
+  { 373, 3, 0, 0, 422 },  // api.simple.com
+  { 443, 4, 0, 0, 423 },  // bank.simple.com
+  { 1815, 2, 0, 0, 421 },  // fj.simple.com
+  { 1774, 3, 0, 0, 420 },  // www.simple.com
+  { 1774, 3, 0, 0, 381 },  // www.surfeasy.com
+  { 1774, 3, 0, 0, 393 },  // www.therapynotes.com
+  { 1765, 3, 0, 0, 346 },  // si0.twimg.com
+  { 373, 3, 0, 0, 340 },  // api.twitter.com
+  { 958, 8, 0, 0, 344 },  // business.twitter.com
+  { 7, 3, 0, 0, 343 },  // dev.twitter.com
+  { 1469, 6, 0, 0, 342 },  // mobile.twitter.com
+  { 1629, 5, 0, 0, 341 },  // oauth.twitter.com
+  { 1110, 8, 0, 0, 345 },  // platform.twitter.com
+  { 1774, 3, 0, 0, 339 },  // www.twitter.com
+  { 98, 6, 0, 0, 84 },  // google.co.cr
+  { 98, 6, 0, 0, 122 },  // google.com.cu
+  { 98, 6, 0, 0, 123 },  // google.com.cy
+  { 1774, 3, 0, 0, 293 },  // www.entropia.de
+  { 346, 13, 0, 0, 418 },  // controlcenter.gigahost.dk
+  { 90, 3, 0, 0, 417 },  // pay.gigahost.dk
+  { 1377, 7, 0, 0, 403 },  // webmail.gigahost.dk
+  { 98, 6, 0, 0, 124 },  // google.com.do
+  { 98, 6, 0, 0, 125 },  // google.com.ec
+  { 1202, 7, 0, 0, 376 },  // csawctf.poly.edu
+  { 98, 6, 0, 0, 126 },  // google.com.eg
+  { 98, 6, 0, 0, 127 },  // google.com.et
+  { 98, 6, 0, 0, 128 },  // google.com.fj
+  { 98, 6, 0, 0, 129 },  // google.com.ge
+  { 98, 6, 0, 0, 130 },  // google.com.gh
+  { 98, 6, 0, 0, 131 },  // google.com.gi
+  { 98, 6, 0, 0, 132 },  // google.com.gr
+  { 98, 6, 0, 0, 133 },  // google.com.gt
+  { 98, 6, 0, 0, 134 },  // google.com.hk
+  { 98, 6, 0, 0, 85 },  // google.co.hu
+  { 98, 6, 0, 0, 86 },  // google.co.id
+  { 98, 6, 0, 0, 87 },  // google.co.il
+  { 98, 6, 0, 0, 88 },  // google.co.im
+  { 98, 6, 0, 0, 89 },  // google.co.in
+  { 373, 3, 0, 0, 373 },  // api.intercom.io
+  { 1774, 3, 0, 0, 374 },  // www.intercom.io
+  { 98, 6, 0, 0, 135 },  // google.com.iq
+  { 98, 6, 0, 0, 90 },  // google.co.je
+  { 98, 6, 0, 0, 136 },  // google.com.jm
+  { 98, 6, 0, 0, 137 },  // google.com.jo
+  { 98, 6, 0, 0, 91 },  // google.co.jp
+  { 98, 6, 0, 0, 231 },  // google.ne.jp
+  { 98, 6, 0, 0, 92 },  // google.co.ke
+  { 98, 6, 0, 0, 138 },  // google.com.kh
+  { 98, 6, 0, 0, 93 },  // google.co.kr
+  { 98, 6, 0, 0, 139 },  // google.com.kw
+  { 98, 6, 0, 0, 140 },  // google.com.lb
+  { 98, 6, 0, 0, 94 },  // google.co.ls
+  { 98, 6, 0, 0, 141 },  // google.com.ly
+  { 98, 6, 0, 0, 95 },  // google.co.ma
+  { 98, 6, 0, 0, 142 },  // google.com.mt
+  { 1293, 7, 1, 817, kNoHSTSPreload },  // medbank.com.mt
+  { 98, 6, 0, 0, 143 },  // google.com.mx
+  { 98, 6, 0, 0, 144 },  // google.com.my
+  { 98, 6, 0, 0, 96 },  // google.co.mz
+  { 98, 6, 0, 0, 145 },  // google.com.na
+  { 1649, 5, 0, 0, 307 },  // simon.butcher.name
+  { 1150, 8, 0, 0, 347 },  // twimg0-a.akamaihd.net
+  { 792, 9, 0, 0, 467 },  // ecosystem.atlassian.net
+  { 1619, 5, 0, 0, 270 },  // learn.doubleclick.net
+  { 1774, 3, 0, 0, 320 },  // www.ledgerscope.net
+  { 411, 12, 0, 0, 336 },  // bigshinylock.minazo.net
+  { 1300, 7, 0, 0, 414 },  // members.nearlyfreespeech.net
+  { 1774, 3, 0, 0, 276 },  // www.noisebridge.net
+  { 98, 6, 0, 0, 146 },  // google.com.nf
+  { 98, 6, 0, 0, 147 },  // google.com.ng
+  { 98, 6, 0, 0, 148 },  // google.com.ni
+  { 98, 6, 0, 0, 149 },  // google.com.np
+  { 98, 6, 0, 0, 150 },  // google.com.nr
+  { 98, 6, 0, 0, 97 },  // google.co.nz
+  { 1709, 4, 1, 818, 409 },  // mega.co.nz
+  { 98, 6, 0, 0, 151 },  // google.com.om
+  { 53, 10, 0, 0, 30 },  // codereview.chromium.org
+  { 990, 8, 0, 0, 359 },  // download.jitsi.org
+  { 1774, 3, 0, 0, 358 },  // www.jitsi.org
+  { 1774, 3, 0, 0, 378 },  // www.makeyourlaws.org
+  { 375, 2, 0, 0, 282 },  // id.mayfirst.org
+  { 1624, 5, 0, 0, 283 },  // lists.mayfirst.org
+  { 1300, 7, 0, 0, 280 },  // members.mayfirst.org
+  { 900, 9, 0, 0, 285 },  // roundcube.mayfirst.org
+  { 1356, 7, 0, 0, 281 },  // support.mayfirst.org
+  { 1377, 7, 0, 0, 284 },  // webmail.mayfirst.org
+  { 950, 8, 0, 0, 413 },  // bugzilla.mozilla.org
+  { 478, 5, 0, 0, 366 },  // login.persona.org
+  { 1737, 4, 0, 0, 461 },  // wiki.python.org
+  { 1673, 4, 0, 0, 314 },  // blog.torproject.org
+  { 263, 5, 0, 0, 315 },  // check.torproject.org
+  { 1685, 4, 0, 0, 317 },  // dist.torproject.org
+  { 1774, 3, 0, 0, 316 },  // www.torproject.org
+  { 98, 6, 0, 0, 152 },  // google.com.pa
+  { 98, 6, 0, 0, 153 },  // google.com.pe
+  { 98, 6, 0, 0, 154 },  // google.com.ph
+  { 98, 6, 0, 0, 155 },  // google.com.pk
+  { 98, 6, 0, 0, 156 },  // google.com.pl
+  { 98, 6, 0, 0, 157 },  // google.com.pr
+  { 478, 5, 0, 0, 299 },  // login.sapo.pt
+  { 98, 6, 0, 0, 158 },  // google.com.py
+  { 98, 6, 0, 0, 159 },  // google.com.qa
+  { 98, 6, 0, 0, 160 },  // google.com.ru
+  { 98, 6, 0, 0, 161 },  // google.com.sa
+  { 98, 6, 0, 0, 162 },  // google.com.sb
+  { 98, 6, 0, 0, 163 },  // google.com.sg
+  { 98, 6, 0, 0, 164 },  // google.com.sl
+  { 98, 6, 0, 0, 165 },  // google.com.sv
+  { 98, 6, 0, 0, 98 },  // google.co.th
+  { 98, 6, 0, 0, 166 },  // google.com.tj
+  { 98, 6, 0, 0, 167 },  // google.com.tn
+  { 98, 6, 0, 0, 168 },  // google.com.tr
+  { 98, 6, 0, 0, 169 },  // google.com.tw
+  { 98, 6, 0, 0, 99 },  // google.co.tz
+  { 98, 6, 0, 0, 170 },  // google.com.ua
+  { 98, 6, 0, 0, 100 },  // google.co.ug
+  { 974, 8, 0, 0, 444 },  // carlolly.co.uk
+  { 98, 6, 0, 0, 101 },  // google.co.uk
+  { 607, 11, 0, 0, 465 },  // saturngames.co.uk
+  { 1774, 3, 0, 0, 398 },  // www.gov.uk
+  { 98, 6, 0, 0, 171 },  // google.com.uy
+  { 98, 6, 0, 0, 102 },  // google.co.uz
+  { 98, 6, 0, 0, 172 },  // google.com.vc
+  { 98, 6, 0, 0, 103 },  // google.co.ve
+  { 98, 6, 0, 0, 173 },  // google.com.ve
+  { 98, 6, 0, 0, 104 },  // google.co.vi
+  { 98, 6, 0, 0, 174 },  // google.com.vn
+  { 435, 12, 1, 819, kNoHSTSPreload },  // indovinabank.com.vn
+  { 98, 6, 0, 0, 105 },  // google.co.za
+  { 98, 6, 0, 0, 106 },  // google.co.zm
+  { 98, 6, 0, 0, 107 },  // google.co.zw
+  { 1574, 5, 0, 0, 35 },  // chart.apis.google.com
+  { 864, 9, 0, 0, 37 },  // oraprodmv.corp.google.com
+  { 708, 10, 0, 0, 36 },  // oraprodsso.corp.google.com
+  { 1725, 4, 0, 0, 17 },  // plus.sandbox.google.com
+  { 1774, 3, 0, 0, 332 },  // www.developer.mydigipass.com
+  { 1774, 3, 0, 0, 334 },  // www.sandbox.mydigipass.com
+  { 958, 8, 0, 0, 353 },  // business.medbank.com.mt
+  { 373, 3, 0, 0, 410 },  // api.mega.co.nz
+  { 998, 8, 0, 0, 311 },  // ebanking.indovinabank.com.vn
+};
+
+// The maximum number of labels of the names in kHSTSPreloads.
+static const size_t kHSTSPreloadTrieMaxDepth = 4;
 
 #endif // NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
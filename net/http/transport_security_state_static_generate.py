@@ -0,0 +1,312 @@
+#!/usr/bin/env python
+# Copyright 2013 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Generates transport_security_state_static.h.
+
+The SPKI hashes and pinsets come from transport_security_state_static.certs
+and the pinsets of transport_security_state_static.json. The preloaded HSTS
+entries of the json file become a table of compact entries, indexed by a trie
+of the reversed labels of their names, so that looking up a host takes one
+walk from its last label instead of a scan of all the entries for each of its
+suffixes.
+
+Usage:
+  transport_security_state_static_generate.py [output_file]
+
+The output defaults to transport_security_state_static.h next to this script.
+"""
+
+import base64
+import hashlib
+import json
+import os
+import re
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+JSON_FILE = os.path.join(SCRIPT_DIR, 'transport_security_state_static.json')
+CERTS_FILE = os.path.join(SCRIPT_DIR, 'transport_security_state_static.certs')
+OUTPUT_FILE = os.path.join(SCRIPT_DIR, 'transport_security_state_static.h')
+
+HEADER = """\
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is automatically generated by
+// transport_security_state_static_generate.py
+
+#ifndef NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
+#define NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
+
+// These are SubjectPublicKeyInfo hashes for public key pinning. The
+// hashes are SHA1 digests.
+
+"""
+
+FOOTER = """\
+#endif // NET_HTTP_TRANSPORT_SECURITY_STATE_STATIC_H_
+"""
+
+# The most children a trie node can have.
+TRIE_MAX_CHILDREN = 0xff
+
+
+def ReadJson(path):
+  with open(path) as f:
+    text = f.read()
+  # The file has comments, which json doesn't allow.
+  return json.loads(re.sub(r'^\s*//.*$', '', text, flags=re.MULTILINE))
+
+
+def ReadDerLength(der, offset):
+  """Returns the length of the DER element at |offset|, and the offset of
+  its contents."""
+  length = ord(der[offset + 1:offset + 2])
+  offset += 2
+  if length & 0x80:
+    num_bytes = length & 0x7f
+    length = 0
+    for i in range(num_bytes):
+      length = (length << 8) | ord(der[offset + i:offset + i + 1])
+    offset += num_bytes
+  return length, offset
+
+
+def SkipDerElement(der, offset):
+  length, contents = ReadDerLength(der, offset)
+  return contents + length
+
+
+def GetSPKI(der):
+  """Returns the SubjectPublicKeyInfo of the DER certificate |der|."""
+  # Certificate ::= SEQUENCE { tbsCertificate, ... }
+  _, offset = ReadDerLength(der, 0)
+  # TBSCertificate ::= SEQUENCE { [0] version OPTIONAL, serialNumber,
+  #     signature, issuer, validity, subject, subjectPublicKeyInfo, ... }
+  _, offset = ReadDerLength(der, offset)
+  if der[offset:offset + 1] == b'\xa0':
+    offset = SkipDerElement(der, offset)
+  for _ in range(5):
+    offset = SkipDerElement(der, offset)
+  return der[offset:SkipDerElement(der, offset)]
+
+
+def ReadCerts(path):
+  """Returns a list of (name, SHA1 hash of the SPKI) pairs."""
+  with open(path) as f:
+    lines = [line.rstrip('\n') for line in f]
+  certs = []
+  name = None
+  pem = None
+  for line in lines:
+    if pem is not None:
+      if line == '-----END CERTIFICATE-----':
+        der = base64.b64decode(''.join(pem))
+        certs.append((name, hashlib.sha1(GetSPKI(der)).digest()))
+        name = None
+        pem = None
+      else:
+        pem.append(line)
+    elif not line or line.startswith('#'):
+      continue
+    elif name is None:
+      name = line
+    elif line.startswith('sha1/'):
+      certs.append((name, base64.b64decode(line[len('sha1/'):])))
+      name = None
+    elif line == '-----BEGIN CERTIFICATE-----':
+      pem = []
+    else:
+      raise ValueError('Unexpected line in %s: %s' % (path, line))
+  return certs
+
+
+def CEscapeBytes(data):
+  return ''.join('\\x%02x' % b for b in bytearray(data))
+
+
+def PinsetMacro(pinset_name):
+  return 'k%s%sPins' % (pinset_name[0].upper(), pinset_name[1:])
+
+
+def PinsetArray(pinset_name, suffix):
+  return 'k%s%s%s' % (pinset_name[0].upper(), pinset_name[1:], suffix)
+
+
+def SecondLevelDomainName(name):
+  labels = name.split('.')[-2:]
+  return 'DOMAIN_' + '_'.join(labels).upper().replace('-', '_')
+
+
+def WriteHashes(out, certs):
+  for name, digest in certs:
+    out.append('static const char kSPKIHash_%s[] =\n' % name)
+    out.append('    "%s"\n' % CEscapeBytes(digest[:10]))
+    out.append('    "%s";\n\n' % CEscapeBytes(digest[10:]))
+
+
+def WritePinsets(out, pinsets):
+  out.append('\n// The following is static data describing the hosts that are '
+             'hardcoded with\n// certificate pins or HSTS information.\n\n')
+  out.append('// kNoRejectedPublicKeys is a placeholder for when no public keys '
+             'are rejected.\n')
+  out.append('static const char* const kNoRejectedPublicKeys[] = {\n'
+             '  NULL,\n};\n\n')
+  for pinset in pinsets:
+    name = pinset['name']
+    out.append('static const char* const %s[] = {\n' %
+               PinsetArray(name, 'AcceptableCerts'))
+    for spki in pinset['static_spki_hashes']:
+      out.append('  kSPKIHash_%s,\n' % spki)
+    out.append('  NULL,\n};\n')
+    rejected = 'kNoRejectedPublicKeys'
+    if pinset.get('bad_static_spki_hashes'):
+      rejected = PinsetArray(name, 'RejectedCerts')
+      out.append('static const char* const %s[] = {\n' % rejected)
+      for spki in pinset['bad_static_spki_hashes']:
+        out.append('  kSPKIHash_%s,\n' % spki)
+      out.append('  NULL,\n};\n')
+    out.append('#define %s { \\\n  %s, \\\n  %s, \\\n}\n\n' %
+               (PinsetMacro(name), PinsetArray(name, 'AcceptableCerts'),
+                rejected))
+  out.append('#define kNoPins {\\\n  NULL, NULL, \\\n}\n\n')
+
+  out.append('// Indexed by HSTSPreload.pins.\n')
+  out.append('static const struct PublicKeyPins kPinsets[] = {\n')
+  out.append('  kNoPins,\n')
+  for pinset in pinsets:
+    out.append('  %s,\n' % PinsetMacro(pinset['name']))
+  out.append('};\n\n')
+
+
+def WriteEntries(out, entries, pinsets):
+  pinset_indices = dict((pinset['name'], i + 1)
+                        for i, pinset in enumerate(pinsets))
+  out.append('static const struct HSTSPreload kHSTSPreloads[] = {\n')
+  for entry in entries:
+    pins = entry.get('pins')
+    out.append('  { %s, %s, %s, %d, %s },  // %s\n' % (
+        str(entry.get('include_subdomains', False)).lower(),
+        str(entry.get('mode') == 'force-https').lower(),
+        str(entry.get('snionly', False)).lower(),
+        pinset_indices[pins] if pins else 0,
+        SecondLevelDomainName(entry['name']) if pins else 'DOMAIN_NOT_PINNED',
+        entry['name']))
+  out.append('};\n\n')
+
+
+class TrieNode(object):
+  def __init__(self, label):
+    self.label = label
+    self.children = {}
+    self.entry = None
+
+
+def BuildTrie(entries):
+  root = TrieNode('')
+  for index, entry in enumerate(entries):
+    name = entry['name']
+    if name != name.lower():
+      raise ValueError('%s is not in lower case' % name)
+    node = root
+    for label in reversed(name.split('.')):
+      if label not in node.children:
+        node.children[label] = TrieNode(label)
+      node = node.children[label]
+    if node.entry is not None:
+      raise ValueError('%s is listed twice' % name)
+    node.entry = index
+  return root
+
+
+def BuildLabelPool(root):
+  """Returns a string holding all the labels of the trie, and a dict of their
+  offsets in it."""
+  labels = set()
+  queue = [root]
+  while queue:
+    node = queue.pop()
+    labels.update(node.children)
+    queue.extend(node.children.values())
+  pool = ''
+  offsets = {}
+  # Longer labels first, so that shorter ones can be found inside them.
+  for label in sorted(labels, key=lambda label: (-len(label), label)):
+    offset = pool.find(label)
+    if offset < 0:
+      offset = len(pool)
+      pool += label
+    offsets[label] = offset
+  return pool, offsets
+
+
+def WriteTrie(out, root):
+  pool, label_offsets = BuildLabelPool(root)
+  if len(pool) > 0xffff:
+    raise ValueError('Too many labels for 16 bit offsets')
+
+  # Lay the nodes out breadth first, so that the children of each node are
+  # next to each other, in order.
+  nodes = []
+  queue = [('', root)]
+  max_depth = 0
+  while queue:
+    name, node = queue.pop(0)
+    if len(node.children) > TRIE_MAX_CHILDREN:
+      raise ValueError('Too many children for %s' % name)
+    first_child = len(nodes) + len(queue) + 1 if node.children else 0
+    nodes.append((name, node, first_child))
+    if name:
+      max_depth = max(max_depth, name.count('.') + 1)
+    for label in sorted(node.children):
+      child_name = label + '.' + name if name else label
+      queue.append((child_name, node.children[label]))
+  if len(nodes) > 0xffff:
+    raise ValueError('Too many nodes for 16 bit indices')
+
+  out.append('// kHSTSPreloadLabels holds the labels of the names in '
+             'kHSTSPreloads.\n')
+  out.append('static const char kHSTSPreloadLabels[] =\n')
+  for i in range(0, len(pool), 72):
+    out.append('    "%s"%s\n' % (pool[i:i + 72],
+                                 ';' if i + 72 >= len(pool) else ''))
+  out.append('\n')
+
+  out.append('// kHSTSPreloadTrie is a trie of the reversed labels of the names '
+             'in\n// kHSTSPreloads. The root comes first, and the children of '
+             'each node are\n// next to each other, sorted by label.\n')
+  out.append('static const struct HSTSPreloadTrieNode kHSTSPreloadTrie[] = {\n')
+  for name, node, first_child in nodes:
+    out.append('  { %d, %d, %d, %d, %s },  // %s\n' % (
+        label_offsets[node.label] if node.label else 0, len(node.label),
+        len(node.children), first_child,
+        node.entry if node.entry is not None else 'kNoHSTSPreload',
+        name or '(root)'))
+  out.append('};\n\n')
+  out.append('// The maximum number of labels of the names in kHSTSPreloads.\n')
+  out.append('static const size_t kHSTSPreloadTrieMaxDepth = %d;\n\n' %
+             max_depth)
+
+
+def main(argv):
+  output_file = argv[1] if len(argv) > 1 else OUTPUT_FILE
+  preloads = ReadJson(JSON_FILE)
+  certs = ReadCerts(CERTS_FILE)
+
+  out = [HEADER]
+  WriteHashes(out, certs)
+  WritePinsets(out, preloads['pinsets'])
+  WriteEntries(out, preloads['entries'], preloads['pinsets'])
+  WriteTrie(out, BuildTrie(preloads['entries']))
+  out.append(FOOTER)
+
+  with open(output_file, 'w') as f:
+    f.write(''.join(out))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))
@@ -485,6 +485,36 @@ TEST_F(TransportSecurityStateTest, LongNames) {
   EXPECT_FALSE(state.GetDomainState(kLongName, true, &domain_state));
 }
 
+TEST_F(TransportSecurityStateTest, PreloadedDeepSubdomains) {
+  TransportSecurityState state;
+  TransportSecurityState::DomainState domain_state;
+
+  // More labels than any preloaded name has.
+  EXPECT_TRUE(state.GetDomainState("a.b.c.d.e.f.g.h.docs.google.com", true,
+                                   &domain_state));
+  EXPECT_EQ("docs.google.com", domain_state.domain);
+  EXPECT_TRUE(domain_state.ShouldUpgradeToSSL());
+  EXPECT_TRUE(domain_state.HasPublicKeyPins());
+
+  // paypal.com doesn't include subdomains.
+  EXPECT_FALSE(state.GetDomainState("a.b.c.d.e.f.g.h.www.paypal.com", true,
+                                    &domain_state));
+}
+
+TEST_F(TransportSecurityStateTest, PreloadedLabelsMatchExactly) {
+  // Labels which are prefixes or extensions of preloaded labels.
+  EXPECT_FALSE(HasState("googl.com"));
+  EXPECT_FALSE(HasState("googlee.com"));
+  EXPECT_FALSE(HasState("oogle.com"));
+  EXPECT_FALSE(HasState("google.co"));
+  EXPECT_FALSE(HasState("google.comm"));
+  EXPECT_FALSE(HasState("com"));
+  EXPECT_FALSE(HasState("google"));
+
+  EXPECT_TRUE(HasState("WWW.Google.COM"));
+  EXPECT_TRUE(HasState("google.com."));
+}
+
 TEST_F(TransportSecurityStateTest, BuiltinCertPins) {
   TransportSecurityState state;
   TransportSecurityState::DomainState domain_state;
@@ -100,6 +100,8 @@
         'base/crypto_module_openssl.cc',
         'base/data_url.cc',
         'base/data_url.h',
+        'base/deflate_dictionary.cc',
+        'base/deflate_dictionary.h',
         'base/directory_lister.cc',
         'base/directory_lister.h',
         'base/dns_reloader.cc',
@@ -168,6 +170,8 @@
         'base/net_log.h',
         'base/net_log_logger.cc',
         'base/net_log_logger.h',
+        'base/net_log_ring_buffer.cc',
+        'base/net_log_ring_buffer.h',
         'base/net_log_event_type_list.h',
         'base/net_log_source_type_list.h',
         'base/net_module.cc',
@@ -268,12 +272,15 @@
         'cert/cert_verify_proc_win.h',
         'cert/cert_verify_result.cc',
         'cert/cert_verify_result.h',
+        'cert/cert_verify_result_store.h',
         'cert/crl_set.cc',
         'cert/crl_set.h',
         'cert/ct_serialization.cc',
         'cert/ct_serialization.h',
         'cert/ev_root_ca_metadata.cc',
         'cert/ev_root_ca_metadata.h',
+        'cert/file_cert_verify_result_store.cc',
+        'cert/file_cert_verify_result_store.h',
         'cert/jwk_serializer_nss.cc',
         'cert/jwk_serializer_openssl.cc',
         'cert/jwk_serializer.h',
@@ -464,6 +471,8 @@
         'dns/dns_transaction.h',
         'dns/host_cache.cc',
         'dns/host_cache.h',
+        'dns/host_cache_persister.cc',
+        'dns/host_cache_persister.h',
         'dns/host_resolver.cc',
         'dns/host_resolver.h',
         'dns/host_resolver_impl.cc',
@@ -557,6 +566,8 @@
         'http/http_byte_range.h',
         'http/http_cache.cc',
         'http/http_cache.h',
+        'http/http_cache_compression.cc',
+        'http/http_cache_compression.h',
         'http/http_cache_transaction.cc',
         'http/http_cache_transaction.h',
         'http/http_content_disposition.cc',
@@ -706,6 +717,8 @@
         'proxy/proxy_service.h',
         'quic/congestion_control/available_channel_estimator.cc',
         'quic/congestion_control/available_channel_estimator.h',
+        'quic/congestion_control/bbr_sender.cc',
+        'quic/congestion_control/bbr_sender.h',
         'quic/congestion_control/channel_estimator.cc',
         'quic/congestion_control/channel_estimator.h',
         'quic/congestion_control/cube_root.cc',
@@ -773,6 +786,7 @@
         'quic/crypto/curve25519_key_exchange.cc',
         'quic/crypto/curve25519_key_exchange.h',
         'quic/crypto/ephemeral_key_source.h',
+        'quic/crypto/handshake_worker_pool.h',
         'quic/crypto/key_exchange.h',
         'quic/crypto/null_decrypter.cc',
         'quic/crypto/null_decrypter.h',
@@ -898,6 +912,8 @@
         'socket/client_socket_pool_manager.h',
         'socket/client_socket_pool_manager_impl.cc',
         'socket/client_socket_pool_manager_impl.h',
+        'socket/connection_prewarm_model.cc',
+        'socket/connection_prewarm_model.h',
         'socket/next_proto.h',
         'socket/nss_ssl_util.cc',
         'socket/nss_ssl_util.h',
@@ -958,6 +974,16 @@
         'socket_stream/socket_stream_metrics.h',
         'spdy/buffered_spdy_framer.cc',
         'spdy/buffered_spdy_framer.h',
+        'spdy/hpack_constants.cc',
+        'spdy/hpack_constants.h',
+        'spdy/hpack_decoder.cc',
+        'spdy/hpack_decoder.h',
+        'spdy/hpack_encoder.cc',
+        'spdy/hpack_encoder.h',
+        'spdy/hpack_header_table.cc',
+        'spdy/hpack_header_table.h',
+        'spdy/hpack_huffman_table.cc',
+        'spdy/hpack_huffman_table.h',
         'spdy/spdy_bitmasks.h',
         'spdy/spdy_buffer.cc',
         'spdy/spdy_buffer.h',
@@ -1002,6 +1028,8 @@
         'ssl/client_cert_store_impl_win.cc',
         'ssl/default_server_bound_cert_store.cc',
         'ssl/default_server_bound_cert_store.h',
+        'ssl/file_ssl_session_store.cc',
+        'ssl/file_ssl_session_store.h',
         'ssl/openssl_client_key_store.cc',
         'ssl/openssl_client_key_store.h',
         'ssl/server_bound_cert_service.cc',
@@ -1021,6 +1049,7 @@
         'ssl/ssl_config_service_defaults.h',
         'ssl/ssl_info.cc',
         'ssl/ssl_info.h',
+        'ssl/ssl_session_store.h',
         'third_party/mozilla_security_manager/nsKeygenHandler.cpp',
         'third_party/mozilla_security_manager/nsKeygenHandler.h',
         'third_party/mozilla_security_manager/nsNSSCertificateDB.cpp',
@@ -1565,6 +1594,7 @@
         'base/mock_filter_context.cc',
         'base/mock_filter_context.h',
         'base/net_log_logger_unittest.cc',
+        'base/net_log_ring_buffer_unittest.cc',
         'base/net_log_unittest.cc',
         'base/net_log_unittest.h',
         'base/net_util_unittest.cc',
@@ -1583,6 +1613,7 @@
         'cert/crl_set_unittest.cc',
         'cert/ct_serialization_unittest.cc',
         'cert/ev_root_ca_metadata_unittest.cc',
+        'cert/file_cert_verify_result_store_unittest.cc',
         'cert/jwk_serializer_unittest.cc',
         'cert/multi_threaded_cert_verifier_unittest.cc',
         'cert/nss_cert_database_unittest.cc',
@@ -1628,6 +1659,7 @@
         'dns/dns_response_unittest.cc',
         'dns/dns_session_unittest.cc',
         'dns/dns_transaction_unittest.cc',
+        'dns/host_cache_persister_unittest.cc',
         'dns/host_cache_unittest.cc',
         'dns/host_resolver_impl_unittest.cc',
         'dns/mapped_host_resolver_unittest.cc',
@@ -1664,6 +1696,7 @@
         'http/http_auth_unittest.cc',
         'http/http_basic_state_unittest.cc',
         'http/http_byte_range_unittest.cc',
+        'http/http_cache_compression_unittest.cc',
         'http/http_cache_unittest.cc',
         'http/http_chunked_decoder_unittest.cc',
         'http/http_content_disposition_unittest.cc',
@@ -1721,6 +1754,7 @@
         'proxy/proxy_server_unittest.cc',
         'proxy/proxy_service_unittest.cc',
         'quic/congestion_control/available_channel_estimator_test.cc',
+        'quic/congestion_control/bbr_sender_test.cc',
         'quic/congestion_control/channel_estimator_test.cc',
         'quic/congestion_control/cube_root_test.cc',
         'quic/congestion_control/cubic_test.cc',
@@ -1788,6 +1822,8 @@
         'quic/test_tools/quic_test_writer.h',
         'quic/test_tools/reliable_quic_stream_peer.cc',
         'quic/test_tools/reliable_quic_stream_peer.h',
+        'quic/test_tools/send_algorithm_simulator.cc',
+        'quic/test_tools/send_algorithm_simulator.h',
         'quic/test_tools/simple_quic_framer.cc',
         'quic/test_tools/simple_quic_framer.h',
         'quic/test_tools/test_task_runner.cc',
@@ -1828,6 +1864,7 @@
         'server/http_server_unittest.cc',
         'socket/buffered_write_stream_socket_unittest.cc',
         'socket/client_socket_pool_base_unittest.cc',
+        'socket/connection_prewarm_model_unittest.cc',
         'socket/deterministic_socket_data_unittest.cc',
         'socket/mock_client_socket_pool_manager.cc',
         'socket/mock_client_socket_pool_manager.h',
@@ -1849,6 +1886,10 @@
         'socket_stream/socket_stream_metrics_unittest.cc',
         'socket_stream/socket_stream_unittest.cc',
         'spdy/buffered_spdy_framer_unittest.cc',
+        'spdy/hpack_decoder_test.cc',
+        'spdy/hpack_encoder_test.cc',
+        'spdy/hpack_header_table_test.cc',
+        'spdy/hpack_huffman_table_test.cc',
         'spdy/spdy_buffer_unittest.cc',
         'spdy/spdy_frame_builder_test.cc',
         'spdy/spdy_frame_reader_test.cc',
@@ -1879,6 +1920,7 @@
         'spdy/write_blocked_list_test.cc',
         'ssl/client_cert_store_impl_unittest.cc',
         'ssl/default_server_bound_cert_store_unittest.cc',
+        'ssl/file_ssl_session_store_unittest.cc',
         'ssl/openssl_client_key_store_unittest.cc',
         'ssl/server_bound_cert_service_unittest.cc',
         'ssl/ssl_cipher_suite_names_unittest.cc',
@@ -1947,11 +1989,14 @@
             'tools/flip_server/mem_cache_test.cc',
             'tools/flip_server/spdy_interface_test.cc',
             'tools/quic/end_to_end_test.cc',
+            'tools/quic/quic_batch_packet_writer_test.cc',
             'tools/quic/quic_client_session_test.cc',
             'tools/quic/quic_dispatcher_test.cc',
             'tools/quic/quic_epoll_clock_test.cc',
             'tools/quic/quic_epoll_connection_helper_test.cc',
+            'tools/quic/quic_handshake_worker_pool_test.cc',
             'tools/quic/quic_in_memory_cache_test.cc',
+            'tools/quic/quic_multi_threaded_server_test.cc',
             'tools/quic/quic_reliable_client_stream_test.cc',
             'tools/quic/quic_reliable_server_stream_test.cc',
             'tools/quic/quic_server_session_test.cc',
@@ -2227,14 +2272,29 @@
         '../base/base.gyp:base_i18n',
         '../base/base.gyp:test_support_perf',
         '../testing/gtest.gyp:gtest',
+        '../third_party/zlib/zlib.gyp:zlib',
         '../url/url.gyp:url_lib',
+        'http_server',
         'net',
         'net_test_support',
       ],
       'sources': [
+        'base/gzip_filter_perftest.cc',
+        'base/net_log_ring_buffer_perftest.cc',
+        'cert/crl_set_perftest.cc',
+        'cert/multi_threaded_cert_verifier_perftest.cc',
         'cookies/cookie_monster_perftest.cc',
         'disk_cache/disk_cache_perftest.cc',
+        'dns/host_resolver_perftest.cc',
+        'http/http_cache_compression_perftest.cc',
+        'http/http_transaction_unittest.cc',
+        'http/http_transaction_unittest.h',
+        'http/transport_security_state_perftest.cc',
         'proxy/proxy_resolver_perftest.cc',
+        'quic/crypto/quic_crypto_server_config_perftest.cc',
+        'server/http_server_perftest.cc',
+        'spdy/spdy_framer_perftest.cc',
+        'spdy/spdy_session_perftest.cc',
       ],
       'conditions': [
         [ 'use_v8_in_net==1', {
@@ -2247,6 +2307,18 @@
             ],
           },
         ],
+        ['os_posix == 1 and OS != "mac" and OS != "ios" and OS != "android"', {
+            'dependencies': [
+              'flip_in_mem_edsm_server_base',
+              'quic_base',
+            ],
+            'sources': [
+              'tools/flip_server/flip_server_perftest.cc',
+              'tools/quic/quic_batch_packet_writer_perftest.cc',
+              'tools/quic/quic_bulk_transfer_perftest.cc',
+            ],
+          },
+        ],
         # This is needed to trigger the dll copy step on windows.
         # TODO(mark): Specifying this here shouldn't be necessary.
         [ 'OS == "win"', {
@@ -2532,6 +2604,17 @@
           # TODO(jschuh): crbug.com/167187 fix size_t to int truncations.
           'msvs_disabled_warnings': [4267, ],
         },
+        {
+          'target_name': 'net_log_to_json',
+          'type': 'executable',
+          'dependencies': [
+            '../base/base.gyp:base',
+            'net',
+          ],
+          'sources': [
+            'tools/net_log_to_json/net_log_to_json.cc',
+          ],
+        },
         {
           'target_name': 'dns_fuzz_stub',
           'type': 'executable',
@@ -2795,6 +2878,8 @@
             'net',
           ],
           'sources': [
+            'tools/quic/quic_batch_packet_writer.cc',
+            'tools/quic/quic_batch_packet_writer.h',
             'tools/quic/quic_client.cc',
             'tools/quic/quic_client.h',
             'tools/quic/quic_client_session.cc',
@@ -2807,8 +2892,12 @@
             'tools/quic/quic_epoll_clock.h',
             'tools/quic/quic_epoll_connection_helper.cc',
             'tools/quic/quic_epoll_connection_helper.h',
+            'tools/quic/quic_handshake_worker_pool.cc',
+            'tools/quic/quic_handshake_worker_pool.h',
             'tools/quic/quic_in_memory_cache.cc',
             'tools/quic/quic_in_memory_cache.h',
+            'tools/quic/quic_multi_threaded_server.cc',
+            'tools/quic/quic_multi_threaded_server.h',
             'tools/quic/quic_reliable_client_stream.cc',
             'tools/quic/quic_reliable_client_stream.h',
             'tools/quic/quic_reliable_server_stream.cc',
@@ -2842,6 +2931,19 @@
             'tools/quic/quic_client_bin.cc',
           ],
         },
+        {
+          'target_name': 'quic_load_generator',
+          'type': 'executable',
+          'dependencies': [
+            '../base/base.gyp:base',
+            '../third_party/openssl/openssl.gyp:openssl',
+            'net',
+            'quic_base',
+          ],
+          'sources': [
+            'tools/quic/benchmark/quic_load_generator.cc',
+          ],
+        },
         {
           'target_name': 'quic_server',
           'type': 'executable',
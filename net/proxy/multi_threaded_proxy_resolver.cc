@@ -22,6 +22,13 @@
 
 namespace net {
 
+namespace {
+
+// The maximum number of URLs whose results are cached.
+const size_t kMaxResultCacheEntries = 1000;
+
+}  // namespace
+
 // An "executor" is a job-runner for PAC requests. It encapsulates a worker
 // thread and a synchronous ProxyResolver (which will be operated on said
 // thread.)
@@ -411,8 +418,24 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   DCHECK(current_script_data_.get())
       << "Resolver is un-initialized. Must call SetPacScript() first!";
 
+  CompletionCallback job_callback = callback;
+  if (result_cache_) {
+    std::string key = url.spec();
+    const ProxyInfo* cached_results =
+        result_cache_->Get(key, base::TimeTicks::Now());
+    if (cached_results) {
+      results->Use(*cached_results);
+      return OK;
+    }
+    // The jobs are cancelled when |this| is deleted, so their callbacks never
+    // outlive it.
+    job_callback = base::Bind(
+        &MultiThreadedProxyResolver::OnGetProxyForURLCompleted,
+        base::Unretained(this), key, results, callback);
+  }
+
   scoped_refptr<GetProxyForURLJob> job(
-      new GetProxyForURLJob(url, results, callback, net_log));
+      new GetProxyForURLJob(url, results, job_callback, net_log));
 
   // Completion will be notified through |callback|, unless the caller cancels
   // the request using |request|.
@@ -485,6 +508,8 @@ void MultiThreadedProxyResolver::CancelSetPacScript() {
 
 void MultiThreadedProxyResolver::PurgeMemory() {
   DCHECK(CalledOnValidThread());
+  if (result_cache_)
+    result_cache_->Clear();
   for (ExecutorList::iterator it = executors_.begin();
        it != executors_.end(); ++it) {
     Executor* executor = it->get();
@@ -501,6 +526,10 @@ int MultiThreadedProxyResolver::SetPacScript(
   // Save the script details, so we can provision new executors later.
   current_script_data_ = script_data;
 
+  // Results of the previous script no longer apply.
+  if (result_cache_)
+    result_cache_->Clear();
+
   // The user should not have any outstanding requests when they call
   // SetPacScript().
   CheckNoOutstandingUserRequests();
@@ -515,6 +544,14 @@ int MultiThreadedProxyResolver::SetPacScript(
   return ERR_IO_PENDING;
 }
 
+void MultiThreadedProxyResolver::EnableResultCache(base::TimeDelta ttl) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(ttl > base::TimeDelta());
+  if (!result_cache_)
+    result_cache_.reset(new ResultCache(kMaxResultCacheEntries));
+  result_cache_ttl_ = ttl;
+}
+
 void MultiThreadedProxyResolver::CheckNoOutstandingUserRequests() const {
   DCHECK(CalledOnValidThread());
   CHECK_EQ(0u, pending_jobs_.size());
@@ -580,4 +617,17 @@ void MultiThreadedProxyResolver::OnExecutorReady(Executor* executor) {
   executor->StartJob(job.get());
 }
 
+void MultiThreadedProxyResolver::OnGetProxyForURLCompleted(
+    const std::string& key,
+    ProxyInfo* results,
+    const CompletionCallback& callback,
+    int rv) {
+  DCHECK(CalledOnValidThread());
+  if (rv == OK && result_cache_) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    result_cache_->Put(key, *results, now, now + result_cache_ttl_);
+  }
+  callback.Run(rv);
+}
+
 }  // namespace net
@@ -6,13 +6,18 @@
 #define NET_PROXY_MULTI_THREADED_PROXY_RESOLVER_H_
 
 #include <deque>
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
+#include "net/proxy/proxy_info.h"
 #include "net/proxy/proxy_resolver.h"
 
 namespace base {
@@ -71,6 +76,10 @@ class ProxyResolverFactory {
 //     a global counter and using that to make a decision. In the
 //     multi-threaded model, each thread may have a different value for this
 //     counter, so it won't globally be seen as monotonically increasing!
+//
+// Optionally (see EnableResultCache()), the results of FindProxyForURL() can
+// be cached per URL, so that repeated requests for the same URL don't queue
+// up behind the worker threads at all.
 class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
     : public ProxyResolver,
       NON_EXPORTED_BASE(public base::NonThreadSafe) {
@@ -104,6 +113,16 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
       const scoped_refptr<ProxyResolverScriptData>& script_data,
       const CompletionCallback& callback) OVERRIDE;
 
+  // Caches successful results for |ttl|, keyed on the full URL passed to
+  // GetProxyForURL() (which ProxyService has already stripped of credentials
+  // and the fragment); until then, GetProxyForURL() completes synchronously
+  // for that URL.  PAC scripts commonly match on the path, so results are
+  // never shared between different URLs.  The cache is cleared by
+  // SetPacScript(), which ProxyService calls again when the network changes,
+  // and by PurgeMemory(); |ttl| bounds how stale results that depend on DNS
+  // or the time of day can get.
+  void EnableResultCache(base::TimeDelta ttl);
+
  private:
   class Executor;
   class Job;
@@ -113,6 +132,8 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
   // TODO(eroman): Make this priority queue.
   typedef std::deque<scoped_refptr<Job> > PendingJobsQueue;
   typedef std::vector<scoped_refptr<Executor> > ExecutorList;
+  typedef ExpiringCache<std::string, ProxyInfo, base::TimeTicks,
+                        std::less<base::TimeTicks> > ResultCache;
 
   // Asserts that there are no outstanding user-initiated jobs on any of the
   // worker threads.
@@ -131,11 +152,23 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
   // Starts the next job from |pending_jobs_| if possible.
   void OnExecutorReady(Executor* executor);
 
+  // Adds the result of a GetProxyForURL() request to |result_cache_| under
+  // |key|, before running the user's |callback|.
+  void OnGetProxyForURLCompleted(const std::string& key,
+                                 ProxyInfo* results,
+                                 const CompletionCallback& callback,
+                                 int rv);
+
   const scoped_ptr<ProxyResolverFactory> resolver_factory_;
   const size_t max_num_threads_;
   PendingJobsQueue pending_jobs_;
   ExecutorList executors_;
   scoped_refptr<ProxyResolverScriptData> current_script_data_;
+
+  // Results of FindProxyForURL() by URL; NULL unless EnableResultCache()
+  // was called.
+  scoped_ptr<ResultCache> result_cache_;
+  base::TimeDelta result_cache_ttl_;
 };
 
 }  // namespace net
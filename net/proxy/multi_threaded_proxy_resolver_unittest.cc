@@ -781,6 +781,73 @@ TEST(MultiThreadedProxyResolverTest, OneThreadBlocked) {
   EXPECT_EQ(3, factory->resolvers()[1]->request_count());
 }
 
+// Tests that with the result cache enabled, successful results are reused for
+// URLs of the same origin until the PAC script is set again.
+TEST(MultiThreadedProxyResolverTest, ResultCache) {
+  const size_t kNumThreads = 1u;
+  scoped_ptr<MockProxyResolver> mock(new MockProxyResolver);
+  MultiThreadedProxyResolver resolver(
+      new ForwardingProxyResolverFactory(mock.get()), kNumThreads);
+  resolver.EnableResultCache(base::TimeDelta::FromHours(1));
+
+  int rv;
+
+  TestCompletionCallback set_script_callback;
+  rv = resolver.SetPacScript(ProxyResolverScriptData::FromUTF8("foo"),
+                             set_script_callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, set_script_callback.WaitForResult());
+
+  // The first request goes to the worker thread, and succeeds.
+  TestCompletionCallback callback0;
+  ProxyInfo results0;
+  rv = resolver.GetProxyForURL(GURL("http://host/path0"), &results0,
+                               callback0.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, callback0.WaitForResult());
+  EXPECT_EQ("PROXY host:80", results0.ToPacString());
+
+  // Asking for the same URL again completes synchronously.
+  TestCompletionCallback callback1;
+  ProxyInfo results1;
+  rv = resolver.GetProxyForURL(GURL("http://host/path0"), &results1,
+                               callback1.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(OK, rv);
+  EXPECT_EQ("PROXY host:80", results1.ToPacString());
+  EXPECT_EQ(1, mock->request_count());
+
+  // Another path on the same host may get a different answer from the
+  // script, so it goes to the worker thread. The mock fails this request (its
+  // result is the request count), so it isn't cached.
+  TestCompletionCallback callback2;
+  ProxyInfo results2;
+  rv = resolver.GetProxyForURL(GURL("http://host/path1"), &results2,
+                               callback2.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(1, callback2.WaitForResult());
+
+  TestCompletionCallback callback3;
+  ProxyInfo results3;
+  rv = resolver.GetProxyForURL(GURL("http://host/path1"), &results3,
+                               callback3.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(2, callback3.WaitForResult());
+
+  // Setting the PAC script clears the cache.
+  rv = resolver.SetPacScript(ProxyResolverScriptData::FromUTF8("bar"),
+                             set_script_callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, set_script_callback.WaitForResult());
+
+  TestCompletionCallback callback4;
+  ProxyInfo results4;
+  rv = resolver.GetProxyForURL(GURL("http://host/path0"), &results4,
+                               callback4.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(3, callback4.WaitForResult());
+  EXPECT_EQ(4, mock->request_count());
+}
+
 }  // namespace
 
 }  // namespace net
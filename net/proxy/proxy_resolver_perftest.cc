@@ -5,11 +5,14 @@
 #include "base/base_paths.h"
 #include "base/compiler_specific.h"
 #include "base/file_util.h"
+#include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
 #include "base/strings/string_util.h"
 #include "base/test/perf_time_logger.h"
 #include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/proxy/multi_threaded_proxy_resolver.h"
 #include "net/proxy/proxy_info.h"
 #include "net/proxy/proxy_resolver_v8.h"
 #include "net/test/spawned_test_server/spawned_test_server.h"
@@ -76,6 +79,22 @@ int PacPerfTest::NumQueries() const {
 // The number of URLs to resolve when testing a PAC script.
 const int kNumIterations = 500;
 
+// Reads the PAC script |script_name| from disk into |contents|.
+bool ReadPacScript(const std::string& script_name, std::string* contents) {
+  base::FilePath path;
+  PathService::Get(base::DIR_SOURCE_ROOT, &path);
+  path = path.AppendASCII("net");
+  path = path.AppendASCII("data");
+  path = path.AppendASCII("proxy_resolver_perftest");
+  path = path.AppendASCII(script_name);
+
+  bool ok = base::ReadFileToString(path, contents);
+
+  // If we can't load the file from disk, something is misconfigured.
+  LOG_IF(ERROR, !ok) << "Failed to read file: " << path.value();
+  return ok;
+}
+
 // Helper class to run through all the performance tests using the specified
 // proxy resolver implementation.
 class PacPerfSuiteRunner {
@@ -154,20 +173,8 @@ class PacPerfSuiteRunner {
 
   // Read the PAC script from disk and initialize the proxy resolver with it.
   void LoadPacScriptIntoResolver(const std::string& script_name) {
-    base::FilePath path;
-    PathService::Get(base::DIR_SOURCE_ROOT, &path);
-    path = path.AppendASCII("net");
-    path = path.AppendASCII("data");
-    path = path.AppendASCII("proxy_resolver_perftest");
-    path = path.AppendASCII(script_name);
-
-    // Try to read the file from disk.
     std::string file_contents;
-    bool ok = base::ReadFileToString(path, &file_contents);
-
-    // If we can't load the file from disk, something is misconfigured.
-    LOG_IF(ERROR, !ok) << "Failed to read file: " << path.value();
-    ASSERT_TRUE(ok);
+    ASSERT_TRUE(ReadPacScript(script_name, &file_contents));
 
     // Load the PAC script into the ProxyResolver.
     int rv = resolver_->SetPacScript(
@@ -227,3 +234,112 @@ TEST(ProxyResolverPerfTest, ProxyResolverV8) {
   PacPerfSuiteRunner runner(&resolver, "ProxyResolverV8");
   runner.RunAllTests();
 }
+
+// Creates ProxyResolverV8s for the threads of a MultiThreadedProxyResolver.
+class ProxyResolverFactoryForV8 : public net::ProxyResolverFactory {
+ public:
+  explicit ProxyResolverFactoryForV8(MockJSBindings* js_bindings)
+      : net::ProxyResolverFactory(true /*expects_pac_bytes*/),
+        js_bindings_(js_bindings) {}
+
+  virtual net::ProxyResolver* CreateProxyResolver() OVERRIDE {
+    net::ProxyResolverV8* resolver = new net::ProxyResolverV8;
+    resolver->set_js_bindings(js_bindings_);
+    return resolver;
+  }
+
+ private:
+  MockJSBindings* js_bindings_;
+};
+
+// Loading a PAC script into a new ProxyResolverV8 only pre-parses it the first
+// time; the others reuse the pre-parse data, as the threads of a
+// MultiThreadedProxyResolver do.
+TEST(ProxyResolverPerfTest, ProxyResolverV8_SetPacScript) {
+  net::ProxyResolverV8::RememberDefaultIsolate();
+
+  std::string file_contents;
+  ASSERT_TRUE(ReadPacScript("no-ads.pac", &file_contents));
+  // The trailing newline keeps the pre-parse data of earlier tests from
+  // matching.
+  scoped_refptr<net::ProxyResolverScriptData> script_data =
+      net::ProxyResolverScriptData::FromUTF8(file_contents + "\n");
+
+  MockJSBindings js_bindings;
+  {
+    net::ProxyResolverV8 resolver;
+    resolver.set_js_bindings(&js_bindings);
+    base::PerfTimeLogger timer("ProxyResolverV8_SetPacScript_first");
+    EXPECT_EQ(net::OK,
+              resolver.SetPacScript(script_data, net::CompletionCallback()));
+    timer.Done();
+  }
+
+  const int kNumResolvers = 20;
+  base::PerfTimeLogger timer("ProxyResolverV8_SetPacScript_shared");
+  for (int i = 0; i < kNumResolvers; ++i) {
+    net::ProxyResolverV8 resolver;
+    resolver.set_js_bindings(&js_bindings);
+    EXPECT_EQ(net::OK, resolver.SetPacScript(
+        net::ProxyResolverScriptData::FromUTF8(file_contents + "\n"),
+        net::CompletionCallback()));
+  }
+  timer.Done();
+}
+
+// Resolves a few URLs repeatedly through a MultiThreadedProxyResolver of
+// ProxyResolverV8s, with and without its result cache.
+class MultiThreadedProxyResolverV8PerfTest : public testing::Test {
+ protected:
+  void RunQueries(net::MultiThreadedProxyResolver* resolver,
+                  const char* name) {
+    static const char* const kQueryUrls[] = {
+      "http://www.google.com/",
+      "http://www.imdb.com/",
+      "http://www.staples.com/",
+      "http://www.foobar.com/",
+      "http://www.testurl1.com/",
+      "http://www.testurl2.com/",
+    };
+
+    std::string file_contents;
+    ASSERT_TRUE(ReadPacScript("no-ads.pac", &file_contents));
+    net::TestCompletionCallback set_script_callback;
+    int rv = resolver->SetPacScript(
+        net::ProxyResolverScriptData::FromUTF8(file_contents),
+        set_script_callback.callback());
+    EXPECT_EQ(net::OK, set_script_callback.GetResult(rv));
+
+    base::PerfTimeLogger timer(name);
+    for (int i = 0; i < kNumIterations; ++i) {
+      net::TestCompletionCallback callback;
+      net::ProxyInfo proxy_info;
+      rv = resolver->GetProxyForURL(
+          GURL(kQueryUrls[i % arraysize(kQueryUrls)]), &proxy_info,
+          callback.callback(), NULL, net::BoundNetLog());
+      ASSERT_EQ(net::OK, callback.GetResult(rv));
+      ASSERT_EQ("DIRECT", proxy_info.ToPacString());
+    }
+    timer.Done();
+  }
+
+  base::MessageLoopForIO message_loop_;
+  MockJSBindings js_bindings_;
+};
+
+TEST_F(MultiThreadedProxyResolverV8PerfTest, NoResultCache) {
+  net::ProxyResolverV8::RememberDefaultIsolate();
+
+  net::MultiThreadedProxyResolver resolver(
+      new ProxyResolverFactoryForV8(&js_bindings_), 4);
+  RunQueries(&resolver, "MultiThreadedProxyResolverV8_no_cache");
+}
+
+TEST_F(MultiThreadedProxyResolverV8PerfTest, ResultCache) {
+  net::ProxyResolverV8::RememberDefaultIsolate();
+
+  net::MultiThreadedProxyResolver resolver(
+      new ProxyResolverFactoryForV8(&js_bindings_), 4);
+  resolver.EnableResultCache(base::TimeDelta::FromMinutes(5));
+  RunQueries(&resolver, "MultiThreadedProxyResolverV8_cache");
+}
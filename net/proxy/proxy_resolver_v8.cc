@@ -9,6 +9,7 @@
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
@@ -328,6 +329,66 @@ bool IsInNetEx(const std::string& ip_address, const std::string& ip_prefix) {
   return IPNumberMatchesPrefix(address, prefix, prefix_length_in_bits);
 }
 
+// Holds the V8 pre-parse data of the most recently loaded PAC script, so that
+// when several ProxyResolverV8s load the same script, as the threads of a
+// MultiThreadedProxyResolver do, only the first one pre-parses it.  The others
+// then compile it without parsing the bodies of its functions up front.
+class PreParseDataCache {
+ public:
+  PreParseDataCache() {}
+
+  // Copies the pre-parse data of |script| to |data|, and returns true if there
+  // is any.
+  bool Get(const scoped_refptr<ProxyResolverScriptData>& script,
+           std::string* data) {
+    base::AutoLock l(lock_);
+    if (!script_.get() ||
+        (script_.get() != script.get() && !script_->Equals(script.get()))) {
+      return false;
+    }
+    *data = data_;
+    return true;
+  }
+
+  // Remembers |data| as the pre-parse data of |script|, replacing that of any
+  // other script.
+  void Set(const scoped_refptr<ProxyResolverScriptData>& script,
+           const std::string& data) {
+    base::AutoLock l(lock_);
+    script_ = script;
+    data_ = data;
+  }
+
+ private:
+  base::Lock lock_;
+  scoped_refptr<ProxyResolverScriptData> script_;
+  std::string data_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreParseDataCache);
+};
+
+base::LazyInstance<PreParseDataCache>::Leaky g_pre_parse_data_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Returns the pre-parse data to compile |pac_script| with, or NULL if it
+// can't be pre-parsed.  |source| is the V8 string of |pac_script|.  Must be
+// called with the isolate locked.
+v8::ScriptData* GetPreParseData(
+    const scoped_refptr<ProxyResolverScriptData>& pac_script,
+    v8::Handle<v8::String> source) {
+  std::string data;
+  if (g_pre_parse_data_cache.Get().Get(pac_script, &data))
+    return v8::ScriptData::New(data.data(), static_cast<int>(data.size()));
+
+  scoped_ptr<v8::ScriptData> pre_data(v8::ScriptData::PreCompile(source));
+  // Leave it to the compiler to report syntax errors.
+  if (!pre_data || pre_data->HasError())
+    return NULL;
+  g_pre_parse_data_cache.Get().Set(
+      pac_script, std::string(pre_data->Data(), pre_data->Length()));
+  return pre_data.release();
+}
+
 }  // namespace
 
 // ProxyResolverV8::Context ---------------------------------------------------
@@ -464,14 +525,18 @@ class ProxyResolverV8::Context {
         ASCIILiteralToV8String(
             PROXY_RESOLVER_SCRIPT
             PROXY_RESOLVER_SCRIPT_EX),
-        kPacUtilityResourceName);
+        kPacUtilityResourceName,
+        NULL);
     if (rv != OK) {
       NOTREACHED();
       return rv;
     }
 
     // Add the user's PAC code to the environment.
-    rv = RunScript(ScriptDataToV8String(pac_script), kPacResourceName);
+    v8::Local<v8::String> pac_source = ScriptDataToV8String(pac_script);
+    scoped_ptr<v8::ScriptData> pre_data(
+        GetPreParseData(pac_script, pac_source));
+    rv = RunScript(pac_source, kPacResourceName, pre_data.get());
     if (rv != OK)
       return rv;
 
@@ -514,15 +579,19 @@ class ProxyResolverV8::Context {
     js_bindings()->OnError(line_number, error_message);
   }
 
-  // Compiles and runs |script| in the current V8 context.
+  // Compiles and runs |script| in the current V8 context, with the pre-parse
+  // data |pre_data| if not NULL.
   // Returns OK on success, otherwise an error code.
-  int RunScript(v8::Handle<v8::String> script, const char* script_name) {
+  int RunScript(v8::Handle<v8::String> script,
+                const char* script_name,
+                v8::ScriptData* pre_data) {
     v8::TryCatch try_catch;
 
     // Compile the script.
     v8::ScriptOrigin origin =
         v8::ScriptOrigin(ASCIILiteralToV8String(script_name));
-    v8::Local<v8::Script> code = v8::Script::Compile(script, &origin);
+    v8::Local<v8::Script> code =
+        v8::Script::Compile(script, &origin, pre_data);
 
     // Execute.
     if (!code.IsEmpty())
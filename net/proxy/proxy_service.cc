@@ -13,6 +13,8 @@
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/metrics/field_trial.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -310,6 +312,28 @@ base::Value* NetLogFinishedResolvingProxyCallback(
   return dict;
 }
 
+// Returns how long the MultiThreadedProxyResolver may reuse the result for a
+// URL, or zero if it should not cache results.
+TimeDelta ConfigureProxyResultCacheFieldTrial() {
+  const int kMaxTTLSeconds = 300;
+
+  // Configure the ProxyResultCache field trial as follows:
+  // groups TTL1 to TTL300: cache results for the number of seconds in the
+  // group name,
+  // otherwise (trial absent or other group): do not cache results.
+  std::string group_name =
+      base::FieldTrialList::FindFullName("ProxyResultCache");
+  const char kGroupPrefix[] = "TTL";
+  int ttl_seconds;
+  if (StartsWithASCII(group_name, kGroupPrefix, true) &&
+      base::StringToInt(group_name.substr(arraysize(kGroupPrefix) - 1),
+                        &ttl_seconds) &&
+      ttl_seconds >= 1 && ttl_seconds <= kMaxTTLSeconds) {
+    return TimeDelta::FromSeconds(ttl_seconds);
+  }
+  return TimeDelta();
+}
+
 #if defined(OS_CHROMEOS)
 class UnsetProxyConfigService : public ProxyConfigService {
  public:
@@ -895,8 +919,11 @@ ProxyService* ProxyService::CreateUsingSystemProxyResolver(
   if (num_pac_threads == 0)
     num_pac_threads = kDefaultNumPacThreads;
 
-  ProxyResolver* proxy_resolver = new MultiThreadedProxyResolver(
+  MultiThreadedProxyResolver* proxy_resolver = new MultiThreadedProxyResolver(
       new ProxyResolverFactoryForSystem(), num_pac_threads);
+  TimeDelta result_cache_ttl = ConfigureProxyResultCacheFieldTrial();
+  if (result_cache_ttl > TimeDelta())
+    proxy_resolver->EnableResultCache(result_cache_ttl);
 
   return new ProxyService(proxy_config_service, proxy_resolver, net_log);
 }
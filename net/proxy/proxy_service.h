@@ -213,7 +213,8 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
 
   // Same as CreateProxyServiceUsingV8ProxyResolver, except it uses system
   // libraries for evaluating the PAC script if available, otherwise skips
-  // proxy autoconfig.
+  // proxy autoconfig. In the ProxyResultCache field trial, the results are
+  // cached per URL, see MultiThreadedProxyResolver::EnableResultCache().
   static ProxyService* CreateUsingSystemProxyResolver(
       ProxyConfigService* proxy_config_service,
       size_t num_pac_threads,
@@ -0,0 +1,413 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+
+namespace net {
+
+namespace {
+const QuicByteCount kMaxSegmentSize = kDefaultTCPMSS;
+const QuicByteCount kInitialCongestionWindow = 10 * kMaxSegmentSize;
+// Enough to keep sending while the minimum RTT is probed.
+const QuicByteCount kMinimumCongestionWindow = 4 * kMaxSegmentSize;
+const int kInitialRttMs = 60;  // At a typical RTT 60 ms.
+
+// 2/ln(2), the smallest gain which doubles the sending rate every round trip.
+const float kHighGain = 2.885f;
+const float kDrainGain = 1.f / kHighGain;
+const float kCongestionWindowGain = 2.f;
+// One phase of the cycle probes for more bandwidth, the next one drains the
+// queue the probe may have created.
+const float kPacingGain[] = { 1.25f, 0.75f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f };
+const int kGainCycleLength = arraysize(kPacingGain);
+// The phase PROBE_BW starts in, which cruises at the estimated bandwidth.
+const int kInitialCycleOffset = 2;
+
+const int64 kBandwidthWindowRounds = 10;
+const float kStartupGrowthTarget = 1.25f;
+const int kRoundTripsWithoutGrowthBeforeExitingStartup = 3;
+
+const int64 kMinRttExpirySeconds = 10;
+const int64 kProbeRttTimeMs = 200;
+
+const float kAlpha = 0.125f;
+const float kOneMinusAlpha = (1 - kAlpha);
+const float kBeta = 0.25f;
+const float kOneMinusBeta = (1 - kBeta);
+}  // namespace
+
+BbrSender::BbrSender(const QuicClock* clock)
+    : clock_(clock),
+      mode_(STARTUP),
+      bytes_in_flight_(0),
+      delivered_(0),
+      delivered_time_(QuicTime::Zero()),
+      round_count_(0),
+      next_round_delivered_(0),
+      round_start_(false),
+      min_rtt_(QuicTime::Delta::Zero()),
+      min_rtt_timestamp_(QuicTime::Zero()),
+      is_at_full_bandwidth_(false),
+      bandwidth_at_last_round_(QuicBandwidth::Zero()),
+      rounds_without_bandwidth_gain_(0),
+      pacing_gain_(kHighGain),
+      congestion_window_gain_(kHighGain),
+      cycle_current_offset_(0),
+      last_cycle_start_(QuicTime::Zero()),
+      exit_probe_rtt_at_(QuicTime::Zero()),
+      probe_rtt_round_passed_(false),
+      congestion_window_(kInitialCongestionWindow),
+      initial_congestion_window_(kInitialCongestionWindow),
+      next_send_time_(QuicTime::Zero()),
+      initial_rtt_(QuicTime::Delta::FromMilliseconds(kInitialRttMs)),
+      smoothed_rtt_(QuicTime::Delta::Zero()),
+      mean_deviation_(QuicTime::Delta::Zero()) {
+}
+
+BbrSender::~BbrSender() {}
+
+void BbrSender::SetFromConfig(const QuicConfig& config, bool is_server) {
+  if (is_server) {
+    // Set the initial window size.
+    initial_congestion_window_ =
+        config.server_initial_congestion_window() * kMaxSegmentSize;
+    congestion_window_ = initial_congestion_window_;
+  }
+  if (config.initial_round_trip_time_us() > 0) {
+    initial_rtt_ =
+        QuicTime::Delta::FromMicroseconds(config.initial_round_trip_time_us());
+  }
+}
+
+void BbrSender::OnIncomingQuicCongestionFeedbackFrame(
+    const QuicCongestionFeedbackFrame& /*feedback*/,
+    QuicTime /*feedback_receive_time*/,
+    const SentPacketsMap& /*sent_packets*/) {
+  // The model is driven by the acks alone.
+}
+
+void BbrSender::OnIncomingAck(QuicPacketSequenceNumber acked_sequence_number,
+                              QuicByteCount acked_bytes,
+                              QuicTime::Delta rtt) {
+  SentPacketStateMap::iterator it = sent_packets_.find(acked_sequence_number);
+  if (it == sent_packets_.end()) {
+    // Sent before this sender took over the connection.
+    return;
+  }
+  const SentPacketState packet = it->second;
+  sent_packets_.erase(it);
+  DCHECK_EQ(packet.bytes, acked_bytes);
+  DCHECK_GE(bytes_in_flight_, packet.bytes);
+  bytes_in_flight_ -= packet.bytes;
+
+  QuicTime now = clock_->ApproximateNow();
+  delivered_ += packet.bytes;
+  delivered_time_ = now;
+
+  round_start_ = packet.delivered >= next_round_delivered_;
+  if (round_start_) {
+    ++round_count_;
+    next_round_delivered_ = delivered_;
+  }
+
+  UpdateBandwidth(packet, now);
+  bool min_rtt_expired = UpdateMinRtt(rtt, now);
+  UpdateSmoothedRtt(rtt);
+
+  if (round_start_ && !is_at_full_bandwidth_) {
+    CheckFullBandwidthReached();
+  }
+  MaybeExitStartupOrDrain(now);
+  MaybeAdvanceGainCycle(now);
+  MaybeEnterOrExitProbeRtt(now, min_rtt_expired);
+  UpdateCongestionWindow(packet.bytes);
+}
+
+void BbrSender::OnIncomingLoss(QuicTime /*ack_receive_time*/) {
+  // Unlike TCP, loss is not taken as a sign of congestion: on a path with a
+  // shallow buffer or random loss it would keep the sender well below the
+  // bottleneck bandwidth. The lost bytes stop counting as in flight when the
+  // packet is abandoned.
+  DLOG(INFO) << "Incoming loss; bandwidth estimate:"
+             << BandwidthEstimate().ToKBitsPerSecond() << " kbps";
+}
+
+bool BbrSender::OnPacketSent(QuicTime sent_time,
+                             QuicPacketSequenceNumber sequence_number,
+                             QuicByteCount bytes,
+                             TransmissionType /*transmission_type*/,
+                             HasRetransmittableData is_retransmittable) {
+  // Only data packets are paced and count against the congestion window.
+  if (is_retransmittable != HAS_RETRANSMITTABLE_DATA) {
+    return false;
+  }
+
+  if (bytes_in_flight_ == 0) {
+    // Do not count the time the connection was idle in the delivery rate of
+    // the packets sent from now on.
+    delivered_time_ = sent_time;
+  }
+  sent_packets_.insert(std::make_pair(
+      sequence_number, SentPacketState(bytes, delivered_, delivered_time_)));
+  bytes_in_flight_ += bytes;
+
+  QuicBandwidth pacing_rate = PacingRate();
+  if (!pacing_rate.IsZero()) {
+    QuicTime::Delta transfer_time = QuicTime::Delta::FromMicroseconds(
+        bytes * 8 * kNumMicrosPerSecond / pacing_rate.ToBitsPerSecond());
+    next_send_time_ = std::max(next_send_time_, sent_time).Add(transfer_time);
+  }
+  return true;
+}
+
+void BbrSender::OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                  QuicByteCount abandoned_bytes) {
+  SentPacketStateMap::iterator it = sent_packets_.find(sequence_number);
+  if (it == sent_packets_.end()) {
+    return;
+  }
+  DCHECK_EQ(it->second.bytes, abandoned_bytes);
+  DCHECK_GE(bytes_in_flight_, it->second.bytes);
+  bytes_in_flight_ -= it->second.bytes;
+  sent_packets_.erase(it);
+}
+
+QuicTime::Delta BbrSender::TimeUntilSend(
+    QuicTime now,
+    TransmissionType transmission_type,
+    HasRetransmittableData has_retransmittable_data,
+    IsHandshake handshake) {
+  if (transmission_type == NACK_RETRANSMISSION ||
+      has_retransmittable_data == NO_RETRANSMITTABLE_DATA ||
+      handshake == IS_HANDSHAKE) {
+    // As with TCP, ACKs, handshake packets and retransmissions of lost
+    // packets are sent immediately.
+    return QuicTime::Delta::Zero();
+  }
+  if (bytes_in_flight_ >= GetCongestionWindow()) {
+    return QuicTime::Delta::Infinite();
+  }
+  if (next_send_time_ > now) {
+    return next_send_time_.Subtract(now);
+  }
+  return QuicTime::Delta::Zero();
+}
+
+QuicBandwidth BbrSender::BandwidthEstimate() {
+  if (max_bandwidth_.empty()) {
+    return QuicBandwidth::Zero();
+  }
+  return max_bandwidth_.front().bandwidth;
+}
+
+QuicTime::Delta BbrSender::SmoothedRtt() {
+  if (smoothed_rtt_.IsZero()) {
+    return initial_rtt_;
+  }
+  return smoothed_rtt_;
+}
+
+QuicTime::Delta BbrSender::RetransmissionDelay() {
+  return QuicTime::Delta::FromMicroseconds(
+      smoothed_rtt_.ToMicroseconds() + 4 * mean_deviation_.ToMicroseconds());
+}
+
+QuicByteCount BbrSender::GetCongestionWindow() {
+  if (mode_ == PROBE_RTT) {
+    return std::min(congestion_window_, kMinimumCongestionWindow);
+  }
+  return congestion_window_;
+}
+
+void BbrSender::SetCongestionWindow(QuicByteCount window) {
+  congestion_window_ = std::max(window, kMinimumCongestionWindow);
+}
+
+QuicBandwidth BbrSender::PacingRate() const {
+  if (max_bandwidth_.empty()) {
+    // Until the first delivery rate sample, pace the initial window over the
+    // initial RTT.
+    QuicTime::Delta rtt = smoothed_rtt_.IsZero() ? initial_rtt_ : smoothed_rtt_;
+    return QuicBandwidth::FromBytesAndTimeDelta(
+        initial_congestion_window_, rtt).Scale(pacing_gain_);
+  }
+  return max_bandwidth_.front().bandwidth.Scale(pacing_gain_);
+}
+
+QuicByteCount BbrSender::TargetCongestionWindow(float gain) const {
+  if (max_bandwidth_.empty() || min_rtt_.IsZero()) {
+    return initial_congestion_window_;
+  }
+  QuicByteCount bdp =
+      max_bandwidth_.front().bandwidth.ToBytesPerPeriod(min_rtt_);
+  return std::max(static_cast<QuicByteCount>(gain * bdp),
+                  kMinimumCongestionWindow);
+}
+
+void BbrSender::UpdateBandwidth(const SentPacketState& packet, QuicTime now) {
+  QuicTime::Delta interval = now.Subtract(packet.delivered_time);
+  if (interval.IsZero()) {
+    return;
+  }
+  QuicBandwidth sample = QuicBandwidth::FromBytesAndTimeDelta(
+      delivered_ - packet.delivered, interval);
+
+  // Older samples which are not larger than this one can never be the
+  // maximum again.
+  while (!max_bandwidth_.empty() &&
+         max_bandwidth_.back().bandwidth <= sample) {
+    max_bandwidth_.pop_back();
+  }
+  max_bandwidth_.push_back(BandwidthSample(sample, round_count_));
+  while (max_bandwidth_.front().round + kBandwidthWindowRounds <=
+         round_count_) {
+    max_bandwidth_.pop_front();
+  }
+}
+
+bool BbrSender::UpdateMinRtt(QuicTime::Delta rtt, QuicTime now) {
+  if (rtt.IsInfinite() || rtt.IsZero()) {
+    return false;
+  }
+  bool expired = !min_rtt_.IsZero() &&
+      now > min_rtt_timestamp_.Add(
+          QuicTime::Delta::FromSeconds(kMinRttExpirySeconds));
+  if (min_rtt_.IsZero() || rtt <= min_rtt_ || expired) {
+    min_rtt_ = rtt;
+    min_rtt_timestamp_ = now;
+  }
+  return expired;
+}
+
+void BbrSender::UpdateSmoothedRtt(QuicTime::Delta rtt) {
+  if (rtt.IsInfinite() || rtt.IsZero()) {
+    return;
+  }
+  if (smoothed_rtt_.IsZero()) {
+    smoothed_rtt_ = rtt;
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        rtt.ToMicroseconds() / 2);
+    return;
+  }
+  mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+      kOneMinusBeta * mean_deviation_.ToMicroseconds() +
+      kBeta * abs(smoothed_rtt_.ToMicroseconds() - rtt.ToMicroseconds()));
+  smoothed_rtt_ = QuicTime::Delta::FromMicroseconds(
+      kOneMinusAlpha * smoothed_rtt_.ToMicroseconds() +
+      kAlpha * rtt.ToMicroseconds());
+}
+
+void BbrSender::CheckFullBandwidthReached() {
+  QuicBandwidth target = bandwidth_at_last_round_.Scale(kStartupGrowthTarget);
+  if (BandwidthEstimate() >= target) {
+    bandwidth_at_last_round_ = BandwidthEstimate();
+    rounds_without_bandwidth_gain_ = 0;
+    return;
+  }
+  ++rounds_without_bandwidth_gain_;
+  if (rounds_without_bandwidth_gain_ >=
+      kRoundTripsWithoutGrowthBeforeExitingStartup) {
+    DLOG(INFO) << "Full bandwidth reached:"
+               << BandwidthEstimate().ToKBitsPerSecond() << " kbps";
+    is_at_full_bandwidth_ = true;
+  }
+}
+
+void BbrSender::MaybeExitStartupOrDrain(QuicTime now) {
+  if (mode_ == STARTUP && is_at_full_bandwidth_) {
+    mode_ = DRAIN;
+    pacing_gain_ = kDrainGain;
+    congestion_window_gain_ = kHighGain;
+  }
+  if (mode_ == DRAIN && bytes_in_flight_ <= TargetCongestionWindow(1)) {
+    EnterProbeBandwidthMode(now);
+  }
+}
+
+void BbrSender::MaybeAdvanceGainCycle(QuicTime now) {
+  if (mode_ != PROBE_BW) {
+    return;
+  }
+  bool should_advance = now.Subtract(last_cycle_start_) > min_rtt_;
+  // Stop draining as soon as the queue created by the probe is gone.
+  if (pacing_gain_ < 1 && bytes_in_flight_ <= TargetCongestionWindow(1)) {
+    should_advance = true;
+  }
+  if (should_advance) {
+    cycle_current_offset_ = (cycle_current_offset_ + 1) % kGainCycleLength;
+    last_cycle_start_ = now;
+    pacing_gain_ = kPacingGain[cycle_current_offset_];
+  }
+}
+
+void BbrSender::MaybeEnterOrExitProbeRtt(QuicTime now, bool min_rtt_expired) {
+  if (min_rtt_expired && mode_ != PROBE_RTT) {
+    DLOG(INFO) << "Probing min RTT; min RTT expired:"
+               << min_rtt_.ToMilliseconds() << " ms";
+    mode_ = PROBE_RTT;
+    pacing_gain_ = 1;
+    exit_probe_rtt_at_ = QuicTime::Zero();
+  }
+  if (mode_ != PROBE_RTT) {
+    return;
+  }
+
+  if (!exit_probe_rtt_at_.IsInitialized()) {
+    // Hold the bytes in flight at the minimum for a while and for at least
+    // one round trip once they have dropped, so that the queue is empty
+    // when the RTT is sampled.
+    if (bytes_in_flight_ <= kMinimumCongestionWindow) {
+      exit_probe_rtt_at_ =
+          now.Add(QuicTime::Delta::FromMilliseconds(kProbeRttTimeMs));
+      probe_rtt_round_passed_ = false;
+      next_round_delivered_ = delivered_;
+    }
+    return;
+  }
+  if (round_start_) {
+    probe_rtt_round_passed_ = true;
+  }
+  if (probe_rtt_round_passed_ && now >= exit_probe_rtt_at_) {
+    min_rtt_timestamp_ = now;
+    if (is_at_full_bandwidth_) {
+      EnterProbeBandwidthMode(now);
+    } else {
+      mode_ = STARTUP;
+      pacing_gain_ = kHighGain;
+      congestion_window_gain_ = kHighGain;
+    }
+  }
+}
+
+void BbrSender::EnterProbeBandwidthMode(QuicTime now) {
+  mode_ = PROBE_BW;
+  congestion_window_gain_ = kCongestionWindowGain;
+  // Other implementations pick the first phase at random so that competing
+  // flows do not probe in lockstep. A fixed phase keeps the sender
+  // deterministic.
+  cycle_current_offset_ = kInitialCycleOffset;
+  last_cycle_start_ = now;
+  pacing_gain_ = kPacingGain[cycle_current_offset_];
+}
+
+void BbrSender::UpdateCongestionWindow(QuicByteCount acked_bytes) {
+  QuicByteCount target = TargetCongestionWindow(congestion_window_gain_);
+  if (is_at_full_bandwidth_) {
+    congestion_window_ = std::min(target, congestion_window_ + acked_bytes);
+  } else if (congestion_window_ < target ||
+             delivered_ < initial_congestion_window_) {
+    // Grow by the bytes acked, doubling the window every round trip, until
+    // the bandwidth estimate stops growing.
+    congestion_window_ += acked_bytes;
+  }
+  congestion_window_ = std::max(congestion_window_, kMinimumCongestionWindow);
+}
+
+}  // namespace net
@@ -0,0 +1,185 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Model based congestion control. Instead of reacting to packet loss, the
+// sender estimates the bottleneck bandwidth (the maximum delivery rate seen
+// over the last few round trips) and the propagation delay (the minimum RTT
+// seen over the last few seconds), paces packets at a gain times the
+// estimated bandwidth and limits the bytes in flight to a small multiple of
+// the bandwidth-delay product. The pacing gain cycles above and below one so
+// that the sender regularly probes for more bandwidth and then drains the
+// queue its probe created, which keeps the bottleneck queue short even when
+// the bottleneck has a large buffer.
+
+#ifndef NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+#define NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+
+#include <deque>
+#include <map>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "net/base/net_export.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_clock.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+
+namespace net {
+
+class NET_EXPORT_PRIVATE BbrSender : public SendAlgorithmInterface {
+ public:
+  enum Mode {
+    // Doubles the sending rate every round trip until the bandwidth estimate
+    // stops growing.
+    STARTUP,
+    // Drains the queue created during STARTUP.
+    DRAIN,
+    // Cycles the pacing gain to probe for more bandwidth.
+    PROBE_BW,
+    // Briefly reduces the bytes in flight to measure the minimum RTT again.
+    PROBE_RTT,
+  };
+
+  explicit BbrSender(const QuicClock* clock);
+  virtual ~BbrSender();
+
+  virtual void SetFromConfig(const QuicConfig& config, bool is_server) OVERRIDE;
+
+  // Start implementation of SendAlgorithmInterface.
+  virtual void OnIncomingQuicCongestionFeedbackFrame(
+      const QuicCongestionFeedbackFrame& feedback,
+      QuicTime feedback_receive_time,
+      const SentPacketsMap& sent_packets) OVERRIDE;
+  virtual void OnIncomingAck(QuicPacketSequenceNumber acked_sequence_number,
+                             QuicByteCount acked_bytes,
+                             QuicTime::Delta rtt) OVERRIDE;
+  virtual void OnIncomingLoss(QuicTime ack_receive_time) OVERRIDE;
+  virtual bool OnPacketSent(
+      QuicTime sent_time,
+      QuicPacketSequenceNumber sequence_number,
+      QuicByteCount bytes,
+      TransmissionType transmission_type,
+      HasRetransmittableData is_retransmittable) OVERRIDE;
+  virtual void OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                 QuicByteCount abandoned_bytes) OVERRIDE;
+  virtual QuicTime::Delta TimeUntilSend(
+      QuicTime now,
+      TransmissionType transmission_type,
+      HasRetransmittableData has_retransmittable_data,
+      IsHandshake handshake) OVERRIDE;
+  virtual QuicBandwidth BandwidthEstimate() OVERRIDE;
+  virtual QuicTime::Delta SmoothedRtt() OVERRIDE;
+  virtual QuicTime::Delta RetransmissionDelay() OVERRIDE;
+  virtual QuicByteCount GetCongestionWindow() OVERRIDE;
+  virtual void SetCongestionWindow(QuicByteCount window) OVERRIDE;
+  // End implementation of SendAlgorithmInterface.
+
+  Mode mode() const { return mode_; }
+
+  // The minimum RTT seen recently, or Zero() before the first sample.
+  QuicTime::Delta min_rtt() const { return min_rtt_; }
+
+  // The rate packets are currently paced at.
+  QuicBandwidth PacingRate() const;
+
+ private:
+  // State recorded when a packet is sent, from which the delivery rate is
+  // sampled when it is acked.
+  struct SentPacketState {
+    SentPacketState(QuicByteCount bytes,
+                    QuicByteCount delivered,
+                    QuicTime delivered_time)
+        : bytes(bytes),
+          delivered(delivered),
+          delivered_time(delivered_time) {}
+    QuicByteCount bytes;
+    // |delivered_| and |delivered_time_| when the packet was sent.
+    QuicByteCount delivered;
+    QuicTime delivered_time;
+  };
+  typedef std::map<QuicPacketSequenceNumber, SentPacketState>
+      SentPacketStateMap;
+
+  // A delivery rate sample and the round trip it was taken in.
+  struct BandwidthSample {
+    BandwidthSample(QuicBandwidth bandwidth, int64 round)
+        : bandwidth(bandwidth), round(round) {}
+    QuicBandwidth bandwidth;
+    int64 round;
+  };
+
+  // The bandwidth-delay product scaled by |gain|.
+  QuicByteCount TargetCongestionWindow(float gain) const;
+
+  void UpdateBandwidth(const SentPacketState& packet, QuicTime now);
+  // Returns true if the minimum RTT had not been seen again for so long that
+  // it should be measured again.
+  bool UpdateMinRtt(QuicTime::Delta rtt, QuicTime now);
+  void UpdateSmoothedRtt(QuicTime::Delta rtt);
+  void CheckFullBandwidthReached();
+  void MaybeExitStartupOrDrain(QuicTime now);
+  void MaybeAdvanceGainCycle(QuicTime now);
+  void MaybeEnterOrExitProbeRtt(QuicTime now, bool min_rtt_expired);
+  void EnterProbeBandwidthMode(QuicTime now);
+  void UpdateCongestionWindow(QuicByteCount acked_bytes);
+
+  const QuicClock* clock_;
+  Mode mode_;
+
+  // Packets sent and not yet acked or abandoned.
+  SentPacketStateMap sent_packets_;
+  QuicByteCount bytes_in_flight_;
+
+  // Total bytes acked, and when the last of them was acked.
+  QuicByteCount delivered_;
+  QuicTime delivered_time_;
+
+  // Round trips are counted in acks: a round ends when a packet sent after
+  // the previous round ended is acked.
+  int64 round_count_;
+  QuicByteCount next_round_delivered_;
+  bool round_start_;
+
+  // Windowed max filter of the delivery rate samples of the last
+  // kBandwidthWindowRounds rounds. Samples are kept in decreasing order of
+  // bandwidth, so the front is the current estimate.
+  std::deque<BandwidthSample> max_bandwidth_;
+
+  QuicTime::Delta min_rtt_;
+  QuicTime min_rtt_timestamp_;
+
+  // STARTUP ends when the bandwidth estimate has not grown by
+  // kStartupGrowthTarget for kRoundTripsWithoutGrowthBeforeExitingStartup.
+  bool is_at_full_bandwidth_;
+  QuicBandwidth bandwidth_at_last_round_;
+  int rounds_without_bandwidth_gain_;
+
+  float pacing_gain_;
+  float congestion_window_gain_;
+  int cycle_current_offset_;
+  QuicTime last_cycle_start_;
+
+  // When PROBE_RTT may end, once the bytes in flight have dropped.
+  QuicTime exit_probe_rtt_at_;
+  bool probe_rtt_round_passed_;
+
+  QuicByteCount congestion_window_;
+  QuicByteCount initial_congestion_window_;
+
+  // Packets are not sent before this time, which spaces them out at the
+  // pacing rate.
+  QuicTime next_send_time_;
+
+  QuicTime::Delta initial_rtt_;
+  QuicTime::Delta smoothed_rtt_;
+  QuicTime::Delta mean_deviation_;
+
+  DISALLOW_COPY_AND_ASSIGN(BbrSender);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
@@ -0,0 +1,155 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include "base/logging.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "net/quic/test_tools/send_algorithm_simulator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+const int64 kBandwidthKBitsPerSecond = 10000;
+const int64 kRttMs = 100;
+
+class BbrSenderTest : public ::testing::Test {
+ protected:
+  BbrSenderTest()
+      : bandwidth_(QuicBandwidth::FromKBitsPerSecond(kBandwidthKBitsPerSecond)),
+        rtt_(QuicTime::Delta::FromMilliseconds(kRttMs)),
+        sender_(&clock_) {
+    // Start the clock somewhere other than zero, which the senders treat as
+    // uninitialized.
+    clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+  }
+
+  // The number of bytes the bottleneck link delivers in one RTT.
+  QuicByteCount BandwidthDelayProduct() const {
+    return bandwidth_.ToBytesPerPeriod(rtt_);
+  }
+
+  const QuicBandwidth bandwidth_;
+  const QuicTime::Delta rtt_;
+  MockClock clock_;
+  BbrSender sender_;
+};
+
+TEST_F(BbrSenderTest, PacesPackets) {
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    HAS_RETRANSMITTABLE_DATA,
+                                    NOT_HANDSHAKE).IsZero());
+  sender_.OnPacketSent(clock_.Now(), 1, kDefaultTCPMSS, NOT_RETRANSMISSION,
+                       HAS_RETRANSMITTABLE_DATA);
+  QuicTime::Delta delay = sender_.TimeUntilSend(
+      clock_.Now(), NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA,
+      NOT_HANDSHAKE);
+  EXPECT_FALSE(delay.IsZero());
+  EXPECT_FALSE(delay.IsInfinite());
+
+  // Acks and handshake packets are not paced.
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    NO_RETRANSMITTABLE_DATA,
+                                    NOT_HANDSHAKE).IsZero());
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    HAS_RETRANSMITTABLE_DATA,
+                                    IS_HANDSHAKE).IsZero());
+
+  clock_.AdvanceTime(delay);
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    HAS_RETRANSMITTABLE_DATA,
+                                    NOT_HANDSHAKE).IsZero());
+}
+
+TEST_F(BbrSenderTest, IgnoresUnknownPackets) {
+  sender_.OnPacketSent(clock_.Now(), 1, kDefaultTCPMSS, NOT_RETRANSMISSION,
+                       NO_RETRANSMITTABLE_DATA);
+  sender_.OnIncomingAck(1, kDefaultTCPMSS, rtt_);
+  sender_.OnPacketAbandoned(2, kDefaultTCPMSS);
+  EXPECT_TRUE(sender_.BandwidthEstimate().IsZero());
+  EXPECT_TRUE(sender_.min_rtt().IsZero());
+}
+
+TEST_F(BbrSenderTest, EstimatesBandwidthAndMinRtt) {
+  SendAlgorithmSimulator simulator(&clock_, bandwidth_, rtt_,
+                                   4 * BandwidthDelayProduct());
+  simulator.Transfer(&sender_, QuicTime::Delta::FromSeconds(5));
+
+  EXPECT_EQ(BbrSender::PROBE_BW, sender_.mode());
+  EXPECT_NEAR(kBandwidthKBitsPerSecond,
+              sender_.BandwidthEstimate().ToKBitsPerSecond(),
+              kBandwidthKBitsPerSecond / 20);
+  // The minimum RTT includes the time the link takes to send a packet.
+  EXPECT_LE(kRttMs, sender_.min_rtt().ToMilliseconds());
+  EXPECT_GE(kRttMs + 5, sender_.min_rtt().ToMilliseconds());
+  EXPECT_GE(2.5 * BandwidthDelayProduct(), sender_.GetCongestionWindow());
+}
+
+TEST_F(BbrSenderTest, ProbesMinRtt) {
+  SendAlgorithmSimulator simulator(&clock_, bandwidth_, rtt_,
+                                   4 * BandwidthDelayProduct());
+  simulator.Transfer(&sender_, QuicTime::Delta::FromSeconds(30));
+
+  // The minimum RTT has been measured again, without losing the bandwidth
+  // estimate.
+  EXPECT_GE(kRttMs + 5, sender_.min_rtt().ToMilliseconds());
+  EXPECT_NEAR(kBandwidthKBitsPerSecond,
+              sender_.BandwidthEstimate().ToKBitsPerSecond(),
+              kBandwidthKBitsPerSecond / 20);
+  SendAlgorithmSimulator::Results results =
+      simulator.Transfer(&sender_, QuicTime::Delta::FromSeconds(10));
+  EXPECT_LT(0.9 * kBandwidthKBitsPerSecond,
+            results.throughput.ToKBitsPerSecond());
+}
+
+// On a link with a buffer much larger than the bandwidth-delay product, Cubic
+// only backs off once the buffer is full, while BBR keeps the queue short at
+// the same throughput.
+TEST_F(BbrSenderTest, KeepsQueueShorterThanCubicOnBufferbloatedLink) {
+  const QuicByteCount buffer_size = 4 * BandwidthDelayProduct();
+  const QuicTime::Delta duration = QuicTime::Delta::FromSeconds(30);
+
+  TcpCubicSender cubic_sender(&clock_, false, 10000);
+  // The largest receive window TCP feedback can advertise, so that only the
+  // congestion window limits Cubic.
+  QuicCongestionFeedbackFrame feedback;
+  feedback.type = kTCP;
+  feedback.tcp.accumulated_number_of_lost_packets = 0;
+  feedback.tcp.receive_window = 1 << 20;
+  SendAlgorithmInterface::SentPacketsMap not_used;
+  cubic_sender.OnIncomingQuicCongestionFeedbackFrame(feedback, clock_.Now(),
+                                                     not_used);
+  SendAlgorithmSimulator cubic_simulator(&clock_, bandwidth_, rtt_,
+                                         buffer_size);
+  SendAlgorithmSimulator::Results cubic =
+      cubic_simulator.Transfer(&cubic_sender, duration);
+
+  SendAlgorithmSimulator bbr_simulator(&clock_, bandwidth_, rtt_,
+                                       buffer_size);
+  SendAlgorithmSimulator::Results bbr =
+      bbr_simulator.Transfer(&sender_, duration);
+
+  LOG(INFO) << "Cubic: " << cubic.throughput.ToKBitsPerSecond() << " kbps, "
+            << cubic.mean_queueing_delay.ToMilliseconds() << " ms queueing, "
+            << cubic.packets_lost << " packets lost";
+  LOG(INFO) << "BBR: " << bbr.throughput.ToKBitsPerSecond() << " kbps, "
+            << bbr.mean_queueing_delay.ToMilliseconds() << " ms queueing, "
+            << bbr.packets_lost << " packets lost";
+
+  EXPECT_LT(0.9 * kBandwidthKBitsPerSecond, bbr.throughput.ToKBitsPerSecond());
+  EXPECT_LT(0.9 * cubic.throughput.ToKBitsPerSecond(),
+            bbr.throughput.ToKBitsPerSecond());
+  EXPECT_GT(cubic.mean_queueing_delay.ToMicroseconds(),
+            4 * bbr.mean_queueing_delay.ToMicroseconds());
+  EXPECT_GT(rtt_.ToMicroseconds() / 2,
+            bbr.mean_queueing_delay.ToMicroseconds());
+  EXPECT_GT(cubic.packets_lost, bbr.packets_lost);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -32,6 +32,8 @@ class NET_EXPORT_PRIVATE QuicCongestionManager {
                         CongestionFeedbackType congestion_type);
   virtual ~QuicCongestionManager();
 
+  // Switches a kTCP manager to BbrSender once the congestion control is
+  // kTBBR.
   virtual void SetFromConfig(const QuicConfig& config, bool is_server);
 
   // Called when we have received an ack frame from peer.
@@ -118,6 +120,8 @@ class NET_EXPORT_PRIVATE QuicCongestionManager {
   const QuicClock* clock_;
   scoped_ptr<ReceiveAlgorithmInterface> receive_algorithm_;
   scoped_ptr<SendAlgorithmInterface> send_algorithm_;
+  const CongestionFeedbackType congestion_type_;
+  bool using_bbr_sender_;
   SendAlgorithmInterface::SentPacketsMap packet_history_map_;
   PendingPacketsMap pending_packets_;
   QuicPacketSequenceNumber largest_missing_;
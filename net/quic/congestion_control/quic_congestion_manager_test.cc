@@ -6,6 +6,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "net/quic/congestion_control/inter_arrival_sender.h"
 #include "net/quic/congestion_control/quic_congestion_manager.h"
+#include "net/quic/crypto/crypto_protocol.h"
+#include "net/quic/quic_config.h"
 #include "net/quic/quic_protocol.h"
 #include "net/quic/test_tools/mock_clock.h"
 #include "net/quic/test_tools/quic_test_utils.h"
@@ -243,5 +245,27 @@ TEST_F(QuicCongestionManagerTest, RttZeroDelta) {
   EXPECT_EQ(manager_->rtt(), expected_rtt);
 }
 
+TEST_F(QuicCongestionManagerTest, UsesBbrSenderForTBBR) {
+  SetUpCongestionType(kTCP);
+  QuicConfig config;
+  config.SetDefaults();
+  manager_->SetFromConfig(config, false);
+
+  // Cubic sends a whole congestion window at once.
+  manager_->OnPacketSent(1, clock_.Now(), 1000, NOT_RETRANSMISSION,
+                         HAS_RETRANSMITTABLE_DATA);
+  EXPECT_TRUE(manager_->TimeUntilSend(
+      clock_.Now(), NOT_RETRANSMISSION, kIgnored, NOT_HANDSHAKE).IsZero());
+
+  config.set_congestion_control(QuicTagVector(1, kTBBR), kTBBR);
+  manager_->SetFromConfig(config, false);
+
+  // BBR paces the packets it sends.
+  manager_->OnPacketSent(2, clock_.Now(), 1000, NOT_RETRANSMISSION,
+                         HAS_RETRANSMITTABLE_DATA);
+  EXPECT_FALSE(manager_->TimeUntilSend(
+      clock_.Now(), NOT_RETRANSMISSION, kIgnored, NOT_HANDSHAKE).IsZero());
+}
+
 }  // namespace test
 }  // namespace net
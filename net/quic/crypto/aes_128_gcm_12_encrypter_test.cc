@@ -325,6 +325,30 @@ TEST(Aes128Gcm12EncrypterTest, Encrypt) {
   }
 }
 
+TEST(Aes128Gcm12EncrypterTest, EncryptPacketToBuffer) {
+  Aes128Gcm12Encrypter encrypter;
+  ASSERT_TRUE(encrypter.SetKey(string(encrypter.GetKeySize(), 'k')));
+  ASSERT_TRUE(encrypter.SetNoncePrefix(
+      string(encrypter.GetNoncePrefixSize(), 'n')));
+  const string associated_data = "associated data";
+  const string plaintext(1000, 'p');
+
+  scoped_ptr<QuicData> encrypted(
+      encrypter.EncryptPacket(42, associated_data, plaintext));
+  ASSERT_TRUE(encrypted.get());
+
+  // Encrypting into a buffer, after a header, gives the same ciphertext.
+  const size_t kHeaderSize = 20;
+  string buffer(kHeaderSize + encrypter.GetCiphertextSize(plaintext.size()),
+                'h');
+  ASSERT_TRUE(encrypter.EncryptPacketToBuffer(42, associated_data, plaintext,
+                                              &buffer[kHeaderSize]));
+  EXPECT_EQ(string(kHeaderSize, 'h'), buffer.substr(0, kHeaderSize));
+  test::CompareCharArraysWithHexError(
+      "ciphertext", buffer.data() + kHeaderSize,
+      buffer.size() - kHeaderSize, encrypted->data(), encrypted->length());
+}
+
 TEST(Aes128Gcm12EncrypterTest, GetMaxPlaintextSize) {
   Aes128Gcm12Encrypter encrypter;
   EXPECT_EQ(1000u, encrypter.GetMaxPlaintextSize(1012));
@@ -5,6 +5,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "crypto/secure_hash.h"
 #include "net/quic/crypto/crypto_utils.h"
+#include "net/quic/crypto/proof_source.h"
 #include "net/quic/crypto/quic_crypto_server_config.h"
 #include "net/quic/crypto/quic_random.h"
 #include "net/quic/test_tools/crypto_test_utils.h"
@@ -14,10 +15,36 @@
 
 using base::StringPiece;
 using std::string;
+using std::vector;
 
 namespace net {
 namespace test {
 
+// CountingProofSource returns a fake proof and counts how many times it was
+// asked for one.
+class CountingProofSource : public ProofSource {
+ public:
+  explicit CountingProofSource(int* num_proofs)
+      : num_proofs_(num_proofs),
+        certs_(1, "certificate") {
+  }
+
+  virtual bool GetProof(const string& hostname,
+                        const string& server_config,
+                        bool ecdsa_ok,
+                        const vector<string>** out_certs,
+                        string* out_signature) OVERRIDE {
+    ++*num_proofs_;
+    *out_certs = &certs_;
+    *out_signature = "signature for " + hostname;
+    return true;
+  }
+
+ private:
+  int* const num_proofs_;
+  const vector<string> certs_;
+};
+
 class CryptoServerTest : public ::testing::Test {
  public:
   CryptoServerTest()
@@ -241,6 +268,34 @@ TEST_F(CryptoServerTest, ReplayProtection) {
   ASSERT_EQ(kSHLO, out_.tag());
 }
 
+TEST_F(CryptoServerTest, ProofIsCached) {
+  int num_proofs = 0;
+  config_.SetProofSource(new CountingProofSource(&num_proofs));
+
+  const char* kHostnames[] = {
+    "www.example.com",
+    "www.example.com",
+    "mail.example.com",
+  };
+  const int kExpectedProofs[] = { 1, 1, 2 };
+
+  for (size_t i = 0; i < arraysize(kHostnames); i++) {
+    ShouldSucceed(InchoateClientHello(
+        "CHLO",
+        "SNI", kHostnames[i],
+        "#004b5453", srct_hex_.c_str(),
+        "PDMD", "X509",
+        NULL));
+    ASSERT_EQ(kREJ, out_.tag());
+    EXPECT_EQ(kExpectedProofs[i], num_proofs);
+
+    // The cached signature is sent in the same way as a fresh one.
+    StringPiece proof;
+    ASSERT_TRUE(out_.GetStringPiece(kPROF, &proof));
+    EXPECT_EQ(string("signature for ") + kHostnames[i], proof.as_string());
+  }
+}
+
 TEST(CryptoServerConfigGenerationTest, Determinism) {
   // Test that using a deterministic PRNG causes the server-config to be
   // deterministic.
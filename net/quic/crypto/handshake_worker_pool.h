@@ -0,0 +1,30 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_QUIC_CRYPTO_HANDSHAKE_WORKER_POOL_H_
+#define NET_QUIC_CRYPTO_HANDSHAKE_WORKER_POOL_H_
+
+#include "base/callback_forward.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// HandshakeWorkerPool is an interface by which a QUIC server can process
+// client hellos away from the thread which runs its connections, so that the
+// key agreement, proof and strike-register work of a burst of new connections
+// does not delay the established ones.
+class NET_EXPORT_PRIVATE HandshakeWorkerPool {
+ public:
+  virtual ~HandshakeWorkerPool() {}
+
+  // PostTaskAndReply runs |task| on one of the pool's threads and then
+  // |reply| on the thread which runs the connections. If the pool is shut down
+  // before |reply| runs then |reply| is destroyed without being run.
+  virtual void PostTaskAndReply(const base::Closure& task,
+                                const base::Closure& reply) = 0;
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CRYPTO_HANDSHAKE_WORKER_POOL_H_
@@ -41,9 +41,21 @@ using std::vector;
 
 namespace net {
 
+namespace {
+
+// kMaxCachedProofsPerConfig is the number of hostnames that a config keeps
+// proofs for. Hostnames come from clients, so the cache is emptied when it
+// reaches this size rather than grow without bound.
+const size_t kMaxCachedProofsPerConfig = 64;
+
+}  // namespace
+
 // static
 const char QuicCryptoServerConfig::TESTING[] = "secret string for testing";
 
+// static
+const size_t QuicCryptoServerConfig::kNumStrikeRegisterShards;
+
 QuicCryptoServerConfig::ConfigOptions::ConfigOptions()
     : expiry_time(QuicWallTime::Zero()),
       channel_id_enabled(false),
@@ -56,7 +68,6 @@ QuicCryptoServerConfig::QuicCryptoServerConfig(
       configs_lock_(),
       primary_config_(NULL),
       next_config_promotion_time_(QuicWallTime::Zero()),
-      strike_register_lock_(),
       server_nonce_strike_register_lock_(),
       strike_register_no_startup_period_(false),
       strike_register_max_entries_(1 << 10),
@@ -660,11 +671,16 @@ QuicErrorCode QuicCryptoServerConfig::EvaluateClientHello(
       info->client_nonce.size() == kNonceSize) {
     info->client_nonce_well_formed = true;
     if (replay_protection_) {
-      base::AutoLock auto_lock(strike_register_lock_);
-
-      if (strike_register_.get() == NULL) {
-        strike_register_.reset(new StrikeRegister(
-            strike_register_max_entries_,
+      StrikeRegisterShard* shard =
+          &strike_register_shards_[StrikeRegisterShardForNonce(
+              info->client_nonce)];
+      base::AutoLock auto_lock(shard->lock);
+
+      if (shard->strike_register.get() == NULL) {
+        shard->strike_register.reset(new StrikeRegister(
+            std::max(strike_register_max_entries_ /
+                         static_cast<uint32>(kNumStrikeRegisterShards),
+                     1u),
             static_cast<uint32>(info->now.ToUNIXSeconds()),
             strike_register_window_secs_,
             orbit,
@@ -673,7 +689,7 @@ QuicErrorCode QuicCryptoServerConfig::EvaluateClientHello(
             StrikeRegister::DENY_REQUESTS_AT_STARTUP));
       }
 
-      unique_by_strike_register = strike_register_->Insert(
+      unique_by_strike_register = shard->strike_register->Insert(
           reinterpret_cast<const uint8*>(info->client_nonce.data()),
           static_cast<uint32>(info->now.ToUNIXSeconds()));
     }
@@ -697,6 +713,57 @@ QuicErrorCode QuicCryptoServerConfig::EvaluateClientHello(
   return QUIC_NO_ERROR;
 }
 
+bool QuicCryptoServerConfig::GetProof(const scoped_refptr<Config>& config,
+                                      const string& hostname,
+                                      bool ecdsa_ok,
+                                      const vector<string>** out_certs,
+                                      string* out_signature) const {
+  const Config::ProofMap::key_type key(hostname, ecdsa_ok);
+  {
+    base::AutoLock locked(config->proof_lock);
+    Config::ProofMap::const_iterator it = config->proof_cache.find(key);
+    if (it != config->proof_cache.end()) {
+      *out_certs = it->second.certs;
+      *out_signature = it->second.signature;
+      return true;
+    }
+  }
+
+  // Signing is slow, so it is done without holding the lock. Concurrent
+  // handshakes for the same hostname may each sign the config once.
+  if (!proof_source_->GetProof(hostname, config->serialized, ecdsa_ok,
+                               out_certs, out_signature)) {
+    return false;
+  }
+
+  base::AutoLock locked(config->proof_lock);
+  if (config->proof_cache.size() >= kMaxCachedProofsPerConfig) {
+    config->proof_cache.clear();
+  }
+  Config::CachedProof* cached = &config->proof_cache[key];
+  cached->certs = *out_certs;
+  cached->signature = *out_signature;
+  return true;
+}
+
+size_t QuicCryptoServerConfig::StrikeRegisterShardForNonce(
+    StringPiece client_nonce) const {
+  DCHECK_EQ(kNonceSize, client_nonce.size());
+  // The nonce ends with random bytes, which spread the nonces evenly.
+  return static_cast<uint8>(client_nonce[client_nonce.size() - 1]) %
+         kNumStrikeRegisterShards;
+}
+
+bool QuicCryptoServerConfig::HasStrikeRegister() const {
+  for (size_t i = 0; i < kNumStrikeRegisterShards; ++i) {
+    base::AutoLock locked(strike_register_shards_[i].lock);
+    if (strike_register_shards_[i].strike_register.get()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void QuicCryptoServerConfig::BuildRejection(
     const scoped_refptr<Config>& config,
     const CryptoHandshakeMessage& client_hello,
@@ -741,8 +808,8 @@ void QuicCryptoServerConfig::BuildRejection(
 
   const vector<string>* certs;
   string signature;
-  if (!proof_source_->GetProof(info.sni.as_string(), config->serialized,
-                               x509_ecdsa_supported, &certs, &signature)) {
+  if (!GetProof(config, info.sni.as_string(), x509_ecdsa_supported, &certs,
+                &signature)) {
     return;
   }
 
@@ -837,10 +904,10 @@ QuicCryptoServerConfig::ParseConfigProtobuf(
   COMPILE_ASSERT(sizeof(config->orbit) == kOrbitSize, orbit_incorrect_size);
   memcpy(config->orbit, orbit.data(), sizeof(config->orbit));
 
-  {
-    base::AutoLock locked(strike_register_lock_);
-    if (strike_register_.get()) {
-      const uint8* orbit = strike_register_->orbit();
+  for (size_t i = 0; i < kNumStrikeRegisterShards; ++i) {
+    base::AutoLock locked(strike_register_shards_[i].lock);
+    if (strike_register_shards_[i].strike_register.get()) {
+      const uint8* orbit = strike_register_shards_[i].strike_register->orbit();
       if (0 != memcmp(orbit, config->orbit, kOrbitSize)) {
         LOG(WARNING)
             << "Server config has different orbit than current config. "
@@ -951,22 +1018,19 @@ void QuicCryptoServerConfig::set_replay_protection(bool on) {
 }
 
 void QuicCryptoServerConfig::set_strike_register_no_startup_period() {
-  base::AutoLock auto_lock(strike_register_lock_);
-  DCHECK(!strike_register_.get());
+  DCHECK(!HasStrikeRegister());
   strike_register_no_startup_period_ = true;
 }
 
 void QuicCryptoServerConfig::set_strike_register_max_entries(
     uint32 max_entries) {
-  base::AutoLock locker(strike_register_lock_);
-  DCHECK(!strike_register_.get());
+  DCHECK(!HasStrikeRegister());
   strike_register_max_entries_ = max_entries;
 }
 
 void QuicCryptoServerConfig::set_strike_register_window_secs(
     uint32 window_secs) {
-  base::AutoLock locker(strike_register_lock_);
-  DCHECK(!strike_register_.get());
+  DCHECK(!HasStrikeRegister());
   strike_register_window_secs_ = window_secs;
 }
 
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
@@ -131,6 +132,10 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   //     contain the state of the connection.
   // out: the resulting handshake message (either REJ or SHLO)
   // error_details: used to store a string describing any error.
+  //
+  // ProcessClientHello may be called concurrently, e.g. from a pool of
+  // handshake threads, as long as |clock|, |rand| and the EphemeralKeySource
+  // can be used from those threads.
   QuicErrorCode ProcessClientHello(const CryptoHandshakeMessage& client_hello,
                                    QuicGuid guid,
                                    const IPEndPoint& client_ip,
@@ -157,13 +162,14 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // request to be processed twice.
   void set_replay_protection(bool on);
 
-  // set_strike_register_no_startup_period configures the strike register to
+  // set_strike_register_no_startup_period configures the strike registers to
   // not have a startup period.
   void set_strike_register_no_startup_period();
 
   // set_strike_register_max_entries sets the maximum number of entries that
-  // the internal strike register will hold. If the strike register fills up
-  // then the oldest entries (by the client's clock) will be dropped.
+  // the internal strike registers will hold between them. If a strike
+  // register fills up then its oldest entries (by the client's clock) will be
+  // dropped.
   void set_strike_register_max_entries(uint32 max_entries);
 
   // set_strike_register_window_secs sets the number of seconds around the
@@ -239,6 +245,24 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
     // will not be promoted at a specific time.
     QuicWallTime primary_time;
 
+    // CachedProof is a certificate chain, owned by the ProofSource, and the
+    // signature of |serialized| made with it.
+    struct CachedProof {
+      const std::vector<std::string>* certs;
+      std::string signature;
+    };
+
+    // ProofMap is keyed by the hostname that a proof was requested for and
+    // whether an ECDSA signature was acceptable.
+    typedef std::map<std::pair<std::string, bool>, CachedProof> ProofMap;
+
+    // proof_lock guards |proof_cache|.
+    base::Lock proof_lock;
+    // proof_cache contains the proofs of this config obtained from the
+    // ProofSource, so that the config is signed once rather than for every
+    // rejection.
+    ProofMap proof_cache;
+
    private:
     friend class base::RefCounted<Config>;
     virtual ~Config();
@@ -266,6 +290,23 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
       ClientHelloInfo* info,
       std::string* error_details) const;
 
+  // GetProof sets |out_certs| and |out_signature| to the certificate chain for
+  // |hostname| and the signature of |config| made with it, and returns true if
+  // the ProofSource could provide them. Proofs are cached in |config|.
+  bool GetProof(const scoped_refptr<Config>& config,
+                const std::string& hostname,
+                bool ecdsa_ok,
+                const std::vector<std::string>** out_certs,
+                std::string* out_signature) const;
+
+  // StrikeRegisterShardForNonce returns the strike register shard which
+  // records |client_nonce|.
+  size_t StrikeRegisterShardForNonce(base::StringPiece client_nonce) const;
+
+  // HasStrikeRegister returns true once any of the strike registers has been
+  // created, after which their parameters can no longer change.
+  bool HasStrikeRegister() const;
+
   // BuildRejection sets |out| to be a REJ message in reply to |client_hello|.
   void BuildRejection(
       const scoped_refptr<Config>& config,
@@ -322,10 +363,22 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // active config will be promoted to primary.
   mutable QuicWallTime next_config_promotion_time_;
 
-  mutable base::Lock strike_register_lock_;
-  // strike_register_ contains a data structure that keeps track of previously
-  // observed client nonces in order to prevent replay attacks.
-  mutable scoped_ptr<StrikeRegister> strike_register_;
+  // kNumStrikeRegisterShards is the number of strike registers which client
+  // nonces are spread over, so that concurrent handshakes seldom wait for the
+  // same lock.
+  static const size_t kNumStrikeRegisterShards = 16;
+
+  // StrikeRegisterShard contains a strike register, which is created with the
+  // first nonce it records, and the lock which guards it.
+  struct StrikeRegisterShard {
+    base::Lock lock;
+    scoped_ptr<StrikeRegister> strike_register;
+  };
+
+  // strike_register_shards_ contain data structures that keep track of
+  // previously observed client nonces in order to prevent replay attacks. Each
+  // nonce is recorded in the shard picked by StrikeRegisterShardForNonce().
+  mutable StrikeRegisterShard strike_register_shards_[kNumStrikeRegisterShards];
 
   // source_address_token_boxer_ is used to protect the source-address tokens
   // that are given to clients.
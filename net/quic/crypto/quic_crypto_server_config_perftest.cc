@@ -0,0 +1,172 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/string_piece.h"
+#include "base/test/perf_log.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_util.h"
+#include "net/quic/crypto/crypto_handshake.h"
+#include "net/quic/crypto/crypto_protocol.h"
+#include "net/quic/crypto/crypto_utils.h"
+#include "net/quic/crypto/quic_crypto_server_config.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/quic/quic_clock.h"
+#include "net/quic/quic_protocol.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::StringPiece;
+using std::string;
+
+namespace net {
+namespace test {
+namespace {
+
+const int kHandshakesPerThread = 2000;
+const int kNumThreads = 4;
+
+// Accepts |num_handshakes| client hellos, each with a fresh nonce so that the
+// strike registers are exercised, with |config|.
+class HandshakeRunner : public base::DelegateSimpleThread::Delegate {
+ public:
+  HandshakeRunner(const QuicCryptoServerConfig* config,
+                  const CryptoHandshakeMessage& client_hello,
+                  const IPEndPoint& client_address,
+                  const string& orbit,
+                  int num_handshakes)
+      : config_(config),
+        client_hello_(client_hello),
+        client_address_(client_address),
+        orbit_(orbit),
+        num_handshakes_(num_handshakes),
+        num_accepted_(0) {
+  }
+
+  virtual void Run() OVERRIDE {
+    QuicClock clock;
+    QuicRandom* rand = QuicRandom::GetInstance();
+    for (int i = 0; i < num_handshakes_; ++i) {
+      CryptoHandshakeMessage client_hello(client_hello_);
+      string nonce;
+      CryptoUtils::GenerateNonce(clock.WallNow(), rand, orbit_, &nonce);
+      client_hello.SetStringPiece(kNONC, nonce);
+
+      QuicCryptoNegotiatedParameters params;
+      CryptoHandshakeMessage reply;
+      string error_details;
+      QuicErrorCode error = config_->ProcessClientHello(
+          client_hello, rand->RandUint64(), client_address_, &clock, rand,
+          &params, &reply, &error_details);
+      CHECK_EQ(QUIC_NO_ERROR, error) << error_details;
+      if (reply.tag() == kSHLO) {
+        ++num_accepted_;
+      }
+    }
+  }
+
+  int num_accepted() const { return num_accepted_; }
+
+ private:
+  const QuicCryptoServerConfig* config_;
+  const CryptoHandshakeMessage client_hello_;
+  const IPEndPoint client_address_;
+  const string orbit_;
+  const int num_handshakes_;
+  int num_accepted_;
+
+  DISALLOW_COPY_AND_ASSIGN(HandshakeRunner);
+};
+
+class QuicCryptoServerConfigPerfTest : public ::testing::Test {
+ protected:
+  QuicCryptoServerConfigPerfTest()
+      : config_(QuicCryptoServerConfig::TESTING, QuicRandom::GetInstance()) {
+  }
+
+  virtual void SetUp() OVERRIDE {
+    IPAddressNumber ip;
+    ASSERT_TRUE(ParseIPLiteralToNumber("192.0.2.33", &ip));
+    client_address_ = IPEndPoint(ip, 1);
+
+    config_.set_strike_register_no_startup_period();
+    // Large enough for no nonce to be evicted during the test.
+    config_.set_strike_register_max_entries(1 << 20);
+    QuicClock clock;
+    scoped_ptr<CryptoHandshakeMessage> scfg(config_.AddDefaultConfig(
+        QuicRandom::GetInstance(), &clock,
+        QuicCryptoServerConfig::ConfigOptions()));
+    StringPiece scid, orbit;
+    ASSERT_TRUE(scfg->GetStringPiece(kSCID, &scid));
+    ASSERT_TRUE(scfg->GetStringPiece(kORBT, &orbit));
+    orbit_ = orbit.as_string();
+
+    client_hello_.set_tag(kCHLO);
+    client_hello_.SetStringPiece(kPAD, string(kClientHelloMinimumSize, '-'));
+
+    // An inchoate client hello fetches the source-address token.
+    QuicCryptoNegotiatedParameters params;
+    CryptoHandshakeMessage reply;
+    string error_details;
+    ASSERT_EQ(QUIC_NO_ERROR, config_.ProcessClientHello(
+        client_hello_, 1, client_address_, &clock, QuicRandom::GetInstance(),
+        &params, &reply, &error_details));
+    ASSERT_EQ(kREJ, reply.tag());
+    StringPiece srct;
+    ASSERT_TRUE(reply.GetStringPiece(kSourceAddressTokenTag, &srct));
+
+    client_hello_.SetTaglist(kAEAD, kAESG, 0);
+    client_hello_.SetTaglist(kKEXS, kC255, 0);
+    client_hello_.SetStringPiece(kSCID, scid);
+    client_hello_.SetStringPiece(kSourceAddressTokenTag, srct);
+    client_hello_.SetStringPiece(kPUBS, string(32, 42));
+  }
+
+  // Runs |num_threads| threads which each accept kHandshakesPerThread client
+  // hellos, and logs the number of handshakes per second as |name|.
+  void RunHandshakes(const char* name, int num_threads) {
+    ScopedVector<HandshakeRunner> runners;
+    ScopedVector<base::DelegateSimpleThread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      runners.push_back(new HandshakeRunner(
+          &config_, client_hello_, client_address_, orbit_,
+          kHandshakesPerThread));
+      threads.push_back(new base::DelegateSimpleThread(runners[i], name));
+    }
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < num_threads; ++i) {
+      threads[i]->Start();
+    }
+    for (int i = 0; i < num_threads; ++i) {
+      threads[i]->Join();
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    for (int i = 0; i < num_threads; ++i) {
+      EXPECT_EQ(kHandshakesPerThread, runners[i]->num_accepted());
+    }
+    base::LogPerfResult(
+        name, num_threads * kHandshakesPerThread / elapsed.InSecondsF(),
+        "handshakes/s");
+  }
+
+  QuicCryptoServerConfig config_;
+  IPEndPoint client_address_;
+  string orbit_;
+  CryptoHandshakeMessage client_hello_;
+};
+
+TEST_F(QuicCryptoServerConfigPerfTest, Handshakes) {
+  RunHandshakes("QuicHandshakes_1_thread", 1);
+  RunHandshakes("QuicHandshakes_4_threads", kNumThreads);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -5,24 +5,119 @@
 #include "net/quic/quic_crypto_server_stream.h"
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "crypto/secure_hash.h"
 #include "net/quic/crypto/crypto_protocol.h"
 #include "net/quic/crypto/crypto_utils.h"
+#include "net/quic/crypto/handshake_worker_pool.h"
 #include "net/quic/crypto/quic_crypto_server_config.h"
+#include "net/quic/crypto/quic_decrypter.h"
+#include "net/quic/crypto/quic_encrypter.h"
+#include "net/quic/quic_clock.h"
 #include "net/quic/quic_config.h"
 #include "net/quic/quic_protocol.h"
 #include "net/quic/quic_session.h"
 
 namespace net {
 
+namespace {
+
+// MoveNegotiatedParameters moves the parameters that
+// QuicCryptoServerConfig::ProcessClientHello sets from |from| to |to|.
+void MoveNegotiatedParameters(QuicCryptoNegotiatedParameters* from,
+                              QuicCryptoNegotiatedParameters* to) {
+  to->key_exchange = from->key_exchange;
+  to->aead = from->aead;
+  to->initial_premaster_secret.swap(from->initial_premaster_secret);
+  to->forward_secure_premaster_secret.swap(
+      from->forward_secure_premaster_secret);
+  to->initial_crypters.encrypter.reset(
+      from->initial_crypters.encrypter.release());
+  to->initial_crypters.decrypter.reset(
+      from->initial_crypters.decrypter.release());
+  to->forward_secure_crypters.encrypter.reset(
+      from->forward_secure_crypters.encrypter.release());
+  to->forward_secure_crypters.decrypter.reset(
+      from->forward_secure_crypters.decrypter.release());
+  to->sni.swap(from->sni);
+  to->channel_id.swap(from->channel_id);
+}
+
+}  // namespace
+
+// ProcessClientHelloJob processes a client hello on a handshake worker
+// thread. It has its own copy of everything that it uses, so that the stream
+// may be deleted while it runs.
+class QuicCryptoServerStream::ProcessClientHelloJob
+    : public base::RefCountedThreadSafe<ProcessClientHelloJob> {
+ public:
+  ProcessClientHelloJob(QuicCryptoServerStream* stream,
+                        const CryptoHandshakeMessage& message)
+      : stream_(stream),
+        crypto_config_(&stream->crypto_config_),
+        message_(message),
+        guid_(stream->session()->connection()->guid()),
+        client_address_(stream->session()->connection()->peer_address()),
+        rand_(stream->session()->connection()->random_generator()),
+        error_(QUIC_NO_ERROR) {
+  }
+
+  // Run is called on a handshake worker thread. The connection's clock is
+  // only meant for its own thread, so a real time clock is used instead.
+  void Run() {
+    QuicClock clock;
+    error_ = crypto_config_->ProcessClientHello(
+        message_, guid_, client_address_, &clock, rand_, &params_, &reply_,
+        &error_details_);
+  }
+
+  // Finish is called on the connection's thread once Run has returned.
+  void Finish() {
+    if (stream_ != NULL) {
+      stream_->OnClientHelloProcessed(this);
+    }
+  }
+
+  // Cancel stops the result of the job from being delivered to the stream.
+  void Cancel() { stream_ = NULL; }
+
+  const CryptoHandshakeMessage& message() const { return message_; }
+  QuicErrorCode error() const { return error_; }
+  const std::string& error_details() const { return error_details_; }
+  CryptoHandshakeMessage* mutable_reply() { return &reply_; }
+  QuicCryptoNegotiatedParameters* params() { return &params_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<ProcessClientHelloJob>;
+  ~ProcessClientHelloJob() {}
+
+  QuicCryptoServerStream* stream_;
+  const QuicCryptoServerConfig* const crypto_config_;
+  const CryptoHandshakeMessage message_;
+  const QuicGuid guid_;
+  const IPEndPoint client_address_;
+  QuicRandom* const rand_;
+
+  QuicErrorCode error_;
+  std::string error_details_;
+  CryptoHandshakeMessage reply_;
+  QuicCryptoNegotiatedParameters params_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessClientHelloJob);
+};
+
 QuicCryptoServerStream::QuicCryptoServerStream(
     const QuicCryptoServerConfig& crypto_config,
     QuicSession* session)
     : QuicCryptoStream(session),
-      crypto_config_(crypto_config) {
+      crypto_config_(crypto_config),
+      handshake_worker_pool_(NULL) {
 }
 
 QuicCryptoServerStream::~QuicCryptoServerStream() {
+  if (pending_job_.get() != NULL) {
+    pending_job_->Cancel();
+  }
 }
 
 void QuicCryptoServerStream::OnHandshakeMessage(
@@ -40,31 +135,68 @@ void QuicCryptoServerStream::OnHandshakeMessage(
     return;
   }
 
+  // The client waits for the reply to one client hello before sending the
+  // next one.
+  if (pending_job_.get() != NULL) {
+    CloseConnection(QUIC_CRYPTO_MESSAGE_WHILE_PROCESSING_CLIENT_HELLO);
+    return;
+  }
+
+  if (handshake_worker_pool_ != NULL) {
+    pending_job_ = new ProcessClientHelloJob(this, message);
+    handshake_worker_pool_->PostTaskAndReply(
+        base::Bind(&ProcessClientHelloJob::Run, pending_job_),
+        base::Bind(&ProcessClientHelloJob::Finish, pending_job_));
+    return;
+  }
+
   string error_details;
   CryptoHandshakeMessage reply;
-
   QuicErrorCode error = ProcessClientHello(message, &reply, &error_details);
+  FinishProcessingHandshakeMessage(message, error, error_details, &reply);
+}
 
+void QuicCryptoServerStream::OnClientHelloProcessed(
+    ProcessClientHelloJob* job) {
+  DCHECK_EQ(pending_job_.get(), job);
+  pending_job_ = NULL;
+
+  // The connection may have been closed while the job was running.
+  if (!session()->connection()->connected()) {
+    return;
+  }
+
+  MoveNegotiatedParameters(job->params(), &crypto_negotiated_params_);
+  FinishProcessingHandshakeMessage(job->message(), job->error(),
+                                   job->error_details(), job->mutable_reply());
+}
+
+void QuicCryptoServerStream::FinishProcessingHandshakeMessage(
+    const CryptoHandshakeMessage& message,
+    QuicErrorCode error,
+    const string& error_details,
+    CryptoHandshakeMessage* reply) {
   if (error != QUIC_NO_ERROR) {
     CloseConnectionWithDetails(error, error_details);
     return;
   }
 
-  if (reply.tag() != kSHLO) {
-    SendHandshakeMessage(reply);
+  if (reply->tag() != kSHLO) {
+    SendHandshakeMessage(*reply);
     return;
   }
 
   // If we are returning a SHLO then we accepted the handshake.
   QuicConfig* config = session()->config();
-  error = config->ProcessClientHello(message, &error_details);
+  string config_error_details;
+  error = config->ProcessClientHello(message, &config_error_details);
   if (error != QUIC_NO_ERROR) {
-    CloseConnectionWithDetails(error, error_details);
+    CloseConnectionWithDetails(error, config_error_details);
     return;
   }
   session()->OnConfigNegotiated();
 
-  config->ToHandshakeMessage(&reply);
+  config->ToHandshakeMessage(reply);
 
   // Receiving a full CHLO implies the client is prepared to decrypt with
   // the new server write key.  We can start to encrypt with the new server
@@ -80,7 +212,7 @@ void QuicCryptoServerStream::OnHandshakeMessage(
   // packets.
   session()->connection()->SetDecrypter(
       crypto_negotiated_params_.initial_crypters.decrypter.release());
-  SendHandshakeMessage(reply);
+  SendHandshakeMessage(*reply);
 
   session()->connection()->SetEncrypter(
       ENCRYPTION_FORWARD_SECURE,
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "base/memory/ref_counted.h"
 #include "net/quic/crypto/crypto_handshake.h"
 #include "net/quic/quic_config.h"
 #include "net/quic/quic_crypto_stream.h"
@@ -14,6 +15,7 @@
 namespace net {
 
 class CryptoHandshakeMessage;
+class HandshakeWorkerPool;
 class QuicCryptoServerConfig;
 class QuicSession;
 
@@ -37,6 +39,14 @@ class NET_EXPORT_PRIVATE QuicCryptoServerStream : public QuicCryptoStream {
   // presented a ChannelID. Otherwise it returns false.
   bool GetBase64SHA256ClientChannelID(std::string* output) const;
 
+  // set_handshake_worker_pool makes the stream process client hellos on
+  // |worker_pool| rather than on the connection's thread. The server config,
+  // and the connection's random generator, must then be usable from the
+  // pool's threads. Not owned.
+  void set_handshake_worker_pool(HandshakeWorkerPool* worker_pool) {
+    handshake_worker_pool_ = worker_pool;
+  }
+
  protected:
   virtual QuicErrorCode ProcessClientHello(
       const CryptoHandshakeMessage& message,
@@ -46,8 +56,29 @@ class NET_EXPORT_PRIVATE QuicCryptoServerStream : public QuicCryptoStream {
  private:
   friend class test::CryptoTestUtils;
 
+  class ProcessClientHelloJob;
+
+  // FinishProcessingHandshakeMessage sends |reply|, the result of processing
+  // the client hello |message|, and sets up the encryption of the connection
+  // if the handshake was accepted. It closes the connection if |error| is set.
+  void FinishProcessingHandshakeMessage(const CryptoHandshakeMessage& message,
+                                        QuicErrorCode error,
+                                        const std::string& error_details,
+                                        CryptoHandshakeMessage* reply);
+
+  // OnClientHelloProcessed is called on the connection's thread when
+  // |pending_job_| has been run by the handshake worker pool.
+  void OnClientHelloProcessed(ProcessClientHelloJob* job);
+
   // crypto_config_ contains crypto parameters for the handshake.
   const QuicCryptoServerConfig& crypto_config_;
+
+  // handshake_worker_pool_, if not NULL, processes the client hellos.
+  HandshakeWorkerPool* handshake_worker_pool_;
+
+  // pending_job_ is the job processing the last client hello on
+  // |handshake_worker_pool_|, until it has finished.
+  scoped_refptr<ProcessClientHelloJob> pending_job_;
 };
 
 }  // namespace net
@@ -5,14 +5,17 @@
 #include "net/quic/quic_crypto_server_stream.h"
 
 #include <map>
+#include <utility>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/memory/scoped_ptr.h"
 #include "net/quic/crypto/aes_128_gcm_12_encrypter.h"
 #include "net/quic/crypto/crypto_framer.h"
 #include "net/quic/crypto/crypto_handshake.h"
 #include "net/quic/crypto/crypto_protocol.h"
 #include "net/quic/crypto/crypto_utils.h"
+#include "net/quic/crypto/handshake_worker_pool.h"
 #include "net/quic/crypto/quic_crypto_server_config.h"
 #include "net/quic/crypto/quic_decrypter.h"
 #include "net/quic/crypto/quic_encrypter.h"
@@ -36,6 +39,30 @@ namespace net {
 namespace test {
 namespace {
 
+// TestHandshakeWorkerPool keeps the posted tasks until RunTasks is called.
+class TestHandshakeWorkerPool : public HandshakeWorkerPool {
+ public:
+  virtual void PostTaskAndReply(const base::Closure& task,
+                                const base::Closure& reply) OVERRIDE {
+    tasks_.push_back(std::make_pair(task, reply));
+  }
+
+  // Runs the posted tasks, each followed by its reply.
+  void RunTasks() {
+    std::vector<std::pair<base::Closure, base::Closure> > tasks;
+    tasks.swap(tasks_);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].first.Run();
+      tasks[i].second.Run();
+    }
+  }
+
+  size_t num_tasks() const { return tasks_.size(); }
+
+ private:
+  std::vector<std::pair<base::Closure, base::Closure> > tasks_;
+};
+
 class QuicCryptoServerStreamTest : public ::testing::Test {
  public:
   QuicCryptoServerStreamTest()
@@ -61,6 +88,14 @@ class QuicCryptoServerStreamTest : public ::testing::Test {
         session_.config(), &crypto_config_);
   }
 
+  // ConstructClientHello sets |message_| to a client hello which the server
+  // rejects, as the client knows nothing about the server yet.
+  void ConstructClientHello() {
+    message_.set_tag(kCHLO);
+    message_.SetStringPiece(kPAD, std::string(kClientHelloMinimumSize, '-'));
+    ConstructHandshakeMessage();
+  }
+
   void ConstructHandshakeMessage() {
     CryptoFramer framer;
     message_data_.reset(framer.ConstructHandshakeMessage(message_));
@@ -206,6 +241,47 @@ TEST_F(QuicCryptoServerStreamTest, ChannelID) {
   EXPECT_TRUE(stream_.handshake_confirmed());
 }
 
+TEST_F(QuicCryptoServerStreamTest, ProcessClientHelloOnWorkerPool) {
+  TestHandshakeWorkerPool worker_pool;
+  stream_.set_handshake_worker_pool(&worker_pool);
+
+  ConstructClientHello();
+  stream_.ProcessData(message_data_->data(), message_data_->length());
+  // Nothing is sent until the worker pool has processed the client hello.
+  EXPECT_EQ(1u, worker_pool.num_tasks());
+  EXPECT_EQ(0u, connection_->packets_.size());
+
+  worker_pool.RunTasks();
+  ASSERT_EQ(1u, connection_->packets_.size());
+  EXPECT_FALSE(stream_.encryption_established());
+}
+
+TEST_F(QuicCryptoServerStreamTest, MessageWhileProcessingClientHello) {
+  TestHandshakeWorkerPool worker_pool;
+  stream_.set_handshake_worker_pool(&worker_pool);
+
+  ConstructClientHello();
+  stream_.ProcessData(message_data_->data(), message_data_->length());
+  EXPECT_CALL(*connection_, SendConnectionClose(
+      QUIC_CRYPTO_MESSAGE_WHILE_PROCESSING_CLIENT_HELLO));
+  stream_.ProcessData(message_data_->data(), message_data_->length());
+}
+
+TEST_F(QuicCryptoServerStreamTest, DeletedWhileProcessingClientHello) {
+  TestHandshakeWorkerPool worker_pool;
+  scoped_ptr<QuicCryptoServerStream> stream(
+      new QuicCryptoServerStream(crypto_config_, &session_));
+  stream->set_handshake_worker_pool(&worker_pool);
+
+  ConstructClientHello();
+  stream->ProcessData(message_data_->data(), message_data_->length());
+  stream.reset();
+
+  // The reply for the deleted stream is dropped.
+  worker_pool.RunTasks();
+  EXPECT_EQ(0u, connection_->packets_.size());
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace net
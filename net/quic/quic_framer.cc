@@ -1615,19 +1615,21 @@ QuicEncryptedPacket* QuicFramer::EncryptPacket(
     const QuicPacket& packet) {
   DCHECK(encrypter_[level].get() != NULL);
 
-  scoped_ptr<QuicData> out(encrypter_[level]->EncryptPacket(
-      packet_sequence_number, packet.AssociatedData(), packet.Plaintext()));
-  if (out.get() == NULL) {
+  // The header is sent in the clear, and the payload is encrypted directly
+  // into the outgoing packet buffer, after it.
+  StringPiece header_data = packet.BeforePlaintext();
+  StringPiece plaintext = packet.Plaintext();
+  size_t len = header_data.length() +
+      encrypter_[level]->GetCiphertextSize(plaintext.length());
+  scoped_ptr<char[]> buffer(new char[len]);
+  memcpy(buffer.get(), header_data.data(), header_data.length());
+  if (!encrypter_[level]->EncryptPacketToBuffer(
+          packet_sequence_number, packet.AssociatedData(), plaintext,
+          buffer.get() + header_data.length())) {
     RaiseError(QUIC_ENCRYPTION_FAILURE);
     return NULL;
   }
-  StringPiece header_data = packet.BeforePlaintext();
-  size_t len =  header_data.length() + out->length();
-  char* buffer = new char[len];
-  // TODO(rch): eliminate this buffer copy by passing in a buffer to Encrypt().
-  memcpy(buffer, header_data.data(), header_data.length());
-  memcpy(buffer + header_data.length(), out->data(), out->length());
-  return new QuicEncryptedPacket(buffer, len, true);
+  return new QuicEncryptedPacket(buffer.release(), len, true);
 }
 
 size_t QuicFramer::GetMaxPlaintextSize(size_t ciphertext_size) {
@@ -4,6 +4,8 @@
 
 #include "net/quic/reliable_quic_stream.h"
 
+#include <vector>
+
 #include "net/quic/quic_session.h"
 #include "net/quic/quic_spdy_decompressor.h"
 #include "net/spdy/write_blocked_list.h"
@@ -45,7 +47,8 @@ uint32 StripUint32(const char* data, uint32 data_len,
 
 ReliableQuicStream::ReliableQuicStream(QuicStreamId id,
                                        QuicSession* session)
-    : sequencer_(this),
+    : queued_data_offset_(0),
+      sequencer_(this),
       id_(id),
       session_(session),
       visitor_(NULL),
@@ -218,7 +221,7 @@ QuicConsumedData ReliableQuicStream::WriteOrBuffer(StringPiece data, bool fin) {
   fin_buffered_ = fin;
 
   if (queued_data_.empty()) {
-    consumed_data = WriteDataInternal(string(data.data(), data.length()), fin);
+    consumed_data = WriteDataInternal(data, fin);
     DCHECK_LE(consumed_data.bytes_consumed, data.length());
   }
 
@@ -234,20 +237,38 @@ QuicConsumedData ReliableQuicStream::WriteOrBuffer(StringPiece data, bool fin) {
 }
 
 void ReliableQuicStream::OnCanWrite() {
-  bool fin = false;
+  if (queued_data_.empty()) {
+    return;
+  }
+
+  // Hand all the queued data to the session at once, referencing it in place
+  // rather than moving the unsent bytes to the front of each buffer.
+  std::vector<struct iovec> iov;
+  iov.reserve(queued_data_.size());
+  size_t offset = queued_data_offset_;
+  for (std::list<string>::iterator it = queued_data_.begin();
+       it != queued_data_.end(); ++it) {
+    struct iovec buffer = {const_cast<char*>(it->data()) + offset,
+                           it->size() - offset};
+    iov.push_back(buffer);
+    offset = 0;
+  }
+  QuicConsumedData consumed_data =
+      WritevDataInternal(&iov[0], iov.size(), fin_buffered_);
+
+  size_t bytes_consumed = consumed_data.bytes_consumed;
   while (!queued_data_.empty()) {
-    const string& data = queued_data_.front();
-    if (queued_data_.size() == 1 && fin_buffered_) {
-      fin = true;
-    }
-    QuicConsumedData consumed_data = WriteDataInternal(data, fin);
-    if (consumed_data.bytes_consumed == data.size() &&
-        fin == consumed_data.fin_consumed) {
-      queued_data_.pop_front();
-    } else {
-      queued_data_.front().erase(0, consumed_data.bytes_consumed);
+    const size_t remaining = queued_data_.front().size() - queued_data_offset_;
+    // The last buffer is kept, even when empty, until the fin is consumed.
+    if (bytes_consumed < remaining ||
+        (queued_data_.size() == 1 && fin_buffered_ &&
+         !consumed_data.fin_consumed)) {
+      queued_data_offset_ += bytes_consumed;
       break;
     }
+    bytes_consumed -= remaining;
+    queued_data_.pop_front();
+    queued_data_offset_ = 0;
   }
 }
 
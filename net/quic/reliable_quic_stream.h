@@ -184,6 +184,9 @@ class NET_EXPORT_PRIVATE ReliableQuicStream : public
   uint32 StripPriorityAndHeaderId(const char* data, uint32 data_len);
 
   std::list<string> queued_data_;
+  // The number of bytes at the start of queued_data_.front() that have
+  // already been sent.
+  size_t queued_data_offset_;
 
   QuicStreamSequencer sequencer_;
   QuicStreamId id_;
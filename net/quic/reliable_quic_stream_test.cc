@@ -202,11 +202,10 @@ TEST_F(ReliableQuicStreamTest, WriteData) {
   EXPECT_EQ(kDataLen, stream_->WriteData(kData2, false).bytes_consumed);
 
   // Make sure we get the tail of the first write followed by the bytes_consumed
+  // in a single write.
   InSequence s;
-  EXPECT_CALL(*session_, WritevData(_, _, 1, _, _)).
-      WillOnce(Return(QuicConsumedData(1, false)));
-  EXPECT_CALL(*session_, WritevData(_, _, 1, _, _)).
-      WillOnce(Return(QuicConsumedData(kDataLen - 2, false)));
+  EXPECT_CALL(*session_, WritevData(_, _, 2, _, _)).
+      WillOnce(Return(QuicConsumedData(kDataLen - 1, false)));
   stream_->OnCanWrite();
 
   // And finally the end of the bytes_consumed.
@@ -0,0 +1,176 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/test_tools/send_algorithm_simulator.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+using std::make_pair;
+using std::max;
+using std::min;
+
+namespace net {
+namespace test {
+
+namespace {
+
+const QuicByteCount kPacketSize = kDefaultMaxPacketSize;
+
+QuicTime::Delta TransferTime(QuicBandwidth bandwidth, QuicByteCount bytes) {
+  return QuicTime::Delta::FromMicroseconds(
+      bytes * 8 * kNumMicrosPerSecond / bandwidth.ToBitsPerSecond());
+}
+
+}  // namespace
+
+SendAlgorithmSimulator::Results::Results()
+    : bytes_acked(0),
+      throughput(QuicBandwidth::Zero()),
+      mean_queueing_delay(QuicTime::Delta::Zero()),
+      max_queueing_delay(QuicTime::Delta::Zero()),
+      packets_lost(0) {
+}
+
+SendAlgorithmSimulator::SendAlgorithmSimulator(MockClock* clock,
+                                               QuicBandwidth bandwidth,
+                                               QuicTime::Delta rtt,
+                                               QuicByteCount buffer_size)
+    : clock_(clock),
+      bandwidth_(bandwidth),
+      rtt_(rtt),
+      buffer_size_(buffer_size),
+      next_sequence_number_(1),
+      link_free_time_(QuicTime::Zero()),
+      bytes_acked_(0),
+      packets_acked_(0),
+      total_queueing_delay_(QuicTime::Delta::Zero()),
+      max_queueing_delay_(QuicTime::Delta::Zero()),
+      packets_lost_(0) {
+  DCHECK_GE(buffer_size_, kPacketSize);
+}
+
+SendAlgorithmSimulator::~SendAlgorithmSimulator() {}
+
+SendAlgorithmSimulator::Results SendAlgorithmSimulator::Transfer(
+    SendAlgorithmInterface* send_algorithm,
+    QuicTime::Delta duration) {
+  bytes_acked_ = 0;
+  packets_acked_ = 0;
+  total_queueing_delay_ = QuicTime::Delta::Zero();
+  max_queueing_delay_ = QuicTime::Delta::Zero();
+  packets_lost_ = 0;
+
+  const QuicTime end_time = clock_->Now().Add(duration);
+  while (true) {
+    const QuicTime now = clock_->Now();
+    while (!packets_in_flight_.empty() &&
+           packets_in_flight_.front().ack_time <= now) {
+      const PacketInFlight packet = packets_in_flight_.front();
+      packets_in_flight_.pop_front();
+      ReportLosses(send_algorithm, packet.sequence_number);
+      send_algorithm->OnIncomingAck(packet.sequence_number, kPacketSize,
+                                    packet.ack_time.Subtract(packet.sent_time));
+
+      QuicTime::Delta queueing_delay =
+          packet.leave_queue_time.Subtract(packet.sent_time);
+      bytes_acked_ += kPacketSize;
+      ++packets_acked_;
+      total_queueing_delay_ = total_queueing_delay_.Add(queueing_delay);
+      max_queueing_delay_ = max(max_queueing_delay_, queueing_delay);
+    }
+    ReportLosses(send_algorithm, 0);
+    if (now >= end_time) {
+      break;
+    }
+
+    QuicTime::Delta delay = send_algorithm->TimeUntilSend(
+        now, NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA, NOT_HANDSHAKE);
+    if (delay.IsZero()) {
+      SendPacket(send_algorithm);
+      continue;
+    }
+
+    QuicTime next_event_time = end_time;
+    if (!delay.IsInfinite()) {
+      next_event_time = min(next_event_time, now.Add(delay));
+    }
+    if (!packets_in_flight_.empty()) {
+      next_event_time =
+          min(next_event_time, packets_in_flight_.front().ack_time);
+    }
+    if (!lost_packets_.empty()) {
+      next_event_time = min(next_event_time, lost_packets_.front().second);
+    }
+    clock_->AdvanceTime(next_event_time.Subtract(now));
+  }
+
+  Results results;
+  results.bytes_acked = bytes_acked_;
+  results.throughput = QuicBandwidth::FromBytesAndTimeDelta(bytes_acked_,
+                                                            duration);
+  if (packets_acked_ > 0) {
+    results.mean_queueing_delay = QuicTime::Delta::FromMicroseconds(
+        total_queueing_delay_.ToMicroseconds() / packets_acked_);
+  }
+  results.max_queueing_delay = max_queueing_delay_;
+  results.packets_lost = packets_lost_;
+  return results;
+}
+
+void SendAlgorithmSimulator::SendPacket(
+    SendAlgorithmInterface* send_algorithm) {
+  const QuicTime now = clock_->Now();
+  QuicPacketSequenceNumber sequence_number = next_sequence_number_++;
+  send_algorithm->OnPacketSent(now, sequence_number, kPacketSize,
+                               NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+
+  if (BytesInQueue() + kPacketSize > buffer_size_) {
+    // Reported lost once the packets ahead of it in the queue are acked.
+    lost_packets_.push_back(
+        make_pair(sequence_number, link_free_time_.Add(rtt_)));
+    return;
+  }
+  QuicTime leave_queue_time = max(now, link_free_time_);
+  link_free_time_ =
+      leave_queue_time.Add(TransferTime(bandwidth_, kPacketSize));
+  packets_in_flight_.push_back(PacketInFlight(
+      sequence_number, now, leave_queue_time, link_free_time_.Add(rtt_)));
+}
+
+void SendAlgorithmSimulator::ReportLosses(
+    SendAlgorithmInterface* send_algorithm,
+    QuicPacketSequenceNumber acked_sequence_number) {
+  const QuicTime now = clock_->Now();
+  bool loss_reported = false;
+  while (!lost_packets_.empty() &&
+         (lost_packets_.front().first < acked_sequence_number ||
+          lost_packets_.front().second <= now)) {
+    if (!loss_reported) {
+      send_algorithm->OnIncomingLoss(now);
+      loss_reported = true;
+    }
+    send_algorithm->OnPacketAbandoned(lost_packets_.front().first,
+                                      kPacketSize);
+    lost_packets_.pop_front();
+    ++packets_lost_;
+  }
+}
+
+QuicByteCount SendAlgorithmSimulator::BytesInQueue() const {
+  const QuicTime now = clock_->Now();
+  QuicByteCount bytes = 0;
+  // A packet has left the link one RTT before it is acked.
+  for (std::deque<PacketInFlight>::const_reverse_iterator it =
+           packets_in_flight_.rbegin();
+       it != packets_in_flight_.rend() && it->ack_time.Subtract(rtt_) > now;
+       ++it) {
+    bytes += kPacketSize;
+  }
+  return bytes;
+}
+
+}  // namespace test
+}  // namespace net
@@ -0,0 +1,112 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A deterministic simulation of a single flow over a bottleneck link, used to
+// compare the throughput and the queueing delay of send algorithms.
+
+#ifndef NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
+#define NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
+
+#include <deque>
+#include <utility>
+
+#include "base/basictypes.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+#include "net/quic/test_tools/mock_clock.h"
+
+namespace net {
+namespace test {
+
+// The sender always has data to send and sends full sized packets as soon as
+// the send algorithm allows. The packets go through a drop tail queue in
+// front of a link of fixed bandwidth, and each packet is acked one
+// propagation RTT after it left the link. Losses are reported when a later
+// packet is acked, or after one RTT when nothing is left to ack, and the lost
+// packets are then abandoned, the way QuicConnection would do it before
+// retransmitting them.
+class SendAlgorithmSimulator {
+ public:
+  struct Results {
+    Results();
+
+    QuicByteCount bytes_acked;
+    QuicBandwidth throughput;
+    // Time spent by the acked packets waiting in the bottleneck queue.
+    QuicTime::Delta mean_queueing_delay;
+    QuicTime::Delta max_queueing_delay;
+    size_t packets_lost;
+  };
+
+  // |buffer_size| is the number of bytes the bottleneck can hold, including
+  // the packet being sent on the link.
+  SendAlgorithmSimulator(MockClock* clock,
+                         QuicBandwidth bandwidth,
+                         QuicTime::Delta rtt,
+                         QuicByteCount buffer_size);
+  ~SendAlgorithmSimulator();
+
+  // Sends with |send_algorithm| for |duration| and returns what the flow
+  // achieved. Packets still in flight at the end do not count.
+  Results Transfer(SendAlgorithmInterface* send_algorithm,
+                   QuicTime::Delta duration);
+
+ private:
+  struct PacketInFlight {
+    PacketInFlight(QuicPacketSequenceNumber sequence_number,
+                   QuicTime sent_time,
+                   QuicTime leave_queue_time,
+                   QuicTime ack_time)
+        : sequence_number(sequence_number),
+          sent_time(sent_time),
+          leave_queue_time(leave_queue_time),
+          ack_time(ack_time) {}
+    QuicPacketSequenceNumber sequence_number;
+    QuicTime sent_time;
+    // When the link starts sending the packet.
+    QuicTime leave_queue_time;
+    QuicTime ack_time;
+  };
+
+  // Sends a packet at the current time, or drops it when the bottleneck
+  // queue is full.
+  void SendPacket(SendAlgorithmInterface* send_algorithm);
+
+  // Reports the packets lost before |acked_sequence_number|, or for long
+  // enough, as lost and abandons them.
+  void ReportLosses(SendAlgorithmInterface* send_algorithm,
+                    QuicPacketSequenceNumber acked_sequence_number);
+
+  // Bytes queued at the bottleneck, including the packet on the link.
+  QuicByteCount BytesInQueue() const;
+
+  MockClock* clock_;
+  const QuicBandwidth bandwidth_;
+  const QuicTime::Delta rtt_;
+  const QuicByteCount buffer_size_;
+
+  QuicPacketSequenceNumber next_sequence_number_;
+  // When the link is done with the last packet queued.
+  QuicTime link_free_time_;
+  // Packets which made it through the queue, in the order they are acked.
+  std::deque<PacketInFlight> packets_in_flight_;
+  // Packets dropped by the queue, with the time they are reported lost at
+  // if no later packet is acked before.
+  std::deque<std::pair<QuicPacketSequenceNumber, QuicTime> > lost_packets_;
+
+  QuicByteCount bytes_acked_;
+  int64 packets_acked_;
+  QuicTime::Delta total_queueing_delay_;
+  QuicTime::Delta max_queueing_delay_;
+  size_t packets_lost_;
+
+  DISALLOW_COPY_AND_ASSIGN(SendAlgorithmSimulator);
+};
+
+}  // namespace test
+}  // namespace net
+
+#endif  // NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
@@ -4,6 +4,7 @@
 
 #include "net/server/http_connection.h"
 
+#include "base/atomic_sequence_num.h"
 #include "net/server/http_server.h"
 #include "net/server/http_server_response_info.h"
 #include "net/server/web_socket.h"
@@ -11,7 +12,13 @@
 
 namespace net {
 
-int HttpConnection::last_id_ = 0;
+namespace {
+
+// Connection ids are unique across all HttpServers, which may run on
+// different threads.
+base::StaticAtomicSequenceNumber g_last_id;
+
+}  // namespace
 
 void HttpConnection::Send(const std::string& data) {
   if (!socket_.get())
@@ -32,8 +39,11 @@ void HttpConnection::Send(const HttpServerResponseInfo& response) {
 HttpConnection::HttpConnection(HttpServer* server,
                                scoped_ptr<StreamListenSocket> sock)
     : server_(server),
-      socket_(sock.Pass()) {
-  id_ = last_id_++;
+      socket_(sock.Pass()),
+      id_(g_last_id.GetNext()),
+      pending_responses_(0),
+      close_after_responses_(false) {
+  ResetParser();
 }
 
 HttpConnection::~HttpConnection() {
@@ -41,7 +51,17 @@ HttpConnection::~HttpConnection() {
 }
 
 void HttpConnection::Shift(int num_bytes) {
-  recv_data_ = recv_data_.substr(num_bytes);
+  recv_data_.erase(0, num_bytes);
+}
+
+void HttpConnection::ResetParser() {
+  parse_state_ = 0;
+  parse_pos_ = 0;
+  parse_complete_ = false;
+  parse_http_1_0_ = false;
+  parse_buffer_.clear();
+  parse_header_name_.clear();
+  request_ = HttpServerRequestInfo();
 }
 
 }  // namespace net
@@ -10,6 +10,7 @@
 #include "base/basictypes.h"
 #include "base/memory/scoped_ptr.h"
 #include "net/http/http_status_code.h"
+#include "net/server/http_server_request_info.h"
 
 namespace net {
 
@@ -33,15 +34,34 @@ class HttpConnection {
 
  private:
   friend class HttpServer;
-  static int last_id_;
 
   HttpConnection(HttpServer* server, scoped_ptr<StreamListenSocket> sock);
 
+  // Readies the parser for the next request, at the start of |recv_data_|.
+  void ResetParser();
+
   HttpServer* server_;
   scoped_ptr<StreamListenSocket> socket_;
   scoped_ptr<WebSocket> web_socket_;
   std::string recv_data_;
   int id_;
+
+  // State of HttpServer::ParseHeaders() for the request at the start of
+  // |recv_data_|, so that each byte is only parsed once however the request
+  // is split across reads.  |parse_state_| is 0 before the request starts.
+  int parse_state_;
+  size_t parse_pos_;
+  bool parse_complete_;
+  bool parse_http_1_0_;
+  std::string parse_buffer_;
+  std::string parse_header_name_;
+  HttpServerRequestInfo request_;
+
+  // The number of requests passed to the delegate that are not yet answered,
+  // and whether to close the connection once they are.
+  int pending_responses_;
+  bool close_after_responses_;
+
   DISALLOW_COPY_AND_ASSIGN(HttpConnection);
 };
 
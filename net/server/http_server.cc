@@ -4,8 +4,10 @@
 
 #include "net/server/http_server.h"
 
+#include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/logging.h"
+#include "base/message_loop/message_loop.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -53,6 +55,15 @@ void HttpServer::SendResponse(int connection_id,
   if (connection == NULL)
     return;
   connection->Send(response);
+
+  if (connection->pending_responses_ > 0)
+    --connection->pending_responses_;
+  if (connection->close_after_responses_ &&
+      connection->pending_responses_ == 0) {
+    // The delegate may still be using the connection, so close it later.
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(&HttpServer::Close, this, connection_id));
+  }
 }
 
 void HttpServer::Send(int connection_id,
@@ -110,6 +121,9 @@ void HttpServer::DidRead(StreamListenSocket* socket,
   if (connection == NULL)
     return;
 
+  // The delegate may close the connection, so it is looked up again after
+  // each call.
+  const int connection_id = connection->id();
   connection->recv_data_.append(data, len);
   while (connection->recv_data_.length()) {
     if (connection->web_socket_.get()) {
@@ -124,14 +138,21 @@ void HttpServer::DidRead(StreamListenSocket* socket,
         break;
       }
       delegate_->OnWebSocketMessage(connection->id(), message);
+      connection = FindConnection(connection_id);
+      if (connection == NULL)
+        return;
       continue;
     }
 
-    HttpServerRequestInfo request;
+    // Clients must not send more requests after asking to close.
+    if (connection->close_after_responses_)
+      break;
+
     size_t pos = 0;
-    if (!ParseHeaders(connection, &request, &pos))
+    if (!ParseHeaders(connection, &pos))
       break;
 
+    HttpServerRequestInfo& request = connection->request_;
     std::string connection_header = request.GetHeaderValue("connection");
     if (connection_header == "Upgrade") {
       connection->web_socket_.reset(WebSocket::CreateWebSocket(connection,
@@ -140,7 +161,12 @@ void HttpServer::DidRead(StreamListenSocket* socket,
 
       if (!connection->web_socket_.get())  // Not enough data was received.
         break;
-      delegate_->OnWebSocketRequest(connection->id(), request);
+      HttpServerRequestInfo upgrade_request = request;
+      connection->ResetParser();
+      delegate_->OnWebSocketRequest(connection->id(), upgrade_request);
+      connection = FindConnection(connection_id);
+      if (connection == NULL)
+        return;
       connection->Shift(pos);
       continue;
     }
@@ -165,8 +191,26 @@ void HttpServer::DidRead(StreamListenSocket* socket,
       pos += content_length;
     }
 
-    delegate_->OnHttpRequest(connection->id(), request);
+    if (LowerCaseEqualsASCII(connection_header, "close") ||
+        (connection->parse_http_1_0_ &&
+         !LowerCaseEqualsASCII(connection_header, "keep-alive"))) {
+      connection->close_after_responses_ = true;
+    }
+    ++connection->pending_responses_;
+
+    // Take the request out of the connection without copying it.
+    HttpServerRequestInfo info;
+    info.method.swap(request.method);
+    info.path.swap(request.path);
+    info.data.swap(request.data);
+    info.headers.swap(request.headers);
+    connection->ResetParser();
     connection->Shift(pos);
+
+    delegate_->OnHttpRequest(connection_id, info);
+    connection = FindConnection(connection_id);
+    if (connection == NULL)
+      return;
   }
 }
 
@@ -192,6 +236,9 @@ HttpServer::~HttpServer() {
 // Known issues:
 //   - does not handle whitespace on first HTTP line correctly.  Expects
 //     a single space between the method/url and url/protocol.
+//
+// The state of a partially parsed request is kept in its HttpConnection, so
+// ParseHeaders() can resume where it stopped when more data arrives.
 
 // Input character types.
 enum header_parse_inputs {
@@ -203,7 +250,7 @@ enum header_parse_inputs {
   MAX_INPUTS,
 };
 
-// Parser states.
+// Parser states.  HttpConnection::ResetParser() relies on ST_METHOD being 0.
 enum header_parse_states {
   ST_METHOD,     // Receiving the method
   ST_URL,        // Receiving the URL
@@ -245,14 +292,19 @@ int charToInput(char ch) {
   return INPUT_DEFAULT;
 }
 
-bool HttpServer::ParseHeaders(HttpConnection* connection,
-                              HttpServerRequestInfo* info,
-                              size_t* ppos) {
-  size_t& pos = *ppos;
+bool HttpServer::ParseHeaders(HttpConnection* connection, size_t* ppos) {
+  size_t& pos = connection->parse_pos_;
+  if (connection->parse_complete_) {
+    // Still waiting for the body.
+    *ppos = pos;
+    return true;
+  }
+
+  HttpServerRequestInfo* info = &connection->request_;
+  std::string& buffer = connection->parse_buffer_;
+  std::string& header_name = connection->parse_header_name_;
   size_t data_len = connection->recv_data_.length();
-  int state = ST_METHOD;
-  std::string buffer;
-  std::string header_name;
+  int state = connection->parse_state_;
   std::string header_value;
   while (pos < data_len) {
     char ch = connection->recv_data_[pos++];
@@ -273,7 +325,8 @@ bool HttpServer::ParseHeaders(HttpConnection* connection,
           break;
         case ST_PROTO:
           // TODO(mbelshe): Deal better with parsing protocol.
-          DCHECK(buffer == "HTTP/1.1");
+          DCHECK(buffer == "HTTP/1.1" || buffer == "HTTP/1.0");
+          connection->parse_http_1_0_ = (buffer == "HTTP/1.0");
           buffer.clear();
           break;
         case ST_NAME:
@@ -303,13 +356,18 @@ bool HttpServer::ParseHeaders(HttpConnection* connection,
           break;
         case ST_DONE:
           DCHECK(input == INPUT_LF);
+          connection->parse_state_ = state;
+          connection->parse_complete_ = true;
+          *ppos = pos;
           return true;
         case ST_ERR:
+          connection->parse_state_ = state;
           return false;
       }
     }
   }
   // No more characters, but we haven't finished parsing yet.
+  connection->parse_state_ = state;
   return false;
 }
 
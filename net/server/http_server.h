@@ -21,6 +21,12 @@ class HttpServerResponseInfo;
 class IPEndPoint;
 class WebSocket;
 
+// HttpServer serves HTTP/1.1 and WebSocket connections on the thread it is
+// created on, which must have an IO message loop.  Connections are kept alive
+// unless the client asks otherwise, and pipelined requests are passed to the
+// delegate in order; the delegate must answer them in the same order.
+// Connection ids are unique across all HttpServers, so several of them can
+// serve different ports on different threads.
 class HttpServer : public StreamListenSocket::Delegate,
                    public base::RefCountedThreadSafe<HttpServer> {
  public:
@@ -78,12 +84,11 @@ class HttpServer : public StreamListenSocket::Delegate,
   friend class base::RefCountedThreadSafe<HttpServer>;
   friend class HttpConnection;
 
-  // Expects the raw data to be stored in recv_data_. If parsing is successful,
-  // will remove the data parsed from recv_data_, leaving only the unused
-  // recv data.
-  bool ParseHeaders(HttpConnection* connection,
-                    HttpServerRequestInfo* info,
-                    size_t* pos);
+  // Parses the headers of the request at the start of the connection's
+  // recv_data_ into its request_, resuming where the previous call stopped.
+  // Returns true once they are complete, with |*pos| set to the offset just
+  // past them.
+  bool ParseHeaders(HttpConnection* connection, size_t* pos);
 
   HttpConnection* FindConnection(int connection_id);
   HttpConnection* FindConnection(StreamListenSocket* socket);
@@ -0,0 +1,259 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/server/http_server.h"
+#include "net/server/http_server_request_info.h"
+#include "net/server/http_server_response_info.h"
+#include "net/socket/tcp_client_socket.h"
+#include "net/socket/tcp_listen_socket.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(OS_POSIX)
+#include <sys/resource.h>
+#endif
+
+namespace net {
+
+namespace {
+
+const int kMaxConnections = 10000;
+const int kRequestsPerConnection = 10;
+const char kRequest[] = "GET /test HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+const char kResponseBody[] = "Hello world";
+const char kResponseContentType[] = "text/plain";
+
+// Returns how many connections this process can open to itself, up to
+// kMaxConnections.  Each one takes a descriptor on both ends.
+int GetMaxConnections() {
+#if defined(OS_POSIX)
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+    return 0;
+  if (limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+  }
+  // Leave some descriptors for everything else.
+  int available = static_cast<int>(
+      std::min<rlim_t>(limit.rlim_cur, 2 * kMaxConnections + 100)) - 100;
+  return std::max(available / 2, 0);
+#else
+  return kMaxConnections;
+#endif
+}
+
+// A client that sends kRequestsPerConnection requests over one connection,
+// either waiting for each response before sending the next request, or all
+// at once, and counts the bytes of the responses.
+class LoadTestClient {
+ public:
+  LoadTestClient(size_t response_size, bool pipeline)
+      : response_size_(response_size),
+        pipeline_(pipeline),
+        read_buffer_(new IOBuffer(kReadBufferSize)),
+        bytes_received_(0) {}
+
+  int Connect(const IPEndPoint& address, const CompletionCallback& callback) {
+    socket_.reset(new TCPClientSocket(AddressList(address), NULL,
+                                      NetLog::Source()));
+    return socket_->Connect(callback);
+  }
+
+  // Sends the requests, then runs |done_callback| once all the responses are
+  // received.
+  void Start(const base::Closure& done_callback) {
+    done_callback_ = done_callback;
+    SendRequests(pipeline_ ? kRequestsPerConnection : 1);
+    Read();
+  }
+
+ private:
+  static const int kReadBufferSize = 4096;
+
+  void SendRequests(int count) {
+    std::string data;
+    for (int i = 0; i < count; ++i)
+      data += kRequest;
+    write_buffer_ =
+        new DrainableIOBuffer(new StringIOBuffer(data), data.length());
+    Write();
+  }
+
+  void Write() {
+    int result = socket_->Write(
+        write_buffer_.get(),
+        write_buffer_->BytesRemaining(),
+        base::Bind(&LoadTestClient::OnWrite, base::Unretained(this)));
+    if (result != ERR_IO_PENDING)
+      OnWrite(result);
+  }
+
+  void OnWrite(int result) {
+    ASSERT_GT(result, 0);
+    write_buffer_->DidConsume(result);
+    if (write_buffer_->BytesRemaining())
+      Write();
+  }
+
+  void Read() {
+    int result = socket_->Read(
+        read_buffer_.get(),
+        kReadBufferSize,
+        base::Bind(&LoadTestClient::OnRead, base::Unretained(this)));
+    if (result != ERR_IO_PENDING)
+      OnRead(result);
+  }
+
+  void OnRead(int result) {
+    ASSERT_GT(result, 0);
+    size_t responses_before = bytes_received_ / response_size_;
+    bytes_received_ += result;
+    size_t responses = bytes_received_ / response_size_;
+    if (responses == static_cast<size_t>(kRequestsPerConnection)) {
+      done_callback_.Run();
+      return;
+    }
+    if (!pipeline_ && responses > responses_before)
+      SendRequests(1);
+    Read();
+  }
+
+  const size_t response_size_;
+  const bool pipeline_;
+  scoped_ptr<TCPClientSocket> socket_;
+  scoped_refptr<DrainableIOBuffer> write_buffer_;
+  scoped_refptr<IOBuffer> read_buffer_;
+  size_t bytes_received_;
+  base::Closure done_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadTestClient);
+};
+
+class HttpServerPerfTest : public testing::Test,
+                           public HttpServer::Delegate {
+ public:
+  HttpServerPerfTest() : connect_result_(OK), clients_done_(0) {}
+
+  virtual void SetUp() OVERRIDE {
+    TCPListenSocketFactory socket_factory("127.0.0.1", 0);
+    server_ = new HttpServer(socket_factory, this);
+    ASSERT_EQ(OK, server_->GetLocalAddress(&server_address_));
+  }
+
+  virtual void OnHttpRequest(int connection_id,
+                             const HttpServerRequestInfo& info) OVERRIDE {
+    server_->Send200(connection_id, kResponseBody, kResponseContentType);
+  }
+
+  virtual void OnWebSocketRequest(int connection_id,
+                                  const HttpServerRequestInfo& info) OVERRIDE {
+    NOTREACHED();
+  }
+
+  virtual void OnWebSocketMessage(int connection_id,
+                                  const std::string& data) OVERRIDE {
+    NOTREACHED();
+  }
+
+  virtual void OnClose(int connection_id) OVERRIDE {}
+
+ protected:
+  // Opens as many connections as allowed, up to kMaxConnections, then times
+  // kRequestsPerConnection requests on each of them at once.
+  void RunLoadTest(bool pipeline, const char* name) {
+    int num_connections = GetMaxConnections();
+    ASSERT_GT(num_connections, 0);
+    base::LogPerfResult(
+        base::StringPrintf("%s_connections", name).c_str(),
+        num_connections, "connections");
+
+    HttpServerResponseInfo response(HTTP_OK);
+    response.SetBody(kResponseBody, kResponseContentType);
+    size_t response_size = response.Serialize().size();
+
+    // Connect one at a time, to stay within the listen backlog.
+    ScopedVector<LoadTestClient> clients;
+    for (int i = 0; i < num_connections; ++i) {
+      LoadTestClient* client = new LoadTestClient(response_size, pipeline);
+      clients.push_back(client);
+      base::RunLoop run_loop;
+      int rv = client->Connect(
+          server_address_,
+          base::Bind(&HttpServerPerfTest::OnConnect, base::Unretained(this),
+                     run_loop.QuitClosure()));
+      if (rv == ERR_IO_PENDING) {
+        run_loop.Run();
+        rv = connect_result_;
+      }
+      ASSERT_EQ(OK, rv);
+    }
+    // Let the server accept the last connections.
+    base::RunLoop().RunUntilIdle();
+
+    base::RunLoop run_loop;
+    base::Closure done_callback =
+        base::Bind(&HttpServerPerfTest::OnClientDone, base::Unretained(this),
+                   num_connections, run_loop.QuitClosure());
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (size_t i = 0; i < clients.size(); ++i)
+      clients[i]->Start(done_callback);
+    run_loop.Run();
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    base::LogPerfResult(
+        base::StringPrintf("%s_requests_per_second", name).c_str(),
+        num_connections * kRequestsPerConnection / elapsed.InSecondsF(),
+        "requests/s");
+  }
+
+ private:
+  void OnConnect(const base::Closure& quit_loop, int result) {
+    connect_result_ = result;
+    quit_loop.Run();
+  }
+
+  void OnClientDone(int num_clients, const base::Closure& quit_loop) {
+    if (++clients_done_ == num_clients)
+      quit_loop.Run();
+  }
+
+  base::MessageLoopForIO message_loop_;
+  scoped_refptr<HttpServer> server_;
+  IPEndPoint server_address_;
+  int connect_result_;
+  int clients_done_;
+};
+
+}  // namespace
+
+TEST_F(HttpServerPerfTest, KeepAlive) {
+  RunLoadTest(false, "HttpServer_KeepAlive");
+}
+
+TEST_F(HttpServerPerfTest, Pipelined) {
+  RunLoadTest(true, "HttpServer_Pipelined");
+}
+
+}  // namespace net
@@ -129,6 +129,7 @@ class HttpServerTest : public testing::Test,
   virtual void OnHttpRequest(int connection_id,
                              const HttpServerRequestInfo& info) OVERRIDE {
     requests_.push_back(info);
+    connection_ids_.push_back(connection_id);
     if (requests_.size() == quit_after_request_count_)
       run_loop_quit_func_.Run();
   }
@@ -143,7 +144,9 @@ class HttpServerTest : public testing::Test,
     NOTREACHED();
   }
 
-  virtual void OnClose(int connection_id) OVERRIDE {}
+  virtual void OnClose(int connection_id) OVERRIDE {
+    closed_connection_ids_.push_back(connection_id);
+  }
 
   bool RunUntilRequestsReceived(size_t count) {
     quit_after_request_count_ = count;
@@ -162,6 +165,8 @@ class HttpServerTest : public testing::Test,
   IPEndPoint server_address_;
   base::Closure run_loop_quit_func_;
   std::vector<HttpServerRequestInfo> requests_;
+  std::vector<int> connection_ids_;
+  std::vector<int> closed_connection_ids_;
 
  private:
   size_t quit_after_request_count_;
@@ -293,6 +298,82 @@ TEST_F(HttpServerTest, RequestWithBodySplitAcrossPackets) {
   ASSERT_EQ(body, requests_[0].data);
 }
 
+TEST_F(HttpServerTest, RequestSplitIntoSingleBytes) {
+  StreamListenSocket* socket =
+      new MockStreamListenSocket(server_.get());
+  server_->DidAccept(NULL, make_scoped_ptr(socket));
+  std::string request(
+      "GET /test HTTP/1.1\r\n"
+      "SomeHeader: 1\r\n"
+      "Content-Length: 4\r\n\r\nbody");
+  for (size_t i = 0; i < request.length(); ++i) {
+    ASSERT_EQ(0u, requests_.size());
+    server_->DidRead(socket, request.c_str() + i, 1);
+  }
+  ASSERT_EQ(1u, requests_.size());
+  ASSERT_EQ("GET", requests_[0].method);
+  ASSERT_EQ("/test", requests_[0].path);
+  ASSERT_EQ("1", requests_[0].GetHeaderValue("someheader"));
+  ASSERT_EQ("body", requests_[0].data);
+}
+
+TEST_F(HttpServerTest, PipelinedRequests) {
+  StreamListenSocket* socket =
+      new MockStreamListenSocket(server_.get());
+  server_->DidAccept(NULL, make_scoped_ptr(socket));
+  std::string requests(
+      "GET /test1 HTTP/1.1\r\n\r\n"
+      "POST /test2 HTTP/1.1\r\nContent-Length: 4\r\n\r\nbody"
+      "GET /test3 HTTP/1.1\r\n\r\n"
+      "GET /test4 HTTP/1.1\r\n");
+  server_->DidRead(socket, requests.c_str(), requests.length());
+  ASSERT_EQ(3u, requests_.size());
+  ASSERT_EQ("/test1", requests_[0].path);
+  ASSERT_EQ("/test2", requests_[1].path);
+  ASSERT_EQ("body", requests_[1].data);
+  ASSERT_EQ("/test3", requests_[2].path);
+  ASSERT_EQ("", requests_[2].data);
+
+  server_->DidRead(socket, "\r\n", 2);
+  ASSERT_EQ(4u, requests_.size());
+  ASSERT_EQ("/test4", requests_[3].path);
+  ASSERT_EQ(0u, requests_[3].headers.size());
+}
+
+TEST_F(HttpServerTest, ConnectionClose) {
+  TestHttpClient client;
+  ASSERT_EQ(OK, client.ConnectAndWait(server_address_));
+  client.Send("GET /test HTTP/1.1\r\nConnection: close\r\n\r\n"
+              "GET /ignored HTTP/1.1\r\n\r\n");
+  ASSERT_TRUE(RunUntilRequestsReceived(1));
+  ASSERT_EQ("/test", requests_[0].path);
+
+  server_->Send200(connection_ids_[0], "ok", "text/plain");
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(1u, closed_connection_ids_.size());
+  ASSERT_EQ(connection_ids_[0], closed_connection_ids_[0]);
+  ASSERT_EQ(1u, requests_.size());
+}
+
+TEST_F(HttpServerTest, Http10KeepAlive) {
+  TestHttpClient client;
+  ASSERT_EQ(OK, client.ConnectAndWait(server_address_));
+  client.Send("GET /test1 HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n");
+  ASSERT_TRUE(RunUntilRequestsReceived(1));
+  server_->Send200(connection_ids_[0], "ok", "text/plain");
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(0u, closed_connection_ids_.size());
+
+  // Without "Connection: Keep-Alive", HTTP/1.0 connections are closed after
+  // the response.
+  client.Send("GET /test2 HTTP/1.0\r\n\r\n");
+  ASSERT_TRUE(RunUntilRequestsReceived(2));
+  ASSERT_EQ(connection_ids_[0], connection_ids_[1]);
+  server_->Send200(connection_ids_[1], "ok", "text/plain");
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(1u, closed_connection_ids_.size());
+}
+
 TEST_F(HttpServerTest, MultipleRequestsOnSameConnection) {
   // The idea behind this test is that requests with or without bodies should
   // not break parsing of the next request.
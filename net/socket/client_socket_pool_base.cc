@@ -4,6 +4,8 @@
 
 #include "net/socket/client_socket_pool_base.h"
 
+#include <algorithm>
+
 #include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
@@ -298,6 +300,37 @@ void ClientSocketPoolBaseHelper::RequestSockets(
   if (!use_cleanup_timer_)
     CleanupIdleSockets(false);
 
+  PreconnectSockets(group_name, request, num_sockets);
+}
+
+void ClientSocketPoolBaseHelper::SetWarmSockets(
+    const std::string& group_name,
+    scoped_ptr<const Request> request,
+    int num_sockets,
+    base::TimeTicks warm_until) {
+  DCHECK(request->callback().is_null());
+  DCHECK(!request->handle());
+
+  // Cleanup any timed out idle sockets if no timer is used.
+  if (!use_cleanup_timer_)
+    CleanupIdleSockets(false);
+
+  if (num_sockets <= 0) {
+    GroupMap::iterator it = group_map_.find(group_name);
+    if (it != group_map_.end())
+      it->second->ClearWarmRequest();
+    return;
+  }
+
+  Group* group = GetOrCreateGroup(group_name);
+  group->SetWarmRequest(request.Pass(), num_sockets, warm_until);
+  TopUpWarmSockets(group_name, group, base::TimeTicks::Now());
+}
+
+void ClientSocketPoolBaseHelper::PreconnectSockets(
+    const std::string& group_name,
+    const Request& request,
+    int num_sockets) {
   if (num_sockets > max_sockets_per_group_) {
     num_sockets = max_sockets_per_group_;
   }
@@ -340,6 +373,42 @@ void ClientSocketPoolBaseHelper::RequestSockets(
       NetLog::TYPE_SOCKET_POOL_CONNECTING_N_SOCKETS, rv);
 }
 
+void ClientSocketPoolBaseHelper::TopUpWarmSockets(
+    const std::string& group_name,
+    Group* group,
+    base::TimeTicks now) {
+  DCHECK(group->warm_request());
+  if (now >= group->warm_until()) {
+    group->ClearWarmRequest();
+    if (group->IsEmpty())
+      RemoveGroup(group_name);
+    return;
+  }
+
+  // Unused sockets are opened ahead of the requests which will use them, so
+  // replace them before they get close to the unused idle socket timeout,
+  // which is also about when servers tend to close them.
+  int num_aging_sockets = 0;
+  for (std::list<IdleSocket>::const_iterator it =
+           group->idle_sockets().begin();
+       it != group->idle_sockets().end(); ++it) {
+    if (!it->socket->WasEverUsed() &&
+        now - it->start_time >= unused_idle_socket_timeout_ / 2) {
+      ++num_aging_sockets;
+    }
+  }
+
+  // Warm sockets are only a guess, so they don't take the place of the idle
+  // sockets of other groups when the pool is full.
+  int num_sockets = group->num_warm_sockets() + num_aging_sockets;
+  int num_free_slots = max_sockets_ - handed_out_socket_count_ -
+      connecting_socket_count_ - idle_socket_count();
+  num_sockets = std::min(num_sockets,
+                         group->NumActiveSocketSlots() + num_free_slots);
+
+  PreconnectSockets(group_name, *group->warm_request(), num_sockets);
+}
+
 int ClientSocketPoolBaseHelper::RequestSocketInternal(
     const std::string& group_name,
     const Request& request) {
@@ -535,6 +604,9 @@ bool ClientSocketPoolBaseHelper::HasGroup(const std::string& group_name) const {
 }
 
 void ClientSocketPoolBaseHelper::CloseIdleSockets() {
+  // Otherwise the sockets of warm groups would just be opened again.
+  for (GroupMap::iterator i = group_map_.begin(); i != group_map_.end(); ++i)
+    i->second->ClearWarmRequest();
   CleanupIdleSockets(true);
   DCHECK_EQ(0, idle_socket_count_);
 }
@@ -658,6 +730,10 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
   // inside the inner loop, since it shouldn't change by any meaningful amount.
   base::TimeTicks now = base::TimeTicks::Now();
 
+  // Groups which keep sockets warm are topped up once all groups have been
+  // cleaned up, since that may start ConnectJobs and delete groups.
+  std::vector<std::string> warm_group_names;
+
   GroupMap::iterator i = group_map_.begin();
   while (i != group_map_.end()) {
     Group* group = i->second;
@@ -676,13 +752,23 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
       }
     }
 
+    if (group->warm_request())
+      warm_group_names.push_back(i->first);
+
     // Delete group if no longer needed.
-    if (group->IsEmpty()) {
+    if (group->IsEmpty() && !group->warm_request()) {
       RemoveGroup(i++);
     } else {
       ++i;
     }
   }
+
+  for (std::vector<std::string>::const_iterator it = warm_group_names.begin();
+       it != warm_group_names.end(); ++it) {
+    GroupMap::iterator group_it = group_map_.find(*it);
+    if (group_it != group_map_.end())
+      TopUpWarmSockets(*it, group_it->second, now);
+  }
 }
 
 ClientSocketPoolBaseHelper::Group* ClientSocketPoolBaseHelper::GetOrCreateGroup(
@@ -1134,7 +1220,8 @@ ClientSocketPoolBaseHelper::Group::Group()
       // The number of priorities is doubled since requests with
       // |ignore_limits| are prioritized over other requests.
       pending_requests_(2 * NUM_PRIORITIES),
-      active_socket_count_(0) {}
+      active_socket_count_(0),
+      num_warm_sockets_(0) {}
 
 ClientSocketPoolBaseHelper::Group::~Group() {
   DCHECK_EQ(0u, unassigned_job_count_);
@@ -1159,6 +1246,22 @@ bool ClientSocketPoolBaseHelper::Group::BackupJobTimerIsRunning() const {
   return backup_job_timer_.IsRunning();
 }
 
+void ClientSocketPoolBaseHelper::Group::SetWarmRequest(
+    scoped_ptr<const Request> request,
+    int num_warm_sockets,
+    base::TimeTicks warm_until) {
+  DCHECK_GT(num_warm_sockets, 0);
+  warm_request_ = request.Pass();
+  num_warm_sockets_ = num_warm_sockets;
+  warm_until_ = warm_until;
+}
+
+void ClientSocketPoolBaseHelper::Group::ClearWarmRequest() {
+  warm_request_.reset();
+  num_warm_sockets_ = 0;
+  warm_until_ = base::TimeTicks();
+}
+
 bool ClientSocketPoolBaseHelper::Group::TryToUseUnassignedConnectJob() {
   SanityCheck();
 
@@ -241,6 +241,18 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
                       const Request& request,
                       int num_sockets);
 
+  // Keeps at least |num_sockets| sockets of |group_name| open or connecting,
+  // like RequestSockets() does once, until |warm_until|. Unused idle sockets
+  // which have been idle for more than half of the unused idle socket timeout
+  // don't count, so they are replaced while they can still be handed out, and
+  // sockets closed by CleanupIdleSockets() are replaced when it runs. A
+  // |num_sockets| of 0 stops keeping sockets of the group warm. |request| is
+  // used for all the ConnectJobs and must not have a handle.
+  void SetWarmSockets(const std::string& group_name,
+                      scoped_ptr<const Request> request,
+                      int num_sockets,
+                      base::TimeTicks warm_until);
+
   // See ClientSocketPool::CancelRequest for documentation on this function.
   void CancelRequest(const std::string& group_name,
                      ClientSocketHandle* handle);
@@ -438,6 +450,17 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     scoped_ptr<const Request> FindAndRemovePendingRequest(
         ClientSocketHandle* handle);
 
+    // Sets the request used to keep sockets of the group warm, and how many
+    // until when. See ClientSocketPoolBaseHelper::SetWarmSockets().
+    void SetWarmRequest(scoped_ptr<const Request> request,
+                        int num_warm_sockets,
+                        base::TimeTicks warm_until);
+    void ClearWarmRequest();
+
+    const Request* warm_request() const { return warm_request_.get(); }
+    int num_warm_sockets() const { return num_warm_sockets_; }
+    base::TimeTicks warm_until() const { return warm_until_; }
+
     void IncrementActiveSocketCount() { active_socket_count_++; }
     void DecrementActiveSocketCount() { active_socket_count_--; }
 
@@ -474,6 +497,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     std::set<ConnectJob*> jobs_;
     RequestQueue pending_requests_;
     int active_socket_count_;  // number of active sockets used by clients
+    // Set while sockets are kept warm. Doesn't keep the group alive on its
+    // own, so it is dropped with the group.
+    scoped_ptr<const Request> warm_request_;
+    int num_warm_sockets_;
+    base::TimeTicks warm_until_;
     // A timer for when to start the backup job.
     base::OneShotTimer<Group> backup_job_timer_;
   };
@@ -549,6 +577,18 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // Returns true if we can't create any more sockets due to the total limit.
   bool ReachedMaxSocketsLimit() const;
 
+  // Starts ConnectJobs for |request| until |group_name| has |num_sockets|
+  // socket slots in use, or no more can be started. May delete the group.
+  void PreconnectSockets(const std::string& group_name,
+                         const Request& request,
+                         int num_sockets);
+
+  // Starts the ConnectJobs |group| is missing to have its warm sockets, or
+  // stops keeping them once its warm_until() has passed. May delete the group.
+  void TopUpWarmSockets(const std::string& group_name,
+                        Group* group,
+                        base::TimeTicks now);
+
   // This is the internal implementation of RequestSocket().  It differs in that
   // it does not handle logging into NetLog of the queueing status of
   // |request|.
@@ -758,6 +798,30 @@ class ClientSocketPoolBase {
     helper_.RequestSockets(group_name, request, num_sockets);
   }
 
+  // SetWarmSockets bundles up the parameters into a Request the way
+  // RequestSockets() does and forwards to
+  // ClientSocketPoolBaseHelper::SetWarmSockets(). The Request outlives the
+  // one which asked for warm sockets, so it is not bound to its NetLog.
+  void SetWarmSockets(const std::string& group_name,
+                      const scoped_refptr<SocketParams>& params,
+                      int num_sockets,
+                      base::TimeTicks warm_until) {
+    scoped_ptr<Request> request(
+        new Request(NULL /* no handle */,
+                    CompletionCallback(),
+                    DEFAULT_PRIORITY,
+                    internal::ClientSocketPoolBaseHelper::NO_IDLE_SOCKETS,
+                    params->ignore_limits(),
+                    params,
+                    BoundNetLog()));
+    helper_.SetWarmSockets(
+        group_name,
+        request.template PassAs<
+            const internal::ClientSocketPoolBaseHelper::Request>(),
+        num_sockets,
+        warm_until);
+  }
+
   void CancelRequest(const std::string& group_name,
                      ClientSocketHandle* handle) {
     return helper_.CancelRequest(group_name, handle);
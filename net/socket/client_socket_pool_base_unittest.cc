@@ -590,6 +590,13 @@ class TestClientSocketPool : public ClientSocketPool {
     return base_.HasGroup(group_name);
   }
 
+  void SetWarmSockets(const std::string& group_name,
+                      const scoped_refptr<TestSocketParams>& params,
+                      int num_sockets,
+                      base::TimeTicks warm_until) {
+    base_.SetWarmSockets(group_name, params, num_sockets, warm_until);
+  }
+
   void CleanupTimedOutIdleSockets() { base_.CleanupIdleSockets(false); }
 
   void EnableConnectBackupJobs() { base_.EnableConnectBackupJobs(); }
@@ -3659,6 +3666,126 @@ TEST_F(ClientSocketPoolBaseTest, PreconnectClosesIdleSocketRemovesGroup) {
   EXPECT_EQ(0, pool_->NumActiveSocketsInGroup("b"));
 }
 
+TEST_F(ClientSocketPoolBaseTest, WarmSockets) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  base::TimeTicks warm_until =
+      base::TimeTicks::Now() + base::TimeDelta::FromHours(1);
+
+  pool_->SetWarmSockets("a", params_, 2, warm_until);
+  EXPECT_EQ(2, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(2, pool_->NumUnassignedConnectJobsInGroup("a"));
+
+  // A request takes one of the ConnectJobs, and the socket it holds counts
+  // as one of the warm ones.
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  EXPECT_EQ(ERR_IO_PENDING, handle.Init("a",
+                                        params_,
+                                        kDefaultPriority,
+                                        callback.callback(),
+                                        pool_.get(),
+                                        BoundNetLog()));
+  pool_->SetWarmSockets("a", params_, 2, warm_until);
+  EXPECT_EQ(2, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(1, pool_->NumUnassignedConnectJobsInGroup("a"));
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(10));
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(0, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(1, pool_->NumActiveSocketsInGroup("a"));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+}
+
+TEST_F(ClientSocketPoolBaseTest, WarmSocketsReplacedAfterTimeout) {
+  CreatePoolWithIdleTimeouts(
+      kDefaultMaxSockets, kDefaultMaxSocketsPerGroup,
+      base::TimeDelta::FromMilliseconds(10),  // Time out unused sockets
+      base::TimeDelta::FromSeconds(10));  // Don't time out used sockets
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->SetWarmSockets("a", params_, 2,
+                        base::TimeTicks::Now() + base::TimeDelta::FromHours(1));
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  // The timed out sockets are closed, and replaced right away.
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(20));
+  pool_->CleanupTimedOutIdleSockets();
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(2, pool_->NumConnectJobsInGroup("a"));
+}
+
+TEST_F(ClientSocketPoolBaseTest, WarmSocketsReplacedBeforeTimeout) {
+  // Replacements count against the per-group limit, so leave room for them.
+  CreatePoolWithIdleTimeouts(
+      kDefaultMaxSockets, kDefaultMaxSockets,
+      base::TimeDelta::FromMilliseconds(100),  // Time out unused sockets
+      base::TimeDelta::FromSeconds(10));  // Don't time out used sockets
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+  base::TimeTicks warm_until =
+      base::TimeTicks::Now() + base::TimeDelta::FromHours(1);
+
+  pool_->SetWarmSockets("a", params_, 2, warm_until);
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  // Once the sockets have been idle for half of the timeout, replacements
+  // are started while they can still be handed out.
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(50));
+  pool_->SetWarmSockets("a", params_, 2, warm_until);
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(2, pool_->NumConnectJobsInGroup("a"));
+}
+
+TEST_F(ClientSocketPoolBaseTest, WarmSocketsExpire) {
+  CreatePoolWithIdleTimeouts(
+      kDefaultMaxSockets, kDefaultMaxSocketsPerGroup,
+      base::TimeDelta::FromMilliseconds(10),  // Time out unused sockets
+      base::TimeDelta::FromSeconds(10));  // Don't time out used sockets
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->SetWarmSockets(
+      "a", params_, 2,
+      base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(20));
+  pool_->CleanupTimedOutIdleSockets();
+  EXPECT_FALSE(pool_->HasGroup("a"));
+}
+
+TEST_F(ClientSocketPoolBaseTest, CloseIdleSocketsStopsWarmSockets) {
+  CreatePoolWithIdleTimeouts(
+      kDefaultMaxSockets, kDefaultMaxSocketsPerGroup,
+      base::TimeDelta::FromMilliseconds(10),  // Time out unused sockets
+      base::TimeDelta::FromSeconds(10));  // Don't time out used sockets
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->SetWarmSockets("a", params_, 2,
+                        base::TimeTicks::Now() + base::TimeDelta::FromHours(1));
+  EXPECT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  pool_->CloseIdleSockets();
+  EXPECT_FALSE(pool_->HasGroup("a"));
+  pool_->CleanupTimedOutIdleSockets();
+  EXPECT_FALSE(pool_->HasGroup("a"));
+}
+
+TEST_F(ClientSocketPoolBaseTest, WarmSocketsDontCloseOtherIdleSockets) {
+  CreatePool(2, 2);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->RequestSockets("a", &params_, 1, BoundNetLog());
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+
+  pool_->SetWarmSockets("b", params_, 2,
+                        base::TimeTicks::Now() + base::TimeDelta::FromHours(1));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("b"));
+}
+
 TEST_F(ClientSocketPoolBaseTest, PreconnectWithoutBackupJob) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
   pool_->EnableConnectBackupJobs();
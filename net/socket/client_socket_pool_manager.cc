@@ -9,12 +9,14 @@
 #include "base/basictypes.h"
 #include "base/logging.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_proxy_client_socket_pool.h"
 #include "net/http/http_request_info.h"
 #include "net/http/http_stream_factory.h"
 #include "net/proxy/proxy_info.h"
 #include "net/socket/client_socket_handle.h"
+#include "net/socket/connection_prewarm_model.h"
 #include "net/socket/socks_client_socket_pool.h"
 #include "net/socket/ssl_client_socket_pool.h"
 #include "net/socket/transport_client_socket_pool.h"
@@ -64,6 +66,26 @@ COMPILE_ASSERT(arraysize(g_max_sockets_per_proxy_server) ==
                    HttpNetworkSession::NUM_SOCKET_POOL_TYPES,
                max_sockets_per_proxy_server_length_mismatch);
 
+// Tells |pool| how many sockets of |group_name|, whose connections go to
+// |server|, to keep warm, if the session predicts it.
+template <typename PoolType, typename SocketParams>
+void KeepSocketsWarm(HttpNetworkSession* session,
+                     HttpNetworkSession::SocketPoolType socket_pool_type,
+                     PoolType* pool,
+                     const std::string& group_name,
+                     const scoped_refptr<SocketParams>& params,
+                     const HostPortPair& server) {
+  ConnectionPrewarmModel* model = session->connection_prewarm_model();
+  if (!model || socket_pool_type != HttpNetworkSession::NORMAL_SOCKET_POOL)
+    return;
+
+  int num_sockets = 0;
+  base::TimeTicks warm_until;
+  model->OnSocketRequested(group_name, server, base::TimeTicks::Now(),
+                           &num_sockets, &warm_until);
+  pool->SetWarmSockets(group_name, params, num_sockets, warm_until);
+}
+
 // The meat of the implementation for the InitSocketHandleForHttpRequest,
 // InitSocketHandleForRawConnect and PreconnectSocketsForHttpRequest methods.
 int InitSocketPoolHelper(const GURL& request_url,
@@ -245,9 +267,14 @@ int InitSocketPoolHelper(const GURL& request_url,
       return OK;
     }
 
-    return socket_handle->Init(connection_group, ssl_params,
-                               request_priority, callback, ssl_pool,
-                               net_log);
+    int rv = socket_handle->Init(connection_group, ssl_params,
+                                 request_priority, callback, ssl_pool,
+                                 net_log);
+    if (proxy_info.is_direct()) {
+      KeepSocketsWarm(session, socket_pool_type, ssl_pool, connection_group,
+                      ssl_params, origin_host_port);
+    }
+    return rv;
   }
 
   // Finally, get the connection started.
@@ -290,9 +317,12 @@ int InitSocketPoolHelper(const GURL& request_url,
     return OK;
   }
 
-  return socket_handle->Init(connection_group, tcp_params,
-                             request_priority, callback,
-                             pool, net_log);
+  int rv = socket_handle->Init(connection_group, tcp_params,
+                               request_priority, callback,
+                               pool, net_log);
+  KeepSocketsWarm(session, socket_pool_type, pool, connection_group,
+                  tcp_params, origin_host_port);
+  return rv;
 }
 
 }  // namespace
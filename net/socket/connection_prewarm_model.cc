@@ -0,0 +1,95 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/socket/connection_prewarm_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "net/base/host_port_pair.h"
+#include "net/http/http_server_properties.h"
+
+namespace net {
+
+namespace {
+
+// Weight of the latest burst in the moving averages.
+const double kNewBurstWeight = 0.25;
+
+// Sockets are kept warm until the next burst is this late, relative to the
+// average time between bursts.
+const double kBurstIntervalSlack = 1.5;
+
+}  // namespace
+
+const int ConnectionPrewarmModel::kBurstGapMs = 1000;
+const int ConnectionPrewarmModel::kMaxWarmTimeSeconds = 300;
+const int ConnectionPrewarmModel::kMaxGroups = 256;
+
+ConnectionPrewarmModel::GroupStats::GroupStats(base::TimeTicks now)
+    : burst_start_time(now),
+      last_request_time(now),
+      burst_size(0),
+      num_bursts(0),
+      average_burst_size(0) {}
+
+ConnectionPrewarmModel::ConnectionPrewarmModel(
+    const base::WeakPtr<HttpServerProperties>& http_server_properties)
+    : http_server_properties_(http_server_properties),
+      group_stats_(kMaxGroups) {}
+
+ConnectionPrewarmModel::~ConnectionPrewarmModel() {}
+
+void ConnectionPrewarmModel::OnSocketRequested(
+    const std::string& group_name,
+    const HostPortPair& server,
+    base::TimeTicks now,
+    int* num_sockets,
+    base::TimeTicks* warm_until) {
+  *num_sockets = 0;
+  *warm_until = now;
+
+  GroupStatsMap::iterator it = group_stats_.Get(group_name);
+  if (it == group_stats_.end())
+    it = group_stats_.Put(group_name, GroupStats(now));
+  GroupStats& stats = it->second;
+
+  if (stats.burst_size > 0 &&
+      now - stats.last_request_time >=
+          base::TimeDelta::FromMilliseconds(kBurstGapMs)) {
+    // The previous burst is over.
+    base::TimeDelta interval = now - stats.burst_start_time;
+    if (stats.num_bursts == 0) {
+      stats.average_burst_size = stats.burst_size;
+      stats.average_burst_interval = interval;
+    } else {
+      stats.average_burst_size =
+          kNewBurstWeight * stats.burst_size +
+          (1 - kNewBurstWeight) * stats.average_burst_size;
+      stats.average_burst_interval = base::TimeDelta::FromMicroseconds(
+          kNewBurstWeight * interval.InMicroseconds() +
+          (1 - kNewBurstWeight) *
+              stats.average_burst_interval.InMicroseconds());
+    }
+    ++stats.num_bursts;
+    stats.burst_start_time = now;
+    stats.burst_size = 0;
+  }
+  ++stats.burst_size;
+  stats.last_request_time = now;
+
+  if (stats.num_bursts == 0)
+    return;
+  if (http_server_properties_ && http_server_properties_->SupportsSpdy(server))
+    return;
+
+  *num_sockets = static_cast<int>(std::ceil(stats.average_burst_size));
+  base::TimeDelta next_burst_deadline = base::TimeDelta::FromMicroseconds(
+      kBurstIntervalSlack * stats.average_burst_interval.InMicroseconds());
+  *warm_until = std::min(
+      stats.burst_start_time + next_burst_deadline,
+      now + base::TimeDelta::FromSeconds(kMaxWarmTimeSeconds));
+}
+
+}  // namespace net
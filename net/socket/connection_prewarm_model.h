@@ -0,0 +1,78 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SOCKET_CONNECTION_PREWARM_MODEL_H_
+#define NET_SOCKET_CONNECTION_PREWARM_MODEL_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+class HostPortPair;
+class HttpServerProperties;
+
+// Predicts how many sockets a connection group should keep open, and for how
+// long, from the way socket requests for the group have come so far.
+//
+// Requests for a group come in bursts, like the requests for the resources of
+// a page. A burst is a run of requests less than kBurstGapMs apart. The model
+// keeps moving averages of the burst size and of the time from one burst to
+// the next, and asks for as many sockets as the average burst needs, until
+// the next burst is overdue. Servers which support SPDY get none, since all
+// their requests share one session.
+class NET_EXPORT_PRIVATE ConnectionPrewarmModel {
+ public:
+  // Requests less than this far apart belong to the same burst.
+  static const int kBurstGapMs;
+  // Sockets are kept warm for at most this long after a request.
+  static const int kMaxWarmTimeSeconds;
+  // The number of groups the model remembers.
+  static const int kMaxGroups;
+
+  explicit ConnectionPrewarmModel(
+      const base::WeakPtr<HttpServerProperties>& http_server_properties);
+  ~ConnectionPrewarmModel();
+
+  // Records a socket request for |group_name|, whose connections go to
+  // |server|, made at |now|. Sets |*num_sockets| to the number of sockets the
+  // group should keep open or connecting until |*warm_until|. Sets
+  // |*num_sockets| to 0 when nothing is known about the group yet.
+  void OnSocketRequested(const std::string& group_name,
+                         const HostPortPair& server,
+                         base::TimeTicks now,
+                         int* num_sockets,
+                         base::TimeTicks* warm_until);
+
+ private:
+  struct GroupStats {
+    explicit GroupStats(base::TimeTicks now);
+
+    // The burst in progress.
+    base::TimeTicks burst_start_time;
+    base::TimeTicks last_request_time;
+    int burst_size;
+
+    // Moving averages over the completed bursts.
+    int num_bursts;
+    double average_burst_size;
+    base::TimeDelta average_burst_interval;
+  };
+
+  typedef base::MRUCache<std::string, GroupStats> GroupStatsMap;
+
+  const base::WeakPtr<HttpServerProperties> http_server_properties_;
+  GroupStatsMap group_stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConnectionPrewarmModel);
+};
+
+}  // namespace net
+
+#endif  // NET_SOCKET_CONNECTION_PREWARM_MODEL_H_
@@ -0,0 +1,293 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/socket/connection_prewarm_model.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/time/time.h"
+#include "net/base/host_port_pair.h"
+#include "net/http/http_server_properties_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const char kGroupName[] = "ssl/www.example.com:443";
+
+class ConnectionPrewarmModelTest : public ::testing::Test {
+ protected:
+  ConnectionPrewarmModelTest()
+      : server_("www.example.com", 443),
+        model_(http_server_properties_.GetWeakPtr()),
+        start_(base::TimeTicks::Now()),
+        num_sockets_(0) {}
+
+  // Requests a socket |ms| milliseconds after the start of the test.
+  void RequestAt(int ms) {
+    model_.OnSocketRequested(kGroupName, server_,
+                             start_ + base::TimeDelta::FromMilliseconds(ms),
+                             &num_sockets_, &warm_until_);
+  }
+
+  // Requests |burst_size| sockets 100ms apart, starting |ms| milliseconds
+  // after the start of the test.
+  void BurstAt(int ms, int burst_size) {
+    for (int i = 0; i < burst_size; ++i)
+      RequestAt(ms + i * 100);
+  }
+
+  base::TimeTicks At(int ms) const {
+    return start_ + base::TimeDelta::FromMilliseconds(ms);
+  }
+
+  const HostPortPair server_;
+  HttpServerPropertiesImpl http_server_properties_;
+  ConnectionPrewarmModel model_;
+  const base::TimeTicks start_;
+  int num_sockets_;
+  base::TimeTicks warm_until_;
+};
+
+TEST_F(ConnectionPrewarmModelTest, NothingWarmBeforeFirstBurstEnds) {
+  BurstAt(0, 4);
+  EXPECT_EQ(0, num_sockets_);
+}
+
+TEST_F(ConnectionPrewarmModelTest, WarmForNextBurst) {
+  BurstAt(0, 4);
+  RequestAt(20000);
+  EXPECT_EQ(4, num_sockets_);
+  // Kept warm until the next burst is half an interval late.
+  EXPECT_EQ(At(50000), warm_until_);
+}
+
+TEST_F(ConnectionPrewarmModelTest, AverageBurstSize) {
+  BurstAt(0, 2);
+  BurstAt(10000, 6);
+  RequestAt(20000);
+  // 0.25 * 6 + 0.75 * 2 = 3.
+  EXPECT_EQ(3, num_sockets_);
+}
+
+TEST_F(ConnectionPrewarmModelTest, WarmTimeIsCapped) {
+  BurstAt(0, 2);
+  RequestAt(1000 * 1000);
+  EXPECT_EQ(2, num_sockets_);
+  EXPECT_EQ(At(1000 * 1000) + base::TimeDelta::FromSeconds(
+                ConnectionPrewarmModel::kMaxWarmTimeSeconds),
+            warm_until_);
+}
+
+TEST_F(ConnectionPrewarmModelTest, NothingWarmForSpdy) {
+  http_server_properties_.SetSupportsSpdy(server_, true);
+  BurstAt(0, 4);
+  RequestAt(20000);
+  EXPECT_EQ(0, num_sockets_);
+}
+
+// Replays a trace of request bursts against a single connection group of a
+// simulated socket pool, which keeps sockets warm the way
+// ClientSocketPoolBaseHelper::SetWarmSockets() does, to measure how long the
+// requests wait for connects.
+class PrewarmSimulation {
+ public:
+  static const int kConnectMs = 300;
+  static const int kRequestMs = 500;
+  static const int kMaxSocketsPerGroup = 6;
+  static const int kCleanupIntervalSeconds = 10;
+  static const int kUnusedIdleSocketTimeoutSeconds = 10;
+  static const int kUsedIdleSocketTimeoutSeconds = 300;
+  // Servers close connections which have been idle for this long.
+  static const int kServerIdleTimeoutSeconds = 15;
+
+  explicit PrewarmSimulation(ConnectionPrewarmModel* model)
+      : model_(model),
+        server_("www.example.com", 443),
+        start_(base::TimeTicks::Now()),
+        next_cleanup_(start_ +
+                      base::TimeDelta::FromSeconds(kCleanupIntervalSeconds)),
+        num_warm_sockets_(0),
+        num_connects_(0) {}
+
+  // Requests a socket at |now|, and returns how long it waited for a connect.
+  base::TimeDelta Request(base::TimeTicks now) {
+    while (next_cleanup_ <= now) {
+      CleanupIdleSockets(next_cleanup_);
+      next_cleanup_ += base::TimeDelta::FromSeconds(kCleanupIntervalSeconds);
+    }
+
+    std::list<Socket>::iterator socket = FindIdleSocket(now);
+    base::TimeDelta wait;
+    if (socket == sockets_.end()) {
+      // Wait for the preconnect closest to completion, or for a new connect.
+      for (std::list<Socket>::iterator it = sockets_.begin();
+           it != sockets_.end(); ++it) {
+        if (!it->used && it->available_time > now &&
+            (socket == sockets_.end() ||
+             it->available_time < socket->available_time)) {
+          socket = it;
+        }
+      }
+      if (socket == sockets_.end())
+        socket = Connect(now);
+      wait = socket->available_time - now;
+    }
+    socket->available_time = now + wait +
+        base::TimeDelta::FromMilliseconds(kRequestMs);
+    socket->used = true;
+
+    if (model_) {
+      model_->OnSocketRequested(kGroupName, server_, now, &num_warm_sockets_,
+                                &warm_until_);
+      TopUpWarmSockets(now);
+    }
+    return wait;
+  }
+
+  base::TimeTicks start() const { return start_; }
+  int num_connects() const { return num_connects_; }
+
+ private:
+  struct Socket {
+    // When the socket is done connecting, or with the request using it.
+    base::TimeTicks available_time;
+    bool used;
+  };
+
+  bool IsIdle(const Socket& socket, base::TimeTicks now) const {
+    return socket.available_time <= now;
+  }
+
+  bool ClosedByServer(const Socket& socket, base::TimeTicks now) const {
+    return now - socket.available_time >=
+        base::TimeDelta::FromSeconds(kServerIdleTimeoutSeconds);
+  }
+
+  // Drops the idle sockets closed by the server, and returns the newest used
+  // idle socket, or else the oldest unused one.
+  std::list<Socket>::iterator FindIdleSocket(base::TimeTicks now) {
+    std::list<Socket>::iterator found = sockets_.end();
+    for (std::list<Socket>::iterator it = sockets_.begin();
+         it != sockets_.end();) {
+      if (!IsIdle(*it, now)) {
+        ++it;
+        continue;
+      }
+      if (ClosedByServer(*it, now)) {
+        it = sockets_.erase(it);
+        continue;
+      }
+      if (found == sockets_.end() ||
+          (it->used && (!found->used ||
+                        it->available_time > found->available_time)) ||
+          (!it->used && !found->used &&
+           it->available_time < found->available_time)) {
+        found = it;
+      }
+      ++it;
+    }
+    return found;
+  }
+
+  std::list<Socket>::iterator Connect(base::TimeTicks now) {
+    ++num_connects_;
+    Socket socket;
+    socket.available_time =
+        now + base::TimeDelta::FromMilliseconds(kConnectMs);
+    socket.used = false;
+    return sockets_.insert(sockets_.end(), socket);
+  }
+
+  void CleanupIdleSockets(base::TimeTicks now) {
+    for (std::list<Socket>::iterator it = sockets_.begin();
+         it != sockets_.end();) {
+      base::TimeDelta timeout = base::TimeDelta::FromSeconds(
+          it->used ? kUsedIdleSocketTimeoutSeconds :
+                     kUnusedIdleSocketTimeoutSeconds);
+      if (IsIdle(*it, now) &&
+          (ClosedByServer(*it, now) || now - it->available_time >= timeout)) {
+        it = sockets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    TopUpWarmSockets(now);
+  }
+
+  void TopUpWarmSockets(base::TimeTicks now) {
+    if (num_warm_sockets_ == 0 || now >= warm_until_)
+      return;
+    int num_sockets = num_warm_sockets_;
+    for (std::list<Socket>::const_iterator it = sockets_.begin();
+         it != sockets_.end(); ++it) {
+      if (!it->used && IsIdle(*it, now) &&
+          now - it->available_time >= base::TimeDelta::FromSeconds(
+              kUnusedIdleSocketTimeoutSeconds) / 2) {
+        ++num_sockets;
+      }
+    }
+    num_sockets = std::min(num_sockets, kMaxSocketsPerGroup);
+    while (static_cast<int>(sockets_.size()) < num_sockets)
+      Connect(now);
+  }
+
+  ConnectionPrewarmModel* const model_;
+  const HostPortPair server_;
+  const base::TimeTicks start_;
+  base::TimeTicks next_cleanup_;
+  std::list<Socket> sockets_;
+  int num_warm_sockets_;
+  base::TimeTicks warm_until_;
+  int num_connects_;
+};
+
+// Replays bursts of requests, like the loads of a page which is reloaded
+// every 20 to 55 seconds, and returns the total time spent waiting for
+// connects.
+base::TimeDelta ReplayTrace(PrewarmSimulation* simulation) {
+  const int kBurstSizes[] = { 4, 6, 5, 6, 3, 6, 5, 4 };
+  const int kBurstIntervalsSeconds[] = { 25, 40, 30, 55, 20, 35, 45, 30 };
+  const int kNumBursts = 40;
+
+  base::TimeDelta total_wait;
+  base::TimeTicks burst_start = simulation->start();
+  for (int i = 0; i < kNumBursts; ++i) {
+    int burst_size = kBurstSizes[i % arraysize(kBurstSizes)];
+    for (int j = 0; j < burst_size; ++j) {
+      total_wait += simulation->Request(
+          burst_start + base::TimeDelta::FromMilliseconds(100 * j));
+    }
+    burst_start += base::TimeDelta::FromSeconds(
+        kBurstIntervalsSeconds[(3 * i) % arraysize(kBurstIntervalsSeconds)]);
+  }
+  return total_wait;
+}
+
+TEST(ConnectionPrewarmModelSimulationTest, SavesConnectWaitTime) {
+  PrewarmSimulation without_prewarming(NULL);
+  base::TimeDelta wait_without_prewarming = ReplayTrace(&without_prewarming);
+
+  HttpServerPropertiesImpl http_server_properties;
+  ConnectionPrewarmModel model(http_server_properties.GetWeakPtr());
+  PrewarmSimulation with_prewarming(&model);
+  base::TimeDelta wait_with_prewarming = ReplayTrace(&with_prewarming);
+
+  // Servers close the sockets between most of the bursts, so without
+  // prewarming nearly every request waits for a connect. With it, mostly the
+  // requests of the first bursts do.
+  EXPECT_LT(wait_with_prewarming * 10, wait_without_prewarming);
+  // Replacing the warm sockets before they time out costs connects, but less
+  // than one more for each request.
+  EXPECT_LT(with_prewarming.num_connects(),
+            2 * without_prewarming.num_connects());
+}
+
+}  // namespace
+
+}  // namespace net
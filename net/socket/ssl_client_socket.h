@@ -20,6 +20,7 @@ class ServerBoundCertService;
 class SSLCertRequestInfo;
 struct SSLConfig;
 class SSLInfo;
+class SSLSessionStore;
 class TransportSecurityState;
 
 // This struct groups together several fields which are used by various
@@ -106,6 +107,14 @@ class NET_EXPORT SSLClientSocket : public SSLSocket {
   // sessions.
   static void ClearSessionCache();
 
+  // Sets the store that the SSL session cache is saved to, so that sessions
+  // can be resumed after a restart. The sessions in |store| are added to the
+  // session cache, and the sessions in the cache to |store|. From then on,
+  // |store| follows the changes to the cache until SetSessionStore() is
+  // called again. |store| must be detached, by passing NULL, before it is
+  // destroyed. Only the OpenSSL implementation can save sessions.
+  static void SetSessionStore(SSLSessionStore* store);
+
   virtual bool set_was_npn_negotiated(bool negotiated);
 
   virtual bool was_spdy_negotiated() const;
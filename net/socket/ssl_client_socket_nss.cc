@@ -2771,6 +2771,12 @@ void SSLClientSocket::ClearSessionCache() {
   SSL_ClearSessionCache();
 }
 
+// static
+void SSLClientSocket::SetSessionStore(SSLSessionStore* store) {
+  // NSS does not allow the sessions in its client session cache to be
+  // exported or imported.
+}
+
 bool SSLClientSocketNSS::GetSSLInfo(SSLInfo* ssl_info) {
   EnterFunction("");
   ssl_info->Reset();
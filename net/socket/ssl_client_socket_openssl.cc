@@ -27,6 +27,7 @@
 #include "net/ssl/ssl_cert_request_info.h"
 #include "net/ssl/ssl_connection_status_flags.h"
 #include "net/ssl/ssl_info.h"
+#include "net/ssl/ssl_session_store.h"
 
 namespace net {
 
@@ -215,12 +216,39 @@ int NoOpVerifyCallback(X509_STORE_CTX*, void *) {
   return 1;
 }
 
+// Serializes |session| for an SSLSessionStore.
+std::string SerializeSession(SSL_SESSION* session) {
+  int length = i2d_SSL_SESSION(session, NULL);
+  if (length <= 0)
+    return std::string();
+  std::string data(length, '\0');
+  unsigned char* out = reinterpret_cast<unsigned char*>(&data[0]);
+  i2d_SSL_SESSION(session, &out);
+  return data;
+}
+
+// Returns the session serialized in |data|, or NULL if it can't be parsed or
+// has expired. The caller owns the returned session.
+SSL_SESSION* DeserializeSession(const std::string& data) {
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(data.data());
+  SSL_SESSION* session = d2i_SSL_SESSION(NULL, &in, data.size());
+  if (!session)
+    return NULL;
+  if (SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <=
+      time(NULL)) {
+    SSL_SESSION_free(session);
+    return NULL;
+  }
+  return session;
+}
+
 // OpenSSL manages a cache of SSL_SESSION, this class provides the application
 // side policy for that cache about session re-use: we retain one session per
-// unique HostPortPair, per shard.
+// unique HostPortPair, per shard. The sessions are mirrored to an optional
+// SSLSessionStore, so that they outlive the process.
 class SSLSessionCache {
  public:
-  SSLSessionCache() {}
+  SSLSessionCache() : store_(NULL) {}
 
   void OnSessionAdded(const HostPortPair& host_and_port,
                       const std::string& shard,
@@ -245,7 +273,8 @@ class SSLSessionCache {
     DCHECK(host_port_map_[cache_key] == session);
     session_map_[session] = res.first;
     DCHECK_EQ(host_port_map_.size(), session_map_.size());
-    DCHECK_LE(host_port_map_.size(), kSessionCacheMaxEntires);
+    if (store_)
+      store_->SetSession(cache_key, SerializeSession(session));
   }
 
   void OnSessionRemoved(SSL_SESSION* session) {
@@ -259,6 +288,8 @@ class SSLSessionCache {
       return;
     DVLOG(2) << "Remove session " << session << " => " << it->second->first;
     DCHECK(it->second->second == session);
+    if (store_)
+      store_->DeleteSession(it->second->first);
     host_port_map_.erase(it->second);
     session_map_.erase(it);
     session_to_free.reset(session);
@@ -295,6 +326,41 @@ class SSLSessionCache {
     }
     host_port_map_.clear();
     session_map_.clear();
+    if (store_)
+      store_->DeleteAll();
+  }
+
+  // Makes |store| follow the cache, after exchanging the sessions missing
+  // from either of them. Sessions only enter OpenSSL's internal cache when
+  // they are negotiated, so the ones loaded from |store| are not evicted by
+  // it, and the cache may hold more than kSessionCacheMaxEntires sessions.
+  // They are replaced by the new sessions of failed resumptions.
+  void SetStore(SSLSessionStore* store) {
+    base::AutoLock lock(lock_);
+    store_ = store;
+    if (!store_)
+      return;
+
+    SSLSessionStore::SessionList stored_sessions;
+    store_->GetAllSessions(&stored_sessions);
+    for (HostPortMap::const_iterator it = host_port_map_.begin();
+         it != host_port_map_.end(); ++it) {
+      store_->SetSession(it->first, SerializeSession(it->second));
+    }
+    for (SSLSessionStore::SessionList::const_iterator it =
+             stored_sessions.begin();
+         it != stored_sessions.end(); ++it) {
+      if (host_port_map_.count(it->first))
+        continue;
+      SSL_SESSION* session = DeserializeSession(it->second);
+      if (!session) {
+        store_->DeleteSession(it->first);
+        continue;
+      }
+      DVLOG(2) << "Loaded session " << session << " => " << it->first;
+      session_map_[session] =
+          host_port_map_.insert(std::make_pair(it->first, session)).first;
+    }
   }
 
  private:
@@ -310,7 +376,10 @@ class SSLSessionCache {
   HostPortMap host_port_map_;
   SessionMap session_map_;
 
-  // Protects access to both the above maps.
+  // Not owned. May be NULL.
+  SSLSessionStore* store_;
+
+  // Protects access to both the above maps, and to |store_|.
   base::Lock lock_;
 
   DISALLOW_COPY_AND_ASSIGN(SSLSessionCache);
@@ -374,6 +443,12 @@ class SSLClientSocketOpenSSL::SSLContext {
 #endif
   }
 
+  ~SSLContext() {
+    // Freeing |ssl_ctx_| removes all its sessions, which must not be deleted
+    // from the store.
+    session_cache_.SetStore(NULL);
+  }
+
   static int NewSessionCallbackStatic(SSL* ssl, SSL_SESSION* session) {
     return GetInstance()->NewSessionCallback(ssl, session);
   }
@@ -433,6 +508,13 @@ void SSLClientSocket::ClearSessionCache() {
   context->session_cache()->Flush();
 }
 
+// static
+void SSLClientSocket::SetSessionStore(SSLSessionStore* store) {
+  SSLClientSocketOpenSSL::SSLContext* context =
+      SSLClientSocketOpenSSL::SSLContext::GetInstance();
+  context->session_cache()->SetStore(store);
+}
+
 SSLClientSocketOpenSSL::SSLClientSocketOpenSSL(
     scoped_ptr<ClientSocketHandle> transport_socket,
     const HostPortPair& host_and_port,
@@ -15,9 +15,11 @@
 
 #include "base/file_util.h"
 #include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_handle.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
 #include "base/values.h"
 #include "crypto/openssl_util.h"
 #include "net/base/address_list.h"
@@ -36,10 +38,12 @@
 #include "net/socket/socket_test_util.h"
 #include "net/socket/tcp_client_socket.h"
 #include "net/ssl/default_server_bound_cert_store.h"
+#include "net/ssl/file_ssl_session_store.h"
 #include "net/ssl/openssl_client_key_store.h"
 #include "net/ssl/server_bound_cert_service.h"
 #include "net/ssl/ssl_cert_request_info.h"
 #include "net/ssl/ssl_config_service.h"
+#include "net/ssl/ssl_info.h"
 #include "net/test/cert_test_util.h"
 #include "net/test/spawned_test_server/spawned_test_server.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -91,6 +95,20 @@ class FailingServerBoundCertStore : public ServerBoundCertStore {
   virtual void SetForceKeepSessionState() OVERRIDE {}
 };
 
+// Saves the SSL session cache to |store| for the lifetime of the object.
+class ScopedSessionStore {
+ public:
+  explicit ScopedSessionStore(SSLSessionStore* store) {
+    SSLClientSocket::SetSessionStore(store);
+  }
+  ~ScopedSessionStore() {
+    SSLClientSocket::SetSessionStore(NULL);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ScopedSessionStore);
+};
+
 // Loads a PEM-encoded private key file into a scoped EVP_PKEY object.
 // |filepath| is the private key file path.
 // |*pkey| is reset to the new EVP_PKEY on success, untouched otherwise.
@@ -361,5 +379,47 @@ TEST_F(SSLClientSocketOpenSSLClientAuthTest, FailingChannelID) {
   EXPECT_FALSE(sock_->IsConnected());
 }
 
+// Connect to a server, save the session to a file, and resume it after a
+// simulated restart, which empties the session cache and reloads the file.
+TEST_F(SSLClientSocketOpenSSLClientAuthTest, ResumeSessionAfterRestart) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.path().AppendASCII("SSL Sessions");
+  SSLClientSocket::ClearSessionCache();
+
+  SpawnedTestServer::SSLOptions ssl_options;
+  ASSERT_TRUE(ConnectToTestServer(ssl_options));
+  SSLConfig ssl_config = kDefaultSSLConfig;
+  SSLInfo ssl_info;
+  int rv;
+
+  {
+    FileSSLSessionStore store(path, base::MessageLoopProxy::current());
+    ScopedSessionStore scoped_store(&store);
+    ASSERT_TRUE(CreateAndConnectSSLClientSocket(ssl_config, &rv));
+    ASSERT_EQ(OK, rv);
+    ASSERT_TRUE(sock_->GetSSLInfo(&ssl_info));
+    EXPECT_EQ(SSLInfo::HANDSHAKE_FULL, ssl_info.handshake_type);
+    sock_->Disconnect();
+  }
+  // Let the store write the file.
+  base::RunLoop().RunUntilIdle();
+
+  SSLClientSocket::ClearSessionCache();
+  FileSSLSessionStore store(path, base::MessageLoopProxy::current());
+  base::RunLoop run_loop;
+  store.Load(run_loop.QuitClosure());
+  run_loop.Run();
+  ScopedSessionStore scoped_store(&store);
+
+  transport_.reset(new TCPClientSocket(addr_, &log_, NetLog::Source()));
+  ASSERT_EQ(OK, callback_.GetResult(transport_->Connect(callback_.callback())));
+  ASSERT_TRUE(CreateAndConnectSSLClientSocket(ssl_config, &rv));
+  ASSERT_EQ(OK, rv);
+  ASSERT_TRUE(sock_->GetSSLInfo(&ssl_info));
+  EXPECT_EQ(SSLInfo::HANDSHAKE_RESUME, ssl_info.handshake_type);
+  sock_->Disconnect();
+}
+
 }  // namespace
 }  // namespace net
@@ -676,6 +676,14 @@ bool SSLClientSocketPool::CloseOneIdleConnection() {
   return base_.CloseOneIdleConnectionInHigherLayeredPool();
 }
 
+void SSLClientSocketPool::SetWarmSockets(
+    const std::string& group_name,
+    const scoped_refptr<SSLSocketParams>& params,
+    int num_sockets,
+    base::TimeTicks warm_until) {
+  base_.SetWarmSockets(group_name, params, num_sockets, warm_until);
+}
+
 void SSLClientSocketPool::OnSSLConfigChanged() {
   FlushWithError(ERR_NETWORK_CHANGED);
 }
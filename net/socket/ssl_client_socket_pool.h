@@ -251,6 +251,13 @@ class NET_EXPORT_PRIVATE SSLClientSocketPool
   // HigherLayeredPool implementation.
   virtual bool CloseOneIdleConnection() OVERRIDE;
 
+  // Keeps at least |num_sockets| sockets of |group_name| open or connecting
+  // until |warm_until|. See ClientSocketPoolBaseHelper::SetWarmSockets().
+  void SetWarmSockets(const std::string& group_name,
+                      const scoped_refptr<SSLSocketParams>& params,
+                      int num_sockets,
+                      base::TimeTicks warm_until);
+
  private:
   typedef ClientSocketPoolBase<SSLSocketParams> PoolBase;
 
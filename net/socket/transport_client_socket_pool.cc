@@ -5,6 +5,7 @@
 #include "net/socket/transport_client_socket_pool.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/lazy_instance.h"
@@ -28,13 +29,18 @@ using base::TimeDelta;
 
 namespace net {
 
-// TODO(willchan): Base this off RTT instead of statically setting it. Note we
-// choose a timeout that is different from the backup connect job timer so they
-// don't synchronize.
-const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
+// Note we choose a delay that is different from the backup connect job timer
+// so they don't synchronize.
+const int TransportConnectJob::kConnectAttemptDelayInMs = 300;
 
 namespace {
 
+// The shortest attempt delay, however fast the connects to an address were.
+const int kMinConnectAttemptDelayInMs = 100;
+
+// For how long an address which failed to connect is tried after the others.
+const int kAddressFailureMemoryInMinutes = 10;
+
 // Returns true iff all addresses in |list| are in the IPv6 family.
 bool AddressListOnlyContainsIPv6(const AddressList& list) {
   DCHECK(!list.empty());
@@ -88,6 +94,7 @@ TransportConnectJob::TransportConnectJob(
     base::TimeDelta timeout_duration,
     ClientSocketFactory* client_socket_factory,
     HostResolver* host_resolver,
+    const base::WeakPtr<HttpServerProperties>& http_server_properties,
     Delegate* delegate,
     NetLog* net_log)
     : ConnectJob(group_name, timeout_duration, priority, delegate,
@@ -95,15 +102,23 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
+      http_server_properties_(http_server_properties),
       next_state_(STATE_NONE),
+      next_address_index_(0),
+      last_error_(ERR_FAILED),
+      connected_address_index_(0),
       less_than_20ms_since_connect_(true) {
 }
 
 TransportConnectJob::~TransportConnectJob() {
-  // We don't worry about cancelling the host resolution and TCP connect, since
+  // We don't worry about cancelling the host resolution and TCP connects, since
   // ~SingleRequestHostResolver and ~StreamSocket will take care of it.
 }
 
+TransportConnectJob::ConnectAttempt::ConnectAttempt() : address_index(0) {}
+
+TransportConnectJob::ConnectAttempt::~ConnectAttempt() {}
+
 LoadState TransportConnectJob::GetLoadState() const {
   switch (next_state_) {
     case STATE_RESOLVE_HOST:
@@ -129,6 +144,32 @@ void TransportConnectJob::MakeAddressListStartWithIPv4(AddressList* list) {
   }
 }
 
+// static
+void TransportConnectJob::InterleaveAddressFamilies(AddressList* list) {
+  if (list->empty())
+    return;
+
+  const AddressFamily first_family = list->front().GetFamily();
+  std::vector<IPEndPoint> first_family_addresses;
+  std::vector<IPEndPoint> other_addresses;
+  for (AddressList::const_iterator i = list->begin(); i != list->end(); ++i) {
+    if (i->GetFamily() == first_family)
+      first_family_addresses.push_back(*i);
+    else
+      other_addresses.push_back(*i);
+  }
+
+  AddressList interleaved;
+  interleaved.set_canonical_name(list->canonical_name());
+  for (size_t i = 0; i < list->size(); ++i) {
+    if (i < first_family_addresses.size())
+      interleaved.push_back(first_family_addresses[i]);
+    if (i < other_addresses.size())
+      interleaved.push_back(other_addresses[i]);
+  }
+  *list = interleaved;
+}
+
 void TransportConnectJob::OnIOComplete(int result) {
   int rv = DoLoop(result);
   if (rv != ERR_IO_PENDING)
@@ -212,23 +253,16 @@ int TransportConnectJob::DoTransportConnect() {
   }
 
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
-  transport_socket_ = client_socket_factory_->CreateTransportClientSocket(
-        addresses_, net_log().net_log(), net_log().source());
-  int rv = transport_socket_->Connect(
-      base::Bind(&TransportConnectJob::OnIOComplete, base::Unretained(this)));
-  if (rv == ERR_IO_PENDING &&
-      addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
-      !AddressListOnlyContainsIPv6(addresses_)) {
-    fallback_timer_.Start(FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
-  }
-  return rv;
+  OrderAddresses();
+  next_address_index_ = 0;
+  return StartNextAttempts();
 }
 
 int TransportConnectJob::DoTransportConnectComplete(int result) {
   if (result == OK) {
-    bool is_ipv4 = addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV4;
+    DCHECK(transport_socket_);
+    const AddressFamily family =
+        addresses_[connected_address_index_].GetFamily();
     DCHECK(!connect_timing_.connect_start.is_null());
     DCHECK(!connect_timing_.dns_start.is_null());
     base::TimeTicks now = base::TimeTicks::Now();
@@ -263,12 +297,20 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
           100);
     }
 
-    if (is_ipv4) {
-      UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_No_Race",
-                                 connect_duration,
-                                 base::TimeDelta::FromMilliseconds(1),
-                                 base::TimeDelta::FromMinutes(10),
-                                 100);
+    if (family == ADDRESS_FAMILY_IPV4) {
+      if (addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6) {
+        UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_Wins_Race",
+                                   now - connected_attempt_start_time_,
+                                   base::TimeDelta::FromMilliseconds(1),
+                                   base::TimeDelta::FromMinutes(10),
+                                   100);
+      } else {
+        UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_No_Race",
+                                   connect_duration,
+                                   base::TimeDelta::FromMilliseconds(1),
+                                   base::TimeDelta::FromMinutes(10),
+                                   100);
+      }
     } else {
       if (AddressListOnlyContainsIPv6(addresses_)) {
         UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv6_Solo",
@@ -285,85 +327,150 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
       }
     }
     SetSocket(transport_socket_.Pass());
-    fallback_timer_.Stop();
-  } else {
-    // Be a bit paranoid and kill off the fallback members to prevent reuse.
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
   }
 
   return result;
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnect() {
-  // The timer should only fire while we're waiting for the main connect to
-  // succeed.
-  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
-    NOTREACHED();
+void TransportConnectJob::OrderAddresses() {
+  if (!http_server_properties_) {
+    InterleaveAddressFamilies(&addresses_);
     return;
   }
 
-  DCHECK(!fallback_transport_socket_.get());
-  DCHECK(!fallback_addresses_.get());
-
-  fallback_addresses_.reset(new AddressList(addresses_));
-  MakeAddressListStartWithIPv4(fallback_addresses_.get());
-  fallback_transport_socket_ =
-      client_socket_factory_->CreateTransportClientSocket(
-          *fallback_addresses_, net_log().net_log(), net_log().source());
-  fallback_connect_start_time_ = base::TimeTicks::Now();
-  int rv = fallback_transport_socket_->Connect(
-      base::Bind(
-          &TransportConnectJob::DoIPv6FallbackTransportConnectComplete,
-          base::Unretained(this)));
+  const base::TimeTicks now = base::TimeTicks::Now();
+  AddressList ordered;
+  ordered.set_canonical_name(addresses_.canonical_name());
+  AddressList recently_failed;
+  for (AddressList::const_iterator i = addresses_.begin();
+       i != addresses_.end(); ++i) {
+    base::TimeTicks last_failure =
+        http_server_properties_->GetAddressConnectStats(*i).last_failure;
+    if (!last_failure.is_null() &&
+        now - last_failure <
+            base::TimeDelta::FromMinutes(kAddressFailureMemoryInMinutes)) {
+      recently_failed.push_back(*i);
+    } else {
+      ordered.push_back(*i);
+    }
+  }
+  InterleaveAddressFamilies(&ordered);
+  InterleaveAddressFamilies(&recently_failed);
+  ordered.insert(ordered.end(), recently_failed.begin(), recently_failed.end());
+  addresses_ = ordered;
+}
+
+int TransportConnectJob::StartNextAttempts() {
+  attempt_timer_.Stop();
+  while (next_address_index_ < addresses_.size()) {
+    ConnectAttempt* attempt = new ConnectAttempt;
+    attempt->address_index = next_address_index_++;
+    const IPEndPoint& address = addresses_[attempt->address_index];
+    attempt->socket = client_socket_factory_->CreateTransportClientSocket(
+        AddressList(address), net_log().net_log(), net_log().source());
+    attempt->start_time = base::TimeTicks::Now();
+    attempts_.push_back(attempt);
+
+    int rv = attempt->socket->Connect(
+        base::Bind(&TransportConnectJob::OnAttemptComplete,
+                   base::Unretained(this), attempt));
+    if (rv == ERR_IO_PENDING) {
+      if (next_address_index_ < addresses_.size()) {
+        attempt_timer_.Start(FROM_HERE, GetAttemptDelay(address), this,
+                             &TransportConnectJob::OnAttemptTimer);
+      }
+      return ERR_IO_PENDING;
+    }
+    CompleteAttempt(attempt, rv);
+    if (rv == OK)
+      return OK;
+  }
+  return attempts_.empty() ? last_error_ : ERR_IO_PENDING;
+}
+
+base::TimeDelta TransportConnectJob::GetAttemptDelay(
+    const IPEndPoint& address) {
+  const base::TimeDelta default_delay =
+      base::TimeDelta::FromMilliseconds(kConnectAttemptDelayInMs);
+  if (!http_server_properties_)
+    return default_delay;
+  base::TimeDelta rtt =
+      http_server_properties_->GetAddressConnectStats(address).rtt;
+  if (rtt == base::TimeDelta())
+    return default_delay;
+  return std::max(
+      base::TimeDelta::FromMilliseconds(kMinConnectAttemptDelayInMs),
+      std::min(rtt * 2, default_delay));
+}
+
+void TransportConnectJob::OnAttemptComplete(ConnectAttempt* attempt,
+                                            int result) {
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
+  CompleteAttempt(attempt, result);
+  // Rather than waiting for the attempt timer, race the next address right
+  // away against the attempts still in progress.
+  int rv = result == OK ? OK : StartNextAttempts();
   if (rv != ERR_IO_PENDING)
-    DoIPv6FallbackTransportConnectComplete(rv);
+    OnIOComplete(rv);  // Deletes |this| when done.
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
-  // This should only happen when we're waiting for the main connect to succeed.
-  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
-    NOTREACHED();
-    return;
-  }
+void TransportConnectJob::OnAttemptTimer() {
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
+  int rv = StartNextAttempts();
+  if (rv != ERR_IO_PENDING)
+    OnIOComplete(rv);  // Deletes |this| when done.
+}
 
+void TransportConnectJob::CompleteAttempt(ConnectAttempt* attempt,
+                                          int result) {
   DCHECK_NE(ERR_IO_PENDING, result);
-  DCHECK(fallback_transport_socket_.get());
-  DCHECK(fallback_addresses_.get());
+  ScopedVector<ConnectAttempt>::iterator it =
+      std::find(attempts_.begin(), attempts_.end(), attempt);
+  DCHECK(it != attempts_.end());
+  RecordAttemptResult(addresses_[attempt->address_index],
+                      base::TimeTicks::Now() - attempt->start_time,
+                      result == OK);
+
+  if (result != OK) {
+    last_error_ = result;
+    attempts_.erase(it);
+    return;
+  }
 
-  if (result == OK) {
-    DCHECK(!fallback_connect_start_time_.is_null());
-    DCHECK(!connect_timing_.dns_start.is_null());
-    base::TimeTicks now = base::TimeTicks::Now();
-    base::TimeDelta total_duration = now - connect_timing_.dns_start;
-    UMA_HISTOGRAM_CUSTOM_TIMES(
-        "Net.DNS_Resolution_And_TCP_Connection_Latency2",
-        total_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
+  transport_socket_ = attempt->socket.Pass();
+  connected_address_index_ = attempt->address_index;
+  connected_attempt_start_time_ = attempt->start_time;
+  // The attempts which started earlier and are still pending lost despite
+  // their head start, so later connects should try their addresses last.
+  for (ScopedVector<ConnectAttempt>::iterator i = attempts_.begin();
+       i != it; ++i) {
+    RecordAttemptResult(addresses_[(*i)->address_index], base::TimeDelta(),
+                        false);
+  }
+  attempts_.clear();
+  attempt_timer_.Stop();
+}
 
-    base::TimeDelta connect_duration = now - fallback_connect_start_time_;
-    UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency",
-        connect_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
+void TransportConnectJob::RecordAttemptResult(
+    const IPEndPoint& address,
+    base::TimeDelta connect_duration,
+    bool succeeded) {
+  if (!http_server_properties_)
+    return;
 
-    UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_Wins_Race",
-        connect_duration,
-        base::TimeDelta::FromMilliseconds(1),
-        base::TimeDelta::FromMinutes(10),
-        100);
-    SetSocket(fallback_transport_socket_.Pass());
-    next_state_ = STATE_NONE;
-    transport_socket_.reset();
+  AddressConnectStats stats =
+      http_server_properties_->GetAddressConnectStats(address);
+  if (succeeded) {
+    // Smooth the connect times the way TCP smooths its RTT samples.
+    if (stats.rtt == base::TimeDelta())
+      stats.rtt = connect_duration;
+    else
+      stats.rtt = (stats.rtt * 7 + connect_duration) / 8;
+    stats.last_failure = base::TimeTicks();
   } else {
-    // Be a bit paranoid and kill off the fallback members to prevent reuse.
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
+    stats.last_failure = base::TimeTicks::Now();
   }
-  NotifyDelegateOfCompletion(result);  // Deletes |this|
+  http_server_properties_->SetAddressConnectStats(address, stats);
 }
 
 int TransportConnectJob::ConnectInternal() {
@@ -383,6 +490,7 @@ scoped_ptr<ConnectJob>
                               ConnectionTimeout(),
                               client_socket_factory_,
                               host_resolver_,
+                              http_server_properties_,
                               delegate,
                               net_log_));
 }
@@ -400,11 +508,12 @@ TransportClientSocketPool::TransportClientSocketPool(
     HostResolver* host_resolver,
     ClientSocketFactory* client_socket_factory,
     NetLog* net_log)
-    : base_(NULL, max_sockets, max_sockets_per_group, histograms,
+    : connect_job_factory_(new TransportConnectJobFactory(
+          client_socket_factory, host_resolver, net_log)),
+      base_(NULL, max_sockets, max_sockets_per_group, histograms,
             ClientSocketPool::unused_idle_socket_timeout(),
             ClientSocketPool::used_idle_socket_timeout(),
-            new TransportConnectJobFactory(client_socket_factory,
-                                           host_resolver, net_log)) {
+            connect_job_factory_) {
   base_.EnableConnectBackupJobs();
 }
 
@@ -515,4 +624,17 @@ void TransportClientSocketPool::RemoveHigherLayeredPool(
   base_.RemoveHigherLayeredPool(higher_pool);
 }
 
+void TransportClientSocketPool::SetWarmSockets(
+    const std::string& group_name,
+    const scoped_refptr<TransportSocketParams>& params,
+    int num_sockets,
+    base::TimeTicks warm_until) {
+  base_.SetWarmSockets(group_name, params, num_sockets, warm_until);
+}
+
+void TransportClientSocketPool::SetHttpServerProperties(
+    const base::WeakPtr<HttpServerProperties>& http_server_properties) {
+  connect_job_factory_->set_http_server_properties(http_server_properties);
+}
+
 }  // namespace net
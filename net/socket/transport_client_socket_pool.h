@@ -10,11 +10,14 @@
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/single_request_host_resolver.h"
+#include "net/http/http_server_properties.h"
 #include "net/socket/client_socket_pool.h"
 #include "net/socket/client_socket_pool_base.h"
 #include "net/socket/client_socket_pool_histograms.h"
@@ -56,23 +59,33 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 };
 
 // TransportConnectJob handles the host resolution necessary for socket creation
-// and the transport (likely TCP) connect. TransportConnectJob also has fallback
-// logic for IPv6 connect() timeouts (which may happen due to networks / routers
-// with broken IPv6 support). Those timeouts take 20s, so rather than make the
-// user wait 20s for the timeout to fire, we use a fallback timer
-// (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
-// fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
-// a headstart) and return the one that completes first to the socket pool.
+// and the transport (likely TCP) connect.
+//
+// Rather than connecting to the resolved addresses one after the other, which
+// takes a connect() timeout (20s or more) for each address that doesn't
+// answer, TransportConnectJob races them, as described in RFC 6555: it starts
+// a connect() to the first address, and starts one to the next address
+// whenever a connect() fails or has been pending for an attempt delay, until
+// one of them succeeds. The others are then cancelled.
+//
+// The addresses are tried in the order of the resolver, alternating between
+// IPv6 and IPv4, except that addresses which failed recently are tried last.
+// The connect times and failures of the addresses are remembered in the
+// HttpServerProperties, when there are any, and the attempt delay is based
+// on the connect time of the address, with a default of
+// kConnectAttemptDelayInMs.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
-  TransportConnectJob(const std::string& group_name,
-                      RequestPriority priority,
-                      const scoped_refptr<TransportSocketParams>& params,
-                      base::TimeDelta timeout_duration,
-                      ClientSocketFactory* client_socket_factory,
-                      HostResolver* host_resolver,
-                      Delegate* delegate,
-                      NetLog* net_log);
+  TransportConnectJob(
+      const std::string& group_name,
+      RequestPriority priority,
+      const scoped_refptr<TransportSocketParams>& params,
+      base::TimeDelta timeout_duration,
+      ClientSocketFactory* client_socket_factory,
+      HostResolver* host_resolver,
+      const base::WeakPtr<HttpServerProperties>& http_server_properties,
+      Delegate* delegate,
+      NetLog* net_log);
   virtual ~TransportConnectJob();
 
   // ConnectJob methods.
@@ -82,7 +95,13 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
-  static const int kIPv6FallbackTimerInMs;
+  // Reorders |addrlist| so that its address families alternate, starting with
+  // the family of its first address. Addresses of the same family keep their
+  // order.
+  static void InterleaveAddressFamilies(AddressList* addrlist);
+
+  // The attempt delay for addresses whose connect time isn't known.
+  static const int kConnectAttemptDelayInMs;
 
  private:
   enum State {
@@ -93,6 +112,16 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
     STATE_NONE,
   };
 
+  // A connect() to one of |addresses_|.
+  struct ConnectAttempt {
+    ConnectAttempt();
+    ~ConnectAttempt();
+
+    size_t address_index;
+    scoped_ptr<StreamSocket> socket;
+    base::TimeTicks start_time;
+  };
+
   void OnIOComplete(int result);
 
   // Runs the state transition loop.
@@ -104,8 +133,33 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   int DoTransportConnectComplete(int result);
 
   // Not part of the state machine.
-  void DoIPv6FallbackTransportConnect();
-  void DoIPv6FallbackTransportConnectComplete(int result);
+
+  // Moves the addresses which failed recently to the end of |addresses_|, and
+  // interleaves the address families of the others.
+  void OrderAddresses();
+
+  // Starts connect attempts to the next addresses until one is pending with
+  // the attempt timer running, or there are no addresses left. Returns OK if
+  // an attempt succeeded, ERR_IO_PENDING if some are in progress, and the
+  // error of the last attempt otherwise.
+  int StartNextAttempts();
+
+  // Returns how long to wait for a connect to |address| before racing the
+  // next address against it.
+  base::TimeDelta GetAttemptDelay(const IPEndPoint& address);
+
+  void OnAttemptComplete(ConnectAttempt* attempt, int result);
+  void OnAttemptTimer();
+
+  // Records the result of |attempt|, and removes it from |attempts_|. If it
+  // succeeded, takes its socket and cancels the other attempts.
+  void CompleteAttempt(ConnectAttempt* attempt, int result);
+
+  // Saves the connect time or the failure of |address| in the
+  // HttpServerProperties.
+  void RecordAttemptResult(const IPEndPoint& address,
+                           base::TimeDelta connect_duration,
+                           bool succeeded);
 
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
@@ -115,15 +169,24 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   scoped_refptr<TransportSocketParams> params_;
   ClientSocketFactory* const client_socket_factory_;
   SingleRequestHostResolver resolver_;
+  base::WeakPtr<HttpServerProperties> http_server_properties_;
   AddressList addresses_;
   State next_state_;
 
+  // The attempts in progress, oldest first.
+  ScopedVector<ConnectAttempt> attempts_;
+  // The index in |addresses_| of the next address to try.
+  size_t next_address_index_;
+  // Started when an attempt is pending, to race the next address against it.
+  base::OneShotTimer<TransportConnectJob> attempt_timer_;
+  // The error of the last attempt which failed.
+  int last_error_;
+
+  // The socket which connected, the index of its address in |addresses_| and
+  // when its attempt started.
   scoped_ptr<StreamSocket> transport_socket_;
-
-  scoped_ptr<StreamSocket> fallback_transport_socket_;
-  scoped_ptr<AddressList> fallback_addresses_;
-  base::TimeTicks fallback_connect_start_time_;
-  base::OneShotTimer<TransportConnectJob> fallback_timer_;
+  size_t connected_address_index_;
+  base::TimeTicks connected_attempt_start_time_;
 
   // If the interval between this connect and previous connect is less than
   // 20ms, then |less_than_20ms_since_connect_| is set to true.
@@ -182,6 +245,18 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
   virtual void AddHigherLayeredPool(HigherLayeredPool* higher_pool) OVERRIDE;
   virtual void RemoveHigherLayeredPool(HigherLayeredPool* higher_pool) OVERRIDE;
 
+  // Keeps at least |num_sockets| sockets of |group_name| open or connecting
+  // until |warm_until|. See ClientSocketPoolBaseHelper::SetWarmSockets().
+  void SetWarmSockets(const std::string& group_name,
+                      const scoped_refptr<TransportSocketParams>& params,
+                      int num_sockets,
+                      base::TimeTicks warm_until);
+
+  // Sets the HttpServerProperties in which the connect jobs remember the
+  // connect times and failures of addresses.
+  void SetHttpServerProperties(
+      const base::WeakPtr<HttpServerProperties>& http_server_properties);
+
  private:
   typedef ClientSocketPoolBase<TransportSocketParams> PoolBase;
 
@@ -206,14 +281,22 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
 
     virtual base::TimeDelta ConnectionTimeout() const OVERRIDE;
 
+    void set_http_server_properties(
+        const base::WeakPtr<HttpServerProperties>& http_server_properties) {
+      http_server_properties_ = http_server_properties;
+    }
+
    private:
     ClientSocketFactory* const client_socket_factory_;
     HostResolver* const host_resolver_;
+    base::WeakPtr<HttpServerProperties> http_server_properties_;
     NetLog* net_log_;
 
     DISALLOW_COPY_AND_ASSIGN(TransportConnectJobFactory);
   };
 
+  // Owned by |base_|.
+  TransportConnectJobFactory* const connect_job_factory_;
   PoolBase base_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportClientSocketPool);
@@ -4,6 +4,10 @@
 
 #include "net/socket/transport_client_socket_pool.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/callback.h"
@@ -11,6 +15,7 @@
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 #include "base/threading/platform_thread.h"
+#include "base/time/time.h"
 #include "net/base/capturing_net_log.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/load_timing_info.h"
@@ -19,6 +24,7 @@
 #include "net/base/net_util.h"
 #include "net/base/test_completion_callback.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/http/http_server_properties_impl.h"
 #include "net/socket/client_socket_factory.h"
 #include "net/socket/client_socket_handle.h"
 #include "net/socket/client_socket_pool_histograms.h"
@@ -72,6 +78,12 @@ void TestLoadTimingInfoConnectedNotReused(const ClientSocketHandle& handle) {
   TestLoadTimingInfoConnectedReused(handle);
 }
 
+IPEndPoint ParseAddress(const std::string& ip_literal) {
+  IPAddressNumber number;
+  CHECK(ParseIPLiteralToNumber(ip_literal, &number));
+  return IPEndPoint(number, 80);
+}
+
 void SetIPv4Address(IPEndPoint* address) {
   IPAddressNumber number;
   CHECK(ParseIPLiteralToNumber("1.1.1.1", &number));
@@ -107,7 +119,10 @@ class MockClientSocket : public StreamSocket {
     return connected_;
   }
   virtual int GetPeerAddress(IPEndPoint* address) const OVERRIDE {
-    return ERR_UNEXPECTED;
+    if (!connected_)
+      return ERR_SOCKET_NOT_CONNECTED;
+    *address = addrlist_.front();
+    return OK;
   }
   virtual int GetLocalAddress(IPEndPoint* address) const OVERRIDE {
     if (!connected_)
@@ -260,7 +275,10 @@ class MockPendingClientSocket : public StreamSocket {
     return is_connected_;
   }
   virtual int GetPeerAddress(IPEndPoint* address) const OVERRIDE {
-    return ERR_UNEXPECTED;
+    if (!is_connected_)
+      return ERR_SOCKET_NOT_CONNECTED;
+    *address = addrlist_.front();
+    return OK;
   }
   virtual int GetLocalAddress(IPEndPoint* address) const OVERRIDE {
     if (!is_connected_)
@@ -364,8 +382,14 @@ class MockClientSocketFactory : public ClientSocketFactory {
     allocation_count_++;
 
     ClientSocketType type = client_socket_type_;
-    if (client_socket_types_ &&
-        client_socket_index_ < client_socket_index_max_) {
+    base::TimeDelta delay = delay_;
+    AddressSocketTypeMap::const_iterator it =
+        address_socket_types_.find(addresses.front());
+    if (it != address_socket_types_.end()) {
+      type = it->second.first;
+      delay = it->second.second;
+    } else if (client_socket_types_ &&
+               client_socket_index_ < client_socket_index_max_) {
       type = client_socket_types_[client_socket_index_++];
     }
 
@@ -387,7 +411,7 @@ class MockClientSocketFactory : public ClientSocketFactory {
       case MOCK_DELAYED_CLIENT_SOCKET:
         return scoped_ptr<StreamSocket>(
             new MockPendingClientSocket(
-                addresses, true, false, delay_, net_log_));
+                addresses, true, false, delay, net_log_));
       case MOCK_STALLED_CLIENT_SOCKET:
         return scoped_ptr<StreamSocket>(
             new MockPendingClientSocket(
@@ -429,7 +453,18 @@ class MockClientSocketFactory : public ClientSocketFactory {
 
   void set_delay(base::TimeDelta delay) { delay_ = delay; }
 
+  // Sets the ClientSocketType of the sockets connecting to |address|, and the
+  // delay of delayed ones. These take precedence over the other types.
+  void SetAddressSocketType(const IPEndPoint& address,
+                            ClientSocketType type,
+                            base::TimeDelta delay) {
+    address_socket_types_[address] = std::make_pair(type, delay);
+  }
+
  private:
+  typedef std::map<IPEndPoint, std::pair<ClientSocketType, base::TimeDelta> >
+      AddressSocketTypeMap;
+
   NetLog* net_log_;
   int allocation_count_;
   ClientSocketType client_socket_type_;
@@ -437,6 +472,7 @@ class MockClientSocketFactory : public ClientSocketFactory {
   int client_socket_index_;
   int client_socket_index_max_;
   base::TimeDelta delay_;
+  AddressSocketTypeMap address_socket_types_;
 
   DISALLOW_COPY_AND_ASSIGN(MockClientSocketFactory);
 };
@@ -572,6 +608,53 @@ TEST(TransportConnectJobTest, MakeAddrListStartWithIPv4) {
   EXPECT_EQ(ADDRESS_FAMILY_IPV6, addrlist[3].GetFamily());
 }
 
+TEST(TransportConnectJobTest, InterleaveAddressFamilies) {
+  const IPEndPoint v4_1 = ParseAddress("192.168.1.1");
+  const IPEndPoint v4_2 = ParseAddress("192.168.1.2");
+  const IPEndPoint v6_1 = ParseAddress("2001:4860:b006::64");
+  const IPEndPoint v6_2 = ParseAddress("2001:4860:b006::66");
+  const IPEndPoint v6_3 = ParseAddress("2001:4860:b006::68");
+
+  AddressList addrlist;
+
+  // IPv4 only.  Expect no change.
+  addrlist.push_back(v4_1);
+  addrlist.push_back(v4_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(2u, addrlist.size());
+  EXPECT_TRUE(v4_1 == addrlist[0]);
+  EXPECT_TRUE(v4_2 == addrlist[1]);
+
+  // IPv6, IPv6, IPv6, IPv4, IPv4.  Expect the families to alternate, starting
+  // with IPv6, and the remaining IPv6 address last.
+  addrlist.clear();
+  addrlist.push_back(v6_1);
+  addrlist.push_back(v6_2);
+  addrlist.push_back(v6_3);
+  addrlist.push_back(v4_1);
+  addrlist.push_back(v4_2);
+  addrlist.set_canonical_name("canonical.example.com");
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(5u, addrlist.size());
+  EXPECT_TRUE(v6_1 == addrlist[0]);
+  EXPECT_TRUE(v4_1 == addrlist[1]);
+  EXPECT_TRUE(v6_2 == addrlist[2]);
+  EXPECT_TRUE(v4_2 == addrlist[3]);
+  EXPECT_TRUE(v6_3 == addrlist[4]);
+  EXPECT_EQ("canonical.example.com", addrlist.canonical_name());
+
+  // IPv4, IPv6, IPv6.  Expect IPv4 to stay first.
+  addrlist.clear();
+  addrlist.push_back(v4_1);
+  addrlist.push_back(v6_1);
+  addrlist.push_back(v6_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(3u, addrlist.size());
+  EXPECT_TRUE(v4_1 == addrlist[0]);
+  EXPECT_TRUE(v6_1 == addrlist[1]);
+  EXPECT_TRUE(v6_2 == addrlist[2]);
+}
+
 TEST_F(TransportClientSocketPoolTest, Basic) {
   TestCompletionCallback callback;
   ClientSocketHandle handle;
@@ -1280,7 +1363,7 @@ TEST_F(TransportClientSocketPoolTest, IPv6FallbackSocketIPv6FinishesFirst) {
 
   client_socket_factory_.set_client_socket_types(case_types, 2);
   client_socket_factory_.set_delay(base::TimeDelta::FromMilliseconds(
-      TransportConnectJob::kIPv6FallbackTimerInMs + 50));
+      TransportConnectJob::kConnectAttemptDelayInMs + 50));
 
   // Resolve an AddressList with a IPv6 address first and then a IPv4 address.
   host_resolver_->rules()
@@ -1370,6 +1453,210 @@ TEST_F(TransportClientSocketPoolTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// Connects to lists of addresses which fail, stall, or connect after a delay,
+// and checks which address wins, how many connects were started, and how long
+// it took. The connect to each address starts when the previous one fails or
+// has been pending for kConnectAttemptDelayInMs.
+TEST_F(TransportClientSocketPoolTest, ConnectRaceLatency) {
+  // Create pools without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+
+  const MockClientSocketFactory::ClientSocketType kFailing =
+      MockClientSocketFactory::MOCK_FAILING_CLIENT_SOCKET;
+  const MockClientSocketFactory::ClientSocketType kPendingFailing =
+      MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET;
+  const MockClientSocketFactory::ClientSocketType kDelayed =
+      MockClientSocketFactory::MOCK_DELAYED_CLIENT_SOCKET;
+  const MockClientSocketFactory::ClientSocketType kStalled =
+      MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET;
+  const int kAttemptDelayMs = TransportConnectJob::kConnectAttemptDelayInMs;
+
+  struct Address {
+    const char* ip_literal;
+    MockClientSocketFactory::ClientSocketType type;
+    int delay_ms;
+  };
+  const struct {
+    // The resolved addresses, in order, up to the first NULL |ip_literal|.
+    Address addresses[3];
+    int expected_result;
+    const char* expected_address;
+    int expected_allocations;
+    int expected_latency_ms;
+  } kCases[] = {
+    // A dead IPv4 address is skipped without waiting.
+    { { { "1.1.1.1", kPendingFailing, 0 }, { "2.2.2.2", kDelayed, 10 } },
+      OK, "2.2.2.2", 2, 10 },
+    { { { "1.1.1.1", kFailing, 0 }, { "2.2.2.2", kDelayed, 10 } },
+      OK, "2.2.2.2", 2, 10 },
+    // Stalled IPv4 addresses each delay the connect by one attempt delay.
+    { { { "1.1.1.1", kStalled, 0 }, { "2.2.2.2", kStalled, 0 },
+        { "3.3.3.3", kDelayed, 10 } },
+      OK, "3.3.3.3", 3, 2 * kAttemptDelayMs + 10 },
+    // Broken IPv6.
+    { { { "2:abcd::3:4:ff", kStalled, 0 }, { "2.2.2.2", kDelayed, 10 } },
+      OK, "2.2.2.2", 2, kAttemptDelayMs + 10 },
+    // Working IPv6.
+    { { { "2:abcd::3:4:ff", kDelayed, 10 }, { "2.2.2.2", kStalled, 0 } },
+      OK, "2:abcd::3:4:ff", 1, 10 },
+    // The IPv4 address is tried before the second IPv6 address.
+    { { { "2:abcd::3:4:ff", kStalled, 0 }, { "3:abcd::3:4:ff", kDelayed, 10 },
+        { "2.2.2.2", kDelayed, 10 } },
+      OK, "2.2.2.2", 2, kAttemptDelayMs + 10 },
+    // All the addresses fail.
+    { { { "1.1.1.1", kFailing, 0 }, { "2:abcd::3:4:ff", kPendingFailing, 0 } },
+      ERR_CONNECTION_FAILED, NULL, 2, 0 },
+  };
+
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(kCases); ++i) {
+    SCOPED_TRACE(i);
+    MockHostResolver host_resolver;
+    MockClientSocketFactory client_socket_factory(&net_log_);
+    std::string ip_literals;
+    for (size_t j = 0; j < ARRAYSIZE_UNSAFE(kCases[i].addresses) &&
+                       kCases[i].addresses[j].ip_literal; ++j) {
+      const Address& address = kCases[i].addresses[j];
+      if (!ip_literals.empty())
+        ip_literals += ",";
+      ip_literals += address.ip_literal;
+      client_socket_factory.SetAddressSocketType(
+          ParseAddress(address.ip_literal), address.type,
+          base::TimeDelta::FromMilliseconds(address.delay_ms));
+    }
+    host_resolver.rules()->AddIPLiteralRule("*", ip_literals, std::string());
+    TransportClientSocketPool pool(kMaxSockets,
+                                   kMaxSocketsPerGroup,
+                                   histograms_.get(),
+                                   &host_resolver,
+                                   &client_socket_factory,
+                                   NULL);
+
+    TestCompletionCallback callback;
+    ClientSocketHandle handle;
+    const base::TimeTicks start_time = base::TimeTicks::Now();
+    int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                         BoundNetLog());
+    EXPECT_EQ(ERR_IO_PENDING, rv);
+    EXPECT_EQ(kCases[i].expected_result, callback.WaitForResult());
+    const base::TimeDelta latency = base::TimeTicks::Now() - start_time;
+
+    // The connect waits for the expected attempt delays, but no more.
+    EXPECT_LE(kCases[i].expected_latency_ms, latency.InMilliseconds());
+    EXPECT_GT(kCases[i].expected_latency_ms + kAttemptDelayMs,
+              latency.InMilliseconds());
+    EXPECT_EQ(kCases[i].expected_allocations,
+              client_socket_factory.allocation_count());
+    if (kCases[i].expected_address) {
+      ASSERT_TRUE(handle.socket());
+      IPEndPoint endpoint;
+      ASSERT_EQ(OK, handle.socket()->GetPeerAddress(&endpoint));
+      EXPECT_EQ(ParseAddress(kCases[i].expected_address).ToString(),
+                endpoint.ToString());
+    }
+  }
+}
+
+// Test that the addresses which lost a race are remembered, and tried after
+// the others by the next connect.
+TEST_F(TransportClientSocketPoolTest, RemembersSlowAddresses) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  HttpServerPropertiesImpl http_server_properties;
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+  pool.SetHttpServerProperties(http_server_properties.GetWeakPtr());
+
+  const IPEndPoint ipv6_address = ParseAddress("2:abcd::3:4:ff");
+  const IPEndPoint ipv4_address = ParseAddress("2.2.2.2");
+  client_socket_factory_.SetAddressSocketType(
+      ipv6_address, MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+      base::TimeDelta());
+  client_socket_factory_.SetAddressSocketType(
+      ipv4_address, MockClientSocketFactory::MOCK_DELAYED_CLIENT_SOCKET,
+      base::TimeDelta::FromMilliseconds(10));
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+
+  AddressConnectStats stats =
+      http_server_properties.GetAddressConnectStats(ipv4_address);
+  EXPECT_LE(10, stats.rtt.InMilliseconds());
+  EXPECT_TRUE(stats.last_failure.is_null());
+  stats = http_server_properties.GetAddressConnectStats(ipv6_address);
+  EXPECT_FALSE(stats.last_failure.is_null());
+
+  // The IPv4 address is tried first now, so the connect doesn't wait for the
+  // IPv6 one.
+  TestCompletionCallback callback2;
+  ClientSocketHandle handle2;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  rv = handle2.Init("b", params_, LOW, callback2.callback(), &pool,
+                    BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, callback2.WaitForResult());
+  EXPECT_GT(TransportConnectJob::kConnectAttemptDelayInMs,
+            (base::TimeTicks::Now() - start_time).InMilliseconds());
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+  IPEndPoint endpoint;
+  ASSERT_EQ(OK, handle2.socket()->GetPeerAddress(&endpoint));
+  EXPECT_TRUE(ipv4_address == endpoint);
+}
+
+// Test that the next address is raced sooner against an address which is
+// known to connect fast.
+TEST_F(TransportClientSocketPoolTest, AttemptDelayFollowsConnectTimes) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  HttpServerPropertiesImpl http_server_properties;
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+  pool.SetHttpServerProperties(http_server_properties.GetWeakPtr());
+
+  const IPEndPoint ipv6_address = ParseAddress("2:abcd::3:4:ff");
+  const IPEndPoint ipv4_address = ParseAddress("2.2.2.2");
+  AddressConnectStats stats;
+  stats.rtt = base::TimeDelta::FromMilliseconds(20);
+  http_server_properties.SetAddressConnectStats(ipv6_address, stats);
+
+  client_socket_factory_.SetAddressSocketType(
+      ipv6_address, MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+      base::TimeDelta());
+  client_socket_factory_.SetAddressSocketType(
+      ipv4_address, MockClientSocketFactory::MOCK_DELAYED_CLIENT_SOCKET,
+      base::TimeDelta::FromMilliseconds(10));
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_GT(TransportConnectJob::kConnectAttemptDelayInMs,
+            (base::TimeTicks::Now() - start_time).InMilliseconds());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+  IPEndPoint endpoint;
+  ASSERT_EQ(OK, handle.socket()->GetPeerAddress(&endpoint));
+  EXPECT_TRUE(ipv4_address == endpoint);
+}
+
 }  // namespace
 
 }  // namespace net
@@ -54,6 +54,11 @@ void BufferedSpdyFramer::set_debug_visitor(
   spdy_framer_.set_debug_visitor(debug_visitor);
 }
 
+void BufferedSpdyFramer::set_header_compression(
+    SpdyFramer::HeaderCompression header_compression) {
+  spdy_framer_.set_header_compression(header_compression);
+}
+
 void BufferedSpdyFramer::OnError(SpdyFramer* spdy_framer) {
   DCHECK(spdy_framer);
   visitor_->OnError(spdy_framer->error_code());
@@ -309,6 +314,16 @@ SpdyFrame* BufferedSpdyFramer::CreateDataFrame(SpdyStreamId stream_id,
   return spdy_framer_.CreateDataFrame(stream_id, data, len, flags);
 }
 
+SpdyFrame* BufferedSpdyFramer::CreateDataFrameHeader(SpdyStreamId stream_id,
+                                                     const char* data,
+                                                     uint32 len,
+                                                     SpdyDataFlags flags) {
+  SpdyDataIR data_ir(stream_id);
+  data_ir.SetDataShallow(base::StringPiece(data, len));
+  data_ir.set_fin((flags & DATA_FLAG_FIN) != 0);
+  return spdy_framer_.SerializeDataFrameHeader(data_ir);
+}
+
 SpdyPriority BufferedSpdyFramer::GetHighestPriority() const {
   return spdy_framer_.GetHighestPriority();
 }
@@ -117,6 +117,10 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
   // If this is called multiple times, only the last visitor will be used.
   void set_debug_visitor(SpdyFramerDebugVisitorInterface* debug_visitor);
 
+  // Selects how header blocks are compressed. See
+  // SpdyFramer::set_header_compression().
+  void set_header_compression(SpdyFramer::HeaderCompression header_compression);
+
   // SpdyFramerVisitorInterface
   virtual void OnError(SpdyFramer* spdy_framer) OVERRIDE;
   virtual void OnSynStream(SpdyStreamId stream_id,
@@ -189,6 +193,12 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
                              const char* data,
                              uint32 len,
                              SpdyDataFlags flags);
+  // Like CreateDataFrame(), but the returned frame holds only the
+  // frame header. The caller writes the |len| bytes of |data| after it.
+  SpdyFrame* CreateDataFrameHeader(SpdyStreamId stream_id,
+                                   const char* data,
+                                   uint32 len,
+                                   SpdyDataFlags flags);
 
   // Serialize a frame of unknown type.
   SpdySerializedFrame* SerializeFrame(const SpdyFrameIR& frame) {
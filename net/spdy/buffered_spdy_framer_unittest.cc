@@ -235,6 +235,39 @@ TEST_P(BufferedSpdyFramerTest, ReadSynStreamHeaderBlock) {
   EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
 }
 
+TEST_P(BufferedSpdyFramerTest, ReadHpackSynStreamHeaderBlocks) {
+  SpdyHeaderBlock headers;
+  headers["aa"] = "vv";
+  headers["bb"] = "ww";
+  BufferedSpdyFramer framer(spdy_version(), true);
+  framer.set_header_compression(SpdyFramer::HPACK_HEADER_COMPRESSION);
+  TestBufferedSpdyVisitor visitor(spdy_version());
+  visitor.buffered_spdy_framer_.set_header_compression(
+      SpdyFramer::HPACK_HEADER_COMPRESSION);
+
+  // The second block is encoded against the header table state the first
+  // one left on both ends.
+  for (SpdyStreamId stream_id = 1; stream_id <= 3; stream_id += 2) {
+    scoped_ptr<SpdyFrame> control_frame(
+        framer.CreateSynStream(stream_id,
+                               0,                      // associated_stream_id
+                               1,                      // priority
+                               0,                      // credential_slot
+                               CONTROL_FLAG_NONE,
+                               true,                   // compress
+                               &headers));
+    EXPECT_TRUE(control_frame.get() != NULL);
+
+    visitor.SimulateInFramer(
+        reinterpret_cast<unsigned char*>(control_frame.get()->data()),
+        control_frame.get()->size());
+    EXPECT_EQ(0, visitor.error_count_);
+    EXPECT_EQ(stream_id, visitor.header_stream_id_);
+    EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+  }
+  EXPECT_EQ(2, visitor.syn_frame_count_);
+}
+
 TEST_P(BufferedSpdyFramerTest, ReadSynReplyHeaderBlock) {
   SpdyHeaderBlock headers;
   headers["alpha"] = "beta";
@@ -281,4 +314,19 @@ TEST_P(BufferedSpdyFramerTest, ReadHeadersHeaderBlock) {
   EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
 }
 
+TEST_P(BufferedSpdyFramerTest, CreateDataFrameHeader) {
+  const char kData[] = "hello";
+  BufferedSpdyFramer framer(spdy_version(), true);
+  scoped_ptr<SpdyFrame> data_frame(
+      framer.CreateDataFrame(1, kData, 5, DATA_FLAG_FIN));
+  scoped_ptr<SpdyFrame> frame_header(
+      framer.CreateDataFrameHeader(1, kData, 5, DATA_FLAG_FIN));
+  ASSERT_EQ(framer.GetDataFrameMinimumSize(), frame_header->size());
+
+  // The header followed by the payload is the whole frame.
+  std::string frame(frame_header->data(), frame_header->size());
+  frame.append(kData, 5);
+  EXPECT_EQ(std::string(data_frame->data(), data_frame->size()), frame);
+}
+
 }  // namespace net
@@ -0,0 +1,358 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_constants.h"
+
+#include "base/basictypes.h"
+
+namespace net {
+
+namespace {
+
+const HpackHuffmanSymbol kHpackHuffmanCode[] = {
+  { 0x1ff8u, 13 },     // 0
+  { 0x7fffd8u, 23 },   // 1
+  { 0xfffffe2u, 28 },  // 2
+  { 0xfffffe3u, 28 },  // 3
+  { 0xfffffe4u, 28 },  // 4
+  { 0xfffffe5u, 28 },  // 5
+  { 0xfffffe6u, 28 },  // 6
+  { 0xfffffe7u, 28 },  // 7
+  { 0xfffffe8u, 28 },  // 8
+  { 0xffffeau, 24 },   // 9
+  { 0x3ffffffcu, 30 },  // 10
+  { 0xfffffe9u, 28 },  // 11
+  { 0xfffffeau, 28 },  // 12
+  { 0x3ffffffdu, 30 },  // 13
+  { 0xfffffebu, 28 },  // 14
+  { 0xfffffecu, 28 },  // 15
+  { 0xfffffedu, 28 },  // 16
+  { 0xfffffeeu, 28 },  // 17
+  { 0xfffffefu, 28 },  // 18
+  { 0xffffff0u, 28 },  // 19
+  { 0xffffff1u, 28 },  // 20
+  { 0xffffff2u, 28 },  // 21
+  { 0x3ffffffeu, 30 },  // 22
+  { 0xffffff3u, 28 },  // 23
+  { 0xffffff4u, 28 },  // 24
+  { 0xffffff5u, 28 },  // 25
+  { 0xffffff6u, 28 },  // 26
+  { 0xffffff7u, 28 },  // 27
+  { 0xffffff8u, 28 },  // 28
+  { 0xffffff9u, 28 },  // 29
+  { 0xffffffau, 28 },  // 30
+  { 0xffffffbu, 28 },  // 31
+  { 0x14u, 6 },        // ' '
+  { 0x3f8u, 10 },      // '!'
+  { 0x3f9u, 10 },      // '"'
+  { 0xffau, 12 },      // '#'
+  { 0x1ff9u, 13 },     // '$'
+  { 0x15u, 6 },        // '%'
+  { 0xf8u, 8 },        // '&'
+  { 0x7fau, 11 },      // '\''
+  { 0x3fau, 10 },      // '('
+  { 0x3fbu, 10 },      // ')'
+  { 0xf9u, 8 },        // '*'
+  { 0x7fbu, 11 },      // '+'
+  { 0xfau, 8 },        // ','
+  { 0x16u, 6 },        // '-'
+  { 0x17u, 6 },        // '.'
+  { 0x18u, 6 },        // '/'
+  { 0x0u, 5 },         // '0'
+  { 0x1u, 5 },         // '1'
+  { 0x2u, 5 },         // '2'
+  { 0x19u, 6 },        // '3'
+  { 0x1au, 6 },        // '4'
+  { 0x1bu, 6 },        // '5'
+  { 0x1cu, 6 },        // '6'
+  { 0x1du, 6 },        // '7'
+  { 0x1eu, 6 },        // '8'
+  { 0x1fu, 6 },        // '9'
+  { 0x5cu, 7 },        // ':'
+  { 0xfbu, 8 },        // ';'
+  { 0x7ffcu, 15 },     // '<'
+  { 0x20u, 6 },        // '='
+  { 0xffbu, 12 },      // '>'
+  { 0x3fcu, 10 },      // '?'
+  { 0x1ffau, 13 },     // '@'
+  { 0x21u, 6 },        // 'A'
+  { 0x5du, 7 },        // 'B'
+  { 0x5eu, 7 },        // 'C'
+  { 0x5fu, 7 },        // 'D'
+  { 0x60u, 7 },        // 'E'
+  { 0x61u, 7 },        // 'F'
+  { 0x62u, 7 },        // 'G'
+  { 0x63u, 7 },        // 'H'
+  { 0x64u, 7 },        // 'I'
+  { 0x65u, 7 },        // 'J'
+  { 0x66u, 7 },        // 'K'
+  { 0x67u, 7 },        // 'L'
+  { 0x68u, 7 },        // 'M'
+  { 0x69u, 7 },        // 'N'
+  { 0x6au, 7 },        // 'O'
+  { 0x6bu, 7 },        // 'P'
+  { 0x6cu, 7 },        // 'Q'
+  { 0x6du, 7 },        // 'R'
+  { 0x6eu, 7 },        // 'S'
+  { 0x6fu, 7 },        // 'T'
+  { 0x70u, 7 },        // 'U'
+  { 0x71u, 7 },        // 'V'
+  { 0x72u, 7 },        // 'W'
+  { 0xfcu, 8 },        // 'X'
+  { 0x73u, 7 },        // 'Y'
+  { 0xfdu, 8 },        // 'Z'
+  { 0x1ffbu, 13 },     // '['
+  { 0x7fff0u, 19 },    // '\\'
+  { 0x1ffcu, 13 },     // ']'
+  { 0x3ffcu, 14 },     // '^'
+  { 0x22u, 6 },        // '_'
+  { 0x7ffdu, 15 },     // '`'
+  { 0x3u, 5 },         // 'a'
+  { 0x23u, 6 },        // 'b'
+  { 0x4u, 5 },         // 'c'
+  { 0x24u, 6 },        // 'd'
+  { 0x5u, 5 },         // 'e'
+  { 0x25u, 6 },        // 'f'
+  { 0x26u, 6 },        // 'g'
+  { 0x27u, 6 },        // 'h'
+  { 0x6u, 5 },         // 'i'
+  { 0x74u, 7 },        // 'j'
+  { 0x75u, 7 },        // 'k'
+  { 0x28u, 6 },        // 'l'
+  { 0x29u, 6 },        // 'm'
+  { 0x2au, 6 },        // 'n'
+  { 0x7u, 5 },         // 'o'
+  { 0x2bu, 6 },        // 'p'
+  { 0x76u, 7 },        // 'q'
+  { 0x2cu, 6 },        // 'r'
+  { 0x8u, 5 },         // 's'
+  { 0x9u, 5 },         // 't'
+  { 0x2du, 6 },        // 'u'
+  { 0x77u, 7 },        // 'v'
+  { 0x78u, 7 },        // 'w'
+  { 0x79u, 7 },        // 'x'
+  { 0x7au, 7 },        // 'y'
+  { 0x7bu, 7 },        // 'z'
+  { 0x7ffeu, 15 },     // '{'
+  { 0x7fcu, 11 },      // '|'
+  { 0x3ffdu, 14 },     // '}'
+  { 0x1ffdu, 13 },     // '~'
+  { 0xffffffcu, 28 },  // 127
+  { 0xfffe6u, 20 },    // 128
+  { 0x3fffd2u, 22 },   // 129
+  { 0xfffe7u, 20 },    // 130
+  { 0xfffe8u, 20 },    // 131
+  { 0x3fffd3u, 22 },   // 132
+  { 0x3fffd4u, 22 },   // 133
+  { 0x3fffd5u, 22 },   // 134
+  { 0x7fffd9u, 23 },   // 135
+  { 0x3fffd6u, 22 },   // 136
+  { 0x7fffdau, 23 },   // 137
+  { 0x7fffdbu, 23 },   // 138
+  { 0x7fffdcu, 23 },   // 139
+  { 0x7fffddu, 23 },   // 140
+  { 0x7fffdeu, 23 },   // 141
+  { 0xffffebu, 24 },   // 142
+  { 0x7fffdfu, 23 },   // 143
+  { 0xffffecu, 24 },   // 144
+  { 0xffffedu, 24 },   // 145
+  { 0x3fffd7u, 22 },   // 146
+  { 0x7fffe0u, 23 },   // 147
+  { 0xffffeeu, 24 },   // 148
+  { 0x7fffe1u, 23 },   // 149
+  { 0x7fffe2u, 23 },   // 150
+  { 0x7fffe3u, 23 },   // 151
+  { 0x7fffe4u, 23 },   // 152
+  { 0x1fffdcu, 21 },   // 153
+  { 0x3fffd8u, 22 },   // 154
+  { 0x7fffe5u, 23 },   // 155
+  { 0x3fffd9u, 22 },   // 156
+  { 0x7fffe6u, 23 },   // 157
+  { 0x7fffe7u, 23 },   // 158
+  { 0xffffefu, 24 },   // 159
+  { 0x3fffdau, 22 },   // 160
+  { 0x1fffddu, 21 },   // 161
+  { 0xfffe9u, 20 },    // 162
+  { 0x3fffdbu, 22 },   // 163
+  { 0x3fffdcu, 22 },   // 164
+  { 0x7fffe8u, 23 },   // 165
+  { 0x7fffe9u, 23 },   // 166
+  { 0x1fffdeu, 21 },   // 167
+  { 0x7fffeau, 23 },   // 168
+  { 0x3fffddu, 22 },   // 169
+  { 0x3fffdeu, 22 },   // 170
+  { 0xfffff0u, 24 },   // 171
+  { 0x1fffdfu, 21 },   // 172
+  { 0x3fffdfu, 22 },   // 173
+  { 0x7fffebu, 23 },   // 174
+  { 0x7fffecu, 23 },   // 175
+  { 0x1fffe0u, 21 },   // 176
+  { 0x1fffe1u, 21 },   // 177
+  { 0x3fffe0u, 22 },   // 178
+  { 0x1fffe2u, 21 },   // 179
+  { 0x7fffedu, 23 },   // 180
+  { 0x3fffe1u, 22 },   // 181
+  { 0x7fffeeu, 23 },   // 182
+  { 0x7fffefu, 23 },   // 183
+  { 0xfffeau, 20 },    // 184
+  { 0x3fffe2u, 22 },   // 185
+  { 0x3fffe3u, 22 },   // 186
+  { 0x3fffe4u, 22 },   // 187
+  { 0x7ffff0u, 23 },   // 188
+  { 0x3fffe5u, 22 },   // 189
+  { 0x3fffe6u, 22 },   // 190
+  { 0x7ffff1u, 23 },   // 191
+  { 0x3ffffe0u, 26 },  // 192
+  { 0x3ffffe1u, 26 },  // 193
+  { 0xfffebu, 20 },    // 194
+  { 0x7fff1u, 19 },    // 195
+  { 0x3fffe7u, 22 },   // 196
+  { 0x7ffff2u, 23 },   // 197
+  { 0x3fffe8u, 22 },   // 198
+  { 0x1ffffecu, 25 },  // 199
+  { 0x3ffffe2u, 26 },  // 200
+  { 0x3ffffe3u, 26 },  // 201
+  { 0x3ffffe4u, 26 },  // 202
+  { 0x7ffffdeu, 27 },  // 203
+  { 0x7ffffdfu, 27 },  // 204
+  { 0x3ffffe5u, 26 },  // 205
+  { 0xfffff1u, 24 },   // 206
+  { 0x1ffffedu, 25 },  // 207
+  { 0x7fff2u, 19 },    // 208
+  { 0x1fffe3u, 21 },   // 209
+  { 0x3ffffe6u, 26 },  // 210
+  { 0x7ffffe0u, 27 },  // 211
+  { 0x7ffffe1u, 27 },  // 212
+  { 0x3ffffe7u, 26 },  // 213
+  { 0x7ffffe2u, 27 },  // 214
+  { 0xfffff2u, 24 },   // 215
+  { 0x1fffe4u, 21 },   // 216
+  { 0x1fffe5u, 21 },   // 217
+  { 0x3ffffe8u, 26 },  // 218
+  { 0x3ffffe9u, 26 },  // 219
+  { 0xffffffdu, 28 },  // 220
+  { 0x7ffffe3u, 27 },  // 221
+  { 0x7ffffe4u, 27 },  // 222
+  { 0x7ffffe5u, 27 },  // 223
+  { 0xfffecu, 20 },    // 224
+  { 0xfffff3u, 24 },   // 225
+  { 0xfffedu, 20 },    // 226
+  { 0x1fffe6u, 21 },   // 227
+  { 0x3fffe9u, 22 },   // 228
+  { 0x1fffe7u, 21 },   // 229
+  { 0x1fffe8u, 21 },   // 230
+  { 0x7ffff3u, 23 },   // 231
+  { 0x3fffeau, 22 },   // 232
+  { 0x3fffebu, 22 },   // 233
+  { 0x1ffffeeu, 25 },  // 234
+  { 0x1ffffefu, 25 },  // 235
+  { 0xfffff4u, 24 },   // 236
+  { 0xfffff5u, 24 },   // 237
+  { 0x3ffffeau, 26 },  // 238
+  { 0x7ffff4u, 23 },   // 239
+  { 0x3ffffebu, 26 },  // 240
+  { 0x7ffffe6u, 27 },  // 241
+  { 0x3ffffecu, 26 },  // 242
+  { 0x3ffffedu, 26 },  // 243
+  { 0x7ffffe7u, 27 },  // 244
+  { 0x7ffffe8u, 27 },  // 245
+  { 0x7ffffe9u, 27 },  // 246
+  { 0x7ffffeau, 27 },  // 247
+  { 0x7ffffebu, 27 },  // 248
+  { 0xffffffeu, 28 },  // 249
+  { 0x7ffffecu, 27 },  // 250
+  { 0x7ffffedu, 27 },  // 251
+  { 0x7ffffeeu, 27 },  // 252
+  { 0x7ffffefu, 27 },  // 253
+  { 0x7fffff0u, 27 },  // 254
+  { 0x3ffffeeu, 26 },  // 255
+  { 0x3fffffffu, 30 },  // EOS
+};
+
+COMPILE_ASSERT(arraysize(kHpackHuffmanCode) == kHpackHuffmanSymbolCount,
+               huffman_code_has_one_entry_per_symbol);
+
+#define STATIC_ENTRY(name, value) \
+  { name, arraysize(name) - 1, value, arraysize(value) - 1 }
+
+const HpackStaticEntry kHpackStaticTable[] = {
+  STATIC_ENTRY(":authority", ""),
+  STATIC_ENTRY(":method", "GET"),
+  STATIC_ENTRY(":method", "POST"),
+  STATIC_ENTRY(":path", "/"),
+  STATIC_ENTRY(":path", "/index.html"),
+  STATIC_ENTRY(":scheme", "http"),
+  STATIC_ENTRY(":scheme", "https"),
+  STATIC_ENTRY(":status", "200"),
+  STATIC_ENTRY(":status", "204"),
+  STATIC_ENTRY(":status", "206"),
+  STATIC_ENTRY(":status", "304"),
+  STATIC_ENTRY(":status", "400"),
+  STATIC_ENTRY(":status", "404"),
+  STATIC_ENTRY(":status", "500"),
+  STATIC_ENTRY("accept-charset", ""),
+  STATIC_ENTRY("accept-encoding", "gzip, deflate"),
+  STATIC_ENTRY("accept-language", ""),
+  STATIC_ENTRY("accept-ranges", ""),
+  STATIC_ENTRY("accept", ""),
+  STATIC_ENTRY("access-control-allow-origin", ""),
+  STATIC_ENTRY("age", ""),
+  STATIC_ENTRY("allow", ""),
+  STATIC_ENTRY("authorization", ""),
+  STATIC_ENTRY("cache-control", ""),
+  STATIC_ENTRY("content-disposition", ""),
+  STATIC_ENTRY("content-encoding", ""),
+  STATIC_ENTRY("content-language", ""),
+  STATIC_ENTRY("content-length", ""),
+  STATIC_ENTRY("content-location", ""),
+  STATIC_ENTRY("content-range", ""),
+  STATIC_ENTRY("content-type", ""),
+  STATIC_ENTRY("cookie", ""),
+  STATIC_ENTRY("date", ""),
+  STATIC_ENTRY("etag", ""),
+  STATIC_ENTRY("expect", ""),
+  STATIC_ENTRY("expires", ""),
+  STATIC_ENTRY("from", ""),
+  STATIC_ENTRY("host", ""),
+  STATIC_ENTRY("if-match", ""),
+  STATIC_ENTRY("if-modified-since", ""),
+  STATIC_ENTRY("if-none-match", ""),
+  STATIC_ENTRY("if-range", ""),
+  STATIC_ENTRY("if-unmodified-since", ""),
+  STATIC_ENTRY("last-modified", ""),
+  STATIC_ENTRY("link", ""),
+  STATIC_ENTRY("location", ""),
+  STATIC_ENTRY("max-forwards", ""),
+  STATIC_ENTRY("proxy-authenticate", ""),
+  STATIC_ENTRY("proxy-authorization", ""),
+  STATIC_ENTRY("range", ""),
+  STATIC_ENTRY("referer", ""),
+  STATIC_ENTRY("refresh", ""),
+  STATIC_ENTRY("retry-after", ""),
+  STATIC_ENTRY("server", ""),
+  STATIC_ENTRY("set-cookie", ""),
+  STATIC_ENTRY("strict-transport-security", ""),
+  STATIC_ENTRY("transfer-encoding", ""),
+  STATIC_ENTRY("user-agent", ""),
+  STATIC_ENTRY("vary", ""),
+  STATIC_ENTRY("via", ""),
+  STATIC_ENTRY("www-authenticate", ""),
+};
+
+#undef STATIC_ENTRY
+
+COMPILE_ASSERT(arraysize(kHpackStaticTable) == kHpackStaticTableSize,
+               static_table_size_mismatch);
+
+}  // namespace
+
+const HpackHuffmanSymbol* HpackHuffmanCode() {
+  return kHpackHuffmanCode;
+}
+
+const HpackStaticEntry* HpackStaticTable() {
+  return kHpackStaticTable;
+}
+
+}  // namespace net
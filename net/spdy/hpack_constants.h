@@ -0,0 +1,80 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_CONSTANTS_H_
+#define NET_SPDY_HPACK_CONSTANTS_H_
+
+#include <cstddef>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+
+// Constants of the HPACK header compression format, as defined by the HTTP/2
+// header compression specification (RFC 7541).
+
+namespace net {
+
+// The size of an entry of the header table is the length of its name and
+// value plus this overhead.
+const size_t kHpackEntrySizeOverhead = 32;
+
+// The size limit of the dynamic header table both ends assume until they
+// agree on another one.
+const size_t kHpackDefaultHeaderTableSize = 4096;
+
+// The number of entries of the static table. Dynamic table entries are
+// indexed after them.
+const size_t kHpackStaticTableSize = 61;
+
+// The number of symbols of the Huffman code: every byte value and EOS.
+const size_t kHpackHuffmanSymbolCount = 257;
+const uint16 kHpackHuffmanEosSymbol = 256;
+
+// The bit patterns the first byte of each header field representation starts
+// with, and the number of low bits of that byte which start the integer
+// following the pattern.
+const uint8 kHpackIndexedHeaderField = 0x80;
+const uint8 kHpackIndexedHeaderFieldPrefixBits = 7;
+const uint8 kHpackLiteralWithIncrementalIndexing = 0x40;
+const uint8 kHpackLiteralWithIncrementalIndexingPrefixBits = 6;
+const uint8 kHpackDynamicTableSizeUpdate = 0x20;
+const uint8 kHpackDynamicTableSizeUpdatePrefixBits = 5;
+const uint8 kHpackLiteralNeverIndexed = 0x10;
+const uint8 kHpackLiteralWithoutIndexing = 0x00;
+const uint8 kHpackLiteralWithoutIndexingPrefixBits = 4;
+
+// Cookie headers are split into one header field per cookie, which are
+// joined back with the separator.
+const char kHpackCookieHeader[] = "cookie";
+const char kHpackCookieSeparator[] = "; ";
+
+// Strings are preceded by this flag, when Huffman encoded, and their length.
+const uint8 kHpackHuffmanEncodedString = 0x80;
+const uint8 kHpackStringLengthPrefixBits = 7;
+
+struct HpackHuffmanSymbol {
+  // The code, right-aligned.
+  uint32 code;
+  // The number of bits of the code.
+  uint8 length;
+};
+
+struct HpackStaticEntry {
+  const char* name;
+  size_t name_len;
+  const char* value;
+  size_t value_len;
+};
+
+// Returns the canonical Huffman code of RFC 7541 Appendix B, indexed by
+// symbol.
+NET_EXPORT_PRIVATE const HpackHuffmanSymbol* HpackHuffmanCode();
+
+// Returns the static table of RFC 7541 Appendix A. Entry i of the array has
+// HPACK index i + 1.
+NET_EXPORT_PRIVATE const HpackStaticEntry* HpackStaticTable();
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_CONSTANTS_H_
@@ -0,0 +1,173 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include <utility>
+
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_huffman_table.h"
+
+namespace net {
+
+namespace {
+
+// Integers longer than this are never needed, and would risk overflows.
+const size_t kMaxIntegerContinuationBytes = 4;
+
+void AddHeader(base::StringPiece name,
+               base::StringPiece value,
+               SpdyNameValueBlock* headers) {
+  std::pair<SpdyNameValueBlock::iterator, bool> result =
+      headers->insert(std::make_pair(name.as_string(), std::string()));
+  if (!result.second) {
+    if (name == kHpackCookieHeader)
+      result.first->second.append(kHpackCookieSeparator);
+    else
+      result.first->second.push_back('\0');
+  }
+  value.AppendToString(&result.first->second);
+}
+
+}  // namespace
+
+HpackDecoder::HpackDecoder()
+    : max_table_size_limit_(kHpackDefaultHeaderTableSize) {
+}
+
+HpackDecoder::~HpackDecoder() {}
+
+bool HpackDecoder::DecodeHeaderBlock(base::StringPiece block,
+                                     SpdyNameValueBlock* headers) {
+  bool header_field_seen = false;
+  while (!block.empty()) {
+    const uint8 first_byte = static_cast<uint8>(block[0]);
+
+    if ((first_byte & kHpackIndexedHeaderField) != 0) {
+      size_t index = 0;
+      base::StringPiece name, value;
+      if (!DecodeInteger(kHpackIndexedHeaderFieldPrefixBits, &block, &index) ||
+          !header_table_.GetEntry(index, &name, &value)) {
+        return false;
+      }
+      AddHeader(name, value, headers);
+      header_field_seen = true;
+      continue;
+    }
+
+    if ((first_byte & kHpackLiteralWithIncrementalIndexing) != 0) {
+      if (!DecodeLiteralHeaderField(
+              kHpackLiteralWithIncrementalIndexingPrefixBits, true, &block,
+              headers)) {
+        return false;
+      }
+      header_field_seen = true;
+      continue;
+    }
+
+    if ((first_byte & kHpackDynamicTableSizeUpdate) != 0) {
+      // Size updates are only allowed at the start of a block.
+      size_t max_size = 0;
+      if (header_field_seen ||
+          !DecodeInteger(kHpackDynamicTableSizeUpdatePrefixBits, &block,
+                         &max_size) ||
+          max_size > max_table_size_limit_) {
+        return false;
+      }
+      header_table_.SetMaxSize(max_size);
+      continue;
+    }
+
+    // Literals never indexed are only a hint to intermediaries, which decode
+    // the same way as literals without indexing.
+    if (!DecodeLiteralHeaderField(kHpackLiteralWithoutIndexingPrefixBits,
+                                  false, &block, headers)) {
+      return false;
+    }
+    header_field_seen = true;
+  }
+  return true;
+}
+
+bool HpackDecoder::DecodeInteger(uint8 prefix_bits,
+                                 base::StringPiece* input,
+                                 size_t* value) const {
+  if (input->empty())
+    return false;
+  const size_t max_prefix_value = (1 << prefix_bits) - 1;
+  *value = static_cast<uint8>((*input)[0]) & max_prefix_value;
+  input->remove_prefix(1);
+  if (*value < max_prefix_value)
+    return true;
+
+  size_t shift = 0;
+  for (size_t i = 0; i < kMaxIntegerContinuationBytes; ++i) {
+    if (input->empty())
+      return false;
+    const uint8 byte = static_cast<uint8>((*input)[0]);
+    input->remove_prefix(1);
+    *value += static_cast<size_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+    shift += 7;
+  }
+  return false;
+}
+
+bool HpackDecoder::DecodeString(base::StringPiece* input,
+                                std::string* buffer,
+                                base::StringPiece* str) const {
+  if (input->empty())
+    return false;
+  const bool huffman_encoded =
+      (static_cast<uint8>((*input)[0]) & kHpackHuffmanEncodedString) != 0;
+  size_t length = 0;
+  if (!DecodeInteger(kHpackStringLengthPrefixBits, input, &length) ||
+      length > input->size()) {
+    return false;
+  }
+  base::StringPiece encoded(input->data(), length);
+  input->remove_prefix(length);
+  if (!huffman_encoded) {
+    *str = encoded;
+    return true;
+  }
+  buffer->clear();
+  if (!ObtainHpackHuffmanTable().Decode(encoded, buffer))
+    return false;
+  *str = *buffer;
+  return true;
+}
+
+bool HpackDecoder::DecodeLiteralHeaderField(uint8 prefix_bits,
+                                            bool add_to_table,
+                                            base::StringPiece* input,
+                                            SpdyNameValueBlock* headers) {
+  size_t name_index = 0;
+  if (!DecodeInteger(prefix_bits, input, &name_index))
+    return false;
+
+  std::string name_buffer;
+  base::StringPiece name;
+  if (name_index == 0) {
+    if (!DecodeString(input, &name_buffer, &name))
+      return false;
+  } else {
+    base::StringPiece unused_value;
+    if (!header_table_.GetEntry(name_index, &name, &unused_value))
+      return false;
+  }
+
+  std::string value_buffer;
+  base::StringPiece value;
+  if (!DecodeString(input, &value_buffer, &value))
+    return false;
+
+  AddHeader(name, value, headers);
+  if (add_to_table)
+    header_table_.AddEntry(name, value);
+  return true;
+}
+
+}  // namespace net
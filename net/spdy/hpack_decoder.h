@@ -0,0 +1,64 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_DECODER_H_
+#define NET_SPDY_HPACK_DECODER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+#include "net/spdy/spdy_protocol.h"
+
+namespace net {
+
+// Decodes header blocks in the HPACK format (RFC 7541), keeping the header
+// table in sync with the encoder of the peer.
+class NET_EXPORT_PRIVATE HpackDecoder {
+ public:
+  HpackDecoder();
+  ~HpackDecoder();
+
+  // Decodes the complete header block |block| into |headers|. Repeated header
+  // names have their values joined with NULs, the way SPDY sends them, except
+  // for cookies, which are joined back into a single cookie header.
+  // Returns false if the block is malformed, in which case the header table
+  // may be out of sync with the encoder and the decoder must not be used
+  // again.
+  bool DecodeHeaderBlock(base::StringPiece block, SpdyNameValueBlock* headers);
+
+  // The largest dynamic table size the encoder may choose. Defaults to
+  // kHpackDefaultHeaderTableSize.
+  void set_max_table_size_limit(size_t limit) {
+    max_table_size_limit_ = limit;
+  }
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  // Each of these consumes what it decodes from the front of |input|, and
+  // returns false if |input| is malformed.
+  bool DecodeInteger(uint8 prefix_bits,
+                     base::StringPiece* input,
+                     size_t* value) const;
+  // |*str| refers either to |input| or to |*buffer|.
+  bool DecodeString(base::StringPiece* input,
+                    std::string* buffer,
+                    base::StringPiece* str) const;
+  bool DecodeLiteralHeaderField(uint8 prefix_bits,
+                                bool add_to_table,
+                                base::StringPiece* input,
+                                SpdyNameValueBlock* headers);
+
+  HpackHeaderTable header_table_;
+  size_t max_table_size_limit_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackDecoder);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_DECODER_H_
@@ -0,0 +1,142 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+std::string DecodeHex(const std::string& hex) {
+  std::vector<uint8> bytes;
+  EXPECT_TRUE(base::HexStringToBytes(hex, &bytes));
+  return std::string(bytes.begin(), bytes.end());
+}
+
+// The requests of RFC 7541 Appendix C.3 and, Huffman encoded, C.4.
+void DecodeSpecRequests(const char* const* blocks) {
+  HpackDecoder decoder;
+  SpdyNameValueBlock headers;
+
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex(blocks[0]), &headers));
+  EXPECT_EQ(4u, headers.size());
+  EXPECT_EQ("GET", headers[":method"]);
+  EXPECT_EQ("http", headers[":scheme"]);
+  EXPECT_EQ("/", headers[":path"]);
+  EXPECT_EQ("www.example.com", headers[":authority"]);
+  EXPECT_EQ(57u, decoder.header_table().size());
+
+  headers.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex(blocks[1]), &headers));
+  EXPECT_EQ(5u, headers.size());
+  EXPECT_EQ("www.example.com", headers[":authority"]);
+  EXPECT_EQ("no-cache", headers["cache-control"]);
+  EXPECT_EQ(110u, decoder.header_table().size());
+
+  headers.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex(blocks[2]), &headers));
+  EXPECT_EQ(5u, headers.size());
+  EXPECT_EQ("https", headers[":scheme"]);
+  EXPECT_EQ("/index.html", headers[":path"]);
+  EXPECT_EQ("www.example.com", headers[":authority"]);
+  EXPECT_EQ("custom-value", headers["custom-key"]);
+  EXPECT_EQ(164u, decoder.header_table().size());
+  EXPECT_EQ(3u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackDecoderTest, SpecRequestsWithoutHuffman) {
+  const char* const kBlocks[] = {
+    "828684410f7777772e6578616d706c652e636f6d",
+    "828684be58086e6f2d6361636865",
+    "828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565",
+  };
+  DecodeSpecRequests(kBlocks);
+}
+
+TEST(HpackDecoderTest, SpecRequestsWithHuffman) {
+  const char* const kBlocks[] = {
+    "828684418cf1e3c2e5f23a6ba0ab90f4ff",
+    "828684be5886a8eb10649cbf",
+    "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf",
+  };
+  DecodeSpecRequests(kBlocks);
+}
+
+TEST(HpackDecoderTest, JoinsRepeatedHeaders) {
+  HpackDecoder decoder;
+  SpdyNameValueBlock headers;
+  // Literals without indexing of "set-cookie" (static index 55).
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex("0f28036123620f2803632364"),
+                                        &headers));
+  EXPECT_EQ(1u, headers.size());
+  EXPECT_EQ(std::string("a#b") + '\0' + "c#d", headers["set-cookie"]);
+  EXPECT_EQ(0u, decoder.header_table().dynamic_entry_count());
+
+  // Cookies are joined into a single cookie header instead.
+  headers.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex("0f11036123620f1103632364"),
+                                        &headers));
+  EXPECT_EQ(1u, headers.size());
+  EXPECT_EQ("a#b; c#d", headers["cookie"]);
+}
+
+TEST(HpackDecoderTest, DynamicTableSizeUpdate) {
+  HpackDecoder decoder;
+  SpdyNameValueBlock headers;
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(
+      DecodeHex("410f7777772e6578616d706c652e636f6d"), &headers));
+  EXPECT_EQ(1u, decoder.header_table().dynamic_entry_count());
+
+  // Shrinking the table to zero evicts everything.
+  headers.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(DecodeHex("2082"), &headers));
+  EXPECT_EQ(0u, decoder.header_table().max_size());
+  EXPECT_EQ(0u, decoder.header_table().dynamic_entry_count());
+
+  // An update after a header field.
+  headers.clear();
+  EXPECT_FALSE(decoder.DecodeHeaderBlock(DecodeHex("8220"), &headers));
+}
+
+TEST(HpackDecoderTest, RejectsTableSizeAboveLimit) {
+  HpackDecoder decoder;
+  decoder.set_max_table_size_limit(100);
+  SpdyNameValueBlock headers;
+  // 31 + 69 = 100.
+  EXPECT_TRUE(decoder.DecodeHeaderBlock(DecodeHex("3f45"), &headers));
+  EXPECT_FALSE(decoder.DecodeHeaderBlock(DecodeHex("3f46"), &headers));
+}
+
+TEST(HpackDecoderTest, RejectsMalformedBlocks) {
+  const char* const kBlocks[] = {
+    // Index 0.
+    "80",
+    // Index past the end of the table.
+    "be",
+    // Truncated integer.
+    "ff",
+    // Integer too large.
+    "ffffffffff0f",
+    // String longer than the block.
+    "0f1105616263",
+    // Invalid Huffman padding.
+    "0f118106",
+  };
+  for (size_t i = 0; i < arraysize(kBlocks); ++i) {
+    HpackDecoder decoder;
+    SpdyNameValueBlock headers;
+    EXPECT_FALSE(decoder.DecodeHeaderBlock(DecodeHex(kBlocks[i]), &headers))
+        << kBlocks[i];
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
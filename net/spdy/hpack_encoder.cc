@@ -0,0 +1,142 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include <string.h>
+
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_huffman_table.h"
+
+namespace net {
+
+namespace {
+
+// An integer of up to 32 bits takes the prefix byte and up to five more.
+const size_t kMaxIntegerSize = 6;
+
+void EncodeInteger(uint8 pattern,
+                   uint8 prefix_bits,
+                   size_t value,
+                   std::string* output) {
+  const size_t max_prefix_value = (1 << prefix_bits) - 1;
+  if (value < max_prefix_value) {
+    output->push_back(static_cast<char>(pattern | value));
+    return;
+  }
+  output->push_back(static_cast<char>(pattern | max_prefix_value));
+  value -= max_prefix_value;
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+}  // namespace
+
+HpackEncoder::HpackEncoder() : table_size_update_pending_(false) {}
+
+HpackEncoder::~HpackEncoder() {}
+
+void HpackEncoder::EncodeHeaderBlock(const SpdyNameValueBlock& headers,
+                                     std::string* output) {
+  if (table_size_update_pending_) {
+    EncodeInteger(kHpackDynamicTableSizeUpdate,
+                  kHpackDynamicTableSizeUpdatePrefixBits,
+                  header_table_.max_size(), output);
+    table_size_update_pending_ = false;
+  }
+
+  for (SpdyNameValueBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    if (it->first != kHpackCookieHeader) {
+      EncodeHeaderField(it->first, it->second, output);
+      continue;
+    }
+    // Each cookie is sent as a header field of its own, so that the ones
+    // which do not change are sent as an index.
+    base::StringPiece cookies(it->second);
+    size_t separator = 0;
+    while ((separator = cookies.find(kHpackCookieSeparator)) !=
+           base::StringPiece::npos) {
+      EncodeHeaderField(it->first, cookies.substr(0, separator), output);
+      cookies.remove_prefix(separator + strlen(kHpackCookieSeparator));
+    }
+    EncodeHeaderField(it->first, cookies, output);
+  }
+}
+
+void HpackEncoder::SetMaxTableSize(size_t max_size) {
+  header_table_.SetMaxSize(max_size);
+  table_size_update_pending_ = true;
+}
+
+// static
+size_t HpackEncoder::GetEncodedSizeBound(const SpdyNameValueBlock& headers) {
+  // A header field is at worst a literal name and value, each preceded by
+  // its length, and a string is only Huffman encoded when that is shorter.
+  size_t bound = kMaxIntegerSize;
+  for (SpdyNameValueBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    size_t field_count = 1;
+    if (it->first == kHpackCookieHeader) {
+      for (size_t pos = it->second.find(kHpackCookieSeparator);
+           pos != std::string::npos;
+           pos = it->second.find(kHpackCookieSeparator, pos + 1)) {
+        ++field_count;
+      }
+    }
+    bound += field_count * (1 + 2 * kMaxIntegerSize) + it->first.size() +
+        it->second.size();
+  }
+  return bound;
+}
+
+void HpackEncoder::EncodeHeaderField(base::StringPiece name,
+                                     base::StringPiece value,
+                                     std::string* output) {
+  size_t name_index = 0;
+  const size_t index = header_table_.FindEntry(name, value, &name_index);
+  if (index != 0) {
+    EncodeInteger(kHpackIndexedHeaderField,
+                  kHpackIndexedHeaderFieldPrefixBits, index, output);
+    return;
+  }
+
+  // A header field too large for the table would only empty it.
+  const bool add_to_table =
+      name.size() + value.size() + kHpackEntrySizeOverhead <=
+      header_table_.max_size();
+  if (add_to_table) {
+    EncodeInteger(kHpackLiteralWithIncrementalIndexing,
+                  kHpackLiteralWithIncrementalIndexingPrefixBits,
+                  name_index, output);
+  } else {
+    EncodeInteger(kHpackLiteralWithoutIndexing,
+                  kHpackLiteralWithoutIndexingPrefixBits,
+                  name_index, output);
+  }
+  if (name_index == 0)
+    EncodeString(name, output);
+  EncodeString(value, output);
+  if (add_to_table)
+    header_table_.AddEntry(name, value);
+}
+
+void HpackEncoder::EncodeString(base::StringPiece str,
+                                std::string* output) const {
+  const HpackHuffmanTable& huffman_table = ObtainHpackHuffmanTable();
+  const size_t huffman_size = huffman_table.EncodedSize(str);
+  if (huffman_size < str.size()) {
+    EncodeInteger(kHpackHuffmanEncodedString, kHpackStringLengthPrefixBits,
+                  huffman_size, output);
+    huffman_table.Encode(str, output);
+  } else {
+    EncodeInteger(0, kHpackStringLengthPrefixBits, str.size(), output);
+    str.AppendToString(output);
+  }
+}
+
+}  // namespace net
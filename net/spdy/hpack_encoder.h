@@ -0,0 +1,59 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_ENCODER_H_
+#define NET_SPDY_HPACK_ENCODER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+#include "net/spdy/spdy_protocol.h"
+
+namespace net {
+
+// Encodes header blocks in the HPACK format (RFC 7541). Header fields already
+// in the header table are sent as their index. Other header fields are sent
+// as literals, Huffman encoded when that is shorter, and added to the header
+// table so that later blocks can refer to them. The encoder and the decoder
+// of a connection must see the same sequence of header blocks.
+class NET_EXPORT_PRIVATE HpackEncoder {
+ public:
+  HpackEncoder();
+  ~HpackEncoder();
+
+  // Appends the encoding of |headers| to |output|. A value holding several
+  // NUL separated values, the way SPDY sends repeated headers, is encoded as
+  // a single header field. A cookie header is split into one header field
+  // per cookie.
+  void EncodeHeaderBlock(const SpdyNameValueBlock& headers,
+                         std::string* output);
+
+  // Changes the size limit of the dynamic table. The decoder is told at the
+  // start of the next header block, and |max_size| must not be above the
+  // limit it accepts.
+  void SetMaxTableSize(size_t max_size);
+
+  // Returns an upper bound of the size of the encoding of |headers|.
+  static size_t GetEncodedSizeBound(const SpdyNameValueBlock& headers);
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  void EncodeHeaderField(base::StringPiece name,
+                         base::StringPiece value,
+                         std::string* output);
+  void EncodeString(base::StringPiece str, std::string* output) const;
+
+  HpackHeaderTable header_table_;
+  bool table_size_update_pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackEncoder);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_ENCODER_H_
@@ -0,0 +1,126 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include <string>
+
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_decoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+SpdyNameValueBlock MakeRequestHeaders() {
+  SpdyNameValueBlock headers;
+  headers[":method"] = "GET";
+  headers[":path"] = "/index.html";
+  headers[":scheme"] = "https";
+  headers[":authority"] = "www.example.com";
+  headers["accept-encoding"] = "gzip, deflate";
+  headers["user-agent"] = "Mozilla/5.0 (X11; Linux x86_64)";
+  headers["cookie"] = std::string("a=b") + '\0' + "c=d";
+  return headers;
+}
+
+TEST(HpackEncoderTest, IndexesStaticEntries) {
+  HpackEncoder encoder;
+  SpdyNameValueBlock headers;
+  headers[":method"] = "GET";
+  headers[":path"] = "/";
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_EQ("\x82\x84", output);
+  EXPECT_EQ(0u, encoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackEncoderTest, RepeatedBlocksAreIndexed) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  const SpdyNameValueBlock headers = MakeRequestHeaders();
+
+  std::string first;
+  encoder.EncodeHeaderBlock(headers, &first);
+  std::string second;
+  encoder.EncodeHeaderBlock(headers, &second);
+  EXPECT_EQ(headers.size(), second.size());
+  EXPECT_LE(first.size(), HpackEncoder::GetEncodedSizeBound(headers));
+
+  SpdyNameValueBlock decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(first, &decoded));
+  EXPECT_EQ(headers, decoded);
+  decoded.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(second, &decoded));
+  EXPECT_EQ(headers, decoded);
+}
+
+TEST(HpackEncoderTest, LargeHeadersAreNotIndexed) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  SpdyNameValueBlock headers;
+  headers["x-large"] = std::string(kHpackDefaultHeaderTableSize, '\xff');
+
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_EQ(0u, encoder.header_table().dynamic_entry_count());
+  // The representation, the Huffman encoded name and its length, then the
+  // value as is, since Huffman encoding would make it longer, and its length.
+  EXPECT_EQ(1 + 1 + 6 + 3 + kHpackDefaultHeaderTableSize, output.size());
+  EXPECT_LE(output.size(), HpackEncoder::GetEncodedSizeBound(headers));
+
+  SpdyNameValueBlock decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(output, &decoded));
+  EXPECT_EQ(headers, decoded);
+  EXPECT_EQ(0u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackEncoderTest, CookiesAreIndexedSeparately) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  SpdyNameValueBlock headers;
+  headers["cookie"] = "PREF=ID=5e4cd3c8c6ff8a6b; NID=67=1; SID=DQAAAMgAAAAx";
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_EQ(3u, encoder.header_table().dynamic_entry_count());
+  EXPECT_LE(output.size(), HpackEncoder::GetEncodedSizeBound(headers));
+  SpdyNameValueBlock decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(output, &decoded));
+  EXPECT_EQ(headers, decoded);
+
+  // Only the cookie which changed is sent as a literal, with an indexed name
+  // and a Huffman encoded value of seven bytes.
+  headers["cookie"] = "PREF=ID=5e4cd3c8c6ff8a6b; NID=67=2; SID=DQAAAMgAAAAx";
+  output.clear();
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_EQ(1u + (1 + 1 + 7) + 1, output.size());
+  decoded.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(output, &decoded));
+  EXPECT_EQ(headers, decoded);
+}
+
+TEST(HpackEncoderTest, TableSizeChangeIsSignalled) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  const SpdyNameValueBlock headers = MakeRequestHeaders();
+  std::string output;
+  encoder.EncodeHeaderBlock(headers, &output);
+  SpdyNameValueBlock decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(output, &decoded));
+
+  encoder.SetMaxTableSize(128);
+  output.clear();
+  encoder.EncodeHeaderBlock(headers, &output);
+  EXPECT_EQ(0x20 | 0x1f, static_cast<uint8>(output[0]));
+  decoded.clear();
+  ASSERT_TRUE(decoder.DecodeHeaderBlock(output, &decoded));
+  EXPECT_EQ(headers, decoded);
+  EXPECT_EQ(128u, decoder.header_table().max_size());
+  EXPECT_EQ(encoder.header_table().size(), decoder.header_table().size());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
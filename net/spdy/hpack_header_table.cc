@@ -0,0 +1,118 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_header_table.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "net/spdy/hpack_constants.h"
+
+namespace net {
+
+namespace {
+
+// Most entries are told apart by their length, which is checked first.
+bool Equals(base::StringPiece a, const char* b, size_t b_len) {
+  return a.size() == b_len && memcmp(a.data(), b, b_len) == 0;
+}
+
+}  // namespace
+
+HpackHeaderTable::HpackEntry::HpackEntry(base::StringPiece name,
+                                         base::StringPiece value)
+    : name(name.data(), name.size()),
+      value(value.data(), value.size()) {
+}
+
+HpackHeaderTable::HpackEntry::~HpackEntry() {}
+
+size_t HpackHeaderTable::HpackEntry::Size() const {
+  return name.size() + value.size() + kHpackEntrySizeOverhead;
+}
+
+HpackHeaderTable::HpackHeaderTable()
+    : size_(0),
+      max_size_(kHpackDefaultHeaderTableSize) {
+}
+
+HpackHeaderTable::~HpackHeaderTable() {}
+
+size_t HpackHeaderTable::GetEntryCount() const {
+  return kHpackStaticTableSize + dynamic_entries_.size();
+}
+
+bool HpackHeaderTable::GetEntry(size_t index,
+                                base::StringPiece* name,
+                                base::StringPiece* value) const {
+  if (index == 0 || index > GetEntryCount())
+    return false;
+  if (index <= kHpackStaticTableSize) {
+    const HpackStaticEntry& entry = HpackStaticTable()[index - 1];
+    name->set(entry.name, entry.name_len);
+    value->set(entry.value, entry.value_len);
+    return true;
+  }
+  const HpackEntry& entry =
+      dynamic_entries_[index - kHpackStaticTableSize - 1];
+  *name = entry.name;
+  *value = entry.value;
+  return true;
+}
+
+size_t HpackHeaderTable::FindEntry(base::StringPiece name,
+                                   base::StringPiece value,
+                                   size_t* name_index) const {
+  *name_index = 0;
+  const HpackStaticEntry* static_table = HpackStaticTable();
+  for (size_t i = 0; i < kHpackStaticTableSize; ++i) {
+    const HpackStaticEntry& entry = static_table[i];
+    if (!Equals(name, entry.name, entry.name_len))
+      continue;
+    if (Equals(value, entry.value, entry.value_len))
+      return i + 1;
+    if (*name_index == 0)
+      *name_index = i + 1;
+  }
+  size_t index = kHpackStaticTableSize + 1;
+  for (std::deque<HpackEntry>::const_iterator it = dynamic_entries_.begin();
+       it != dynamic_entries_.end(); ++it, ++index) {
+    if (!Equals(name, it->name.data(), it->name.size()))
+      continue;
+    if (Equals(value, it->value.data(), it->value.size()))
+      return index;
+    if (*name_index == 0)
+      *name_index = index;
+  }
+  return 0;
+}
+
+void HpackHeaderTable::AddEntry(base::StringPiece name,
+                                base::StringPiece value) {
+  // Copy the entry first: |name| may refer to an entry about to be evicted.
+  HpackEntry entry(name, value);
+  const size_t entry_size = entry.Size();
+  if (entry_size > max_size_) {
+    EvictToFit(0);
+    return;
+  }
+  EvictToFit(max_size_ - entry_size);
+  dynamic_entries_.push_front(entry);
+  size_ += entry_size;
+}
+
+void HpackHeaderTable::SetMaxSize(size_t max_size) {
+  max_size_ = max_size;
+  EvictToFit(max_size_);
+}
+
+void HpackHeaderTable::EvictToFit(size_t max_size) {
+  while (size_ > max_size) {
+    DCHECK(!dynamic_entries_.empty());
+    size_ -= dynamic_entries_.back().Size();
+    dynamic_entries_.pop_back();
+  }
+}
+
+}  // namespace net
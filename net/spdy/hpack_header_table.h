@@ -0,0 +1,78 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_HEADER_TABLE_H_
+#define NET_SPDY_HPACK_HEADER_TABLE_H_
+
+#include <deque>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// The header table an HPACK encoder or decoder indexes header fields with:
+// the static table, followed by the dynamic table of the header fields seen
+// on the connection, newest first. Adding to the dynamic table evicts its
+// oldest entries so that the total size of the entries, as defined by
+// HpackEntry::Size(), stays within the table size limit.
+class NET_EXPORT_PRIVATE HpackHeaderTable {
+ public:
+  struct NET_EXPORT_PRIVATE HpackEntry {
+    HpackEntry(base::StringPiece name, base::StringPiece value);
+    ~HpackEntry();
+
+    size_t Size() const;
+
+    std::string name;
+    std::string value;
+  };
+
+  HpackHeaderTable();
+  ~HpackHeaderTable();
+
+  // The number of entries of the static and the dynamic table.
+  size_t GetEntryCount() const;
+
+  // Looks up the entry with the given 1-based |index|. Returns false if there
+  // is no such entry.
+  bool GetEntry(size_t index,
+                base::StringPiece* name,
+                base::StringPiece* value) const;
+
+  // Returns the index of an entry matching both |name| and |value|, or 0 if
+  // there is none. In that case, |*name_index| is set to the index of an
+  // entry with |name|, or 0.
+  size_t FindEntry(base::StringPiece name,
+                   base::StringPiece value,
+                   size_t* name_index) const;
+
+  // Adds an entry to the dynamic table, first evicting entries to make room
+  // for it. An entry larger than the limit empties the table and is not
+  // added.
+  void AddEntry(base::StringPiece name, base::StringPiece value);
+
+  // Changes the size limit of the dynamic table, evicting entries as needed.
+  void SetMaxSize(size_t max_size);
+
+  size_t size() const { return size_; }
+  size_t max_size() const { return max_size_; }
+  size_t dynamic_entry_count() const { return dynamic_entries_.size(); }
+
+ private:
+  void EvictToFit(size_t max_size);
+
+  // Newest first.
+  std::deque<HpackEntry> dynamic_entries_;
+  size_t size_;
+  size_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackHeaderTable);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_HEADER_TABLE_H_
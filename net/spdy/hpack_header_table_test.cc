@@ -0,0 +1,99 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_header_table.h"
+
+#include <string>
+
+#include "net/spdy/hpack_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+TEST(HpackHeaderTableTest, StaticTable) {
+  HpackHeaderTable table;
+  base::StringPiece name, value;
+  EXPECT_FALSE(table.GetEntry(0, &name, &value));
+  ASSERT_TRUE(table.GetEntry(2, &name, &value));
+  EXPECT_EQ(":method", name);
+  EXPECT_EQ("GET", value);
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize, &name, &value));
+  EXPECT_EQ("www-authenticate", name);
+  EXPECT_EQ("", value);
+  EXPECT_FALSE(table.GetEntry(kHpackStaticTableSize + 1, &name, &value));
+
+  size_t name_index = 0;
+  EXPECT_EQ(3u, table.FindEntry(":method", "POST", &name_index));
+  EXPECT_EQ(0u, table.FindEntry(":method", "PUT", &name_index));
+  EXPECT_EQ(2u, name_index);
+  EXPECT_EQ(0u, table.FindEntry("x-custom", "", &name_index));
+  EXPECT_EQ(0u, name_index);
+}
+
+TEST(HpackHeaderTableTest, DynamicEntriesAreIndexedNewestFirst) {
+  HpackHeaderTable table;
+  table.AddEntry("x-first", "1");
+  table.AddEntry("x-second", "2");
+  EXPECT_EQ(kHpackStaticTableSize + 2, table.GetEntryCount());
+  EXPECT_EQ(7 + 1 + 8 + 1 + 2 * kHpackEntrySizeOverhead, table.size());
+
+  base::StringPiece name, value;
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 1, &name, &value));
+  EXPECT_EQ("x-second", name);
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 2, &name, &value));
+  EXPECT_EQ("x-first", name);
+
+  size_t name_index = 0;
+  EXPECT_EQ(kHpackStaticTableSize + 2,
+            table.FindEntry("x-first", "1", &name_index));
+  EXPECT_EQ(0u, table.FindEntry("x-first", "3", &name_index));
+  EXPECT_EQ(kHpackStaticTableSize + 2, name_index);
+}
+
+TEST(HpackHeaderTableTest, EvictsOldestEntries) {
+  HpackHeaderTable table;
+  // Each entry takes 32 + 2 + 30 = 64 bytes.
+  const std::string value(30, 'v');
+  table.SetMaxSize(3 * 64);
+  table.AddEntry("x1", value);
+  table.AddEntry("x2", value);
+  table.AddEntry("x3", value);
+  EXPECT_EQ(3u, table.dynamic_entry_count());
+  table.AddEntry("x4", value);
+  EXPECT_EQ(3u, table.dynamic_entry_count());
+  EXPECT_EQ(3u * 64, table.size());
+
+  size_t name_index = 0;
+  EXPECT_EQ(0u, table.FindEntry("x1", value, &name_index));
+  EXPECT_EQ(0u, name_index);
+
+  table.SetMaxSize(64);
+  EXPECT_EQ(1u, table.dynamic_entry_count());
+  EXPECT_NE(0u, table.FindEntry("x4", value, &name_index));
+
+  // An entry larger than the table empties it.
+  table.AddEntry("x5", value + "v");
+  EXPECT_EQ(0u, table.dynamic_entry_count());
+  EXPECT_EQ(0u, table.size());
+}
+
+TEST(HpackHeaderTableTest, AddEntryReferringToEvictedEntry) {
+  HpackHeaderTable table;
+  const std::string value(30, 'v');
+  table.SetMaxSize(64);
+  table.AddEntry("x1", value);
+  base::StringPiece name, old_value;
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 1, &name, &old_value));
+  // Adding the entry evicts the one |name| points into.
+  table.AddEntry(name, "w" + value.substr(1));
+  ASSERT_TRUE(table.GetEntry(kHpackStaticTableSize + 1, &name, &old_value));
+  EXPECT_EQ("x1", name);
+  EXPECT_EQ(1u, table.dynamic_entry_count());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -0,0 +1,146 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_huffman_table.h"
+
+#include <algorithm>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+
+namespace net {
+
+namespace {
+
+base::LazyInstance<HpackHuffmanTable>::Leaky g_huffman_table =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Orders symbols by the length of their code, then by value, which is the
+// order of their codes since the code is canonical.
+class SymbolCodeLess {
+ public:
+  explicit SymbolCodeLess(const HpackHuffmanSymbol* code) : code_(code) {}
+
+  bool operator()(uint16 a, uint16 b) const {
+    if (code_[a].length != code_[b].length)
+      return code_[a].length < code_[b].length;
+    return a < b;
+  }
+
+ private:
+  const HpackHuffmanSymbol* code_;
+};
+
+}  // namespace
+
+HpackHuffmanTable::HpackHuffmanTable() {
+  const HpackHuffmanSymbol* code = HpackHuffmanCode();
+  for (size_t i = 0; i < kHpackHuffmanSymbolCount; ++i)
+    sorted_symbols_[i] = static_cast<uint16>(i);
+  std::sort(sorted_symbols_, sorted_symbols_ + kHpackHuffmanSymbolCount,
+            SymbolCodeLess(code));
+  min_code_length_ = code[sorted_symbols_[0]].length;
+
+  // Walk the codes in order and record, for each length, the first code and
+  // the left-aligned code following the last one.
+  uint64 next_code = 0;
+  size_t length = min_code_length_;
+  size_t index = 0;
+  for (size_t l = 0; l <= kMaxCodeLength; ++l) {
+    length_limits_[l] = 0;
+    first_codes_[l] = 0;
+    first_symbol_indices_[l] = 0;
+  }
+  for (; length <= kMaxCodeLength; ++length) {
+    first_codes_[length] = static_cast<uint32>(next_code);
+    first_symbol_indices_[length] = static_cast<uint16>(index);
+    while (index < kHpackHuffmanSymbolCount &&
+           code[sorted_symbols_[index]].length == length) {
+      DCHECK_EQ(next_code, code[sorted_symbols_[index]].code)
+          << "The Huffman code is not canonical.";
+      ++next_code;
+      ++index;
+    }
+    length_limits_[length] = next_code << (32 - length);
+    next_code <<= 1;
+  }
+  DCHECK_EQ(kHpackHuffmanSymbolCount, index);
+}
+
+HpackHuffmanTable::~HpackHuffmanTable() {}
+
+size_t HpackHuffmanTable::EncodedSize(base::StringPiece in) const {
+  const HpackHuffmanSymbol* code = HpackHuffmanCode();
+  size_t bit_count = 0;
+  for (size_t i = 0; i < in.size(); ++i)
+    bit_count += code[static_cast<uint8>(in[i])].length;
+  return (bit_count + 7) / 8;
+}
+
+void HpackHuffmanTable::Encode(base::StringPiece in, std::string* out) const {
+  const HpackHuffmanSymbol* code = HpackHuffmanCode();
+  out->reserve(out->size() + EncodedSize(in));
+
+  // Bits not yet written, left-aligned.
+  uint64 bits = 0;
+  size_t bit_count = 0;
+  for (size_t i = 0; i < in.size(); ++i) {
+    const HpackHuffmanSymbol& symbol = code[static_cast<uint8>(in[i])];
+    bits |= static_cast<uint64>(symbol.code) << (64 - bit_count -
+                                                 symbol.length);
+    bit_count += symbol.length;
+    while (bit_count >= 8) {
+      out->push_back(static_cast<char>(bits >> 56));
+      bits <<= 8;
+      bit_count -= 8;
+    }
+  }
+  if (bit_count > 0) {
+    // Pad with the most significant bits of EOS, which are all ones.
+    bits |= GG_UINT64_C(0xff) << (56 - bit_count);
+    out->push_back(static_cast<char>(bits >> 56));
+  }
+}
+
+bool HpackHuffmanTable::Decode(base::StringPiece in, std::string* out) const {
+  // Bits read from |in| and not yet decoded, left-aligned.
+  uint64 bits = 0;
+  size_t bit_count = 0;
+  size_t in_pos = 0;
+  while (true) {
+    while (bit_count <= 56 && in_pos < in.size()) {
+      bits |= static_cast<uint64>(static_cast<uint8>(in[in_pos++])) <<
+          (56 - bit_count);
+      bit_count += 8;
+    }
+    if (bit_count == 0)
+      return true;
+
+    const uint64 peek = bits >> 32;
+    size_t length = min_code_length_;
+    while (length < kMaxCodeLength && peek >= length_limits_[length])
+      ++length;
+
+    if (length > bit_count) {
+      // All input is consumed and what remains must be padding.
+      const uint64 padding = peek >> (32 - bit_count);
+      return bit_count < 8 && padding == (1u << bit_count) - 1;
+    }
+
+    const uint32 value = static_cast<uint32>(peek >> (32 - length));
+    const uint16 symbol = sorted_symbols_[
+        first_symbol_indices_[length] + (value - first_codes_[length])];
+    if (symbol == kHpackHuffmanEosSymbol)
+      return false;
+    out->push_back(static_cast<char>(symbol));
+    bits <<= length;
+    bit_count -= length;
+  }
+}
+
+const HpackHuffmanTable& ObtainHpackHuffmanTable() {
+  return g_huffman_table.Get();
+}
+
+}  // namespace net
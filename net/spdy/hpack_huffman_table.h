@@ -0,0 +1,63 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_HUFFMAN_TABLE_H_
+#define NET_SPDY_HPACK_HUFFMAN_TABLE_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_constants.h"
+
+namespace net {
+
+// Encodes and decodes HPACK string literals with the canonical Huffman code
+// of RFC 7541 Appendix B. The object is immutable once constructed and may be
+// shared by any number of encoders and decoders; use
+// ObtainHpackHuffmanTable() rather than constructing one.
+class NET_EXPORT_PRIVATE HpackHuffmanTable {
+ public:
+  HpackHuffmanTable();
+  ~HpackHuffmanTable();
+
+  // Returns the number of bytes Encode() would produce for |in|.
+  size_t EncodedSize(base::StringPiece in) const;
+
+  // Appends the Huffman encoding of |in| to |out|, padded to a byte boundary
+  // with the most significant bits of EOS.
+  void Encode(base::StringPiece in, std::string* out) const;
+
+  // Appends the decoding of |in| to |out|. Returns false if |in| is not a
+  // valid encoding: it contains EOS, or its padding is longer than seven bits
+  // or not made of ones.
+  bool Decode(base::StringPiece in, std::string* out) const;
+
+ private:
+  // Codes are at most 30 bits long.
+  static const size_t kMaxCodeLength = 30;
+
+  // Since the code is canonical, the codes of a given length are consecutive
+  // and follow, left-aligned, all the shorter codes. The length of the next
+  // code in the input is therefore the smallest length whose
+  // |length_limits_| is above the next 32 bits of the input, and its symbol
+  // is found by its distance to the first code of that length.
+  uint64 length_limits_[kMaxCodeLength + 1];
+  uint32 first_codes_[kMaxCodeLength + 1];
+  // Index in |sorted_symbols_| of the first code of each length.
+  uint16 first_symbol_indices_[kMaxCodeLength + 1];
+  // Symbols in the order of their codes.
+  uint16 sorted_symbols_[kHpackHuffmanSymbolCount];
+  size_t min_code_length_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackHuffmanTable);
+};
+
+// Returns the process wide table.
+NET_EXPORT_PRIVATE const HpackHuffmanTable& ObtainHpackHuffmanTable();
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_HUFFMAN_TABLE_H_
@@ -0,0 +1,80 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_huffman_table.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+std::string DecodeHex(const std::string& hex) {
+  std::vector<uint8> bytes;
+  EXPECT_TRUE(base::HexStringToBytes(hex, &bytes));
+  return std::string(bytes.begin(), bytes.end());
+}
+
+std::string Encode(base::StringPiece in) {
+  std::string out;
+  ObtainHpackHuffmanTable().Encode(in, &out);
+  EXPECT_EQ(out.size(), ObtainHpackHuffmanTable().EncodedSize(in));
+  return out;
+}
+
+// Examples of RFC 7541 Appendix C.4 and C.6.
+TEST(HpackHuffmanTableTest, SpecExamples) {
+  const struct {
+    const char* decoded;
+    const char* encoded;
+  } kExamples[] = {
+    { "www.example.com", "f1e3c2e5f23a6ba0ab90f4ff" },
+    { "no-cache", "a8eb10649cbf" },
+    { "custom-key", "25a849e95ba97d7f" },
+    { "custom-value", "25a849e95bb8e8b4bf" },
+    { "302", "6402" },
+    { "private", "aec3771a4b" },
+  };
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(kExamples); ++i) {
+    const std::string encoded = DecodeHex(kExamples[i].encoded);
+    EXPECT_EQ(encoded, Encode(kExamples[i].decoded)) << kExamples[i].decoded;
+    std::string decoded;
+    EXPECT_TRUE(ObtainHpackHuffmanTable().Decode(encoded, &decoded));
+    EXPECT_EQ(kExamples[i].decoded, decoded);
+  }
+}
+
+TEST(HpackHuffmanTableTest, RoundTripsAllBytes) {
+  std::string in;
+  for (int i = 0; i < 256; ++i)
+    in.push_back(static_cast<char>(i));
+  in += in;
+  for (size_t length = 0; length <= in.size(); ++length) {
+    std::string decoded;
+    EXPECT_TRUE(ObtainHpackHuffmanTable().Decode(
+        Encode(base::StringPiece(in.data(), length)), &decoded));
+    EXPECT_EQ(in.substr(0, length), decoded);
+  }
+}
+
+TEST(HpackHuffmanTableTest, RejectsInvalidPadding) {
+  std::string decoded;
+  // '0' is 00000, so three bits of padding are needed, and they must be ones.
+  EXPECT_TRUE(ObtainHpackHuffmanTable().Decode(DecodeHex("07"), &decoded));
+  EXPECT_EQ("0", decoded);
+  EXPECT_FALSE(ObtainHpackHuffmanTable().Decode(DecodeHex("06"), &decoded));
+  // A full byte of padding.
+  EXPECT_FALSE(ObtainHpackHuffmanTable().Decode(DecodeHex("07ff"), &decoded));
+  // EOS itself.
+  EXPECT_FALSE(ObtainHpackHuffmanTable().Decode(DecodeHex("ffffffff"),
+                                                &decoded));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
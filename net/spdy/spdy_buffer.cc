@@ -54,6 +54,7 @@ class SpdyBuffer::SharedFrameIOBuffer : public IOBuffer {
 
 SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> frame)
     : shared_frame_(new SharedFrame()),
+      payload_size_(0),
       offset_(0) {
   shared_frame_->data = frame.Pass();
 }
@@ -62,21 +63,57 @@ SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> frame)
 // |frame_| just as a container.
 SpdyBuffer::SpdyBuffer(const char* data, size_t size) :
     shared_frame_(new SharedFrame()),
+    payload_size_(0),
     offset_(0) {
   shared_frame_->data = MakeSpdyFrame(data, size);
 }
 
+SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> frame_header,
+                       IOBuffer* payload,
+                       size_t payload_size)
+    : shared_frame_(new SharedFrame()),
+      payload_(payload),
+      payload_size_(payload_size),
+      offset_(0) {
+  DCHECK(payload || payload_size == 0);
+  shared_frame_->data = frame_header.Pass();
+}
+
 SpdyBuffer::~SpdyBuffer() {
   if (GetRemainingSize() > 0)
     ConsumeHelper(GetRemainingSize(), DISCARD);
 }
 
 const char* SpdyBuffer::GetRemainingData() const {
-  return shared_frame_->data->data() + offset_;
+  DCHECK(IsRemainingDataContiguous());
+  size_t frame_size = GetFrameSize();
+  if (offset_ < frame_size || payload_size_ == 0)
+    return shared_frame_->data->data() + offset_;
+  return payload_->data() + (offset_ - frame_size);
 }
 
 size_t SpdyBuffer::GetRemainingSize() const {
-  return shared_frame_->data->size() - offset_;
+  return GetFrameSize() + payload_size_ - offset_;
+}
+
+bool SpdyBuffer::IsRemainingDataContiguous() const {
+  return payload_size_ == 0 || offset_ >= GetFrameSize();
+}
+
+void SpdyBuffer::CopyRemainingData(char* dest) const {
+  size_t frame_size = GetFrameSize();
+  size_t payload_offset = 0;
+  if (offset_ < frame_size) {
+    std::memcpy(dest, shared_frame_->data->data() + offset_,
+                frame_size - offset_);
+    dest += frame_size - offset_;
+  } else {
+    payload_offset = offset_ - frame_size;
+  }
+  if (payload_size_ > payload_offset) {
+    std::memcpy(dest, payload_->data() + payload_offset,
+                payload_size_ - payload_offset);
+  }
 }
 
 void SpdyBuffer::AddConsumeCallback(const ConsumeCallback& consume_callback) {
@@ -88,7 +125,19 @@ void SpdyBuffer::Consume(size_t consume_size) {
 };
 
 IOBuffer* SpdyBuffer::GetIOBufferForRemainingData() {
-  return new SharedFrameIOBuffer(shared_frame_, offset_);
+  DCHECK(IsRemainingDataContiguous());
+  size_t frame_size = GetFrameSize();
+  if (offset_ < frame_size || payload_size_ == 0)
+    return new SharedFrameIOBuffer(shared_frame_, offset_);
+  // Hold on to |payload_| rather than to |shared_frame_|.
+  DrainableIOBuffer* payload_buffer =
+      new DrainableIOBuffer(payload_.get(), static_cast<int>(payload_size_));
+  payload_buffer->SetOffset(static_cast<int>(offset_ - frame_size));
+  return payload_buffer;
+}
+
+size_t SpdyBuffer::GetFrameSize() const {
+  return shared_frame_->data->size();
 }
 
 void SpdyBuffer::ConsumeHelper(size_t consume_size,
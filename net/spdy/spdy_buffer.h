@@ -53,16 +53,36 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   // non-NULL and |size| must be non-zero.
   SpdyBuffer(const char* data, size_t size);
 
+  // Construct with the data in |frame_header| followed by the first
+  // |payload_size| bytes of |payload|. Used for DATA frames, so that
+  // the payload doesn't have to be copied into the frame; |payload|
+  // must not be modified until the buffer has been consumed or
+  // destroyed.
+  SpdyBuffer(scoped_ptr<SpdyFrame> frame_header,
+             IOBuffer* payload,
+             size_t payload_size);
+
   // If there are bytes remaining in the buffer, triggers a call to
   // any consume callbacks with a DISCARD source.
   ~SpdyBuffer();
 
-  // Returns the remaining (unconsumed) data.
+  // Returns the remaining (unconsumed) data. Must only be called
+  // when IsRemainingDataContiguous() returns true.
   const char* GetRemainingData() const;
 
   // Returns the number of remaining (unconsumed) bytes.
   size_t GetRemainingSize() const;
 
+  // Returns whether the remaining data is stored in one piece. This
+  // is false only for a buffer constructed from a frame header and a
+  // separate payload whose header hasn't been consumed completely.
+  bool IsRemainingDataContiguous() const;
+
+  // Copies all of the remaining data, which need not be contiguous,
+  // to |dest| without consuming it. |dest| must have room for
+  // GetRemainingSize() bytes.
+  void CopyRemainingData(char* dest) const;
+
   // Add a callback to be called when bytes are consumed. The
   // ConsumeCallback should not do anything complicated; ideally it
   // should only update a counter. In particular, it must *not* cause
@@ -80,7 +100,8 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   //
   // This is used with Socket::Write(), which takes an IOBuffer* that
   // may be written to even after the socket itself is destroyed. (See
-  // http://crbug.com/249725 .)
+  // http://crbug.com/249725 .) Must only be called when
+  // IsRemainingDataContiguous() returns true.
   IOBuffer* GetIOBufferForRemainingData();
 
  private:
@@ -92,8 +113,17 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
 
   class SharedFrameIOBuffer;
 
+  // Returns the size of the data held in |shared_frame_|, which is
+  // followed by |payload_size_| bytes of |payload_|.
+  size_t GetFrameSize() const;
+
   const scoped_refptr<SharedFrame> shared_frame_;
+  // The payload following |shared_frame_|, if any.
+  const scoped_refptr<IOBuffer> payload_;
+  const size_t payload_size_;
   std::vector<ConsumeCallback> consume_callbacks_;
+  // The number of bytes consumed, counting from the start of
+  // |shared_frame_|.
   size_t offset_;
 
   DISALLOW_COPY_AND_ASSIGN(SpdyBuffer);
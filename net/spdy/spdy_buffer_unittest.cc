@@ -132,6 +132,63 @@ TEST_F(SpdyBufferTest, IOBufferForRemainingDataOutlivesBuffer) {
   std::memcpy(io_buffer->data(), kData, kDataSize);
 }
 
+// Construct a SpdyBuffer from a frame header and a separate payload
+// and make sure the payload isn't copied until the data is copied out.
+TEST_F(SpdyBufferTest, HeaderAndPayloadConstructor) {
+  scoped_refptr<IOBuffer> payload = new IOBuffer(kDataSize - 3);
+  std::memcpy(payload->data(), kData + 3, kDataSize - 3);
+  SpdyBuffer buffer(
+      scoped_ptr<SpdyFrame>(
+          new SpdyFrame(const_cast<char*>(kData), 3,
+                        false /* owns_buffer */)),
+      payload.get(), kDataSize - 3);
+
+  EXPECT_EQ(kDataSize, buffer.GetRemainingSize());
+  EXPECT_FALSE(buffer.IsRemainingDataContiguous());
+
+  // This mutation should be visible through |buffer|.
+  payload->data()[0] = 'L';
+  std::string expected_data(kData, kDataSize);
+  expected_data[3] = 'L';
+  std::string data(buffer.GetRemainingSize(), '\0');
+  buffer.CopyRemainingData(&data[0]);
+  EXPECT_EQ(expected_data, data);
+}
+
+// Consume a SpdyBuffer made of a frame header and a separate payload
+// past the header; the remaining data should then be contiguous.
+TEST_F(SpdyBufferTest, ConsumeHeaderAndPayload) {
+  scoped_refptr<IOBuffer> payload = new IOBuffer(kDataSize - 3);
+  std::memcpy(payload->data(), kData + 3, kDataSize - 3);
+  SpdyBuffer buffer(
+      scoped_ptr<SpdyFrame>(
+          new SpdyFrame(const_cast<char*>(kData), 3,
+                        false /* owns_buffer */)),
+      payload.get(), kDataSize - 3);
+
+  size_t x = 0;
+  buffer.AddConsumeCallback(
+      base::Bind(&IncrementBy, &x, SpdyBuffer::CONSUME));
+
+  buffer.Consume(2);
+  EXPECT_FALSE(buffer.IsRemainingDataContiguous());
+  std::string data(buffer.GetRemainingSize(), '\0');
+  buffer.CopyRemainingData(&data[0]);
+  EXPECT_EQ(std::string(kData + 2, kDataSize - 2), data);
+
+  buffer.Consume(3);
+  EXPECT_TRUE(buffer.IsRemainingDataContiguous());
+  EXPECT_EQ(payload->data() + 2, buffer.GetRemainingData());
+  EXPECT_EQ(std::string(kData + 5, kDataSize - 5), BufferToString(buffer));
+
+  scoped_refptr<IOBuffer> io_buffer = buffer.GetIOBufferForRemainingData();
+  EXPECT_EQ(payload->data() + 2, io_buffer->data());
+
+  buffer.Consume(kDataSize - 5);
+  EXPECT_EQ(0u, buffer.GetRemainingSize());
+  EXPECT_EQ(kDataSize, x);
+}
+
 }  // namespace
 
 }  // namespace net
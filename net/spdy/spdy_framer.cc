@@ -12,6 +12,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/stats_counters.h"
 #include "base/third_party/valgrind/memcheck.h"
+#include "net/spdy/hpack_decoder.h"
+#include "net/spdy/hpack_encoder.h"
 #include "net/spdy/spdy_frame_builder.h"
 #include "net/spdy/spdy_frame_reader.h"
 #include "net/spdy/spdy_bitmasks.h"
@@ -117,6 +119,7 @@ SpdyCredential::~SpdyCredential() {}
 SpdyFramer::SpdyFramer(SpdyMajorVersion version)
     : current_frame_buffer_(new char[kControlFrameBufferSize]),
       enable_compression_(true),
+      header_compression_(ZLIB_HEADER_COMPRESSION),
       visitor_(NULL),
       debug_visitor_(NULL),
       display_protocol_("SPDY"),
@@ -149,6 +152,7 @@ void SpdyFramer::Reset() {
   current_frame_length_ = 0;
   current_frame_stream_id_ = kInvalidStream;
   settings_scratch_.Reset();
+  hpack_header_block_buffer_.clear();
 }
 
 size_t SpdyFramer::GetDataFrameMinimumSize() const {
@@ -1229,9 +1233,13 @@ size_t SpdyFramer::ProcessControlFrameHeaderBlock(const char* data,
       current_frame_type_ != PUSH_PROMISE) {
     LOG(DFATAL) << "Unhandled frame type in ProcessControlFrameHeaderBlock.";
   }
+  const bool use_hpack =
+      enable_compression_ && header_compression_ == HPACK_HEADER_COMPRESSION;
   size_t process_bytes = std::min(data_len, remaining_data_length_);
   if (process_bytes > 0) {
-    if (enable_compression_) {
+    if (use_hpack) {
+      hpack_header_block_buffer_.append(data, process_bytes);
+    } else if (enable_compression_) {
       processed_successfully = IncrementallyDecompressControlFrameHeaderData(
           current_frame_stream_id_, data, process_bytes);
     } else {
@@ -1242,6 +1250,11 @@ size_t SpdyFramer::ProcessControlFrameHeaderBlock(const char* data,
     remaining_data_length_ -= process_bytes;
   }
 
+  if (use_hpack && remaining_data_length_ == 0) {
+    processed_successfully =
+        DeliverHpackControlFrameHeaderBlock(current_frame_stream_id_);
+  }
+
   // Handle the case that there is no futher data in this frame.
   if (remaining_data_length_ == 0 && processed_successfully) {
     // The complete header block has been delivered. We send a zero-length
@@ -1593,7 +1606,8 @@ SpdyFrame* SpdyFramer::CreateDataFrame(SpdyStreamId stream_id,
                                        uint32 len, SpdyDataFlags flags) const {
   DCHECK_EQ(0, flags & (!DATA_FLAG_FIN));
 
-  SpdyDataIR data_ir(stream_id, base::StringPiece(data, len));
+  SpdyDataIR data_ir(stream_id);
+  data_ir.SetDataShallow(base::StringPiece(data, len));
   data_ir.set_fin(flags & DATA_FLAG_FIN);
   return SerializeData(data_ir);
 }
@@ -2108,6 +2122,9 @@ size_t SpdyFramer::GetSerializedLength(const SpdyHeaderBlock& headers) {
   if (!enable_compression_) {
     return uncompressed_length;
   }
+  if (header_compression_ == HPACK_HEADER_COMPRESSION) {
+    return HpackEncoder::GetEncodedSizeBound(headers);
+  }
   z_stream* compressor = GetHeaderCompressor();
   // Since we'll be performing lots of flushes when compressing the data,
   // zlib's lower bounds may be insufficient.
@@ -2174,6 +2191,25 @@ z_stream* SpdyFramer::GetHeaderDecompressor() {
   return header_decompressor_.get();
 }
 
+HpackEncoder* SpdyFramer::GetHpackEncoder() {
+  if (!hpack_encoder_.get())
+    hpack_encoder_.reset(new HpackEncoder);
+  return hpack_encoder_.get();
+}
+
+HpackDecoder* SpdyFramer::GetHpackDecoder() {
+  if (!hpack_decoder_.get())
+    hpack_decoder_.reset(new HpackDecoder);
+  return hpack_decoder_.get();
+}
+
+void SpdyFramer::set_header_compression(HeaderCompression header_compression) {
+  DCHECK(!header_compressor_.get() && !header_decompressor_.get() &&
+         !hpack_encoder_.get() && !hpack_decoder_.get())
+      << "Header compression changed after header blocks were processed.";
+  header_compression_ = header_compression;
+}
+
 // Incrementally decompress the control frame's header block, feeding the
 // result to the visitor in chunks. Continue this until the visitor
 // indicates that it cannot process any more data, or (more commonly) we
@@ -2265,6 +2301,25 @@ bool SpdyFramer::IncrementallyDeliverControlFrameHeaderData(
   return read_successfully;
 }
 
+bool SpdyFramer::DeliverHpackControlFrameHeaderBlock(SpdyStreamId stream_id) {
+  SpdyHeaderBlock headers;
+  const bool decoded = GetHpackDecoder()->DecodeHeaderBlock(
+      hpack_header_block_buffer_, &headers);
+  hpack_header_block_buffer_.clear();
+  if (!decoded) {
+    DLOG(WARNING) << "Failed to decode HPACK header block.";
+    set_error(SPDY_DECOMPRESS_FAILURE);
+    return false;
+  }
+
+  // Visitors parse the same uncompressed block zlib would have produced.
+  SpdyFrameBuilder builder(GetSerializedLength(protocol_version(), &headers));
+  SerializeNameValueBlockWithoutCompression(&builder, headers);
+  scoped_ptr<SpdyFrame> block(builder.take());
+  return IncrementallyDeliverControlFrameHeaderData(stream_id, block->data(),
+                                                    block->size());
+}
+
 void SpdyFramer::SerializeNameValueBlockWithoutCompression(
     SpdyFrameBuilder* builder,
     const SpdyNameValueBlock& name_value_block) const {
@@ -2296,6 +2351,9 @@ void SpdyFramer::SerializeNameValueBlock(
     return SerializeNameValueBlockWithoutCompression(builder,
                                                      frame.name_value_block());
   }
+  if (header_compression_ == HPACK_HEADER_COMPRESSION) {
+    return SerializeNameValueBlockWithHpack(builder, frame.name_value_block());
+  }
 
   // First build an uncompressed version to be fed into the compressor.
   const size_t uncompressed_len = GetSerializedLength(
@@ -2358,4 +2416,23 @@ void SpdyFramer::SerializeNameValueBlock(
   compressed_frames.Increment();
 }
 
+void SpdyFramer::SerializeNameValueBlockWithHpack(
+    SpdyFrameBuilder* builder,
+    const SpdyNameValueBlock& name_value_block) {
+  base::StatsCounter compressed_frames("spdy.CompressedFrames");
+  base::StatsCounter pre_compress_bytes("spdy.PreCompressSize");
+  base::StatsCounter post_compress_bytes("spdy.PostCompressSize");
+
+  std::string encoded;
+  GetHpackEncoder()->EncodeHeaderBlock(name_value_block, &encoded);
+  builder->WriteBytes(encoded.data(), encoded.size());
+  builder->RewriteLength(*this);
+
+  pre_compress_bytes.Add(
+      GetSerializedLength(protocol_version(), &name_value_block));
+  post_compress_bytes.Add(encoded.size());
+
+  compressed_frames.Increment();
+}
+
 }  // namespace net
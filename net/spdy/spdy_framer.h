@@ -25,6 +25,8 @@ typedef struct z_stream_s z_stream;  // Forward declaration for zlib.
 
 namespace net {
 
+class HpackDecoder;
+class HpackEncoder;
 class HttpProxyClientSocketPoolTest;
 class HttpNetworkLayer;
 class HttpNetworkTransactionTest;
@@ -492,6 +494,22 @@ class NET_EXPORT_PRIVATE SpdyFramer {
     enable_compression_ = value;
   }
 
+  // How header blocks are compressed when compression is enabled. Both ends
+  // of a connection must use the same one.
+  enum HeaderCompression {
+    // A zlib stream primed with the SPDY dictionary.
+    ZLIB_HEADER_COMPRESSION,
+    // HPACK (RFC 7541): header fields are sent as indices into a small table
+    // of the header fields seen before, or as Huffman encoded literals.
+    // Keeps a few kilobytes of state per direction instead of zlib's window
+    // and hash tables.
+    HPACK_HEADER_COMPRESSION,
+  };
+
+  // Must be called before any header block is sent or received.
+  void set_header_compression(HeaderCompression header_compression);
+  HeaderCompression header_compression() const { return header_compression_; }
+
   // Used only in log messages.
   void set_display_protocol(const std::string& protocol) {
     display_protocol_ = protocol;
@@ -594,6 +612,10 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   z_stream* GetHeaderCompressor();
   z_stream* GetHeaderDecompressor();
 
+  // Get (and lazily initialize) the HPACK state.
+  HpackEncoder* GetHpackEncoder();
+  HpackDecoder* GetHpackDecoder();
+
  private:
   // Deliver the given control frame's uncompressed headers block to the
   // visitor in chunks. Returns true if the visitor has accepted all of the
@@ -602,6 +624,12 @@ class NET_EXPORT_PRIVATE SpdyFramer {
                                                   const char* data,
                                                   size_t len);
 
+  // Decodes the HPACK header block buffered in hpack_header_block_buffer_
+  // and delivers it to the visitor the way
+  // IncrementallyDeliverControlFrameHeaderData() does. Returns false and sets
+  // the error if the block cannot be decoded or is not accepted.
+  bool DeliverHpackControlFrameHeaderBlock(SpdyStreamId stream_id);
+
   // Utility to copy the given data block to the current frame buffer, up
   // to the given maximum number of bytes, and update the buffer
   // data (pointer and length). Returns the number of bytes
@@ -618,7 +646,12 @@ class NET_EXPORT_PRIVATE SpdyFramer {
       SpdyFrameBuilder* builder,
       const SpdyNameValueBlock& name_value_block) const;
 
-  // Compresses automatically according to enable_compression_.
+  void SerializeNameValueBlockWithHpack(
+      SpdyFrameBuilder* builder,
+      const SpdyNameValueBlock& name_value_block);
+
+  // Compresses automatically according to enable_compression_ and
+  // header_compression_.
   void SerializeNameValueBlock(
       SpdyFrameBuilder* builder,
       const SpdyFrameWithNameValueBlockIR& frame);
@@ -687,6 +720,13 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   scoped_ptr<z_stream> header_compressor_;
   scoped_ptr<z_stream> header_decompressor_;
 
+  HeaderCompression header_compression_;
+  scoped_ptr<HpackEncoder> hpack_encoder_;
+  scoped_ptr<HpackDecoder> hpack_decoder_;
+  // HPACK header blocks can only be decoded once complete, so their
+  // fragments are collected here.
+  std::string hpack_header_block_buffer_;
+
   SpdyFramerVisitorInterface* visitor_;
   SpdyFramerDebugVisitorInterface* debug_visitor_;
 
@@ -0,0 +1,205 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/process/process_handle.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "net/spdy/buffered_spdy_framer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumSessions = 1000;
+const int kNumHeaderBlocks = 20000;
+
+// Counts the header blocks received and the bytes of headers in them.
+class HeaderCountingVisitor : public BufferedSpdyFramerVisitorInterface {
+ public:
+  HeaderCountingVisitor()
+      : error_count_(0),
+        header_block_count_(0),
+        header_bytes_(0) {
+  }
+
+  virtual void OnError(SpdyFramer::SpdyError error_code) OVERRIDE {
+    ++error_count_;
+  }
+  virtual void OnStreamError(SpdyStreamId stream_id,
+                             const std::string& description) OVERRIDE {
+    ++error_count_;
+  }
+  virtual void OnSynStream(SpdyStreamId stream_id,
+                           SpdyStreamId associated_stream_id,
+                           SpdyPriority priority,
+                           uint8 credential_slot,
+                           bool fin,
+                           bool unidirectional,
+                           const SpdyHeaderBlock& headers) OVERRIDE {
+    ++header_block_count_;
+    for (SpdyHeaderBlock::const_iterator it = headers.begin();
+         it != headers.end(); ++it) {
+      header_bytes_ += it->first.size() + it->second.size();
+    }
+  }
+  virtual void OnSynReply(SpdyStreamId stream_id,
+                          bool fin,
+                          const SpdyHeaderBlock& headers) OVERRIDE {}
+  virtual void OnHeaders(SpdyStreamId stream_id,
+                         bool fin,
+                         const SpdyHeaderBlock& headers) OVERRIDE {}
+  virtual void OnStreamFrameData(SpdyStreamId stream_id,
+                                 const char* data,
+                                 size_t len,
+                                 bool fin) OVERRIDE {}
+  virtual void OnSettings(bool clear_persisted) OVERRIDE {}
+  virtual void OnSetting(SpdySettingsIds id,
+                         uint8 flags,
+                         uint32 value) OVERRIDE {}
+  virtual void OnPing(uint32 unique_id) OVERRIDE {}
+  virtual void OnRstStream(SpdyStreamId stream_id,
+                           SpdyRstStreamStatus status) OVERRIDE {}
+  virtual void OnGoAway(SpdyStreamId last_accepted_stream_id,
+                        SpdyGoAwayStatus status) OVERRIDE {}
+  virtual void OnWindowUpdate(SpdyStreamId stream_id,
+                              uint32 delta_window_size) OVERRIDE {}
+  virtual void OnPushPromise(SpdyStreamId stream_id,
+                             SpdyStreamId promised_stream_id) OVERRIDE {}
+
+  int error_count_;
+  int header_block_count_;
+  size_t header_bytes_;
+};
+
+// Request headers the way a browser sends them for the subresources of a
+// page: most headers repeat, the path and some cookies change.
+SpdyHeaderBlock MakeRequestHeaders(int i) {
+  SpdyHeaderBlock headers;
+  headers[":method"] = "GET";
+  headers[":path"] = base::StringPrintf("/static/images/sprite_%d.png", i);
+  headers[":version"] = "HTTP/1.1";
+  headers[":host"] = "www.example.com";
+  headers[":scheme"] = "https";
+  headers["accept"] = "image/webp,*/*;q=0.8";
+  headers["accept-encoding"] = "gzip,deflate,sdch";
+  headers["accept-language"] = "en-US,en;q=0.8";
+  headers["referer"] = "https://www.example.com/";
+  headers["user-agent"] =
+      "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+      "Chrome/31.0.1650.57 Safari/537.36";
+  headers["cookie"] = base::StringPrintf(
+      "PREF=ID=5e4cd3c8c6ff8a6b:U=63b2d0e2:FF=0:TM=1384292811; "
+      "NID=67=%08x; SID=DQAAAMgAAAAx", i * 2654435761u);
+  return headers;
+}
+
+SpdyFrame* CreateRequest(BufferedSpdyFramer* framer, int i) {
+  SpdyHeaderBlock headers = MakeRequestHeaders(i);
+  return framer->CreateSynStream(2 * i + 1,  // stream_id
+                                 0,          // associated_stream_id
+                                 1,          // priority
+                                 0,          // credential_slot
+                                 CONTROL_FLAG_FIN,
+                                 true,       // compress
+                                 &headers);
+}
+
+size_t GetWorkingSetSize() {
+  scoped_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          base::GetCurrentProcessHandle()));
+  return metrics->GetWorkingSetSize();
+}
+
+// Measures the memory held by the header compression state of sessions
+// which have each sent and received one header block.
+void MeasureMemoryPerSession(SpdyFramer::HeaderCompression compression,
+                             const char* name) {
+  BufferedSpdyFramer peer(SPDY3, true);
+  peer.set_header_compression(compression);
+  scoped_ptr<SpdyFrame> received(CreateRequest(&peer, 0));
+
+  HeaderCountingVisitor visitor;
+  ScopedVector<BufferedSpdyFramer> sessions;
+  const size_t working_set_before = GetWorkingSetSize();
+  for (int i = 0; i < kNumSessions; ++i) {
+    BufferedSpdyFramer* framer = new BufferedSpdyFramer(SPDY3, true);
+    sessions.push_back(framer);
+    framer->set_header_compression(compression);
+    framer->set_visitor(&visitor);
+    scoped_ptr<SpdyFrame> sent(CreateRequest(framer, i));
+    framer->ProcessInput(received->data(), received->size());
+  }
+  const size_t working_set_after = GetWorkingSetSize();
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(kNumSessions, visitor.header_block_count_);
+
+  base::LogPerfResult(
+      base::StringPrintf("SpdyFramer_%s_bytes_per_session", name).c_str(),
+      static_cast<double>(working_set_after - working_set_before) /
+          kNumSessions,
+      "bytes");
+}
+
+// Measures how fast header blocks are encoded and decoded over one
+// connection, and how small they get.
+void MeasureThroughput(SpdyFramer::HeaderCompression compression,
+                       const char* name) {
+  BufferedSpdyFramer sender(SPDY3, true);
+  sender.set_header_compression(compression);
+  BufferedSpdyFramer receiver(SPDY3, true);
+  receiver.set_header_compression(compression);
+  HeaderCountingVisitor visitor;
+  receiver.set_visitor(&visitor);
+
+  ScopedVector<SpdyFrame> frames;
+  size_t encoded_bytes = 0;
+  {
+    base::PerfTimeLogger timer(
+        base::StringPrintf("SpdyFramer_%s_encode", name).c_str());
+    for (int i = 0; i < kNumHeaderBlocks; ++i) {
+      frames.push_back(CreateRequest(&sender, i));
+      encoded_bytes += frames.back()->size();
+    }
+    timer.Done();
+  }
+  {
+    base::PerfTimeLogger timer(
+        base::StringPrintf("SpdyFramer_%s_decode", name).c_str());
+    for (size_t i = 0; i < frames.size(); ++i)
+      receiver.ProcessInput(frames[i]->data(), frames[i]->size());
+    timer.Done();
+  }
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(kNumHeaderBlocks, visitor.header_block_count_);
+
+  base::LogPerfResult(
+      base::StringPrintf("SpdyFramer_%s_compression_ratio", name).c_str(),
+      static_cast<double>(visitor.header_bytes_) / encoded_bytes, "x");
+  base::LogPerfResult(
+      base::StringPrintf("SpdyFramer_%s_bytes_per_block", name).c_str(),
+      static_cast<double>(encoded_bytes) / kNumHeaderBlocks, "bytes");
+}
+
+}  // namespace
+
+TEST(SpdyFramerPerfTest, MemoryPerSession) {
+  MeasureMemoryPerSession(SpdyFramer::ZLIB_HEADER_COMPRESSION, "zlib");
+  MeasureMemoryPerSession(SpdyFramer::HPACK_HEADER_COMPRESSION, "hpack");
+}
+
+TEST(SpdyFramerPerfTest, EncodeDecode) {
+  MeasureThroughput(SpdyFramer::ZLIB_HEADER_COMPRESSION, "zlib");
+  MeasureThroughput(SpdyFramer::HPACK_HEADER_COMPRESSION, "hpack");
+}
+
+}  // namespace net
@@ -1647,6 +1647,64 @@ TEST_P(SpdyFramerTest, HeaderCompression) {
   EXPECT_EQ(kValue3, decompressed_headers[kHeader3]);
 }
 
+TEST_P(SpdyFramerTest, HpackHeaderCompression) {
+  SpdyFramer send_framer(spdy_version_);
+  send_framer.set_header_compression(SpdyFramer::HPACK_HEADER_COMPRESSION);
+
+  SpdyHeaderBlock headers;
+  headers["server"] = "SpdyServer 1.0";
+  headers["date"] = "Mon 12 Jan 2009 12:12:12 PST";
+  headers["status"] = "200";
+  headers["version"] = "HTTP/1.1";
+  headers["content-type"] = "text/html";
+  headers["content-length"] = "12";
+  headers["set-cookie"] = std::string("a=b") + '\0' + "c=d";
+
+  scoped_ptr<SpdyFrame> syn_frame_1(
+      send_framer.CreateSynStream(1,  // stream id
+                                  0,  // associated stream id
+                                  1,  // priority
+                                  0,  // credential slot
+                                  CONTROL_FLAG_NONE,
+                                  true,  // compress
+                                  &headers));
+  ASSERT_TRUE(syn_frame_1.get() != NULL);
+  scoped_ptr<SpdyFrame> syn_frame_2(
+      send_framer.CreateSynStream(3,  // stream id
+                                  0,  // associated stream id
+                                  1,  // priority
+                                  0,  // credential slot
+                                  CONTROL_FLAG_NONE,
+                                  true,  // compress
+                                  &headers));
+  ASSERT_TRUE(syn_frame_2.get() != NULL);
+
+  // The second block only refers to the header table, one byte per header.
+  EXPECT_EQ(send_framer.GetSynStreamMinimumSize() + headers.size(),
+            syn_frame_2->size());
+
+  // Both blocks are delivered to the visitor uncompressed, even when they
+  // arrive in small chunks.
+  TestSpdyVisitor visitor(spdy_version_);
+  visitor.use_compression_ = true;
+  visitor.framer_.set_header_compression(
+      SpdyFramer::HPACK_HEADER_COMPRESSION);
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(syn_frame_1->data()),
+      syn_frame_1->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(1, visitor.syn_frame_count_);
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+
+  visitor.headers_.clear();
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(syn_frame_2->data()),
+      syn_frame_2->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(2, visitor.syn_frame_count_);
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+}
+
 // Verify we don't leak when we leave streams unclosed
 TEST_P(SpdyFramerTest, UnclosedStreamDataCompressors) {
   SpdyFramer send_framer(spdy_version_);
@@ -3414,6 +3472,42 @@ TEST_P(SpdyFramerTest, DecompressCorruptHeaderBlock) {
   EXPECT_EQ(0u, visitor.header_buffer_length_);
 }
 
+TEST_P(SpdyFramerTest, DecodeOutOfSyncHpackHeaderBlock) {
+  SpdyHeaderBlock headers;
+  headers["aa"] = "alpha beta gamma delta";
+  SpdyFramer framer(spdy_version_);
+  framer.set_header_compression(SpdyFramer::HPACK_HEADER_COMPRESSION);
+  scoped_ptr<SpdyFrame> control_frame_1(
+      framer.CreateSynStream(1,                     // stream_id
+                             0,                     // associated_stream_id
+                             1,                     // priority
+                             0,                     // credential_slot
+                             CONTROL_FLAG_NONE,
+                             true,                  // compress
+                             &headers));
+  scoped_ptr<SpdyFrame> control_frame_2(
+      framer.CreateSynStream(3,                     // stream_id
+                             0,                     // associated_stream_id
+                             1,                     // priority
+                             0,                     // credential_slot
+                             CONTROL_FLAG_NONE,
+                             true,                  // compress
+                             &headers));
+  // The second header block refers to a header table entry added by the
+  // first one, which the receiving framer never saw.
+  TestSpdyVisitor visitor(spdy_version_);
+  visitor.use_compression_ = true;
+  visitor.framer_.set_header_compression(
+      SpdyFramer::HPACK_HEADER_COMPRESSION);
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(control_frame_2->data()),
+      control_frame_2->size());
+  EXPECT_EQ(1, visitor.error_count_);
+  EXPECT_EQ(SpdyFramer::SPDY_DECOMPRESS_FAILURE, visitor.framer_.error_code())
+      << SpdyFramer::ErrorCodeToString(framer.error_code());
+  EXPECT_EQ(0u, visitor.header_buffer_length_);
+}
+
 TEST_P(SpdyFramerTest, ControlFrameSizesAreValidated) {
   // Create a GoAway frame that has a few extra bytes at the end.
   // We create enough overhead to overflow the framer's control frame buffer.
@@ -363,6 +363,22 @@ SpdySession::PushedStreamInfo::PushedStreamInfo(
 
 SpdySession::PushedStreamInfo::~PushedStreamInfo() {}
 
+SpdySession::InFlightWrite::InFlightWrite()
+    : frame_type(DATA),
+      buffer(NULL),
+      frame_size(0) {}
+
+SpdySession::InFlightWrite::InFlightWrite(
+    SpdyFrameType frame_type,
+    SpdyBuffer* buffer,
+    const base::WeakPtr<SpdyStream>& stream)
+    : frame_type(frame_type),
+      buffer(buffer),
+      frame_size(buffer->GetRemainingSize()),
+      stream(stream) {}
+
+SpdySession::InFlightWrite::~InFlightWrite() {}
+
 SpdySession::SpdySession(
     const SpdySessionKey& spdy_session_key,
     const base::WeakPtr<HttpServerProperties>& http_server_properties,
@@ -384,8 +400,6 @@ SpdySession::SpdySession(
       http_server_properties_(http_server_properties),
       read_buffer_(new IOBuffer(kReadBufferSize)),
       stream_hi_water_mark_(kFirstStreamId),
-      in_flight_write_frame_type_(DATA),
-      in_flight_write_frame_size_(0),
       is_secure_(false),
       certificate_error_code_(OK),
       availability_state_(STATE_AVAILABLE),
@@ -454,6 +468,8 @@ SpdySession::~SpdySession() {
   // With SPDY we can't recycle sockets.
   connection_->socket()->Disconnect();
 
+  ClearInFlightWrites();
+
   RecordHistograms();
 
   net_log_.EndEvent(NetLog::TYPE_SPDY_SESSION);
@@ -939,14 +955,17 @@ scoped_ptr<SpdyBuffer> SpdySession::CreateDataBuffer(SpdyStreamId stream_id,
   if (effective_len > 0)
     SendPrefacePingIfNoneInFlight();
 
-  // TODO(mbelshe): reduce memory copies here.
+  // Only the frame header is serialized; the payload is gathered from
+  // |data| when the frame is written.
   DCHECK(buffered_spdy_framer_.get());
-  scoped_ptr<SpdyFrame> frame(
-      buffered_spdy_framer_->CreateDataFrame(
+  scoped_ptr<SpdyFrame> frame_header(
+      buffered_spdy_framer_->CreateDataFrameHeader(
           stream_id, data->data(),
           static_cast<uint32>(effective_len), flags));
 
-  scoped_ptr<SpdyBuffer> data_buffer(new SpdyBuffer(frame.Pass()));
+  scoped_ptr<SpdyBuffer> data_buffer(
+      new SpdyBuffer(frame_header.Pass(), data,
+                     static_cast<size_t>(effective_len)));
 
   if (flow_control_state_ == FLOW_CONTROL_STREAM_AND_SESSION) {
     DecreaseSendWindowSize(static_cast<int32>(effective_len));
@@ -1287,44 +1306,70 @@ int SpdySession::DoWrite() {
   DCHECK_NE(availability_state_, STATE_CLOSED);
 
   DCHECK(buffered_spdy_framer_);
-  if (in_flight_write_) {
-    DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  if (!in_flight_writes_.empty()) {
+    DCHECK_GT(in_flight_writes_.front().buffer->GetRemainingSize(), 0u);
   } else {
-    // Grab the next frame to send.
-    SpdyFrameType frame_type = DATA;
-    scoped_ptr<SpdyBufferProducer> producer;
-    base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream)) {
-      write_state_ = WRITE_STATE_IDLE;
-      return ERR_IO_PENDING;
-    }
+    // Grab the next frames to send, until enough has been gathered
+    // for a single write.
+    size_t gathered_size = 0;
+    while (gathered_size < static_cast<size_t>(kMaxSpdyWriteGatherSize)) {
+      SpdyFrameType frame_type = DATA;
+      scoped_ptr<SpdyBufferProducer> producer;
+      base::WeakPtr<SpdyStream> stream;
+      if (!write_queue_.Dequeue(&frame_type, &producer, &stream))
+        break;
+
+      if (stream.get())
+        DCHECK(!stream->IsClosed());
+
+      // Activate the stream only when sending the SYN_STREAM frame to
+      // guarantee monotonically-increasing stream IDs.
+      if (frame_type == SYN_STREAM) {
+        if (stream.get() && stream->stream_id() == 0) {
+          scoped_ptr<SpdyStream> owned_stream =
+              ActivateCreatedStream(stream.get());
+          InsertActivatedStream(owned_stream.Pass());
+        } else {
+          NOTREACHED();
+          return ERR_UNEXPECTED;
+        }
+      }
 
-    if (stream.get())
-      DCHECK(!stream->IsClosed());
-
-    // Activate the stream only when sending the SYN_STREAM frame to
-    // guarantee monotonically-increasing stream IDs.
-    if (frame_type == SYN_STREAM) {
-      if (stream.get() && stream->stream_id() == 0) {
-        scoped_ptr<SpdyStream> owned_stream =
-            ActivateCreatedStream(stream.get());
-        InsertActivatedStream(owned_stream.Pass());
-      } else {
+      scoped_ptr<SpdyBuffer> buffer = producer->ProduceBuffer();
+      if (!buffer) {
         NOTREACHED();
         return ERR_UNEXPECTED;
       }
+      DCHECK_GE(buffer->GetRemainingSize(),
+                buffered_spdy_framer_->GetFrameMinimumSize());
+      gathered_size += buffer->GetRemainingSize();
+      in_flight_writes_.push_back(
+          InFlightWrite(frame_type, buffer.release(), stream));
+    }
+
+    if (in_flight_writes_.empty()) {
+      write_state_ = WRITE_STATE_IDLE;
+      return ERR_IO_PENDING;
     }
 
-    in_flight_write_ = producer->ProduceBuffer();
-    if (!in_flight_write_) {
-      NOTREACHED();
-      return ERR_UNEXPECTED;
+    // A single frame whose data is in one piece is written as is;
+    // otherwise the frames are copied into one buffer, which also
+    // gathers DATA frame payloads that aren't stored with their frame
+    // header.
+    if (in_flight_writes_.size() > 1 ||
+        !in_flight_writes_.front().buffer->IsRemainingDataContiguous()) {
+      scoped_refptr<IOBuffer> gathered_buffer = new IOBuffer(gathered_size);
+      char* dest = gathered_buffer->data();
+      for (std::deque<InFlightWrite>::const_iterator it =
+               in_flight_writes_.begin();
+           it != in_flight_writes_.end(); ++it) {
+        it->buffer->CopyRemainingData(dest);
+        dest += it->buffer->GetRemainingSize();
+      }
+      in_flight_write_buffer_ =
+          new DrainableIOBuffer(gathered_buffer.get(),
+                                static_cast<int>(gathered_size));
     }
-    in_flight_write_frame_type_ = frame_type;
-    in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
-    DCHECK_GE(in_flight_write_frame_size_,
-              buffered_spdy_framer_->GetFrameMinimumSize());
-    in_flight_write_stream_ = stream;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
@@ -1332,11 +1377,20 @@ int SpdySession::DoWrite() {
   // Explicitly store in a scoped_refptr<IOBuffer> to avoid problems
   // with Socket implementations that don't store their IOBuffer
   // argument in a scoped_refptr<IOBuffer> (see crbug.com/232345).
-  scoped_refptr<IOBuffer> write_io_buffer =
-      in_flight_write_->GetIOBufferForRemainingData();
+  scoped_refptr<IOBuffer> write_io_buffer;
+  int write_size = 0;
+  if (in_flight_write_buffer_.get()) {
+    write_io_buffer = in_flight_write_buffer_;
+    write_size = in_flight_write_buffer_->BytesRemaining();
+  } else {
+    DCHECK_EQ(in_flight_writes_.size(), 1u);
+    SpdyBuffer* buffer = in_flight_writes_.front().buffer;
+    write_io_buffer = buffer->GetIOBufferForRemainingData();
+    write_size = static_cast<int>(buffer->GetRemainingSize());
+  }
   return connection_->socket()->Write(
       write_io_buffer.get(),
-      in_flight_write_->GetRemainingSize(),
+      write_size,
       base::Bind(&SpdySession::PumpWriteLoop,
                  weak_factory_.GetWeakPtr(), WRITE_STATE_DO_WRITE_COMPLETE));
 }
@@ -1345,16 +1399,13 @@ int SpdySession::DoWriteComplete(int result) {
   CHECK(in_io_loop_);
   DCHECK_NE(availability_state_, STATE_CLOSED);
   DCHECK_NE(result, ERR_IO_PENDING);
-  DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  DCHECK(!in_flight_writes_.empty());
 
   last_activity_time_ = time_func_();
 
   if (result < 0) {
     DCHECK_NE(result, ERR_IO_PENDING);
-    in_flight_write_.reset();
-    in_flight_write_frame_type_ = DATA;
-    in_flight_write_frame_size_ = 0;
-    in_flight_write_stream_.reset();
+    ClearInFlightWrites();
     CloseSessionResult close_session_result =
         DoCloseSession(static_cast<Error>(result), "Write error");
     DCHECK_EQ(close_session_result, SESSION_CLOSED_BUT_NOT_REMOVED);
@@ -1363,37 +1414,66 @@ int SpdySession::DoWriteComplete(int result) {
     return result;
   }
 
-  // It should not be possible to have written more bytes than our
-  // in_flight_write_.
-  DCHECK_LE(static_cast<size_t>(result),
-            in_flight_write_->GetRemainingSize());
-
   if (result > 0) {
-    in_flight_write_->Consume(static_cast<size_t>(result));
+    size_t bytes_written = static_cast<size_t>(result);
+    if (in_flight_write_buffer_.get()) {
+      // It should not be possible to have written more bytes than we
+      // gathered.
+      DCHECK_LE(result, in_flight_write_buffer_->BytesRemaining());
+      in_flight_write_buffer_->DidConsume(result);
+    } else {
+      DCHECK_LE(bytes_written,
+                in_flight_writes_.front().buffer->GetRemainingSize());
+    }
+
+    while (bytes_written > 0) {
+      DCHECK(!in_flight_writes_.empty());
+      InFlightWrite in_flight_write = in_flight_writes_.front();
+      size_t consume_size =
+          std::min(bytes_written, in_flight_write.buffer->GetRemainingSize());
+      in_flight_write.buffer->Consume(consume_size);
+      bytes_written -= consume_size;
+
+      // We only notify the stream when we've fully written the
+      // pending frame.
+      if (in_flight_write.buffer->GetRemainingSize() > 0)
+        break;
+
+      // Cleanup the write which just completed before notifying the
+      // stream, which may enqueue more frames.
+      in_flight_writes_.pop_front();
+      delete in_flight_write.buffer;
 
-    // We only notify the stream when we've fully written the pending frame.
-    if (in_flight_write_->GetRemainingSize() == 0) {
       // It is possible that the stream was cancelled while we were
       // writing to the socket.
-      if (in_flight_write_stream_.get()) {
-        DCHECK_GT(in_flight_write_frame_size_, 0u);
-        in_flight_write_stream_->OnFrameWriteComplete(
-            in_flight_write_frame_type_,
-            in_flight_write_frame_size_);
+      if (in_flight_write.stream.get()) {
+        DCHECK_GT(in_flight_write.frame_size, 0u);
+        in_flight_write.stream->OnFrameWriteComplete(
+            in_flight_write.frame_type,
+            in_flight_write.frame_size);
       }
-
-      // Cleanup the write which just completed.
-      in_flight_write_.reset();
-      in_flight_write_frame_type_ = DATA;
-      in_flight_write_frame_size_ = 0;
-      in_flight_write_stream_.reset();
     }
+
+    if (in_flight_writes_.empty())
+      in_flight_write_buffer_ = NULL;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE;
   return OK;
 }
 
+void SpdySession::ClearInFlightWrites() {
+  // Move the writes out first, since deleting a buffer may run
+  // consume callbacks.
+  std::deque<InFlightWrite> in_flight_writes;
+  in_flight_writes.swap(in_flight_writes_);
+  in_flight_write_buffer_ = NULL;
+  for (std::deque<InFlightWrite>::iterator it = in_flight_writes.begin();
+       it != in_flight_writes.end(); ++it) {
+    delete it->buffer;
+  }
+}
+
 void SpdySession::DcheckGoingAway() const {
   DCHECK_GE(availability_state_, STATE_GOING_AWAY);
   if (DCHECK_IS_ON()) {
@@ -1665,7 +1745,7 @@ void SpdySession::EnqueueWrite(RequestPriority priority,
   write_queue_.Enqueue(priority, frame_type, producer.Pass(), stream);
   if (write_state_ == WRITE_STATE_IDLE) {
     DCHECK(was_idle);
-    DCHECK(!in_flight_write_);
+    DCHECK(in_flight_writes_.empty());
     write_state_ = WRITE_STATE_DO_WRITE;
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
@@ -1703,12 +1783,14 @@ void SpdySession::InsertActivatedStream(scoped_ptr<SpdyStream> stream) {
 }
 
 void SpdySession::DeleteStream(scoped_ptr<SpdyStream> stream, int status) {
-  if (in_flight_write_stream_.get() == stream.get()) {
-    // If we're deleting the stream for the in-flight write, we still
-    // need to let the write complete, so we clear
-    // |in_flight_write_stream_| and let the write finish on its own
-    // without notifying |in_flight_write_stream_|.
-    in_flight_write_stream_.reset();
+  for (std::deque<InFlightWrite>::iterator it = in_flight_writes_.begin();
+       it != in_flight_writes_.end(); ++it) {
+    if (it->stream.get() == stream.get()) {
+      // If we're deleting the stream for an in-flight write, we still
+      // need to let the write complete, so we clear its stream and let
+      // the write finish on its own without notifying the stream.
+      it->stream.reset();
+    }
   }
 
   write_queue_.RemovePendingWritesForStream(stream->GetWeakPtr());
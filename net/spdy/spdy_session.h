@@ -47,6 +47,11 @@ const int kMss = 1430;
 // The 8 is the size of the SPDY frame header.
 const int kMaxSpdyFrameChunkSize = (2 * kMss) - 8;
 
+// Queued frames are gathered into a single socket write until at least
+// this many bytes have been gathered. This is also the number of bytes
+// of DATA frames a stream queues ahead of the one being written.
+const int kMaxSpdyWriteGatherSize = 16 * 1024;
+
 // Maximum number of concurrent streams we will create, unless the server
 // sends a SETTINGS frame with a different value.
 const size_t kInitialMaxConcurrentStreams = 100;
@@ -503,6 +508,24 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   };
   typedef std::map<GURL, PushedStreamInfo> PushedStreamMap;
 
+  struct InFlightWrite {
+    InFlightWrite();
+    InFlightWrite(SpdyFrameType frame_type,
+                  SpdyBuffer* buffer,
+                  const base::WeakPtr<SpdyStream>& stream);
+    ~InFlightWrite();
+
+    SpdyFrameType frame_type;
+    // This has to be a raw pointer since we store this in an STL
+    // container. Owned by the session.
+    SpdyBuffer* buffer;
+    // The size of the frame in |buffer|.
+    size_t frame_size;
+    // The stream to notify when |buffer| has been written to the
+    // socket completely.
+    base::WeakPtr<SpdyStream> stream;
+  };
+
   typedef std::set<SpdyStream*> CreatedStreamSet;
 
   enum AvailabilityState {
@@ -631,6 +654,10 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   int DoWrite();
   int DoWriteComplete(int result);
 
+  // Deletes the buffers of |in_flight_writes_|, discarding whatever
+  // hasn't been written yet.
+  void ClearInFlightWrites();
+
   // TODO(akalin): Rename the Send* and Write* functions below to
   // Enqueue*.
 
@@ -970,17 +997,14 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // The write queue.
   SpdyWriteQueue write_queue_;
 
-  // Data for the frame we are currently sending.
-
-  // The buffer we're currently writing.
-  scoped_ptr<SpdyBuffer> in_flight_write_;
-  // The type of the frame in |in_flight_write_|.
-  SpdyFrameType in_flight_write_frame_type_;
-  // The size of the frame in |in_flight_write_|.
-  size_t in_flight_write_frame_size_;
-  // The stream to notify when |in_flight_write_| has been written to
-  // the socket completely.
-  base::WeakPtr<SpdyStream> in_flight_write_stream_;
+  // Data for the frames we are currently sending.
+
+  // The frames we're currently writing, in the order they are written.
+  std::deque<InFlightWrite> in_flight_writes_;
+  // The remaining data of |in_flight_writes_| gathered into a single
+  // buffer, or NULL if the only in-flight frame is written directly
+  // from its SpdyBuffer.
+  scoped_refptr<DrainableIOBuffer> in_flight_write_buffer_;
 
   // Flag if we're using an SSL connection for this SpdySession.
   bool is_secure_;
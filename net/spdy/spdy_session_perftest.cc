@@ -0,0 +1,143 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "net/base/net_log.h"
+#include "net/base/request_priority.h"
+#include "net/http/http_network_session.h"
+#include "net/socket/next_proto.h"
+#include "net/socket/socket_test_util.h"
+#include "net/spdy/spdy_session.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_stream_test_util.h"
+#include "net/spdy/spdy_test_util_common.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const char kUploadUrl[] = "http://www.google.com/upload";
+const int kUploadSize = 64 * 1024 * 1024;
+
+// Accepts every write synchronously and counts them. Reads never
+// complete.
+class CountingSocketDataProvider : public StaticSocketDataProvider {
+ public:
+  CountingSocketDataProvider()
+      : StaticSocketDataProvider(&read_, 1, NULL, 0),
+        read_(SYNCHRONOUS, ERR_IO_PENDING),
+        write_count_(0),
+        bytes_written_(0) {}
+
+  virtual MockWriteResult OnWrite(const std::string& data) OVERRIDE {
+    ++write_count_;
+    bytes_written_ += data.size();
+    return MockWriteResult(SYNCHRONOUS, static_cast<int>(data.size()));
+  }
+
+  int write_count() const { return write_count_; }
+  int64 bytes_written() const { return bytes_written_; }
+
+ private:
+  MockRead read_;
+  int write_count_;
+  int64 bytes_written_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingSocketDataProvider);
+};
+
+// Sends the body once the request headers have been sent and quits
+// |run_loop| once all of it has been written to the socket.
+class UploadDelegate : public test::StreamDelegateWithBody {
+ public:
+  UploadDelegate(const base::WeakPtr<SpdyStream>& stream,
+                 base::StringPiece data,
+                 base::RunLoop* run_loop)
+      : StreamDelegateWithBody(stream, data),
+        run_loop_(run_loop) {}
+  virtual ~UploadDelegate() {}
+
+  virtual void OnDataSent() OVERRIDE {
+    StreamDelegateWithBody::OnDataSent();
+    run_loop_->Quit();
+  }
+
+ private:
+  base::RunLoop* const run_loop_;
+
+  DISALLOW_COPY_AND_ASSIGN(UploadDelegate);
+};
+
+// Uploads a large request body on a single stream. The body is split
+// into DATA frames of at most kMaxSpdyFrameChunkSize bytes, which the
+// session gathers into writes of about kMaxSpdyWriteGatherSize
+// bytes. SPDY/2 is used since it has no flow control, so the upload
+// never waits for WINDOW_UPDATE frames.
+TEST(SpdySessionPerfTest, BulkUpload) {
+  base::MessageLoopForIO message_loop;
+
+  SpdySessionDependencies session_deps(kProtoDeprecatedSPDY2);
+  CountingSocketDataProvider data;
+  data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+  session_deps.socket_factory->AddSocketDataProvider(&data);
+  scoped_refptr<HttpNetworkSession> http_session(
+      SpdySessionDependencies::SpdyCreateSession(&session_deps));
+
+  SpdySessionKey key(HostPortPair("www.google.com", 80),
+                     ProxyServer::Direct(), kPrivacyModeDisabled);
+  base::WeakPtr<SpdySession> session =
+      CreateInsecureSpdySession(http_session, key, BoundNetLog());
+
+  GURL url(kUploadUrl);
+  base::WeakPtr<SpdyStream> stream =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session, url,
+                                LOWEST, BoundNetLog());
+  ASSERT_TRUE(stream.get() != NULL);
+
+  base::RunLoop run_loop;
+  std::string body(kUploadSize, 'x');
+  UploadDelegate delegate(stream, body, &run_loop);
+  stream->SetDelegate(&delegate);
+
+  SpdyTestUtil spdy_util(kProtoDeprecatedSPDY2);
+  scoped_ptr<SpdyHeaderBlock> headers(
+      spdy_util.ConstructPostHeaderBlock(kUploadUrl, kUploadSize));
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::PerfTimeLogger timer("SpdySession_bulk_upload");
+  stream->SendRequestHeaders(headers.Pass(), MORE_DATA_TO_SEND);
+  run_loop.Run();
+  timer.Done();
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  EXPECT_LT(kUploadSize, data.bytes_written());
+  base::LogPerfResult("SpdySession_bulk_upload_throughput",
+                      kUploadSize / elapsed.InSecondsF() / (1024 * 1024),
+                      "MB/s");
+  base::LogPerfResult("SpdySession_bulk_upload_bytes_per_write",
+                      static_cast<double>(data.bytes_written()) /
+                          data.write_count(),
+                      "bytes");
+
+  stream->Cancel();
+  session->CloseSessionOnError(ERR_ABORTED, std::string());
+  base::MessageLoop::current()->RunUntilIdle();
+}
+
+}  // namespace
+
+}  // namespace net
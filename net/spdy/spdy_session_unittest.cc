@@ -8,6 +8,7 @@
 #include "base/callback.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/run_loop.h"
+#include "base/stl_util.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_log_unittest.h"
@@ -1477,6 +1478,82 @@ TEST_P(SpdySessionTest, OutOfOrderSynStreams) {
   EXPECT_EQ(1u, delegate_highest.stream_id());
 }
 
+// Frames queued while the session isn't writing should be gathered
+// into a single socket write, in priority order.
+TEST_P(SpdySessionTest, GatherQueuedFramesIntoOneWrite) {
+  MockConnect connect_data(SYNCHRONOUS, OK);
+  scoped_ptr<SpdyFrame> req_highest(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 1, HIGHEST, true));
+  scoped_ptr<SpdyFrame> req_lowest(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 3, LOWEST, true));
+  const SpdyFrame* reqs[] = { req_highest.get(), req_lowest.get() };
+  std::string combined_reqs(req_highest->size() + req_lowest->size(), '\0');
+  int combined_reqs_len =
+      CombineFrames(reqs, arraysize(reqs), string_as_array(&combined_reqs),
+                    static_cast<int>(combined_reqs.size()));
+  ASSERT_EQ(static_cast<int>(combined_reqs.size()), combined_reqs_len);
+  MockWrite writes[] = {
+    MockWrite(ASYNC, combined_reqs.data(), combined_reqs_len, 0),
+  };
+
+  MockRead reads[] = {
+    MockRead(ASYNC, 0, 1)  // EOF
+  };
+
+  session_deps_.host_resolver->set_synchronous_mode(true);
+
+  DeterministicSocketData data(reads, arraysize(reads),
+                               writes, arraysize(writes));
+  data.set_connect_data(connect_data);
+  session_deps_.deterministic_socket_factory->AddSocketDataProvider(&data);
+
+  SSLSocketDataProvider ssl(SYNCHRONOUS, OK);
+  session_deps_.deterministic_socket_factory->AddSSLSocketDataProvider(&ssl);
+
+  CreateDeterministicNetworkSession();
+
+  base::WeakPtr<SpdySession> session =
+      CreateInsecureSpdySession(http_session_, key_, BoundNetLog());
+
+  GURL url("http://www.google.com");
+
+  base::WeakPtr<SpdyStream> spdy_stream_lowest =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                session, url, LOWEST, BoundNetLog());
+  ASSERT_TRUE(spdy_stream_lowest);
+  test::StreamDelegateDoNothing delegate_lowest(spdy_stream_lowest);
+  spdy_stream_lowest->SetDelegate(&delegate_lowest);
+
+  base::WeakPtr<SpdyStream> spdy_stream_highest =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                session, url, HIGHEST, BoundNetLog());
+  ASSERT_TRUE(spdy_stream_highest);
+  test::StreamDelegateDoNothing delegate_highest(spdy_stream_highest);
+  spdy_stream_highest->SetDelegate(&delegate_highest);
+
+  scoped_ptr<SpdyHeaderBlock> headers_lowest(
+      spdy_util_.ConstructGetHeaderBlock(url.spec()));
+  spdy_stream_lowest->SendRequestHeaders(
+      headers_lowest.Pass(), NO_MORE_DATA_TO_SEND);
+
+  scoped_ptr<SpdyHeaderBlock> headers_highest(
+      spdy_util_.ConstructGetHeaderBlock(url.spec()));
+  spdy_stream_highest->SendRequestHeaders(
+      headers_highest.Pass(), NO_MORE_DATA_TO_SEND);
+
+  data.RunFor(1);
+
+  EXPECT_EQ(3u, spdy_stream_lowest->stream_id());
+  EXPECT_EQ(1u, spdy_stream_highest->stream_id());
+  EXPECT_TRUE(data.at_write_eof());
+
+  data.RunFor(1);
+
+  EXPECT_FALSE(spdy_stream_lowest);
+  EXPECT_FALSE(spdy_stream_highest);
+  EXPECT_TRUE(session == NULL);
+}
+
 TEST_P(SpdySessionTest, CancelStream) {
   MockConnect connect_data(SYNCHRONOUS, OK);
   // Request 1, at HIGHEST priority, will be cancelled before it writes data.
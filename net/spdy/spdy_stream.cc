@@ -101,6 +101,7 @@ SpdyStream::SpdyStream(SpdyStreamType type,
       send_status_(
           (type_ == SPDY_PUSH_STREAM) ?
           NO_MORE_DATA_TO_SEND : MORE_DATA_TO_SEND),
+      pending_send_data_queued_size_(0),
       request_time_(base::Time::Now()),
       response_headers_status_(RESPONSE_HEADERS_ARE_INCOMPLETE),
       io_state_((type_ == SPDY_PUSH_STREAM) ? STATE_IDLE : STATE_NONE),
@@ -595,6 +596,7 @@ void SpdyStream::SendData(IOBuffer* data,
   CHECK_GE(io_state_, STATE_SEND_REQUEST_HEADERS_COMPLETE);
   CHECK(!pending_send_data_.get());
   pending_send_data_ = new DrainableIOBuffer(data, length);
+  DCHECK_EQ(pending_send_data_queued_size_, 0);
   send_status_ = send_status;
   QueueNextDataFrame();
 }
@@ -787,11 +789,20 @@ int SpdyStream::DoOpen() {
   send_bytes_ += frame_payload_size;
 
   pending_send_data_->DidConsume(frame_payload_size);
+  pending_send_data_queued_size_ -= static_cast<int>(frame_payload_size);
+  DCHECK_GE(pending_send_data_queued_size_, 0);
   if (pending_send_data_->BytesRemaining() > 0) {
-    QueueNextDataFrame();
+    // Keep queueing frames ahead, unless we're waiting to be resumed
+    // by PossiblyResumeIfSendStalled().
+    if (!send_stalled_by_flow_control_ &&
+        pending_send_data_->BytesRemaining() >
+            pending_send_data_queued_size_) {
+      QueueNextDataFrame();
+    }
     return ERR_IO_PENDING;
   }
 
+  DCHECK_EQ(pending_send_data_queued_size_, 0);
   pending_send_data_ = NULL;
 
   CHECK(delegate_);
@@ -838,39 +849,53 @@ void SpdyStream::QueueNextDataFrame() {
   DCHECK_GT(io_state_, STATE_SEND_REQUEST_HEADERS_COMPLETE);
   CHECK_GT(stream_id_, 0u);
   CHECK(pending_send_data_.get());
-  CHECK_GT(pending_send_data_->BytesRemaining(), 0);
+  CHECK_GT(pending_send_data_->BytesRemaining(),
+           pending_send_data_queued_size_);
 
   SpdyDataFlags flags =
       (send_status_ == NO_MORE_DATA_TO_SEND) ?
       DATA_FLAG_FIN : DATA_FLAG_NONE;
-  scoped_ptr<SpdyBuffer> data_buffer(
-      session_->CreateDataBuffer(stream_id_,
-                                 pending_send_data_.get(),
-                                 pending_send_data_->BytesRemaining(),
-                                 flags));
-  // We'll get called again by PossiblyResumeIfSendStalled().
-  if (!data_buffer)
-    return;
+  do {
+    // The frame refers to the data instead of copying it, which is
+    // fine since |pending_send_data_| isn't touched until the frame
+    // has been written.
+    scoped_refptr<DrainableIOBuffer> frame_data =
+        new DrainableIOBuffer(pending_send_data_.get(),
+                              pending_send_data_->BytesRemaining());
+    frame_data->SetOffset(pending_send_data_queued_size_);
+    scoped_ptr<SpdyBuffer> data_buffer(
+        session_->CreateDataBuffer(stream_id_,
+                                   frame_data.get(),
+                                   frame_data->BytesRemaining(),
+                                   flags));
+    // We'll get called again by PossiblyResumeIfSendStalled().
+    if (!data_buffer)
+      return;
 
-  if (session_->flow_control_state() >= SpdySession::FLOW_CONTROL_STREAM) {
     DCHECK_GE(data_buffer->GetRemainingSize(),
               session_->GetDataFrameMinimumSize());
     size_t payload_size =
         data_buffer->GetRemainingSize() - session_->GetDataFrameMinimumSize();
     DCHECK_LE(payload_size, session_->GetDataFrameMaximumPayload());
-    DecreaseSendWindowSize(static_cast<int32>(payload_size));
-    // This currently isn't strictly needed, since write frames are
-    // discarded only if the stream is about to be closed. But have it
-    // here anyway just in case this changes.
-    data_buffer->AddConsumeCallback(
-        base::Bind(&SpdyStream::OnWriteBufferConsumed,
-                   GetWeakPtr(), payload_size));
-  }
+    pending_send_data_queued_size_ += static_cast<int>(payload_size);
+
+    if (session_->flow_control_state() >= SpdySession::FLOW_CONTROL_STREAM) {
+      DecreaseSendWindowSize(static_cast<int32>(payload_size));
+      // This currently isn't strictly needed, since write frames are
+      // discarded only if the stream is about to be closed. But have it
+      // here anyway just in case this changes.
+      data_buffer->AddConsumeCallback(
+          base::Bind(&SpdyStream::OnWriteBufferConsumed,
+                     GetWeakPtr(), payload_size));
+    }
 
-  session_->EnqueueStreamWrite(
-      GetWeakPtr(), DATA,
-      scoped_ptr<SpdyBufferProducer>(
-          new SimpleBufferProducer(data_buffer.Pass())));
+    session_->EnqueueStreamWrite(
+        GetWeakPtr(), DATA,
+        scoped_ptr<SpdyBufferProducer>(
+            new SimpleBufferProducer(data_buffer.Pass())));
+  } while (pending_send_data_->BytesRemaining() >
+               pending_send_data_queued_size_ &&
+           pending_send_data_queued_size_ < kMaxSpdyWriteGatherSize);
 }
 
 int SpdyStream::MergeWithResponseHeaders(
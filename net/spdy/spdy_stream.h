@@ -446,9 +446,11 @@ class NET_EXPORT_PRIVATE SpdyStream {
   scoped_ptr<SpdyFrame> ProduceHeaderFrame(
       scoped_ptr<SpdyHeaderBlock> header_block);
 
-  // Queues the send for next frame of the remaining data in
-  // |pending_send_data_|. Must be called only when
-  // |pending_send_data_| is set.
+  // Queues the sends for the next frames of the remaining data in
+  // |pending_send_data_| that hasn't been queued yet, up to
+  // kMaxSpdyWriteGatherSize bytes ahead of the frame being written so
+  // that the session can gather them into a single write. Must be
+  // called only when |pending_send_data_| has unqueued data.
   void QueueNextDataFrame();
 
   // Merge the given headers into |response_headers_| and calls
@@ -499,6 +501,9 @@ class NET_EXPORT_PRIVATE SpdyStream {
 
   // The data waiting to be sent.
   scoped_refptr<DrainableIOBuffer> pending_send_data_;
+  // The number of bytes at the start of |pending_send_data_| which
+  // are in queued DATA frames.
+  int pending_send_data_queued_size_;
 
   // The time at which the request was made that resulted in this response.
   // For cached responses, this time could be "far" in the past.
@@ -437,6 +437,69 @@ TEST_P(SpdyStreamTest, SendLargeDataAfterOpenBidirectional) {
   EXPECT_TRUE(data.at_write_eof());
 }
 
+// Make sure that the frames of a large block of data are gathered
+// into a single socket write.
+TEST_P(SpdyStreamTest, SendLargeDataGathersFrames) {
+  GURL url(kStreamUrl);
+
+  session_ = SpdySessionDependencies::SpdyCreateSession(&session_deps_);
+
+  scoped_ptr<SpdyFrame> req(
+      spdy_util_.ConstructSpdyPost(
+          kStreamUrl, 1, kPostBodyLength, LOWEST, NULL, 0));
+  AddWrite(*req);
+
+  scoped_ptr<SpdyFrame> resp(spdy_util_.ConstructSpdyPostSynReply(NULL, 0));
+  AddRead(*resp);
+
+  std::string chunk_data(kMaxSpdyFrameChunkSize, 'x');
+  scoped_ptr<SpdyFrame> chunk(
+      spdy_util_.ConstructSpdyBodyFrame(
+          1, chunk_data.data(), chunk_data.length(), false));
+  const SpdyFrame* chunks[] = { chunk.get(), chunk.get(), chunk.get() };
+  std::string combined_chunks(3 * chunk->size(), '\0');
+  int combined_chunks_len =
+      CombineFrames(chunks, arraysize(chunks),
+                    string_as_array(&combined_chunks),
+                    static_cast<int>(combined_chunks.size()));
+  ASSERT_EQ(static_cast<int>(combined_chunks.size()), combined_chunks_len);
+  // All three DATA frames have to be written at once.
+  SpdyFrame combined_frame(string_as_array(&combined_chunks),
+                           combined_chunks.size(), false);
+  AddWrite(combined_frame);
+
+  AddReadEOF();
+
+  OrderedSocketData data(GetReads(), GetNumReads(),
+                         GetWrites(), GetNumWrites());
+  MockConnect connect_data(SYNCHRONOUS, OK);
+  data.set_connect_data(connect_data);
+
+  session_deps_.socket_factory->AddSocketDataProvider(&data);
+
+  base::WeakPtr<SpdySession> session(CreateDefaultSpdySession());
+
+  base::WeakPtr<SpdyStream> stream =
+      CreateStreamSynchronously(
+          SPDY_BIDIRECTIONAL_STREAM, session, url, LOWEST, BoundNetLog());
+  ASSERT_TRUE(stream.get() != NULL);
+
+  std::string body_data(3 * kMaxSpdyFrameChunkSize, 'x');
+  StreamDelegateSendImmediate delegate(stream, body_data);
+  stream->SetDelegate(&delegate);
+
+  scoped_ptr<SpdyHeaderBlock> headers(
+      spdy_util_.ConstructPostHeaderBlock(kStreamUrl, kPostBodyLength));
+  EXPECT_EQ(ERR_IO_PENDING,
+            stream->SendRequestHeaders(headers.Pass(), MORE_DATA_TO_SEND));
+
+  EXPECT_EQ(ERR_CONNECTION_CLOSED, delegate.WaitForClose());
+
+  EXPECT_TRUE(delegate.send_headers_completed());
+  EXPECT_EQ(std::string(), delegate.TakeReceivedData());
+  EXPECT_TRUE(data.at_write_eof());
+}
+
 // Receiving a header with uppercase ASCII should result in a protocol
 // error.
 TEST_P(SpdyStreamTest, UpperCaseHeaders) {
@@ -0,0 +1,127 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/ssl/file_ssl_session_store.h"
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/location.h"
+#include "base/pickle.h"
+#include "base/sequenced_task_runner.h"
+
+namespace net {
+
+namespace {
+
+// Version number of the file format.
+const int kVersion = 1;
+
+void ReadFile(const base::FilePath& path, std::string* data) {
+  if (!base::ReadFileToString(path, data))
+    data->clear();
+}
+
+}  // namespace
+
+const size_t FileSSLSessionStore::kMaxSessions = 256;
+
+FileSSLSessionStore::FileSSLSessionStore(
+    const base::FilePath& path,
+    base::SequencedTaskRunner* task_runner)
+    : sessions_(kMaxSessions),
+      task_runner_(task_runner),
+      writer_(path, task_runner),
+      weak_factory_(this) {
+}
+
+FileSSLSessionStore::~FileSSLSessionStore() {
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+}
+
+void FileSSLSessionStore::Load(const base::Closure& callback) {
+  DCHECK(CalledOnValidThread());
+  std::string* data = new std::string;
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadFile, writer_.path(), data),
+      base::Bind(&FileSSLSessionStore::OnFileRead, weak_factory_.GetWeakPtr(),
+                 callback, base::Owned(data)));
+}
+
+void FileSSLSessionStore::GetAllSessions(SessionList* sessions) {
+  DCHECK(CalledOnValidThread());
+  for (SessionMap::const_reverse_iterator it = sessions_.rbegin();
+       it != sessions_.rend(); ++it) {
+    sessions->push_back(*it);
+  }
+}
+
+void FileSSLSessionStore::SetSession(const std::string& key,
+                                     const std::string& session) {
+  DCHECK(CalledOnValidThread());
+  sessions_.Put(key, session);
+  writer_.ScheduleWrite(this);
+}
+
+void FileSSLSessionStore::DeleteSession(const std::string& key) {
+  DCHECK(CalledOnValidThread());
+  SessionMap::iterator it = sessions_.Peek(key);
+  if (it == sessions_.end())
+    return;
+  sessions_.Erase(it);
+  writer_.ScheduleWrite(this);
+}
+
+void FileSSLSessionStore::DeleteAll() {
+  DCHECK(CalledOnValidThread());
+  sessions_.Clear();
+  writer_.ScheduleWrite(this);
+}
+
+bool FileSSLSessionStore::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+  Pickle pickle;
+  pickle.WriteInt(kVersion);
+  pickle.WriteUInt32(static_cast<uint32>(sessions_.size()));
+  // Oldest first, so that reading the file back preserves the order.
+  for (SessionMap::const_reverse_iterator it = sessions_.rbegin();
+       it != sessions_.rend(); ++it) {
+    pickle.WriteString(it->first);
+    pickle.WriteString(it->second);
+  }
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  return true;
+}
+
+void FileSSLSessionStore::OnFileRead(const base::Closure& callback,
+                                     const std::string* data) {
+  DCHECK(CalledOnValidThread());
+  Pickle pickle(data->data(), data->size());
+  PickleIterator iter(pickle);
+  int version;
+  uint32 num_sessions;
+  if (iter.ReadInt(&version) && version == kVersion &&
+      iter.ReadUInt32(&num_sessions)) {
+    // Sessions which are already in the store are newer than the saved ones,
+    // so they are put back in front of them.
+    SessionList newer_sessions;
+    GetAllSessions(&newer_sessions);
+    for (uint32 i = 0; i < num_sessions; ++i) {
+      std::string key;
+      std::string session;
+      if (!iter.ReadString(&key) || !iter.ReadString(&session))
+        break;
+      sessions_.Put(key, session);
+    }
+    for (SessionList::const_iterator it = newer_sessions.begin();
+         it != newer_sessions.end(); ++it) {
+      sessions_.Put(it->first, it->second);
+    }
+  }
+  callback.Run();
+}
+
+}  // namespace net
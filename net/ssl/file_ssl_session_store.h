@@ -0,0 +1,75 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SSL_FILE_SSL_SESSION_STORE_H_
+#define NET_SSL_FILE_SSL_SESSION_STORE_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/callback_forward.h"
+#include "base/compiler_specific.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+#include "net/ssl/ssl_session_store.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// An SSLSessionStore which keeps the kMaxSessions most recently stored
+// sessions, and saves them to a file a few seconds after they change.
+class NET_EXPORT FileSSLSessionStore
+    : public SSLSessionStore,
+      public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  static const size_t kMaxSessions;
+
+  // The file is read and written on |task_runner|.
+  FileSSLSessionStore(const base::FilePath& path,
+                      base::SequencedTaskRunner* task_runner);
+
+  // Starts writing out any pending changes.
+  virtual ~FileSSLSessionStore();
+
+  // Reads the sessions saved in the file, and runs |callback| once they have
+  // been added to the store. Sessions stored before then take precedence over
+  // the ones in the file.
+  void Load(const base::Closure& callback);
+
+  // SSLSessionStore implementation.
+  virtual void GetAllSessions(SessionList* sessions) OVERRIDE;
+  virtual void SetSession(const std::string& key,
+                          const std::string& session) OVERRIDE;
+  virtual void DeleteSession(const std::string& key) OVERRIDE;
+  virtual void DeleteAll() OVERRIDE;
+
+  // base::ImportantFileWriter::DataSerializer implementation.
+  virtual bool SerializeData(std::string* data) OVERRIDE;
+
+ private:
+  typedef base::MRUCache<std::string, std::string> SessionMap;
+
+  void OnFileRead(const base::Closure& callback, const std::string* data);
+
+  SessionMap sessions_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<FileSSLSessionStore> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileSSLSessionStore);
+};
+
+}  // namespace net
+
+#endif  // NET_SSL_FILE_SSL_SESSION_STORE_H_
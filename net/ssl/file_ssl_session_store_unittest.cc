@@ -0,0 +1,142 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/ssl/file_ssl_session_store.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+class FileSSLSessionStoreTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("SSL Sessions");
+  }
+
+  scoped_ptr<FileSSLSessionStore> CreateStore() {
+    return scoped_ptr<FileSSLSessionStore>(new FileSSLSessionStore(
+        path_, base::MessageLoopProxy::current()));
+  }
+
+  void Load(FileSSLSessionStore* store) {
+    base::RunLoop run_loop;
+    store->Load(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  // Destroys |store|, and waits for it to finish writing the file.
+  void Shutdown(scoped_ptr<FileSSLSessionStore> store) {
+    store.reset();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(FileSSLSessionStoreTest, LoadWithoutFile) {
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  Load(store.get());
+
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  EXPECT_TRUE(sessions.empty());
+}
+
+TEST_F(FileSSLSessionStoreTest, SaveAndLoad) {
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  Load(store.get());
+  store->SetSession("a.com:443/", "session a");
+  store->SetSession("b.com:443/", "session b");
+  store->SetSession("b.com:443/pm/", "private session b");
+  store->SetSession("c.com:443/", "session c");
+  store->DeleteSession("c.com:443/");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  ASSERT_EQ(3u, sessions.size());
+  EXPECT_EQ("a.com:443/", sessions[0].first);
+  EXPECT_EQ("session a", sessions[0].second);
+  EXPECT_EQ("b.com:443/", sessions[1].first);
+  EXPECT_EQ("session b", sessions[1].second);
+  EXPECT_EQ("b.com:443/pm/", sessions[2].first);
+  EXPECT_EQ("private session b", sessions[2].second);
+}
+
+TEST_F(FileSSLSessionStoreTest, DeleteAll) {
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  store->SetSession("a.com:443/", "session a");
+  store->DeleteAll();
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  EXPECT_TRUE(sessions.empty());
+}
+
+// Sessions stored while the file is being loaded are newer than the ones in
+// it.
+TEST_F(FileSSLSessionStoreTest, LoadKeepsNewerSessions) {
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  store->SetSession("a.com:443/", "old session a");
+  store->SetSession("b.com:443/", "session b");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  store->SetSession("a.com:443/", "new session a");
+  Load(store.get());
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  ASSERT_EQ(2u, sessions.size());
+  EXPECT_EQ("b.com:443/", sessions[0].first);
+  EXPECT_EQ("a.com:443/", sessions[1].first);
+  EXPECT_EQ("new session a", sessions[1].second);
+}
+
+TEST_F(FileSSLSessionStoreTest, KeepsMostRecentSessions) {
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  for (size_t i = 0; i <= FileSSLSessionStore::kMaxSessions; ++i)
+    store->SetSession(base::Uint64ToString(i), "session");
+  Shutdown(store.Pass());
+
+  store = CreateStore();
+  Load(store.get());
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  ASSERT_EQ(FileSSLSessionStore::kMaxSessions, sessions.size());
+  EXPECT_EQ("1", sessions.front().first);
+  EXPECT_EQ(base::Uint64ToString(FileSSLSessionStore::kMaxSessions),
+            sessions.back().first);
+}
+
+TEST_F(FileSSLSessionStoreTest, IgnoresCorruptFile) {
+  ASSERT_EQ(4, file_util::WriteFile(path_, "junk", 4));
+
+  scoped_ptr<FileSSLSessionStore> store(CreateStore());
+  Load(store.get());
+  SSLSessionStore::SessionList sessions;
+  store->GetAllSessions(&sessions);
+  EXPECT_TRUE(sessions.empty());
+}
+
+}  // namespace
+
+}  // namespace net
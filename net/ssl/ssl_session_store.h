@@ -0,0 +1,43 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SSL_SSL_SESSION_STORE_H_
+#define NET_SSL_SSL_SESSION_STORE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "net/base/net_export.h"
+
+namespace net {
+
+// An interface for keeping the sessions of the SSL client session cache
+// across restarts, so that the first handshake with each server after a
+// restart can be resumed. See SSLClientSocket::SetSessionStore().
+//
+// Sessions are opaque serialized blobs. They are keyed by host:port and by
+// session cache shard, which also tells apart privacy mode connections.
+class NET_EXPORT SSLSessionStore {
+ public:
+  // (key, session) pairs, least recently used first.
+  typedef std::vector<std::pair<std::string, std::string> > SessionList;
+
+  virtual ~SSLSessionStore() {}
+
+  // Appends all the sessions in the store to |sessions|.
+  virtual void GetAllSessions(SessionList* sessions) = 0;
+
+  // Stores |session| for |key|, replacing any previous session for |key|.
+  virtual void SetSession(const std::string& key,
+                          const std::string& session) = 0;
+
+  virtual void DeleteSession(const std::string& key) = 0;
+
+  virtual void DeleteAll() = 0;
+};
+
+}  // namespace net
+
+#endif  // NET_SSL_SSL_SESSION_STORE_H_
@@ -8,6 +8,7 @@
 #include <netinet/tcp.h>  // For TCP_NODELAY
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <string>
 
@@ -24,9 +25,12 @@ SMAcceptorThread::SMAcceptorThread(FlipAcceptor *acceptor,
                                    MemoryCache* memory_cache)
     : SimpleThread("SMAcceptorThread"),
       acceptor_(acceptor),
+      listen_fd_(acceptor->listen_fd_),
+      owns_listen_fd_(false),
       ssl_state_(NULL),
       use_ssl_(false),
       idle_socket_timeout_s_(acceptor->idle_socket_timeout_s_),
+      oldest_time_(time(NULL)),
       quitting_(false),
       memory_cache_(memory_cache) {
   if (!acceptor->ssl_cert_filename_.empty() &&
@@ -54,6 +58,8 @@ SMAcceptorThread::~SMAcceptorThread() {
     delete *i;
   }
   delete ssl_state_;
+  if (owns_listen_fd_)
+    close(listen_fd_);
 }
 
 SMConnection* SMAcceptorThread::NewConnection() {
@@ -76,8 +82,18 @@ SMConnection* SMAcceptorThread::FindOrMakeNewSMConnection() {
   return server;
 }
 
+bool SMAcceptorThread::CreateOwnListenSocket() {
+  DCHECK(!owns_listen_fd_);
+  int listen_fd = acceptor_->CreateListenSocket();
+  if (listen_fd == -1)
+    return false;
+  listen_fd_ = listen_fd;
+  owns_listen_fd_ = true;
+  return true;
+}
+
 void SMAcceptorThread::InitWorker() {
-  epoll_server_.RegisterFD(acceptor_->listen_fd_, this, EPOLLIN | EPOLLET);
+  epoll_server_.RegisterFD(listen_fd_, this, EPOLLIN | EPOLLET);
 }
 
 void SMAcceptorThread::HandleConnection(int server_fd,
@@ -118,11 +134,11 @@ void SMAcceptorThread::AcceptFromListenFD() {
     for (int i = 0; i < acceptor_->accepts_per_wake_; ++i) {
       struct sockaddr address;
       socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
+      int fd = accept(listen_fd_, &address, &socklen);
       if (fd == -1) {
         if (errno != 11) {
           VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
+                  << listen_fd_ << "): " << errno << ": "
                   << strerror(errno);
         }
         break;
@@ -134,11 +150,11 @@ void SMAcceptorThread::AcceptFromListenFD() {
     while (true) {
       struct sockaddr address;
       socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
+      int fd = accept(listen_fd_, &address, &socklen);
       if (fd == -1) {
         if (errno != 11) {
           VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
+                  << listen_fd_ << "): " << errno << ": "
                   << strerror(errno);
         }
         break;
@@ -150,12 +166,10 @@ void SMAcceptorThread::AcceptFromListenFD() {
 }
 
 void SMAcceptorThread::HandleConnectionIdleTimeout() {
-  static time_t oldest_time = time(NULL);
-
   int cur_time = time(NULL);
   // Only iterate the list if we speculate that a connection is ready to be
   // expired
-  if ((cur_time - oldest_time) < idle_socket_timeout_s_)
+  if ((cur_time - oldest_time_) < idle_socket_timeout_s_)
     return;
 
   // TODO(mbelshe): This code could be optimized, active_server_connections_
@@ -169,12 +183,12 @@ void SMAcceptorThread::HandleConnectionIdleTimeout() {
       iter = active_server_connections_.erase(iter);
       continue;
     }
-    if (conn->last_read_time_ < oldest_time)
-      oldest_time = conn->last_read_time_;
+    if (conn->last_read_time_ < oldest_time_)
+      oldest_time_ = conn->last_read_time_;
     iter++;
   }
-  if ((cur_time - oldest_time) >= idle_socket_timeout_s_)
-    oldest_time = cur_time;
+  if ((cur_time - oldest_time_) >= idle_socket_timeout_s_)
+    oldest_time_ = cur_time;
 }
 
 void SMAcceptorThread::Run() {
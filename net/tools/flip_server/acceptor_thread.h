@@ -64,6 +64,11 @@ class SMAcceptorThread : public base::SimpleThread,
   // TODO(mbelshe): figure out if we can move these to private functions.
   SMConnection* NewConnection();
   SMConnection* FindOrMakeNewSMConnection();
+  // Accepts on a listening socket of its own rather than on the shared one
+  // of the acceptor, so that the kernel spreads new connections across the
+  // workers of the acceptor. Requires the acceptor to use SO_REUSEPORT. Must
+  // be called before InitWorker().
+  bool CreateOwnListenSocket();
   void InitWorker();
   void HandleConnection(int server_fd, struct sockaddr_in *remote_addr);
   void AcceptFromListenFD();
@@ -80,6 +85,10 @@ class SMAcceptorThread : public base::SimpleThread,
  private:
   EpollServer epoll_server_;
   FlipAcceptor* acceptor_;
+  // Either the listening socket of |acceptor_|, which is shared with the
+  // other workers of the acceptor, or one owned by this thread.
+  int listen_fd_;
+  bool owns_listen_fd_;
   SSLState* ssl_state_;
   bool use_ssl_;
   int idle_socket_timeout_s_;
@@ -88,6 +97,9 @@ class SMAcceptorThread : public base::SimpleThread,
   std::vector<SMConnection*> tmp_unused_server_connections_;
   std::vector<SMConnection*> allocated_server_connections_;
   std::list<SMConnection*> active_server_connections_;
+  // The last read time of the least recently active connection, as of the
+  // last idle check.
+  time_t oldest_time_;
   Notification quitting_;
   MemoryCache* memory_cache_;
 };
@@ -41,6 +41,11 @@ class FlipAcceptor {
                void *memory_cache);
   ~FlipAcceptor();
 
+  // Creates a non-blocking socket listening on the address of the acceptor.
+  // Once |listen_fd_| exists, this only succeeds with |reuseport_|. Returns
+  // -1 on failure.
+  int CreateListenSocket();
+
   enum FlipHandlerType flip_handler_type_;
   std::string listen_ip_;
   std::string listen_port_;
@@ -54,6 +59,8 @@ class FlipAcceptor {
   int accept_backlog_size_;
   bool disable_nagle_;
   int accepts_per_wake_;
+  bool reuseport_;
+  bool wait_for_iface_;
   int listen_fd_;
   void* memory_cache_;
   int ssl_session_expiry_;
@@ -91,6 +98,9 @@ class FlipConfig {
   int ssl_session_expiry_;
   bool ssl_disable_compression_;
   int idle_socket_timeout_s_;
+  // The number of worker threads, each with its own EpollServer, that
+  // accept and serve the connections of every acceptor.
+  int num_workers_;
 };
 
 }  // namespace
@@ -204,6 +204,10 @@ int main (int argc, char**argv)
     cout << "\t--ssl-session-expiry=<seconds> (default is 300)\n";
     cout << "\t--ssl-disable-compression\n";
     cout << "\t--idle-timeout=<seconds> (default is 300)\n";
+    cout << "\t--workers=<number of threads per listen ip:port> (default 1)\n";
+    cout << "\t--reuseport\n";
+    cout << "\t  * Every worker gets a listening socket of its own. Requires"
+         << " SO_REUSEPORT.\n";
     cout << "\t--pidfile=<filepath> (default /var/run/flip-server.pid)\n";
     cout << "\t--help\n";
     exit(0);
@@ -266,6 +270,15 @@ int main (int argc, char**argv)
       atoi(cl.GetSwitchValueASCII("idle-timeout").c_str());
   }
 
+  if (cl.HasSwitch("workers")) {
+    g_proxy_config.num_workers_ =
+      atoi(cl.GetSwitchValueASCII("workers").c_str());
+    CHECK_GT(g_proxy_config.num_workers_, 0);
+  }
+
+  if (cl.HasSwitch("reuseport"))
+    FLAGS_reuseport = true;
+
   if (cl.HasSwitch("force_spdy"))
     net::SMConnection::set_force_spdy(true);
 
@@ -296,6 +309,7 @@ int main (int argc, char**argv)
             << g_proxy_config.ssl_disable_compression_;
   LOG(INFO) << "Connection idle timeout : "
             << g_proxy_config.idle_socket_timeout_s_;
+  LOG(INFO) << "Workers per acceptor    : " << g_proxy_config.num_workers_;
 
   // Proxy Acceptors
   while (true) {
@@ -379,22 +393,26 @@ int main (int argc, char**argv)
 
   std::vector<net::SMAcceptorThread*> sm_worker_threads_;
 
+  // The memory caches are not modified anymore, so all the workers of an
+  // acceptor share one. The connections of an acceptor are spread across its
+  // workers either by the kernel, when each has its own SO_REUSEPORT socket,
+  // or by whichever worker accept()s first on the shared socket.
   for (i = 0; i < g_proxy_config.acceptors_.size(); i++) {
     net::FlipAcceptor *acceptor = g_proxy_config.acceptors_[i];
 
-    sm_worker_threads_.push_back(
-        new net::SMAcceptorThread(acceptor,
-                                  (net::MemoryCache *)acceptor->memory_cache_));
-    // Note that spdy_memory_cache is not threadsafe, it is merely
-    // thread compatible. Thus, if ever we are to spawn multiple threads,
-    // we either must make the MemoryCache threadsafe, or use
-    // a separate MemoryCache for each thread.
-    //
-    // The latter is what is currently being done as we spawn
-    // a separate thread for each http and spdy server acceptor.
-
-    sm_worker_threads_.back()->InitWorker();
-    sm_worker_threads_.back()->Start();
+    for (int worker = 0; worker < g_proxy_config.num_workers_; ++worker) {
+      sm_worker_threads_.push_back(new net::SMAcceptorThread(
+          acceptor, (net::MemoryCache *)acceptor->memory_cache_));
+      if (worker > 0 && FLAGS_reuseport &&
+          !sm_worker_threads_.back()->CreateOwnListenSocket()) {
+        LOG(ERROR) << "Worker " << worker << " shares the listening socket "
+                   << "of " << acceptor->listen_ip_ << ":"
+                   << acceptor->listen_port_;
+      }
+
+      sm_worker_threads_.back()->InitWorker();
+      sm_worker_threads_.back()->Start();
+    }
   }
 
   while (!wantExit) {
@@ -0,0 +1,188 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "net/tools/balsa/balsa_frame.h"
+#include "net/tools/balsa/balsa_headers.h"
+#include "net/tools/balsa/noop_balsa_visitor.h"
+#include "net/tools/flip_server/acceptor_thread.h"
+#include "net/tools/flip_server/flip_config.h"
+#include "net/tools/flip_server/mem_cache.h"
+#include "net/tools/flip_server/spdy_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const char kHost[] = "www.example.com";
+const char kPath[] = "/index.html";
+const size_t kBodySize = 4 * 1024;
+const int kNumClients = 16;
+const int kRequestsPerClient = 2000;
+
+// Sends |kRequestsPerClient| requests one after the other on a keep-alive
+// connection, reading each response before sending the next request.
+class ClientThread : public base::SimpleThread {
+ public:
+  explicit ClientThread(int port)
+      : SimpleThread("FlipServerPerfTestClient"),
+        port_(port),
+        responses_(0) {}
+
+  virtual void Run() OVERRIDE {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(-1, fd);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port_);
+    ASSERT_EQ(0, connect(fd, reinterpret_cast<struct sockaddr*>(&address),
+                         sizeof(address)));
+
+    const std::string request = base::StringPrintf(
+        "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", kPath, kHost);
+    NoOpBalsaVisitor visitor;
+    BalsaHeaders headers;
+    BalsaFrame framer;
+    framer.set_is_request(false);
+    framer.set_balsa_visitor(&visitor);
+    framer.set_balsa_headers(&headers);
+    char buffer[16 * 1024];
+    for (int i = 0; i < kRequestsPerClient; ++i) {
+      ASSERT_EQ(static_cast<ssize_t>(request.size()),
+                write(fd, request.data(), request.size()));
+      while (!framer.MessageFullyRead()) {
+        ssize_t bytes_read = read(fd, buffer, sizeof(buffer));
+        ASSERT_GT(bytes_read, 0);
+        // The framer stops at the end of the headers, so it may have to be
+        // called more than once for the input of a read.
+        size_t bytes_consumed = 0;
+        while (bytes_consumed < static_cast<size_t>(bytes_read)) {
+          size_t bytes_processed = framer.ProcessInput(
+              buffer + bytes_consumed, bytes_read - bytes_consumed);
+          ASSERT_FALSE(framer.Error());
+          ASSERT_GT(bytes_processed, 0u);
+          bytes_consumed += bytes_processed;
+        }
+      }
+      ASSERT_EQ("200", headers.response_code());
+      framer.Reset();
+      ++responses_;
+    }
+    close(fd);
+  }
+
+  int responses() const { return responses_; }
+
+ private:
+  const int port_;
+  int responses_;
+
+  DISALLOW_COPY_AND_ASSIGN(ClientThread);
+};
+
+class FlipServerPerfTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    BalsaHeaders headers;
+    headers.SetResponseFirstlineFromStringPieces("HTTP/1.1", "200", "OK");
+    headers.AppendHeader("transfer-encoding", "chunked");
+    headers.AppendHeader("connection", "keep-alive");
+    memory_cache_.InsertFile(&headers, EncodeURL(kPath, kHost, "GET"),
+                             std::string(kBodySize, 'x'));
+
+    acceptor_.reset(new FlipAcceptor(FLIP_HANDLER_HTTP_SERVER,
+                                     "127.0.0.1", "0",
+                                     std::string(), std::string(),
+                                     std::string(), std::string(),
+                                     std::string(), std::string(),
+                                     0,  // spdy_only
+                                     1024,  // accept_backlog_size
+                                     true,  // disable_nagle
+                                     0,  // accepts_per_wake
+                                     false,  // reuseport
+                                     false,  // wait_for_iface
+                                     &memory_cache_));
+    ASSERT_NE(-1, acceptor_->listen_fd_);
+    struct sockaddr_in address;
+    socklen_t address_len = sizeof(address);
+    ASSERT_EQ(0, getsockname(acceptor_->listen_fd_,
+                             reinterpret_cast<struct sockaddr*>(&address),
+                             &address_len));
+    port_ = ntohs(address.sin_port);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    close(acceptor_->listen_fd_);
+  }
+
+  // Serves the requests of |kNumClients| concurrent clients with
+  // |num_workers| threads sharing |memory_cache_|, and logs the requests
+  // served per second.
+  void RunWithWorkers(int num_workers) {
+    ScopedVector<SMAcceptorThread> workers;
+    for (int i = 0; i < num_workers; ++i) {
+      workers.push_back(new SMAcceptorThread(acceptor_.get(), &memory_cache_));
+      workers.back()->InitWorker();
+      workers.back()->Start();
+    }
+
+    ScopedVector<ClientThread> clients;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kNumClients; ++i) {
+      clients.push_back(new ClientThread(port_));
+      clients.back()->Start();
+    }
+    int responses = 0;
+    for (int i = 0; i < kNumClients; ++i) {
+      clients[i]->Join();
+      responses += clients[i]->responses();
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    for (int i = 0; i < num_workers; ++i)
+      workers[i]->Quit();
+    for (int i = 0; i < num_workers; ++i)
+      workers[i]->Join();
+
+    EXPECT_EQ(kNumClients * kRequestsPerClient, responses);
+    base::LogPerfResult(
+        base::StringPrintf("FlipServer_requests_per_second_%d_workers",
+                           num_workers).c_str(),
+        responses / elapsed.InSecondsF(), "requests/s");
+  }
+
+  MemoryCache memory_cache_;
+  scoped_ptr<FlipAcceptor> acceptor_;
+  int port_;
+};
+
+TEST_F(FlipServerPerfTest, OneWorker) {
+  RunWithWorkers(1);
+}
+
+TEST_F(FlipServerPerfTest, TwoWorkers) {
+  RunWithWorkers(2);
+}
+
+TEST_F(FlipServerPerfTest, FourWorkers) {
+  RunWithWorkers(4);
+}
+
+}  // namespace
+
+}  // namespace net
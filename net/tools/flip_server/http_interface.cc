@@ -166,8 +166,9 @@ void HttpSM::ResetForNewConnection() {
       << connection_->server_port_ << " ";
   }
   // Message has not been fully read, either it is incomplete or the
-  // server is closing the connection to signal message end.
-  if (!MessageFullyRead()) {
+  // server is closing the connection to signal message end. Only a proxy
+  // has a SPDY stream to end.
+  if (!MessageFullyRead() && sm_spdy_interface_) {
     VLOG(2) << "HTTP response closed before end of file detected. "
             << "Sending EOF to spdy.";
     sm_spdy_interface_->SendEOF(stream_id_);
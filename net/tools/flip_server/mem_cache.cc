@@ -5,8 +5,6 @@
 #include "net/tools/flip_server/mem_cache.h"
 
 #include <dirent.h>
-#include <errno.h>
-#include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -16,6 +14,8 @@
 #include <map>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/strings/string_util.h"
 #include "net/tools/balsa/balsa_frame.h"
 #include "net/tools/balsa/balsa_headers.h"
@@ -25,12 +25,56 @@
 namespace {
 // The directory where cache locates);
 const char FLAGS_cache_base_dir[] = ".";
+
+// The contents of a file mapped read-only into memory.
+class MappedFileContents : public base::RefCountedMemory {
+ public:
+  MappedFileContents() {}
+
+  bool Initialize(const base::FilePath& path) {
+    return mapped_file_.Initialize(path);
+  }
+
+  // base::RefCountedMemory:
+  virtual const unsigned char* front() const OVERRIDE {
+    return mapped_file_.data();
+  }
+  virtual size_t size() const OVERRIDE { return mapped_file_.length(); }
+
+ private:
+  virtual ~MappedFileContents() {}
+
+  base::MemoryMappedFile mapped_file_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedFileContents);
+};
+
 }  // namespace
 
 namespace net {
 
+StoreBodyAndHeadersVisitor::StoreBodyAndHeadersVisitor() : error_(false) {}
+
+base::StringPiece StoreBodyAndHeadersVisitor::GetBody() const {
+  if (!body.empty())
+    return body;
+  return contiguous_body;
+}
+
 void StoreBodyAndHeadersVisitor::ProcessBodyData(const char *input,
                                                  size_t size) {
+  if (body.empty()) {
+    if (contiguous_body.empty()) {
+      contiguous_body.set(input, size);
+      return;
+    }
+    if (contiguous_body.data() + contiguous_body.size() == input) {
+      contiguous_body.set(contiguous_body.data(),
+                          contiguous_body.size() + size);
+      return;
+    }
+    contiguous_body.CopyToString(&body);
+  }
   body.append(input, size);
 }
 
@@ -53,8 +97,23 @@ void StoreBodyAndHeadersVisitor::HandleBodyError(BalsaFrame* framer) {
 FileData::FileData(const BalsaHeaders* headers,
                    const std::string& filename,
                    const std::string& body)
-    : filename_(filename)
-    , body_(body) {
+    : filename_(filename) {
+  if (headers) {
+    headers_.reset(new BalsaHeaders);
+    headers_->CopyFrom(*headers);
+  }
+  std::string body_copy(body);
+  contents_ = base::RefCountedString::TakeString(&body_copy);
+  body_.set(contents_->front(), contents_->size());
+}
+
+FileData::FileData(const BalsaHeaders* headers,
+                   const std::string& filename,
+                   base::RefCountedMemory* contents,
+                   const base::StringPiece& body)
+    : filename_(filename),
+      contents_(contents),
+      body_(body) {
   if (headers) {
     headers_.reset(new BalsaHeaders);
     headers_->CopyFrom(*headers);
@@ -71,13 +130,6 @@ MemoryCache::~MemoryCache() {
   ClearFiles();
 }
 
-void MemoryCache::CloneFrom(const MemoryCache& mc) {
-  DCHECK_NE(this, &mc);
-  ClearFiles();
-  files_ = mc.files_;
-  cwd_ = mc.cwd_;
-}
-
 void MemoryCache::AddFiles() {
   std::deque<std::string> paths;
   paths.push_back(cwd_ + "/GET_");
@@ -122,20 +174,12 @@ void MemoryCache::AddFiles() {
   }
 }
 
-void MemoryCache::ReadToString(const char* filename, std::string* output) {
-  output->clear();
-  int fd = open(filename, 0, "r");
-  if (fd == -1)
-    return;
-  char buffer[4096];
-  ssize_t read_status = read(fd, buffer, sizeof(buffer));
-  while (read_status > 0) {
-    output->append(buffer, static_cast<size_t>(read_status));
-    do {
-      read_status = read(fd, buffer, sizeof(buffer));
-    } while (read_status <= 0 && errno == EINTR);
-  }
-  close(fd);
+scoped_refptr<base::RefCountedMemory> MemoryCache::ReadFileContents(
+    const char* filename) {
+  scoped_refptr<MappedFileContents> contents(new MappedFileContents);
+  if (!contents->Initialize(base::FilePath(filename)))
+    return NULL;
+  return contents;
 }
 
 void MemoryCache::ReadAndStoreFileContents(const char* filename) {
@@ -143,12 +187,13 @@ void MemoryCache::ReadAndStoreFileContents(const char* filename) {
   BalsaFrame framer;
   framer.set_balsa_visitor(&visitor);
   framer.set_balsa_headers(&(visitor.headers));
-  std::string filename_contents;
-  ReadToString(filename, &filename_contents);
-
-  // Ugly hack to make everything look like 1.1.
-  if (filename_contents.find("HTTP/1.0") == 0)
-    filename_contents[7] = '1';
+  scoped_refptr<base::RefCountedMemory> contents(ReadFileContents(filename));
+  if (!contents.get()) {
+    LOG(ERROR) << "Unable to read file: " << filename;
+    return;
+  }
+  base::StringPiece filename_contents(
+      reinterpret_cast<const char*>(contents->front()), contents->size());
 
   size_t pos = 0;
   size_t old_pos = 0;
@@ -169,11 +214,15 @@ void MemoryCache::ReadAndStoreFileContents(const char* filename) {
       // If no Content-Length or Transfer-Encoding was captured in the
       // file, then the rest of the data is the body.  Many of the captures
       // from within Chrome don't have content-lengths.
-      if (!visitor.body.length())
-        visitor.body = filename_contents.substr(pos);
+      if (visitor.GetBody().empty())
+        visitor.contiguous_body = filename_contents.substr(pos);
       break;
     }
   }
+  // Ugly hack to make everything look like 1.1. The file is mapped
+  // read-only, so the parsed first line is rewritten instead of the file.
+  if (visitor.headers.response_version() == "HTTP/1.0")
+    visitor.headers.SetResponseVersion("HTTP/1.1");
   visitor.headers.RemoveAllOfHeader("content-length");
   visitor.headers.RemoveAllOfHeader("transfer-encoding");
   visitor.headers.RemoveAllOfHeader("connection");
@@ -196,19 +245,27 @@ void MemoryCache::ReadAndStoreFileContents(const char* filename) {
   DCHECK_EQ(std::string(filename).substr(0, cwd_.size()), cwd_);
   DCHECK_EQ(filename[cwd_.size()], '/');
   std::string filename_stripped = std::string(filename).substr(cwd_.size() + 1);
-  LOG(INFO) << "Adding file (" << visitor.body.length() << " bytes): "
+  LOG(INFO) << "Adding file (" << visitor.GetBody().length() << " bytes): "
             << filename_stripped;
   size_t slash_pos = filename_stripped.find('/');
   if (slash_pos == std::string::npos) {
     slash_pos = filename_stripped.size();
   }
-  InsertFile(&visitor.headers,
-             filename_stripped.substr(0, slash_pos),
-             visitor.body);
+  if (!visitor.body.empty()) {
+    // The body was decoded, so it can't be served from the mapping.
+    InsertFile(&visitor.headers,
+               filename_stripped.substr(0, slash_pos),
+               visitor.body);
+    return;
+  }
+  InsertFile(new FileData(&visitor.headers,
+                          filename_stripped.substr(0, slash_pos),
+                          contents.get(),
+                          visitor.contiguous_body));
 }
 
-FileData* MemoryCache::GetFileData(const std::string& filename) {
-  Files::iterator fi = files_.end();
+FileData* MemoryCache::GetFileData(const std::string& filename) const {
+  Files::const_iterator fi = files_.end();
   if (EndsWith(filename, ".html", true)) {
     fi = files_.find(filename.substr(0, filename.size() - 5) + ".http");
   }
@@ -222,7 +279,7 @@ FileData* MemoryCache::GetFileData(const std::string& filename) {
 }
 
 bool MemoryCache::AssignFileData(const std::string& filename,
-                                 MemCacheIter* mci) {
+                                 MemCacheIter* mci) const {
   mci->file_data = GetFileData(filename);
   if (mci->file_data == NULL) {
     LOG(ERROR) << "Could not find file data for " << filename;
@@ -9,7 +9,10 @@
 #include <string>
 
 #include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/strings/string_piece.h"
 #include "net/tools/balsa/balsa_headers.h"
 #include "net/tools/balsa/balsa_visitor_interface.h"
 #include "net/tools/flip_server/constants.h"
@@ -18,8 +21,14 @@ namespace net {
 
 class StoreBodyAndHeadersVisitor: public BalsaVisitorInterface {
  public:
+  StoreBodyAndHeadersVisitor();
+
   void HandleError() { error_ = true; }
 
+  // Returns the body read so far. While it is one contiguous run of the
+  // input it points into the input, otherwise into |body|.
+  base::StringPiece GetBody() const;
+
   // BalsaVisitorInterface:
   virtual void ProcessBodyInput(const char *input, size_t size) OVERRIDE {}
   virtual void ProcessBodyData(const char *input, size_t size) OVERRIDE;
@@ -56,7 +65,10 @@ class StoreBodyAndHeadersVisitor: public BalsaVisitorInterface {
   virtual void HandleBodyError(BalsaFrame* framer) OVERRIDE;
 
   BalsaHeaders headers;
+  // Only used once the body is not contiguous in the input, e.g. when it is
+  // chunked.
   std::string body;
+  base::StringPiece contiguous_body;
   bool error_;
 };
 
@@ -67,18 +79,25 @@ class FileData {
   FileData(const BalsaHeaders* headers,
            const std::string& filename,
            const std::string& body);
+  // |body| points into |contents|, which is kept alive as long as this
+  // FileData.
+  FileData(const BalsaHeaders* headers,
+           const std::string& filename,
+           base::RefCountedMemory* contents,
+           const base::StringPiece& body);
   ~FileData();
 
   BalsaHeaders* headers() { return headers_.get(); }
   const BalsaHeaders* headers() const { return headers_.get(); }
 
-  const std::string& filename() { return filename_; }
-  const std::string& body() { return body_; }
+  const std::string& filename() const { return filename_; }
+  const base::StringPiece& body() const { return body_; }
 
  private:
   scoped_ptr<BalsaHeaders> headers_;
   std::string filename_;
-  std::string body_;
+  scoped_refptr<base::RefCountedMemory> contents_;
+  base::StringPiece body_;
 
   DISALLOW_COPY_AND_ASSIGN(FileData);
 };
@@ -114,6 +133,10 @@ class MemCacheIter {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// The files are memory-mapped rather than read into the heap, so their
+// bodies are backed by the page cache and never copied. Once AddFiles() has
+// returned the cache is not modified anymore, and any number of threads may
+// then call GetFileData() and AssignFileData() concurrently without locking.
 class MemoryCache {
  public:
   typedef std::map<std::string, FileData*> Files;
@@ -122,18 +145,18 @@ class MemoryCache {
   MemoryCache();
   virtual ~MemoryCache();
 
-  void CloneFrom(const MemoryCache& mc);
-
   void AddFiles();
 
+  // Maps |filename| into memory. Returns NULL if it can't be read.
   // virtual for unittests
-  virtual void ReadToString(const char* filename, std::string* output);
+  virtual scoped_refptr<base::RefCountedMemory> ReadFileContents(
+      const char* filename);
 
   void ReadAndStoreFileContents(const char* filename);
 
-  FileData* GetFileData(const std::string& filename);
+  FileData* GetFileData(const std::string& filename) const;
 
-  bool AssignFileData(const std::string& filename, MemCacheIter* mci);
+  bool AssignFileData(const std::string& filename, MemCacheIter* mci) const;
 
   // For unittests
   void InsertFile(const BalsaHeaders* headers,
@@ -146,6 +169,8 @@ class MemoryCache {
 
   Files files_;
   std::string cwd_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryCache);
 };
 
 class NotifierInterface {
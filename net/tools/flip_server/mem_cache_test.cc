@@ -4,6 +4,11 @@
 
 #include "net/tools/flip_server/mem_cache.h"
 
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
 #include "net/tools/balsa/balsa_headers.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -11,24 +16,30 @@ namespace net {
 
 namespace {
 
-class MemoryCacheWithFakeReadToString : public MemoryCache {
+class MemoryCacheWithFakeReadFileContents : public MemoryCache {
  public:
-  virtual ~MemoryCacheWithFakeReadToString() {}
-
-  virtual void ReadToString(const char* filename, std::string* output)
-      OVERRIDE {
-    *output = data_map_[filename];
+  virtual ~MemoryCacheWithFakeReadFileContents() {}
+
+  virtual scoped_refptr<base::RefCountedMemory> ReadFileContents(
+      const char* filename) OVERRIDE {
+    std::string data = data_map_[filename];
+    scoped_refptr<base::RefCountedMemory> contents(
+        base::RefCountedString::TakeString(&data));
+    contents_map_[filename] = contents;
+    return contents;
   }
 
   std::map<std::string, std::string> data_map_;
+  // The contents handed out for each file.
+  std::map<std::string, scoped_refptr<base::RefCountedMemory> > contents_map_;
 };
 
 class FlipMemoryCacheTest : public ::testing::Test {
  public:
-  FlipMemoryCacheTest(): mem_cache_(new MemoryCacheWithFakeReadToString) {}
+  FlipMemoryCacheTest(): mem_cache_(new MemoryCacheWithFakeReadFileContents) {}
 
  protected:
-  scoped_ptr<MemoryCacheWithFakeReadToString> mem_cache_;
+  scoped_ptr<MemoryCacheWithFakeReadFileContents> mem_cache_;
 };
 
 TEST_F(FlipMemoryCacheTest, EmptyCache) {
@@ -93,6 +104,54 @@ TEST_F(FlipMemoryCacheTest, GetFileDataForHtmlFile) {
   ASSERT_EQ(hello_html, mem_cache_->GetFileData("hello.http"));
 }
 
+TEST_F(FlipMemoryCacheTest, BodyIsNotCopied) {
+  const char kHeaders[] = "HTTP/1.1 200 OK\r\n"
+      "content-length: 4\r\n\r\n";
+  mem_cache_->data_map_["./hello"] = std::string(kHeaders) + "body";
+  mem_cache_->ReadAndStoreFileContents("./hello");
+
+  FileData* hello = mem_cache_->GetFileData("hello");
+  ASSERT_FALSE(NULL == hello);
+  EXPECT_EQ("body", hello->body());
+  const base::RefCountedMemory* contents =
+      mem_cache_->contents_map_["./hello"].get();
+  EXPECT_EQ(reinterpret_cast<const char*>(contents->front()) +
+                strlen(kHeaders),
+            hello->body().data());
+}
+
+TEST_F(FlipMemoryCacheTest, ChunkedBodyIsDecoded) {
+  mem_cache_->data_map_["./hello"] = "HTTP/1.1 200 OK\r\n"
+      "transfer-encoding: chunked\r\n\r\n"
+      "3\r\nbod\r\n"
+      "2\r\ny!\r\n"
+      "0\r\n\r\n";
+  mem_cache_->ReadAndStoreFileContents("./hello");
+
+  FileData* hello = mem_cache_->GetFileData("hello");
+  ASSERT_FALSE(NULL == hello);
+  EXPECT_EQ("body!", hello->body());
+}
+
+TEST(FlipMemoryCacheMappingTest, ReadFileContents) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.path().AppendASCII("hello");
+  const std::string kData = "HTTP/1.1 200 OK\r\n\r\nbody";
+  ASSERT_EQ(static_cast<int>(kData.size()),
+            file_util::WriteFile(path, kData.data(), kData.size()));
+
+  MemoryCache mem_cache;
+  scoped_refptr<base::RefCountedMemory> contents =
+      mem_cache.ReadFileContents(path.value().c_str());
+  ASSERT_TRUE(contents.get());
+  EXPECT_EQ(kData, std::string(reinterpret_cast<const char*>(contents->front()),
+                               contents->size()));
+
+  EXPECT_FALSE(mem_cache.ReadFileContents(
+      temp_dir.path().AppendASCII("missing").value().c_str()).get());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -65,7 +65,9 @@ OutputOrdering::BeginOutputtingAlarm::~BeginOutputtingAlarm() {
 }
 
 int64 OutputOrdering::BeginOutputtingAlarm::OnAlarm() {
-  OnUnregistration();
+  // The alarm is not registered anymore once it fired. OnUnregistration()
+  // is not used here since it deletes |this|.
+  pmp_->alarm_enabled = false;
   output_ordering_->MoveToActive(pmp_, mci_);
   VLOG(2) << "ON ALARM! Should now start to output...";
   delete this;
@@ -4,12 +4,60 @@
 
 #include "net/tools/flip_server/spdy_ssl.h"
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
 #include "openssl/err.h"
 #include "openssl/ssl.h"
 
 namespace net {
 
+namespace {
+
+unsigned long CurrentThreadId() {
+  return static_cast<unsigned long>(base::PlatformThread::CurrentId());
+}
+
+// The locks OpenSSL needs to be used from more than one thread, as it is
+// when an acceptor has several workers.
+class OpenSSLLocks {
+ public:
+  OpenSSLLocks() {
+    int num_locks = CRYPTO_num_locks();
+    locks_.reserve(num_locks);
+    for (int i = 0; i < num_locks; ++i)
+      locks_.push_back(new base::Lock());
+  }
+
+  void Install() {
+    CRYPTO_set_locking_callback(LockingCallback);
+    CRYPTO_set_id_callback(CurrentThreadId);
+  }
+
+ private:
+  static void LockingCallback(int mode, int n, const char* file, int line);
+
+  ScopedVector<base::Lock> locks_;
+
+  DISALLOW_COPY_AND_ASSIGN(OpenSSLLocks);
+};
+
+base::LazyInstance<OpenSSLLocks>::Leaky g_openssl_locks =
+    LAZY_INSTANCE_INITIALIZER;
+
+void OpenSSLLocks::LockingCallback(int mode, int n, const char* file,
+                                   int line) {
+  base::Lock* lock = g_openssl_locks.Get().locks_[n];
+  if (mode & CRYPTO_LOCK)
+    lock->Acquire();
+  else
+    lock->Release();
+}
+
+}  // namespace
+
 #define NEXT_PROTO_STRING "\x06spdy/2\x08http/1.1\x08http/1.0"
 #define SSL_CIPHER_LIST "!aNULL:!ADH:!eNull:!LOW:!EXP:RC4+RSA:MEDIUM:HIGH"
 
@@ -31,6 +79,7 @@ void InitSSL(SSLState* state,
              bool disable_ssl_compression) {
   SSL_library_init();
   PrintSslError();
+  g_openssl_locks.Get().Install();
 
   SSL_load_error_strings();
   PrintSslError();
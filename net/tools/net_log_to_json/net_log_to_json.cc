@@ -0,0 +1,58 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This utility converts a log dumped by NetLogRingBuffer to the JSON format
+// written by NetLogLogger, which about:net-internals can load.
+
+#include <stdio.h>
+
+#include <string>
+
+#include "base/at_exit.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/values.h"
+#include "net/base/net_log_logger.h"
+#include "net/base/net_log_ring_buffer.h"
+
+static int Usage(const char* argv0) {
+  fprintf(stderr, "Usage: %s <dump file> [<output file>]\n", argv0);
+  return 1;
+}
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+
+  if (argc < 2 || argc > 3)
+    return Usage(argv[0]);
+
+  std::string data;
+  if (!base::ReadFileToString(base::FilePath::FromUTF8Unsafe(argv[1]),
+                              &data)) {
+    fprintf(stderr, "Failed to read %s\n", argv[1]);
+    return 1;
+  }
+
+  scoped_ptr<base::DictionaryValue> constants(
+      net::NetLogLogger::GetConstants());
+  std::string json;
+  if (!net::NetLogRingBuffer::ConvertToJSON(data, *constants, &json)) {
+    fprintf(stderr, "Failed to parse %s\n", argv[1]);
+    return 1;
+  }
+
+  if (argc == 3) {
+    base::FilePath output_filename = base::FilePath::FromUTF8Unsafe(argv[2]);
+    if (file_util::WriteFile(output_filename, json.data(), json.size()) !=
+        static_cast<int>(json.size())) {
+      fprintf(stderr, "Failed to write %s\n", argv[2]);
+      return 1;
+    }
+  } else {
+    fwrite(json.data(), 1, json.size(), stdout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,221 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A loopback load generator for QuicMultiThreadedServer. It starts the server
+// in-process with 1, 2, 4, ... up to --max_workers threads, and for each
+// number of workers fetches --response_size bytes over new connections from
+// --num_clients client threads. It reports the connections completed per
+// second and the throughput of the response bodies.
+//
+// For example:
+//  quic_load_generator --max_workers=8 --num_clients=16
+//      --connections_per_client=200 --response_size=102400
+
+#include <stdio.h>
+
+#include <iostream>
+#include <string>
+
+#include "base/at_exit.h"
+#include "base/basictypes.h"
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_util.h"
+#include "net/quic/quic_config.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/reliable_quic_stream.h"
+#include "net/tools/balsa/balsa_headers.h"
+#include "net/tools/quic/quic_client.h"
+#include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/quic_multi_threaded_server.h"
+#include "net/tools/quic/quic_reliable_client_stream.h"
+
+int32 FLAGS_max_workers = 0;  // 0 means the number of processors.
+int32 FLAGS_num_clients = 8;
+int32 FLAGS_connections_per_client = 100;
+int32 FLAGS_response_size = 10 * 1024;
+
+namespace {
+
+const char kHostname[] = "www.example.com";
+const char kUrl[] = "https://www.example.com/load";
+
+// Opens |FLAGS_connections_per_client| connections one after the other, and
+// fetches kUrl once on each.
+class LoadClient : public base::DelegateSimpleThread::Delegate,
+                   public net::ReliableQuicStream::Visitor {
+ public:
+  explicit LoadClient(const net::IPEndPoint& server_address)
+      : server_address_(server_address),
+        connections_(0),
+        bytes_received_(0) {
+    config_.SetDefaults();
+  }
+
+  virtual ~LoadClient() {}
+
+  int connections() const { return connections_; }
+  int64 bytes_received() const { return bytes_received_; }
+
+  // base::DelegateSimpleThread::Delegate:
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < FLAGS_connections_per_client; ++i) {
+      if (Fetch())
+        ++connections_;
+    }
+  }
+
+  // net::ReliableQuicStream::Visitor:
+  virtual void OnClose(net::ReliableQuicStream* stream) OVERRIDE {
+    // The stream is deleted once closed, so the body is counted here.
+    bytes_received_ +=
+        static_cast<net::tools::QuicReliableClientStream*>(stream)->
+            data().size();
+  }
+
+ private:
+  bool Fetch() {
+    net::tools::QuicClient client(server_address_, kHostname, config_,
+                                  net::QuicSupportedVersions());
+    if (!client.Initialize() || !client.Connect()) {
+      LOG(ERROR) << "Failed to connect to " << server_address_.ToString();
+      return false;
+    }
+
+    net::tools::QuicReliableClientStream* stream =
+        client.CreateReliableClientStream();
+    if (!stream)
+      return false;
+    stream->set_visitor(this);
+
+    net::BalsaHeaders headers;
+    headers.SetRequestFirstlineFromStringPieces("GET", kUrl, "HTTP/1.1");
+    stream->SendRequest(headers, "", true);
+    client.WaitForStreamToClose(stream->id());
+    client.Disconnect();
+    return true;
+  }
+
+  const net::IPEndPoint server_address_;
+  net::QuicConfig config_;
+
+  int connections_;
+  int64 bytes_received_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClient);
+};
+
+// Runs the clients against a server with |num_workers| threads, and prints
+// the results. Returns false if the server could not be started.
+bool RunWithWorkers(int num_workers) {
+  net::QuicConfig config;
+  config.SetDefaults();
+  net::tools::QuicMultiThreadedServer server(
+      config, net::QuicSupportedVersions(), num_workers);
+  server.SetStrikeRegisterNoStartupPeriod();
+
+  net::IPAddressNumber ip;
+  CHECK(net::ParseIPLiteralToNumber("127.0.0.1", &ip));
+  if (!server.Start(net::IPEndPoint(ip, 0)))
+    return false;
+  net::IPEndPoint server_address(ip, server.port());
+
+  ScopedVector<LoadClient> clients;
+  ScopedVector<base::DelegateSimpleThread> threads;
+  for (int i = 0; i < FLAGS_num_clients; ++i) {
+    clients.push_back(new LoadClient(server_address));
+    threads.push_back(new base::DelegateSimpleThread(clients[i], "client"));
+  }
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i]->Start();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i]->Join();
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  server.Shutdown();
+
+  int connections = 0;
+  int64 bytes_received = 0;
+  for (size_t i = 0; i < clients.size(); ++i) {
+    connections += clients[i]->connections();
+    bytes_received += clients[i]->bytes_received();
+  }
+
+  double seconds = elapsed.InSecondsF();
+  printf("workers=%d connections=%d time=%.3fs connections/sec=%.1f "
+         "Gbps=%.3f\n",
+         num_workers, connections, seconds, connections / seconds,
+         bytes_received * 8 / seconds / 1e9);
+  return true;
+}
+
+bool ParsePositiveIntSwitch(CommandLine* line, const char* name,
+                            int32* value) {
+  if (!line->HasSwitch(name))
+    return true;
+  int parsed;
+  if (!base::StringToInt(line->GetSwitchValueASCII(name), &parsed) ||
+      parsed <= 0) {
+    return false;
+  }
+  *value = parsed;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  CommandLine::Init(argc, argv);
+  CommandLine* line = CommandLine::ForCurrentProcess();
+  if (line->HasSwitch("h") || line->HasSwitch("help") ||
+      !ParsePositiveIntSwitch(line, "max_workers", &FLAGS_max_workers) ||
+      !ParsePositiveIntSwitch(line, "num_clients", &FLAGS_num_clients) ||
+      !ParsePositiveIntSwitch(line, "connections_per_client",
+                              &FLAGS_connections_per_client) ||
+      !ParsePositiveIntSwitch(line, "response_size", &FLAGS_response_size)) {
+    const char* help_str =
+        "Usage: quic_load_generator [options]\n"
+        "\n"
+        "Options:\n"
+        "-h, --help                    show this help message and exit\n"
+        "--max_workers=<n>             largest number of server threads\n"
+        "                              (default: number of processors)\n"
+        "--num_clients=<n>             number of client threads\n"
+        "--connections_per_client=<n>  connections opened by each client\n"
+        "--response_size=<bytes>       size of the response body\n";
+    std::cout << help_str;
+    exit(0);
+  }
+
+  base::AtExitManager exit_manager;
+
+  if (FLAGS_max_workers == 0)
+    FLAGS_max_workers = base::SysInfo::NumberOfProcessors();
+
+  net::tools::QuicInMemoryCache::GetInstance()->AddSimpleResponse(
+      "GET", kUrl, "HTTP/1.1", "200", "OK",
+      std::string(FLAGS_response_size, 'x'));
+
+  for (int num_workers = 1; ; num_workers *= 2) {
+    if (num_workers > FLAGS_max_workers)
+      num_workers = FLAGS_max_workers;
+    if (!RunWithWorkers(num_workers)) {
+      LOG(ERROR) << "Failed to start the server with " << num_workers
+                 << " workers";
+      return 1;
+    }
+    if (num_workers == FLAGS_max_workers)
+      break;
+  }
+
+  return 0;
+}
@@ -0,0 +1,189 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_batch_packet_writer.h"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "base/logging.h"
+#include "net/tools/quic/quic_socket_utils.h"
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+namespace net {
+namespace tools {
+
+namespace {
+
+// The space needed in the control buffer of a message for the self address
+// and the GSO segment size.
+const size_t kControlBufferSize =
+    QuicSocketUtils::kSpaceForIp + CMSG_SPACE(sizeof(uint16));
+
+// Returns true if the kernel can segment UDP buffers sent on |fd|.
+bool IsGsoSupported(int fd) {
+  int gso_size = 0;
+  socklen_t gso_size_len = sizeof(gso_size);
+  return getsockopt(fd, SOL_UDP, UDP_SEGMENT, &gso_size, &gso_size_len) == 0;
+}
+
+}  // namespace
+
+// static
+const size_t QuicBatchPacketWriter::kMaxBatchSize;
+
+QuicBatchPacketWriter::QuicBatchPacketWriter(int fd)
+    : fd_(fd),
+      use_gso_(IsGsoSupported(fd)),
+      blocked_(false),
+      buffers_(new char[kMaxBatchSize * kMaxPacketSize]),
+      first_packet_(0),
+      num_packets_(0) {
+}
+
+QuicBatchPacketWriter::~QuicBatchPacketWriter() {
+  if (num_queued_packets() > 0)
+    DVLOG(1) << "Dropping " << num_queued_packets() << " unsent packets.";
+}
+
+WriteResult QuicBatchPacketWriter::WritePacket(
+    const char* buffer, size_t buf_len,
+    const net::IPAddressNumber& self_address,
+    const net::IPEndPoint& peer_address,
+    QuicBlockedWriterInterface* blocked_writer) {
+  if (blocked_)
+    return WriteResult(WRITE_STATUS_BLOCKED, EAGAIN);
+  DCHECK_LT(num_packets_, kMaxBatchSize);
+  DCHECK_LE(buf_len, kMaxPacketSize);
+
+  QueuedPacket* packet = &packets_[num_packets_];
+  packet->length = buf_len;
+  packet->self_address = self_address;
+  packet->peer_address_len = sizeof(packet->peer_address);
+  CHECK(peer_address.ToSockAddr(
+      reinterpret_cast<sockaddr*>(&packet->peer_address),
+      &packet->peer_address_len));
+  memcpy(this->buffer(num_packets_), buffer, buf_len);
+  ++num_packets_;
+
+  // The packet is sent even if this flush becomes blocked, once the socket
+  // is writable again.
+  if (num_packets_ == kMaxBatchSize)
+    Flush();
+  return WriteResult(WRITE_STATUS_OK, buf_len);
+}
+
+bool QuicBatchPacketWriter::IsWriteBlockedDataBuffered() const {
+  return false;
+}
+
+WriteResult QuicBatchPacketWriter::Flush() {
+  mmsghdr messages[kMaxBatchSize];
+  iovec iovs[kMaxBatchSize];
+  char control_buffers[kMaxBatchSize][kControlBufferSize];
+  // The number of packets sent by each message.
+  size_t message_packets[kMaxBatchSize];
+
+  while (first_packet_ < num_packets_) {
+    size_t num_messages = 0;
+    for (size_t i = first_packet_; i < num_packets_; ++num_messages) {
+      size_t segments = use_gso_ ? CountSegments(i) : 1;
+      const QueuedPacket& packet = packets_[i];
+
+      for (size_t j = 0; j < segments; ++j) {
+        iovs[i + j].iov_base = buffer(i + j);
+        iovs[i + j].iov_len = packets_[i + j].length;
+      }
+
+      msghdr* hdr = &messages[num_messages].msg_hdr;
+      memset(hdr, 0, sizeof(*hdr));
+      hdr->msg_name = const_cast<sockaddr_storage*>(&packet.peer_address);
+      hdr->msg_namelen = packet.peer_address_len;
+      hdr->msg_iov = &iovs[i];
+      hdr->msg_iovlen = segments;
+      hdr->msg_control = control_buffers[num_messages];
+      hdr->msg_controllen = kControlBufferSize;
+      messages[num_messages].msg_len = 0;
+
+      size_t control_len = 0;
+      cmsghdr* cmsg = CMSG_FIRSTHDR(hdr);
+      if (!packet.self_address.empty()) {
+        control_len += QuicSocketUtils::SetIpInfoInCmsg(packet.self_address,
+                                                        cmsg);
+        cmsg = CMSG_NXTHDR(hdr, cmsg);
+      }
+      if (segments > 1) {
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16));
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        uint16 segment_size = packet.length;
+        memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+        control_len += CMSG_SPACE(sizeof(uint16));
+      }
+      hdr->msg_controllen = control_len;
+      if (control_len == 0)
+        hdr->msg_control = NULL;
+
+      message_packets[num_messages] = segments;
+      i += segments;
+    }
+
+    int rc = sendmmsg(fd_, messages, num_messages, 0);
+    if (rc < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        blocked_ = true;
+        return WriteResult(WRITE_STATUS_BLOCKED, errno);
+      }
+      if (message_packets[0] > 1 && (errno == EIO || errno == EINVAL)) {
+        // The kernel or the device can not segment this buffer. Send the
+        // packets one by one from now on.
+        LOG(WARNING) << "Disabling UDP GSO: " << strerror(errno);
+        use_gso_ = false;
+        continue;
+      }
+      LOG(ERROR) << "Dropping packet: " << strerror(errno);
+      rc = 1;
+    }
+
+    for (int i = 0; i < rc; ++i)
+      first_packet_ += message_packets[i];
+  }
+
+  first_packet_ = 0;
+  num_packets_ = 0;
+  blocked_ = false;
+  return WriteResult(WRITE_STATUS_OK, 0);
+}
+
+size_t QuicBatchPacketWriter::CountSegments(size_t first) const {
+  const QueuedPacket& first_packet = packets_[first];
+  size_t segments = 1;
+  for (size_t i = first + 1; i < num_packets_; ++i) {
+    const QueuedPacket& packet = packets_[i];
+    // Every segment but the last must have the size of the first one.
+    if (packets_[i - 1].length != first_packet.length ||
+        packet.length > first_packet.length ||
+        packet.self_address != first_packet.self_address ||
+        packet.peer_address_len != first_packet.peer_address_len ||
+        memcmp(&packet.peer_address, &first_packet.peer_address,
+               first_packet.peer_address_len) != 0) {
+      break;
+    }
+    ++segments;
+  }
+  return segments;
+}
+
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,98 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
+#define NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
+
+#include <sys/socket.h>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "net/base/ip_endpoint.h"
+#include "net/quic/quic_packet_writer.h"
+#include "net/quic/quic_protocol.h"
+
+namespace net {
+
+class QuicBlockedWriterInterface;
+struct WriteResult;
+
+namespace tools {
+
+// Packet writer which queues the packets written during one turn of the
+// event loop, and sends them with as few system calls as possible when
+// Flush() is called: all the queued packets go out in one sendmmsg(), and
+// when the kernel supports UDP GSO, consecutive packets of the same size to
+// the same peer go out as a single segmented buffer.
+//
+// Packets are copied when queued, and reported as written. If the socket
+// becomes write blocked during a flush, the unsent packets stay queued and
+// WritePacket() reports WRITE_STATUS_BLOCKED until a later Flush() has sent
+// them, so that the blocked writers wait for the socket to become writable.
+class QuicBatchPacketWriter : public QuicPacketWriter {
+ public:
+  // The largest number of packets queued before they are flushed.
+  static const size_t kMaxBatchSize = 32;
+
+  explicit QuicBatchPacketWriter(int fd);
+  virtual ~QuicBatchPacketWriter();
+
+  // QuicPacketWriter
+  virtual WriteResult WritePacket(
+      const char* buffer, size_t buf_len,
+      const net::IPAddressNumber& self_address,
+      const net::IPEndPoint& peer_address,
+      QuicBlockedWriterInterface* blocked_writer) OVERRIDE;
+  virtual bool IsWriteBlockedDataBuffered() const OVERRIDE;
+
+  // Sends the queued packets. Returns WRITE_STATUS_BLOCKED if the socket
+  // became write blocked before all of them were sent, and WRITE_STATUS_OK
+  // otherwise. A packet the kernel fails to send for another reason is
+  // dropped, as the network could have done.
+  WriteResult Flush();
+
+  size_t num_queued_packets() const { return num_packets_ - first_packet_; }
+
+  // True if the writer is waiting for the socket to become writable.
+  bool write_blocked() const { return blocked_; }
+
+  // Whether packets are combined into UDP GSO buffers. Defaults to whether
+  // the kernel supports it.
+  bool use_gso() const { return use_gso_; }
+  void set_use_gso(bool use_gso) { use_gso_ = use_gso; }
+
+ private:
+  struct QueuedPacket {
+    size_t length;
+    IPAddressNumber self_address;
+    sockaddr_storage peer_address;
+    socklen_t peer_address_len;
+  };
+
+  // Returns the number of queued packets, starting at |first|, which can be
+  // sent as the segments of one GSO buffer.
+  size_t CountSegments(size_t first) const;
+
+  char* buffer(size_t index) { return buffers_.get() + index * kMaxPacketSize; }
+
+  int fd_;
+  bool use_gso_;
+
+  // Set when a flush stops because the socket is write blocked, until the
+  // queue is emptied.
+  bool blocked_;
+
+  // The packets in [first_packet_, num_packets_) are waiting to be sent.
+  QueuedPacket packets_[kMaxBatchSize];
+  scoped_ptr<char[]> buffers_;
+  size_t first_packet_;
+  size_t num_packets_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicBatchPacketWriter);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
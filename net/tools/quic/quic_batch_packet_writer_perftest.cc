@@ -0,0 +1,105 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "base/test/perf_time_logger.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_util.h"
+#include "net/quic/quic_packet_writer.h"
+#include "net/tools/quic/quic_batch_packet_writer.h"
+#include "net/tools/quic/quic_default_packet_writer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+const int kNumPackets = 200000;
+const size_t kPacketSize = 1350;
+
+// Packets written per event loop turn, i.e. between two flushes.
+const int kPacketsPerTurn = 16;
+
+class QuicBatchPacketWriterPerfTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    IPAddressNumber loopback;
+    CHECK(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+
+    // Nothing reads from this socket: once its buffer is full, the kernel
+    // drops what is sent to it, which costs the sender the same.
+    receive_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_LE(0, receive_fd_);
+    sockaddr_storage raw_address;
+    socklen_t address_len = sizeof(raw_address);
+    ASSERT_TRUE(IPEndPoint(loopback, 0).ToSockAddr(
+        reinterpret_cast<sockaddr*>(&raw_address), &address_len));
+    ASSERT_EQ(0, bind(receive_fd_, reinterpret_cast<sockaddr*>(&raw_address),
+                      address_len));
+    address_len = sizeof(raw_address);
+    ASSERT_EQ(0, getsockname(receive_fd_,
+                             reinterpret_cast<sockaddr*>(&raw_address),
+                             &address_len));
+    ASSERT_TRUE(receive_address_.FromSockAddr(
+        reinterpret_cast<sockaddr*>(&raw_address), address_len));
+
+    send_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_LE(0, send_fd_);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    close(send_fd_);
+    close(receive_fd_);
+  }
+
+  // Writes kNumPackets packets with |writer|, calling Flush() on
+  // |batch_writer| after each turn if it is not NULL.
+  void WritePackets(const std::string& name,
+                    QuicPacketWriter* writer,
+                    QuicBatchPacketWriter* batch_writer) {
+    std::string packet(kPacketSize, 'x');
+    base::PerfTimeLogger timer(name.c_str());
+    for (int i = 0; i < kNumPackets; ++i) {
+      WriteResult result = writer->WritePacket(
+          packet.data(), packet.size(), IPAddressNumber(), receive_address_,
+          NULL);
+      ASSERT_EQ(WRITE_STATUS_OK, result.status);
+      if (batch_writer != NULL && (i + 1) % kPacketsPerTurn == 0)
+        batch_writer->Flush();
+    }
+    if (batch_writer != NULL)
+      batch_writer->Flush();
+    timer.Done();
+  }
+
+  IPEndPoint receive_address_;
+  int send_fd_;
+  int receive_fd_;
+};
+
+TEST_F(QuicBatchPacketWriterPerfTest, Throughput) {
+  QuicDefaultPacketWriter default_writer(send_fd_);
+  WritePackets("QuicPacketWriter_default", &default_writer, NULL);
+
+  QuicBatchPacketWriter batch_writer(send_fd_);
+  bool gso_supported = batch_writer.use_gso();
+  batch_writer.set_use_gso(false);
+  WritePackets("QuicPacketWriter_sendmmsg", &batch_writer, &batch_writer);
+
+  if (gso_supported) {
+    batch_writer.set_use_gso(true);
+    WritePackets("QuicPacketWriter_gso", &batch_writer, &batch_writer);
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,156 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_batch_packet_writer.h"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "net/base/net_util.h"
+#include "net/tools/quic/quic_socket_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+class QuicBatchPacketWriterTest : public ::testing::Test {
+ protected:
+  QuicBatchPacketWriterTest() : send_fd_(-1), receive_fd_(-1) {}
+
+  virtual void SetUp() OVERRIDE {
+    CHECK(ParseIPLiteralToNumber("127.0.0.1", &loopback_));
+
+    receive_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_LE(0, receive_fd_);
+    sockaddr_storage raw_address;
+    socklen_t address_len = sizeof(raw_address);
+    ASSERT_TRUE(IPEndPoint(loopback_, 0).ToSockAddr(
+        reinterpret_cast<sockaddr*>(&raw_address), &address_len));
+    ASSERT_EQ(0, bind(receive_fd_, reinterpret_cast<sockaddr*>(&raw_address),
+                      address_len));
+    address_len = sizeof(raw_address);
+    ASSERT_EQ(0, getsockname(receive_fd_,
+                             reinterpret_cast<sockaddr*>(&raw_address),
+                             &address_len));
+    ASSERT_TRUE(receive_address_.FromSockAddr(
+        reinterpret_cast<sockaddr*>(&raw_address), address_len));
+
+    send_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_LE(0, send_fd_);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    close(send_fd_);
+    close(receive_fd_);
+  }
+
+  // Returns the next packet received, or an empty string if there is none.
+  std::string ReceivePacket() {
+    char buffer[kMaxPacketSize];
+    int rc = recv(receive_fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (rc <= 0)
+      return std::string();
+    return std::string(buffer, rc);
+  }
+
+  WriteResult Write(QuicBatchPacketWriter* writer, const std::string& data) {
+    return writer->WritePacket(data.data(), data.size(), IPAddressNumber(),
+                               receive_address_, NULL);
+  }
+
+  IPAddressNumber loopback_;
+  IPEndPoint receive_address_;
+  int send_fd_;
+  int receive_fd_;
+};
+
+TEST_F(QuicBatchPacketWriterTest, QueuesPacketsUntilFlush) {
+  QuicBatchPacketWriter writer(send_fd_);
+  EXPECT_FALSE(writer.IsWriteBlockedDataBuffered());
+
+  WriteResult result = Write(&writer, "first");
+  EXPECT_EQ(WRITE_STATUS_OK, result.status);
+  EXPECT_EQ(5, result.bytes_written);
+  EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, "second").status);
+  EXPECT_EQ(2u, writer.num_queued_packets());
+  EXPECT_EQ("", ReceivePacket());
+
+  EXPECT_EQ(WRITE_STATUS_OK, writer.Flush().status);
+  EXPECT_EQ(0u, writer.num_queued_packets());
+  EXPECT_FALSE(writer.write_blocked());
+  EXPECT_EQ("first", ReceivePacket());
+  EXPECT_EQ("second", ReceivePacket());
+  EXPECT_EQ("", ReceivePacket());
+}
+
+TEST_F(QuicBatchPacketWriterTest, FlushesFullBatch) {
+  QuicBatchPacketWriter writer(send_fd_);
+  for (size_t i = 0; i < QuicBatchPacketWriter::kMaxBatchSize; ++i)
+    EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, "packet").status);
+  EXPECT_EQ(0u, writer.num_queued_packets());
+  for (size_t i = 0; i < QuicBatchPacketWriter::kMaxBatchSize; ++i)
+    EXPECT_EQ("packet", ReceivePacket());
+}
+
+TEST_F(QuicBatchPacketWriterTest, DropsPacketOnError) {
+  QuicBatchPacketWriter writer(send_fd_);
+  // An IPv4 socket can not send to an IPv6 peer.
+  IPAddressNumber ipv6_loopback;
+  CHECK(ParseIPLiteralToNumber("::1", &ipv6_loopback));
+  std::string dropped = "dropped";
+  EXPECT_EQ(WRITE_STATUS_OK,
+            writer.WritePacket(dropped.data(), dropped.size(),
+                               IPAddressNumber(),
+                               IPEndPoint(ipv6_loopback, 443), NULL).status);
+  EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, "sent").status);
+
+  EXPECT_EQ(WRITE_STATUS_OK, writer.Flush().status);
+  EXPECT_EQ(0u, writer.num_queued_packets());
+  EXPECT_EQ("sent", ReceivePacket());
+}
+
+// GSO segments arrive as separate packets, so the result is the same with and
+// without it.
+TEST_F(QuicBatchPacketWriterTest, SegmentsPacketsOfTheSameSize) {
+  QuicBatchPacketWriter writer(send_fd_);
+  for (int use_gso = 0; use_gso <= (writer.use_gso() ? 1 : 0); ++use_gso) {
+    writer.set_use_gso(use_gso != 0);
+    std::string full(1000, 'a');
+    std::string last(200, 'b');
+    std::string other(1000, 'c');
+    EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, full).status);
+    EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, full).status);
+    EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, last).status);
+    EXPECT_EQ(WRITE_STATUS_OK, Write(&writer, other).status);
+
+    EXPECT_EQ(WRITE_STATUS_OK, writer.Flush().status);
+    EXPECT_EQ(full, ReceivePacket());
+    EXPECT_EQ(full, ReceivePacket());
+    EXPECT_EQ(last, ReceivePacket());
+    EXPECT_EQ(other, ReceivePacket());
+    EXPECT_EQ("", ReceivePacket());
+  }
+}
+
+TEST_F(QuicBatchPacketWriterTest, SendsFromSelfAddress) {
+  QuicBatchPacketWriter writer(send_fd_);
+  ASSERT_EQ(0, QuicSocketUtils::SetGetAddressInfo(send_fd_, AF_INET));
+  std::string data = "from loopback";
+  EXPECT_EQ(WRITE_STATUS_OK,
+            writer.WritePacket(data.data(), data.size(), loopback_,
+                               receive_address_, NULL).status);
+  EXPECT_EQ(WRITE_STATUS_OK, writer.Flush().status);
+  EXPECT_EQ(data, ReceivePacket());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,80 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_util.h"
+#include "net/quic/quic_config.h"
+#include "net/quic/quic_connection.h"
+#include "net/quic/quic_protocol.h"
+#include "net/tools/balsa/balsa_headers.h"
+#include "net/tools/quic/quic_client.h"
+#include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/quic_multi_threaded_server.h"
+#include "net/tools/quic/quic_reliable_client_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+const char kHostname[] = "www.example.com";
+const char kUrl[] = "https://www.example.com/bulk";
+const size_t kResponseSize = 16 * 1024 * 1024;
+
+// Downloads a large response over loopback. Most of the time is spent by the
+// server sending the response, which is where the stream data is copied on
+// its way from the stream to the socket.
+TEST(QuicBulkTransferPerfTest, Download) {
+  QuicInMemoryCache::GetInstance()->AddSimpleResponse(
+      "GET", kUrl, "HTTP/1.1", "200", "OK", std::string(kResponseSize, 'x'));
+
+  QuicConfig config;
+  config.SetDefaults();
+  QuicMultiThreadedServer server(config, QuicSupportedVersions(), 1);
+  server.SetStrikeRegisterNoStartupPeriod();
+  IPAddressNumber ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &ip));
+  ASSERT_TRUE(server.Start(IPEndPoint(ip, 0)));
+
+  QuicClient client(IPEndPoint(ip, server.port()), kHostname, config,
+                    QuicSupportedVersions());
+  ASSERT_TRUE(client.Initialize());
+  ASSERT_TRUE(client.Connect());
+
+  QuicReliableClientStream* stream = client.CreateReliableClientStream();
+  ASSERT_TRUE(stream != NULL);
+  BalsaHeaders headers;
+  headers.SetRequestFirstlineFromStringPieces("GET", kUrl, "HTTP/1.1");
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::PerfTimeLogger timer("QuicBulkTransfer_download");
+  stream->SendRequest(headers, "", true);
+  client.WaitForStreamToClose(stream->id());
+  timer.Done();
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  const QuicConnectionStats& stats =
+      client.session()->connection()->GetStats();
+  EXPECT_LE(kResponseSize, stats.stream_bytes_received);
+  base::LogPerfResult(
+      "QuicBulkTransfer_ns_per_byte",
+      elapsed.InMicroseconds() * 1000.0 / stats.stream_bytes_received, "ns");
+  base::LogPerfResult(
+      "QuicBulkTransfer_throughput",
+      stats.stream_bytes_received * 8 / elapsed.InSecondsF() / 1e6, "Mbps");
+
+  client.Disconnect();
+  server.Shutdown();
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -50,6 +50,7 @@ QuicDispatcher::QuicDispatcher(const QuicConfig& config,
       write_blocked_(false),
       helper_(new QuicEpollConnectionHelper(epoll_server_)),
       writer_(new QuicDefaultPacketWriter(fd)),
+      handshake_worker_pool_(NULL),
       supported_versions_(supported_versions) {
 }
 
@@ -207,6 +208,9 @@ QuicSession* QuicDispatcher::CreateQuicSession(
       config_, new QuicConnection(guid, client_address, helper_.get(), this,
                                   true, supported_versions_), this);
   session->InitializeSession(crypto_config_);
+  if (handshake_worker_pool_ != NULL) {
+    session->set_handshake_worker_pool(handshake_worker_pool_);
+  }
   return session;
 }
 
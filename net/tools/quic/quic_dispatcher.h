@@ -36,6 +36,7 @@ struct hash<net::QuicBlockedWriterInterface*> {
 namespace net {
 
 class EpollServer;
+class HandshakeWorkerPool;
 class QuicConfig;
 class QuicCryptoServerConfig;
 class QuicSession;
@@ -109,6 +110,12 @@ class QuicDispatcher : public QuicPacketWriter, public QuicSessionOwner {
 
   WriteBlockedList* write_blocked_list() { return &write_blocked_list_; }
 
+  // Makes the sessions created from now on process their client hellos on
+  // |worker_pool|, which must outlive them. Not owned.
+  void set_handshake_worker_pool(HandshakeWorkerPool* worker_pool) {
+    handshake_worker_pool_ = worker_pool;
+  }
+
  protected:
   const QuicConfig& config_;
   const QuicCryptoServerConfig& crypto_config_;
@@ -160,6 +167,9 @@ class QuicDispatcher : public QuicPacketWriter, public QuicSessionOwner {
   // The writer to write to the socket with.
   scoped_ptr<QuicPacketWriter> writer_;
 
+  // If not NULL, processes the client hellos of new sessions.
+  HandshakeWorkerPool* handshake_worker_pool_;
+
   // This vector contains QUIC versions which we currently support.
   // This should be ordered such that the highest supported version is the first
   // element, with subsequent elements in descending order (versions can be
@@ -0,0 +1,81 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_handshake_worker_pool.h"
+
+#include "base/logging.h"
+#include "net/tools/epoll_server/epoll_server.h"
+
+namespace net {
+namespace tools {
+
+// A posted task and its reply, run by one of the pool threads.
+class QuicHandshakeWorkerPool::Task
+    : public base::DelegateSimpleThread::Delegate {
+ public:
+  Task(QuicHandshakeWorkerPool* pool,
+       const base::Closure& task,
+       const base::Closure& reply)
+      : pool_(pool),
+        task_(task),
+        reply_(reply) {
+  }
+
+  // base::DelegateSimpleThread::Delegate:
+  virtual void Run() OVERRIDE {
+    task_.Run();
+    pool_->OnTaskDone(reply_);
+    delete this;
+  }
+
+ private:
+  QuicHandshakeWorkerPool* pool_;
+  base::Closure task_;
+  base::Closure reply_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+QuicHandshakeWorkerPool::QuicHandshakeWorkerPool(EpollServer* epoll_server,
+                                                 int num_threads)
+    : epoll_server_(epoll_server),
+      threads_("QuicHandshake", num_threads) {
+  DCHECK_GT(num_threads, 0);
+  threads_.Start();
+}
+
+QuicHandshakeWorkerPool::~QuicHandshakeWorkerPool() {
+  threads_.JoinAll();
+}
+
+void QuicHandshakeWorkerPool::PostTaskAndReply(const base::Closure& task,
+                                               const base::Closure& reply) {
+  threads_.AddWork(new Task(this, task, reply));
+}
+
+void QuicHandshakeWorkerPool::RunReplies() {
+  std::vector<base::Closure> replies;
+  {
+    base::AutoLock lock(lock_);
+    replies.swap(replies_);
+  }
+  for (size_t i = 0; i < replies.size(); ++i) {
+    replies[i].Run();
+  }
+}
+
+void QuicHandshakeWorkerPool::OnTaskDone(const base::Closure& reply) {
+  {
+    base::AutoLock lock(lock_);
+    replies_.push_back(reply);
+    // The EpollServer has already been woken for the earlier replies.
+    if (replies_.size() > 1) {
+      return;
+    }
+  }
+  epoll_server_->Wake();
+}
+
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,62 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_TOOLS_QUIC_QUIC_HANDSHAKE_WORKER_POOL_H_
+#define NET_TOOLS_QUIC_QUIC_HANDSHAKE_WORKER_POOL_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+#include "net/quic/crypto/handshake_worker_pool.h"
+
+namespace net {
+
+class EpollServer;
+
+namespace tools {
+
+// HandshakeWorkerPool for a server whose connections run on an EpollServer.
+// The tasks run on a fixed number of threads. When a task is done its reply
+// is queued, and the EpollServer is woken so that the owner of the pool runs
+// the reply with RunReplies() after the current turn of its event loop.
+class QuicHandshakeWorkerPool : public HandshakeWorkerPool {
+ public:
+  // |epoll_server| is the event loop of the connections, and must outlive the
+  // pool.
+  QuicHandshakeWorkerPool(EpollServer* epoll_server, int num_threads);
+
+  // Waits for the posted tasks to run, and destroys their replies.
+  virtual ~QuicHandshakeWorkerPool();
+
+  // HandshakeWorkerPool
+  virtual void PostTaskAndReply(const base::Closure& task,
+                                const base::Closure& reply) OVERRIDE;
+
+  // Runs the replies of the tasks which are done. Must be called on the thread
+  // which runs the EpollServer.
+  void RunReplies();
+
+ private:
+  class Task;
+
+  // Called on a pool thread when a task is done.
+  void OnTaskDone(const base::Closure& reply);
+
+  EpollServer* epoll_server_;
+  base::DelegateSimpleThreadPool threads_;
+
+  // Protects |replies_|, which the pool threads append to.
+  base::Lock lock_;
+  std::vector<base::Closure> replies_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicHandshakeWorkerPool);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_HANDSHAKE_WORKER_POOL_H_
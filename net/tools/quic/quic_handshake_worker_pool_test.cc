@@ -0,0 +1,64 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_handshake_worker_pool.h"
+
+#include "base/bind.h"
+#include "base/threading/platform_thread.h"
+#include "net/tools/epoll_server/epoll_server.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+void RecordThread(base::PlatformThreadId* thread_id) {
+  *thread_id = base::PlatformThread::CurrentId();
+}
+
+void SetTrue(bool* flag) {
+  *flag = true;
+}
+
+TEST(QuicHandshakeWorkerPoolTest, RunsReplyOnEventLoopThread) {
+  EpollServer epoll_server;
+  QuicHandshakeWorkerPool pool(&epoll_server, 2);
+
+  const base::PlatformThreadId kNoThread = base::kInvalidThreadId;
+  base::PlatformThreadId task_thread = kNoThread;
+  base::PlatformThreadId reply_thread = kNoThread;
+  pool.PostTaskAndReply(base::Bind(&RecordThread, &task_thread),
+                        base::Bind(&RecordThread, &reply_thread));
+
+  // The pool wakes the EpollServer when the task is done, so this does not
+  // wait for the timeout.
+  for (int i = 0; i < 100 && reply_thread == kNoThread; ++i) {
+    epoll_server.WaitForEventsAndExecuteCallbacks();
+    pool.RunReplies();
+  }
+
+  EXPECT_NE(kNoThread, task_thread);
+  EXPECT_NE(base::PlatformThread::CurrentId(), task_thread);
+  EXPECT_EQ(base::PlatformThread::CurrentId(), reply_thread);
+}
+
+TEST(QuicHandshakeWorkerPoolTest, DropsRepliesOnDestruction) {
+  EpollServer epoll_server;
+  bool task_ran = false;
+  bool reply_ran = false;
+  {
+    QuicHandshakeWorkerPool pool(&epoll_server, 1);
+    pool.PostTaskAndReply(base::Bind(&SetTrue, &task_ran),
+                          base::Bind(&SetTrue, &reply_ran));
+  }
+  // The task was run before the pool went away, but not the reply.
+  EXPECT_TRUE(task_ran);
+  EXPECT_FALSE(reply_ran);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,255 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_multi_threaded_server.h"
+
+#include <deque>
+#include <string>
+
+#include "base/format_macros.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "net/quic/crypto/crypto_handshake.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/quic/quic_clock.h"
+#include "net/tools/quic/quic_dispatcher.h"
+#include "net/tools/quic/quic_server.h"
+
+namespace net {
+namespace tools {
+
+namespace {
+
+const char kSourceAddressTokenSecret[] = "secret";
+
+// A packet read by one worker for a connection owned by another.
+struct ForwardedPacket {
+  ForwardedPacket(const IPEndPoint& server_address,
+                  const IPEndPoint& client_address,
+                  QuicGuid guid,
+                  const QuicEncryptedPacket& packet)
+      : server_address(server_address),
+        client_address(client_address),
+        guid(guid),
+        data(packet.data(), packet.length()) {}
+
+  IPEndPoint server_address;
+  IPEndPoint client_address;
+  QuicGuid guid;
+  std::string data;
+};
+
+}  // namespace
+
+// A QuicServer that runs on its own thread and shares its port with the other
+// workers.
+class QuicMultiThreadedServer::Worker : public QuicServer,
+                                        public base::SimpleThread {
+ public:
+  Worker(QuicMultiThreadedServer* server, size_t index)
+      : QuicServer(server->config_, server->supported_versions_,
+                   &server->crypto_config_),
+        base::SimpleThread(base::StringPrintf("quic_worker_%" PRIuS, index)),
+        server_(server),
+        index_(index),
+        quit_(true, false) {
+    set_reuse_port(true);
+  }
+
+  virtual ~Worker() {}
+
+  size_t index() const { return index_; }
+
+  // Hands a packet over to the worker that owns |guid|.
+  void RoutePacket(const IPEndPoint& server_address,
+                   const IPEndPoint& client_address,
+                   QuicGuid guid,
+                   const QuicEncryptedPacket& packet) {
+    size_t owner = GetWorkerForGuid(guid, server_->num_workers_);
+    DCHECK_NE(index_, owner);
+    server_->workers_[owner]->QueuePacket(
+        ForwardedPacket(server_address, client_address, guid, packet));
+  }
+
+  // Called on the thread of another worker.
+  void QueuePacket(const ForwardedPacket& packet) {
+    {
+      base::AutoLock lock(lock_);
+      forwarded_packets_.push_back(packet);
+    }
+    epoll_server()->Wake();
+  }
+
+  // Makes Run() return after closing the sessions. Can be called from any
+  // thread.
+  void Quit() {
+    quit_.Signal();
+    epoll_server()->Wake();
+  }
+
+  // base::SimpleThread:
+  virtual void Run() OVERRIDE {
+    while (!quit_.IsSignaled())
+      WaitForEvents();
+    Shutdown();
+  }
+
+ protected:
+  // QuicServer:
+  virtual QuicDispatcher* CreateQuicDispatcher() OVERRIDE;
+  // Handles the packets forwarded by the other workers, so that the replies
+  // are sent with the rest of this turn's packets.
+  virtual void OnEventsHandled() OVERRIDE;
+
+ private:
+  QuicMultiThreadedServer* server_;
+  const size_t index_;
+
+  base::WaitableEvent quit_;
+
+  // Protects |forwarded_packets_|, which other workers append to.
+  base::Lock lock_;
+  std::deque<ForwardedPacket> forwarded_packets_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+// A QuicDispatcher which only handles the packets of the connections owned by
+// its worker, and forwards the others.
+class QuicMultiThreadedServer::ForwardingDispatcher : public QuicDispatcher {
+ public:
+  ForwardingDispatcher(Worker* worker,
+                       size_t num_workers,
+                       const QuicConfig& config,
+                       const QuicCryptoServerConfig& crypto_config,
+                       const QuicVersionVector& supported_versions,
+                       int fd,
+                       EpollServer* epoll_server)
+      : QuicDispatcher(config, crypto_config, supported_versions, fd,
+                       epoll_server),
+        worker_(worker),
+        num_workers_(num_workers) {}
+
+  virtual ~ForwardingDispatcher() {}
+
+  // QuicDispatcher:
+  virtual void ProcessPacket(const IPEndPoint& server_address,
+                             const IPEndPoint& client_address,
+                             QuicGuid guid,
+                             const QuicEncryptedPacket& packet) OVERRIDE {
+    if (GetWorkerForGuid(guid, num_workers_) != worker_->index()) {
+      worker_->RoutePacket(server_address, client_address, guid, packet);
+      return;
+    }
+    QuicDispatcher::ProcessPacket(server_address, client_address, guid,
+                                  packet);
+  }
+
+  // Processes a packet forwarded by another worker.
+  void ProcessForwardedPacket(const IPEndPoint& server_address,
+                              const IPEndPoint& client_address,
+                              QuicGuid guid,
+                              const QuicEncryptedPacket& packet) {
+    QuicDispatcher::ProcessPacket(server_address, client_address, guid,
+                                  packet);
+  }
+
+ private:
+  Worker* worker_;
+  const size_t num_workers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ForwardingDispatcher);
+};
+
+QuicDispatcher* QuicMultiThreadedServer::Worker::CreateQuicDispatcher() {
+  return new ForwardingDispatcher(this, server_->num_workers_, config(),
+                                  crypto_config(), supported_versions(), fd(),
+                                  epoll_server());
+}
+
+void QuicMultiThreadedServer::Worker::OnEventsHandled() {
+  std::deque<ForwardedPacket> packets;
+  {
+    base::AutoLock lock(lock_);
+    packets.swap(forwarded_packets_);
+  }
+
+  ForwardingDispatcher* forwarding_dispatcher =
+      static_cast<ForwardingDispatcher*>(dispatcher());
+  for (std::deque<ForwardedPacket>::const_iterator it = packets.begin();
+       it != packets.end(); ++it) {
+    QuicEncryptedPacket packet(it->data.data(), it->data.size());
+    forwarding_dispatcher->ProcessForwardedPacket(
+        it->server_address, it->client_address, it->guid, packet);
+  }
+}
+
+QuicMultiThreadedServer::QuicMultiThreadedServer(
+    const QuicConfig& config,
+    const QuicVersionVector& supported_versions,
+    size_t num_workers)
+    : num_workers_(num_workers),
+      config_(config),
+      supported_versions_(supported_versions),
+      crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
+      batch_writes_(false),
+      handshake_threads_(0),
+      port_(0) {
+  DCHECK_GT(num_workers, 0u);
+  QuicClock clock;
+  scoped_ptr<CryptoHandshakeMessage> scfg(
+      crypto_config_.AddDefaultConfig(
+          QuicRandom::GetInstance(), &clock,
+          QuicCryptoServerConfig::ConfigOptions()));
+}
+
+QuicMultiThreadedServer::~QuicMultiThreadedServer() {
+  Shutdown();
+}
+
+bool QuicMultiThreadedServer::Start(const IPEndPoint& address) {
+  DCHECK(workers_.empty());
+
+  IPEndPoint worker_address = address;
+  for (size_t i = 0; i < num_workers_; ++i) {
+    Worker* worker = new Worker(this, i);
+    worker->set_batch_writes(batch_writes_);
+    worker->set_handshake_threads(handshake_threads_);
+    if (!worker->Listen(worker_address)) {
+      delete worker;
+      for (size_t j = 0; j < workers_.size(); ++j)
+        workers_[j]->Shutdown();
+      workers_.clear();
+      return false;
+    }
+    workers_.push_back(worker);
+    port_ = worker->port();
+    worker_address = IPEndPoint(address.address(), port_);
+  }
+
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Start();
+  return true;
+}
+
+void QuicMultiThreadedServer::Shutdown() {
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Quit();
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Join();
+  workers_.clear();
+}
+
+// static
+size_t QuicMultiThreadedServer::GetWorkerForGuid(QuicGuid guid,
+                                                 size_t num_workers) {
+  // Clients pick GUIDs at random, so the low bits are evenly distributed.
+  return static_cast<size_t>(guid % num_workers);
+}
+
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,95 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A QUIC server which spreads its connections over several threads.
+
+#ifndef NET_TOOLS_QUIC_QUIC_MULTI_THREADED_SERVER_H_
+#define NET_TOOLS_QUIC_QUIC_MULTI_THREADED_SERVER_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "net/base/ip_endpoint.h"
+#include "net/quic/crypto/quic_crypto_server_config.h"
+#include "net/quic/quic_config.h"
+#include "net/quic/quic_protocol.h"
+
+namespace net {
+namespace tools {
+
+// Runs |num_workers| QuicServers on the same port, each on its own thread with
+// its own EpollServer, SO_REUSEPORT socket, QuicDispatcher and
+// QuicTimeWaitListManager. The workers share a single QuicCryptoServerConfig,
+// so that a server config obtained from one of them is valid for all.
+//
+// The kernel picks the socket for an incoming packet by hashing its address
+// 4-tuple, which only keeps the packets of a connection together while the
+// client address does not change. Routing is instead done by GUID: every
+// connection is owned by the worker named by GetWorkerForGuid(), and a worker
+// that reads a packet for a connection it does not own hands the packet over
+// to the owner's thread.
+class QuicMultiThreadedServer {
+ public:
+  QuicMultiThreadedServer(const QuicConfig& config,
+                          const QuicVersionVector& supported_versions,
+                          size_t num_workers);
+
+  // Calls Shutdown() if the server is running.
+  ~QuicMultiThreadedServer();
+
+  // Opens a socket on |address| for each worker and starts the worker
+  // threads. If the port of |address| is 0, all the workers use the port that
+  // the kernel picked for the first one. Returns false on failure.
+  bool Start(const IPEndPoint& address);
+
+  // Stops the worker threads, letting each close its sessions first.
+  void Shutdown();
+
+  void SetStrikeRegisterNoStartupPeriod() {
+    crypto_config_.set_strike_register_no_startup_period();
+  }
+
+  // Makes the workers send the packets of each event loop turn together.
+  // Must be called before Start().
+  void set_batch_writes(bool batch_writes) { batch_writes_ = batch_writes; }
+
+  // Gives each worker a pool of |handshake_threads| threads to process client
+  // hellos on. Must be called before Start().
+  void set_handshake_threads(int handshake_threads) {
+    handshake_threads_ = handshake_threads;
+  }
+
+  // The port the server is listening on, once started.
+  int port() const { return port_; }
+
+  size_t num_workers() const { return num_workers_; }
+
+  // Returns the index of the worker which owns the connection |guid|.
+  static size_t GetWorkerForGuid(QuicGuid guid, size_t num_workers);
+
+ private:
+  class ForwardingDispatcher;
+  class Worker;
+
+  const size_t num_workers_;
+
+  const QuicConfig config_;
+  const QuicVersionVector supported_versions_;
+
+  // Shared by all the workers. QuicCryptoServerConfig locks its own state.
+  QuicCryptoServerConfig crypto_config_;
+
+  bool batch_writes_;
+  int handshake_threads_;
+
+  ScopedVector<Worker> workers_;
+
+  int port_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicMultiThreadedServer);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_MULTI_THREADED_SERVER_H_
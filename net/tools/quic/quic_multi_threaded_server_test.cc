@@ -0,0 +1,107 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_multi_threaded_server.h"
+
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "net/base/net_util.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/test_tools/quic_in_memory_cache_peer.h"
+#include "net/tools/quic/test_tools/quic_test_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+
+namespace {
+
+const char kFooResponseBody[] = "Artichoke hearts make me happy.";
+
+TEST(QuicMultiThreadedServerTest, GetWorkerForGuid) {
+  const size_t kNumWorkers = 4;
+  std::vector<int> counts(kNumWorkers, 0);
+  QuicRandom* random = QuicRandom::GetInstance();
+  for (int i = 0; i < 4000; ++i) {
+    QuicGuid guid = random->RandUint64();
+    size_t worker =
+        QuicMultiThreadedServer::GetWorkerForGuid(guid, kNumWorkers);
+    ASSERT_LT(worker, kNumWorkers);
+    // The same GUID is always routed to the same worker.
+    EXPECT_EQ(worker,
+              QuicMultiThreadedServer::GetWorkerForGuid(guid, kNumWorkers));
+    ++counts[worker];
+  }
+  for (size_t i = 0; i < kNumWorkers; ++i)
+    EXPECT_GT(counts[i], 800);
+
+  EXPECT_EQ(0u, QuicMultiThreadedServer::GetWorkerForGuid(12345, 1));
+}
+
+// Fetches over several connections, most of which are owned by a worker other
+// than the one whose socket receives their packets.
+TEST(QuicMultiThreadedServerTest, ServesAllConnections) {
+  QuicInMemoryCachePeer::ResetForTests();
+  QuicInMemoryCache::GetInstance()->AddSimpleResponse(
+      "GET", "https://www.google.com/foo", "HTTP/1.1", "200", "OK",
+      kFooResponseBody);
+
+  QuicConfig config;
+  config.SetDefaults();
+  QuicMultiThreadedServer server(config, QuicSupportedVersions(), 4);
+  server.SetStrikeRegisterNoStartupPeriod();
+
+  IPAddressNumber ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &ip));
+  ASSERT_TRUE(server.Start(IPEndPoint(ip, 0)));
+  EXPECT_NE(0, server.port());
+  IPEndPoint server_address(ip, server.port());
+
+  for (int i = 0; i < 8; ++i) {
+    QuicTestClient client(server_address, "www.google.com",
+                          false,  // not secure
+                          QuicSupportedVersions());
+    EXPECT_EQ(kFooResponseBody, client.SendSynchronousRequest("/foo"));
+  }
+
+  server.Shutdown();
+  QuicInMemoryCachePeer::ResetForTests();
+}
+
+// Completes the handshakes on the workers' handshake threads.
+TEST(QuicMultiThreadedServerTest, HandshakeThreads) {
+  QuicInMemoryCachePeer::ResetForTests();
+  QuicInMemoryCache::GetInstance()->AddSimpleResponse(
+      "GET", "https://www.google.com/foo", "HTTP/1.1", "200", "OK",
+      kFooResponseBody);
+
+  QuicConfig config;
+  config.SetDefaults();
+  QuicMultiThreadedServer server(config, QuicSupportedVersions(), 2);
+  server.SetStrikeRegisterNoStartupPeriod();
+  server.set_handshake_threads(2);
+
+  IPAddressNumber ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &ip));
+  ASSERT_TRUE(server.Start(IPEndPoint(ip, 0)));
+  IPEndPoint server_address(ip, server.port());
+
+  for (int i = 0; i < 4; ++i) {
+    QuicTestClient client(server_address, "www.google.com",
+                          false,  // not secure
+                          QuicSupportedVersions());
+    EXPECT_EQ(kFooResponseBody, client.SendSynchronousRequest("/foo"));
+  }
+
+  server.Shutdown();
+  QuicInMemoryCachePeer::ResetForTests();
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -18,6 +18,8 @@
 #include "net/quic/quic_crypto_stream.h"
 #include "net/quic/quic_data_reader.h"
 #include "net/quic/quic_protocol.h"
+#include "net/tools/quic/quic_batch_packet_writer.h"
+#include "net/tools/quic/quic_handshake_worker_pool.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
 #include "net/tools/quic/quic_socket_utils.h"
 
@@ -27,6 +29,10 @@
 #define SO_RXQ_OVFL 40
 #endif
 
+#ifndef SO_REUSEPORT
+#define SO_REUSEPORT 15
+#endif
+
 const int kEpollFlags = EPOLLIN | EPOLLOUT | EPOLLET;
 static const char kSourceAddressTokenSecret[] = "secret";
 
@@ -39,7 +45,13 @@ QuicServer::QuicServer()
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
-      crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
+      reuse_port_(false),
+      batch_writes_(false),
+      batch_writer_(NULL),
+      handshake_threads_(0),
+      owned_crypto_config_(new QuicCryptoServerConfig(
+          kSourceAddressTokenSecret, QuicRandom::GetInstance())),
+      crypto_config_(owned_crypto_config_.get()),
       supported_versions_(QuicSupportedVersions()) {
   // Use hardcoded crypto parameters for now.
   config_.SetDefaults();
@@ -54,8 +66,32 @@ QuicServer::QuicServer(const QuicConfig& config,
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
+      reuse_port_(false),
+      batch_writes_(false),
+      batch_writer_(NULL),
+      handshake_threads_(0),
+      config_(config),
+      owned_crypto_config_(new QuicCryptoServerConfig(
+          kSourceAddressTokenSecret, QuicRandom::GetInstance())),
+      crypto_config_(owned_crypto_config_.get()),
+      supported_versions_(supported_versions) {
+  Initialize();
+}
+
+QuicServer::QuicServer(const QuicConfig& config,
+                       const QuicVersionVector& supported_versions,
+                       QuicCryptoServerConfig* crypto_config)
+    : port_(0),
+      fd_(-1),
+      packets_dropped_(0),
+      overflow_supported_(false),
+      use_recvmmsg_(false),
+      reuse_port_(false),
+      batch_writes_(false),
+      batch_writer_(NULL),
+      handshake_threads_(0),
       config_(config),
-      crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
+      crypto_config_(crypto_config),
       supported_versions_(supported_versions) {
   Initialize();
 }
@@ -68,10 +104,14 @@ void QuicServer::Initialize() {
   // Initialize the in memory cache now.
   QuicInMemoryCache::GetInstance();
 
+  // A shared crypto config is set up by its owner.
+  if (!owned_crypto_config_.get())
+    return;
+
   QuicEpollClock clock(&epoll_server_);
 
   scoped_ptr<CryptoHandshakeMessage> scfg(
-      crypto_config_.AddDefaultConfig(
+      crypto_config_->AddDefaultConfig(
           QuicRandom::GetInstance(), &clock,
           QuicCryptoServerConfig::ConfigOptions()));
 }
@@ -119,6 +159,16 @@ bool QuicServer::Listen(const IPEndPoint& address) {
     return false;
   }
 
+  if (reuse_port_) {
+    int reuse_port = 1;
+    rc = setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT,
+                    &reuse_port, sizeof(reuse_port));
+    if (rc != 0) {
+      LOG(ERROR) << "SO_REUSEPORT not supported: " << strerror(errno);
+      return false;
+    }
+  }
+
   sockaddr_storage raw_addr;
   socklen_t raw_addr_len = sizeof(raw_addr);
   CHECK(address.ToSockAddr(reinterpret_cast<sockaddr*>(&raw_addr),
@@ -145,21 +195,51 @@ bool QuicServer::Listen(const IPEndPoint& address) {
   }
 
   epoll_server_.RegisterFD(fd_, this, kEpollFlags);
-  dispatcher_.reset(new QuicDispatcher(config_, crypto_config_,
-                                       supported_versions_,
-                                       fd_, &epoll_server_));
+  dispatcher_.reset(CreateQuicDispatcher());
+  if (batch_writes_) {
+    batch_writer_ = new QuicBatchPacketWriter(fd_);
+    dispatcher_->UseWriter(batch_writer_);
+  }
+  if (handshake_threads_ > 0) {
+    handshake_worker_pool_.reset(
+        new QuicHandshakeWorkerPool(&epoll_server_, handshake_threads_));
+    dispatcher_->set_handshake_worker_pool(handshake_worker_pool_.get());
+  }
 
   return true;
 }
 
+QuicDispatcher* QuicServer::CreateQuicDispatcher() {
+  return new QuicDispatcher(config_, *crypto_config_, supported_versions_,
+                            fd_, &epoll_server_);
+}
+
 void QuicServer::WaitForEvents() {
   epoll_server_.WaitForEventsAndExecuteCallbacks();
+  // Reply to the client hellos processed in the meantime.
+  if (handshake_worker_pool_.get() != NULL) {
+    handshake_worker_pool_->RunReplies();
+  }
+  OnEventsHandled();
+  // Send the packets written by all the callbacks of this turn at once.
+  if (batch_writer_ != NULL) {
+    batch_writer_->Flush();
+  }
 }
 
 void QuicServer::Shutdown() {
+  // Finish the handshakes in progress. Their replies are dropped, as the
+  // sessions are closing.
+  if (handshake_worker_pool_.get() != NULL) {
+    dispatcher_->set_handshake_worker_pool(NULL);
+    handshake_worker_pool_.reset();
+  }
   // Before we shut down the epoll server, give all active sessions a chance to
   // notify clients that they're closing.
   dispatcher_->Shutdown();
+  if (batch_writer_ != NULL) {
+    batch_writer_->Flush();
+  }
 
   close(fd_);
   fd_ = -1;
@@ -179,6 +259,11 @@ void QuicServer::OnEvent(int fd, EpollEvent* event) {
     }
   }
   if (event->in_events & EPOLLOUT) {
+    // The packets queued before the socket became blocked go out first.
+    if (batch_writer_ != NULL &&
+        batch_writer_->Flush().status == WRITE_STATUS_BLOCKED) {
+      return;
+    }
     bool can_write_more = dispatcher_->OnCanWrite();
     if (can_write_more) {
       event->out_ready_mask |= EPOLLOUT;
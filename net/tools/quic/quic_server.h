@@ -24,13 +24,21 @@ namespace test {
 class QuicServerPeer;
 }  // namespace test
 
+class QuicBatchPacketWriter;
 class QuicDispatcher;
+class QuicHandshakeWorkerPool;
 
 class QuicServer : public EpollCallbackInterface {
  public:
   QuicServer();
   QuicServer(const QuicConfig& config,
              const QuicVersionVector& supported_versions);
+  // Uses |crypto_config| instead of creating a crypto config with a default
+  // server config. |crypto_config| must outlive the server, and can be shared
+  // by servers running on other threads.
+  QuicServer(const QuicConfig& config,
+             const QuicVersionVector& supported_versions,
+             QuicCryptoServerConfig* crypto_config);
 
   virtual ~QuicServer();
 
@@ -71,7 +79,24 @@ class QuicServer : public EpollCallbackInterface {
                                   const IPEndPoint& client_address);
 
   void SetStrikeRegisterNoStartupPeriod() {
-    crypto_config_.set_strike_register_no_startup_period();
+    crypto_config_->set_strike_register_no_startup_period();
+  }
+
+  // If true, Listen() sets SO_REUSEPORT on the socket so that several servers
+  // can listen on the same port, with the kernel spreading clients between
+  // them. Must be called before Listen().
+  void set_reuse_port(bool reuse_port) { reuse_port_ = reuse_port; }
+
+  // If true, the packets written during a turn of the event loop are sent
+  // together at the end of the turn, with a QuicBatchPacketWriter. Must be
+  // called before Listen().
+  void set_batch_writes(bool batch_writes) { batch_writes_ = batch_writes; }
+
+  // If positive, client hellos are processed on a pool of that many threads,
+  // rather than on the thread which runs the event loop. Must be called before
+  // Listen().
+  void set_handshake_threads(int handshake_threads) {
+    handshake_threads_ = handshake_threads;
   }
 
   bool overflow_supported() { return overflow_supported_; }
@@ -80,6 +105,26 @@ class QuicServer : public EpollCallbackInterface {
 
   int port() { return port_; }
 
+ protected:
+  // Creates the dispatcher that handles the packets read from the socket.
+  // Called by Listen().
+  virtual QuicDispatcher* CreateQuicDispatcher();
+
+  // Called by WaitForEvents() once the events of this turn are handled, before
+  // the packets written by then are sent.
+  virtual void OnEventsHandled() {}
+
+  QuicDispatcher* dispatcher() { return dispatcher_.get(); }
+  EpollServer* epoll_server() { return &epoll_server_; }
+  const QuicConfig& config() const { return config_; }
+  const QuicCryptoServerConfig& crypto_config() const {
+    return *crypto_config_;
+  }
+  const QuicVersionVector& supported_versions() const {
+    return supported_versions_;
+  }
+  int fd() const { return fd_; }
+
  private:
   friend class net::tools::test::QuicServerPeer;
 
@@ -109,11 +154,25 @@ class QuicServer : public EpollCallbackInterface {
   // If true, use recvmmsg for reading.
   bool use_recvmmsg_;
 
+  // If true, the socket is opened with SO_REUSEPORT.
+  bool reuse_port_;
+
+  // If true, Listen() gives the dispatcher a QuicBatchPacketWriter, which
+  // batch_writer_ points to. The dispatcher owns it.
+  bool batch_writes_;
+  QuicBatchPacketWriter* batch_writer_;
+
+  // The number of threads of |handshake_worker_pool_|, which Listen() creates
+  // if it is positive.
+  int handshake_threads_;
+
   // config_ contains non-crypto parameters that are negotiated in the crypto
   // handshake.
   QuicConfig config_;
-  // crypto_config_ contains crypto parameters for the handshake.
-  QuicCryptoServerConfig crypto_config_;
+  // crypto_config_ contains crypto parameters for the handshake. It points to
+  // owned_crypto_config_, unless it was passed to the constructor.
+  scoped_ptr<QuicCryptoServerConfig> owned_crypto_config_;
+  QuicCryptoServerConfig* crypto_config_;
 
   // This vector contains QUIC versions which we currently support.
   // This should be ordered such that the highest supported version is the first
@@ -121,6 +180,11 @@ class QuicServer : public EpollCallbackInterface {
   // skipped as necessary).
   QuicVersionVector supported_versions_;
 
+  // Processes client hellos, if |handshake_threads_| is positive. Declared
+  // after the crypto config, which its threads use, so that it is destroyed
+  // first.
+  scoped_ptr<QuicHandshakeWorkerPool> handshake_worker_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(QuicServer);
 };
 
@@ -3,7 +3,8 @@
 // found in the LICENSE file.
 //
 // A binary wrapper for QuicServer.  It listens forever on --port
-// (default 6121) until it's killed or ctrl-cd to death.
+// (default 6121) until it's killed or ctrl-cd to death. With
+// --num_workers=<n>, the connections are spread over n threads.
 
 #include <iostream>
 
@@ -11,14 +12,26 @@
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/synchronization/waitable_event.h"
 #include "net/base/ip_endpoint.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/quic_multi_threaded_server.h"
 #include "net/tools/quic/quic_server.h"
 
 // The port the quic server will listen on.
 
 int32 FLAGS_port = 6121;
 
+// The number of threads serving connections.
+int32 FLAGS_num_workers = 1;
+
+// Whether the packets written in one event loop turn are sent together.
+bool FLAGS_batch_writes = false;
+
+// The number of threads processing client hellos for each worker, or 0 to
+// process them on the worker's own thread.
+int32 FLAGS_handshake_threads = 0;
+
 int main(int argc, char *argv[]) {
   CommandLine::Init(argc, argv);
   CommandLine* line = CommandLine::ForCurrentProcess();
@@ -29,6 +42,9 @@ int main(int argc, char *argv[]) {
         "Options:\n"
         "-h, --help                  show this help message and exit\n"
         "--port=<port>               specify the port to listen on\n"
+        "--num_workers=<n>           number of threads serving connections\n"
+        "--batch_writes              send packets with sendmmsg or UDP GSO\n"
+        "--handshake_threads=<n>     threads processing client hellos\n"
         "--quic_in_memory_cache_dir  directory containing response data\n"
         "                            to load\n";
     std::cout << help_str;
@@ -47,12 +63,51 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (line->HasSwitch("num_workers")) {
+    int num_workers;
+    if (base::StringToInt(line->GetSwitchValueASCII("num_workers"),
+                          &num_workers) && num_workers > 0) {
+      FLAGS_num_workers = num_workers;
+    }
+  }
+
+  if (line->HasSwitch("batch_writes")) {
+    FLAGS_batch_writes = true;
+  }
+
+  if (line->HasSwitch("handshake_threads")) {
+    int handshake_threads;
+    if (base::StringToInt(line->GetSwitchValueASCII("handshake_threads"),
+                          &handshake_threads) && handshake_threads >= 0) {
+      FLAGS_handshake_threads = handshake_threads;
+    }
+  }
+
   base::AtExitManager exit_manager;
 
   net::IPAddressNumber ip;
   CHECK(net::ParseIPLiteralToNumber("::", &ip));
 
+  if (FLAGS_num_workers > 1) {
+    net::QuicConfig config;
+    config.SetDefaults();
+    config.set_initial_round_trip_time_us(net::kMaxInitialRoundTripTimeUs, 0);
+    net::tools::QuicMultiThreadedServer server(
+        config, net::QuicSupportedVersions(), FLAGS_num_workers);
+    server.set_batch_writes(FLAGS_batch_writes);
+    server.set_handshake_threads(FLAGS_handshake_threads);
+    if (!server.Start(net::IPEndPoint(ip, FLAGS_port))) {
+      return 1;
+    }
+    // The workers run until the process is killed.
+    base::WaitableEvent never_signaled(true, false);
+    never_signaled.Wait();
+    return 0;
+  }
+
   net::tools::QuicServer server;
+  server.set_batch_writes(FLAGS_batch_writes);
+  server.set_handshake_threads(FLAGS_handshake_threads);
 
   if (!server.Listen(net::IPEndPoint(ip, FLAGS_port))) {
     return 1;
@@ -27,6 +27,12 @@ void QuicServerSession::InitializeSession(
   crypto_stream_.reset(CreateQuicCryptoServerStream(crypto_config));
 }
 
+void QuicServerSession::set_handshake_worker_pool(
+    HandshakeWorkerPool* worker_pool) {
+  DCHECK(crypto_stream_.get());
+  crypto_stream_->set_handshake_worker_pool(worker_pool);
+}
+
 QuicCryptoServerStream* QuicServerSession::CreateQuicCryptoServerStream(
     const QuicCryptoServerConfig& crypto_config) {
   return new QuicCryptoServerStream(crypto_config, this);
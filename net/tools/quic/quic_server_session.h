@@ -18,6 +18,7 @@
 
 namespace net {
 
+class HandshakeWorkerPool;
 class QuicConfig;
 class QuicConnection;
 class QuicCryptoServerConfig;
@@ -52,6 +53,10 @@ class QuicServerSession : public QuicSession {
 
   virtual void InitializeSession(const QuicCryptoServerConfig& crypto_config);
 
+  // Makes the crypto stream process client hellos on |worker_pool|. Must be
+  // called after InitializeSession().
+  void set_handshake_worker_pool(HandshakeWorkerPool* worker_pool);
+
   const QuicCryptoServerStream* crypto_stream() { return crypto_stream_.get(); }
 
  protected:
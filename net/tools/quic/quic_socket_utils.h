@@ -7,6 +7,7 @@
 #ifndef NET_TOOLS_QUIC_QUIC_SOCKET_UTILS_H_
 #define NET_TOOLS_QUIC_QUIC_SOCKET_UTILS_H_
 
+#include <netinet/in.h>
 #include <stddef.h>
 #include <sys/socket.h>
 #include <string>
@@ -19,6 +20,12 @@ namespace tools {
 
 class QuicSocketUtils {
  public:
+  // The space needed in a control buffer by SetIpInfoInCmsg(), which is
+  // enough for both IPv4 and IPv6 packet info.
+  static const size_t kSpaceForIp =
+      CMSG_SPACE(sizeof(in_pktinfo)) > CMSG_SPACE(sizeof(in6_pktinfo)) ?
+          CMSG_SPACE(sizeof(in_pktinfo)) : CMSG_SPACE(sizeof(in6_pktinfo));
+
   // If the msghdr contains IP_PKTINFO or IPV6_PKTINFO, this will return the
   // IPAddressNumber in that header.  Returns an uninitialized IPAddress on
   // failure.
@@ -46,6 +53,12 @@ class QuicSocketUtils {
                         IPAddressNumber* self_address,
                         IPEndPoint* peer_address);
 
+  // Fills |cmsg| with IP_PKTINFO or IPV6_PKTINFO, based on the address
+  // family of |self_address|, so that a packet is sent from |self_address|.
+  // Returns the space taken in the control buffer.
+  static size_t SetIpInfoInCmsg(const IPAddressNumber& self_address,
+                                cmsghdr* cmsg);
+
   // Writes buf_len to the socket. If writing is successful, sets the result's
   // status to WRITE_STATUS_OK and sets bytes_written.  Otherwise sets the
   // result's status to WRITE_STATUS_BLOCKED or WRITE_STATUS_ERROR and sets
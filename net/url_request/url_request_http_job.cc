@@ -16,7 +16,9 @@
 #include "base/rand_util.h"
 #include "base/strings/string_util.h"
 #include "base/time/time.h"
+#include "net/base/deflate_dictionary.h"
 #include "net/base/filter.h"
+#include "net/base/gzip_filter.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/load_flags.h"
 #include "net/base/mime_util.h"
@@ -559,14 +561,19 @@ void URLRequestHttpJob::AddExtraHeaders() {
     // easier to filter and analyze the streams to assure that a proxy has not
     // damaged these headers.  Some proxies deliberately corrupt Accept-Encoding
     // headers.
+    std::string accept_encoding("gzip,deflate");
+    if (GZipFilter::deflate_dictionary_enabled()) {
+      accept_encoding.append(",");
+      accept_encoding.append(kDeflateDictionaryEncoding);
+    }
     if (!advertise_sdch) {
       // Tell the server what compression formats we support (other than SDCH).
       request_info_.extra_headers.SetHeader(
-          HttpRequestHeaders::kAcceptEncoding, "gzip,deflate");
+          HttpRequestHeaders::kAcceptEncoding, accept_encoding);
     } else {
       // Include SDCH in acceptable list.
       request_info_.extra_headers.SetHeader(
-          HttpRequestHeaders::kAcceptEncoding, "gzip,deflate,sdch");
+          HttpRequestHeaders::kAcceptEncoding, accept_encoding + ",sdch");
       if (!avail_dictionaries.empty()) {
         request_info_.extra_headers.SetHeader(
             kAvailDictionaryHeader,
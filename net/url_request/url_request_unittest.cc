@@ -30,6 +30,8 @@
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "net/base/capturing_net_log.h"
+#include "net/base/deflate_dictionary.h"
+#include "net/base/gzip_filter.h"
 #include "net/base/load_flags.h"
 #include "net/base/load_timing_info.h"
 #include "net/base/load_timing_info_test_util.h"
@@ -60,6 +62,9 @@
 #include "net/socket/ssl_client_socket.h"
 #include "net/ssl/ssl_connection_status_flags.h"
 #include "net/test/cert_test_util.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
 #include "net/test/spawned_test_server/spawned_test_server.h"
 #include "net/url_request/data_protocol_handler.h"
 #include "net/url_request/file_protocol_handler.h"
@@ -74,6 +79,7 @@
 #include "net/url_request/url_request_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
+#include "third_party/zlib/zlib.h"
 
 #if defined(OS_WIN)
 #include "base/win/scoped_com_initializer.h"
@@ -5719,6 +5725,114 @@ TEST_F(URLRequestTestHTTP, OverrideAcceptEncoding) {
   EXPECT_TRUE(ContainsString(d.data_received(), "identity"));
 }
 
+// Check that x-deflate-dict is advertised only when enabled.
+TEST_F(URLRequestTestHTTP, DeflateDictionaryAcceptEncoding) {
+  ASSERT_TRUE(test_server_.Start());
+
+  const bool was_enabled = GZipFilter::deflate_dictionary_enabled();
+  for (int enabled = 0; enabled < 2; ++enabled) {
+    GZipFilter::EnableDeflateDictionarySupport(enabled != 0);
+    TestDelegate d;
+    URLRequest req(test_server_.GetURL("echoheader?Accept-Encoding"),
+                   DEFAULT_PRIORITY,
+                   &d,
+                   &default_context_);
+    req.Start();
+    base::RunLoop().Run();
+    EXPECT_TRUE(ContainsString(d.data_received(), "gzip"));
+    EXPECT_EQ(enabled != 0,
+              ContainsString(d.data_received(), kDeflateDictionaryEncoding));
+  }
+  GZipFilter::EnableDeflateDictionarySupport(was_enabled);
+}
+
+namespace {
+
+const char kDeflateDictionaryPath[] = "/deflate-dict";
+
+// Returns |body| compressed with the x-deflate-dict content encoding.
+std::string DeflateWithDictionary(const std::string& body) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                               -MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+  EXPECT_EQ(Z_OK, deflateSetDictionary(
+      &stream, reinterpret_cast<const Bytef*>(kDeflateDictionary),
+      kDeflateDictionarySize));
+  std::string compressed(deflateBound(&stream, body.size()), '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+  stream.avail_in = body.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+  stream.avail_out = compressed.size();
+  EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  compressed.resize(compressed.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return compressed;
+}
+
+// Serves |body| at kDeflateDictionaryPath, with the x-deflate-dict content
+// encoding if the request accepts it.
+scoped_ptr<test_server::HttpResponse> HandleDeflateDictionaryRequest(
+    const std::string& body,
+    const test_server::HttpRequest& request) {
+  if (request.relative_url != kDeflateDictionaryPath)
+    return scoped_ptr<test_server::HttpResponse>();
+
+  scoped_ptr<test_server::BasicHttpResponse> response(
+      new test_server::BasicHttpResponse);
+  response->set_code(HTTP_OK);
+  response->set_content_type("text/html");
+  std::map<std::string, std::string>::const_iterator accept_encoding =
+      request.headers.find(HttpRequestHeaders::kAcceptEncoding);
+  if (accept_encoding != request.headers.end() &&
+      ContainsString(accept_encoding->second, kDeflateDictionaryEncoding)) {
+    response->AddCustomHeader("Content-Encoding", kDeflateDictionaryEncoding);
+    response->set_content(DeflateWithDictionary(body));
+  } else {
+    response->set_content(body);
+  }
+  return response.PassAs<test_server::HttpResponse>();
+}
+
+}  // namespace
+
+// Check that a response is negotiated to and decoded from x-deflate-dict.
+TEST_F(URLRequestTest, DeflateDictionaryContentEncoding) {
+  std::string body("<!DOCTYPE html>\n<html lang=\"en\"><head>"
+                   "<meta charset=\"utf-8\"><title>Test</title></head>\n"
+                   "<body>");
+  for (int i = 0; i < 100; ++i) {
+    body.append(base::StringPrintf(
+        "<div class=\"item\"><a href=\"/item?id=%d\">Item %d</a></div>\n",
+        i, i));
+  }
+  body.append("</body></html>\n");
+
+  test_server::EmbeddedTestServer server;
+  ASSERT_TRUE(server.InitializeAndWaitUntilReady());
+  server.RegisterRequestHandler(
+      base::Bind(&HandleDeflateDictionaryRequest, body));
+
+  const bool was_enabled = GZipFilter::deflate_dictionary_enabled();
+  GZipFilter::EnableDeflateDictionarySupport(true);
+  TestDelegate d;
+  {
+    URLRequest req(server.GetURL(kDeflateDictionaryPath), DEFAULT_PRIORITY,
+                   &d, &default_context_);
+    req.Start();
+    base::RunLoop().Run();
+
+    std::string content_encoding;
+    EXPECT_TRUE(req.response_headers()->GetNormalizedHeader(
+        "Content-Encoding", &content_encoding));
+    EXPECT_EQ(kDeflateDictionaryEncoding, content_encoding);
+  }
+  GZipFilter::EnableDeflateDictionarySupport(was_enabled);
+
+  EXPECT_EQ(body, d.data_received());
+  ASSERT_TRUE(server.ShutdownAndWaitUntilComplete());
+}
+
 // Check that setting the A-C header sends the proper header.
 TEST_F(URLRequestTestHTTP, SetAcceptCharset) {
   ASSERT_TRUE(test_server_.Start());